@@ -0,0 +1,570 @@
+/**
+ * DropBlocks microbenchmarks
+ * ==========================
+ *
+ * Mede em ns/op os caminhos quentes da mecânica (colisão, kicks, limpeza de
+ * linhas, randomizer), primitivas de render contra um renderer de software
+ * offscreen e o parse dos .cfg distribuídos. Os randomizers também saem com
+ * um relatório de justiça (secas e repetições) sobre um milhão de sorteios. Cada caso é calibrado para
+ * ~MIN_RUN_MS por rodada e repetido REPEATS vezes; o número reportado é a
+ * mediana (o mínimo vai junto, para ver ruído).
+ *
+ * BUILD (ou ./compile.sh bench):
+ *   g++ -std=c++17 -O2 -Iinclude bench/Benchmarks.cpp $(find src -name '*.cpp') \
+ *       $(sdl2-config --cflags --libs) -o dropblocks_bench
+ *
+ * USO:
+ *   dropblocks_bench [--filter TEXTO] [--json ARQUIVO] [--cfg-dir DIR]
+ */
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ConfigManager.hpp"
+#include "ai/BotEngine.hpp"
+#include "DebugLogger.hpp"
+#include "app/GameBoard.hpp"
+#include "app/GameTypes.hpp"
+#include "app/GameSnapshot.hpp"
+#include "app/GameEvents.hpp"
+#include "app/HeadlessSim.hpp"
+#include "app/TimerWheel.hpp"
+#include "render/GameStateBridge.hpp"
+#include "audio/NullAudioSystem.hpp"
+#include "game/Mechanics.hpp"
+#include "pieces/BuiltinPieces.hpp"
+#include "pieces/Piece.hpp"
+#include "pieces/PieceManager.hpp"
+#include "pieces/PieceRng.hpp"
+#include "render/ParticleLayer.hpp"
+#include "render/Primitives.hpp"
+#include "render/SoftRaster.hpp"
+
+extern std::vector<Piece> PIECES;
+extern PieceManager pieceManager;
+
+namespace {
+
+constexpr double MIN_RUN_MS = 20.0;
+constexpr int REPEATS = 7;
+
+struct BenchResult {
+    std::string name;
+    long long iterations = 0;   // por rodada
+    double nsPerOp = 0.0;       // mediana
+    double minNsPerOp = 0.0;
+};
+
+// Impede o otimizador de descartar resultados
+volatile long long g_sink = 0;
+
+using Clock = std::chrono::steady_clock;
+
+double runOnce(const std::function<void(long long)>& body, long long iters) {
+    auto t0 = Clock::now();
+    body(iters);
+    auto t1 = Clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+/// body(n) executa n operações; calibra n até uma rodada durar MIN_RUN_MS
+BenchResult measure(const std::string& name, const std::function<void(long long)>& body) {
+    long long iters = 1;
+    for (;;) {
+        double ns = runOnce(body, iters);
+        if (ns >= MIN_RUN_MS * 1e6 || iters >= (1LL << 40)) break;
+        double scale = ns > 0 ? (MIN_RUN_MS * 1e6 * 1.2) / ns : 10.0;
+        iters = std::max(iters * 2, (long long)(iters * std::min(scale, 100.0)));
+    }
+
+    std::vector<double> perOp;
+    perOp.reserve(REPEATS);
+    for (int r = 0; r < REPEATS; ++r) perOp.push_back(runOnce(body, iters) / (double)iters);
+    std::sort(perOp.begin(), perOp.end());
+
+    BenchResult res;
+    res.name = name;
+    res.iterations = iters;
+    res.nsPerOp = perOp[REPEATS / 2];
+    res.minNsPerOp = perOp.front();
+    return res;
+}
+
+int findPiece(const char* name) {
+    for (size_t i = 0; i < PIECES.size(); ++i) if (PIECES[i].name == name) return (int)i;
+    return 0;
+}
+
+/// Tabuleiro "de meio de jogo": 8 linhas de baixo com um buraco por linha
+void fillGarbage(GameBoard& board) {
+    board.reset();
+    const int o = findPiece("O");
+    for (int y = ROWS - 2; y >= ROWS - 8; y -= 2) {
+        int hole = (y * 3) % (COLS / 2);
+        for (int b = 0; b < COLS / 2; ++b) {
+            if (b == hole) continue;
+            Active a{b * 2, y, 0, o};
+            if (board.canPlacePiece(a, 0, 0, 0)) board.placePiece(a);
+        }
+    }
+}
+
+/// Duas linhas completas no fundo, feitas de peças O
+void fillTwoLines(GameBoard& board) {
+    board.reset();
+    const int o = findPiece("O");
+    for (int b = 0; b < COLS / 2; ++b) board.placePiece(Active{b * 2, ROWS - 2, 0, o});
+}
+
+/// Secas (sorteios entre duas aparições da mesma peça), repetições seguidas e chi² contra o uniforme
+struct Fairness {
+    int maxDrought = 0;
+    double meanGap = 0.0;
+    double repeatPct = 0.0;
+    double chi2 = 0.0;
+};
+
+Fairness measureFairness(PieceManager& pm, int pieces, long long draws) {
+    std::vector<long long> last(pieces, -1), counts(pieces, 0);
+    Fairness f;
+    long long gaps = 0, gapSum = 0, repeats = 0;
+    int prev = -1;
+    for (long long i = 0; i < draws; ++i) {
+        const int p = pm.getNextPiece();
+        if (p < 0 || p >= pieces) continue;
+        if (last[p] >= 0) {
+            const long long gap = i - last[p];
+            f.maxDrought = std::max(f.maxDrought, (int)gap);
+            gapSum += gap; gaps++;
+        }
+        repeats += (p == prev);
+        last[p] = i; counts[p]++; prev = p;
+    }
+    const double expected = (double)draws / pieces;
+    for (long long c : counts) f.chi2 += (c - expected) * (c - expected) / expected;
+    f.meanGap = gaps ? (double)gapSum / gaps : 0.0;
+    f.repeatPct = 100.0 * repeats / std::max(1LL, draws - 1);
+    return f;
+}
+
+std::vector<std::string> shippedConfigs(const std::string& dir) {
+    static const char* names[] = {
+        "default.cfg", "generic.cfg", "amber.cfg", "cmyk.cfg", "green.cfg",
+        "neon-noir.cfg", "rainbow.cfg", "test-1920x540.cfg", "test-900x600.cfg", "test-960x540.cfg",
+    };
+    std::vector<std::string> out;
+    for (const char* n : names) {
+        std::string path = dir.empty() ? n : dir + "/" + n;
+        if (std::ifstream(path).good()) out.push_back(path);
+    }
+    return out;
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+bool writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out.good()) return false;
+    out << "{\n  \"unit\": \"ns/op\",\n  \"repeats\": " << REPEATS << ",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        char buf[512];
+        std::snprintf(buf, sizeof(buf),
+                      "    {\"name\": \"%s\", \"iterations\": %lld, \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f}",
+                      jsonEscape(r.name).c_str(), r.iterations, r.nsPerOp, r.minNsPerOp);
+        out << buf << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return out.good();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string filter, jsonPath, cfgDir;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--cfg-dir") && i + 1 < argc) cfgDir = argv[++i];
+        else { std::fprintf(stderr, "usage: %s [--filter TEXT] [--json FILE] [--cfg-dir DIR]\n", argv[0]); return 2; }
+    }
+
+    DebugLogger::setLevel(DebugLogger::ERROR);  // Logs de info distorcem o parse de config
+    pieceManager.seedFallback();                 // Peças fixas: números comparáveis entre máquinas
+
+    std::vector<BenchResult> results;
+    auto bench = [&](const std::string& name, const std::function<void(long long)>& body) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) return;
+        results.push_back(measure(name, body));
+        const BenchResult& r = results.back();
+        std::printf("%-40s %12.1f ns/op  (min %10.1f, %lld iters)\n", r.name.c_str(), r.nsPerOp, r.minNsPerOp, r.iterations);
+        std::fflush(stdout);
+    };
+
+    // ---- Mecânica ----
+    GameBoard board;
+    fillGarbage(board);
+    const auto& grid = board.getGrid();
+    const int t = findPiece("T");
+
+    bench("mechanics/collides.grid", [&](long long n) {
+        long long hits = 0;
+        for (long long i = 0; i < n; ++i) {
+            Active a{(int)(i % (COLS - 2)), (int)(i % ROWS), (int)(i & 3), t};
+            hits += collides(a, grid, 0, 1, 0);
+        }
+        g_sink = hits;
+    });
+
+    bench("mechanics/collides.bitboard", [&](long long n) {
+        long long hits = 0;
+        for (long long i = 0; i < n; ++i) {
+            Active a{(int)(i % (COLS - 2)), (int)(i % ROWS), (int)(i & 3), t};
+            hits += !board.canPlacePiece(a, 0, 1, 0);
+        }
+        g_sink = hits;
+    });
+
+    bench("mechanics/rotateWithKicks", [&](long long n) {
+        Active a{COLS / 2 - 1, ROWS - 11, 0, t};
+        long long acc = 0;
+        for (long long i = 0; i < n; ++i) {
+            rotateWithKicks(a, board, (i & 4) ? -1 : 1);
+            acc += a.rot + a.x;
+        }
+        g_sink = acc;
+    });
+
+    GameBoard lines;
+    bench("mechanics/board.fillTwoLines", [&](long long n) {
+        for (long long i = 0; i < n; ++i) fillTwoLines(lines);
+        g_sink = lines.getVersion();
+    });
+
+    bench("mechanics/board.fillTwoLines+clearLines", [&](long long n) {
+        long long cleared = 0;
+        for (long long i = 0; i < n; ++i) { fillTwoLines(lines); cleared += lines.clearLines(); }
+        g_sink = cleared;
+    });
+
+    bench("mechanics/board.clearLines.none", [&](long long n) {
+        fillGarbage(lines);
+        long long cleared = 0;
+        for (long long i = 0; i < n; ++i) cleared += lines.clearLines();
+        g_sink = cleared;
+    });
+
+    // ---- Bot ----
+    if (BotBoard::supported()) {
+        BotBoard botBoard;
+        botBoard.load(board);
+        Active spawn{COLS / 2, 0, 0, t};
+        std::vector<Active> placements;
+        bench("bot/enumeratePlacements.garbage", [&](long long n) {
+            long long acc = 0;
+            for (long long i = 0; i < n; ++i) { BotEngine::enumeratePlacements(botBoard, spawn, placements); acc += (long long)placements.size(); }
+            g_sink = acc;
+        });
+
+        BotEngine engine(0);  // Só a thread chamadora: números estáveis
+        engine.setBudgetMs(0);
+        Active best;
+        for (int lookahead = 0; lookahead < 2; ++lookahead) {
+            engine.setLookahead(lookahead != 0);
+            bench(std::string("bot/findBest.garbage.") + (lookahead ? "lookahead" : "single"), [&](long long n) {
+                long long acc = 0;
+                for (long long i = 0; i < n; ++i) { engine.findBest(board, spawn, findPiece("I"), best); acc += best.x; }
+                g_sink = acc;
+            });
+        }
+    }
+
+    // ---- Randomizer ----
+    pieceManager.setRandomizerType(RandType::BAG);
+    pieceManager.setRandBagSize(0);
+    pieceManager.seed(12345);
+    bench("pieces/getNextPiece.bag", [&](long long n) {
+        long long acc = 0;
+        for (long long i = 0; i < n; ++i) acc += pieceManager.getNextPiece();
+        g_sink = acc;
+    });
+
+    for (RngType type : {RngType::PCG, RngType::XOSHIRO, RngType::MT19937}) {
+        PieceRng rng(type, 12345);
+        bench(std::string("pieces/rng.") + PieceRng::typeName(type), [&](long long n) {
+            uint32_t acc = 0;
+            for (long long i = 0; i < n; ++i) acc += rng();
+            g_sink = acc;
+        });
+
+        pieceManager.getRng().setType(type);
+        bench(std::string("pieces/reset.refillBag.") + PieceRng::typeName(type), [&](long long n) {
+            for (long long i = 0; i < n; ++i) pieceManager.reset();  // refillBag() + primeiro sorteio
+            g_sink = pieceManager.getCurrentNextPiece();
+        });
+
+        bench(std::string("pieces/saveState+restore.") + PieceRng::typeName(type), [&](long long n) {
+            for (long long i = 0; i < n; ++i) pieceManager.restoreState(pieceManager.saveState());
+            g_sink = pieceManager.getCurrentNextPiece();
+        });
+    }
+    pieceManager.getRng().setType(RngType::PCG);
+
+    pieceManager.setRandomizerType(RandType::SIMPLE);
+    bench("pieces/getNextPiece.simple", [&](long long n) {
+        long long acc = 0;
+        for (long long i = 0; i < n; ++i) acc += pieceManager.getNextPiece();
+        g_sink = acc;
+    });
+
+    for (RandType type : {RandType::HISTORY, RandType::BAG14, RandType::WEIGHTED}) {
+        pieceManager.setRandomizerType(type);
+        pieceManager.reset();
+        bench(std::string("pieces/getNextPiece.") + PieceManager::randTypeName(type), [&](long long n) {
+            long long acc = 0;
+            for (long long i = 0; i < n; ++i) acc += pieceManager.getNextPiece();
+            g_sink = acc;
+        });
+    }
+
+    pieceManager.setRandomizerType(RandType::BAG);
+    pieceManager.reset();
+    bench("pieces/peek5+getNextPiece.bag", [&](long long n) {
+        long long acc = 0;
+        for (long long i = 0; i < n; ++i) { acc += pieceManager.peek(4); acc += pieceManager.getNextPiece(); }
+        g_sink = acc;
+    });
+
+    // Startup do conjunto padrão: tabelas constexpr contra o parse do default.pieces
+    bench("pieces/load.builtin", [&](long long n) {
+        for (long long i = 0; i < n; ++i) { PieceSet set; BuiltinPieces::build(set); g_sink = (long long)set.pieces.size(); }
+    });
+    if (std::ifstream("default.pieces").good()) {
+        bench("pieces/load.parse.default.pieces", [&](long long n) {
+            for (long long i = 0; i < n; ++i) { PieceSet set; PieceManager::parsePiecesFile("default.pieces", set); g_sink = (long long)set.pieces.size(); }
+        });
+    }
+
+    for (RandType type : {RandType::SIMPLE, RandType::BAG, RandType::HISTORY, RandType::BAG14, RandType::WEIGHTED}) {
+        const std::string name = std::string("fairness/") + PieceManager::randTypeName(type);
+        if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+        pieceManager.setRandomizerType(type);
+        pieceManager.seed(12345);
+        pieceManager.reset();
+        const Fairness f = measureFairness(pieceManager, (int)PIECES.size(), 1000000);
+        std::printf("%-40s maxDrought %4d  meanGap %5.2f  repeats %5.2f%%  chi2 %8.1f\n",
+                    name.c_str(), f.maxDrought, f.meanGap, f.repeatPct, f.chi2);
+    }
+    pieceManager.setRandomizerType(RandType::SIMPLE);
+
+    // ---- Snapshots (rewind / retomada / TripleBuffer) ----
+    {
+        HeadlessSim sim(4);
+        sim.start(12345);
+        for (int i = 0; i < 2000 && !sim.state().isGameOver(); ++i) sim.step(i % 97 == 0 ? SyntheticInput::HARD_DROP : 0);
+        std::unique_ptr<GameSnapshot> snap(new GameSnapshot());
+        bench("snapshot/capture.10x20", [&](long long n) {
+            for (long long i = 0; i < n; ++i) db_captureSnapshot(sim.state(), *snap);
+            g_sink = snap->score;
+        });
+        bench("snapshot/restore.10x20", [&](long long n) {
+            bool ok = true;
+            for (long long i = 0; i < n; ++i) ok &= sim.state().restoreSnapshot(*snap);
+            g_sink = ok;
+        });
+    }
+
+    // ---- Scheduler (timing wheel) ----
+    {
+        // 8 timers periódicos de 100..800 ms que se reagendam; um advance por frame de 16 ms
+        struct Periodic {
+            TimerWheel* wheel;
+            Uint32 period;
+            static void fire(void* user, Uint32 now) {
+                Periodic& p = *static_cast<Periodic*>(user);
+                p.wheel->schedule(now + p.period, &Periodic::fire, user);
+            }
+        };
+        TimerWheel wheel(16);
+        Periodic periodic[8];
+        Uint32 now = 0;
+        for (int i = 0; i < 8; ++i) {
+            periodic[i] = {&wheel, (Uint32)(100 * (i + 1))};
+            wheel.schedule(periodic[i].period, &Periodic::fire, &periodic[i]);
+        }
+        bench("scheduler/advance.16ms.8timers", [&](long long n) {
+            int fired = 0;
+            for (long long i = 0; i < n; ++i) fired += wheel.advance(now += 16);
+            g_sink = fired;
+        });
+    }
+
+    // ---- Eventos da partida ----
+    {
+        // Frame típico: movimento, rotação, lock e linha, entregues a som (mudo) e métricas
+        NullAudioSystem audio;
+        GameAudioEvents audioEvents;
+        audioEvents.setAudio(&audio);
+        GameMetricsEvents metricsEvents;
+        GameEventQueue queue;
+        queue.subscribe(&audioEvents);
+        queue.subscribe(&metricsEvents);
+        const GameEventType frame[] = {GameEventType::MOVED, GameEventType::ROTATED, GameEventType::LOCKED,
+                                       GameEventType::LINES_CLEARED};
+        bench("events/push4+dispatch", [&](long long n) {
+            GameEvent ev;
+            for (long long i = 0; i < n; ++i) {
+                for (GameEventType type : frame) { ev.type = type; ev.count = 1; queue.push(ev); }
+                queue.dispatch();
+            }
+            g_sink = queue.pending();
+        });
+    }
+
+    // ---- Partículas (SoA) ----
+    {
+        ParticlePool pool;
+        pool.setCapacity(2048);
+        for (int i = 0; i < 2048; ++i) pool.spawn((float)(i % 10), (float)(i % 20), 0.0f, 0.0f, 1e9f, 200, 120, 40);   // Paradas: o pool fica cheio
+        bench("particles/update.2048", [&](long long n) {
+            for (long long i = 0; i < n; ++i) pool.update(1.0f / 60.0f, 0.0f, 1e9f, 1e9f);
+            g_sink = pool.size();
+        });
+        ParticleLayer layer;
+        layer.pool().setCapacity(2048);
+        LockEvent ev;
+        ev.clearedRows = Uint64(0xF) << 16;   // Tetris nas últimas 4 linhas
+        ev.cellCount = 4;
+        for (int i = 0; i < 4; ++i) { ev.cellX[i] = (Sint8)i; ev.cellY[i] = 19; }
+        bench("particles/spawn.tetris10x20", [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                layer.pool().clear();
+                layer.spawnLock(ev, 10, 20, 1.0f);
+            }
+            g_sink = layer.pool().size();
+        });
+    }
+
+    // ---- Render (software, offscreen) ----
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 1280, 720, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* ren = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!ren) {
+        std::fprintf(stderr, "software renderer unavailable: %s (skipping render benchmarks)\n", SDL_GetError());
+    } else {
+        SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+
+        bench("render/drawPixelText.scale2.16ch", [&](long long n) {
+            for (long long i = 0; i < n; ++i) drawPixelText(ren, 20, 20 + (int)(i & 63), "SCORE: 00123456", 2, 220, 220, 220);
+        });
+
+        bench("render/drawPixelText.scale6.8ch", [&](long long n) {
+            for (long long i = 0; i < n; ++i) drawPixelText(ren, 20, 100, "LEVEL 12", 6, 255, 200, 80);
+        });
+
+        bench("render/drawRoundedFilled.300x200.r12", [&](long long n) {
+            for (long long i = 0; i < n; ++i) drawRoundedFilled(ren, 40, 40, 300, 200, 12, 30, 30, 60, 220);
+        });
+
+        bench("render/drawRoundedFilled.900x600.r24", [&](long long n) {
+            for (long long i = 0; i < n; ++i) drawRoundedFilled(ren, 40, 40, 900, 600, 24, 30, 30, 60, 220);
+        });
+
+        // Tabuleiro 10x20 de células 28px com 8 cores: FillRects por cor x um SDL_RenderGeometry
+        std::vector<SDL_Rect> cells;
+        for (int y = 0; y < 20; ++y)
+            for (int x = 0; x < 10; ++x) cells.push_back(SDL_Rect{300 + x * 29, 40 + y * 29, 28, 28});
+        RectBatch rects;
+        bench("render/RectBatch.board10x20", [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                for (size_t c = 0; c < cells.size(); ++c) rects.add(cells[c], (Uint8)(c % 8 * 30), 90, 160);
+                rects.flush(ren);
+            }
+        });
+        QuadBatch quads;
+        quads.reserve(cells.size());
+        bench("render/QuadBatch.board10x20", [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                for (size_t c = 0; c < cells.size(); ++c) quads.add(cells[c], (Uint8)(c % 8 * 30), 90, 160);
+                quads.flush(ren);
+            }
+        });
+
+        SDL_DestroyRenderer(ren);
+    }
+    if (surface) SDL_FreeSurface(surface);
+
+    // ---- Raster de software (frame sem GPU): os kernels direto num buffer 1280x720 ----
+    {
+        std::vector<Uint32> frame(1280 * 720, 0xFF101020u);
+        SoftRaster::Target t;
+        t.pixels = frame.data();
+        t.stride = 1280;
+        t.clip = SDL_Rect{0, 0, 1280, 720};
+        const std::string kernels = SoftRaster::kernelName();
+
+        bench("soft/fillSpan.1280." + kernels, [&](long long n) {
+            for (long long i = 0; i < n; ++i) SoftRaster::fillSpan(&frame[(size_t)(i & 511) * 1280], 1280, 0xFF3050A0u);
+        });
+        bench("soft/blendSpan.1280.a220." + kernels, [&](long long n) {
+            for (long long i = 0; i < n; ++i) SoftRaster::blendSpan(&frame[(size_t)(i & 511) * 1280], 1280, 0xFF3050A0u, 220);
+        });
+        bench("soft/fillRounded.900x600.r24." + kernels, [&](long long n) {
+            for (long long i = 0; i < n; ++i) SoftRaster::fillRounded(t, 40, 40, 900, 600, 24, 24, 0, 30, 30, 60, 220);
+        });
+        bench("soft/fillRect.board10x20." + kernels, [&](long long n) {
+            for (long long i = 0; i < n; ++i)
+                for (int c = 0; c < 200; ++c)
+                    SoftRaster::fillRect(t, 300 + c % 10 * 29, 40 + c / 10 * 29, 28, 28, (Uint8)(c % 8 * 30), 90, 160, 255);
+        });
+    }
+
+    // ---- Config ----
+    for (const std::string& path : shippedConfigs(cfgDir)) {
+        std::string base = path.substr(path.find_last_of("/\\") + 1);
+        bench("config/loadFromFile." + base, [&](long long n) {
+            long long ok = 0;
+            for (long long i = 0; i < n; ++i) {
+                ConfigManager cm;  // Novo a cada vez: loadFromFile acumula caminhos
+                ok += cm.loadFromFile(path);
+            }
+            g_sink = ok;
+        });
+
+        // Só o parse (tokenizer + hash perfeito), sem abrir o arquivo
+        std::ifstream in(path, std::ios::binary);
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::string scratch;
+        bench("config/parseBuffer." + base, [&](long long n) {
+            long long applied = 0;
+            ConfigManager cm;
+            for (long long i = 0; i < n; ++i) {
+                scratch.assign(text.c_str(), text.size() + 1);  // O parse escreve no buffer
+                applied += cm.parseBuffer(&scratch[0], text.size(), base);
+            }
+            g_sink = applied;
+        });
+    }
+
+    if (!jsonPath.empty()) {
+        if (!writeJson(jsonPath, results)) { std::fprintf(stderr, "could not write %s\n", jsonPath.c_str()); return 1; }
+        std::printf("JSON written to %s\n", jsonPath.c_str());
+    }
+    return 0;
+}
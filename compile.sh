@@ -18,6 +18,26 @@ if [ ! -f "dropblocks.cpp" ]; then
     exit 1
 fi
 
+# Winsock (UdpSocket: métricas StatsD) no MSYS2/MinGW
+NET_LIBS=""
+case "$(uname -s)" in MINGW*|MSYS*) NET_LIBS="-lws2_32" ;; esac
+
+# ALLOC_TRACKING=1 ./compile.sh: conta alocações por frame (overlay de debug e métricas)
+EXTRA_FLAGS=""
+if [ "$ALLOC_TRACKING" = "1" ]; then EXTRA_FLAGS="-DDROPBLOCKS_ALLOC_TRACKING=1"; fi
+# STB_VORBIS_DIR=/caminho/do/stb ./compile.sh: música OGG Vorbis (stb_vorbis.c nesse diretório)
+if [ -n "$STB_VORBIS_DIR" ]; then EXTRA_FLAGS="$EXTRA_FLAGS -DDROPBLOCKS_STB_VORBIS=1 -I$STB_VORBIS_DIR"; fi
+
+# Microbenchmarks: ./compile.sh bench [--filter TEXTO] [--json ARQUIVO]
+if [ "$1" = "bench" ]; then
+  shift
+  echo "⏱️  Compilando benchmarks..."
+  BENCH_SRC="bench/Benchmarks.cpp $(find src -type f -name '*.cpp' 2>/dev/null | tr '\n' ' ')"
+  g++ -Iinclude $BENCH_SRC -o dropblocks_bench.exe $(sdl2-config --cflags --libs) $NET_LIBS $EXTRA_FLAGS -O2 -std=c++17 || { echo "❌ Erro na compilação dos benchmarks!"; exit 1; }
+  ./dropblocks_bench.exe "$@"
+  exit $?
+fi
+
 echo "🔧 Preparando fontes..."
 
 # Coletar fontes
@@ -30,7 +50,7 @@ if [ -d src ]; then
 fi
 
 echo "🔧 Compilando: $SRC_LIST"
-g++ -Iinclude $SRC_LIST -o dropblocks.exe $(sdl2-config --cflags --libs) -O2 -std=c++17
+g++ -Iinclude $SRC_LIST -o dropblocks.exe $(sdl2-config --cflags --libs) $NET_LIBS $EXTRA_FLAGS -O2 -std=c++17
 
 # Verificar se a compilação foi bem-sucedida
 if [ $? -eq 0 ]; then
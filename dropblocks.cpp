@@ -33,8 +33,25 @@
  * - Position with TIMER_X, TIMER_Y, TIMER_WIDTH, TIMER_HEIGHT
  * - Customize colors with TIMER_FILL, TIMER_TEXT_COLOR, warning colors
  *
+ * REPLAY VERIFICATION (tournaments):
+ * - dropblocks --verify DIR [--json FILE] [--threads N]
+ * - Re-simulates every .dbr in DIR headless on all cores (no window), checks the
+ *   Zobrist checkpoints and final score, writes the JSON report (default verify.json)
+ *
+ * SOAK TEST (long sessions):
+ * - dropblocks --soak HOURS [--csv FILE] [--replay FILE] [--sample SECONDS]
+ * - The bot (or FILE, looped) plays with every effect on and the themes cycling;
+ *   RSS, heap blocks, textures, mixer queue and frame-time percentiles go to the
+ *   CSV (default soak.csv) once per interval. Exit code 2 = something kept growing
+ *
+ * FRAME BENCHMARK (renderer changes):
+ * - dropblocks --bench-frames --replay FILE [--config FILE]... [--frames N] [--json FILE]
+ * - Replays FILE once per config (every *.cfg in the current directory by default),
+ *   each in a fresh process, uncapped and at fixed steps per frame; frame-time
+ *   percentiles, draw calls and CPU per section go to the JSON (default bench-frames.json)
+ *
  * BUILD:
- * - g++ -std=c++17 -Wall -Wextra -O2 -I./include dropblocks.cpp src/*.cpp src/app/*.cpp src/audio/*.cpp src/config/*.cpp src/di/*.cpp src/game/*.cpp src/input/*.cpp src/pieces/*.cpp src/render/*.cpp src/timer/*.cpp src/util/*.cpp `pkg-config --cflags --libs sdl2` -o dropblocks
+ * - g++ -std=c++17 -Wall -Wextra -O2 -I./include dropblocks.cpp src/*.cpp src/app/*.cpp src/audio/*.cpp src/config/*.cpp src/di/*.cpp src/game/*.cpp src/input/*.cpp src/net/*.cpp src/pieces/*.cpp src/render/*.cpp src/timer/*.cpp src/util/*.cpp `pkg-config --cflags --libs sdl2` -o dropblocks
  * 
  * CHANGELOG v5.4:
  * - Fixed timer pause functionality - now correctly freezes during game pause
@@ -53,8 +70,14 @@
 // Application modules
 #include "app/GameInitializer.hpp"
 #include "app/GameLoop.hpp"
+#include "app/SplitScreenLoop.hpp"
 #include "app/GameCleanup.hpp"
 #include "app/GameState.hpp"
+#include "app/Replay.hpp"
+#include "app/ReplayVerifier.hpp"
+#include "app/SoakTest.hpp"
+#include "app/FrameBench.hpp"
+#include "app/Tracing.hpp"
 
 // Rendering
 #include "render/RenderManager.hpp"
@@ -81,11 +104,14 @@
 // DI Container
 #include "Interfaces.hpp"
 #include "di/DependencyContainer.hpp"
+#include "di/ServiceRegistry.hpp"
 
 // STL
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstdlib>
+#include <cstring>
 
 // ===========================
 //   DEFINIÇÕES DE VERSÃO
@@ -99,57 +125,8 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-// ===========================
-//   GLOBAL CONFIGURATION
-// ===========================
-// These globals are managed by ConfigManager and applied via ConfigApplicator.
-// They remain global for performance (avoiding indirection) and backward compatibility.
-// Future: Consider moving to a GlobalConfig singleton if more encapsulation is needed.
-
-// Layout parameters (synced from VisualConfig.layout via ConfigApplicator)
-int   ROUNDED_PANELS = 1;           // 1 = rounded; 0 = rectangle
-int   HUD_FIXED_SCALE   = 6;        // Fixed HUD scale
-std::string TITLE_TEXT  = "__H A C K T R I S";  // Vertical text (A-Z and space)
-int   GAP1_SCALE        = 10;       // banner ↔ board (x scale)
-int   GAP2_SCALE        = 10;       // board ↔ panel (x scale)
-
-// Pieces configuration (managed by PieceManager)
-std::string PIECES_FILE_PATH = "";  // Optional path to pieces file from config
-
-// Visual effects bridge (provides read-only access to visual config)
-VisualEffectsView g_visualView{};
-
-// ===========================
-//   GAME MECHANICS CONSTANTS
-// ===========================
-// These constants define core game behavior and are synced from GameConfig.
-
-/** @brief Number of columns in the game board (constant) */
-const int COLS = 10;
-/** @brief Number of rows in the game board (constant) */
-const int ROWS = 20;
-/** @brief Border size around the game board (pixels) */
-int BORDER = 10;
-/** @brief Speed acceleration per level (ms reduction per level) */
-int SPEED_ACCELERATION = 50;
-/** @brief Lines required to advance to next level */
-int LEVEL_STEP = 10;
-
-// ===========================
-//   GLOBAL MANAGER INSTANCES
-// ===========================
-// These are the main subsystem managers. They coordinate configuration,
-// theme, and piece management across the application.
-
-GameConfig gameConfig;              // Game timing and mechanics configuration
-ThemeManager themeManager;          // Visual theme and color management
-std::vector<Piece> PIECES;          // Active piece set (loaded from .pieces file)
-LayoutConfig layoutConfig;          // Virtual layout configuration
-
-
-// Global piece manager instance
-PieceManager pieceManager;
-
+// Note: global configuration and manager instances live in src/Globals.cpp
+// (shared with the bench/ executables, which have their own main)
 // Note: All bridge functions (db_*) moved to src/render/GameStateBridge.cpp
 
 // ===========================
@@ -161,15 +138,54 @@ PieceManager pieceManager;
  * Initializes SDL2, loads configuration and piece sets, sets up audio,
  * and runs the main game loop until the user quits.
  * 
- * @param argc Command line argument count (unused)
- * @param argv Command line arguments (unused)
- * @return Exit status (0 for success)
+ * @param argc Command line argument count
+ * @param argv Command line arguments (--verify DIR [--json FILE] [--threads N], --soak HOURS [--csv FILE] [--replay FILE] [--sample SECONDS], --bench-frames --replay FILE [--config FILE] [--frames N])
+ * @return Exit status (0 for success, 2 = soak found monotonic growth)
  */
-int main(int, char**) {
+int main(int argc, char** argv) {
+    // Log numa thread própria: nenhum printf/fflush no caminho do frame
+    DebugLogger::startAsync();
+    
+    // DROPBLOCKS_TRACE=N: grava zonas desde o boot (antes de a config dizer TRACE_SECONDS)
+    Trace::setThreadName("Main");
+    if (const char* trace = std::getenv("DROPBLOCKS_TRACE")) Trace::enable(std::atoi(trace));
+    
     // Display version info
     DebugLogger::info("DropBlocks v" + std::string(DROPBLOCKS_VERSION) + " - " + DROPBLOCKS_BUILD_INFO);
     DebugLogger::info("Features: " + std::string(DROPBLOCKS_FEATURES));
     
+    // --verify DIR: servidor de torneio, confere os replays e sai
+    std::string verifyDir, jsonPath;
+    int verifyThreads = 0;
+    // --soak HOURS: o bot (ou --replay em loop) por horas, amostras em --csv
+    SoakOptions soakOptions;
+    // --bench-frames: o mesmo --replay em cada config; --bench-child = uma rodada dessas
+    FrameBenchOptions benchOptions;
+    bool benchFrames = false, benchChild = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--verify") && i + 1 < argc) verifyDir = argv[++i];
+        else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) jsonPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) verifyThreads = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--soak") && i + 1 < argc) soakOptions.hours = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--csv") && i + 1 < argc) soakOptions.csvPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--replay") && i + 1 < argc) soakOptions.replayFile = argv[++i];
+        else if (!std::strcmp(argv[i], "--sample") && i + 1 < argc) soakOptions.sampleSeconds = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--config") && i + 1 < argc) benchOptions.configs.push_back(argv[++i]);
+        else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) benchOptions.maxFrames = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--bench-frames")) benchFrames = true;
+        else if (!std::strcmp(argv[i], "--bench-child")) benchChild = true;
+    }
+    benchOptions.replayFile = soakOptions.replayFile;
+    if (!jsonPath.empty()) benchOptions.jsonPath = jsonPath;
+    
+    if (benchFrames && !benchChild) {
+        // Só o orquestrador: quem abre janela e mede são os processos filhos
+        int exitCode = runFrameBenchmarks(argv[0], benchOptions);
+        Trace::shutdown();
+        DebugLogger::shutdown();
+        return exitCode;
+    }
+    
     // Create game objects
     AudioSystem audio;
     InputManager inputManager;
@@ -178,6 +194,18 @@ int main(int, char**) {
     SDL_Window* win = nullptr;
     SDL_Renderer* ren = nullptr;
     
+    if (!verifyDir.empty()) {
+        // Só config e peças: nada de SDL_Init, janela ou dispositivo de áudio
+        int exitCode = GameInit::initializeGame(state, audio, configManager, inputManager)
+                           ? runReplayVerification(verifyDir, jsonPath.empty() ? "verify.json" : jsonPath, verifyThreads) : 1;
+        Trace::shutdown();
+        DebugLogger::shutdown();
+        return exitCode;
+    }
+    
+    // Antes do renderer: UNCAPPED só vale se o PRESENTVSYNC nunca for pedido
+    if (benchChild) setFrameBenchOverrides(configManager, benchOptions);
+    
     // Initialize all systems
     GameInitializer initializer;
     if (!initializer.initializeComplete(audio, inputManager, configManager, state, win, ren)) {
@@ -187,27 +215,69 @@ int main(int, char**) {
     
     // Setup rendering pipeline
     RenderManager renderManager(ren);
-    renderManager.addLayer(std::make_unique<BackgroundLayer>());
-    renderManager.addLayer(std::make_unique<TimerRenderLayer>());  // Timer layer (early - before game elements)
-    renderManager.addLayer(std::make_unique<BannerLayer>());
-    renderManager.addLayer(std::make_unique<PieceStatsLayer>());
-    renderManager.addLayer(std::make_unique<BoardLayer>());
-    renderManager.addLayer(std::make_unique<HUDLayer>());
-    renderManager.addLayer(std::make_unique<NextLayer>());
-    renderManager.addLayer(std::make_unique<ScoreLayer>());
-    renderManager.addLayer(std::make_unique<OverlayLayer>());
-    renderManager.addLayer(std::make_unique<PostEffectsLayer>(&audio));
+    addDefaultLayers(renderManager, &audio);
     
     // Initialize game randomizer
     GameInit::initializeRandomizer(state);
     
-    // Run game loop
-    GameLoop gameLoop;
-    gameLoop.run(state, renderManager, ren, configManager, inputManager);
+    // --soak: por cima do .cfg, antes de qualquer modo olhar a config
+    SoakMonitor soak;
+    bool soakFailed = false;
+    if (soakOptions.hours > 0.0) {
+        applySoakOverrides(configManager, soakOptions);
+        soakFailed = !soak.start(soakOptions);
+    }
+    
+    // REPLAY_SPEED=FAST: reproduz no núcleo headless e sai (sem renderizar)
+    const GameConfig& gameCfg = configManager.getGame();
+    int exitCode = 0;
+    if (soakFailed) {
+        exitCode = 1;
+    } else if (!gameCfg.replayFile.empty() && gameCfg.replaySpeed == "FAST") {
+        ReplayData replay;
+        if (!loadReplay(gameCfg.replayFile, replay)) {
+            exitCode = 1;
+        } else {
+            Uint64 t0 = SDL_GetPerformanceCounter();
+            ReplayResult res = runReplayHeadless(replay);
+            double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+            const bool ok = res.matches && res.divergedTick < 0;
+            DebugLogger::info(std::string("Replay ") + (ok ? "MATCH" : "MISMATCH") +
+                              ": score " + std::to_string(res.score) + "/" + std::to_string(replay.finalScore) +
+                              ", lines " + std::to_string(res.lines) + "/" + std::to_string(replay.finalLines) +
+                              ", " + std::to_string(res.checkpoints) + " checkpoint(s)" +
+                              (res.divergedTick >= 0 ? " (diverged at tick " + std::to_string(res.divergedTick) + ")" : "") +
+                              ", " + std::to_string(res.ticks) + " ticks in " + std::to_string(ms) + "ms" +
+                              (res.configMatches ? "" : " (config hash differs)"));
+            exitCode = ok ? 0 : 1;
+        }
+    } else if (gameCfg.splitPlayers > 1 || !gameCfg.netPeer.empty()) {
+        // SPLIT_PLAYERS: versus local, tabuleiros lado a lado na mesma janela;
+        // NET_PEER: o mesmo loop com o segundo tabuleiro espelhando o par da rede
+        SplitScreenLoop splitLoop;
+        splitLoop.setDeferredStartup(&initializer.getDeferredStartup());
+        splitLoop.run(state, renderManager, ren, configManager, inputManager);
+    } else {
+        // Run game loop
+        GameLoop gameLoop;
+        gameLoop.setStartupTimings(&initializer.getStartupTimings());
+        gameLoop.setDeferredStartup(&initializer.getDeferredStartup());
+        if (soak.isRunning()) gameLoop.setSoak(&soak);
+        FrameBench bench(benchOptions.maxFrames);
+        if (benchChild) gameLoop.setBench(&bench);
+        gameLoop.run(state, renderManager, ren, configManager, inputManager);
+        if (benchChild && (!bench.frames() || !bench.writeJson(benchOptions.jsonPath, configManager, ren))) exitCode = 1;
+        if (soak.isRunning()) {
+            soak.finish(state.getAudio());
+            if (soak.flagged()) exitCode = 2;
+        }
+    }
     
     // Cleanup
     GameCleanup cleanup;
     cleanup.cleanupAll(audio, inputManager, renderManager, win, ren);
+    Trace::shutdown();
+    DebugLogger::shutdown();
     
-    return 0;
+    return exitCode;
 }
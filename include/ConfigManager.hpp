@@ -44,13 +44,26 @@ public:
 
     // Loading methods
     bool loadFromFile(const std::string& path) override;
+    /**
+     * @brief Aplica um .cfg já em memória (uma passada, in-place)
+     * @param data buffer gravável com data[size] também gravável; é modificado
+     * @param source nome usado nos avisos (arquivo:linha)
+     * @return chaves aplicadas
+     */
+    int parseBuffer(char* data, size_t size, const std::string& source);
     bool loadFromEnvironment() override;
     bool loadFromCommandLine(int argc, char* argv[]);
     bool loadAll();
+    /// Arquivos que loadAll() tenta, em ordem; vale o primeiro que abrir
+    static std::vector<std::string> candidatePaths();
+    /// Config veio de outro lugar (cache compilado): registra as fontes
+    void markLoaded(const std::vector<std::string>& paths) { configPaths_ = paths; loaded_ = true; }
 
     // Override system
     void setOverride(const std::string& key, const std::string& value) override;
     void clearOverrides();
+    /// Chaves de setOverride() por cima do que foi carregado (loadGameData chama depois do .cfg ou do cache)
+    int applyOverrides();
 
     // Validation
     bool validate() const override;
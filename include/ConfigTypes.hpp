@@ -1,5 +1,7 @@
 #pragma once
 
+#include <iterator>
+#include <map>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -46,6 +48,7 @@ struct LayoutConfig {
     ElementLayout hud{1130, 0, 490, 1080, {24,24,32}, {90,90,120}, {200,200,220}, 255, 200, true};
     ElementLayout next{1245, 550, 260, 300, {18,18,26}, {80,80,110}, {220,220,220}, 255, 160, true};
     ElementLayout score{1200, 50, 350, 450, {18,18,26}, {80,80,110}, {220,220,220}, 255, 160, true};
+    int nextCount = 1;  // Peças na fila do NEXT (1-6); as extras saem em miniatura abaixo da grade
 };
 
 struct VisualConfig {
@@ -110,14 +113,23 @@ struct VisualConfig {
         int sweepGAlphaMax = 50;
         float sweepGSoftness = 0.9f;
         int scanlineAlpha = 20;
+        bool crtShader = false;       // scanlines/sweep/curvatura/vinheta/glow num shader GL
+        float crtCurvature = 0.15f;   // 0 = tela plana
+        float crtVignette = 0.3f;
+        float crtGlow = 0.25f;
+        int particleCapacity = 2048;  // pool do ParticleLayer; 0 = desligado
+        float particleDensity = 1.0f; // partículas por célula limpa/travada (x base)
     } effects;
 
     struct Layout {
         int roundedPanels = 1;
+        int cachedPanels = 1;   // 1 = blit pre-rendered panels; 0 = draw every frame
+        int cachedLayers = 1;   // 1 = banner/HUD/score/stats/NEXT redrawn only when they change
         int hudFixedScale = 6;
     } layout;
 
     std::string titleText = "__H A C K T R I S";
+    std::string cellSkin = "flat";   // flat, bevel, gloss ou caminho de um .bmp
 };
 
 struct AudioConfig {
@@ -128,6 +140,36 @@ struct AudioConfig {
     bool enableAmbientSounds = true;
     bool enableComboSounds = true;
     bool enableLevelUpSounds = true;
+    std::map<std::string, std::string> sfxFiles; // SFX_FILE_<NOME> -> WAV (NOME de SfxBank::name)
+    float musicVolume = 0.5f;
+    int musicCrossfadeMs = 1500;
+    std::map<int, std::string> musicFiles;       // MUSIC_FILE_<NÍVEL> -> faixa a partir desse nível
+
+    // SFX_FILE_MOVE=..., SFX_FILE_HARD_DROP=...: substitui o som sintetizado por um WAV
+    bool loadSfxFile(const std::string& key, const std::string& value) {
+        static const std::string prefix = "SFX_FILE_";
+        if (key.compare(0, prefix.size(), prefix) != 0 || key.size() == prefix.size()) return false;
+        sfxFiles[key.substr(prefix.size())] = value;
+        return true;
+    }
+
+    // MUSIC_FILE_0=music/a.ogg, MUSIC_FILE_5=...: faixa do nível 0 em diante, do 5 em diante...
+    bool loadMusicFile(const std::string& key, const std::string& value) {
+        static const std::string prefix = "MUSIC_FILE_";
+        if (key.compare(0, prefix.size(), prefix) != 0 || key.size() == prefix.size() || key.size() > prefix.size() + 4) return false;
+        for (size_t i = prefix.size(); i < key.size(); ++i) if (key[i] < '0' || key[i] > '9') return false;
+        const int level = std::atoi(key.c_str() + prefix.size());
+        if (value.empty()) musicFiles.erase(level); else musicFiles[level] = value;
+        return true;
+    }
+
+    /// Faixa do maior MUSIC_FILE_<N> com N <= level (vazio = sem música)
+    const std::string& musicFor(int level) const {
+        static const std::string none;
+        if (level < 0) return none;
+        auto it = musicFiles.upper_bound(level);
+        return it == musicFiles.begin() ? none : std::prev(it)->second;
+    }
 
     bool loadFromConfig(const std::string& key, const std::string& value) {
         if (key == "MASTER_VOLUME") { masterVolume = std::clamp((float)std::atof(value.c_str()), 0.0f, 1.0f); return true; }
@@ -137,11 +179,26 @@ struct AudioConfig {
         if (key == "ENABLE_AMBIENT_SOUNDS") { enableAmbientSounds = (value == "1" || value == "true"); return true; }
         if (key == "ENABLE_COMBO_SOUNDS") { enableComboSounds = (value == "1" || value == "true"); return true; }
         if (key == "ENABLE_LEVEL_UP_SOUNDS") { enableLevelUpSounds = (value == "1" || value == "true"); return true; }
+        if (key == "MUSIC_VOLUME") { musicVolume = std::clamp((float)std::atof(value.c_str()), 0.0f, 1.0f); return true; }
+        if (key == "MUSIC_CROSSFADE_MS") { musicCrossfadeMs = std::clamp(std::atoi(value.c_str()), 0, 10000); return true; }
+        if (loadSfxFile(key, value)) return true;
+        if (loadMusicFile(key, value)) return true;
         return false;
     }
 };
 
+// Ações do teclado remapeáveis (KEY_*): índice em InputConfig::keys e bit da KeyMap
+enum class KeyAction : int {
+    LEFT, RIGHT, SOFT_DROP, HARD_DROP, ROTATE_CCW, ROTATE_CW,
+    PAUSE, RESTART, FORCE_RESTART, QUIT, SCREENSHOT, DEBUG, TIMER, THEME, REWIND, TRACE,
+    COUNT
+};
+constexpr int KEY_ACTION_COUNT = (int)KeyAction::COUNT;
+constexpr int KEYS_PER_ACTION = 4;
+
 struct InputConfig {
+    // Scancodes SDL por ação; linha zerada = teclas padrão, -1 = sem tecla (KEY_x=NONE)
+    int keys[KEY_ACTION_COUNT][KEYS_PER_ACTION] = {};
     int buttonLeft = 13, buttonRight = 11, buttonDown = 14, buttonUp = 12;
     int buttonRotateCCW = 0, buttonRotateCW = 1, buttonSoftDrop = 2, buttonHardDrop = 3;
     int buttonPause = 6, buttonStart = 7, buttonQuit = 8;
@@ -156,6 +213,8 @@ struct PiecesConfig {
     int previewGrid = 6;
     std::string randomizerType = "simple";
     int randBagSize = 0;
+    std::string rngType = "pcg";       // pcg, xoshiro ou mt19937
+    unsigned rngSeed = 0;              // 0 = semente do relógio
     std::vector<RGB> pieceColors;
 };
 
@@ -170,92 +229,95 @@ struct TimerConfig {
     RGB criticalColor{255,0,0};     // Cor crítica
     RGB progressBarBg{40,40,40};    // Cor de fundo da barra de progresso
     RGB progressBarBorder{80,80,80}; // Cor da borda da barra de progresso
-    
-    // Função helper para carregar configurações do arquivo
-    bool loadFromConfig(const std::string& key, const std::string& value) {
-        if (key == "TIMER_ENABLED") { enabled = (value == "1" || value == "true"); return true; }
-        if (key == "TIMER_DURATION_SECONDS") { 
-            int v = std::atoi(value.c_str());
-            if (v > 0 && v <= 7200) { durationSeconds = v; return true; } // Max 2 horas
-        }
-        if (key == "TIMER_SHOW_WARNING_AT_30S") { showWarningAt30s = (value == "1" || value == "true"); return true; }
-        if (key == "TIMER_SHOW_WARNING_AT_10S") { showWarningAt10s = (value == "1" || value == "true"); return true; }
-        
-        // Layout properties
-        if (key == "TIMER_X") { layout.x = std::atoi(value.c_str()); return true; }
-        if (key == "TIMER_Y") { layout.y = std::atoi(value.c_str()); return true; }
-        if (key == "TIMER_WIDTH") { layout.width = std::atoi(value.c_str()); return true; }
-        if (key == "TIMER_HEIGHT") { layout.height = std::atoi(value.c_str()); return true; }
-        
-        // Parse color values (format: #RRGGBB)
-        if (key == "TIMER_FILL") {
-            if (value.length() == 7 && value[0] == '#') {
-                unsigned int r, g, b;
-                if (sscanf(value.c_str(), "#%02x%02x%02x", &r, &g, &b) == 3) {
-                    layout.backgroundColor = {(unsigned char)r, (unsigned char)g, (unsigned char)b};
-                    return true;
-                }
-            }
-        }
-        if (key == "TIMER_TEXT_COLOR") {
-            if (value.length() == 7 && value[0] == '#') {
-                unsigned int r, g, b;
-                if (sscanf(value.c_str(), "#%02x%02x%02x", &r, &g, &b) == 3) {
-                    normalColor = {(unsigned char)r, (unsigned char)g, (unsigned char)b};
-                    return true;
-                }
-            }
-        }
-        if (key == "TIMER_WARNING_COLOR") {
-            if (value.length() == 7 && value[0] == '#') {
-                unsigned int r, g, b;
-                if (sscanf(value.c_str(), "#%02x%02x%02x", &r, &g, &b) == 3) {
-                    warningColor = {(unsigned char)r, (unsigned char)g, (unsigned char)b};
-                    return true;
-                }
-            }
-        }
-        if (key == "TIMER_CRITICAL_COLOR") {
-            if (value.length() == 7 && value[0] == '#') {
-                unsigned int r, g, b;
-                if (sscanf(value.c_str(), "#%02x%02x%02x", &r, &g, &b) == 3) {
-                    criticalColor = {(unsigned char)r, (unsigned char)g, (unsigned char)b};
-                    return true;
-                }
-            }
-        }
-        if (key == "TIMER_PROGRESS_BG") {
-            if (value.length() == 7 && value[0] == '#') {
-                unsigned int r, g, b;
-                if (sscanf(value.c_str(), "#%02x%02x%02x", &r, &g, &b) == 3) {
-                    progressBarBg = {(unsigned char)r, (unsigned char)g, (unsigned char)b};
-                    return true;
-                }
-            }
-        }
-        if (key == "TIMER_PROGRESS_BORDER") {
-            if (value.length() == 7 && value[0] == '#') {
-                unsigned int r, g, b;
-                if (sscanf(value.c_str(), "#%02x%02x%02x", &r, &g, &b) == 3) {
-                    progressBarBorder = {(unsigned char)r, (unsigned char)g, (unsigned char)b};
-                    return true;
-                }
-            }
-        }
-        
-        // Alpha values
-        if (key == "TIMER_BG_ALPHA") { 
-            int v = std::atoi(value.c_str());
-            if (v >= 0 && v <= 255) { layout.backgroundAlpha = (unsigned char)v; return true; }
-        }
-        
-        // Layout enabled
-        if (key == "TIMER_LAYOUT_ENABLED") { layout.enabled = (value == "1" || value == "true"); return true; }
-        
-        return false;
-    }
 };
 
-struct GameConfig { int tickMsStart = 400; int tickMsMin = 80; int speedAcceleration = 50; int levelStep = 10; };
+struct GameConfig {
+    int tickMsStart = 400; int tickMsMin = 80; int speedAcceleration = 50; int levelStep = 10;
+    int boardCols = 10; int boardRows = 20;   // lidos no boot (mudar exige reiniciar)
+    // Frame pacing (FrameScheduler): VSYNC | CAPPED | UNCAPPED | LOW_LATENCY
+    std::string framePacing = "VSYNC";
+    int targetFps = 60;      // CAPPED / LOW_LATENCY
+    int simStepMs = 4;       // passo fixo da lógica (gravity, timer)
+    bool threadedMode = false;  // simulação em thread própria, render lê snapshots
+    bool inputThread = false;   // teclado lido do evdev numa thread própria (Linux), aplicado no passo do timestamp
+    // Split-screen local (lido no boot): 1 = desligado, 2-4 tabuleiros lado a lado
+    int splitPlayers = 1;
+    bool splitBots = false;     // assentos 2..N jogados pelo bot em vez do teclado
+    bool splitParallel = true;  // assentos atualizados em paralelo (SDL threads) com mais de um núcleo
+    // Versus em rede (lido no boot): vazio = desligado, senão "host:porta" do outro gabinete
+    std::string netPeer;
+    int netPort = 7777;         // porta UDP local
+    int netChecksumTicks = 250; // CHECKSUM do estado a cada N ticks (0 = nunca)
+    bool netGarbage = true;     // linhas limpas mandam lixo para o outro lado
+    // Espectador (lido no boot): porta TCP que publica a partida / gabinete a assistir
+    int spectatePort = 0;         // 0 = não publica
+    std::string spectateSource;   // "host:porta"; vazio = joga normalmente
+    int spectateBufferMs = 200;   // folga do telão contra jitter
+    std::string profileCsv;     // vazio = sem dump; senão uma linha de tempos por frame
+    bool latencyProbe = false;  // mede input -> Present (overlay PERF e métrica input_latency_ms)
+    int traceSeconds = 0;       // zonas de trace guardadas por thread (0 = desligado); KEY_TRACE grava
+    std::string traceFile = "trace.json";  // Chrome trace-event; o horário entra antes da extensão
+    bool qualityGovernor = false;  // desliga efeitos em ordem quando o frame não cabe no orçamento
+    float qualityBudgetMs = 0.0f;  // orçamento do frame; 0 = 1000 / TARGET_FPS
+    int textureBudgetMb = 0;       // teto das texturas do renderTargetPool(); 0 = sem teto
+    std::string captureVideo;   // vazio = não grava; .y4m cru ou qualquer extensão via ffmpeg
+    int captureFps = 0;         // taxa declarada no vídeo; 0 = TARGET_FPS
+    int captureDelayFrames = 2; // leitura N frames atrás do draw (GPU sem parar)
+    int captureBudgetMb = 256;  // teto dos buffers entre o render e o encoder
+    std::string themeFiles;     // vazio = *.cfg ao lado da config (F9 troca)
+    int themeAttractSeconds = 0; // troca de paleta na demo do attract (0 = não)
+    bool idleRender = true;     // pausa/game over: só redesenha quando algo muda
+    int idleWaitMs = 100;       // sono máximo em SDL_WaitEventTimeout sem eventos
+    int frameArenaKb = 64;      // rascunho por frame do render (FrameArena); cresce sozinho se estourar
+    // Topper (lido no boot): segunda janela com placar, NEXT, melhores e o tabuleiro
+    int marqueeDisplay = -1;    // índice da tela do SDL; -1 = desligado
+    int marqueeFps = 15;        // teto de redesenho do marquee (só redesenha quando algo muda)
+    // Driver de render: vazio/AUTO = padrão do SDL, PROBE = medir e guardar, ou um nome ("opengles2")
+    std::string renderDriver;
+    std::string renderProbeFile = "render_probe.txt";
+    // Replays (.dbr): gravar cada partida em replayRecordDir, ou tocar replayFile
+    std::string replayRecordDir;
+    std::string replayFile;
+    std::string replaySpeed = "REALTIME";  // REALTIME | FAST (headless, sem janela)
+    // Partidas e ranking no disco (lido no boot; SessionLog): vazio = não grava
+    std::string sessionLog = "sessions.dbl";
+    int highScoreCount = 10;    // tamanho do ranking (índice SESSION_LOG.idx)
+    int sessionFsyncMs = 2000;  // fsync em lote no máximo a cada N ms (0 = a cada game over)
+    // Treino e retomada (lidos no boot): rewind por GameSnapshot e partida salva no disco
+    bool practiceMode = false;  // KEY_REWIND volta peças (RewindBuffer); partidas fora do ranking
+    int rewindSlots = 120;      // snapshots guardados (~12 KB cada, alocados no boot)
+    int rewindIntervalTicks = 0; // captura também a cada N passos sem lock (0 = só nos locks)
+    std::string resumeFile;     // vazio = desligado; senão a partida volta daqui depois de um corte
+    int resumeSaveMs = 5000;    // intervalo mínimo entre gravações (sempre num lock)
+    // Bot (BotEngine + BotInput) no lugar do jogador
+    bool botEnabled = false;
+    int botThreads = -1;        // workers da busca; -1 = núcleos - 1
+    int botBudgetMs = 10;       // tempo máximo de busca por peça (0 = sem limite)
+    bool botLookahead = true;   // avalia a próxima peça também
+    int botActionDelayMs = 60;  // intervalo entre ações (0 = uma por passo)
+    float botWeightHeight = -0.510066f;
+    float botWeightLines = 0.760666f;
+    float botWeightHoles = -0.35663f;
+    float botWeightBumpiness = -0.184483f;
+    // Attract mode: depois de N s sem input o bot joga uma demo com CPU/GPU baixos
+    int attractIdleSeconds = 0;     // 0 = desligado
+    int attractFps = 20;            // render durante a demo (CAPPED)
+    int attractActionDelayMs = 150;
+    int attractBotThreads = 0;      // 0 = só a thread da lógica
+    int attractBotBudgetMs = 2;
+    bool attractLookahead = false;
+    // Hot reload: intervalo do stat dos .cfg/.pieces (0 = desligado)
+    int configWatchMs = 0;
+    // Log (DebugLogger): nível e cópia opcional em arquivo com rotação
+    std::string logLevel = "DEBUG";   // ERROR | WARNING | INFO | DEBUG
+    std::string logFile;              // vazio = só stdout
+    int logFileMaxKb = 1024;          // rotação: passou disso vira .1, .2...
+    int logFileKeep = 3;              // arquivos antigos mantidos
+    // Métricas da máquina (MetricsExporter): "udp://host:porta" (StatsD) ou arquivo; vazio = desligado
+    std::string metricsTarget;
+    std::string metricsPrefix = "dropblocks";
+    int metricsIntervalMs = 10000;
+    int metricsFileMaxKb = 1024;
+};
 
 
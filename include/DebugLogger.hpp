@@ -1,18 +1,86 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <string>
 
+// Nível máximo compilado (0=ERROR .. 3=DEBUG): acima dele as macros DB_LOG_* somem.
+// Release (NDEBUG) corta DEBUG; -DDROPBLOCKS_LOG_MAX_LEVEL=N escolhe outro.
+#ifndef DROPBLOCKS_LOG_MAX_LEVEL
+#  ifdef NDEBUG
+#    define DROPBLOCKS_LOG_MAX_LEVEL 2
+#  else
+#    define DROPBLOCKS_LOG_MAX_LEVEL 3
+#  endif
+#endif
+
+/**
+ * @brief Log com nível, síncrono até startAsync() e assíncrono depois
+ *
+ * No modo assíncrono cada mensagem é copiada para um anel pré-alocado
+ * (lock-free, vários produtores) e uma thread escreve no stdout e no
+ * arquivo opcional, com um fflush por lote; quem loga nunca espera I/O.
+ * Com o anel cheio a mensagem é descartada e a contagem sai no log depois.
+ *
+ * As macros DB_LOG_* testam o nível antes de avaliar o argumento, então
+ * concatenações de std::string só custam quando a mensagem vai sair.
+ */
 class DebugLogger {
 public:
     enum Level { ERROR = 0, WARNING = 1, INFO = 2, DEBUG = 3 };
 
+    static constexpr size_t RING_SIZE = 1024;   ///< registros no anel (potência de 2)
+    static constexpr size_t TEXT_MAX = 240;     ///< bytes por mensagem (o resto é cortado)
+
     static void setEnabled(bool enabled);
     static void setLevel(int level);
+    static int getLevel() { return threshold_.load(std::memory_order_relaxed); }
+    /// true se uma mensagem desse nível sairia (teste barato, sem lock)
+    static bool isEnabled(int level) { return level <= threshold_.load(std::memory_order_relaxed); }
+    /// "ERROR"/"WARNING"/"INFO"/"DEBUG" ou 0-3; false se não reconhecer
+    static bool parseLevel(const std::string& name, int& level);
 
     static void error(const std::string& message);
     static void warning(const std::string& message);
     static void info(const std::string& message);
     static void debug(const std::string& message);
+    static void write(Level level, const char* message, size_t length);
+
+    /// Liga a thread de escrita (registra shutdown() no atexit)
+    static bool startAsync();
+    /// Escreve o que falta no anel e para a thread; volta ao modo síncrono
+    static void shutdown();
+
+    /**
+     * @brief Copia o log para um arquivo (além do stdout)
+     * @param maxBytes rotação: passou disso vira path.1, path.1 vira path.2...
+     * @param keepFiles quantos antigos manter (0 = só trunca)
+     */
+    static bool setLogFile(const std::string& path, size_t maxBytes, int keepFiles);
+
+private:
+    static inline std::atomic<int> threshold_{DEBUG};   ///< -1 = desligado
 };
 
+/// Nível compilado e ligado em runtime (para montar mensagens caras só quando saem)
+#define DB_LOG_ENABLED(level) ((level) <= DROPBLOCKS_LOG_MAX_LEVEL && DebugLogger::isEnabled(level))
+
+#define DB_LOG_AT(level, msg) \
+    do { if (DebugLogger::isEnabled(level)) { const std::string& db_log_msg_ = (msg); DebugLogger::write(level, db_log_msg_.data(), db_log_msg_.size()); } } while (0)
 
+#define DB_LOG_ERROR(msg) DB_LOG_AT(DebugLogger::ERROR, msg)
+#if DROPBLOCKS_LOG_MAX_LEVEL >= 1
+#  define DB_LOG_WARNING(msg) DB_LOG_AT(DebugLogger::WARNING, msg)
+#else
+#  define DB_LOG_WARNING(msg) do { } while (0)
+#endif
+#if DROPBLOCKS_LOG_MAX_LEVEL >= 2
+#  define DB_LOG_INFO(msg) DB_LOG_AT(DebugLogger::INFO, msg)
+#else
+#  define DB_LOG_INFO(msg) do { } while (0)
+#endif
+#if DROPBLOCKS_LOG_MAX_LEVEL >= 3
+#  define DB_LOG_DEBUG(msg) DB_LOG_AT(DebugLogger::DEBUG, msg)
+#else
+#  define DB_LOG_DEBUG(msg) do { } while (0)
+#endif
@@ -2,22 +2,36 @@
 
 #include <SDL2/SDL.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
+class FrameProfiler;
+class LatencyProbe;
+struct StartupTimings;
+namespace AllocCounter { class FrameMeter; }
+
 /**
  * @brief Debug overlay for development
  * 
  * Shows FPS, frame time, and other debug info.
- * Toggle with 'D' key.
+ * Toggle with 'D' key: INFO page -> PERF page (per-phase/layer timings) -> off.
+ * Lines are formatted into frameArena(); the INFO page also shows its high-water mark.
  */
 class DebugOverlay {
 public:
     DebugOverlay() = default;
     
+    enum class Page { INFO, PERF };
+    
     /**
-     * @brief Toggle debug overlay on/off
+     * @brief Cycle the overlay: off -> INFO -> PERF -> off
      */
-    void toggle() { enabled_ = !enabled_; }
+    void toggle();
+    
+    /**
+     * @brief Current page (meaningful while enabled)
+     */
+    Page getPage() const { return page_; }
     
     /**
      * @brief Check if overlay is enabled
@@ -54,9 +68,9 @@ public:
     float getFrameTime() const { return frameTimeMs_; }
     
     /**
-     * @brief Add a custom debug value
+     * @brief Add a custom debug value (copied; a FrameArena::format view is fine)
      */
-    void setCustomValue(const std::string& name, const std::string& value);
+    void setCustomValue(std::string_view name, std::string_view value);
     
     /**
      * @brief Set layout debug information
@@ -65,13 +79,52 @@ public:
                        float scaleX, float scaleY, int offsetX, int offsetY,
                        const std::string& scaleMode);
     
+    /**
+     * @brief Set frame scheduler timings (sub-ms, from the performance counter)
+     */
+    void setFrameTimings(double simMs, double renderMs, double waitMs, int steps,
+                         const std::string& pacing, int targetFps);
+    
+    /**
+     * @brief Set audio command queue occupancy (voices, high water, overflows)
+     */
+    void setAudioStats(int voices, int queued, int capacity, int highWater, unsigned overflows);
+    
     /**
      * @brief Set configuration file debug information
      */
     void setConfigInfo(const std::vector<std::string>& configPaths);
     
+    /**
+     * @brief Source of the PERF page (min/avg/p99/max per section + frame graph)
+     */
+    void setProfiler(const FrameProfiler* profiler) { profiler_ = profiler; }
+    
+    /**
+     * @brief Boot phases listed under the PERF graph (nullptr = hidden)
+     */
+    void setStartupTimings(const StartupTimings* timings) { startup_ = timings; }
+    
+    /**
+     * @brief Input-to-present p50/p99 line on the PERF page (nullptr = hidden)
+     */
+    void setLatencyProbe(const LatencyProbe* probe) { latency_ = probe; }
+    
+    /**
+     * @brief Heap allocations per frame on the INFO page (nullptr = hidden; DROPBLOCKS_ALLOC_TRACKING builds)
+     */
+    void setAllocMeter(const AllocCounter::FrameMeter* meter) { allocs_ = meter; }
+    
 private:
+    static constexpr int PERF_WIDTH = 400;
+    void renderPerfPage(SDL_Renderer* renderer, int x, int y);
+    
     bool enabled_ = false;
+    Page page_ = Page::INFO;
+    const FrameProfiler* profiler_ = nullptr;
+    const StartupTimings* startup_ = nullptr;
+    const LatencyProbe* latency_ = nullptr;
+    const AllocCounter::FrameMeter* allocs_ = nullptr;
     float fps_ = 0.0f;
     float frameTimeMs_ = 0.0f;
     
@@ -97,6 +150,21 @@ private:
     int offsetY_ = 0;
     std::string scaleMode_ = "UNKNOWN";
     
+    // Frame scheduler info
+    double simMs_ = 0.0;
+    double renderMs_ = 0.0;
+    double waitMs_ = 0.0;
+    int simSteps_ = 0;
+    std::string pacing_ = "VSYNC";
+    int targetFps_ = 60;
+    
+    // Audio queue info
+    int audioVoices_ = 0;
+    int audioQueued_ = 0;
+    int audioCapacity_ = 0;
+    int audioHighWater_ = 0;
+    unsigned audioOverflows_ = 0;
+    
     // Config debug info
     std::string configFiles_ = "None";
 };
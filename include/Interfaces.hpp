@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,18 @@ struct InputConfig;
 struct PiecesConfig;
 struct GameConfig;
 enum class RandType; // forward declare to use in interface
+struct DealState;
+
+/**
+ * @brief Ocupação da fila de comandos de áudio (DebugOverlay)
+ */
+struct AudioQueueStats {
+    int activeVoices = 0;
+    int queued = 0;
+    int capacity = 0;
+    int highWater = 0;
+    unsigned overflows = 0;
+};
 
 class IAudioSystem {
 public:
@@ -34,6 +47,9 @@ public:
     virtual void playSweepEffect() = 0;
     virtual void playScanlineEffect() = 0;
     virtual bool loadFromConfig(const std::string& key, const std::string& value) = 0;
+    virtual AudioQueueStats getQueueStats() const { return {}; }
+    /// Faixa de MUSIC_FILE_<N> para o nível (crossfade se mudar); -1 = fade para o silêncio
+    virtual void setMusicLevel(int /*level*/) {}
 };
 
 class IThemeManager {
@@ -59,6 +75,11 @@ public:
     virtual bool loadPiecesFile() = 0;
     virtual void seedFallback() = 0;
     virtual int getCurrentNextPiece() const = 0;
+    // Peça que getNextPiece() devolverá daqui a `ahead` sorteios; -1 = além da fila
+    virtual int peek(int ahead) = 0;
+    // Sorteio em tamanho fixo (GameSnapshot: rewind/retomada); false = não dá para guardar/restaurar
+    virtual bool saveDeal(DealState&) const { return false; }
+    virtual bool restoreDeal(const DealState&) { return false; }
 };
 
 class IInputManager {
@@ -78,6 +99,13 @@ public:
     virtual bool shouldScreenshot() = 0;
     virtual bool shouldToggleDebug() = 0;
     virtual bool shouldToggleTimer() = 0;
+    // Repeating actions: number of DAS/ARR steps elapsed since the last update
+    virtual int moveLeftSteps() { return shouldMoveLeft() ? 1 : 0; }
+    virtual int moveRightSteps() { return shouldMoveRight() ? 1 : 0; }
+    virtual int softDropSteps() { return shouldSoftDrop() ? 1 : 0; }
+    // Performance counter de chegada do evento de ação mais antigo visto pelo
+    // último update() (0 = nenhum); zera ao ler. Só input real tem (LATENCY_PROBE)
+    virtual uint64_t takeInputStamp() { return 0; }
     // System methods
     virtual void update() = 0;
     virtual void resetTimers() = 0;
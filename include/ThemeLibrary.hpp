@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ThemeManager.hpp"
+
+class ConfigManager;
+
+/**
+ * @brief Paletas dos outros .cfg de tema, prontas para trocar em runtime
+ *
+ * load() lê os arquivos uma vez (THEME_FILES ou os *.cfg ao lado da config
+ * carregada) e fica só com as cores, já no formato Theme. Trocar de tema é
+ * só trocar o ponteiro ativo do ThemeManager; o chamador reaplica as cores
+ * das peças e pede o rebake incremental do TextureCache.
+ * A entrada 0 é sempre o tema da própria config.
+ */
+class ThemeLibrary {
+public:
+    /// @param files lista separada por vírgula; vazia = procura os *.cfg
+    void load(const ConfigManager& config, const std::string& files);
+
+    int size() const { return (int)entries_.size() + 1; }
+    int current() const { return current_; }
+    const std::string& name(int index) const;
+
+    /// Ativa a paleta index (0 = a da config); devolve a que ficou
+    int select(ThemeManager& themeManager, int index);
+
+private:
+    struct Entry {
+        std::string name;     // Nome do arquivo sem extensão
+        Theme theme;
+        bool ownPieceColors = false;
+    };
+
+    bool addFile(const std::string& path, const Theme& base);
+
+    std::vector<Entry> entries_;
+    std::string configName_ = "config";
+    int current_ = 0;
+};
@@ -3,6 +3,7 @@
 #include <SDL2/SDL.h>
 #include <vector>
 #include <string>
+#include <tuple>
 
 #include "ConfigTypes.hpp"
 #include "Interfaces.hpp"
@@ -60,15 +61,56 @@ struct Theme {
 
     // piece colors (dynamic, no fixed size)
     std::vector<RGB> piece_colors;
+
+    /// Todas as cores acima (sem piece_colors), para comparar paletas inteiras.
+    /// Cor nova na struct entra aqui também.
+    auto colors() const {
+        return std::tie(bg_r, bg_g, bg_b,
+                        board_empty_r, board_empty_g, board_empty_b,
+                        panel_fill_r, panel_fill_g, panel_fill_b,
+                        panel_outline_r, panel_outline_g, panel_outline_b,
+                        banner_bg_r, banner_bg_g, banner_bg_b,
+                        banner_outline_r, banner_outline_g, banner_outline_b,
+                        banner_text_r, banner_text_g, banner_text_b,
+                        hud_label_r, hud_label_g, hud_label_b,
+                        hud_score_r, hud_score_g, hud_score_b,
+                        hud_lines_r, hud_lines_g, hud_lines_b,
+                        hud_level_r, hud_level_g, hud_level_b,
+                        next_fill_r, next_fill_g, next_fill_b,
+                        next_outline_r, next_outline_g, next_outline_b,
+                        next_label_r, next_label_g, next_label_b,
+                        score_fill_r, score_fill_g, score_fill_b,
+                        score_outline_r, score_outline_g, score_outline_b,
+                        next_grid_dark, next_grid_light,
+                        next_grid_dark_r, next_grid_dark_g, next_grid_dark_b,
+                        next_grid_light_r, next_grid_light_g, next_grid_light_b,
+                        next_grid_use_rgb,
+                        stats_fill_r, stats_fill_g, stats_fill_b,
+                        stats_outline_r, stats_outline_g, stats_outline_b,
+                        stats_label_r, stats_label_g, stats_label_b,
+                        stats_count_r, stats_count_g, stats_count_b,
+                        overlay_fill_r, overlay_fill_g, overlay_fill_b, overlay_fill_a,
+                        overlay_outline_r, overlay_outline_g, overlay_outline_b, overlay_outline_a,
+                        overlay_top_r, overlay_top_g, overlay_top_b,
+                        overlay_sub_r, overlay_sub_g, overlay_sub_b);
+    }
 };
 
 class ThemeManager : public IThemeManager {
 private:
-    Theme theme_;
+    Theme theme_;                 // O da config carregada
+    Theme* active_ = &theme_;     // O que está na tela (ThemeLibrary troca o ponteiro)
 
 public:
-    const Theme& getTheme() const { return theme_; }
-    Theme& getTheme() { return theme_; }
+    ThemeManager() = default;
+    ThemeManager(const ThemeManager&) = delete;
+    ThemeManager& operator=(const ThemeManager&) = delete;
+
+    const Theme& getTheme() const { return *active_; }
+    Theme& getTheme() { return *active_; }
+    /// Paleta ativa; nullptr volta para a da config. Só na thread do render.
+    void setActiveTheme(Theme* theme) { active_ = theme ? theme : &theme_; }
+    Theme& getConfigTheme() { return theme_; }
 
     void initDefaultPieceColors();
 
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "app/GameTypes.hpp"
+
+class GameBoard;
+class WorkStealingPool;
+
+/**
+ * @brief Pesos da avaliação de um tabuleiro (maior = melhor)
+ *
+ * Padrão: pesos de Yiyuan Lee, afinados para limpar linhas e sobreviver.
+ */
+struct BotWeights {
+    float aggregateHeight = -0.510066f;   ///< soma das alturas das colunas
+    float lines = 0.760666f;              ///< linhas limpas pela jogada
+    float holes = -0.35663f;              ///< vazios com bloco acima
+    float bumpiness = -0.184483f;         ///< soma de |h[x] - h[x+1]|
+};
+
+/**
+ * @brief Tabuleiro de busca: só as máscaras de linha (bit x = coluna x)
+ */
+struct BotBoard {
+    static constexpr int MAX_ROWS = 64;
+    uint32_t rows[MAX_ROWS];
+
+    static bool supported();   ///< COLS <= 32 e ROWS <= MAX_ROWS
+    void load(const GameBoard& board);
+    /// Trava a peça e limpa as linhas cheias; false se ficou célula acima do topo
+    bool lock(const Active& piece, int& cleared);
+};
+
+/**
+ * @brief Estatísticas da última busca
+ */
+struct BotSearchStats {
+    int candidates = 0;          ///< colocações da peça atual
+    int lookaheadDone = 0;       ///< quantas tiveram a próxima peça avaliada
+    double ms = 0.0;
+    int transpositions = 0;      ///< colocações que deram num tabuleiro já visto (ramo reaproveitado)
+};
+
+/**
+ * @brief Busca de colocação: enumera, avalia e escolhe onde travar a peça
+ *
+ * As colocações são os estados finais alcançáveis a partir do spawn por
+ * esquerda/direita/queda/rotação, com rotação pelas mesmas regras de kick do
+ * jogo (rotateWithKicks sobre máscaras), então inclui encaixes por baixo e
+ * giros com kick. A avaliação usa a próxima peça como lookahead (só quedas
+ * retas, ~10x mais barato que a busca completa), com um ramo por colocação
+ * no WorkStealingPool, do melhor chute para o pior. Colocações que travam
+ * no mesmo tabuleiro (mesmo hash Zobrist, ex.: giros simétricos do O/I/S/Z)
+ * dividem um ramo só. Se o orçamento de tempo estourar, vale o melhor entre
+ * os ramos já completos.
+ */
+class BotEngine {
+public:
+    /// threads: workers do pool (< 0 = núcleos - 1, 0 = só a thread chamadora)
+    explicit BotEngine(int threads = -1);
+    ~BotEngine();
+
+    void setWeights(const BotWeights& w) { weights_ = w; }
+    const BotWeights& getWeights() const { return weights_; }
+    void setLookahead(bool on) { lookahead_ = on; }
+    /// Orçamento por jogada (ms); 0 = sem limite
+    void setBudgetMs(double ms) { budgetMs_ = ms; }
+    int concurrency() const;
+
+    /**
+     * @brief Escolhe onde travar current; nextIdx < 0 desliga o lookahead
+     * @return false se não há colocação (peça já colide no spawn)
+     */
+    bool findBest(const GameBoard& board, const Active& current, int nextIdx,
+                  Active& out, BotSearchStats* stats = nullptr);
+
+    /// Estados finais (peça apoiada) alcançáveis a partir de from, sem repetidos
+    static void enumeratePlacements(const BotBoard& board, const Active& from, std::vector<Active>& out);
+
+    /// Só rotação + coluna + queda reta a partir da linha de from (lookahead barato)
+    static void enumerateDrops(const BotBoard& board, const Active& from, std::vector<Active>& out);
+
+    /**
+     * @brief Ações (SyntheticInput::Action) que levam from até target
+     *
+     * Uma ação por tick; termina em HARD_DROP quando a queda a partir do
+     * último estado cai em target. false se target não é alcançável.
+     */
+    static bool planPath(const BotBoard& board, const Active& from, const Active& target,
+                         std::vector<uint16_t>& actions);
+
+    float evaluate(const BotBoard& board, int linesCleared) const;
+
+private:
+    // Corpo de findBest/evaluate com o tamanho do tabuleiro fixado (game/BoardDims.hpp)
+    template <class Dims>
+    bool findBestIn(Dims dims, const GameBoard& board, const Active& current, int nextIdx,
+                    Active& out, BotSearchStats* stats);
+    template <class Dims>
+    float evaluateIn(Dims dims, const BotBoard& board, int linesCleared) const;
+
+    BotWeights weights_;
+    bool lookahead_ = true;
+    double budgetMs_ = 10.0;
+    std::unique_ptr<WorkStealingPool> pool_;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Pool de threads com filas por worker e roubo de tarefas
+ *
+ * parallelFor() distribui os índices em round-robin pelas filas (a thread
+ * chamadora tem a sua e também trabalha); cada worker consome a própria
+ * fila pelo fim e, vazia, rouba do começo das outras. Assim tarefas de custo
+ * desigual (ramos de lookahead com muitas ou poucas colocações) se equilibram
+ * sem um escalonador central. Um parallelFor por vez.
+ */
+class WorkStealingPool {
+public:
+    using Task = void (*)(void* ctx, int index);
+
+    /// threads = workers além da thread chamadora (até 63); < 0 = núcleos - 1, até 15
+    explicit WorkStealingPool(int threads = -1);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /// Executa task(ctx, i) para i em [0, count) e espera todas terminarem
+    void parallelFor(int count, Task task, void* ctx);
+
+    template <typename F>
+    void parallelFor(int count, F& body) {
+        parallelFor(count, [](void* c, int i) { (*static_cast<F*>(c))(i); }, &body);
+    }
+
+    /// Workers + a thread chamadora
+    int concurrency() const { return (int)threads_.size() + 1; }
+    /// Tarefas executadas fora da fila de origem (diagnóstico)
+    unsigned stolenCount() const { return stolen_.load(std::memory_order_relaxed); }
+
+private:
+    struct Queue {
+        SDL_SpinLock lock = 0;
+        std::vector<int> items;
+        size_t head = 0;   // Próximo a ser roubado
+    };
+
+    static int SDLCALL workerMain(void* self);
+    void workerLoop(int slot);
+    bool runOne(int slot);
+    bool popLocal(int slot, int& index);
+    bool steal(int thief, int& index);
+
+    std::vector<SDL_Thread*> threads_;
+    std::vector<Queue> queues_;          // [0] = thread chamadora
+    Task task_ = nullptr;
+    void* ctx_ = nullptr;
+    std::atomic<int> remaining_{0};
+    std::atomic<unsigned> stolen_{0};
+    std::atomic<int> nextSlot_{1};       // Slot de cada worker na partida
+
+    SDL_mutex* mutex_ = nullptr;
+    SDL_cond* wake_ = nullptr;
+    unsigned generation_ = 0;            // Protegido por mutex_
+    bool quit_ = false;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include "app/Metrics.hpp"
+
+// Build opt-in: -DDROPBLOCKS_ALLOC_TRACKING=1 substitui o operator new/delete
+// globais por versões que contam (AllocCounter.cpp); sem o flag nada é instalado
+#ifndef DROPBLOCKS_ALLOC_TRACKING
+#define DROPBLOCKS_ALLOC_TRACKING 0
+#endif
+
+/**
+ * @brief Contagem de alocações do heap via operator new
+ *
+ * Contadores atômicos (relaxed) do processo inteiro e thread_local da thread
+ * atual, só incrementados: uma leitura antes e outra depois de um trecho dão
+ * quantas alocações ele fez. O operator delete só conta quantos blocos voltaram
+ * (liveBlocks()). Sem DROPBLOCKS_ALLOC_TRACKING tudo lê zero.
+ * new alinhado (alignas > __STDCPP_DEFAULT_NEW_ALIGNMENT__) não passa por aqui.
+ */
+namespace AllocCounter {
+
+struct Counts {
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+};
+
+inline Counts operator-(const Counts& a, const Counts& b) { return Counts{a.allocs - b.allocs, a.bytes - b.bytes}; }
+inline Counts& operator+=(Counts& a, const Counts& b) { a.allocs += b.allocs; a.bytes += b.bytes; return a; }
+
+constexpr bool enabled() { return DROPBLOCKS_ALLOC_TRACKING != 0; }
+/// Desde o início, todas as threads
+Counts process();
+/// Desde o início, só a thread que chama
+Counts thread();
+/// Blocos do operator new ainda não devolvidos (o soak procura crescimento aqui)
+uint64_t liveBlocks();
+
+/**
+ * @brief Alocações por frame da thread de render (overlay de debug e Metrics)
+ *
+ * beginFrame()/endFrame() delimitam o frame; pause()/resume() tiram um trecho
+ * da conta (o próprio overlay, que formata strings). O total do processo
+ * inclui a simulação e o áudio; o trecho pausado sai dos dois números.
+ */
+class FrameMeter {
+public:
+    FrameMeter();
+
+    void beginFrame();
+    void pause();
+    void resume();
+    /// Fecha o frame e publica frame_allocs/frame_alloc_bytes
+    void endFrame();
+
+    const Counts& last() const { return last_; }               ///< thread de render
+    const Counts& lastProcess() const { return lastProcess_; } ///< todas as threads
+    uint64_t peakAllocs() const { return peak_; }              ///< maior last().allocs visto
+
+private:
+    Counts threadStart_, processStart_, pausedAt_, excluded_;
+    Counts last_, lastProcess_;
+    uint64_t peak_ = 0;
+    bool paused_ = false;
+    Metrics::Id mAllocs_, mBytes_, mProcess_;
+};
+
+} // namespace AllocCounter
@@ -1,13 +1,12 @@
 #pragma once
 #include <SDL2/SDL.h>
 
-class AudioSystem;
-
 struct ComboSystem {
     int combo = 0;
     Uint32 lastClear = 0;
 
-    void onLineClear(AudioSystem& audio);
+    /// Conta a limpeza e devolve o combo atual (o som sai do evento LINES_CLEARED)
+    int onLineClear(Uint32 now);
     void reset();
 };
 
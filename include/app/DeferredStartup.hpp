@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+class AudioSystem;
+class InputManager;
+class ConfigManager;
+struct StartupTimings;
+
+/**
+ * @brief Segundo estágio do boot: o que fica pronto depois do primeiro frame
+ *
+ * GameInitializer apresenta fundo + banner assim que o renderer existe e
+ * entrega o resto aqui: o dispositivo de áudio e o banco de SFX abrem numa
+ * thread (AudioSystem::startAsync) e os joysticks entram no primeiro update()
+ * (SDL_InitSubSystem e a varredura de controles ficam na thread principal).
+ * GameLoop chama update() uma vez por frame e reage ao que ficou pronto; o
+ * cache de texturas dos painéis ele mesmo aquece depois do primeiro Present.
+ */
+class DeferredStartup {
+public:
+    enum Item : unsigned {
+        AUDIO     = 1u << 0,
+        JOYSTICKS = 1u << 1,
+    };
+
+    /// Dispara o áudio; timings (opcional) recebe as fases conforme terminam
+    void begin(AudioSystem& audio, InputManager& input, ConfigManager& config, StartupTimings* timings);
+
+    /// Thread principal, uma vez por frame; devolve os itens que terminaram agora
+    unsigned update();
+
+    bool isPending() const { return pending_ != 0; }
+    unsigned finished() const { return done_; }
+
+private:
+    void addPhase(const char* name, double ms, bool worker);
+    void startJoysticks();
+
+    AudioSystem* audio_ = nullptr;
+    InputManager* input_ = nullptr;
+    ConfigManager* config_ = nullptr;
+    StartupTimings* timings_ = nullptr;
+    unsigned pending_ = 0;
+    unsigned done_ = 0;
+    Uint64 beginTicks_ = 0;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Bump allocator do frame: rascunho de layers e overlay, zerado no topo do GameLoop
+ *
+ * allocate() só anda um ponteiro; reset() volta ao início sem liberar nada.
+ * Quando o bloco enche, o excesso vai para blocos extras do heap (o frame
+ * nunca falha) e o próximo reset() cresce o bloco principal para o pico
+ * visto, então o regime volta a zero alocações. Só a thread de render usa:
+ * a simulação (THREADED_MODE) nunca toca a arena.
+ *
+ * Nada alocado aqui sobrevive ao frame: não guarde ponteiros, string_view
+ * ou containers com ArenaAllocator em membros.
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 64 * 1024);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t));
+
+    template <class T>
+    T* allocArray(size_t n) { return static_cast<T*>(allocate(n * sizeof(T), alignof(T))); }
+
+    /// printf num trecho da arena; a view vale até o próximo reset()
+    std::string_view format(const char* fmt, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    /// Início do frame: descarta tudo e, se houve estouro, cresce o bloco principal
+    void reset();
+    /// Troca a capacidade (FRAME_ARENA_KB); só entre frames
+    void reserve(size_t capacity);
+
+    size_t used() const { return used_ + spilledBytes_; }           ///< frame atual
+    size_t highWater() const { return highWater_; }                  ///< maior used() desde o início
+    size_t capacity() const { return capacity_; }
+    uint32_t overflows() const { return overflows_; }                ///< frames que precisaram de blocos extras
+
+private:
+    void* spill(size_t bytes, size_t align);
+
+    unsigned char* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t highWater_ = 0;
+    size_t spilledBytes_ = 0;
+    uint32_t overflows_ = 0;
+    std::vector<void*> spills_;
+};
+
+/// Arena do render (uma só; reset em GameLoop e no loop de split screen)
+FrameArena& frameArena();
+
+/**
+ * @brief Adaptador STL sobre FrameArena (deallocate é no-op)
+ *
+ * std::vector<SDL_Rect, ArenaAllocator<SDL_Rect>> v{ArenaAllocator<SDL_Rect>(arena)};
+ */
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(FrameArena& arena) noexcept : arena_(&arena) {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t n) { return arena_->allocArray<T>(n); }
+    void deallocate(T*, size_t) noexcept {}
+
+    FrameArena* arena() const noexcept { return arena_; }
+
+private:
+    FrameArena* arena_;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept { return a.arena() == b.arena(); }
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept { return a.arena() != b.arena(); }
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+#include "app/FrameProfiler.hpp"
+
+class ConfigManager;
+
+/**
+ * @brief Opções do --bench-frames (linha de comando)
+ */
+struct FrameBenchOptions {
+    std::string replayFile;                      ///< Obrigatório: a mesma partida em toda config
+    std::string jsonPath = "bench-frames.json";
+    std::vector<std::string> configs;            ///< Vazio = todo *.cfg do diretório atual
+    int maxFrames = 0;                           ///< 0 = o replay inteiro
+};
+
+/**
+ * @brief Config de uma rodada por cima do .cfg: FRAME_PACING=UNCAPPED (renderer
+ * sem PRESENTVSYNC), o replay em REALTIME e nada que espere, grave ou mude a
+ * carga sozinho (idle, attract, governor, threads extras, capturas, rede)
+ *
+ * Vai por setOverride(): precisa valer antes de o renderer ser criado.
+ */
+void setFrameBenchOverrides(ConfigManager& configManager, const FrameBenchOptions& options);
+
+/**
+ * @brief Medição de uma rodada do --bench-frames (uma config, um processo)
+ *
+ * O GameLoop roda como timedemo: passos fixos por frame (um frame de
+ * TARGET_FPS de partida), então o frame N mostra o mesmo momento do replay
+ * em qualquer máquina e só o tempo para chegar nele muda. Os WARMUP_FRAMES
+ * primeiros (painéis assando, atlas, caches) ficam fora. Frame: avg/p50/p99/max
+ * de um FrameHistogram; draw calls por frame (DrawCalls); CPU por seção do
+ * FrameProfiler (Update, Input, Render, Present e cada layer), em ms por frame.
+ */
+class FrameBench {
+public:
+    static constexpr int WARMUP_FRAMES = 60;
+
+    explicit FrameBench(int maxFrames = 0) : maxFrames_(maxFrames) {}
+
+    /// Entrada do loop: o profiler vive até end()
+    void begin(FrameProfiler* profiler, int stepsPerFrame);
+    void onFrame(double frameMs, unsigned drawCalls);
+    /// --frames atingido
+    bool full() const { return maxFrames_ > 0 && (int)frames_.count() >= maxFrames_; }
+    /// Saída do loop: copia os totais por seção (o profiler morre com o GameLoop)
+    void end(bool replayFinished);
+
+    uint64_t frames() const { return frames_.count(); }
+    /// Objeto JSON da rodada (o processo pai junta um por config)
+    bool writeJson(const std::string& path, const ConfigManager& configManager, SDL_Renderer* renderer) const;
+
+private:
+    struct Section {
+        std::string name;
+        double msPerFrame;
+    };
+
+    int maxFrames_ = 0;
+    int stepsPerFrame_ = 0;
+    int warmup_ = 0;
+    FrameProfiler* profiler_ = nullptr;
+    FrameHistogram frames_;
+    uint64_t drawSum_ = 0;
+    unsigned drawMax_ = 0;
+    Uint64 startTicks_ = 0;
+    double wallMs_ = 0.0;
+    bool replayFinished_ = false;
+    std::vector<Section> sections_;
+};
+
+/**
+ * @brief Modo --bench-frames: uma rodada por config, cada uma num processo novo
+ *
+ * O jogo não foi feito para reinicializar dentro do mesmo processo (globais
+ * de tema, peças, caches), então o executável chama a si mesmo com
+ * DROPBLOCKS_CFG apontando para cada .cfg e junta os objetos no JSON final.
+ * @return 0 = todas as rodadas terminaram, 1 = alguma falhou (ou nenhuma config/replay)
+ */
+int runFrameBenchmarks(const std::string& executable, const FrameBenchOptions& options);
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief min / média / p50 / p99 / max de uma janela de amostras (ms)
+ */
+struct PhaseStats {
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    double lastMs = 0.0;
+};
+
+/**
+ * @brief Janela circular de amostras com estatísticas sob demanda
+ *
+ * add() é O(1); stats() ordena uma cópia da janela e só é chamado quando o
+ * overlay está visível.
+ */
+class RollingStat {
+public:
+    static constexpr int WINDOW = 240;   // ~4 s a 60 FPS
+
+    void add(double ms);
+    PhaseStats stats() const;
+    void clear() { count_ = 0; head_ = 0; }
+
+    int count() const { return count_; }
+    /// i = 0 é a amostra mais antiga da janela
+    float sample(int i) const { return samples_[(head_ - count_ + i + WINDOW) % WINDOW]; }
+
+private:
+    float samples_[WINDOW] = {0};
+    int head_ = 0;
+    int count_ = 0;
+};
+
+/**
+ * @brief Histograma dos tempos de frame de uma sessão inteira (--soak, --bench-frames)
+ *
+ * Baldes fixos de BUCKET_MS: add() é O(1) e nada aloca depois do construtor.
+ * Os percentis saem com a resolução do balde (limite superior); acima do
+ * último só o máximo é exato.
+ */
+class FrameHistogram {
+public:
+    static constexpr double BUCKET_MS = 0.1;
+    static constexpr int BUCKETS = 2000;
+
+    FrameHistogram() : buckets_(BUCKETS, 0u) {}
+    void add(double ms);
+    void clear();
+
+    uint64_t count() const { return count_; }
+    double avgMs() const { return count_ ? sum_ / (double)count_ : 0.0; }
+    double maxMs() const { return max_; }
+    /// fraction 0.5 = p50, 0.99 = p99; 0 sem amostras
+    double percentileMs(double fraction) const;
+
+private:
+    std::vector<uint32_t> buckets_;
+    uint64_t count_ = 0;
+    double sum_ = 0.0;
+    double max_ = 0.0;
+};
+
+/**
+ * @brief Tempos por fase/layer do frame, medidos com o performance counter
+ *
+ * Cada seção registrada acumula record() durante o frame; endFrame() fecha o
+ * frame, empurra os totais para as janelas e, com PROFILE_CSV, grava uma
+ * linha por frame (frame, frame_ms, uma coluna por seção).
+ */
+class FrameProfiler {
+public:
+    ~FrameProfiler() { closeCsv(); }
+
+    /// Registra (ou reencontra) uma seção pelo nome; devolve o índice
+    int addSection(const std::string& name);
+    int sectionCount() const { return (int)sections_.size(); }
+    const std::string& sectionName(int idx) const { return sections_[idx].name; }
+
+    /// Soma ms à seção no frame corrente (várias chamadas por frame somam)
+    void record(int idx, double ms) { if (idx >= 0 && idx < (int)sections_.size()) sections_[idx].pending += ms; }
+    void recordTicks(int idx, Uint64 ticks) { record(idx, ticksToMs(ticks)); }
+
+    /// Fecha o frame: totais vão para as janelas (e para o CSV)
+    void endFrame(double frameMs);
+
+    PhaseStats sectionStats(int idx) const { return sections_[idx].window.stats(); }
+    /// Soma da seção desde resetTotals() (média por frame = total / totalFrames())
+    double sectionTotalMs(int idx) const { return sections_[idx].totalMs; }
+    Uint64 totalFrames() const { return totalFrames_; }
+    void resetTotals();
+    PhaseStats frameStats() const { return frame_.stats(); }
+    const RollingStat& frameHistory() const { return frame_; }
+
+    /// Inicia o dump CSV (fechando um anterior); false se não abriu
+    bool openCsv(const std::string& path);
+    void closeCsv();
+    bool isCsvOpen() const { return csv_.is_open(); }
+
+    static double ticksToMs(Uint64 ticks) {
+        static const double msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+        return (double)ticks * msPerTick;
+    }
+
+private:
+    struct Section {
+        std::string name;
+        double pending = 0.0;
+        RollingStat window;
+        double totalMs = 0.0;
+    };
+
+    void writeCsvHeader();
+
+    std::vector<Section> sections_;
+    RollingStat frame_;
+    Uint64 frameIndex_ = 0;
+    Uint64 totalFrames_ = 0;
+
+    std::ofstream csv_;
+    bool csvHeaderDone_ = false;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <string>
+
+/**
+ * @brief Modo de ritmo dos frames
+ *
+ * VSYNC: Present bloqueia no refresh do display (renderer com PRESENTVSYNC).
+ * CAPPED: dorme até o prazo do TARGET_FPS depois do Present.
+ * UNCAPPED: sem espera.
+ * LOW_LATENCY: como CAPPED, mas a espera vem ANTES de ler input/simular
+ * (late-latch), usando a média do custo do frame para acordar em cima da hora.
+ */
+enum class FramePacing { VSYNC, CAPPED, UNCAPPED, LOW_LATENCY };
+
+FramePacing parseFramePacing(const std::string& value);
+const char* framePacingName(FramePacing mode);
+
+/** @brief Tempos do último frame em ms (resolução do performance counter) */
+struct FrameTimings {
+    double frameMs = 0.0;    // início a início
+    double simMs = 0.0;      // passos fixos da simulação
+    double renderMs = 0.0;   // layers + overlay (antes do Present)
+    double waitMs = 0.0;     // Present + sleep/spin de pacing
+    int steps = 0;           // passos de simulação neste frame
+};
+
+/**
+ * @brief Agenda frames com SDL_GetPerformanceCounter e um acumulador de passo fixo
+ *
+ * A lógica avança sempre em passos de stepMs, independente da taxa do
+ * display; o acumulador é limitado para não cair em espiral depois de um
+ * travamento (o tempo excedente é descartado).
+ */
+class FrameScheduler {
+public:
+    static constexpr double MAX_ACCUMULATED_MS = 250.0;
+
+    FrameScheduler();
+
+    void configure(FramePacing mode, int targetFps, int stepMs);
+    FramePacing getMode() const { return mode_; }
+    int getStepMs() const { return stepMs_; }
+
+    /** @brief Zera o acumulador (início do loop ou depois de uma pausa longa) */
+    void start();
+
+    /** @brief LOW_LATENCY: dorme até pouco antes do prazo; nos outros modos não faz nada */
+    void waitBeforeFrame();
+
+    /**
+     * @brief Passos por frame fixos, sem olhar o relógio (timedemo do --bench-frames)
+     *
+     * Cada frame mostra o mesmo ponto da partida em qualquer máquina; 0 volta ao acumulador.
+     */
+    void setFixedSteps(int steps) { fixedSteps_ = std::max(0, steps); }
+
+    /** @brief Marca o início do frame e retorna quantos passos fixos simular */
+    int beginFrame();
+    void markSimDone();
+    void markRenderDone();
+    /** @brief Depois do Present: CAPPED dorme até o prazo; fecha os tempos do frame */
+    void endFrame();
+
+    const FrameTimings& timings() const { return timings_; }
+    double ticksToMs(Uint64 ticks) const { return (double)ticks * 1000.0 / (double)freq_; }
+
+private:
+    FramePacing mode_ = FramePacing::VSYNC;
+    int stepMs_ = 4;
+    Uint64 freq_ = 1;
+    Uint64 frameTicks_ = 0;       // duração alvo do frame (0 = sem alvo)
+    Uint64 frameStart_ = 0, lastFrameStart_ = 0, simEnd_ = 0, renderEnd_ = 0;
+    Uint64 nextDeadline_ = 0;
+    double accumulatorMs_ = 0.0;
+    int fixedSteps_ = 0;
+    double workEmaMs_ = 0.0;      // custo médio de sim+render (late-latch)
+    FrameTimings timings_;
+
+    void sleepUntil(Uint64 target) const;
+};
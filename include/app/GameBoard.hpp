@@ -1,23 +1,114 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include "app/GameTypes.hpp"
 
-class AudioSystem;
+class IAudioSystem;
 
+/**
+ * @brief Tabuleiro com ocupação em bitboard
+ *
+ * Cada linha guarda sua ocupação numa máscara (bit x = coluna x) e as cores
+ * ficam num array plano ao lado. As linhas de cor são endereçadas por uma
+ * indireção (linha lógica -> slot físico), então limpar linhas só compacta
+ * índices: nada é alocado e nenhuma linha de cor é copiada.
+ *
+ * Alturas de coluna, contagem por linha e o nível de tensão são mantidos
+ * incrementalmente em placePiece()/clearLines(), para que tensão, distância
+ * de hard drop/ghost e detecção de linha cheia sejam consultas O(1)/O(COLS).
+ *
+ * getGrid() continua disponível como view de compatibilidade; ela é
+ * reconstruída sob demanda depois de uma limpeza.
+ *
+ * O hash Zobrist (getHash()) também é incremental: lock liga as chaves das
+ * células novas; clear tira e recoloca só as linhas que desceram; lixo e
+ * reset recalculam.
+ *
+ * O tamanho vem de COLS/ROWS na construção ou de resize() (BOARD_COLS/ROWS).
+ * Os laços por linha/coluna são instanciados para os tamanhos comuns (10x20,
+ * 10x40, 20x20) com limites constantes; qualquer outro usa a versão genérica.
+ */
 class GameBoard {
+public:
+    using RowMask = uint32_t;   ///< suporta até 32 colunas
+
 private:
-    std::vector<std::vector<Cell>> grid_;
+    std::vector<RowMask> rows_;                 ///< ocupação por linha lógica
+    std::vector<int> slot_;                     ///< linha lógica -> slot em cells_
+    std::vector<Cell> cells_;                   ///< cores, índice slot*COLS + x
+    std::vector<int> clearedRows_;              ///< linhas removidas na última limpeza
+    std::vector<int> freeSlots_;                ///< scratch de clearLines (reservado)
+    std::vector<int> colHeight_;                ///< altura de cada coluna (0 = vazia)
+    std::vector<int> rowFill_;                  ///< células ocupadas por linha
+    int fullRows_ = 0;                          ///< linhas cheias pendentes
+    int tension_ = 0;                           ///< cache de getTensionLevel()
+    uint32_t version_ = 1;                      ///< muda a cada lock/clear/reset
+    uint64_t hash_ = 0;                         ///< Zobrist das células ocupadas
+    RowMask fullRow_ = 0;
+    int width_ = 0, height_ = 0;
+
+    void recomputeHeights();
+    void recomputeTension();
+
+    // View legada (somente leitura), refeita quando gridDirty_
+    mutable std::vector<std::vector<Cell>> grid_;
+    mutable bool gridDirty_ = false;
+
 public:
-    GameBoard() : grid_(ROWS, std::vector<Cell>(COLS)) {}
-    const std::vector<std::vector<Cell>>& getGrid() const { return grid_; }
-    std::vector<std::vector<Cell>>& getGrid() { return grid_; }
+    GameBoard();
+
+    /** @brief Novo tamanho (limitado a MIN/MAX_BOARD_*); esvazia o tabuleiro */
+    void resize(int cols, int rows);
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    const std::vector<std::vector<Cell>>& getGrid() const;
+
+    // Acesso direto ao bitboard
+    const RowMask* rowMasks() const { return rows_.data(); }
+    RowMask rowMask(int y) const { return rows_[y]; }
+    RowMask fullRowMask() const { return fullRow_; }
+    bool isOccupied(int x, int y) const { return (rows_[y] >> x) & 1u; }
+    const Cell& cellAt(int x, int y) const { return cells_[slot_[y] * width_ + x]; }
+    /// Plano de cores cru: célula (x, y) = cellData()[rowSlots()[y] * width() + x]
+    const Cell* cellData() const { return cells_.data(); }
+    const int* rowSlots() const { return slot_.data(); }
+
+    /** @brief Contador de mudanças do stack travado (para caches de render) */
+    uint32_t getVersion() const { return version_; }
+    /** @brief Hash Zobrist do stack travado (mesmo valor em qualquer máquina) */
+    uint64_t getHash() const { return hash_; }
+
+    // Estatísticas incrementais
+    int getColumnHeight(int x) const { return colHeight_[x]; }
+    int getRowFill(int y) const { return rowFill_[y]; }
+    int getMaxHeight() const;
+    /** @brief Quantas linhas a peça pode descer (hard drop / ghost) */
+    int dropDistance(const Active& piece) const;
+    int ghostY(const Active& piece) const { return piece.y + dropDistance(piece); }
+
     bool canPlacePiece(const Active& piece, int dx, int dy, int drot) const;
     void placePiece(const Active& piece);
     int clearLines();
+    /** @brief Linhas (índices antes da limpeza, de baixo para cima) removidas no último clearLines() */
+    const std::vector<int>& getLastClearedRows() const { return clearedRows_; }
     bool isGameOver(const Active& piece) const;
+    /**
+     * @brief Empurra o stack `lines` linhas para cima e preenche o fundo com lixo
+     *
+     * Linhas cheias exceto a coluna holeCol (netplay). true se alguma célula
+     * ocupada saiu pelo topo.
+     */
+    bool addGarbage(int lines, int holeCol, const Cell& color);
+    /**
+     * @brief Copia um stack inteiro (GameSnapshot) sobre o atual, sem alocar
+     *
+     * masks/cells em ordem lógica, cells com cellStride células por linha; o
+     * tamanho tem que ser o do tabuleiro. Slots voltam à identidade e as
+     * estatísticas incrementais (alturas, tensão, hash) são recalculadas.
+     */
+    void restore(const RowMask* masks, const Cell* cells, int cellStride);
     void reset();
     int getTensionLevel() const;
-    void checkTension(AudioSystem& audio) const;
+    void checkTension(IAudioSystem& audio) const;
 };
-
-
@@ -0,0 +1,32 @@
+#pragma once
+#include <SDL2/SDL.h>
+
+/**
+ * @brief Fonte de tempo (ms) injetável na lógica do jogo
+ *
+ * O jogo usa SdlClock; a simulação headless usa ManualClock, avançado em
+ * passos fixos, para rodar mais rápido que o tempo real e de forma
+ * determinística.
+ */
+class IGameClock {
+public:
+    virtual ~IGameClock() = default;
+    virtual Uint32 nowMs() const = 0;
+};
+
+class SdlClock : public IGameClock {
+public:
+    Uint32 nowMs() const override { return SDL_GetTicks(); }
+};
+
+class ManualClock : public IGameClock {
+private:
+    Uint32 now_ = 0;
+public:
+    Uint32 nowMs() const override { return now_; }
+    void set(Uint32 ms) { now_ = ms; }
+    void advance(Uint32 ms) { now_ += ms; }
+};
+
+/** @brief Relógio padrão (SDL_GetTicks) compartilhado */
+IGameClock& systemClock();
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+class IAudioSystem;
+
+/**
+ * @brief O que a partida fez num passo da simulação
+ */
+enum class GameEventType : Uint8 {
+    ROUND_STARTED,   ///< restartRound()
+    PAUSED,          ///< count = 1 pausou, 0 voltou
+    MOVED,           ///< count = colunas andadas no passo (esquerda + direita)
+    SOFT_DROP,       ///< count = linhas pedidas pelo soft drop
+    HARD_DROP,       ///< count = linhas que a peça caiu
+    KICKED,          ///< A rotação só coube com deslocamento; count = direção (+1 horário)
+    ROTATED,         ///< count = direção; value = 1 se a peça girou (0 = bloqueada)
+    LOCKED,          ///< A peça travou
+    LINES_CLEARED,   ///< count = linhas; value = combo
+    LEVEL_UP,        ///< value = nível novo
+    GAME_OVER        ///< Estouro do stack (lock ou lixo do versus)
+};
+
+/**
+ * @brief Evento POD da fila: cabe em 8 bytes, copiado por valor
+ */
+struct GameEvent {
+    GameEventType type = GameEventType::LOCKED;
+    Sint8 piece = -1;   ///< Índice em PIECES da peça ativa (ou da que travou)
+    Sint8 count = 0;    ///< Ver GameEventType
+    Sint8 pad = 0;
+    Sint16 value = 0;   ///< Ver GameEventType
+    Uint16 atMs = 0;    ///< 16 bits baixos do relógio da partida: ordem dentro do lote
+};
+
+/**
+ * @brief Assinante da fila: recebe o lote inteiro de uma vez, na ordem em que aconteceu
+ */
+class IGameEventListener {
+public:
+    virtual ~IGameEventListener() = default;
+    virtual void onGameEvents(const GameEvent* events, int count) = 0;
+};
+
+/**
+ * @brief Fila de eventos da partida: enchida nos passos, esvaziada uma vez por frame
+ *
+ * A lógica só faz push() (um store num array fixo, sem alocação nem chamada
+ * virtual); quem roda o frame chama dispatch() depois dos passos e cada
+ * assinante vê o lote todo. Fila cheia antes do dispatch (lote de recuperação,
+ * headless sem frame) entrega na hora: nada se perde.
+ */
+class GameEventQueue {
+public:
+    static constexpr int CAPACITY = 128;
+    static constexpr int MAX_LISTENERS = 8;
+
+    void push(const GameEvent& ev) {
+        if (count_ == CAPACITY) dispatch();
+        events_[count_++] = ev;
+    }
+
+    /// Entrega o lote pendente a todos os assinantes e esvazia a fila
+    void dispatch();
+    /// Descarta sem entregar (restart de sessão, restore)
+    void clear() { count_ = 0; }
+    int pending() const { return count_; }
+
+    /// false se já há MAX_LISTENERS; o mesmo listener não entra duas vezes
+    bool subscribe(IGameEventListener* listener);
+    void unsubscribe(IGameEventListener* listener);
+
+private:
+    GameEvent events_[CAPACITY];
+    int count_ = 0;
+    IGameEventListener* listeners_[MAX_LISTENERS] = {};
+    int listenerCount_ = 0;
+};
+
+/**
+ * @brief Sons da partida a partir dos eventos (os mesmos que a lógica tocava direto)
+ *
+ * Música por nível, SFX de movimento/rotação/kick/drop, lock, linhas, combo e
+ * game over. Sons ambientes (tensão, melodia) continuam no timer da partida.
+ */
+class GameAudioEvents : public IGameEventListener {
+public:
+    void setAudio(IAudioSystem* audio) { audio_ = audio; }
+    void onGameEvents(const GameEvent* events, int count) override;
+
+private:
+    IAudioSystem* audio_ = nullptr;
+};
+
+/**
+ * @brief Contadores pieces_locked e lines_cleared do Metrics, um add por lote
+ */
+class GameMetricsEvents : public IGameEventListener {
+public:
+    void onGameEvents(const GameEvent* events, int count) override;
+};
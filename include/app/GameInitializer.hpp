@@ -1,11 +1,14 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include "app/StartupTimings.hpp"
+#include "app/DeferredStartup.hpp"
 
 class AudioSystem;
 class InputManager;
 class ConfigManager;
 class GameState;
+struct GameConfig;
 
 /**
  * @brief Utility functions for game initialization
@@ -24,10 +27,27 @@ namespace GameInit {
     bool initializeWindow(SDL_Window*& win, SDL_Renderer*& ren);
     
     /**
-     * @brief Initialize game configuration and apply to all systems
+     * @brief Init the joystick subsystem and add a JoystickInput (connected now or on hot-plug)
+     */
+    bool initializeJoysticks(InputManager& inputManager);
+    
+    /**
+     * @brief Initialize game configuration and apply to all systems (loadGameData + applyGameConfig)
      */
     bool initializeGame(GameState& state, AudioSystem& audio, ConfigManager& configManager, InputManager& inputManager);
     
+    /**
+     * @brief Load config and pieces (cache, .cfg, .pieces) without touching SDL or game state
+     *
+     * Safe on a worker thread while the main thread creates the window.
+     */
+    bool loadGameData(ConfigManager& configManager, StartupTimings* timings = nullptr);
+    
+    /**
+     * @brief Apply the loaded configuration to audio, theme, input, layout and pieces
+     */
+    bool applyGameConfig(GameState& state, AudioSystem& audio, ConfigManager& configManager, InputManager& inputManager);
+    
     /**
      * @brief Initialize randomizer and set first piece
      */
@@ -42,16 +62,40 @@ private:
     bool configInitialized_ = false;
     bool windowInitialized_ = false;
     bool gameStateInitialized_ = false;
+    bool probeRenderer_ = false;   // RENDER_DRIVER=PROBE sem escolha gravada para esta máquina
+    StartupTimings timings_;
+    DeferredStartup deferred_;
+
+    bool createWindow(SDL_Window*& win);
+    /// driver = índice do SDL (-1 = padrão); se o forçado falhar cai no padrão
+    bool createRenderer(SDL_Window* win, SDL_Renderer*& ren, bool vsync, int driver = -1);
+    /// Índice do RENDER_DRIVER (forçado ou gravado pelo probe); marca probeRenderer_ se falta medir
+    int pickRenderDriver(SDL_Window* win, const GameConfig& game);
+    /// Troca `ren` pelo driver mais rápido medido com as layers do jogo e grava a escolha
+    bool probeRenderer(SDL_Window* win, SDL_Renderer*& ren, bool vsync, const GameState& state, const GameConfig& game);
+    void presentFirstFrame(const GameState& state, SDL_Renderer* ren);
 
 public:
     bool initializeSDL();
     bool initializeBasic();
     bool initializeAudio(AudioSystem& audio);
-    bool initializeInput(InputManager& inputManager);
+    bool initializeInput(InputManager& inputManager, bool joysticks = true);
     bool initializeConfig(ConfigManager& configManager);
-    bool initializeWindow(SDL_Window*& win, SDL_Renderer*& ren);
+    bool initializeWindow(SDL_Window*& win, SDL_Renderer*& ren, bool vsync = true);
     bool initializeGameState(GameState& state, AudioSystem& audio, ConfigManager& configManager, InputManager& inputManager);
+    /**
+     * @brief Two-stage boot up to the first presented frame
+     *
+     * Config/pieces load on a worker thread while the window is created here
+     * (SDL video stays on this thread); background + banner are presented as
+     * soon as the renderer exists. Audio and joysticks are left to
+     * getDeferredStartup(), which GameLoop finishes.
+     */
     bool initializeComplete(AudioSystem& audio, InputManager& inputManager, ConfigManager& configManager, GameState& state, SDL_Window*& win, SDL_Renderer*& ren);
+    /** @brief Phase timings of the last initializeComplete() (plus the deferred ones as they finish) */
+    const StartupTimings& getStartupTimings() const { return timings_; }
+    /** @brief Second boot stage started by initializeComplete() */
+    DeferredStartup& getDeferredStartup() { return deferred_; }
 
     bool isSDLInitialized() const { return sdlInitialized_; }
     bool isAudioInitialized() const { return audioInitialized_; }
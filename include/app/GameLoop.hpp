@@ -6,12 +6,30 @@ class ConfigManager;
 class InputManager;
 struct SDL_Renderer;
 struct LayoutCache;
+struct StartupTimings;
+class DeferredStartup;
+class SoakMonitor;
+class FrameBench;
 
 class GameLoop {
 private:
+    struct Session;   // Estado e etapas de uma chamada de run() (GameLoop.cpp)
+
     bool running_ = false;
     LayoutCache* layoutCachePtr_ = nullptr; // forward-only; managed in cpp
+    const StartupTimings* startupTimings_ = nullptr;
+    DeferredStartup* deferred_ = nullptr;
+    SoakMonitor* soak_ = nullptr;
+    FrameBench* bench_ = nullptr;
 public:
+    /// Fases do boot mostradas na página PERF do overlay (precisa viver até run() voltar)
+    void setStartupTimings(const StartupTimings* timings) { startupTimings_ = timings; }
+    /// Segundo estágio do boot (GameInitializer::getDeferredStartup), concluído pelos frames do loop
+    void setDeferredStartup(DeferredStartup* deferred) { deferred_ = deferred; }
+    /// --soak: amostras por intervalo, paletas em rodízio, replay em loop; run() volta quando a duração acaba
+    void setSoak(SoakMonitor* soak) { soak_ = soak; }
+    /// --bench-frames: passos fixos por frame; run() volta no fim do replay (ou em --frames)
+    void setBench(FrameBench* bench) { bench_ = bench; }
     void run(GameState& state, RenderManager& renderManager, SDL_Renderer* ren, ConfigManager& configManager, InputManager& inputManager);
     void stop();
     bool isRunning() const { return running_; }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include "app/GameTypes.hpp"
+#include "pieces/DealState.hpp"
+
+/**
+ * @brief Cópia compacta (POD) do estado da partida
+ *
+ * Publicada pela thread de simulação num TripleBuffer e lida pela de render
+ * via db_bindSnapshot(): com um snapshot ligado, os acessores db_* leem dele
+ * em vez do GameState vivo. Tamanho fixo, sem ponteiros nem alocação.
+ *
+ * Com a parte de retomada (sorteio, combo, relógios relativos) o mesmo
+ * snapshot volta para a lógica por GameState::restoreSnapshot(): é o que o
+ * RewindBuffer guarda (PRACTICE_MODE) e o que o RESUME_FILE grava.
+ */
+struct GameSnapshot {
+    static constexpr int MAX_ROWS = MAX_BOARD_ROWS;
+    static constexpr int MAX_COLS = MAX_BOARD_COLS;
+    static constexpr int MAX_PIECE_TYPES = 320;   // conjuntos "chaos" de algumas centenas de peças
+    static constexpr int MAX_NEXT = 6;            // fila do NEXT (NEXT_COUNT)
+
+    using Cell = ::Cell;   // mesmo layout do GameBoard: BoardView serve aos dois
+
+    // Tabuleiro
+    int rows = 0, cols = 0;
+    Uint32 boardVersion = 0;
+    Uint32 rowMasks[MAX_ROWS];     // ocupação, bit x = coluna x
+    Cell cells[MAX_ROWS * MAX_COLS];
+
+    // Peça ativa e fila do NEXT (nextQueue[0] = próxima)
+    int activeIdx = 0, activeRot = 0, activeX = 0, activeY = 0;
+    int nextCount = 0;
+    int nextQueue[MAX_NEXT];
+
+    // Placar
+    int score = 0, lines = 0, level = 0;
+
+    // Estatísticas de peças sorteadas
+    int pieceStatCount = 0;
+    int pieceStats[MAX_PIECE_TYPES];
+
+    // Timer (o render reconstrói a visão a partir disto)
+    bool timerEnabled = false;
+    int timerState = 0;          // TimerSystem::State
+    int timerRemaining = 0;      // segundos
+
+    // Flags
+    bool running = true, paused = false, gameOver = false;
+    Uint32 screenshotRequests = 0;  // Contador: render tira o screenshot quando muda
+    Uint32 simTick = 0;             // Passos de simulação publicados até aqui
+    Uint32 inputVersion = 0;        // GameState::getInputVersion (LatencyProbe)
+    Uint64 inputStamp = 0;
+    LockEvent lockEvent;            // Partículas do render (não volta na retomada)
+
+    // Retomada: o que a lógica precisa além do que o render mostra. Tempos são
+    // idades (agora - instante), então o snapshot vale em outro relógio
+    bool resumable = false;         // false = sorteio sem estado POD (mt19937): não restaura
+    DealState deal;
+    int tickMs = 0;
+    int combo = 0;
+    Uint32 comboAgeMs = 0;          // desde o último clear
+    Uint32 gravityAgeMs = 0;        // desde o último passo de gravidade
+    Uint32 roundMs = 0;             // duração da partida, sem as pausas
+    Uint32 timerElapsedMs = 0;      // TimerSystem (RUNNING/PAUSED)
+
+    const Cell& cellAt(int x, int y) const { return cells[y * MAX_COLS + x]; }
+    Cell& cellAt(int x, int y) { return cells[y * MAX_COLS + x]; }
+};
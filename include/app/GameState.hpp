@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <SDL2/SDL.h>
@@ -6,12 +7,18 @@
 #include "app/GameBoard.hpp"
 #include "app/ScoreSystem.hpp"
 #include "app/ComboSystem.hpp"
+#include "app/GameEvents.hpp"
 #include "Interfaces.hpp"
 #include "timer/TimerSystem.hpp"
+#include "app/GameClock.hpp"
+#include "app/TimerWheel.hpp"
+#include "di/ServiceRegistry.hpp"
 
 class RenderManager;
+class ScreenshotWriter;
+class SessionLog;
+struct GameSnapshot;
 struct LayoutCache;
-class DependencyContainer;
 
 class GameState {
 private:
@@ -24,25 +31,69 @@ private:
     bool gameover_ = false;
     Uint32 lastTick_ = 0;
     std::vector<int> pieceStats_; // contador de cada tipo de peça sorteada
+    Uint32 screenshotRequests_ = 0;
+    Uint64 inputTicks_ = 0;          // Performance counter gasto em input_->update()
+    Uint32 inputVersion_ = 0;        // Sobe a cada update em que uma ação nova foi aplicada
+    Uint64 inputStamp_ = 0;          // Chegada do evento dessa ação (IInputManager::takeInputStamp)
+    std::atomic<Uint32> redrawVersion_{0};  // Sobe quando algo visível mudou fora do jogo andando (IDLE_RENDER); o render também escreve
+    Uint32 roundStartMs_ = 0;        // Relógio da lógica no restart (duração no SessionLog)
+    Uint32 pausedMs_ = 0;            // Pausas da partida atual
+    Uint32 pauseStartMs_ = 0;
+    Uint32 roundVersion_ = 0;        // Sobe a cada reset() (RewindBuffer: a partida trocou)
+    LockEvent lockEvent_;            // Último lock (partículas); não volta com restoreSnapshot()
+    
+    // Eventos dos passos, entregues uma vez por frame (som e métricas assinam por padrão)
+    GameEventQueue events_;
+    GameAudioEvents audioEvents_;
+    GameMetricsEvents metricsEvents_;
+    
+    // Prazos da lógica no clock_: só avança com a partida andando (pausa congela)
+    TimerWheel wheel_;
+    TimerWheel::Id gravityTimer_ = 0;
+    Uint32 gravityArmedTick_ = 0;    // lastTick_ e tickMs com que a gravidade foi armada:
+    int gravityArmedMs_ = -1;        // mudou qualquer um (lock, restart, restore, nível) = rearma
+    TimerWheel::Id ambientTimer_ = 0;
     
     // Timer system
     std::unique_ptr<TimerSystem> timer_;
     
-    std::unique_ptr<IAudioSystem> audio_;
-    std::unique_ptr<IThemeManager> theme_;
-    std::unique_ptr<IPieceManager> pieces_;
-    std::unique_ptr<IInputManager> input_;
-    std::unique_ptr<IGameConfig> config_;
+    // Dependências não-possuídas (vivem em main() ou na simulação headless)
+    IAudioSystem* audio_ = nullptr;
+    IThemeManager* theme_ = nullptr;
+    IPieceManager* pieces_ = nullptr;
+    IInputManager* input_ = nullptr;
+    IGameConfig* config_ = nullptr;
+    const IGameClock* clock_ = &systemClock();
+    ScreenshotWriter* screenshots_ = nullptr;
+    SessionLog* sessionLog_ = nullptr;
+    uint32_t sessionFlags_ = 0;
     
-    void restartRound();
+    void recordLock(int cleared);  // lockEvent_ da peça que acabou de travar
+    void emit(GameEventType type, int count = 0, int value = 0);
+    void armTimers(Uint32 now);    // Gravidade em lastTick_ + tickMs; efeitos ambientes
+    static void onGravity(void* self, Uint32 now);
+    static void onAmbient(void* self, Uint32 now);
+    void topOut();  // Game over pela peça que não cabe (lock ou lixo)
+    void endRound();  // Todo game over passa aqui: métrica e registro no SessionLog
 
 public:
-    GameState(DependencyContainer& container);
+    explicit GameState(const GameServices& services);
     GameState();
     
-    void setDependencies(class AudioSystem* audio, class ThemeManager* theme, 
-                        class PieceManager* pieces, class InputManager* input, 
-                        class ConfigManager* config);
+    // Copia os slots do registro; slot vazio fica nullptr (headless não tem tema/config)
+    void setServices(const GameServices& services);
+    // Apenas o necessário para a lógica (headless: NullAudioSystem/SyntheticInput)
+    void setCoreDependencies(IAudioSystem* audio, IPieceManager* pieces, IInputManager* input);
+    // Troca só a fonte de input (gravação/reprodução de replays)
+    void setInput(IInputManager* input) { input_ = input; }
+    IInputManager* getInput() const { return input_; }
+    
+    // Relógio da lógica (padrão: SDL_GetTicks). Também repassado ao TimerSystem.
+    void setClock(const IGameClock* clock);
+    const IGameClock& getClock() const { return *clock_; }
+    /// Prazos no relógio da partida, disparados no update() enquanto ela anda (pausa e game over congelam)
+    TimerWheel& getScheduler() { return wheel_; }
+    const TimerWheel& getScheduler() const { return wheel_; }
     
     GameBoard& getBoard();
     const GameBoard& getBoard() const;
@@ -52,6 +103,61 @@ public:
     const ComboSystem& getCombo() const;
     IPieceManager& getPieces();
     const IPieceManager& getPieces() const;
+    const IAudioSystem* getAudio() const { return audio_; }
+    IAudioSystem* getAudio() { return audio_; }
+    
+    // Com writer, F12 só conta o pedido: quem renderiza captura depois do draw e
+    // o beep toca aqui quando o arquivo fica pronto. Sem writer: BMP na hora.
+    void setScreenshotWriter(ScreenshotWriter* writer) { screenshots_ = writer; }
+    /// Cada game over vira um SessionRecord (flags extras: SessionRecord::BOT); nullptr = não registra
+    void setSessionLog(SessionLog* log, uint32_t flags) { sessionLog_ = log; sessionFlags_ = flags; }
+    // Screenshots pedidos para a thread de render tirar (writer ou modo threaded)
+    Uint32 getScreenshotRequests() const { return screenshotRequests_; }
+    /// Ticks de input acumulados desde a última chamada (profiler)
+    Uint64 takeInputTicks() { Uint64 t = inputTicks_; inputTicks_ = 0; return t; }
+    /// Versão da última ação de input aplicada e a chegada do evento dela (LatencyProbe)
+    Uint32 getInputVersion() const { return inputVersion_; }
+    Uint64 getInputStamp() const { return inputStamp_; }
+    /**
+     * @brief Versão do que está na tela enquanto o jogo não anda (pausa/game over)
+     *
+     * Sobe com ações de input aplicadas, pausa, game over e restart; quem muda a
+     * tela por fora (tema, layout, hot reload) chama requestRedraw(). Com
+     * IDLE_RENDER o loop só redesenha a pausa/game over quando ela muda.
+     */
+    Uint32 getRedrawVersion() const { return redrawVersion_.load(std::memory_order_relaxed); }
+    void requestRedraw() { redrawVersion_.fetch_add(1, std::memory_order_relaxed); }
+    /// Muda a cada reset()/restartRound(); restoreSnapshot() não mexe
+    Uint32 getRoundVersion() const { return roundVersion_; }
+    /// Peça travada e linhas limpas no último lock (efeitos do render)
+    const LockEvent& getLockEvent() const { return lockEvent_; }
+    /**
+     * @brief Fila de eventos da partida (GameEvents.hpp)
+     *
+     * Quem roda os passos chama dispatchEvents() uma vez por frame, depois
+     * deles; outros assinantes (replay, espectador, efeitos) entram com
+     * getEvents().subscribe().
+     */
+    GameEventQueue& getEvents() { return events_; }
+    void dispatchEvents() { events_.dispatch(); }
+    
+    /**
+     * @brief Parte de retomada do GameSnapshot: sorteio, combo, velocidade e as idades dos relógios
+     *
+     * db_captureSnapshot() chama depois de preencher o resto; resumable fica
+     * false se o sorteio não cabe num POD (mt19937).
+     */
+    void saveResumeState(GameSnapshot& out) const;
+    /**
+     * @brief Volta a partida para o estado do snapshot (rewind, RESUME_FILE)
+     *
+     * Tabuleiro, peça ativa, sorteio, placar, combo, estatísticas e timer;
+     * os relógios continuam deste ponto (a gravidade e o combo mantêm a idade
+     * que tinham). Sem alocação quando o conjunto de peças é o mesmo.
+     * @return false (nada muda) se o snapshot não serve aqui: não restaurável,
+     *         outro tamanho de tabuleiro ou peças fora do conjunto atual
+     */
+    bool restoreSnapshot(const GameSnapshot& snap);
     
     TimerSystem& getTimer();
     const TimerSystem& getTimer() const;
@@ -72,13 +178,17 @@ public:
     void setLastTick(Uint32 t);
     
     void reset();
+    void restartRound();
+    // renderer pode ser nullptr (headless): apenas o screenshot depende dele
     void update(SDL_Renderer* renderer);
     void render(RenderManager& renderManager, const LayoutCache& layout);
     void handleInput(SDL_Renderer* renderer);
     void updatePiece();
+    /** @brief Linhas de lixo recebidas (versus); true se o stack estourou e a partida acabou */
+    bool addGarbage(int lines, int holeCol);
     
     // Backward compat
-    std::vector<std::vector<Cell>>& grid;
+    const std::vector<std::vector<Cell>>& grid;
     Active& act;
     bool& running;
     bool& paused;
@@ -95,6 +205,13 @@ public:
     void setLevel(int level);
     void setTickMs(int tickMs);
     int getNextIdx() const;
+    /**
+     * @brief Fila do NEXT: out[0] = getNextIdx(), depois o lookahead do randomizer
+     *
+     * O peek só adianta sorteios na fila do PieceManager; a sequência não muda.
+     * @return entradas escritas (1..max)
+     */
+    int getNextQueue(int* out, int max) const;
     
     // Piece statistics
     const std::vector<int>& getPieceStats() const;
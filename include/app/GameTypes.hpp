@@ -1,11 +1,28 @@
 #pragma once
 #include <SDL2/SDL.h>
 
-// Forward-declared board size constants provided by the main build
-extern const int COLS;
-extern const int ROWS;
+// Board size (Globals.cpp): BOARD_COLS/BOARD_ROWS, fixed once the config is applied at boot
+extern int COLS;
+extern int ROWS;
+constexpr int MIN_BOARD_COLS = 4, MAX_BOARD_COLS = 32;   // GameBoard::RowMask
+constexpr int MIN_BOARD_ROWS = 4, MAX_BOARD_ROWS = 64;   // GameSnapshot / BotBoard
 
 struct Cell { Uint8 r, g, b; bool occ = false; };
 struct Active { int x, y, rot, idx; };
 
 
+
+/**
+ * @brief O último lock, para os efeitos do render (ParticleLayer)
+ *
+ * Não faz parte do estado do jogo: não entra no hash, no replay nem na
+ * retomada. seq diferente = houve lock desde a última leitura.
+ */
+struct LockEvent {
+    static constexpr int MAX_CELLS = 32;   // = ActiveView::MAX_CELLS
+    Uint32 seq = 0;                        ///< Sobe a cada lock
+    Uint64 clearedRows = 0;                ///< bit y = linha y (antes da limpeza) removida neste lock
+    Uint8 r = 0, g = 0, b = 0;             ///< Cor da peça travada
+    int cellCount = 0;
+    Sint8 cellX[MAX_CELLS], cellY[MAX_CELLS];
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include "app/GameState.hpp"
+#include "app/GameClock.hpp"
+#include "audio/NullAudioSystem.hpp"
+#include "input/SyntheticInput.hpp"
+#include "pieces/PieceManager.hpp"
+
+/**
+ * @brief Núcleo de simulação headless e determinístico
+ *
+ * Reaproveita GameState/GameBoard/ScoreSystem/PieceManager sem SDL de vídeo
+ * ou áudio: relógio manual avançado em passos fixos, NullAudioSystem e
+ * SyntheticInput no lugar do InputManager. Serve para replays, avaliação de
+ * bots e testes de carga da lógica, rodando muito acima do tempo real.
+ *
+ * Requer PIECES carregado (loadPiecesFile ou seedFallback).
+ */
+class HeadlessSim {
+public:
+    static constexpr Uint32 DEFAULT_STEP_MS = 1;
+
+    explicit HeadlessSim(Uint32 stepMs = DEFAULT_STEP_MS);
+
+    /** @brief Começa uma rodada nova com a semente dada */
+    void start(uint32_t seed);
+
+    /** @brief Avança um passo fixo com as ações do tick */
+    void step(uint16_t actions = 0);
+
+    /** @brief Roda até game over ou maxTicks; retorna os ticks executados */
+    uint64_t run(uint64_t maxTicks);
+
+    GameState& state() { return state_; }
+    const GameState& state() const { return state_; }
+    SyntheticInput& input() { return input_; }
+    PieceManager& pieces() { return pieces_; }
+    /** @brief Troca a fonte de input (replay); nullptr volta ao SyntheticInput */
+    void setInput(IInputManager* input);
+    ManualClock& clock() { return clock_; }
+    uint64_t ticks() const { return ticks_; }
+    Uint32 stepMs() const { return stepMs_; }
+
+private:
+    Uint32 stepMs_;
+    uint64_t ticks_ = 0;
+    ManualClock clock_;
+    NullAudioSystem audio_;
+    SyntheticInput input_;
+    PieceManager pieces_;
+    GameState state_;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include "app/FrameProfiler.hpp"
+#include "app/Metrics.hpp"
+
+/**
+ * @brief Latência input -> tela (LATENCY_PROBE)
+ *
+ * O InputManager anota quando o evento de tecla/botão chegou; o GameState
+ * sobe a versão de input quando aplica a ação desse evento. Logo depois de
+ * cada SDL_RenderPresent, onPresent() recebe a versão que o frame desenhou: a
+ * primeira vez que uma versão nova aparece vira uma amostra (agora - chegada).
+ *
+ * A ponta do evento tem resolução de ms (timestamp do SDL); várias ações antes
+ * do mesmo Present contam como uma, a da última.
+ */
+class LatencyProbe {
+public:
+    LatencyProbe();
+
+    /// inputVersion/inputStamp do estado (ou snapshot) que acabou de ser apresentado
+    void onPresent(Uint32 inputVersion, Uint64 inputStamp);
+
+    PhaseStats stats() const { return window_.stats(); }
+    /// Amostras desde o início (a janela guarda só as últimas)
+    Uint32 samples() const { return samples_; }
+
+private:
+    RollingStat window_;
+    Metrics::Id metric_;
+    Uint32 lastVersion_ = 0;
+    Uint32 samples_ = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+/**
+ * @brief Registro de métricas da máquina: contadores, gauges e histogramas
+ *
+ * Tudo pré-alocado (MAX_METRICS, MAX_BUCKETS): registrar pega um slot uma
+ * vez (em geral num static local no ponto de uso) e gravar é uma operação
+ * atômica relaxed, sem lock nem alocação, de qualquer thread. Id -1 (registro
+ * cheio) vira no-op. Quem lê é o MetricsExporter, numa thread própria.
+ */
+namespace Metrics {
+
+constexpr int MAX_METRICS = 64;
+constexpr int MAX_BUCKETS = 16;
+constexpr int NAME_MAX = 48;
+
+using Id = int;
+
+enum class Kind : uint8_t { COUNTER, GAUGE, HISTOGRAM };
+
+/// Mesmo nome devolve o mesmo Id
+Id counter(const char* name);
+Id gauge(const char* name);
+/// upperBounds crescentes (até MAX_BUCKETS); acima do último cai no bucket de overflow
+Id histogram(const char* name, std::initializer_list<double> upperBounds);
+
+void add(Id id, uint64_t n = 1);
+void set(Id id, double value);
+void observe(Id id, double value);
+
+// ---- leitura (exportador) ----
+int count();
+const char* name(Id id);
+Kind kind(Id id);
+uint64_t counterValue(Id id);
+double gaugeValue(Id id);
+
+struct HistogramSnapshot {
+    int buckets = 0;                       ///< limites em bounds; counts tem buckets + 1 (overflow)
+    double bounds[MAX_BUCKETS] = {};
+    uint64_t counts[MAX_BUCKETS + 1] = {};
+    uint64_t total = 0;
+    double sum = 0.0;
+    double max = 0.0;                      ///< desde o último takeHistogram
+};
+/// Cópia cumulativa dos buckets; zera o máximo
+void takeHistogram(Id id, HistogramSnapshot& out);
+
+} // namespace Metrics
+
+/**
+ * @brief Envia o registro a cada intervalo para StatsD (UDP) ou um arquivo
+ *
+ * target "udp://host:porta" manda datagramas StatsD (contadores como delta
+ * |c, gauges |g, histogramas como .count/.avg/.p50/.p99/.max); qualquer outro
+ * valor é um caminho de arquivo com as mesmas linhas, precedidas do horário
+ * Unix e rodado em maxFileBytes. A thread só lê os atômicos: nada disso pesa
+ * no frame.
+ */
+class MetricsExporter {
+public:
+    MetricsExporter(const std::string& target, const std::string& prefix, Uint32 intervalMs, size_t maxFileBytes);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    bool start();
+    void stop();     ///< Para a thread depois de um último envio
+
+private:
+    struct State;
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    void flush(double seconds);
+
+    std::string target_;
+    std::string prefix_;
+    Uint32 intervalMs_;
+    size_t maxFileBytes_;
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+    State* state_ = nullptr;
+};
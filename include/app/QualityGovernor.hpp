@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+
+struct VisualConfig;
+struct VisualEffectsView;
+
+/**
+ * @brief Desliga efeitos caros quando os frames não cabem no orçamento
+ *
+ * Recebe os mesmos tempos por frame que vão para o FrameProfiler (frame
+ * início a início e trabalho = sim + render) e avalia janelas de
+ * EVAL_FRAMES. Frame atrasado (mais de 25% acima do orçamento) em mais de 10%
+ * da janela, ou trabalho médio acima de 90% dele, por duas janelas seguidas:
+ * desce um tier. Folga (quase nenhum atraso e trabalho abaixo de 60%) por
+ * upWindows janelas: sobe um. Um tier que volta a estourar logo depois de
+ * subir dobra a espera da próxima subida (até MAX_UP_WINDOWS), para não
+ * ficar oscilando entre dois tiers.
+ *
+ * Cada tier soma um corte à lista, na ordem:
+ *  1 sweeps, 2 scanlines, 3 partículas novas, 4 ROUNDED_PANELS=0 (retângulos),
+ *  5 texto sem contorno (TEXT_OUTLINES=0).
+ * apply() parte sempre da config, então voltar de tier devolve o que o .cfg pedia.
+ */
+class QualityGovernor {
+public:
+    static constexpr int MAX_TIER = 5;
+    static constexpr int EVAL_FRAMES = 30;       ///< ~0.5 s a 60 FPS
+    static constexpr int BASE_UP_WINDOWS = 10;   ///< Folga contínua antes de subir (~5 s)
+    static constexpr int MAX_UP_WINDOWS = 120;
+
+    /// budgetMs <= 0 desliga (tier 0 e nada muda)
+    void configure(bool enabled, double budgetMs);
+    bool isEnabled() const { return enabled_; }
+    double budgetMs() const { return budgetMs_; }
+
+    /**
+     * @brief Um frame terminado; true quando o tier mudou neste frame
+     *
+     * Quem chama então faz apply() e refaz os caches de painéis/layers.
+     */
+    bool onFrame(double frameMs, double workMs);
+
+    int tier() const { return tier_; }
+    static const char* tierName(int tier);
+
+    /// Valores da config com os cortes do tier atual (view e ROUNDED_PANELS/TEXT_OUTLINES)
+    void apply(const VisualConfig& config, VisualEffectsView& view) const;
+
+    /// "tier 2/5 no scanlines, late 4%, work 9.8/16.7ms"
+    std::string statusLine() const;
+
+private:
+    bool enabled_ = false;
+    double budgetMs_ = 0.0;
+    int tier_ = 0;
+
+    // Janela corrente
+    int frames_ = 0;
+    int late_ = 0;
+    double workSum_ = 0.0;
+    // Última janela fechada (overlay)
+    double lastLatePct_ = 0.0;
+    double lastWorkMs_ = 0.0;
+
+    int overWindows_ = 0;      // Janelas seguidas acima do orçamento
+    int calmWindows_ = 0;      // Janelas seguidas com folga
+    int sinceChange_ = 0;      // Janelas desde a última troca de tier
+    int upWindows_ = BASE_UP_WINDOWS;
+    bool lastWasUp_ = false;
+
+    bool setTier(int tier);
+};
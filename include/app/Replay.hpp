@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Uma ação resolvida num tick (bits de SyntheticInput::Action)
+ *
+ * steps guarda os passos de DAS/ARR de MOVE_LEFT, MOVE_RIGHT e SOFT_DROP
+ * (só significativos quando o bit correspondente está ligado).
+ */
+struct ReplayEvent {
+    uint32_t tick = 0;
+    uint16_t actions = 0;
+    uint8_t steps[3] = {1, 1, 1};
+};
+
+/**
+ * @brief Uma partida gravada: semente, hash da config e stream de ações
+ *
+ * Formato .dbr (little endian): "DBRP", versão (u8), stepMs (u16), seed (u32),
+ * configHash (u64); depois, por evento, varint(delta de ticks) + varint(ações)
+ * [+ varint(passos-1) por ação repetida se o bit MULTI estiver ligado];
+ * varint(delta até o fim) + varint(0) fecha o stream, seguido de placar,
+ * linhas e nível finais (varints) para verificação. Da versão 3 em diante,
+ * varint(intervalo) + varint(quantos) + u64 por checkpoint: o
+ * Zobrist::stateHash ao fim dos ticks intervalo-1, 2*intervalo-1, ...
+ * (versão 2 ainda carrega, sem checkpoints).
+ */
+struct ReplayData {
+    static constexpr uint8_t VERSION = 3;   // 2: bag embaralhado com PieceRng; 3: checkpoints Zobrist
+    static constexpr uint32_t CHECKPOINT_TICKS = 250;   // 1 s no passo padrão de 4 ms
+
+    uint16_t stepMs = 4;
+    uint32_t seed = 0;
+    uint64_t configHash = 0;
+    uint32_t endTick = 0;          // Ticks da partida (o último evento é < endTick)
+    int32_t finalScore = 0;
+    int32_t finalLines = 0;
+    int32_t finalLevel = 0;
+    std::vector<ReplayEvent> events;
+    uint32_t checkpointTicks = 0;        // 0 = sem checkpoints (versão 2)
+    std::vector<uint64_t> checkpoints;   // checkpoints[i]: hash ao fim do tick (i + 1) * checkpointTicks - 1
+};
+
+/**
+ * @brief Resultado de uma reprodução comparado ao placar gravado
+ */
+struct ReplayResult {
+    uint32_t ticks = 0;
+    int score = 0, lines = 0, level = 0;
+    bool configMatches = true;
+    bool matches = false;          // placar/linhas/nível iguais aos gravados
+    uint32_t checkpoints = 0;      // checkpoints conferidos
+    int64_t divergedTick = -1;     // primeiro checkpoint com hash diferente (-1 = nenhum)
+};
+
+std::vector<uint8_t> encodeReplay(const ReplayData& data);
+bool decodeReplay(const uint8_t* bytes, size_t size, ReplayData& out);
+
+bool saveReplay(const std::string& path, const ReplayData& data);
+bool loadReplay(const std::string& path, ReplayData& out);
+
+/**
+ * @brief Hash (FNV-1a) do que muda o resultado da simulação
+ *
+ * Tabuleiro, passo fixo, velocidade (gameConfig/SPEED_ACCELERATION), RNG e bag das
+ * peças, e a geometria e os kicks das peças carregadas. Um replay com hash diferente ainda toca, mas
+ * provavelmente diverge.
+ */
+uint64_t replayConfigHash(uint16_t stepMs);
+
+/**
+ * @brief Reproduz o replay no núcleo headless, o mais rápido possível
+ */
+ReplayResult runReplayHeadless(const ReplayData& data);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ai/WorkStealingPool.hpp"
+#include "app/Replay.hpp"
+
+/**
+ * @brief Veredito de um arquivo .dbr re-simulado pelo ReplayVerifier
+ */
+struct ReplayVerdict {
+    enum Status {
+        VERIFIED,    ///< Placar/linhas/nível finais e todos os checkpoints batem
+        MISMATCH,    ///< Checkpoints ok (ou ausentes), final diferente do gravado
+        DIVERGED,    ///< Algum checkpoint Zobrist não bateu
+        CORRUPT,     ///< Arquivo ilegível, truncado ou versão desconhecida
+        TOO_LONG     ///< Mais que ReplayVerifier::MAX_GAME_MS de partida: não simulado
+    };
+
+    std::string file;
+    Status status = CORRUPT;
+    ReplayData recorded;          ///< Cabeçalho, placar e checkpoints gravados (events é liberado após simular)
+    ReplayResult result;
+    double ms = 0.0;              ///< Tempo de simulação deste arquivo
+
+    static const char* statusName(Status s);
+};
+
+/**
+ * @brief Verificação de replays em lote (torneio: --verify DIR)
+ *
+ * Cada arquivo é re-simulado no núcleo determinístico (runReplayHeadless:
+ * HeadlessSim, NullAudioSystem, sem SDL de vídeo) conferindo os checkpoints
+ * Zobrist e o placar final. Os arquivos vão para um WorkStealingPool, uma
+ * tarefa por replay: partidas curtas e longas se equilibram pelo roubo entre
+ * filas. As simulações só leem o estado global (PIECES, gameConfig, RNG
+ * configurado), então a config e as peças precisam estar carregadas antes.
+ */
+class ReplayVerifier {
+public:
+    /// Teto de duração aceito por arquivo: um endTick forjado não prende o servidor
+    static constexpr uint64_t MAX_GAME_MS = 2ull * 60 * 60 * 1000;
+
+    /// threads = total de threads, contando a chamadora; <= 0 = um por núcleo
+    explicit ReplayVerifier(int threads = 0);
+
+    /// Arquivos .dbr do diretório (não recursivo), em ordem de nome
+    static std::vector<std::string> listReplays(const std::string& dir);
+
+    /// Re-simula todos os arquivos; out fica na mesma ordem de paths
+    void verify(const std::vector<std::string>& paths, std::vector<ReplayVerdict>& out);
+
+    /// Relatório JSON: resumo do lote e um objeto por arquivo
+    static bool writeJson(const std::string& path, const std::vector<ReplayVerdict>& verdicts,
+                          double wallMs, int threads);
+
+    int concurrency() const { return pool_.concurrency(); }
+    unsigned stolenCount() const { return pool_.stolenCount(); }
+
+private:
+    WorkStealingPool pool_;
+};
+
+/**
+ * @brief Modo --verify: confere o diretório, grava o JSON e loga o resumo
+ * @return Código de saída (0 = todos verificados, 1 = algum falhou ou erro de I/O)
+ */
+int runReplayVerification(const std::string& dir, const std::string& jsonPath, int threads);
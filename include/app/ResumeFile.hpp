@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "app/GameSnapshot.hpp"
+
+/**
+ * @brief Partida em andamento salva no disco para voltar depois de um corte de energia (RESUME_FILE)
+ *
+ * O arquivo é um GameSnapshot cru com cabeçalho (magic, versão, tamanho da
+ * struct, hash da config) e checksum: outro build, outra config de jogo ou
+ * escrita pela metade = nada a retomar. Quem joga só chama submit() (uma
+ * cópia de ~12 KB sob mutex); a thread grava num .tmp, faz fsync e renomeia,
+ * então o arquivo no disco é sempre um snapshot inteiro. discard() (game
+ * over) apaga o arquivo pela mesma thread.
+ */
+class ResumeFile {
+public:
+    static constexpr uint32_t VERSION = 1;   ///< Sobe quando o layout do GameSnapshot muda
+
+    ResumeFile() = default;
+    ~ResumeFile() { stop(); }
+    ResumeFile(const ResumeFile&) = delete;
+    ResumeFile& operator=(const ResumeFile&) = delete;
+
+    /// Lê a partida guardada (saved()) e abre a thread de escrita; false = sem arquivo de retomada
+    bool start(const std::string& path, uint64_t configHash);
+    /// Grava o que estiver pendente antes de sair
+    void stop();
+    bool isRunning() const { return thread_ != nullptr; }
+
+    /// Partida lida no start(); nullptr = nada a retomar
+    const GameSnapshot* saved() const { return saved_.get(); }
+    void dropSaved() { saved_.reset(); }
+
+    /// Fica com a cópia mais nova; a anterior ainda não gravada é descartada
+    void submit(const GameSnapshot& snap);
+    /// A partida acabou: apaga o arquivo (e o que estava pendente)
+    void discard();
+
+    uint32_t writes() const { return writes_.load(std::memory_order_relaxed); }
+
+    /// Lê e valida um arquivo de retomada (também usado fora da thread)
+    static bool load(const std::string& path, uint64_t configHash, GameSnapshot& out);
+
+private:
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    bool write(const GameSnapshot& snap);
+
+    std::string path_;
+    uint64_t configHash_ = 0;
+    std::unique_ptr<GameSnapshot> saved_;
+
+    SDL_mutex* mutex_ = nullptr;
+    std::unique_ptr<GameSnapshot> pending_;   // com mutex_
+    bool hasPending_ = false;                 // com mutex_
+    bool discard_ = false;                    // com mutex_
+    std::unique_ptr<GameSnapshot> writing_;   // só a thread
+
+    SDL_sem* wake_ = nullptr;
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+    std::atomic<uint32_t> writes_{0};
+};
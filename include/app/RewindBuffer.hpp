@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+#include "app/GameSnapshot.hpp"
+
+class GameState;
+
+/**
+ * @brief Anel de GameSnapshot para o undo/rewind do PRACTICE_MODE
+ *
+ * Os slots são alocados uma vez no construtor (REWIND_SLOTS x ~12 KB); daí
+ * em diante capturar é um db_captureSnapshot() no slot seguinte e voltar é
+ * um GameState::restoreSnapshot(), alguns microssegundos cada.
+ *
+ * afterStep() captura depois de cada lock (a versão do tabuleiro mudou) e,
+ * com REWIND_INTERVAL_TICKS, também a cada N passos sem lock. rewind() tira
+ * o mais novo e restaura o que ficou no topo: o primeiro toque desfaz a
+ * última peça travada (volta ao spawn dela), os seguintes continuam voltando.
+ * Restart esvazia o anel; pausa e game over não capturam.
+ */
+class RewindBuffer {
+public:
+    /// slots >= 2; intervalTicks 0 = só nos locks
+    RewindBuffer(int slots, int intervalTicks);
+
+    /// Depois de cada passo da simulação
+    void afterStep(const GameState& state);
+    /// Volta um snapshot; false = não há para onde voltar (ou não restaurável)
+    bool rewind(GameState& state);
+    void clear() { count_ = 0; }
+
+    int size() const { return count_; }
+    int capacity() const { return (int)ring_.size(); }
+    /// Snapshot mais novo (RESUME_FILE grava dele); nullptr se vazio
+    const GameSnapshot* latest() const { return count_ ? &ring_[head_] : nullptr; }
+    uint32_t captures() const { return captures_; }
+    uint32_t rewinds() const { return rewinds_; }
+    /// Duração do último restoreSnapshot(), em microssegundos
+    double lastRestoreUs() const { return lastRestoreUs_; }
+
+private:
+    void capture(const GameState& state);
+
+    std::vector<GameSnapshot> ring_;
+    int head_ = 0, count_ = 0;
+    int intervalTicks_ = 0;
+    Uint32 tick_ = 0, capturedTick_ = 0;
+    Uint32 boardVersion_ = 0, roundVersion_ = 0;
+    bool seen_ = false;
+    bool unsaved_ = false;   // Houve lock depois do mais novo sem capturar (game over)
+    uint32_t captures_ = 0, rewinds_ = 0;
+    double lastRestoreUs_ = 0.0;
+};
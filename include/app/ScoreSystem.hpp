@@ -18,6 +18,8 @@ public:
     void addLines(int lines);
     void reset();
     void setTickMs(int ms);
+    /// Valores exatos de um snapshot (sem recalcular nível/velocidade)
+    void restore(int score, int lines, int level, int tickMs);
 };
 
 
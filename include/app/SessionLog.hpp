@@ -0,0 +1,112 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Uma partida terminada, como vai para o log
+ */
+struct SessionRecord {
+    enum Flags : uint32_t {
+        TIMER_MODE = 1u << 0,   ///< partida contra o relógio (TIMER_ENABLED)
+        BOT = 1u << 1,          ///< jogada pelo bot (BOT_ENABLED): fica no log, fora do ranking
+        PRACTICE = 1u << 2,     ///< PRACTICE_MODE (com rewind): fica no log, fora do ranking
+    };
+    uint64_t endedAt = 0;       ///< segundos Unix
+    int32_t score = 0;
+    int32_t lines = 0;
+    int32_t level = 0;
+    uint32_t durationMs = 0;    ///< do restart ao game over, sem as pausas
+    uint32_t flags = 0;
+    std::vector<uint32_t> pieceStats;   ///< getPieceStats(), por índice de PIECES
+};
+
+/// Entrada do ranking (24 bytes no índice)
+struct HighScore {
+    int32_t score = 0;
+    int32_t lines = 0;
+    int32_t level = 0;
+    uint32_t durationMs = 0;
+    uint64_t endedAt = 0;
+};
+
+/// Payload de um registro do log (sem o cabeçalho de tamanho/checksum)
+std::vector<uint8_t> encodeSessionRecord(const SessionRecord& record);
+bool decodeSessionRecord(const uint8_t* data, size_t size, SessionRecord& out);
+
+/**
+ * @brief Log de partidas em append e ranking persistente (SESSION_LOG)
+ *
+ * O log (SESSION_LOG) é binário e só cresce: cada partida é um registro com
+ * tamanho e checksum, então um corte de energia no meio da escrita perde só
+ * o último. Quem joga só chama submit(): o registro é codificado e entra na
+ * fila, o ranking em memória muda na hora, e uma thread grava em lote e faz
+ * fsync no máximo a cada SESSION_FSYNC_MS. O game over nunca espera o cartão.
+ *
+ * O ranking fica num índice compacto ao lado (SESSION_LOG.idx), regravado
+ * pela mesma thread quando muda e lido por mmap no boot. O índice guarda até
+ * que byte do log ele cobre: o que veio depois (queda antes de regravar) é
+ * lido do log; índice ausente ou corrompido = o log inteiro é relido.
+ *
+ * O log também serve de analytics do kiosque: é para ser recolhido e lido
+ * fora (decodeSessionRecord).
+ */
+class SessionLog {
+public:
+    static constexpr int MAX_HIGH_SCORES = 50;
+
+    SessionLog() = default;
+    ~SessionLog() { stop(); }
+    SessionLog(const SessionLog&) = delete;
+    SessionLog& operator=(const SessionLog&) = delete;
+
+    /// Lê o ranking e abre a thread de escrita; false = log desligado (jogo segue)
+    bool start(const std::string& path, int highScoreCount, int fsyncMs);
+    /// Grava o que estiver na fila, fsync e regrava o índice se precisar
+    void stop();
+    bool isRunning() const { return thread_ != nullptr; }
+
+    /// Qualquer thread (o game over pode ser na thread de simulação)
+    void submit(const SessionRecord& record);
+    /// Attract/replay: partidas que não são de ninguém não entram
+    void setSuspended(bool suspended) { suspended_.store(suspended, std::memory_order_relaxed); }
+
+    /// Cópia do ranking em ordem decrescente; retorna quantas entradas
+    int highScores(HighScore* out, int max) const;
+    /// Muda a cada alteração do ranking (quem desenha compara)
+    uint32_t highScoreVersion() const { return tableVersion_.load(std::memory_order_acquire); }
+    uint32_t recordsWritten() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+    bool loadTable();
+    uint64_t scanLog(uint64_t from);
+    bool insertScore(const SessionRecord& record);   // com mutex_; true se o ranking mudou
+    bool writeIndex(const std::vector<HighScore>& table, uint64_t logBytes);
+
+    static int SDLCALL threadMain(void* self);
+    void loop();
+
+    std::string path_;
+    int capacity_ = 10;
+    Uint32 fsyncMs_ = 2000;
+
+    mutable SDL_mutex* mutex_ = nullptr;
+    std::vector<HighScore> table_;             // com mutex_
+    std::vector<std::vector<uint8_t>> queue_;  // com mutex_: registros já emoldurados
+    bool tableDirty_ = false;                  // com mutex_
+
+    SDL_sem* wake_ = nullptr;
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+    std::atomic<bool> suspended_{false};
+    std::atomic<uint32_t> tableVersion_{0};
+    std::atomic<uint32_t> written_{0};
+
+    // Só a thread de escrita
+    FILE* file_ = nullptr;
+    uint64_t logBytes_ = 0;
+    std::vector<std::vector<uint8_t>> batch_;
+};
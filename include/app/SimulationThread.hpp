@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+
+#include "app/GameClock.hpp"
+#include "app/GameSnapshot.hpp"
+#include "app/TripleBuffer.hpp"
+
+class GameState;
+class InputManager;
+
+/**
+ * @brief Simulação em thread própria (THREADED_MODE=1)
+ *
+ * Roda os passos fixos de SIM_STEP_MS contra o performance counter e publica
+ * um GameSnapshot por lote num TripleBuffer. A thread principal fica com
+ * vídeo, eventos (SDL_PumpEvents) e render, então um Present lento ou um
+ * stall de driver não atrasa input nem gravidade.
+ */
+class SimulationThread {
+public:
+    SimulationThread(GameState& state, InputManager& input, int stepMs);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    /// Publica o snapshot inicial e inicia a thread (chamar na thread principal)
+    bool start();
+
+    /// Pede parada e espera a thread terminar
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    /// Consumidor (render): acquire() + readBuffer()
+    TripleBuffer<GameSnapshot>& snapshots() { return snapshots_; }
+
+    /// Toggles de debug pedidos desde a última chamada (o overlay é da thread principal)
+    int takeDebugToggles() { return debugToggles_.exchange(0, std::memory_order_acq_rel); }
+    /// Idem para KEY_THEME (a paleta é trocada na thread do render)
+    int takeThemeCycles() { return themeCycles_.exchange(0, std::memory_order_acq_rel); }
+    int takeTraceDumps() { return traceDumps_.exchange(0, std::memory_order_acq_rel); }
+
+    /// Escrita da thread principal no que os passos leem (cores de PIECES, GameState):
+    /// fn roda com a simulação parada entre dois lotes de passos
+    template <typename F>
+    void betweenSteps(F&& fn) {
+        SDL_LockMutex(stepMutex_);
+        fn();
+        SDL_UnlockMutex(stepMutex_);
+    }
+
+    /// Custo do último lote de passos (ms) e quantos passos ele teve
+    double lastBatchMs() const { return lastBatchUs_.load(std::memory_order_relaxed) / 1000.0; }
+    int lastBatchSteps() const { return lastBatchSteps_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int MAX_STEPS_PER_BATCH = 64;   // 250 ms a 4 ms/passo
+
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    void publish();
+
+    GameState& state_;
+    InputManager& input_;
+    int stepMs_;
+    ManualClock clock_;
+    Uint32 tick_ = 0;
+
+    SDL_Thread* thread_ = nullptr;
+    SDL_mutex* stepMutex_ = nullptr;   // A thread da simulação segura durante cada lote
+    std::atomic<bool> quit_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<int> debugToggles_{0};
+    std::atomic<int> themeCycles_{0};
+    std::atomic<int> traceDumps_{0};
+    std::atomic<Uint32> lastBatchUs_{0};
+    std::atomic<int> lastBatchSteps_{0};
+
+    TripleBuffer<GameSnapshot> snapshots_;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "app/FrameProfiler.hpp"
+
+class ConfigManager;
+class IAudioSystem;
+
+/**
+ * @brief Opções do --soak (linha de comando)
+ */
+struct SoakOptions {
+    double hours = 0.0;               ///< <= 0 = sem soak
+    std::string csvPath = "soak.csv";
+    std::string replayFile;           ///< vazio = bot jogando sozinho
+    int sampleSeconds = 60;           ///< Uma linha do CSV por intervalo
+    int themeSeconds = 60;            ///< 0 = sem trocar de paleta
+};
+
+/**
+ * @brief Config do soak por cima do .cfg carregado
+ *
+ * Bot (ou o replay, em loop e fora do THREADED_MODE) num tabuleiro só,
+ * sem IDLE_RENDER, attract, QUALITY_GOVERNOR nem SESSION_LOG, e todos os efeitos ligados
+ * (sweeps, scanlines, partículas, CRT_SHADER) na config e em g_visualView.
+ */
+void applySoakOverrides(ConfigManager& configManager, const SoakOptions& options);
+
+/**
+ * @brief Amostras periódicas de uma sessão longa (--soak) e detecção de vazamentos
+ *
+ * onFrame() só soma num FrameHistogram: nada aloca no caminho do frame. A
+ * cada sampleSeconds, poll() fecha a amostra e grava uma linha no CSV: RSS,
+ * blocos vivos e alocações do heap (build com DROPBLOCKS_ALLOC_TRACKING),
+ * texturas do renderTargetPool(), fila do mixer, frames e avg/p50/p99/max do frame.
+ *
+ * Série que não cai em GROWTH_SAMPLES amostras seguidas e cresceu mais que a
+ * folga dela é marcada (uma vez, no log e na coluna flags); as WARMUP_SAMPLES
+ * primeiras ficam fora (caches e pools enchendo). finish() resume no log.
+ */
+class SoakMonitor {
+public:
+    static constexpr int WARMUP_SAMPLES = 2;
+    static constexpr int GROWTH_SAMPLES = 10;   ///< ~10 min com o intervalo padrão
+
+    bool start(const SoakOptions& options);
+    bool isRunning() const { return csv_ != nullptr; }
+    /// Duração pedida já passou (o loop sai e o processo devolve o resultado)
+    bool expired(Uint32 now) const { return csv_ && (Sint32)(now - endAt_) >= 0; }
+    int themeSeconds() const { return themeSeconds_; }
+
+    void onFrame(double frameMs);
+    /// Fecha a amostra se o intervalo venceu; true = linha nova no CSV
+    bool poll(Uint32 now, const IAudioSystem* audio);
+    /// Última amostra (parcial), resumo no log e fecha o CSV
+    void finish(const IAudioSystem* audio);
+
+    bool flagged() const;
+    /// "min 42/480, rss 81M, p99 9.4ms, growing: rss" (overlay)
+    std::string statusLine() const;
+
+private:
+    enum Series { RSS, HEAP, TEXTURES, TEXTURE_KB, AUDIO_QUEUED, FRAME_AVG, SERIES_COUNT };
+    struct Trend {
+        double runStart = 0.0;   // Valor no início da sequência sem queda
+        double last = 0.0;
+        int runLength = 0;
+        bool flagged = false;
+    };
+    static const char* seriesName(int series);
+    void writeSample(Uint32 now, const IAudioSystem* audio);
+    void track(int series, double value);
+
+    FILE* csv_ = nullptr;
+    std::string csvPath_;
+    Uint32 startedAt_ = 0;
+    Uint32 endAt_ = 0;
+    Uint32 nextSample_ = 0;
+    Uint32 sampleMs_ = 60000;
+    int themeSeconds_ = 0;
+    int samples_ = 0;
+    double hours_ = 0.0;
+
+    // Amostra corrente
+    FrameHistogram frames_;
+    uint64_t allocsAtSample_ = 0;
+    uint64_t bytesAtSample_ = 0;
+
+    // Última linha (overlay/resumo)
+    double lastRssKb_ = 0.0;
+    double firstRssKb_ = -1.0;
+    double lastP99_ = 0.0;
+    Trend trends_[SERIES_COUNT];
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+class GameState;
+class RenderManager;
+class ConfigManager;
+class InputManager;
+class DeferredStartup;
+struct SDL_Renderer;
+
+/**
+ * @brief Versus local com 2-4 tabuleiros lado a lado (SPLIT_PLAYERS)
+ *
+ * O jogador 1 é o GameState de sempre (teclado/joystick, áudio, screenshot,
+ * toggles); cada assento extra tem GameState, PieceManager, relógio e input
+ * próprios (SeatInput ou bot) e áudio mudo. A tela vira N fatias iguais: um
+ * LayoutCache calculado para a largura de uma fatia, desenhado N vezes com
+ * SDL_RenderSetViewport, então painéis pré-renderizados e textos em cache são
+ * os mesmos para todos. Todos começam com o mesmo estado de sorteio.
+ *
+ * Por frame: o jogador 1 atualiza primeiro (bombeia os eventos que alimentam
+ * os teclados dos assentos), depois os assentos, em paralelo quando
+ * SPLIT_PARALLEL=1 e há mais de um núcleo. Pause do jogador 1 pausa todos;
+ * restart é por assento. Sem THREADED_MODE, replay, bot do jogador 1 ou hot
+ * reload neste modo.
+ */
+class SplitScreenLoop {
+public:
+    /// Segundo estágio do boot (joysticks/áudio), concluído pelos frames do loop
+    void setDeferredStartup(DeferredStartup* deferred) { deferred_ = deferred; }
+    void run(GameState& state, RenderManager& renderManager, SDL_Renderer* ren, ConfigManager& configManager,
+             InputManager& inputManager);
+    void stop() { running_ = false; }
+    bool isRunning() const { return running_; }
+
+private:
+    bool running_ = false;
+    DeferredStartup* deferred_ = nullptr;
+};
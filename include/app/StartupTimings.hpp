@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Tempo de cada fase do boot (log + página PERF do DebugOverlay)
+ *
+ * Fases de outras threads (config, peças, áudio) rodam por baixo das da
+ * thread principal (janela, renderer); por isso a soma pode passar do
+ * total, que é o tempo de parede até o primeiro frame. As fases do segundo
+ * estágio (DeferredStartup) entram depois, já com o jogo rodando.
+ */
+struct StartupTimings {
+    struct Phase {
+        std::string name;
+        double ms = 0.0;
+        bool worker = false;   ///< rodou fora da thread principal
+    };
+
+    std::vector<Phase> phases;
+    double totalMs = 0.0;
+
+    /// Fecha a fase que começou em startTicks (SDL_GetPerformanceCounter); devolve o contador de agora
+    Uint64 add(const char* name, Uint64 startTicks, bool worker = false);
+    /// Junta as fases de outra thread (depois do join)
+    void merge(const StartupTimings& other);
+    /// "SDL 12.1ms, Window 80.3ms, [Config 1.2ms] ... = 140.0ms"
+    std::string summary() const;
+};
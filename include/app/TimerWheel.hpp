@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Agendador de prazos da lógica: timing wheel de 1 ms por slot
+ *
+ * Os subsistemas registram um prazo (ms do IGameClock da partida) com um
+ * callback; advance(now) só visita os slots dos milissegundos que passaram
+ * desde a última chamada e dispara os vencidos, em ordem de prazo (empate =
+ * ordem de agendamento). Prazos além de uma volta ficam no slot e só vencem
+ * na volta certa. Entradas saem de um pool fixo: agendar/cancelar não aloca.
+ *
+ * Callback é ponteiro de função + user (sem std::function): pode agendar de
+ * novo, inclusive o próprio timer, de dentro do disparo.
+ */
+class TimerWheel {
+public:
+    using Callback = void (*)(void* user, Uint32 now);
+    using Id = uint32_t;                    ///< 0 = nenhum
+    static constexpr int SLOTS = 256;       ///< Potência de 2
+
+    explicit TimerWheel(int capacity = 16);
+
+    /// Cancela tudo e recomeça a contar de now (troca de relógio, partida nova)
+    void reset(Uint32 now);
+    /// Prazo já vencido dispara no próximo advance(); 0 = pool cheio
+    Id schedule(Uint32 deadline, Callback fn, void* user);
+    bool cancel(Id id);
+    bool isPending(Id id) const;
+
+    /// Dispara os vencidos até now (inclusive); devolve quantos
+    int advance(Uint32 now);
+
+    int size() const { return active_; }
+    int capacity() const { return (int)entries_.size(); }
+    uint64_t fired() const { return fired_; }
+
+private:
+    struct Entry {
+        Uint32 deadline = 0;
+        Callback fn = nullptr;
+        void* user = nullptr;
+        uint32_t seq = 0;                   // ordem de agendamento (desempate)
+        int prev = -1, next = -1;
+        int list = -1;                      // slot, OVERDUE ou -1 (livre)
+        uint16_t gen = 1;
+    };
+    static constexpr int OVERDUE = SLOTS;   // lista dos agendados já vencidos
+
+    int take(Id id) const;                  // índice se id ainda vale, senão -1
+    void link(int idx, int list);
+    void unlink(int idx);
+    void collect(int list, Uint32 now);
+
+    std::vector<Entry> entries_;
+    std::vector<int> free_;
+    std::vector<int> due_;                  // scratch do advance (reservado)
+    struct Call { Callback fn; void* user; };
+    std::vector<Call> calls_;
+    int heads_[SLOTS + 1];
+    Uint32 cursor_ = 0;                     // próximo ms ainda não visitado
+    uint32_t seq_ = 0;
+    int active_ = 0;
+    uint64_t fired_ = 0;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <string>
+
+/**
+ * @brief Zonas de trace com escopo para timeline no Chrome/Perfetto
+ *
+ * DB_TRACE_ZONE("nome") mede do ponto até o fim do escopo e grava o par
+ * begin/end (performance counter) no anel da thread que executou: um anel por
+ * thread, alocado no primeiro uso e escrito só por ela, sem lock nem
+ * alocação depois disso. Desligado, uma zona custa um load relaxed.
+ *
+ * dump() copia o que terminou nos últimos N segundos de todos os anéis e uma
+ * thread grava o JSON trace-event do Chrome (ui.perfetto.dev ou
+ * chrome://tracing): uma linha por thread, zonas aninhadas como no código.
+ *
+ * Nomes precisam viver até o dump: literais, ou intern() para nomes montados.
+ */
+namespace Trace {
+
+constexpr int MAX_THREADS = 32;        ///< Threads com anel ao mesmo tempo; além disso as zonas se perdem
+constexpr int ZONES_PER_SECOND = 4096; ///< Por thread: dimensiona o anel (~68 zonas por frame a 60 FPS)
+
+inline std::atomic<bool> g_enabled{false};
+
+inline bool isEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Liga a gravação guardando ~seconds de histórico por thread
+ *
+ * O tamanho do anel vem da primeira chamada (os anéis já alocados não mudam);
+ * seconds <= 0 desliga.
+ */
+void enable(int seconds);
+
+/// Grava uma zona terminada na thread atual
+void record(const char* name, Uint64 begin, Uint64 end);
+
+/// Nome da thread atual na timeline (ponteiro guardado: literal ou intern())
+void setThreadName(const char* name);
+
+/// Cópia com vida até o fim do processo, para nomes que não são literais
+const char* intern(const std::string& name);
+
+/**
+ * @brief Grava em path os últimos N segundos como Chrome trace.json
+ *
+ * O horário entra antes da extensão (trace.json -> trace_20261014_153000.json).
+ * A cópia dos anéis roda aqui (rápida); formatar e escrever, numa thread.
+ * Uma thread chama (o loop principal). false se o trace está desligado ou um
+ * dump anterior ainda está gravando.
+ */
+bool dump(const std::string& path);
+
+/// Espera o dump em andamento terminar (fim do processo)
+void shutdown();
+
+class Zone {
+public:
+    explicit Zone(const char* name)
+        : name_(isEnabled() ? name : nullptr), begin_(name_ ? SDL_GetPerformanceCounter() : 0) {}
+    ~Zone() { if (name_) record(name_, begin_, SDL_GetPerformanceCounter()); }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* name_;
+    Uint64 begin_;
+};
+
+} // namespace Trace
+
+#define DB_TRACE_CONCAT_(a, b) a##b
+#define DB_TRACE_CONCAT(a, b) DB_TRACE_CONCAT_(a, b)
+#define DB_TRACE_ZONE(name) Trace::Zone DB_TRACE_CONCAT(db_trace_zone_, __LINE__)(name)
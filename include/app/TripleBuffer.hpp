@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * @brief Triple buffer lock-free: um produtor, um consumidor, sempre o mais recente
+ *
+ * O produtor escreve em writeBuffer() e chama publish(); o consumidor chama
+ * acquire() e lê o último publicado. Nenhum lado espera pelo outro: se o
+ * produtor publicar duas vezes antes de uma leitura, a mais antiga é
+ * simplesmente descartada.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /// Produtor: buffer livre para escrever (não visto pelo consumidor)
+    T& writeBuffer() { return slots_[back_]; }
+
+    /// Produtor: torna writeBuffer() o mais recente e pega outro slot livre
+    void publish() {
+        int prev = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+        back_ = prev & INDEX_MASK;
+    }
+
+    /**
+     * @brief Consumidor: troca para a publicação mais nova, se houver
+     * @return true se o conteúdo mudou desde o último acquire()
+     */
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_acquire) & FRESH)) return false;
+        int prev = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = prev & INDEX_MASK;
+        return true;
+    }
+
+    /// Consumidor: último buffer adquirido (estável até o próximo acquire())
+    const T& readBuffer() const { return slots_[front_]; }
+
+private:
+    static constexpr int INDEX_MASK = 0x3;
+    static constexpr int FRESH = 0x4;
+
+    T slots_[3];
+    int back_ = 0;                      // Só o produtor
+    int front_ = 1;                     // Só o consumidor
+    std::atomic<int> middle_{2};        // Índice trocado + bit FRESH
+};
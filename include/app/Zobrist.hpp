@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include "app/GameTypes.hpp"
+
+class GameState;
+
+/**
+ * @brief Hash Zobrist do estado da partida (replay, netplay, bot)
+ *
+ * Uma chave de 64 bits por célula (x, y) do maior tabuleiro, gerada em
+ * compilação por splitmix64 de uma semente fixa: o mesmo hash em qualquer
+ * máquina e build. O tabuleiro é o XOR das chaves das células ocupadas,
+ * mantido pelo GameBoard a cada lock/clear/reset (getHash()); stateHash()
+ * junta a ele peça ativa, próxima peça, semente da rodada e placar, em O(1).
+ */
+namespace Zobrist {
+
+/// Chave da célula (x, y); y é a linha lógica (0 = topo)
+uint64_t cell(int x, int y);
+
+/// XOR das chaves das colunas ligadas em mask na linha y (0 para linha vazia)
+uint64_t row(int y, uint32_t mask);
+
+/// Hash de um tabuleiro inteiro a partir das máscaras (garbage, bot, verificação)
+uint64_t board(const uint32_t* rows, int height);
+
+/// Finalizador do splitmix64: espalha um valor pequeno pelos 64 bits
+inline uint64_t mix(uint64_t v) {
+    v += 0x9E3779B97F4A7C15ull;
+    v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ull;
+    v = (v ^ (v >> 27)) * 0x94D049BB133111EBull;
+    return v ^ (v >> 31);
+}
+
+/**
+ * @brief Hash do que os dois lados conseguem reproduzir a partir das mesmas ações
+ *
+ * Tabuleiro, peça ativa, próxima peça, placar/linhas/nível, game over e a
+ * semente da rodada. O estado cru do gerador fica de fora: o painel NEXT e o
+ * bot sorteiam adiantado (peek) conforme a config de cada máquina, então as
+ * palavras do PRNG divergem sem que a sequência de peças mude.
+ */
+uint64_t stateHash(const GameState& state, uint64_t roundSeed);
+
+} // namespace Zobrist
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+
+#include "audio/SpscRing.hpp"
+
+class MusicStream;
+
+/**
+ * @brief Mixer de vozes alimentado pelo callback do SDL
+ *
+ * A thread do jogo apenas enfileira comandos (play, stop, ganhos) numa
+ * SpscRing lock-free; a síntese e a mixagem acontecem no callback do
+ * dispositivo, sobre um pool fixo de vozes. Acordes tocam de fato
+ * simultâneos, sequências usam delayMs e a latência fica limitada ao buffer
+ * do dispositivo. O throttle de sons ambientes (slots) também roda no lado
+ * do áudio, medido em amostras tocadas.
+ */
+class AudioMixer {
+public:
+    static constexpr int MAX_VOICES = 32;
+    static constexpr int MAX_COMMANDS = 256;          // Potência de 2 (SpscRing)
+    static constexpr int MAX_VOICES_PER_COMMAND = 4;
+    static constexpr int MAX_THROTTLE_SLOTS = 8;
+
+    /// Barramentos com ganho próprio (master é aplicado a todos)
+    enum class Bus : Uint8 { MAIN, SFX, AMBIENT, MUSIC, COUNT };
+    enum class Wave : Uint8 { SINE, SQUARE, SAMPLE };
+
+    /**
+     * @brief Parâmetros de uma voz (copiados no play, sem alocação)
+     */
+    struct VoiceParams {
+        Wave wave = Wave::SINE;
+        Bus bus = Bus::MAIN;
+        float freq = 440.0f;
+        float freqEnd = 0.0f;        // > 0: glide linear até freqEnd (sweeps)
+        float volume = 0.25f;
+        int durationMs = 100;        // Ignorado para SAMPLE (usa sampleCount)
+        int delayMs = 0;             // Atraso até o início (arpejos, sequências)
+        int attackMs = 2;            // Envelope linear contra cliques
+        int releaseMs = 5;
+        const float* samples = nullptr;  // PCM mono na taxa do dispositivo (SAMPLE)
+        int sampleCount = 0;
+    };
+
+    /**
+     * @brief Contadores da fila de comandos (lidos pela thread do jogo)
+     */
+    struct Stats {
+        int activeVoices = 0;
+        int queued = 0;
+        int highWater = 0;           // Maior ocupação observada desde open()
+        unsigned overflows = 0;      // Comandos descartados com a fila cheia
+    };
+
+    AudioMixer();
+    ~AudioMixer();
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const { return device_ != 0; }
+    int sampleRate() const { return spec_.freq; }
+
+    /**
+     * @brief Pede o início de uma voz (thread do jogo, lock-free)
+     * @return false se o mixer estiver fechado ou a fila de comandos cheia
+     */
+    bool play(const VoiceParams& params) { return playGroup(&params, 1); }
+
+    /**
+     * @brief Inicia até MAX_VOICES_PER_COMMAND vozes num único comando
+     * @param throttleSlot 1..MAX_THROTTLE_SLOTS-1: descarta o grupo se o mesmo
+     *        slot tocou há menos de throttleMs (decidido no callback); 0 = sem throttle
+     */
+    bool playGroup(const VoiceParams* voices, int count, int throttleSlot = 0, int throttleMs = 0);
+
+    /// Pede silêncio em todas as vozes (assíncrono, via fila)
+    bool stopAll();
+
+    /**
+     * @brief Silencia tudo e descarta comandos pendentes, de forma síncrona
+     *
+     * Ao retornar, nenhuma voz referencia mais buffers SAMPLE, que podem
+     * então ser liberados ou reconstruídos.
+     */
+    void flush();
+
+    /// Ganhos só geram comando quando mudam
+    void setMasterGain(float gain);
+    void setBusGain(Bus bus, float gain);
+
+    Stats stats() const;
+
+    /**
+     * @brief Liga (ou desliga, nullptr) a música em streaming no barramento MUSIC
+     *
+     * Síncrono (trava o dispositivo): ao retornar o callback já usa/largou o stream.
+     */
+    void setMusic(MusicStream* music);
+
+private:
+    struct Voice {
+        bool active = false;
+        Wave wave = Wave::SINE;
+        Bus bus = Bus::MAIN;
+        double phase = 0.0;
+        double phaseInc = 0.0;
+        double phaseIncDelta = 0.0;  // Glide por amostra
+        float volume = 0.0f;
+        int delay = 0;               // Amostras até começar
+        int length = 0;              // Amostras de duração
+        int pos = 0;
+        int attack = 1;
+        int release = 1;
+        const float* samples = nullptr;
+    };
+
+    struct Command {
+        enum class Type : Uint8 { PLAY, STOP_ALL, SET_MASTER_GAIN, SET_BUS_GAIN };
+        Type type = Type::PLAY;
+        Bus bus = Bus::MAIN;         // SET_BUS_GAIN
+        Uint8 voiceCount = 0;        // PLAY
+        Uint8 throttleSlot = 0;      // PLAY (0 = sem throttle)
+        Uint32 throttleMs = 0;
+        float gain = 1.0f;           // SET_*_GAIN
+        VoiceParams voices[MAX_VOICES_PER_COMMAND];
+    };
+
+    static void SDLCALL audioCallback(void* userdata, Uint8* stream, int len);
+    void mix(float* out, int frames);
+    void execute(const Command& cmd);
+    void startVoice(const VoiceParams& params);
+    bool post(const Command& cmd);
+
+    SDL_AudioDeviceID device_ = 0;
+    SDL_AudioSpec spec_{};
+
+    SpscRing<Command, MAX_COMMANDS> commands_;
+
+    // Estado do callback (thread de áudio)
+    Voice voices_[MAX_VOICES];
+    float masterGain_ = 1.0f;
+    float busGain_[(int)Bus::COUNT];
+    Uint64 clock_ = 0;                             // Amostras mixadas desde open()
+    Uint64 slotLastStart_[MAX_THROTTLE_SLOTS] = {};
+    bool slotUsed_[MAX_THROTTLE_SLOTS] = {};
+    Uint64 lastCallbackTicks_ = 0;                 // Buraco entre callbacks > 2 buffers = underrun
+    MusicStream* music_ = nullptr;
+
+    // Estado do produtor (thread do jogo)
+    float postedMaster_ = -1.0f;
+    float postedBus_[(int)Bus::COUNT];
+    SDL_SpinLock producerLock_ = 0;                // Vários produtores -> um por vez no ring
+    std::atomic<int> highWater_{0};
+    std::atomic<unsigned> overflows_{0};
+
+    std::atomic<int> activeVoices_{0};
+};
@@ -14,9 +14,23 @@ public:
     ~AudioSystem() override = default;
 
     // Lifecycle
-    bool initialize() override;
+    bool initialize() override;                  // openDevice() + prepareBank()
+    bool openDevice();                           // Só o dispositivo
+    bool prepareBank();                          // Sintetiza/carrega o banco de SFX; depois dele os sons tocam
     void cleanup() override;
 
+    /**
+     * @brief initialize() numa thread própria (segundo estágio do boot)
+     *
+     * Até isReady() os play* são no-op; setConfig/loadFromConfig/cleanup
+     * esperam a thread (ela lê a config).
+     */
+    bool startAsync();
+    bool isReady() const;                        // Dispositivo aberto e banco pronto
+    bool isStarting() const;                     // A thread de startAsync() ainda roda
+    double lastStartMs() const;                  // Duração da última abertura assíncrona
+    void waitAsync();
+
     // Synthesis
     void playBeep(double freq, int ms, float vol = 0.25f, bool square = true) override;
     void playChord(double baseFreq, int notes[], int count, int ms, float vol = 0.15f) override;
@@ -34,10 +48,13 @@ public:
     void playSweepEffect() override;
     void playScanlineEffect() override;
     bool loadFromConfig(const std::string& key, const std::string& value) override;
+    AudioQueueStats getQueueStats() const override;
+    void setMusicLevel(int level) override;
 
     // Configuration access used elsewhere in the app
     AudioConfig& getConfig();
     const AudioConfig& getConfig() const;
+    void setConfig(const AudioConfig& config);  // Refaz o banco de SFX se os WAVs mudarem
 
     // Legacy compatibility fields (kept while migrating code)
     float masterVolume = 1.0f;
@@ -49,6 +66,8 @@ public:
     bool enableLevelUpSounds = true;
 
 private:
+    static int SDLCALL asyncMain(void* self);
+
     struct Impl;
     Impl* impl_; // pimpl to keep internal types private
 };
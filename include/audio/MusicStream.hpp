@@ -0,0 +1,112 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "audio/SpscRing.hpp"
+
+class MusicDecoder;
+
+/**
+ * @brief Música de fundo em streaming, com crossfade entre faixas
+ *
+ * Dois decks, cada um com um decoder e um ring de PCM mono na taxa do
+ * dispositivo: o que toca e o que entra no fade. A thread própria abre o
+ * arquivo, decodifica em blocos de DECODE_FRAMES e mantém o ring cheio
+ * (RING_FRAMES, ~370 ms a 44.1 kHz); o callback do mixer só copia do ring e
+ * aplica o ganho do fade. Nenhuma faixa fica inteira na memória e a thread
+ * do jogo não decodifica nada: request() só troca o pedido e acorda a thread.
+ * As faixas tocam em loop.
+ *
+ * Formatos: WAV (PCM 8/16/24/32 bits ou float) sempre; OGG Vorbis compilando
+ * com DROPBLOCKS_STB_VORBIS (stb_vorbis.c no include path).
+ */
+class MusicStream {
+public:
+    static constexpr int RING_FRAMES = 16384;     ///< Por deck; potência de 2
+    static constexpr int DECODE_FRAMES = 2048;    ///< Bloco de decode/cópia
+    static constexpr int FILL_INTERVAL_MS = 10;   ///< A thread acorda no mínimo com essa frequência
+
+    struct Stats {
+        unsigned underruns = 0;       ///< Callbacks em que o deck tocando não tinha PCM suficiente
+        int buffered = 0;             ///< Amostras prontas no deck tocando
+        bool fading = false;
+    };
+
+    MusicStream();
+    ~MusicStream();
+
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+
+    /// Sobe a thread de decode para a taxa de saída sampleRate
+    bool start(int sampleRate);
+    /// Para a thread e solta os decoders; o mixer já não pode estar chamando mix()
+    void stop();
+    bool isRunning() const { return thread_ != nullptr; }
+
+    /**
+     * @brief Troca de faixa (thread do jogo, O(1))
+     * @param path Arquivo; vazio = fade para o silêncio
+     * @param crossfadeMs Duração do fade entre a faixa atual e a nova
+     */
+    void request(const std::string& path, int crossfadeMs);
+
+    /// Callback do mixer: soma frames amostras em out com o ganho dado
+    void mix(float* out, int frames, float gain);
+
+    Stats stats() const;
+
+private:
+    enum DeckState : int {
+        IDLE,        ///< Livre para a thread de decode
+        PLAYING,     ///< Publicado: o callback lê, a thread só completa o ring
+        RELEASED     ///< O callback terminou o fade-out; a thread limpa e volta a IDLE
+    };
+
+    struct Deck {
+        SpscSampleRing<RING_FRAMES> ring;
+        std::atomic<int> state{IDLE};
+        std::atomic<bool> streaming{false};       // Decoder vivo: ring vazio no callback = underrun
+        std::atomic<uint32_t> switchSeq{0};       // Troca que publicou o deck (0 = ainda não publicado)
+        std::unique_ptr<MusicDecoder> decoder;    // Só a thread de decode
+    };
+
+    static int SDLCALL threadMain(void* self);
+    void run();
+    bool startTrack(const std::string& path, int crossfadeMs);   // false = deck ainda ocupado, tentar de novo
+    void fill(Deck& deck);
+    void publish(int deck, int crossfadeMs);
+    void mixDeck(int deck, float* out, int frames, float gain, int fadeDir);
+
+    int rate_ = 0;
+    SDL_Thread* thread_ = nullptr;
+    SDL_mutex* mutex_ = nullptr;
+    SDL_cond* wake_ = nullptr;
+
+    // Pedido da thread do jogo (sob mutex_)
+    bool quit_ = false;
+    std::string pendingPath_;
+    int pendingFadeMs_ = 0;
+    uint32_t pendingSeq_ = 0;
+
+    // Thread de decode
+    uint32_t takenSeq_ = 0;
+    std::vector<float> decodeBuf_;
+
+    Deck decks_[2];
+    std::atomic<int> live_{-1};              // Deck que deve tocar (-1 = silêncio)
+    std::atomic<int> switchFade_{0};         // Fade da troca publicada, em amostras
+    std::atomic<uint32_t> switchSeq_{0};     // Sobe a cada troca publicada
+
+    // Callback de áudio
+    uint32_t seenSwitch_ = 0;
+    int cur_ = -1, old_ = -1;                // Entrando/tocando e saindo no fade
+    int fadePos_ = 0, fadeLen_ = 0;
+    float scratch_[256];
+    std::atomic<unsigned> underruns_{0};
+    std::atomic<bool> fading_{false};
+};
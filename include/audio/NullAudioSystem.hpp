@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Interfaces.hpp"
+
+/**
+ * @brief IAudioSystem que não toca nada (simulação headless, testes, batch)
+ */
+class NullAudioSystem : public IAudioSystem {
+public:
+    bool initialize() override { return true; }
+    void cleanup() override {}
+    void playBeep(double, int, float = 0.25f, bool = true) override {}
+    void playChord(double, int[], int, int, float = 0.15f) override {}
+    void playMovementSound() override {}
+    void playRotationSound(bool) override {}
+    void playSoftDropSound() override {}
+    void playHardDropSound() override {}
+    void playKickSound() override {}
+    void playLevelUpSound() override {}
+    void playGameOverSound() override {}
+    void playComboSound(int) override {}
+    void playTetrisSound() override {}
+    void playBackgroundMelody(int) override {}
+    void playTensionSound(int) override {}
+    void playSweepEffect() override {}
+    void playScanlineEffect() override {}
+    bool loadFromConfig(const std::string&, const std::string&) override { return false; }
+};
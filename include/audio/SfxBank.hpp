@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+#include "audio/AudioMixer.hpp"
+
+struct AudioConfig;
+
+/**
+ * @brief Banco de SFX pré-sintetizados (PCM mono float na taxa do dispositivo)
+ *
+ * Os sons de parâmetros fixos (movimento, rotação, drops, kick, level-up,
+ * game over, tetris) são renderizados uma vez em build(); tocar um SFX vira
+ * só uma voz SAMPLE apontando para o buffer. Entradas SFX_FILE_<NOME> da
+ * config substituem a síntese por um WAV convertido no build.
+ */
+class SfxBank {
+public:
+    enum class Sfx : Uint8 {
+        MOVE, ROTATE_CW, ROTATE_CCW, SOFT_DROP, HARD_DROP, KICK,
+        LEVEL_UP, GAME_OVER, TETRIS, COUNT
+    };
+
+    struct Clip {
+        std::vector<float> pcm;
+        AudioMixer::Bus bus = AudioMixer::Bus::MAIN;
+        bool fromFile = false;
+    };
+
+    /**
+     * @brief (Re)constrói todos os clips; o chamador garante que nenhuma voz os usa
+     */
+    void build(int sampleRate, const AudioConfig& config);
+    void clear();
+
+    bool isBuilt() const { return sampleRate_ > 0; }
+    int sampleRate() const { return sampleRate_; }
+    const Clip& get(Sfx sfx) const { return clips_[(int)sfx]; }
+
+    /// Nome usado nas chaves SFX_FILE_<NOME> (ex.: "HARD_DROP")
+    static const char* name(Sfx sfx);
+
+private:
+    void synthesize(Sfx sfx, Clip& clip) const;
+    bool loadWav(const std::string& path, Clip& clip) const;
+
+    Clip clips_[(int)Sfx::COUNT];
+    int sampleRate_ = 0;
+};
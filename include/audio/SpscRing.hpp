@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Fila lock-free de produtor único / consumidor único, tamanho fixo
+ *
+ * Um lado só chama push() (thread do jogo), o outro só front()/pop()
+ * (callback de áudio). Sem alocação e sem locks; push() falha com a fila
+ * cheia e o chamador contabiliza o overflow.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    static constexpr size_t capacity() { return Capacity; }
+
+    /// Produtor: copia o item para a fila; false se cheia
+    bool push(const T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == Capacity) return false;
+        buffer_[head & (Capacity - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumidor: próximo item ou nullptr (válido até o pop())
+    const T* front() const {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return nullptr;
+        return &buffer_[tail & (Capacity - 1)];
+    }
+
+    /// Consumidor: descarta o item devolvido por front()
+    void pop() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /// Ocupação aproximada (exata quando lida pelo produtor logo após push)
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    // Índices em linhas de cache separadas: cada thread escreve só o seu
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    T buffer_[Capacity];
+};
+
+/**
+ * @brief Variante em bloco para PCM (floats), mesmo contrato do SpscRing
+ *
+ * O escritor (thread de decode) chama write(), o leitor (callback) read();
+ * cada lado copia até dois trechos contíguos. reset() só com os dois parados.
+ */
+template <size_t Capacity>
+class SpscSampleRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    static constexpr size_t capacity() { return Capacity; }
+
+    /// Escritor: espaço livre
+    size_t writable() const { return Capacity - (head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_acquire)); }
+    /// Qualquer lado: amostras prontas (aproximado fora do leitor)
+    size_t readable() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed); }
+
+    /// Escritor: copia até n amostras; devolve quantas couberam
+    size_t write(const float* src, size_t n) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t room = Capacity - (head - tail_.load(std::memory_order_acquire));
+        if (n > room) n = room;
+        const size_t at = head & (Capacity - 1);
+        const size_t first = n < Capacity - at ? n : Capacity - at;
+        std::memcpy(buffer_ + at, src, first * sizeof(float));
+        std::memcpy(buffer_, src + first, (n - first) * sizeof(float));
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    /// Leitor: copia até n amostras para dst; devolve quantas havia
+    size_t read(float* dst, size_t n) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t ready = head_.load(std::memory_order_acquire) - tail;
+        if (n > ready) n = ready;
+        const size_t at = tail & (Capacity - 1);
+        const size_t first = n < Capacity - at ? n : Capacity - at;
+        std::memcpy(dst, buffer_ + at, first * sizeof(float));
+        std::memcpy(dst + first, buffer_, (n - first) * sizeof(float));
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    void reset() {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    float buffer_[Capacity];
+};
@@ -5,7 +5,11 @@
 
 // Forward declarations
 class AudioSystem;
+class ConfigManager;
+class PieceManager;
+struct PieceSet;
 class ThemeManager;
+struct Theme;
 class GameState;
 class InputManager;
 struct Piece;
@@ -16,6 +20,22 @@ struct VisualEffectsView;
  * 
  * Functions to apply configuration structures to various game systems
  */
+/** @brief O que uma releitura mudou (bits devolvidos pelos applyReloaded*) */
+namespace ConfigChange {
+enum : unsigned {
+    COLORS       = 1u << 0,  ///< cores do tema -> TextureCache
+    EFFECTS      = 1u << 1,  ///< sweeps/scanlines (lidos por frame)
+    PANELS       = 1u << 2,  ///< ROUNDED/CACHED_PANELS, HUD_FIXED_SCALE, título -> TextureCache
+    PIECE_COLORS = 1u << 3,
+    LAYOUT       = 1u << 4,  ///< geometria -> db_layoutCalculate + TextureCache
+    AUDIO        = 1u << 5,  ///< volumes; WAVs novos refazem o banco de SFX
+    INPUT        = 1u << 6,
+    GAME         = 1u << 7,  ///< velocidade (vale a partir do próximo nível/partida)
+    TIMER        = 1u << 8,  ///< reinicia a contagem
+    PIECES       = 1u << 9   ///< formas/kicks do .pieces
+};
+}
+
 namespace ConfigApplicator {
 
 /**
@@ -28,6 +48,11 @@ void applyThemePieceColors(ThemeManager& themeManager, std::vector<Piece>& piece
  */
 void applyConfigToAudio(AudioSystem& audio, const AudioConfig& config);
 
+/**
+ * @brief Só as cores do VisualConfig (também usado para montar as paletas da ThemeLibrary)
+ */
+void applyColorsToTheme(const VisualConfig& config, Theme& theme);
+
 /**
  * @brief Apply visual configuration to theme and globals
  */
@@ -44,7 +69,7 @@ void applyConfigToGame(GameState& state, const GameConfig& config);
 void applyConfigToPieces(const PiecesConfig& config, ThemeManager& themeManager);
 
 /**
- * @brief Apply input configuration to InputManager (joystick)
+ * @brief Apply input configuration to InputManager (key/joystick mapping, DAS/ARR for all devices)
  */
 void applyConfigToJoystick(InputManager& inputManager, const InputConfig& config);
 
@@ -53,5 +78,23 @@ void applyConfigToJoystick(InputManager& inputManager, const InputConfig& config
  */
 void applyConfigToLayout(const LayoutConfig& config);
 
+/**
+ * @brief Hot reload: aplica só o que difere entre a config viva e a relida
+ *
+ * O que foi aplicado é copiado para live. Com simThreaded, input, áudio,
+ * velocidade e timer ficam para o reinício (a thread da simulação lê esses
+ * valores sem lock); o resto que não dá para trocar com o jogo rodando
+ * (frame pacing, bot, replay...) só é avisado no log.
+ * @return bits de ConfigChange aplicados (o chamador invalida os caches)
+ */
+unsigned applyReloadedConfig(ConfigManager& live, const ConfigManager& fresh, GameState& state, InputManager& input,
+                             ThemeManager& themeManager, VisualEffectsView& visualView, bool simThreaded);
+
+/**
+ * @brief Hot reload do .pieces: cores sempre; formas só com o mesmo número de
+ * peças e sem outra thread lendo PIECES (simulação ou bot)
+ */
+unsigned applyReloadedPieces(PieceSet& set, ThemeManager& themeManager, bool piecesShared);
+
 } // namespace ConfigApplicator
 
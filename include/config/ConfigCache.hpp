@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+class ConfigManager;
+class PieceManager;
+
+/**
+ * @brief Config e peças "compiladas" num blob binário (boot rápido de quiosque)
+ *
+ * Guarda as structs já resolvidas do ConfigManager, o PIECES e as opções do
+ * arquivo de peças (preview, randomizer, bag). Os arquivos de texto continuam
+ * sendo a fonte: o blob registra quais foram lidos (caminho, tamanho, mtime e
+ * hash do conteúdo) e as variáveis de ambiente que escolheram esses
+ * caminhos. Na carga, qualquer fonte com tamanho/mtime diferente tem o
+ * conteúdo re-hasheado; se mudou, ou se outro arquivo passaria a ser
+ * escolhido, o blob é recusado e o boot volta ao parse normal.
+ *
+ * Formato (little-endian): "DBCC", versão, fingerprint do layout das structs,
+ * fontes e payload. Structs trivialmente copiáveis vão inteiras (o blob só
+ * serve para o mesmo binário/plataforma; a fingerprint recusa o resto).
+ */
+namespace ConfigCache {
+
+/**
+ * @brief Carrega o blob em config/pieces/PIECES se ainda bater com as fontes
+ * @return false (sem efeito colateral além do log) se ausente, velho ou corrompido
+ */
+bool load(const std::string& path, ConfigManager& config, PieceManager& pieces);
+
+/**
+ * @brief Grava o estado atual (após loadAll + loadPiecesFile)
+ *
+ * Escreve num .tmp e renomeia, então uma queda no meio não deixa blob pela metade.
+ */
+bool save(const std::string& path, const ConfigManager& config, const PieceManager& pieces);
+
+} // namespace ConfigCache
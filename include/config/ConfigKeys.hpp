@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include "ConfigTypes.hpp"
+
+/** @brief Structs que recebem as chaves lidas de um .cfg */
+struct ConfigTargets {
+    VisualConfig& visual;
+    AudioConfig& audio;
+    InputConfig& input;
+    PiecesConfig& pieces;
+    GameConfig& game;
+    LayoutConfig& layout;
+    TimerConfig& timer;
+};
+
+/**
+ * @brief Tabela de todas as chaves conhecidas do .cfg
+ *
+ * Cada chave tem um handler próprio; a busca é um hash perfeito gerado em
+ * tempo de compilação (hash-and-displace: o hash escolhe o bucket, o seed
+ * do bucket escolhe o slot), então casar uma chave custa uma passada de hash
+ * e uma comparação. Chaves com sufixo livre (PIECE<n>, SFX_FILE_<nome>) são
+ * tratadas depois, por prefixo.
+ */
+namespace ConfigKeys {
+
+enum class Result { APPLIED, INVALID_VALUE, UNKNOWN_KEY };
+
+/// key em maiúsculas; value.data() terminado em '\0'
+Result apply(ConfigTargets& targets, std::string_view key, std::string_view value);
+
+/// Chaves com nome fixo na tabela (diagnóstico)
+size_t count();
+
+} // namespace ConfigKeys
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/** @brief Uma linha KEY=VALUE do .cfg (views para dentro do buffer) */
+struct ConfigEntry {
+    int line = 0;              ///< 1-based
+    std::string_view key;      ///< já em maiúsculas
+    std::string_view value;    ///< value.data() termina em '\0' (atoi/atof direto)
+};
+
+/**
+ * @brief Tokenizer de .cfg numa passada, sem cópias
+ *
+ * Trabalha in-place sobre o buffer do arquivo: a chave é passada para
+ * maiúsculas e o fim do valor vira '\0', então nada é alocado por linha.
+ * Regras do formato: '#' no início ou depois de espaço começa comentário,
+ * ';' corta o resto da linha, espaços em volta da chave e do valor são
+ * ignorados e linhas sem '=' (ou com chave vazia) são puladas.
+ *
+ * data[size] precisa ser gravável (o '\0' da última linha sem '\n').
+ */
+class ConfigTokenizer {
+public:
+    ConfigTokenizer(char* data, size_t size) : p_(data), end_(data + size) {}
+
+    /// Próxima entrada; false no fim do buffer
+    bool next(ConfigEntry& out);
+
+private:
+    char* p_;
+    char* end_;
+    int line_ = 0;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ConfigManager;
+struct PieceSet;
+
+/** @brief Uma releitura pronta para aplicar (null = aquele arquivo não mudou) */
+struct ConfigReload {
+    std::unique_ptr<ConfigManager> config;
+    std::unique_ptr<PieceSet> pieces;
+    ConfigReload();
+    ~ConfigReload();
+    ConfigReload(ConfigReload&&) noexcept;
+    ConfigReload& operator=(ConfigReload&&) noexcept;
+};
+
+/**
+ * @brief Hot reload dos .cfg/.pieces (CONFIG_WATCH_MS)
+ *
+ * Uma thread faz stat dos arquivos a cada intervalo e, quando um muda, relê
+ * tudo num ConfigManager/PieceSet novos, longe da thread principal. A mudança
+ * só é lida depois de ficar estável por um intervalo inteiro (editor no meio
+ * do save) e arquivo sumido é ignorado (save por rename).
+ *
+ * A thread principal chama poll() uma vez por frame: um load atômico e, se há
+ * algo pronto, SDL_TryLockMutex. Nunca espera; o diff e a aplicação ficam com
+ * ConfigApplicator::applyReloadedConfig.
+ */
+class ConfigWatcher {
+public:
+    /// cfgPaths = ConfigManager::getConfigPaths(); piecesPath vazio = não vigia peças
+    ConfigWatcher(const std::vector<std::string>& cfgPaths, const std::string& piecesPath, Uint32 intervalMs);
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    bool start();
+    void stop();
+
+    /// Move a releitura pronta para out; false se não há nada (ou o mutex está ocupado)
+    bool poll(ConfigReload& out);
+
+private:
+    struct Stamp {
+        bool exists = false;
+        uint64_t size = 0;
+        int64_t mtime = 0;   // ns (resolução de segundo fora do Linux)
+        bool operator==(const Stamp& o) const { return exists == o.exists && size == o.size && mtime == o.mtime; }
+        bool operator!=(const Stamp& o) const { return !(*this == o); }
+    };
+    struct Watched {
+        std::string path;
+        Stamp loaded;   // versão já lida
+        Stamp last;     // da última volta (debounce)
+    };
+
+    static Stamp stampOf(const std::string& path);
+    /// true se o arquivo mudou e está estável; atualiza w.last
+    static bool settled(Watched& w);
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    void scan();
+
+    std::vector<Watched> cfgFiles_;
+    std::vector<Watched> piecesFiles_;   // 0 ou 1
+    Uint32 intervalMs_;
+
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+
+    SDL_mutex* mutex_ = nullptr;
+    std::atomic<bool> hasReady_{false};
+    ConfigReload ready_;
+};
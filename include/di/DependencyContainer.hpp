@@ -5,6 +5,7 @@
 #include <functional>
 #include <chrono>
 
+// Registro por nome (string, map, metadados). O jogo usa ServiceRegistry (di/ServiceRegistry.hpp).
 class DependencyContainer {
 public:
     enum class Lifecycle {
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include "Interfaces.hpp"
+
+// 1 = conta resoluções por serviço (describe() mostra); 0 = get() é só uma leitura
+#ifndef DROPBLOCKS_DI_DIAGNOSTICS
+#define DROPBLOCKS_DI_DIAGNOSTICS 0
+#endif
+
+/**
+ * @brief Registro de serviços tipado: um slot por interface, resolvido em compilação
+ *
+ * get<T>() é std::get num tuple de ponteiros: sem hash, sem string, sem pilha
+ * de resolução. Interface fora da lista não compila. Não possui os serviços:
+ * quem registra mantém o objeto vivo (main() ou HeadlessSim).
+ *
+ * O DependencyContainer continua para registro por nome (ferramentas); o
+ * caminho do jogo usa este.
+ */
+template <class... Services>
+class ServiceRegistry {
+public:
+    static constexpr std::size_t COUNT = sizeof...(Services);
+
+    template <class T>
+    void provide(T* service) { std::get<T*>(slots_) = service; }
+
+    /// nullptr se ninguém registrou T
+    template <class T>
+    T* get() const {
+#if DROPBLOCKS_DI_DIAGNOSTICS
+        ++resolves_[indexOf<T>()];
+#endif
+        return std::get<T*>(slots_);
+    }
+
+    template <class T>
+    bool has() const { return std::get<T*>(slots_) != nullptr; }
+
+    /// Todos os slots preenchidos
+    bool complete() const { return (has<Services>() && ...); }
+
+    /// Diagnóstico (fora do caminho quente): "tipo=ok|missing[ xN]" por slot
+    std::string describe() const {
+        std::string out;
+        (appendSlot<Services>(out), ...);
+        return out;
+    }
+
+private:
+    template <class T, std::size_t I = 0>
+    static constexpr std::size_t indexOf() {
+        static_assert(I < COUNT, "service not in this registry");
+        if constexpr (std::is_same<T, std::tuple_element_t<I, std::tuple<Services...>>>::value) return I;
+        else return indexOf<T, I + 1>();
+    }
+
+    template <class T>
+    void appendSlot(std::string& out) const {
+        if (!out.empty()) out += ", ";
+        out += typeid(T).name();
+        out += has<T>() ? "=ok" : "=missing";
+#if DROPBLOCKS_DI_DIAGNOSTICS
+        out += " x" + std::to_string(resolves_[indexOf<T>()]);
+#endif
+    }
+
+    std::tuple<Services*...> slots_{};
+#if DROPBLOCKS_DI_DIAGNOSTICS
+    mutable unsigned long resolves_[COUNT] = {};
+#endif
+};
+
+/// Dependências do GameState
+using GameServices = ServiceRegistry<IAudioSystem, IThemeManager, IPieceManager, IInputManager, IGameConfig>;
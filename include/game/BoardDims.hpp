@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Dimensões do tabuleiro como parâmetro de template
+ *
+ * FixedDims dá largura, altura e máscara de linha cheia como constantes de
+ * compilação (laços com limite fixo, comparações contra imediatos);
+ * DynamicDims carrega os mesmos campos em runtime para qualquer outro tamanho.
+ * withDims() escolhe a instância uma vez e chama f com ela.
+ *
+ * Ao incluir um tamanho em withDims(), acrescente também as instanciações
+ * explícitas no fim de game/Mechanics.cpp.
+ */
+constexpr uint32_t fullRowFor(int cols) { return cols >= 32 ? 0xFFFFFFFFu : ((uint32_t(1) << cols) - 1u); }
+
+template <int C, int R> struct FixedDims {
+    static constexpr int cols = C, rows = R;
+    static constexpr uint32_t fullRow = fullRowFor(C);
+};
+
+struct DynamicDims {
+    int cols, rows;
+    uint32_t fullRow;
+    DynamicDims(int c, int r) : cols(c), rows(r), fullRow(fullRowFor(c)) {}
+};
+
+// Tamanhos comuns (padrão, alto, largo) com limites fixos; o resto no genérico
+template <class F> auto withDims(int cols, int rows, F&& f) -> decltype(f(DynamicDims(cols, rows))) {
+    if (cols == 10 && rows == 20) return f(FixedDims<10, 20>{});
+    if (cols == 10 && rows == 40) return f(FixedDims<10, 40>{});
+    if (cols == 20 && rows == 20) return f(FixedDims<20, 20>{});
+    return f(DynamicDims(cols, rows));
+}
@@ -1,10 +1,19 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include "app/GameTypes.hpp"
 
 bool collides(const Active& piece, const std::vector<std::vector<Cell>>& grid, int dx, int dy, int drot);
+// Bitboard: rowMasks[y] tem o bit x ligado quando (x,y) está ocupado. Dims é
+// FixedDims/DynamicDims (game/BoardDims.hpp), instanciado em Mechanics.cpp
+template <class Dims>
+bool collidesMask(const Active& piece, const uint32_t* rowMasks, Dims dims, int dx, int dy, int drot);
 void lockPiece(const Active& piece, std::vector<std::vector<Cell>>& grid);
-class AudioSystem;
-void rotateWithKicks(Active& act, const std::vector<std::vector<Cell>>& grid, int dir, AudioSystem& audio);
-
-
+class GameBoard;
+// Sem som aqui: quem chama vira o resultado em evento (GameEventType::KICKED/ROTATED)
+enum class RotateResult { BLOCKED, ROTATED, KICKED };
+RotateResult rotateWithKicks(Active& act, const std::vector<std::vector<Cell>>& grid, int dir);
+RotateResult rotateWithKicks(Active& act, const GameBoard& board, int dir);
+// Direto sobre máscaras de linha (busca do bot sobre cópias do tabuleiro)
+template <class Dims>
+RotateResult rotateWithKicks(Active& act, const uint32_t* rowMasks, Dims dims, int dir);
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
+#include "IInputManager.hpp"
+#include "BotInput.hpp"
+
+class BotEngine;
+class GameState;
+class InputManager;
+class ReplayRecorder;
+
+/**
+ * @brief Attract mode de quiosque: o bot joga depois de um tempo sem input
+ *
+ * Decorator do input vivo. Fora da demo repassa tudo e cronometra a
+ * ociosidade pelo contador de atividade do InputManager; passados idleMs sem
+ * tecla/botão, entra na demo e o BotInput interno assume (busca barata, uma
+ * ação a cada actionDelayMs, recomeço automático). Na demo o input vivo é
+ * lido só para detectar atividade: a primeira entrada real encerra a demo e
+ * é descartada. Cada transição devolve shouldForceRestart() uma vez, então a
+ * lógica chama restartRound() e a partida seguinte começa do zero.
+ *
+ * O render reduzido fica com quem roda o loop: isActive() pode ser lido de
+ * outra thread (modo threaded).
+ */
+class AttractInput : public IInputManager {
+public:
+    AttractInput(InputManager& live, const GameState& state, BotEngine& engine, Uint32 idleMs);
+    ~AttractInput();
+
+    void setActionDelayMs(Uint32 ms) { bot_->setActionDelayMs(ms); }
+    /// Partidas da demo não são gravadas
+    void setRecorder(ReplayRecorder* recorder) { recorder_ = recorder; }
+
+    bool isActive() const { return active_.load(std::memory_order_relaxed); }
+    /// Demos iniciadas desde a criação (diagnóstico)
+    Uint32 demosStarted() const { return demos_; }
+
+    void update() override;
+    void resetTimers() override;
+
+    bool shouldMoveLeft() override { return source().shouldMoveLeft(); }
+    bool shouldMoveRight() override { return source().shouldMoveRight(); }
+    bool shouldSoftDrop() override { return source().shouldSoftDrop(); }
+    bool shouldHardDrop() override { return source().shouldHardDrop(); }
+    bool shouldRotateCCW() override { return source().shouldRotateCCW(); }
+    bool shouldRotateCW() override { return source().shouldRotateCW(); }
+    bool shouldPause() override { return passLive() && live().shouldPause(); }
+    bool shouldRestart() override { return source().shouldRestart(); }
+    bool shouldForceRestart() override;
+    bool shouldQuit() override;
+    bool shouldScreenshot() override { return passLive() && live().shouldScreenshot(); }
+    bool shouldToggleDebug() override { return passLive() && live().shouldToggleDebug(); }
+    bool shouldToggleTimer() override { return passLive() && live().shouldToggleTimer(); }
+
+    int moveLeftSteps() override { return source().moveLeftSteps(); }
+    int moveRightSteps() override { return source().moveRightSteps(); }
+    int softDropSteps() override { return source().softDropSteps(); }
+    /// Na demo as ações são do bot: sem latência de input a medir
+    uint64_t takeInputStamp() override;
+
+private:
+    IInputManager& live();
+    /// Fora da demo e fora do tick de transição (a entrada que acordou a demo é descartada)
+    bool passLive() const { return !isActive() && !restartPending_; }
+    IInputManager& source() { return isActive() ? static_cast<IInputManager&>(*bot_) : live(); }
+    void setActive(bool on);
+
+    InputManager& live_;
+    const GameState& state_;
+    std::unique_ptr<BotInput> bot_;
+    ReplayRecorder* recorder_ = nullptr;
+    Uint32 idleMs_;
+
+    std::atomic<bool> active_{false};
+    bool restartPending_ = false;    // Transição: shouldForceRestart() devolve true uma vez
+    Uint32 lastActivity_ = 0;        // Último valor de getActivityCount()
+    Uint32 lastActivityMs_ = 0;
+    Uint32 demos_ = 0;
+};
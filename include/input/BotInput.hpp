@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "IInputManager.hpp"
+#include "SyntheticInput.hpp"
+#include "app/GameTypes.hpp"
+
+class BotEngine;
+class GameState;
+
+/**
+ * @brief Fonte de input que joga sozinha (attract mode, avaliação de pesos)
+ *
+ * A cada peça nova pede a BotEngine onde travá-la e depois emite uma ação
+ * por tick (no máximo uma a cada actionDelayMs) pelo caminho mais curto até
+ * lá, terminando em hard drop. Se a gravidade mexer na peça no meio do
+ * caminho, o caminho é recalculado da posição real. Pause, quit, screenshot
+ * e toggles continuam vindo do input vivo (se houver).
+ */
+class BotInput : public IInputManager {
+public:
+    BotInput(BotEngine& engine, const GameState& state, IInputManager* live = nullptr);
+
+    /// Intervalo mínimo entre ações (0 = uma por tick)
+    void setActionDelayMs(Uint32 ms) { actionDelayMs_ = ms; }
+    /// Recomeça sozinho depois do game over (após delayMs)
+    void setAutoRestart(bool on, Uint32 delayMs = 2000) { autoRestart_ = on; restartDelayMs_ = delayMs; }
+
+    /// Peças jogadas e tempo da última busca (diagnóstico)
+    uint32_t piecesPlayed() const { return piecesPlayed_; }
+    double lastSearchMs() const { return lastSearchMs_; }
+
+    void update() override;
+    void resetTimers() override { if (live_) live_->resetTimers(); havePlan_ = false; }
+
+    bool shouldMoveLeft() override { return current_ & SyntheticInput::MOVE_LEFT; }
+    bool shouldMoveRight() override { return current_ & SyntheticInput::MOVE_RIGHT; }
+    bool shouldSoftDrop() override { return current_ & SyntheticInput::SOFT_DROP; }
+    bool shouldHardDrop() override { return current_ & SyntheticInput::HARD_DROP; }
+    bool shouldRotateCCW() override { return current_ & SyntheticInput::ROTATE_CCW; }
+    bool shouldRotateCW() override { return current_ & SyntheticInput::ROTATE_CW; }
+    bool shouldPause() override { return live_ && live_->shouldPause(); }
+    bool shouldRestart() override { return (current_ & SyntheticInput::RESTART) || (live_ && live_->shouldRestart()); }
+    bool shouldForceRestart() override { return live_ && live_->shouldForceRestart(); }
+    bool shouldQuit() override { return live_ && live_->shouldQuit(); }
+    bool shouldScreenshot() override { return live_ && live_->shouldScreenshot(); }
+    bool shouldToggleDebug() override { return live_ && live_->shouldToggleDebug(); }
+    bool shouldToggleTimer() override { return live_ && live_->shouldToggleTimer(); }
+
+private:
+    void think();
+
+    BotEngine& engine_;
+    const GameState& state_;
+    IInputManager* live_;
+
+    Uint32 actionDelayMs_ = 0;
+    bool autoRestart_ = false;
+    Uint32 restartDelayMs_ = 2000;
+
+    uint16_t current_ = 0;
+    bool havePlan_ = false;
+    Active target_{0, 0, 0, 0};
+    int piecesSeen_ = -1;            // Soma de getPieceStats() quando o alvo foi escolhido
+    Uint32 lastActionMs_ = 0;
+    Uint32 gameOverAtMs_ = 0;
+    bool wasGameOver_ = false;
+    uint32_t piecesPlayed_ = 0;
+    double lastSearchMs_ = 0.0;
+    std::vector<uint16_t> path_;
+};
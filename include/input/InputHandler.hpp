@@ -21,6 +21,14 @@ public:
     virtual bool shouldScreenshot() = 0;
     virtual bool shouldToggleDebug() = 0;
     virtual bool shouldToggleTimer() = 0;
+    virtual bool shouldCycleTheme() { return false; }  // Só teclado (KEY_THEME)
+    virtual bool shouldRewind() { return false; }      // Só teclado (KEY_REWIND, PRACTICE_MODE)
+    virtual bool shouldDumpTrace() { return false; }   // Só teclado (KEY_TRACE, TRACE_SECONDS)
+
+    // Passos de DAS/ARR vencidos desde a última consulta (aplicados em ordem)
+    virtual int moveLeftSteps() { return shouldMoveLeft() ? 1 : 0; }
+    virtual int moveRightSteps() { return shouldMoveRight() ? 1 : 0; }
+    virtual int softDropSteps() { return shouldSoftDrop() ? 1 : 0; }
 
     virtual void update() = 0;
     virtual bool isConnected() = 0;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <SDL2/SDL.h>
@@ -8,20 +9,55 @@
 
 // Forward declaration
 class KeyboardInput;
+class JoystickInput;
+class InputSampler;
 
 class InputManager : public IInputManager {
 private:
     std::vector<std::unique_ptr<InputHandler>> handlers;
     InputHandler* primaryHandler = nullptr;
     KeyboardInput* keyboardHandler = nullptr;  // Direct access for event forwarding
+    JoystickInput* joystickHandler = nullptr;  // Idem: botões, eixos e hot-plug
+    std::vector<KeyboardInput*> seatKeyboards;  // Teclados dos outros assentos (split-screen), não são handlers
     bool quitRequested = false;
+    bool pumpEvents = true;  // false: outra thread (a do vídeo) chama SDL_PumpEvents
+    Uint32 activityCount = 0;  // Eventos de input real (tecla, botão, hat, eixo fora da zona morta)
+    Uint32 windowEventCount = 0;
+    Uint32 targetsResetCount = 0;   // SDL_RENDER_TARGETS_RESET
+    Uint32 deviceResetCount = 0;    // SDL_RENDER_DEVICE_RESET
+    Uint64 pendingStamp = 0;   // Chegada do primeiro evento de ação ainda não lido (takeInputStamp)
+    InputSampler* sampler = nullptr;  // INPUT_THREAD: as teclas vêm dele, não dos eventos do SDL
+    Uint32 sampleCutoff = 0;          // Instante (SDL ticks) do próximo passo; 0 = agora
+    Uint32 lastCutoff = 0;
+
+    void stampEvent(const SDL_Event& e) { stampTicks(e.common.timestamp); }
+    void stampTicks(Uint32 timestamp);
+    void drainSamples(Uint32 cutoff);
 
 public:
     void addHandler(std::unique_ptr<InputHandler> handler);
     void setPrimaryHandler(InputHandler* handler) { primaryHandler = handler; }
     
     void update() override;
+    // Modo threaded: update() só retira eventos da fila (SDL_PeepEvents) sem bombear
+    void setPumpEvents(bool pump) { pumpEvents = pump; }
+    /// INPUT_THREAD: teclado lido pelo sampler (nullptr volta aos eventos do SDL)
+    void setSampler(InputSampler* s);
+    /// Instante do passo que vai rodar: update() só aplica as amostras até ele
+    void setSampleCutoff(Uint32 ticks) { sampleCutoff = ticks; }
     void handleKeyboardEvent(const SDL_KeyboardEvent& event);  // Forward events to KeyboardInput
+    // Split-screen: o mesmo evento de tecla também vai para estes (o dono mantém vivo e remove)
+    void addSeatKeyboard(KeyboardInput* keyboard) { if (keyboard) seatKeyboards.push_back(keyboard); }
+    void removeSeatKeyboard(KeyboardInput* keyboard) {
+        seatKeyboards.erase(std::remove(seatKeyboards.begin(), seatKeyboards.end(), keyboard), seatKeyboards.end());
+    }
+    // Muda a cada input real visto por update() (detecção de ociosidade do attract mode)
+    Uint32 getActivityCount() const { return activityCount; }
+    /// Eventos que pedem redesenho da janela (exposta, redimensionada, targets perdidos)
+    Uint32 getWindowEventCount() const { return windowEventCount; }
+    /// Render targets / device perdidos (também contam em getWindowEventCount)
+    Uint32 getTargetsResetCount() const { return targetsResetCount; }
+    Uint32 getDeviceResetCount() const { return deviceResetCount; }
     
     std::vector<std::unique_ptr<InputHandler>>& getHandlers() { return handlers; }
     InputHandler* getActiveHandler() {
@@ -38,6 +74,10 @@ public:
     bool shouldPause() override { for (auto& h : handlers) if (h->isConnected() && h->shouldPause()) return true; return false; }
     bool shouldRestart() override { for (auto& h : handlers) if (h->isConnected() && h->shouldRestart()) return true; return false; }
     bool shouldForceRestart() override { for (auto& h : handlers) if (h->isConnected() && h->shouldForceRestart()) return true; return false; }
+    // Dispositivos segurando a mesma direção não somam passos: vale o maior
+    int moveLeftSteps() override { int n = 0; for (auto& h : handlers) if (h->isConnected()) n = std::max(n, h->moveLeftSteps()); return n; }
+    int moveRightSteps() override { int n = 0; for (auto& h : handlers) if (h->isConnected()) n = std::max(n, h->moveRightSteps()); return n; }
+    int softDropSteps() override { int n = 0; for (auto& h : handlers) if (h->isConnected()) n = std::max(n, h->softDropSteps()); return n; }
     bool shouldQuit() override {
         if (quitRequested) return true;
         for (auto& h : handlers) if (h->isConnected() && h->shouldQuit()) return true; return false;
@@ -45,8 +85,13 @@ public:
     bool shouldScreenshot() override { for (auto& h : handlers) if (h->isConnected() && h->shouldScreenshot()) return true; return false; }
     bool shouldToggleDebug() override { for (auto& h : handlers) if (h->isConnected() && h->shouldToggleDebug()) return true; return false; }
     bool shouldToggleTimer() override { for (auto& h : handlers) if (h->isConnected() && h->shouldToggleTimer()) return true; return false; }
+    // Fora do IInputManager: troca de tema é do loop, não da lógica (nem do replay)
+    bool shouldCycleTheme() { for (auto& h : handlers) if (h->isConnected() && h->shouldCycleTheme()) return true; return false; }
+    bool shouldRewind() { for (auto& h : handlers) if (h->isConnected() && h->shouldRewind()) return true; return false; }
+    bool shouldDumpTrace() { for (auto& h : handlers) if (h->isConnected() && h->shouldDumpTrace()) return true; return false; }
+    uint64_t takeInputStamp() override { Uint64 s = pendingStamp; pendingStamp = 0; return s; }
     void resetTimers() override { auto h = getActiveHandler(); if (h) h->resetTimers(); }
-    void cleanup() { quitRequested = false; handlers.clear(); primaryHandler = nullptr; keyboardHandler = nullptr; }
+    void cleanup() { quitRequested = false; handlers.clear(); seatKeyboards.clear(); primaryHandler = nullptr; keyboardHandler = nullptr; joystickHandler = nullptr; }
 };
 
 
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "audio/SpscRing.hpp"
+
+// Leitura direta do evdev (/dev/input/event*); fora do Linux o INPUT_THREAD não tem fonte
+#ifndef DROPBLOCKS_EVDEV
+#  if defined(__linux__)
+#    define DROPBLOCKS_EVDEV 1
+#  else
+#    define DROPBLOCKS_EVDEV 0
+#  endif
+#endif
+
+/**
+ * @brief Thread de amostragem das teclas (INPUT_THREAD), independente do vsync
+ *
+ * Sem ela a tecla só é vista quando o GameLoop bombeia o SDL, uma vez por
+ * frame: a 60 Hz um toque espera até ~16 ms e chega com o timestamp do
+ * pump. SDL_PumpEvents não pode sair da thread do vídeo, então a fonte aqui
+ * é o evdev do Linux: a thread espera em poll() nos teclados (e encoders de
+ * arcade, que são teclados), acorda na hora do evento (em vez de amostrar a
+ * 1 kHz) e empurra a tecla com o timestamp do kernel, já em SDL ticks, numa
+ * SpscRing.
+ *
+ * O consumidor é o InputManager, a cada passo da simulação: só entram as
+ * amostras até o instante daquele passo (setSampleCutoff), então um toque no
+ * meio do frame vale no passo certo e o DAS conta a partir do evento real.
+ */
+class InputSampler {
+public:
+    static constexpr Uint32 RESCAN_MS = 2000;      ///< Teclados conectados depois do boot
+    static constexpr int POLL_TIMEOUT_MS = 50;     ///< poll() acorda no evento; o timeout só confere quit/rescan
+    static constexpr int MAX_DEVICES = 16;
+
+    struct Sample {
+        Uint32 timestamp = 0;        ///< SDL ticks do evento no kernel
+        SDL_Scancode scancode = SDL_SCANCODE_UNKNOWN;
+        bool down = false;
+    };
+
+    InputSampler() = default;
+    ~InputSampler() { stop(); }
+    InputSampler(const InputSampler&) = delete;
+    InputSampler& operator=(const InputSampler&) = delete;
+
+    /// Abre os teclados e inicia a thread; false = sem evdev ou sem permissão (fica o SDL)
+    bool start();
+    void stop();
+    bool isRunning() const { return thread_ != nullptr; }
+
+    // Consumidor (thread da simulação)
+    const Sample* front() const { return ring_.front(); }
+    void pop() { ring_.pop(); }
+
+    int devices() const { return devices_.load(std::memory_order_relaxed); }
+    uint32_t samples() const { return samples_.load(std::memory_order_relaxed); }
+    uint32_t overflows() const { return overflows_.load(std::memory_order_relaxed); }
+
+private:
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    void rescan();
+    void closeDevices();
+    void readDevice(size_t index);
+
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+
+    // Só a thread do sampler (depois do start)
+    struct Device { int fd = -1; int node = -1; };
+    std::vector<Device> fds_;
+    Uint32 lastScan_ = 0;
+
+    SpscRing<Sample, 1024> ring_;
+    std::atomic<int> devices_{0};
+    std::atomic<uint32_t> samples_{0};
+    std::atomic<uint32_t> overflows_{0};
+};
@@ -10,6 +10,11 @@
  * 
  * DAS (Delayed Auto Shift): Initial delay before auto-repeat begins
  * ARR (Auto Repeat Rate): Interval between subsequent repeats
+ *
+ * Repeats are scheduled from the press timestamp (SDL event timestamp for the
+ * keyboard, poll time for the joystick) instead of being sampled once per
+ * frame: consumeSteps() returns every ARR step that actually elapsed, so a
+ * frame hitch neither eats nor bunches moves.
  */
 class InputTimingManager {
 public:
@@ -21,10 +26,18 @@ public:
         Uint32 lastTriggerTime = 0;  // When the action was last triggered
         bool wasActive = false;      // Previous frame state for press detection
         
+        // Event-driven repeat state (see press()/release()/consumeSteps())
+        bool held = false;           // Between press and release events
+        Uint32 nextRepeatTime = 0;   // Timestamp of the next scheduled repeat
+        int pendingSteps = 0;        // Steps elapsed but not yet consumed
+        
         void reset() {
             pressTime = 0;
             lastTriggerTime = 0;
             wasActive = false;
+            held = false;
+            nextRepeatTime = 0;
+            pendingSteps = 0;
         }
     };
     
@@ -36,6 +49,14 @@ public:
         Uint32 ARR = 50;   // Auto Repeat Rate (ms) - repeat interval
         Uint32 softDropDelay = 100;  // Special timing for soft drop (ms)
     };
+    
+    /**
+     * @brief Repeating actions with their own DAS/ARR timer
+     */
+    enum class Direction { LEFT, RIGHT, DOWN };
+    
+    /// Limite de passos entregues por consumeSteps() (ARR=0 ou travamentos longos)
+    static constexpr int MAX_STEPS_PER_UPDATE = 64;
 
 private:
     TimingConfig config_;
@@ -80,6 +101,28 @@ public:
      */
     bool shouldTriggerOnce(bool isActive, DirectionTimer& timer);
     
+    /**
+     * @brief Register a press event (counts one immediate step, schedules DAS)
+     * @param timestamp Event time in SDL ticks (SDL_KeyboardEvent::timestamp)
+     */
+    void press(Direction dir, Uint32 timestamp);
+    
+    /**
+     * @brief Register a release event; repeats due before it are kept
+     */
+    void release(Direction dir, Uint32 timestamp);
+    
+    /**
+     * @brief Level-based feed for polled devices (press/release on edges)
+     */
+    void setHeld(Direction dir, bool isHeld, Uint32 timestamp);
+    
+    /**
+     * @brief Number of steps (press + DAS/ARR repeats) elapsed up to now
+     * @return Steps to apply in order, at most MAX_STEPS_PER_UPDATE
+     */
+    int consumeSteps(Direction dir, Uint32 now);
+    
     /**
      * @brief Reset all timers (called when game state changes)
      */
@@ -106,12 +149,13 @@ public:
     void setSoftDropTiming(Uint32 delay);
 
 private:
+    DirectionTimer& timerFor(Direction dir);
+    
+    /// Intervalo de repetição do timer (softDropDelay para DOWN, ARR nos demais)
+    Uint32 repeatRate(Direction dir) const;
+    
     /**
-     * @brief Core timing logic with DAS/ARR system
-     * @param isActive Current input state
-     * @param timer Direction timer to update
-     * @param useSpecialDelay If true, uses softDropDelay instead of ARR
-     * @return True if action should trigger
+     * @brief Move repeats scheduled up to `until` into pendingSteps
      */
-    bool shouldTriggerWithTiming(bool isActive, DirectionTimer& timer, bool useSpecialDelay = false);
+    void accumulateRepeats(DirectionTimer& timer, Uint32 until, Uint32 rate);
 };
\ No newline at end of file
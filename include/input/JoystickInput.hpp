@@ -8,7 +8,7 @@
  * @brief Joystick input handler
  * 
  * Handles joystick/controller input with analog and digital support
- * Uses the modular JoystickSystem internally
+ * Uses the modular JoystickSystem internally; driven by SDL events, not polling
  */
 class JoystickInput : public InputHandler {
 private:
@@ -30,7 +30,12 @@ public:
     bool shouldScreenshot() override;
     bool shouldToggleDebug() override;
     bool shouldToggleTimer() override;
+    int moveLeftSteps() override;
+    int moveRightSteps() override;
+    int softDropSteps() override;
     
+    /// Joystick/controller events from InputManager::update (state, DAS/ARR, hot-plug)
+    void handleEvent(const SDL_Event& event);
     void update() override;
     bool isConnected() override;
     void resetTimers() override;
@@ -40,6 +45,7 @@ public:
     
     // Configuration access
     JoystickConfig& getConfig();
+    InputTimingManager& getTimingManager();
     
     // Check if joystick has active input (for fallback to keyboard)
     bool hasActiveInput();
@@ -15,6 +15,7 @@ private:
     SDL_Joystick* joystick_ = nullptr;
     SDL_GameController* controller_ = nullptr;
     int joystickId_ = -1;
+    SDL_JoystickID instanceId_ = -1;   // "which" dos eventos deste dispositivo
     bool isConnected_ = false;
     std::string deviceName_;
     
@@ -23,12 +24,15 @@ public:
     
     // Device management
     bool initialize();
+    /// Abre o dispositivo de índice deviceIndex (GameController se houver mapeamento)
+    bool open(int deviceIndex);
     void cleanup();
     
     // Getters
     SDL_Joystick* getJoystick() const { return joystick_; }
     SDL_GameController* getController() const { return controller_; }
     int getJoystickId() const { return joystickId_; }
+    SDL_JoystickID getInstanceId() const { return instanceId_; }
     bool isConnected() const { return isConnected_; }
     const std::string& getDeviceName() const { return deviceName_; }
 };
@@ -80,57 +84,90 @@ public:
 };
 
 /**
- * @brief Joystick state management
- * 
- * Tracks current state of buttons and analog inputs (simplified - timing handled by InputTimingManager)
+ * @brief Joystick state as an action bitmask, fed by SDL events
+ *
+ * Each source (raw buttons, hat, GameController D-pad, sticks) keeps its own
+ * bits; held is their union mapped to actions. Rising edges seen between two
+ * latchPressed() calls are kept in pressed, so a tap shorter than a frame
+ * still counts. Nothing is polled per frame.
  */
 class JoystickState {
 public:
-    // Button states (for press detection)
-    bool buttonStates[32] = {false};
-    bool lastButtonStates[32] = {false};
-    
-    // Analog states
+    enum Action : Uint32 {
+        LEFT = 1u << 0,
+        RIGHT = 1u << 1,
+        DOWN = 1u << 2,         // soft drop
+        ROTATE_CCW = 1u << 3,   // também cima (botão, D-pad, analógico)
+        ROTATE_CW = 1u << 4,
+        HARD_DROP = 1u << 5,
+        PAUSE = 1u << 6,
+        START = 1u << 7,
+        QUIT = 1u << 8
+    };
+    
+    Uint32 buttons = 0;      // bit i = botão cru i (SDL_JOYBUTTON*)
+    Uint32 hatActions = 0;   // hat 0
+    Uint32 padActions = 0;   // D-pad do GameController (SDL_CONTROLLERBUTTON*)
+    Uint32 axisActions = 0;  // analógicos além da zona morta
+    
+    Uint32 held = 0;         // Ações seguras agora
+    Uint32 pressed = 0;      // Bordas de subida do último latchPressed()
+    Uint32 pendingPressed = 0;
+    
+    // Analog states (já com sensibilidade e inversão de Y)
     float leftStickX = 0.0f;
     float leftStickY = 0.0f;
     float rightStickX = 0.0f;
     float rightStickY = 0.0f;
     
-    // Previous analog states (for press detection)
-    float lastLeftStickX = 0.0f;
-    float lastLeftStickY = 0.0f;
+    /**
+     * @brief Apply one button/hat/axis event
+     * @return Actions whose held state changed
+     */
+    Uint32 applyEvent(const SDL_Event& e, const JoystickConfig& config);
     
-    // State management
-    void updateButtonStates(const JoystickDevice& device, const JoystickConfig& config);
-    bool isButtonPressed(int button) const;
+    /// Bordas acumuladas desde a última chamada viram o pressed deste update
+    void latchPressed() { pressed = pendingPressed; pendingPressed = 0; }
+    /// Consome a borda (mais de uma consulta no mesmo update devolve true uma vez)
+    bool takePressed(Uint32 action) { bool p = (pressed & action) != 0; pressed &= ~action; return p; }
+    bool isHeld(Uint32 action) const { return (held & action) != 0; }
     
-    // Analog press detection (for rotation - single press only)
-    bool isAnalogPressed(float currentValue, float lastValue, float deadzone, bool checkNegative) const;
+    void clear();
+
+private:
+    Uint32 buttonActions(const JoystickConfig& config) const;
+    void updateAxisActions(const JoystickConfig& config);
 };
 
 /**
  * @brief Joystick input processor
  * 
- * Processes joystick input and converts to game actions using unified timing system
+ * Turns the action bitmask into game actions; repeated directions go to the
+ * unified DAS/ARR timer with the SDL event timestamp (sub-frame timing)
  */
 class JoystickInputProcessor {
 private:
-    const JoystickConfig& config_;
-    const JoystickState& state_;
-    const JoystickDevice& device_;
+    JoystickState& state_;
     
     // Unified timing manager (replaces duplicated DAS/ARR logic)
     mutable InputTimingManager timingManager_;
     
-    // Timers for single-press actions
-    mutable InputTimingManager::DirectionTimer rotateCCWTimer_;
-    mutable InputTimingManager::DirectionTimer rotateCWTimer_;
-    mutable InputTimingManager::DirectionTimer hardDropTimer_;
-    mutable InputTimingManager::DirectionTimer pauseTimer_;
-    mutable InputTimingManager::DirectionTimer restartTimer_;
-    
 public:
-    JoystickInputProcessor(const JoystickConfig& config, const JoystickState& state, const JoystickDevice& device);
+    JoystickInputProcessor(const JoystickConfig& config, JoystickState& state);
+    
+    /**
+     * @brief Press/release repeated directions whose held state changed
+     */
+    void onActionsChanged(Uint32 changed, Uint32 timestamp);
+    
+    /**
+     * @brief Reset DAS/ARR, re-arming directions still held from now
+     */
+    void resetTimers();
+    
+    int moveLeftSteps() const;
+    int moveRightSteps() const;
+    int softDropSteps() const;
     
     bool shouldMoveLeft() const;
     bool shouldMoveRight() const;
@@ -150,7 +187,10 @@ public:
 /**
  * @brief Main joystick system coordinator
  * 
- * Coordinates joystick device, configuration, state, and input processing
+ * Coordinates joystick device, configuration, state, and input processing.
+ * InputManager::update forwards every joystick/controller event to
+ * handleEvent(); device added/removed events open and close the device
+ * without rescanning.
  */
 class JoystickSystem {
 private:
@@ -166,6 +206,7 @@ public:
     bool initialize();
     void cleanup();
     void update();
+    void handleEvent(const SDL_Event& e);
     
     // Configuration
     JoystickConfig& getConfig() { return config_; }
@@ -186,6 +227,9 @@ public:
     bool shouldRestart() const;
     bool shouldQuit() const;
     bool shouldScreenshot() const;
+    int moveLeftSteps() const;
+    int moveRightSteps() const;
+    int softDropSteps() const;
     
     // Connection status
     bool isConnected() const;
@@ -196,4 +240,3 @@ public:
     // Access to timing manager for configuration
     InputTimingManager& getTimingManager() const;
 };
-
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include "ConfigTypes.hpp"
+
+/**
+ * @brief Tabela scancode -> ação do teclado (KEY_* no .cfg)
+ *
+ * Um byte por scancode: o evento de tecla vira uma consulta e um bit da
+ * máscara de ações do KeyboardInput. Uma tecla pertence a uma ação só (o
+ * último bind vence); uma ação aceita até KEYS_PER_ACTION teclas.
+ */
+class KeyMap {
+public:
+    static constexpr uint8_t NONE = 0xFF;
+
+    KeyMap() { setDefaults(); }
+
+    /// Setas, Z/X, espaço, P, Enter, R, ESC, F12, D, T
+    void setDefaults();
+    /// Split-screen: 1 = setDefaults(); 2 = J/L/K, U/I, O (Y restart); 3 = keypad 4/6/5,
+    /// 7/8, 0 (Enter restart); 4 = C/B/V, F/G, N (H restart); outros ficam sem teclas
+    void setSeatDefaults(int seat);
+    /// Linhas zeradas de config.keys ficam com as teclas padrão
+    void load(const InputConfig& config);
+
+    void bind(KeyAction action, SDL_Scancode key);
+    void unbind(KeyAction action);
+
+    /// Ação da tecla, ou -1
+    int actionOf(SDL_Scancode key) const {
+        return (unsigned)key < (unsigned)SDL_NUM_SCANCODES && table_[key] != NONE ? table_[key] : -1;
+    }
+
+    static uint32_t bit(KeyAction action) { return 1u << (int)action; }
+
+private:
+    uint8_t table_[SDL_NUM_SCANCODES];
+};
+
+static_assert(KEY_ACTION_COUNT <= 32, "KeyboardInput keeps actions in a uint32_t");
@@ -1,106 +1,92 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include "InputHandler.hpp"
 #include "InputTimingManager.hpp"
+#include "KeyMap.hpp"
 
+/**
+ * @brief Keyboard input driven by key events and a remappable KeyMap
+ *
+ * Each event is one table lookup that updates a uint32_t action mask; presses
+ * seen between two update() calls are latched as edges, so every shouldX()
+ * is a bit test (a tap shorter than a frame still counts).
+ */
 class KeyboardInput : public InputHandler {
 private:
-    // Clean key states (no OS auto-repeat)
-    bool keyStates[SDL_NUM_SCANCODES] = {false};
+    KeyMap keyMap_;
+    uint8_t downKeys_[KEY_ACTION_COUNT] = {0};  // Teclas seguras por ação (várias teclas na mesma ação)
+    uint32_t held_ = 0;                          // Ações seguras agora
+    uint32_t pressed_ = 0;                       // Bordas de subida deste update
+    uint32_t pendingPressed_ = 0;                // Bordas ainda não latched
     
     // Unified timing manager (same as joystick for uniformity)
     InputTimingManager timingManager_;
+    Uint32 stepTime_ = 0;                        // Instante do passo (INPUT_THREAD); 0 = SDL_GetTicks()
     
-    // Timers for single-press actions
-    InputTimingManager::DirectionTimer rotateCCWTimer_;
-    InputTimingManager::DirectionTimer rotateCWTimer_;
-    InputTimingManager::DirectionTimer hardDropTimer_;
-    InputTimingManager::DirectionTimer pauseTimer_;
-    InputTimingManager::DirectionTimer restartTimer_;
-    InputTimingManager::DirectionTimer forceRestartTimer_;
-    InputTimingManager::DirectionTimer quitTimer_;
-    InputTimingManager::DirectionTimer screenshotTimer_;
-    InputTimingManager::DirectionTimer debugTimer_;
-    InputTimingManager::DirectionTimer timerToggleTimer_;
-
-    bool isKeyActive(SDL_Scancode key) {
-        return keyStates[key];
+    Uint32 now() const { return stepTime_ ? stepTime_ : SDL_GetTicks(); }
+    
+    /// Borda de uma ação de um toque; consome (uma consulta por update)
+    bool takePressed(KeyAction action) {
+        uint32_t b = KeyMap::bit(action);
+        bool p = (pressed_ & b) != 0;
+        pressed_ &= ~b;
+        return p;
     }
 
 public:
-    // Movement with DAS/ARR (uniform with joystick)
-    bool shouldMoveLeft() override { 
-        return timingManager_.shouldTriggerHorizontal(isKeyActive(SDL_SCANCODE_LEFT), true); 
-    }
-    
-    bool shouldMoveRight() override { 
-        return timingManager_.shouldTriggerHorizontal(isKeyActive(SDL_SCANCODE_RIGHT), false); 
-    }
-    
-    bool shouldSoftDrop() override { 
-        // Soft drop with repeat (uniform with joystick)
-        return timingManager_.shouldTriggerVertical(isKeyActive(SDL_SCANCODE_DOWN)); 
-    }
-    
-    // Single-press actions
-    bool shouldHardDrop() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_SPACE), hardDropTimer_); 
-    }
-    
-    bool shouldRotateCCW() override { 
-        bool isActive = isKeyActive(SDL_SCANCODE_Z) || isKeyActive(SDL_SCANCODE_UP);
-        return timingManager_.shouldTriggerOnce(isActive, rotateCCWTimer_); 
-    }
-    
-    bool shouldRotateCW() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_X), rotateCWTimer_); 
-    }
+    // Movement with DAS/ARR driven by key event timestamps (see handleKeyEvent)
+    bool shouldMoveLeft() override { return moveLeftSteps() > 0; }
+    bool shouldMoveRight() override { return moveRightSteps() > 0; }
+    bool shouldSoftDrop() override { return softDropSteps() > 0; }
     
-    bool shouldPause() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_P), pauseTimer_); 
+    int moveLeftSteps() override { 
+        return timingManager_.consumeSteps(InputTimingManager::Direction::LEFT, now()); 
     }
     
-    bool shouldRestart() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_RETURN), restartTimer_); 
+    int moveRightSteps() override { 
+        return timingManager_.consumeSteps(InputTimingManager::Direction::RIGHT, now()); 
     }
     
-    bool shouldForceRestart() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_R), forceRestartTimer_); 
+    int softDropSteps() override { 
+        return timingManager_.consumeSteps(InputTimingManager::Direction::DOWN, now()); 
     }
     
-    bool shouldQuit() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_ESCAPE), quitTimer_); 
-    }
-    
-    bool shouldScreenshot() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_F12), screenshotTimer_); 
-    }
-    
-    bool shouldToggleDebug() { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_D), debugTimer_); 
-    }
-    
-    bool shouldToggleTimer() override { 
-        return timingManager_.shouldTriggerOnce(isKeyActive(SDL_SCANCODE_T), timerToggleTimer_); 
-    }
+    // Single-press actions
+    bool shouldHardDrop() override { return takePressed(KeyAction::HARD_DROP); }
+    bool shouldRotateCCW() override { return takePressed(KeyAction::ROTATE_CCW); }
+    bool shouldRotateCW() override { return takePressed(KeyAction::ROTATE_CW); }
+    bool shouldPause() override { return takePressed(KeyAction::PAUSE); }
+    bool shouldRestart() override { return takePressed(KeyAction::RESTART); }
+    bool shouldForceRestart() override { return takePressed(KeyAction::FORCE_RESTART); }
+    bool shouldQuit() override { return takePressed(KeyAction::QUIT); }
+    bool shouldScreenshot() override { return takePressed(KeyAction::SCREENSHOT); }
+    bool shouldToggleDebug() override { return takePressed(KeyAction::DEBUG); }
+    bool shouldToggleTimer() override { return takePressed(KeyAction::TIMER); }
+    bool shouldCycleTheme() override { return takePressed(KeyAction::THEME); }
+    bool shouldRewind() override { return takePressed(KeyAction::REWIND); }
+    bool shouldDumpTrace() override { return takePressed(KeyAction::TRACE); }
 
     // Handle SDL events to get clean key press/release (no OS auto-repeat)
     void handleKeyEvent(const SDL_KeyboardEvent& event);
     
-    void update() override {
-        // Update is now handled by SDL events, not polling
-    }
+    /// Latches the presses seen since the previous update (events arrive first)
+    void update() override { pressed_ = pendingPressed_; pendingPressed_ = 0; }
+    
+    /// DAS/ARR contados até este instante em vez de agora (amostras com timestamp do INPUT_THREAD)
+    void setStepTime(Uint32 ticks) { stepTime_ = ticks; }
     
     bool isConnected() override { return true; }
     
-    void resetTimers() override { 
-        timingManager_.resetAllTimers(); 
-    }
+    void resetTimers() override;
+    
+    /// Troca as teclas (KEY_* do .cfg); o que estava seguro é solto
+    void setKeyMap(const KeyMap& keyMap);
+    const KeyMap& getKeyMap() const { return keyMap_; }
     
     // Access to timing manager for configuration
     InputTimingManager& getTimingManager() { return timingManager_; }
     const InputTimingManager& getTimingManager() const { return timingManager_; }
 };
 
-
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "IInputManager.hpp"
+#include "SyntheticInput.hpp"
+#include "app/Replay.hpp"
+#include "pieces/PieceRng.hpp"
+
+class GameState;
+
+/**
+ * @brief Recebe o stream do ReplayRecorder ao vivo (espectador)
+ *
+ * Chamado na thread da lógica, na ordem: onActions() do tick em andamento,
+ * onRoundStart() quando uma partida nova vai começar no próximo tick,
+ * onTick() no início de cada tick (o anterior está completo).
+ */
+class ReplayObserver {
+public:
+    virtual ~ReplayObserver() = default;
+    virtual void onRoundStart(uint32_t seed) = 0;
+    virtual void onActions(const ReplayEvent& event) = 0;
+    virtual void onTick() = 0;
+};
+
+/**
+ * @brief Grava as ações resolvidas do input real, uma partida por arquivo
+ *
+ * Decorator de IInputManager: repassa tudo ao input vivo e anota o que a
+ * lógica consultou em cada tick. A lógica pergunta sempre na mesma ordem, então
+ * devolver as mesmas respostas na reprodução reproduz a partida. beginRound()
+ * sorteia e aplica a semente ao RNG das peças; deve vir logo antes de
+ * GameState::restartRound(). Restarts pedidos pelo jogador fazem isso sozinhos.
+ */
+class ReplayRecorder : public IInputManager {
+public:
+    ReplayRecorder(IInputManager& live, const GameState& state, PieceRng& rng,
+                   const std::string& dir, uint16_t stepMs);
+
+    void beginRound();
+    /// Grava o arquivo da partida em andamento (se houver)
+    void finishRound();
+    bool isRecording() const { return active_; }
+    /// false: as próximas partidas não viram arquivo (demo do attract mode)
+    void setEnabled(bool on) { enabled_ = on; }
+    /// Recebe cada semente/tick mesmo com a gravação desligada
+    void setObserver(ReplayObserver* observer) { observer_ = observer; }
+
+    void update() override;
+    void resetTimers() override { live_.resetTimers(); }
+
+    bool shouldMoveLeft() override { return flag(live_.shouldMoveLeft(), SyntheticInput::MOVE_LEFT); }
+    bool shouldMoveRight() override { return flag(live_.shouldMoveRight(), SyntheticInput::MOVE_RIGHT); }
+    bool shouldSoftDrop() override { return flag(live_.shouldSoftDrop(), SyntheticInput::SOFT_DROP); }
+    bool shouldHardDrop() override { return flag(live_.shouldHardDrop(), SyntheticInput::HARD_DROP); }
+    bool shouldRotateCCW() override { return flag(live_.shouldRotateCCW(), SyntheticInput::ROTATE_CCW); }
+    bool shouldRotateCW() override { return flag(live_.shouldRotateCW(), SyntheticInput::ROTATE_CW); }
+    bool shouldPause() override { return flag(live_.shouldPause(), SyntheticInput::PAUSE); }
+    bool shouldRestart() override;
+    bool shouldForceRestart() override;
+    bool shouldQuit() override;
+    bool shouldScreenshot() override { return live_.shouldScreenshot(); }
+    bool shouldToggleDebug() override { return live_.shouldToggleDebug(); }
+    bool shouldToggleTimer() override { return live_.shouldToggleTimer(); }
+
+    int moveLeftSteps() override { return steps(live_.moveLeftSteps(), SyntheticInput::MOVE_LEFT, 0); }
+    int moveRightSteps() override { return steps(live_.moveRightSteps(), SyntheticInput::MOVE_RIGHT, 1); }
+    int softDropSteps() override { return steps(live_.softDropSteps(), SyntheticInput::SOFT_DROP, 2); }
+    uint64_t takeInputStamp() override { return live_.takeInputStamp(); }
+
+private:
+    bool flag(bool v, uint16_t bit) { if (v) pending_.actions |= bit; return v; }
+    int steps(int n, uint16_t bit, int slot);
+    void commitPending();
+
+    IInputManager& live_;
+    const GameState& state_;
+    PieceRng& rng_;
+    std::string dir_;
+    uint16_t stepMs_;
+
+    bool enabled_ = true;
+    bool active_ = false;
+    ReplayObserver* observer_ = nullptr;
+    int64_t tick_ = -1;            // Tick cujas consultas estão sendo anotadas
+    ReplayEvent pending_;
+    ReplayData data_;
+};
+
+/**
+ * @brief Devolve à lógica as ações de um replay no lugar do input vivo
+ *
+ * Quit/screenshot/debug/timer continuam vindo do input vivo (se houver).
+ * Com state, cada checkpoint do arquivo é conferido contra o
+ * Zobrist::stateHash na hora (O(1)), e ao fim do stream a partida é pausada
+ * (se não acabou) e o resultado é comparado com o gravado no log.
+ */
+class ReplayPlayer : public IInputManager {
+public:
+    ReplayPlayer(const ReplayData& data, IInputManager* live = nullptr, const GameState* state = nullptr);
+
+    /// Todos os ticks gravados já foram entregues
+    bool done() const { return tick_ + 1 >= (int64_t)data_.endTick; }
+    uint32_t ticksPlayed() const { return (uint32_t)(tick_ + 1); }
+    const ReplayData& data() const { return data_; }
+    uint32_t checkpointsChecked() const { return checked_; }
+    /// Tick do primeiro checkpoint que não bateu; -1 = todos bateram até aqui
+    int64_t divergedTick() const { return divergedTick_; }
+
+    void update() override;
+    void resetTimers() override { if (live_) live_->resetTimers(); }
+
+    bool shouldMoveLeft() override { return current_.actions & SyntheticInput::MOVE_LEFT; }
+    bool shouldMoveRight() override { return current_.actions & SyntheticInput::MOVE_RIGHT; }
+    bool shouldSoftDrop() override { return current_.actions & SyntheticInput::SOFT_DROP; }
+    bool shouldHardDrop() override { return current_.actions & SyntheticInput::HARD_DROP; }
+    bool shouldRotateCCW() override { return current_.actions & SyntheticInput::ROTATE_CCW; }
+    bool shouldRotateCW() override { return current_.actions & SyntheticInput::ROTATE_CW; }
+    bool shouldPause() override { return current_.actions & SyntheticInput::PAUSE; }
+    bool shouldRestart() override { return false; }
+    bool shouldForceRestart() override { return false; }
+    bool shouldQuit() override { return live_ && live_->shouldQuit(); }
+    bool shouldScreenshot() override { return live_ && live_->shouldScreenshot(); }
+    bool shouldToggleDebug() override { return live_ && live_->shouldToggleDebug(); }
+    bool shouldToggleTimer() override { return live_ && live_->shouldToggleTimer(); }
+
+    int moveLeftSteps() override { return (current_.actions & SyntheticInput::MOVE_LEFT) ? current_.steps[0] : 0; }
+    int moveRightSteps() override { return (current_.actions & SyntheticInput::MOVE_RIGHT) ? current_.steps[1] : 0; }
+    int softDropSteps() override { return (current_.actions & SyntheticInput::SOFT_DROP) ? current_.steps[2] : 0; }
+
+private:
+    ReplayData data_;
+    IInputManager* live_;
+    const GameState* state_;
+    int64_t tick_ = -1;
+    size_t next_ = 0;
+    ReplayEvent current_;
+    bool finished_ = false;
+    uint32_t checked_ = 0;
+    int64_t divergedTick_ = -1;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "IInputManager.hpp"
+#include "KeyboardInput.hpp"
+
+/**
+ * @brief Input de um assento do split-screen (jogadores 2..4)
+ *
+ * Um KeyboardInput próprio com o mapa do assento (KeyMap::setSeatDefaults).
+ * Não bombeia eventos: o InputManager do jogador 1 repassa cada evento de
+ * tecla (addSeatKeyboard) e update() aqui só trava as bordas, então o
+ * GameState do assento precisa atualizar depois do jogador 1 no mesmo frame.
+ */
+class SeatInput : public IInputManager {
+public:
+    explicit SeatInput(int seat) {
+        KeyMap map;
+        map.setSeatDefaults(seat);
+        keyboard_.setKeyMap(map);
+    }
+
+    KeyboardInput& keyboard() { return keyboard_; }
+
+    void update() override { keyboard_.update(); }
+    void resetTimers() override { keyboard_.resetTimers(); }
+
+    bool shouldMoveLeft() override { return keyboard_.shouldMoveLeft(); }
+    bool shouldMoveRight() override { return keyboard_.shouldMoveRight(); }
+    bool shouldSoftDrop() override { return keyboard_.shouldSoftDrop(); }
+    bool shouldHardDrop() override { return keyboard_.shouldHardDrop(); }
+    bool shouldRotateCCW() override { return keyboard_.shouldRotateCCW(); }
+    bool shouldRotateCW() override { return keyboard_.shouldRotateCW(); }
+    bool shouldPause() override { return keyboard_.shouldPause(); }
+    bool shouldRestart() override { return keyboard_.shouldRestart(); }
+    bool shouldForceRestart() override { return keyboard_.shouldForceRestart(); }
+    bool shouldQuit() override { return keyboard_.shouldQuit(); }
+    bool shouldScreenshot() override { return keyboard_.shouldScreenshot(); }
+    bool shouldToggleDebug() override { return keyboard_.shouldToggleDebug(); }
+    bool shouldToggleTimer() override { return keyboard_.shouldToggleTimer(); }
+    int moveLeftSteps() override { return keyboard_.moveLeftSteps(); }
+    int moveRightSteps() override { return keyboard_.moveRightSteps(); }
+    int softDropSteps() override { return keyboard_.softDropSteps(); }
+
+private:
+    KeyboardInput keyboard_;
+};
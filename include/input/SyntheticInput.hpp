@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include "IInputManager.hpp"
+
+/**
+ * @brief Fonte de input programática (simulação headless, bot, replay)
+ *
+ * As ações ficam ativas por exatamente um update(): setActions() define o
+ * conjunto do próximo tick e update() o consome.
+ */
+class SyntheticInput : public IInputManager {
+public:
+    enum Action : uint16_t {
+        MOVE_LEFT     = 1 << 0,
+        MOVE_RIGHT    = 1 << 1,
+        SOFT_DROP     = 1 << 2,
+        HARD_DROP     = 1 << 3,
+        ROTATE_CCW    = 1 << 4,
+        ROTATE_CW     = 1 << 5,
+        PAUSE         = 1 << 6,
+        RESTART       = 1 << 7,
+        FORCE_RESTART = 1 << 8,
+        QUIT          = 1 << 9
+    };
+
+    void setActions(uint16_t actions) { pending_ = actions; }
+    uint16_t getActions() const { return current_; }
+
+    void update() override { current_ = pending_; pending_ = 0; }
+    void resetTimers() override {}
+
+    bool shouldMoveLeft() override { return current_ & MOVE_LEFT; }
+    bool shouldMoveRight() override { return current_ & MOVE_RIGHT; }
+    bool shouldSoftDrop() override { return current_ & SOFT_DROP; }
+    bool shouldHardDrop() override { return current_ & HARD_DROP; }
+    bool shouldRotateCCW() override { return current_ & ROTATE_CCW; }
+    bool shouldRotateCW() override { return current_ & ROTATE_CW; }
+    bool shouldPause() override { return current_ & PAUSE; }
+    bool shouldRestart() override { return current_ & RESTART; }
+    bool shouldForceRestart() override { return current_ & FORCE_RESTART; }
+    bool shouldQuit() override { return current_ & QUIT; }
+    bool shouldScreenshot() override { return false; }
+    bool shouldToggleDebug() override { return false; }
+    bool shouldToggleTimer() override { return false; }
+
+private:
+    uint16_t pending_ = 0;
+    uint16_t current_ = 0;
+};
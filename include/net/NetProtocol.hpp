@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Um item do stream de uma partida em rede, na ordem dos ticks
+ *
+ * O estado nunca trafega: cada lado manda as ações resolvidas por tick (as
+ * mesmas do replay) e os eventos que mudam o tabuleiro por fora do input; o
+ * outro lado roda uma cópia no núcleo determinístico e confere o CHECKSUM.
+ */
+struct NetEvent {
+    enum Type : uint8_t {
+        ACTIONS = 1,   ///< actions/steps do tick (só ticks com ação)
+        ROUND,         ///< partida nova neste tick; value = semente do sorteio
+        ATTACK,        ///< linhas de lixo mandadas ao outro lado; value = linhas
+        GARBAGE,       ///< lixo aplicado antes deste tick; value = linhas | buraco << 8
+        CHECKSUM,      ///< hash do estado depois deste tick; value = Zobrist::stateHash (64 bits)
+        START          ///< espectador: partida nova antes deste tick (como um replay); value = semente
+    };
+
+    uint8_t type = ACTIONS;
+    uint32_t tick = 0;
+    uint16_t actions = 0;
+    uint8_t steps[3] = {1, 1, 1};
+    uint64_t value = 0;
+};
+
+/**
+ * @brief Datagramas do netplay (little endian, varints como no .dbr)
+ *
+ * Cabeçalho: "DBN", versão (u8), tipo (u8).
+ * - HELLO: configHash (u64), nonce (varint), stepMs (varint), seen (u8).
+ *   Repetido até o outro lado responder com seen=1.
+ * - DATA: ack (varint: próximo seq esperado do outro lado), horizon (varint:
+ *   ticks < horizon estão completos no stream até o último evento do pacote),
+ *   firstSeq (varint), count (varint) e os eventos: tipo (u8), delta de tick
+ *   (varint), payload. Todo DATA repete os eventos ainda sem ack (redundância
+ *   no lugar de retransmissão com timer).
+ * - BYE: o outro lado saiu.
+ *
+ * Sobre TCP (espectador) os mesmos datagramas vão em frames: tamanho (u16)
+ * e o datagrama.
+ */
+namespace NetProtocol {
+
+constexpr uint8_t VERSION = 2;   // 2: CHECKSUM de 64 bits (Zobrist)
+constexpr size_t MAX_DATAGRAM = 1200;   // cabe no MTU de qualquer LAN/VPN sem fragmentar
+
+enum Kind : uint8_t { HELLO = 1, DATA = 2, BYE = 3 };
+
+struct Hello {
+    uint64_t configHash = 0;
+    uint32_t nonce = 0;      // distingue uma sessão nova do mesmo par
+    uint16_t stepMs = 0;
+    bool seen = false;       // resposta: quem manda já recebeu o HELLO do outro (não responder)
+};
+
+struct Data {
+    uint32_t ack = 0;
+    uint32_t horizon = 0;
+    uint32_t firstSeq = 0;
+    std::vector<NetEvent> events;
+};
+
+std::vector<uint8_t> encodeHello(const Hello& hello);
+std::vector<uint8_t> encodeBye();
+
+/**
+ * @brief Monta um DATA com o máximo de eventos que couber em MAX_DATAGRAM
+ *
+ * @param count Eventos de events[0..count) candidatos (em ordem de seq/tick)
+ * @param included Quantos entraram; se faltou espaço, horizon cai para o tick
+ *                 do primeiro que ficou de fora
+ */
+std::vector<uint8_t> encodeData(uint32_t ack, uint32_t horizon, uint32_t firstSeq,
+                                const NetEvent* events, size_t count, size_t& included);
+/// Igual, direto em out[0..capacity) (buffers de pool, sem alocar); devolve o tamanho (0 = não coube)
+size_t encodeDataTo(uint8_t* out, size_t capacity, uint32_t ack, uint32_t horizon, uint32_t firstSeq,
+                    const NetEvent* events, size_t count, size_t& included);
+
+/// Tipo do datagrama, ou 0 se não for deste protocolo/versão
+uint8_t peekKind(const uint8_t* bytes, size_t size);
+bool decodeHello(const uint8_t* bytes, size_t size, Hello& out);
+bool decodeData(const uint8_t* bytes, size_t size, Data& out);
+
+/// "host:porta", "[v6]:porta" ou só "host" (porta = defaultPort)
+bool splitAddress(const std::string& address, int defaultPort, std::string& host, int& port);
+
+} // namespace NetProtocol
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "audio/SpscRing.hpp"
+#include "net/NetProtocol.hpp"
+#include "util/UdpSocket.hpp"
+
+/**
+ * @brief Conexão de netplay com um par (NET_PEER), numa thread própria
+ *
+ * Toda E/S de socket fica na thread da rede: o jogo só faz push()/pop() em
+ * filas SPSC e lê atômicos, então jitter ou perda de pacote nunca chegam ao
+ * loop de render. A thread manda HELLO até ouvir o par, depois um DATA a
+ * cada SEND_INTERVAL_MS (ou assim que houver eventos novos) repetindo tudo
+ * que o par ainda não confirmou; eventos recebidos entram em ordem de seq,
+ * sem buracos, e só são confirmados quando couberam na fila de entrada.
+ */
+class NetSession {
+public:
+    static constexpr Uint32 SEND_INTERVAL_MS = 8;
+    static constexpr Uint32 HELLO_INTERVAL_MS = 100;
+    static constexpr Uint32 TIMEOUT_MS = 5000;
+
+    enum class Status { IDLE, WAITING, CONNECTED, INCOMPATIBLE, LOST, CLOSED };
+
+    NetSession() = default;
+    ~NetSession() { stop(); }
+    NetSession(const NetSession&) = delete;
+    NetSession& operator=(const NetSession&) = delete;
+
+    /// "host:porta" do par, porta UDP local; configHash/stepMs precisam bater dos dois lados
+    bool start(const std::string& peer, int localPort, uint64_t configHash, uint16_t stepMs);
+    /// Manda BYE e espera a thread
+    void stop();
+
+    Status status() const { return (Status)status_.load(std::memory_order_acquire); }
+    bool connected() const { return status() == Status::CONNECTED; }
+    static const char* statusName(Status s);
+
+    // --- Lado do jogo (uma thread só) ---
+    /// Evento local (ordem de tick); o que não couber na fila espera o próximo flush()
+    void send(const NetEvent& event);
+    /// Ticks locais < horizon estão completos (chamar depois dos send() deles)
+    void setLocalHorizon(uint32_t horizon);
+    /// Próximo evento do par, ou false
+    bool receive(NetEvent& out);
+    /// Ticks do par < horizon já chegaram inteiros (ler antes de drenar receive())
+    uint32_t remoteHorizon() const { return remoteHorizon_.load(std::memory_order_acquire); }
+
+    /// Round trip suavizado (ms), pelo tempo até o ack cobrir um seq
+    double rttMs() const { return rttUs_.load(std::memory_order_relaxed) / 1000.0; }
+    uint32_t packetsSent() const { return packetsSent_.load(std::memory_order_relaxed); }
+    uint32_t packetsReceived() const { return packetsReceived_.load(std::memory_order_relaxed); }
+
+private:
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    void handleDatagram(const uint8_t* bytes, size_t size, Uint32 now);
+    void sendData(Uint32 now);
+    void flushBacklog();
+
+    struct Sent {
+        NetEvent event;
+        Uint32 firstSentMs = 0;
+    };
+
+    UdpSocket socket_;
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+    std::atomic<int> status_{(int)Status::IDLE};
+
+    // Jogo -> rede e rede -> jogo
+    SpscRing<NetEvent, 4096> outbound_;
+    SpscRing<NetEvent, 4096> inbound_;
+    std::vector<NetEvent> backlog_;              // Só a thread do jogo: fila de saída cheia
+    std::atomic<uint32_t> localHorizon_{0};
+    std::atomic<uint32_t> remoteHorizon_{0};
+
+    // Só a thread da rede
+    NetProtocol::Hello hello_;
+    uint32_t peerNonce_ = 0;
+    bool peerSeen_ = false;
+    std::deque<Sent> unacked_;                   // seq = ackedSeq_ + índice
+    uint32_t ackedSeq_ = 0;                      // Primeiro seq ainda sem ack do par
+    uint32_t nextSeq_ = 0;                       // Próximo seq local
+    uint32_t expectedSeq_ = 0;                   // Próximo seq do par que entra na fila
+    uint32_t sentHorizon_ = 0;
+    Uint32 lastSendMs_ = 0, lastHelloMs_ = 0, lastHeardMs_ = 0;
+
+    std::atomic<uint32_t> rttUs_{0};
+    std::atomic<uint32_t> packetsSent_{0};
+    std::atomic<uint32_t> packetsReceived_{0};
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include "input/IInputManager.hpp"
+#include "input/SyntheticInput.hpp"
+#include "net/NetProtocol.hpp"
+#include "pieces/PieceRng.hpp"
+
+class GameState;
+class NetSession;
+
+/**
+ * @brief Input do jogador local numa partida em rede
+ *
+ * Decorator como o ReplayRecorder: repassa o input vivo e anota as respostas
+ * de cada tick; flush() manda o tick para o par. O tick 0 e todo restart
+ * (R/ENTER) sorteiam uma semente, semeiam o RNG local e viram um ROUND no
+ * stream, sempre pela consulta shouldForceRestart() para o espelho reiniciar
+ * no mesmo ponto do mesmo tick.
+ */
+class NetLocalInput : public IInputManager {
+public:
+    NetLocalInput(IInputManager& live, PieceRng& rng, NetSession& session) : live_(live), rng_(rng), session_(session) {}
+
+    /// Tick do último update() (-1 antes do primeiro)
+    int64_t tick() const { return tick_; }
+    /// Manda o ACTIONS do tick atual (chamar depois do passo)
+    void flush();
+    /// Uma partida nova começou desde a última chamada
+    bool takeRoundStart() { bool r = roundStarted_; roundStarted_ = false; return r; }
+
+    void update() override;
+    void resetTimers() override { live_.resetTimers(); }
+
+    bool shouldMoveLeft() override { return flag(live_.shouldMoveLeft(), SyntheticInput::MOVE_LEFT); }
+    bool shouldMoveRight() override { return flag(live_.shouldMoveRight(), SyntheticInput::MOVE_RIGHT); }
+    bool shouldSoftDrop() override { return flag(live_.shouldSoftDrop(), SyntheticInput::SOFT_DROP); }
+    bool shouldHardDrop() override { return flag(live_.shouldHardDrop(), SyntheticInput::HARD_DROP); }
+    bool shouldRotateCCW() override { return flag(live_.shouldRotateCCW(), SyntheticInput::ROTATE_CCW); }
+    bool shouldRotateCW() override { return flag(live_.shouldRotateCW(), SyntheticInput::ROTATE_CW); }
+    bool shouldPause() override { return flag(live_.shouldPause(), SyntheticInput::PAUSE); }
+    bool shouldRestart() override;
+    bool shouldForceRestart() override;
+    bool shouldQuit() override { return live_.shouldQuit(); }
+    bool shouldScreenshot() override { return live_.shouldScreenshot(); }
+    bool shouldToggleDebug() override { return live_.shouldToggleDebug(); }
+    bool shouldToggleTimer() override { return live_.shouldToggleTimer(); }
+
+    int moveLeftSteps() override { return steps(live_.moveLeftSteps(), SyntheticInput::MOVE_LEFT, 0); }
+    int moveRightSteps() override { return steps(live_.moveRightSteps(), SyntheticInput::MOVE_RIGHT, 1); }
+    int softDropSteps() override { return steps(live_.softDropSteps(), SyntheticInput::SOFT_DROP, 2); }
+    uint64_t takeInputStamp() override { return live_.takeInputStamp(); }
+
+private:
+    bool flag(bool v, uint16_t bit) { if (v) pending_.actions |= bit; return v; }
+    int steps(int n, uint16_t bit, int slot);
+    void beginRound();
+
+    IInputManager& live_;
+    PieceRng& rng_;
+    NetSession& session_;
+    int64_t tick_ = -1;
+    NetEvent pending_;
+    bool roundStarted_ = false;
+};
+
+/**
+ * @brief Input do espelho do par: devolve as ações que vieram pela rede
+ *
+ * Quem alimenta é o NetVersus, tick a tick (load()); um ROUND semeia o RNG
+ * do espelho e responde shouldForceRestart() naquele tick.
+ */
+class NetRemoteInput : public IInputManager {
+public:
+    explicit NetRemoteInput(PieceRng& rng) : rng_(rng) {}
+
+    /// Respostas do próximo tick: actions (ou nullptr) e, se round, a semente da partida nova
+    void load(const NetEvent* actions, bool round, uint32_t seed);
+
+    void update() override {}
+    void resetTimers() override {}
+
+    bool shouldMoveLeft() override { return current_.actions & SyntheticInput::MOVE_LEFT; }
+    bool shouldMoveRight() override { return current_.actions & SyntheticInput::MOVE_RIGHT; }
+    bool shouldSoftDrop() override { return current_.actions & SyntheticInput::SOFT_DROP; }
+    bool shouldHardDrop() override { return current_.actions & SyntheticInput::HARD_DROP; }
+    bool shouldRotateCCW() override { return current_.actions & SyntheticInput::ROTATE_CCW; }
+    bool shouldRotateCW() override { return current_.actions & SyntheticInput::ROTATE_CW; }
+    bool shouldPause() override { return current_.actions & SyntheticInput::PAUSE; }
+    bool shouldRestart() override { return false; }
+    bool shouldForceRestart() override;
+    bool shouldQuit() override { return false; }
+    bool shouldScreenshot() override { return false; }
+    bool shouldToggleDebug() override { return false; }
+    bool shouldToggleTimer() override { return false; }
+
+    int moveLeftSteps() override { return (current_.actions & SyntheticInput::MOVE_LEFT) ? current_.steps[0] : 0; }
+    int moveRightSteps() override { return (current_.actions & SyntheticInput::MOVE_RIGHT) ? current_.steps[1] : 0; }
+    int softDropSteps() override { return (current_.actions & SyntheticInput::SOFT_DROP) ? current_.steps[2] : 0; }
+
+private:
+    PieceRng& rng_;
+    NetEvent current_;
+    bool round_ = false;
+    uint32_t seed_ = 0;
+};
+
+/**
+ * @brief Regras do versus em rede em volta de dois GameState comuns
+ *
+ * O tabuleiro local roda com NetLocalInput; o do par é um espelho
+ * determinístico rodando o stream dele (ações, ROUND, GARBAGE) só até o
+ * horizonte que já chegou inteiro, então nunca adivinha nem volta atrás.
+ * Linhas limpas viram ATTACK (tabela 0/1/2/4, cancelando primeiro o lixo
+ * pendente); o lixo recebido entra no tabuleiro local no início do tick
+ * seguinte a um lock (no máximo GARBAGE_PER_LOCK linhas) e vai para o stream
+ * como GARBAGE, o que mantém o espelho do outro lado exato. CHECKSUM a cada
+ * checksumTicks detecta divergência (contada e logada, não corrigida).
+ *
+ * Tudo na thread do jogo; a rede é só a NetSession.
+ */
+class NetVersus {
+public:
+    static constexpr int GARBAGE_PER_LOCK = 8;
+
+    NetVersus(NetSession& session, GameState& local, IInputManager& live, PieceRng& localRng,
+              GameState& mirror, PieceRng& mirrorRng);
+
+    /// Liga os inputs nos dois GameState (antes do primeiro passo)
+    void install();
+    void setChecksumTicks(int ticks) { checksumTicks_ = ticks; }
+    void setGarbageEnabled(bool on) { garbage_ = on; }
+
+    /// Drena a NetSession: ataques recebidos e o stream do espelho
+    void poll();
+
+    // Passo local: beforeLocalStep(), db_update(local), afterLocalStep()
+    void beforeLocalStep();
+    void afterLocalStep();
+
+    /// O espelho pode rodar o próximo tick (já chegou inteiro)
+    bool mirrorReady() const { return mirrorTick_ < remoteHorizon_; }
+    // Passo do espelho: beforeMirrorStep(), db_update(mirror), afterMirrorStep()
+    void beforeMirrorStep();
+    void afterMirrorStep();
+
+    uint32_t localTick() const { return (uint32_t)(localInput_.tick() + 1); }
+    uint32_t mirrorTick() const { return mirrorTick_; }
+    /// Ticks que o espelho está atrás do último horizonte recebido
+    uint32_t mirrorLag() const { return remoteHorizon_ - mirrorTick_; }
+    int pendingGarbage() const { return pendingGarbage_; }
+    uint32_t desyncs() const { return desyncs_; }
+    uint32_t checksumsMatched() const { return matched_; }
+
+private:
+    NetSession& session_;
+    GameState& local_;
+    GameState& mirror_;
+    NetLocalInput localInput_;
+    NetRemoteInput remoteInput_;
+    const PieceRng& localRng_;       // Semente da rodada entra no CHECKSUM
+    const PieceRng& mirrorRng_;
+
+    int checksumTicks_ = 250;
+    bool garbage_ = true;
+
+    int pendingGarbage_ = 0;
+    int prevLines_ = 0;
+    uint32_t lockVersion_ = 0;       // getVersion() depois do último lixo aplicado
+
+    std::deque<NetEvent> stream_;    // Eventos do par para o espelho, em ordem de tick
+    uint32_t remoteHorizon_ = 0;
+    uint32_t mirrorTick_ = 0;
+    uint32_t desyncs_ = 0;
+    uint32_t matched_ = 0;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "audio/SpscRing.hpp"
+#include "input/IInputManager.hpp"
+#include "input/SyntheticInput.hpp"
+#include "net/NetProtocol.hpp"
+#include "pieces/PieceRng.hpp"
+#include "util/TcpSocket.hpp"
+
+class GameState;
+
+/**
+ * @brief Conexão do telão com um SpectatorPublisher (SPECTATE_SOURCE)
+ *
+ * Thread própria: conecta (e reconecta a cada RETRY_MS se cair), separa os
+ * frames e entrega os eventos por uma fila SPSC, com o horizonte (ticks
+ * completos) num atômico publicado depois dos eventos.
+ */
+class SpectatorClient {
+public:
+    static constexpr Uint32 RETRY_MS = 2000;
+
+    SpectatorClient() = default;
+    ~SpectatorClient() { stop(); }
+    SpectatorClient(const SpectatorClient&) = delete;
+    SpectatorClient& operator=(const SpectatorClient&) = delete;
+
+    /// "host:porta" do gabinete; configHash/stepMs são conferidos com o HELLO dele
+    bool start(const std::string& source, uint64_t configHash, uint16_t stepMs);
+    void stop();
+
+    bool connected() const { return connected_.load(std::memory_order_acquire); }
+    bool incompatible() const { return incompatible_.load(std::memory_order_acquire); }
+    uint32_t bytesReceived() const { return bytesReceived_.load(std::memory_order_relaxed); }
+
+    // Thread do jogo
+    uint32_t horizon() const { return horizon_.load(std::memory_order_acquire); }
+    bool receive(NetEvent& out);
+
+private:
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    bool parse();            // false = stream inválido
+    void deliver();          // backlog_ -> ring_
+
+    std::string host_;
+    int port_ = 0;
+    uint64_t configHash_ = 0;
+    uint16_t stepMs_ = 0;
+
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+    std::atomic<bool> connected_{false};
+    std::atomic<bool> incompatible_{false};
+
+    // Só a thread da rede
+    TcpSocket socket_;
+    std::vector<uint8_t> rx_;
+    bool helloSeen_ = false;
+    std::vector<NetEvent> backlog_;    // Fila cheia (alcançando uma partida longa)
+    uint32_t pendingHorizon_ = 0;
+    NetProtocol::Data data_;
+
+    SpscRing<NetEvent, 8192> ring_;
+    std::atomic<uint32_t> horizon_{0};
+    std::atomic<uint32_t> bytesReceived_{0};
+};
+
+/**
+ * @brief Input do telão: a partida do gabinete, tick a tick
+ *
+ * Como o ReplayPlayer, mas o stream chega pela rede: plan() diz quantos
+ * passos rodar neste frame (com BUFFER de folga contra jitter e corrida para
+ * alcançar quando conectou no meio), beforeStep()/afterStep() cercam cada
+ * db_update(). START semeia o RNG e reinicia o tabuleiro antes do tick, como
+ * o início de um replay. Quit/screenshot/debug/timer seguem no input vivo.
+ */
+class SpectatorInput : public IInputManager {
+public:
+    static constexpr int MAX_CATCHUP_STEPS = 4000;   // Por frame, alcançando
+
+    SpectatorInput(SpectatorClient& client, IInputManager& live, PieceRng& rng, uint32_t bufferTicks)
+        : client_(client), live_(live), rng_(rng), bufferTicks_(bufferTicks) {}
+
+    /// Passos para este frame (o scheduler pediu steps)
+    int plan(int steps);
+    void beforeStep(GameState& state);
+    void afterStep(const GameState& state);
+
+    uint32_t lagTicks() const { return horizon_ > tick_ ? horizon_ - tick_ : 0; }
+    bool watching() const { return started_; }
+    uint32_t desyncs() const { return desyncs_; }
+
+    void update() override { live_.update(); }
+    void resetTimers() override { live_.resetTimers(); }
+
+    bool shouldMoveLeft() override { return current_.actions & SyntheticInput::MOVE_LEFT; }
+    bool shouldMoveRight() override { return current_.actions & SyntheticInput::MOVE_RIGHT; }
+    bool shouldSoftDrop() override { return current_.actions & SyntheticInput::SOFT_DROP; }
+    bool shouldHardDrop() override { return current_.actions & SyntheticInput::HARD_DROP; }
+    bool shouldRotateCCW() override { return current_.actions & SyntheticInput::ROTATE_CCW; }
+    bool shouldRotateCW() override { return current_.actions & SyntheticInput::ROTATE_CW; }
+    bool shouldPause() override { return current_.actions & SyntheticInput::PAUSE; }
+    bool shouldRestart() override { return false; }
+    bool shouldForceRestart() override { return false; }
+    bool shouldQuit() override { return live_.shouldQuit(); }
+    bool shouldScreenshot() override { return live_.shouldScreenshot(); }
+    bool shouldToggleDebug() override { return live_.shouldToggleDebug(); }
+    bool shouldToggleTimer() override { return live_.shouldToggleTimer(); }
+
+    int moveLeftSteps() override { return (current_.actions & SyntheticInput::MOVE_LEFT) ? current_.steps[0] : 0; }
+    int moveRightSteps() override { return (current_.actions & SyntheticInput::MOVE_RIGHT) ? current_.steps[1] : 0; }
+    int softDropSteps() override { return (current_.actions & SyntheticInput::SOFT_DROP) ? current_.steps[2] : 0; }
+
+private:
+    void poll();
+
+    SpectatorClient& client_;
+    IInputManager& live_;
+    PieceRng& rng_;
+    uint32_t bufferTicks_;
+
+    std::deque<NetEvent> stream_;
+    uint32_t horizon_ = 0;
+    uint32_t tick_ = 0;          // Próximo tick do stream a rodar
+    bool started_ = false;       // Já houve um START
+    bool buffering_ = true;
+    NetEvent current_;
+    uint32_t desyncs_ = 0;
+};
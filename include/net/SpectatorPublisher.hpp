@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "audio/SpscRing.hpp"
+#include "input/ReplayInput.hpp"
+#include "net/NetProtocol.hpp"
+#include "util/TcpSocket.hpp"
+
+class GameState;
+
+/**
+ * @brief Publica a partida para telões (SPECTATE_PORT), por TCP
+ *
+ * Observer do ReplayRecorder: o stream é o do replay (semente por partida e
+ * ações resolvidas por tick, mais um CHECKSUM de vez em quando), então um
+ * espectador reconstrói tudo rodando o mesmo núcleo - dá algumas centenas de
+ * bytes por segundo. A lógica só faz push() numa fila SPSC; a thread da rede
+ * aceita conexões, manda a partida em andamento desde o START para quem chega
+ * e, a cada FLUSH_MS, codifica um frame uma vez só num bloco de um pool
+ * pré-alocado que todos os espectadores enviam direto dali. Quem não
+ * acompanha (fila longa demais ou pool sem bloco livre) é desconectado; nada
+ * disso chega na lógica.
+ */
+class SpectatorPublisher : public ReplayObserver {
+public:
+    static constexpr Uint32 FLUSH_MS = 100;
+    static constexpr int MAX_SUBSCRIBERS = 8;
+    static constexpr int POOL_BLOCKS = 64;
+    static constexpr size_t MAX_QUEUED_BLOCKS = 24;   // ~2.4 s de atraso antes de derrubar
+
+    SpectatorPublisher(const GameState& state, int checksumTicks) : state_(state), checksumTicks_(checksumTicks) {}
+    ~SpectatorPublisher() override { stop(); }
+    SpectatorPublisher(const SpectatorPublisher&) = delete;
+    SpectatorPublisher& operator=(const SpectatorPublisher&) = delete;
+
+    bool start(int port, uint64_t configHash, uint16_t stepMs);
+    void stop();
+
+    int subscribers() const { return subscribers_.load(std::memory_order_relaxed); }
+    uint32_t bytesSent() const { return bytesSent_.load(std::memory_order_relaxed); }
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // ReplayObserver (thread da lógica)
+    void onRoundStart(uint32_t seed) override;
+    void onActions(const ReplayEvent& event) override;
+    void onTick() override;
+
+private:
+    struct Block {
+        uint8_t data[NetProtocol::MAX_DATAGRAM + 2];   // Frame: tamanho (u16) + datagrama
+        uint16_t size = 0;
+        int refs = 0;
+    };
+    struct Queued {
+        int block;
+        size_t offset;
+    };
+    struct Subscriber {
+        TcpSocket socket;
+        std::vector<uint8_t> catchup;   // HELLO + partida até aqui (uma vez, ao conectar)
+        size_t catchupSent = 0;
+        std::deque<Queued> queue;
+    };
+
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    void push(const NetEvent& event);
+    void accept();
+    void flush(uint32_t horizon);
+    bool pump(Subscriber& sub);
+    void drop(size_t index, const char* reason);
+    int allocBlock();
+    void releaseBlock(int block);
+
+    // Lado da lógica
+    const GameState& state_;
+    int checksumTicks_;
+    uint32_t streamTick_ = 0;       // Ticks começados
+    bool roundPending_ = false;     // START vai no próximo onTick()
+    uint32_t roundSeed_ = 0;
+    bool overflow_ = false;         // Fila cheia: descarta até o próximo START
+
+    // Lógica -> rede
+    SpscRing<NetEvent, 4096> ring_;
+    std::atomic<uint32_t> horizon_{0};
+
+    // Só a thread da rede
+    TcpListener listener_;
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+    NetProtocol::Hello hello_;
+    std::vector<Block> pool_;
+    std::vector<int> freeBlocks_;
+    std::vector<std::unique_ptr<Subscriber>> subs_;
+    std::vector<NetEvent> batch_;   // Drenado e ainda não enviado
+    std::vector<NetEvent> round_;   // Partida em andamento, desde o START (para quem chega)
+    uint32_t flushedHorizon_ = 0;
+    Uint32 lastFlushMs_ = 0;
+
+    std::atomic<int> subscribers_{0};
+    std::atomic<uint32_t> bytesSent_{0};
+    std::atomic<uint32_t> dropped_{0};
+};
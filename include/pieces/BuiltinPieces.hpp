@@ -0,0 +1,163 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include "pieces/Piece.hpp"
+
+struct PieceSet;
+
+/**
+ * @brief O conjunto padrão (7 tetrominós + kicks SRS) compilado no executável
+ *
+ * Células, cores e kicks são tabelas constexpr com o mesmo conteúdo do
+ * default.pieces; as quatro rotações, as RotationMask e as sequências de
+ * kick (o que compilePieceTables faria no load) saem daqui em tempo de
+ * compilação. Com PIECES_FILE vazio o jogo instala este conjunto sem abrir
+ * nem parsear arquivo; .pieces próprios continuam pelo loader.
+ */
+namespace BuiltinPieces {
+
+struct Cell { int8_t x = 0, y = 0; };
+
+constexpr int COUNT = 7;
+constexpr int CELLS = 4;
+constexpr int MAX_KICKS = 6;               ///< I 0->1 e 0->3 têm o (2,0) extra do default.pieces
+constexpr int PREVIEW_GRID = 6;            ///< [SET] PREVIEWGRID do default.pieces
+
+using Shape = std::array<Cell, CELLS>;
+
+struct KickList { std::array<Cell, MAX_KICKS> k{}; int n = 0; };
+using TransKicks = std::array<std::array<KickList, 4>, 2>;   ///< [dirIdx: 0=CW,1=CCW][from]
+
+enum class Kicks { LEGACY_ZERO, JLSTZ, I };   ///< LEGACY_ZERO = KICKS.CW/CCW = (0,0) (peça O)
+
+struct Def {
+    const char* name;
+    Uint8 r, g, b;
+    Shape base;
+    Kicks kicks;
+};
+
+// SRS (Guideline), y para baixo como no resto do jogo
+constexpr TransKicks JLSTZ_KICKS = {{
+    {{ {{{{0,0},{-1,0},{-1,1},{0,-2},{-1,-2}}}, 5},     // 0->1
+       {{{{0,0},{1,0},{1,-1},{0,2},{1,2}}}, 5},         // 1->2
+       {{{{0,0},{1,0},{1,1},{0,-2},{1,-2}}}, 5},        // 2->3
+       {{{{0,0},{-1,0},{-1,-1},{0,2},{-1,2}}}, 5} }},   // 3->0
+    {{ {{{{0,0},{1,0},{1,1},{0,-2},{1,-2}}}, 5},        // 0->3
+       {{{{0,0},{-1,0},{-1,-1},{0,2},{-1,2}}}, 5},      // 1->0
+       {{{{0,0},{-1,0},{-1,1},{0,-2},{-1,-2}}}, 5},     // 2->1
+       {{{{0,0},{1,0},{1,-1},{0,2},{1,2}}}, 5} }},      // 3->2
+}};
+
+constexpr TransKicks I_KICKS = {{
+    {{ {{{{0,0},{-2,0},{1,0},{-2,-1},{1,2},{2,0}}}, 6}, // 0->1
+       {{{{0,0},{-1,0},{2,0},{-1,2},{2,-1}}}, 5},       // 1->2
+       {{{{0,0},{2,0},{-1,0},{2,1},{-1,-2}}}, 5},       // 2->3
+       {{{{0,0},{1,0},{-2,0},{1,-2},{-2,1}}}, 5} }},    // 3->0
+    {{ {{{{0,0},{-1,0},{2,0},{-1,2},{2,-1},{2,0}}}, 6}, // 0->3
+       {{{{0,0},{2,0},{-1,0},{2,1},{-1,-2}}}, 5},       // 1->0
+       {{{{0,0},{1,0},{-2,0},{1,-2},{-2,1}}}, 5},       // 2->1
+       {{{{0,0},{-2,0},{1,0},{-2,-1},{1,2}}}, 5} }},    // 3->2
+}};
+
+// Mesma ordem do default.pieces: o índice da peça entra no RNG e nos replays
+constexpr std::array<Def, COUNT> DEFS = {{
+    {"I", 0x00, 0xFF, 0xFF, {{{-1,0},{0,0},{1,0},{2,0}}}, Kicks::I},
+    {"O", 0xFF, 0xFF, 0x00, {{{0,0},{1,0},{0,1},{1,1}}}, Kicks::LEGACY_ZERO},
+    {"T", 0x80, 0x00, 0x80, {{{0,0},{-1,0},{1,0},{0,1}}}, Kicks::JLSTZ},
+    {"S", 0x00, 0xFF, 0x00, {{{0,0},{1,0},{0,1},{-1,1}}}, Kicks::JLSTZ},
+    {"Z", 0xFF, 0x00, 0x00, {{{0,0},{-1,0},{0,1},{1,1}}}, Kicks::JLSTZ},
+    {"J", 0x00, 0x00, 0xFF, {{{0,0},{-1,0},{1,0},{1,1}}}, Kicks::JLSTZ},
+    {"L", 0xFF, 0xA5, 0x00, {{{0,0},{-1,0},{1,0},{-1,1}}}, Kicks::JLSTZ},
+}};
+
+// ---- Geração em tempo de compilação (espelha o loader e compilePieceTables) ----
+
+/// (x, y) -> (-y, x), o mesmo giro do ROTATIONS = auto
+constexpr Shape rotate90(Shape s) {
+    for (int i = 0; i < CELLS; ++i) {
+        const int8_t x = s[i].x;
+        s[i].x = (int8_t)-s[i].y;
+        s[i].y = x;
+    }
+    return s;
+}
+
+constexpr RotationMask makeMask(const Shape& s) {
+    RotationMask m{};
+    m.minX = m.maxX = s[0].x;
+    m.minY = m.maxY = s[0].y;
+    for (int i = 1; i < CELLS; ++i) {
+        m.minX = s[i].x < m.minX ? s[i].x : m.minX; m.maxX = s[i].x > m.maxX ? s[i].x : m.maxX;
+        m.minY = s[i].y < m.minY ? s[i].y : m.minY; m.maxY = s[i].y > m.maxY ? s[i].y : m.maxY;
+    }
+    for (int i = 0; i < CELLS; ++i) {
+        const uint32_t bit = uint32_t(1) << (s[i].x - m.minX);
+        if (!(m.rows[s[i].y - m.minY] & bit)) { m.rows[s[i].y - m.minY] |= bit; m.cells++; }
+    }
+    m.valid = true;
+    return m;
+}
+
+/// Todas as sequências de uma peça achatadas, como buildKickSequences
+struct KickTable {
+    static constexpr int CAPACITY = 2 * 4 * (MAX_KICKS + (int)WALL_FALLBACK_KICKS.size());
+    std::array<Cell, CAPACITY> cells{};
+    int size = 0;
+    std::array<std::array<KickSeq, 4>, 2> seq{};
+};
+
+constexpr KickTable makeKickTable(Kicks kicks) {
+    KickTable t{};
+    const TransKicks* trans = kicks == Kicks::I ? &I_KICKS : kicks == Kicks::JLSTZ ? &JLSTZ_KICKS : nullptr;
+    for (int dir = 0; dir < 2; ++dir) {
+        for (int from = 0; from < 4; ++from) {
+            KickSeq& seq = t.seq[dir][from];
+            seq.begin = (uint16_t)t.size;
+            auto push = [&t, &seq](int x, int y) {
+                for (int i = seq.begin; i < t.size; ++i) if (t.cells[i].x == x && t.cells[i].y == y) return;
+                t.cells[t.size].x = (int8_t)x;
+                t.cells[t.size].y = (int8_t)y;
+                t.size++;
+            };
+            if (trans) {
+                const KickList& list = (*trans)[dir][from];
+                for (int i = 0; i < list.n; ++i) push(list.k[i].x, list.k[i].y);
+            } else {
+                push(0, 0);
+            }
+            seq.split = (uint16_t)t.size;
+            for (const auto& k : WALL_FALLBACK_KICKS) push(k.first, k.second);
+            seq.end = (uint16_t)t.size;
+        }
+    }
+    return t;
+}
+
+struct Compiled {
+    std::array<Shape, 4> rot{};
+    std::array<RotationMask, 4> masks{};
+    KickTable kicks{};
+};
+
+constexpr Compiled compile(const Def& def) {
+    Compiled c{};
+    c.rot[0] = def.base;
+    for (int r = 1; r < 4; ++r) c.rot[r] = rotate90(c.rot[r - 1]);
+    for (int r = 0; r < 4; ++r) c.masks[r] = makeMask(c.rot[r]);
+    c.kicks = makeKickTable(def.kicks);
+    return c;
+}
+
+constexpr std::array<Compiled, COUNT> compileAll() {
+    std::array<Compiled, COUNT> out{};
+    for (int i = 0; i < COUNT; ++i) out[i] = compile(DEFS[i]);
+    return out;
+}
+
+/** @brief Preenche out com o conjunto embutido (o equivalente a parsear o default.pieces) */
+void build(PieceSet& out);
+
+} // namespace BuiltinPieces
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Estado do sorteio em tamanho fixo (POD), para GameSnapshot
+ *
+ * O mesmo que PieceManager::Snapshot, sem vector nem shared_ptr: cabe num
+ * snapshot copiado por memcpy (rewind, retomada, TripleBuffer). Só entram
+ * geradores com estado de 16 bytes (PCG/xoshiro); com mt19937 o
+ * PieceManager recusa (saveDeal() = false).
+ */
+struct DealState {
+    static constexpr int MAX_BAG = 320;        ///< = GameSnapshot::MAX_PIECE_TYPES
+    static constexpr int MAX_POOL = 2 * MAX_BAG;
+    static constexpr int HISTORY = 4;          ///< = PieceManager::HISTORY_SIZE
+    static constexpr int LOOKAHEAD = 16;       ///< = PieceManager::LOOKAHEAD_MAX
+
+    uint8_t rngType = 0;                       ///< RngType
+    uint64_t rngSeed = 0;
+    uint64_t rngWords[2] = {0, 0};
+
+    uint16_t bagCount = 0, bagPos = 0;
+    uint16_t bag[MAX_BAG];
+    uint16_t poolCount = 0, poolLeft = 0;
+    uint16_t pool[MAX_POOL];
+    int16_t nextIdx = 0;
+    int16_t history[HISTORY] = {};
+    int16_t historyPos = 0;
+    int16_t ahead[LOOKAHEAD] = {};
+    int16_t aheadHead = 0, aheadCount = 0;
+};
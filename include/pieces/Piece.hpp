@@ -1,15 +1,50 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <array>
 #include <utility>
 
+/**
+ * @brief Máscara pré-compilada de uma rotação
+ *
+ * rows[i] tem o bit (x - minX) ligado para cada célula em (x, minY + i).
+ * Gerada no carregamento das peças por buildPieceMasks(); rotações maiores
+ * que MAX_ROWS x 32 ficam com valid=false e usam os vetores de pares.
+ */
+struct RotationMask {
+    static constexpr int MAX_ROWS = 8;
+    std::array<uint32_t, MAX_ROWS> rows{};
+    int minX = 0, maxX = -1, minY = 0, maxY = -1;
+    int cells = 0;
+    bool valid = false;
+
+    int width() const { return maxX - minX + 1; }
+    int height() const { return maxY - minY + 1; }
+};
+
+/**
+ * @brief Faixa de uma sequência de kicks compilada em Piece::kickTable
+ *
+ * [begin, split) são testados antes do ajuste dinâmico de parede (que depende
+ * da posição da peça) e [split, end) depois dele.
+ */
+struct KickSeq {
+    uint16_t begin = 0, split = 0, end = 0;
+};
+
+/** @brief Kicks genéricos testados depois do ajuste de parede, em toda sequência */
+constexpr std::array<std::pair<int,int>, 10> WALL_FALLBACK_KICKS = {{
+    {0,0},{-1,0},{1,0},{0,-1},{-1,-1},{1,-1},{0,-2},{-2,0},{2,0},{0,1}
+}};
+
 struct Piece {
     std::string name;
     std::vector<std::vector<std::pair<int,int>>> rot; // 0..3
     Uint8 r = 200, g = 200, b = 200;
+    Uint16 weight = 1;   // WEIGHT no .pieces: peso relativo no randomizer "weighted" (0 = nunca)
 
     Piece() : name(), rot(4), r(200), g(200), b(200) {}
 
@@ -21,6 +56,18 @@ struct Piece {
     std::vector<std::pair<int,int>> kicksCW;
     std::vector<std::pair<int,int>> kicksCCW;
     bool hasKicks = false;
+
+    // Tabelas compiladas no load (ver compilePieceTables)
+    std::array<RotationMask,4> masks;
+    std::vector<std::pair<int,int>> kickTable;           // todas as sequências, concatenadas
+    std::array<std::array<KickSeq,4>,2> kickSeq;         // [dirIdx: 0=CW,1=CCW][from]
 };
 
+/** @brief (Re)constrói as máscaras/bounding boxes de todas as rotações */
+void buildPieceMasks(Piece& piece);
+/** @brief Achata os estágios de kick de rotateWithKicks numa lista única e sem repetição */
+void buildKickSequences(Piece& piece);
+/** @brief Tudo que é pré-computado no carregamento de uma peça */
+void compilePieceTables(Piece& piece);
+
 
@@ -1,18 +1,59 @@
 #pragma once
 
-#include <random>
+#include <array>
+#include <string>
+#include <vector>
 #include "Interfaces.hpp"
+#include "pieces/DealState.hpp"
+#include "pieces/PieceRng.hpp"
+#include "pieces/Piece.hpp"
 
 /**
  * @brief Piece randomization algorithm types
  */
 enum class RandType { 
-    SIMPLE,  /**< Simple random selection */
-    BAG      /**< Bag-based randomizer (7-bag system) */
+    SIMPLE,   /**< Simple random selection */
+    BAG,      /**< Bag-based randomizer (7-bag system) */
+    HISTORY,  /**< TGM: evita as últimas HISTORY_SIZE peças, até HISTORY_ROLLS tentativas */
+    BAG14,    /**< Duas cópias de cada peça por saco, sorteio incremental */
+    WEIGHTED  /**< Proporcional ao WEIGHT de cada peça (tabela de alias) */
 };
 
+/** @brief Resultado do parse de um .pieces, sem tocar em PIECES (hot reload) */
+struct PieceSet {
+    std::vector<Piece> pieces;      ///< Já com compilePieceTables
+    int previewGrid = 0;            ///< 0 = o arquivo não define
+    RandType randomizerType = RandType::SIMPLE;
+    int randBagSize = 0;
+};
+
+/**
+ * @brief Sorteio de peças (bag + RNG próprios por instância)
+ *
+ * Cada instância tem seu bag e seu PieceRng, então simulações paralelas não
+ * disputam estado. Tipo de randomizer, tamanho do bag e grade do preview
+ * vêm do arquivo de peças e são compartilhados.
+ */
 class PieceManager : public IPieceManager {
 public:
+    static constexpr int HISTORY_SIZE = 4;     // drawHistory compara as 4 direto
+    static constexpr int HISTORY_ROLLS = 6;
+    static constexpr int LOOKAHEAD_MAX = 16;   ///< peek(ahead) aceita ahead < LOOKAHEAD_MAX
+
+    /** @brief Estado completo do sorteio (RNG + bag + próxima peça) */
+    struct Snapshot {
+        RngState rng;
+        std::vector<int> bag;
+        size_t bagPos = 0;
+        int nextIdx = 0;
+        std::vector<int> pool;
+        size_t poolLeft = 0;
+        std::array<int, HISTORY_SIZE> history{};
+        int historyPos = 0;
+        std::array<int, LOOKAHEAD_MAX> ahead{};
+        int aheadHead = 0, aheadCount = 0;
+    };
+
     PieceManager();
 
     // Piece generation
@@ -31,15 +72,68 @@ public:
     void setRandomizerType(RandType type) override;
     void setRandBagSize(int size) override;
 
+    /**
+     * @brief Peça que getNextPiece() devolverá daqui a `ahead` sorteios (0 = a próxima)
+     *
+     * Sorteia adiantado numa fila circular; getNextPiece() consome dela antes
+     * de sortear de novo, então a sequência é a mesma com ou sem peek.
+     * @return -1 se ahead >= LOOKAHEAD_MAX
+     */
+    int peek(int ahead) override;
+
     // Additional API
     int getRandBagSize() const;
     RandType getRandomizerType() const;
-    std::mt19937& getRng();
+    PieceRng& getRng();
+    /** @brief Re-semeia o RNG (o bag atual segue até acabar; reset() resorteia) */
+    void seed(uint64_t seed);
+    Snapshot saveState() const;
+    void restoreState(const Snapshot& snap);
+    /** @brief O mesmo em POD (GameSnapshot); false com mt19937 ou conjunto maior que DealState::MAX_BAG */
+    bool saveDeal(DealState& out) const override;
+    /** @brief false (nada muda) se o estado não cabe no PIECES atual */
+    bool restoreDeal(const DealState& in) override;
+    /** @brief Primeiro .pieces de piecesCandidates() que carregar; nenhum = conjunto embutido (sempre true) */
     bool loadPiecesFile();
+    /** @brief Lê um .pieces em out; não mexe no estado global (seguro fora da thread principal) */
+    static bool parsePiecesFile(const std::string& path, PieceSet& out);
+    /** @brief Troca PIECES e as opções do arquivo pelo conjunto lido */
+    static void installPieceSet(PieceSet&& set);
     void seedFallback();
+    /** @brief Instala o conjunto padrão compilado (BuiltinPieces), sem parse */
+    void installBuiltinSet();
+    /** @brief Arquivos que loadPiecesFile() tenta, em ordem (configured = PIECES_FILE) */
+    static std::vector<std::string> piecesCandidates(const std::string& configured);
+    /** @brief "simple", "bag", "history", "bag14" ou "weighted" */
+    static const char* randTypeName(RandType type);
+    /** @brief Inverso de randTypeName (sem diferenciar maiúsculas) */
+    static bool parseRandType(const std::string& name, RandType& out);
+    /** @brief Arquivo de onde vieram as peças atuais (vazio = fallback interno) */
+    const std::string& getLoadedPath() const { return loadedPath_; }
+    void setLoadedPath(const std::string& path) { loadedPath_ = path; }
 
 private:
     void refillBag();
+    int drawPiece();       // Um sorteio do randomizer ativo, sem passar pela fila do peek
+    int drawBag();
+    int drawHistory();
+    int drawMultiBag();
+    int drawWeighted();
+    void resetDrawState();
+
+    std::vector<int> bag_;
+    size_t bagPos_ = 0;
+    int nextIdx_ = 0;
+    // BAG14: o multiconjunto não muda entre sacos; cada sorteio é um passo de
+    // Fisher-Yates sobre [0, poolLeft_) e o saco novo é só poolLeft_ = size
+    std::vector<int> pool_;
+    size_t poolLeft_ = 0;
+    std::array<int, HISTORY_SIZE> history_{};
+    int historyPos_ = 0;
+    std::array<int, LOOKAHEAD_MAX> ahead_{};
+    int aheadHead_ = 0, aheadCount_ = 0;
+    PieceRng rng_;
+    std::string loadedPath_;
 };
 
 
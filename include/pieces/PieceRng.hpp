@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+
+/**
+ * @brief Gerador de números usado no sorteio das peças
+ */
+enum class RngType {
+    XOSHIRO,   /**< xoshiro128++ (16 bytes de estado) */
+    PCG,       /**< pcg32 (16 bytes de estado, padrão: o mais rápido no bag) */
+    MT19937    /**< std::mt19937 (comportamento antigo, ~2.5 KB de estado) */
+};
+
+/**
+ * @brief Estado capturado de um PieceRng; restaurar reproduz a mesma sequência
+ *
+ * Para XOSHIRO/PCG é só o struct (cópia trivial). mt19937 vai num bloco
+ * separado, compartilhado entre cópias do snapshot.
+ */
+struct RngState {
+    RngType type = RngType::PCG;
+    uint64_t seed = 0;
+    uint64_t words[2] = {0, 0};
+    std::shared_ptr<const std::mt19937> mt;
+};
+
+/**
+ * @brief PRNG selecionável com semente explícita e snapshot barato
+ *
+ * Satisfaz UniformRandomBitGenerator (32 bits), mas o bag usa below(), que não
+ * depende da implementação de std::uniform_int_distribution: a mesma semente
+ * dá as mesmas peças em qualquer biblioteca padrão.
+ */
+class PieceRng {
+public:
+    using result_type = uint32_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    explicit PieceRng(RngType type = RngType::PCG, uint64_t seed = 0);
+    PieceRng(const PieceRng& other);
+    PieceRng& operator=(const PieceRng& other);
+
+    /** @brief Troca o algoritmo e re-semeia com a semente atual */
+    void setType(RngType type);
+    RngType type() const { return type_; }
+
+    void seed(uint64_t seed);
+    uint64_t getSeed() const { return seed_; }
+
+    result_type operator()() {
+        switch (type_) {
+            case RngType::PCG: return nextPcg();
+            case RngType::MT19937: return (result_type)(*mt_)();
+            default: return nextXoshiro();
+        }
+    }
+
+    /** @brief Inteiro uniforme em [0, n) (multiplicação de Lemire, sem viés) */
+    uint32_t below(uint32_t n) {
+        uint64_t m = (uint64_t)(*this)() * n;
+        uint32_t low = (uint32_t)m;
+        if (low < n) {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold) { m = (uint64_t)(*this)() * n; low = (uint32_t)m; }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    RngState save() const;
+    void restore(const RngState& state);
+
+    static const char* typeName(RngType type);
+    /** @brief "xoshiro", "pcg" ou "mt19937" (sem diferenciar maiúsculas) */
+    static bool parseType(const std::string& name, RngType& out);
+
+private:
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    uint32_t nextXoshiro() {
+        // Estado em 2x64 bits: com 4x32 o GCC junta as escritas num store SSE
+        // e as leituras seguintes perdem o store-forwarding (~3x mais lento)
+        uint32_t s0 = (uint32_t)xa_, s1 = (uint32_t)(xa_ >> 32);
+        uint32_t s2 = (uint32_t)xb_, s3 = (uint32_t)(xb_ >> 32);
+        uint32_t result = rotl(s0 + s3, 7) + s0;
+        uint32_t t = s1 << 9;
+        s2 ^= s0; s3 ^= s1; s1 ^= s2; s0 ^= s3;
+        s2 ^= t;
+        s3 = rotl(s3, 11);
+        xa_ = (uint64_t)s0 | ((uint64_t)s1 << 32);
+        xb_ = (uint64_t)s2 | ((uint64_t)s3 << 32);
+        return result;
+    }
+
+    uint32_t nextPcg() {
+        uint64_t old = pcgState_;
+        pcgState_ = old * 6364136223846793005ull + pcgInc_;
+        uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rot = (uint32_t)(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    RngType type_;
+    uint64_t seed_ = 0;
+    uint64_t xa_ = 1, xb_ = 0;          // xoshiro128++: s0|s1<<32, s2|s3<<32
+    uint64_t pcgState_ = 0;
+    uint64_t pcgInc_ = 1;
+    std::unique_ptr<std::mt19937> mt_;   // Só alocado com MT19937
+};
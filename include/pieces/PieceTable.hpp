@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+struct Piece;
+
+/**
+ * @brief O conjunto de peças achatado em arrays paralelos (SoA)
+ *
+ * Espelho compacto de PIECES para quem percorre o conjunto inteiro a cada
+ * layout (miniaturas do painel de estatísticas, peças do NEXT): as células de
+ * todas as rotações ficam contíguas em cellX/cellY e cada (peça, rotação) é a
+ * faixa [rotBegin[s], rotBegin[s + 1]) com s = slot(peça, rotação). Com
+ * centenas de peças são alguns KB num bloco só, em vez de quatro vetores no
+ * heap por peça. Cores ficam em PIECES: o tema pode trocá-las a qualquer hora.
+ */
+struct PieceTable {
+    std::vector<int16_t> cellX, cellY;
+    std::vector<uint32_t> rotBegin;                 // size() * 4 + 1 offsets
+    std::vector<int16_t> minX, minY, maxX, maxY;    // bounding box de cada slot
+    // Tabela de alias (Vose) dos pesos: sorteia i uniforme e fica com i se
+    // u32 < aliasProb[i], senão com alias[i]. Todo peso 0 = uniforme.
+    std::vector<uint32_t> aliasProb;
+    std::vector<int> alias;
+    Uint32 generation = 0;                          // sobe a cada rebuild
+
+    static int slot(int piece, int rot) { return piece * 4 + rot; }
+    int size() const { return rotBegin.empty() ? 0 : (int)(rotBegin.size() - 1) / 4; }
+    int cellCount(int piece, int rot) const {
+        const int s = slot(piece, rot);
+        return (int)(rotBegin[s + 1] - rotBegin[s]);
+    }
+    int width(int piece, int rot) const { const int s = slot(piece, rot); return maxX[s] - minX[s] + 1; }
+    int height(int piece, int rot) const { const int s = slot(piece, rot); return maxY[s] - minY[s] + 1; }
+};
+
+/** @brief Tabela de PIECES; refeita por rebuildPieceTable() sempre que PIECES é trocado */
+extern PieceTable PIECE_TABLE;
+
+/** @brief Reconstrói PIECE_TABLE a partir de pieces (rotações vazias viram faixas vazias) */
+void rebuildPieceTable(const std::vector<Piece>& pieces);
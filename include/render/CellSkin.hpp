@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <SDL2/SDL.h>
+
+/**
+ * @brief Atlas das células (CELL_SKIN): um tile de bloco e um texel branco
+ *
+ * O tile é em tons de cinza e a cor da peça vem por vértice (color mod do
+ * SDL_RenderGeometry), então um atlas serve para todas as cores e todo o
+ * board/NEXT/stats vira uma chamada só. A parte branca deixa as células
+ * lisas (vazio do tabuleiro, grade do NEXT) no mesmo draw.
+ */
+struct CellSkin {
+    SDL_Texture* texture = nullptr;
+    SDL_FRect blockUV{0, 0, 0, 0};   // Tile do bloco (bevel/gloss/imagem)
+    SDL_FRect flatUV{0, 0, 0, 0};    // Branco: cor exata do vértice
+    Uint32 generation = 0;           // Muda a cada atlas novo (caches de textura refazem)
+};
+
+/**
+ * @brief Atlas de CELL_SKIN para este renderer, construído na primeira chamada
+ *
+ * CELL_SKIN: "flat" (padrão, sem atlas), "bevel", "gloss" ou o caminho de um
+ * .bmp com o tile. Trocar o valor (hot reload) refaz o atlas.
+ * @return nullptr = células lisas por SDL_RenderFillRects
+ */
+const CellSkin* acquireCellSkin(SDL_Renderer* ren);
+
+/// SDL_RenderGeometry falhou com o atlas: volta para as células lisas
+void disableCellSkin();
+
+/// Libera o atlas; chame antes de destruir o renderer
+void releaseCellSkin();
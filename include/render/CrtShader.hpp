@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <string>
+
+class LayoutCache;
+struct VisualEffectsView;
+
+/**
+ * @brief Pós-processamento CRT num fragment shader (CRT_SHADER)
+ *
+ * O frame inteiro é desenhado numa render target; end() a desenha de volta
+ * no alvo anterior (janela ou a textura do CAPTURE_VIDEO) com um shader que
+ * aplica scanlines, sweep global, curvatura, vinheta e glow numa passada só,
+ * com os parâmetros do VisualEffectsView.
+ *
+ * Só nos renderers "opengl" e "opengles2" do SDL: as funções GL vêm de
+ * SDL_GL_GetProcAddress (sem linkar libGL) e o estado GL que o SDL guarda em
+ * cache é restaurado depois do draw. Em qualquer falha o shader desliga de
+ * vez e o PostEffectsLayer volta a desenhar scanlines e sweep.
+ */
+class CrtShader {
+public:
+    CrtShader();
+    ~CrtShader();
+    CrtShader(const CrtShader&) = delete;
+    CrtShader& operator=(const CrtShader&) = delete;
+
+    /**
+     * @brief Antes do draw: aponta o render para a textura da cena
+     * @return false = este frame sem shader (desligado, renderer sem GL, erro)
+     */
+    bool begin(SDL_Renderer* renderer, const VisualEffectsView& fx, int w, int h);
+    /// Depois das layers: cena -> alvo anterior pelo shader
+    void end(SDL_Renderer* renderer, const LayoutCache& layout, const VisualEffectsView& fx);
+    /// Libera programa e textura; chame antes de destruir o renderer
+    void release();
+
+    bool isFailed() const { return failed_; }
+    /// "GLSL (opengles2)", "OFF" ou o motivo da queda, para o overlay de debug
+    std::string statusLine() const;
+
+    struct Gl;   // Ponteiros das funções GL (CrtShader.cpp)
+
+private:
+    bool init(SDL_Renderer* renderer);
+    void fail(const std::string& why);
+
+    std::unique_ptr<Gl> gl_;
+    unsigned program_ = 0;
+    int locScene_ = -1, locUvScale_ = -1, locSize_ = -1, locArea_ = -1, locScanline_ = -1;
+    int locSweep_ = -1, locSweepSigma_ = -1, locCurvature_ = -1, locVignette_ = -1, locGlow_ = -1;
+    SDL_Texture* scene_ = nullptr;
+    int w_ = 0, h_ = 0;
+    Uint32 sceneEpoch_ = 0;   // TexturePool::deviceEpoch() da cena
+    SDL_Texture* prevTarget_ = nullptr;
+    bool active_ = false;    // begin() trocou o alvo neste frame
+    bool failed_ = false;
+    std::string driver_;
+    std::string failure_;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief Comandos de desenho que o jogo submete ao SDL_Renderer (por frame)
+ *
+ * Os wrappers têm a assinatura e o retorno do SDL_Render* correspondente e
+ * só somam um ao contador: layers, primitivos e caches desenham por aqui. O
+ * SDL ainda junta esses comandos em lotes (RENDER_BATCHING) antes do driver,
+ * então o número é o trabalho submetido, não chamadas à GPU. Fora da conta:
+ * o overlay de debug, o MARQUEE_DISPLAY (outro renderer) e o desenho direto
+ * do SoftRaster. Só a thread de render.
+ */
+namespace DrawCalls {
+
+inline unsigned g_count = 0;
+
+inline unsigned count() { return g_count; }
+inline void reset() { g_count = 0; }
+/// Desenho que não passa pelos wrappers (glDrawArrays do CRT_SHADER)
+inline void add(unsigned n = 1) { g_count += n; }
+
+inline int copy(SDL_Renderer* r, SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst) {
+    ++g_count;
+    return SDL_RenderCopy(r, texture, src, dst);
+}
+inline int fillRect(SDL_Renderer* r, const SDL_Rect* rect) {
+    ++g_count;
+    return SDL_RenderFillRect(r, rect);
+}
+inline int fillRects(SDL_Renderer* r, const SDL_Rect* rects, int count) {
+    ++g_count;
+    return SDL_RenderFillRects(r, rects, count);
+}
+inline int drawRect(SDL_Renderer* r, const SDL_Rect* rect) {
+    ++g_count;
+    return SDL_RenderDrawRect(r, rect);
+}
+inline int geometry(SDL_Renderer* r, SDL_Texture* texture, const SDL_Vertex* vertices, int numVertices,
+                    const int* indices, int numIndices) {
+    ++g_count;
+    return SDL_RenderGeometry(r, texture, vertices, numVertices, indices, numIndices);
+}
+inline int clear(SDL_Renderer* r) {
+    ++g_count;
+    return SDL_RenderClear(r);
+}
+
+} // namespace DrawCalls
@@ -2,10 +2,13 @@
 
 #include <SDL2/SDL.h>
 #include <vector>
+#include "app/GameTypes.hpp"
 
 class GameState;
 class RenderManager;
+class TimerSystem;
 struct LayoutCache;
+struct GameSnapshot;
 struct VisualEffectsView {
     bool bannerSweep;
     bool globalSweep;
@@ -18,25 +21,81 @@ struct VisualEffectsView {
     int sweepGAlphaMax;
     float sweepGSoftness;
     int scanlineAlpha;
+    bool crtShader;       // CRT_SHADER: efeitos num fragment shader (render/CrtShader)
+    float crtCurvature;
+    float crtVignette;
+    float crtGlow;
+    int particleCapacity;    // PARTICLE_CAPACITY: tamanho do pool (0 = sem partículas)
+    float particleDensity;   // PARTICLE_DENSITY: multiplicador de partículas por célula
 };
 
+/**
+ * @brief View contígua (somente leitura) do stack travado
+ *
+ * Ponteiros para o bitboard e o plano de cores do GameBoard (ou do snapshot
+ * ligado): sem chamada nem bounds check por célula. Vale até a próxima
+ * mudança do tabuleiro / db_bindSnapshot; version igual = nada mudou.
+ */
+struct BoardView {
+    int rows = 0, cols = 0;
+    Uint32 version = 0;
+    const Uint32* rowMasks = nullptr;   ///< ocupação por linha, bit x = coluna x
+    const Cell* cells = nullptr;        ///< cor de (x, y) = cells[rowSlot[y] * stride + x]
+    const int* rowSlot = nullptr;
+    int stride = 0;
+
+    bool occupied(int x, int y) const { return (rowMasks[y] >> x) & 1u; }
+    const Cell* row(int y) const { return cells + rowSlot[y] * stride; }
+};
+
+/// Peça ativa com as células já em coordenadas do tabuleiro (da RotationMask)
+struct ActiveView {
+    static constexpr int MAX_CELLS = 32;
+    int idx = -1, rot = 0, x = 0, y = 0;
+    Uint8 r = 0, g = 0, b = 0;
+    int count = 0;
+    SDL_Point cells[MAX_CELLS];
+};
+
+struct NextView {
+    static constexpr int MAX_NEXT = 8;
+    int count = 0;
+    int idx[MAX_NEXT];
+};
+
+// Bulk views: preferred by layers, one call per frame instead of one per cell
+bool db_getBoardView(const GameState& state, BoardView& out);
+bool db_getActiveView(const GameState& state, ActiveView& out);
+bool db_getNextView(const GameState& state, NextView& out);
+
 // Read-only bridge to query GameState without exposing its internals
 bool db_getBoardSize(const GameState& state, int& rows, int& cols);
 bool db_getBoardCell(const GameState& state, int x, int y, Uint8& r, Uint8& g, Uint8& b, bool& occ);
+Uint32 db_getBoardVersion(const GameState& state);
 bool db_getActive(const GameState& state, int& idx, int& rot, int& x, int& y);
 bool db_getNextIdx(const GameState& state, int& nextIdx);
+const LockEvent& db_getLockEvent(const GameState& state);
 bool db_isPaused(const GameState& state);
 bool db_isGameOver(const GameState& state);
 int db_getScore(const GameState& state);
 int db_getLines(const GameState& state);
 int db_getLevel(const GameState& state);
 bool db_getPieceStats(const GameState& state, const std::vector<int>*& stats);
+const TimerSystem& db_getTimer(const GameState& state);
+
+// Snapshot bridge (threaded mode): capture on the sim thread, bind on the render thread.
+// While a snapshot is bound the read accessors above ignore `state` and read from it.
+void db_captureSnapshot(const GameState& state, GameSnapshot& out);
+void db_prepareSnapshotView(const GameState& state);  // copia config do timer (antes da thread)
+void db_bindSnapshot(const GameSnapshot* snapshot);
 
 // Loop/control bridge
 bool db_isRunning(const GameState& state);
 void db_update(GameState& state, SDL_Renderer* renderer);
 void db_render(GameState& state, RenderManager& renderManager, const LayoutCache& layout);
 void db_layoutCalculate(LayoutCache& layout, SDL_Renderer* renderer);
+// Layout para uma área w x h (fatia do split-screen desenhada com SDL_RenderSetViewport)
+void db_layoutCalculateSize(LayoutCache& layout, int w, int h);
 // Visual effects bridge (read-only snapshot)
 const VisualEffectsView& db_getVisualEffects();
 
@@ -1,12 +1,27 @@
 #pragma once
 
 #include "RenderLayer.hpp"
+#include <SDL2/SDL.h>
 #include <string>
+#include <vector>
 
 class GameState;
 class LayoutCache;
 struct SDL_Renderer;
 class AudioSystem;
+class RenderManager;
+struct VisualEffectsView;
+struct PieceRectRange;
+
+/** @brief Pilha de layers do jogo, na ordem de desenho (audio pode ser nullptr: sem sons dos efeitos) */
+void addDefaultLayers(RenderManager& manager, AudioSystem* audio);
+
+/**
+ * @brief Posição da banda do sweep global neste instante (PostEffectsLayer e CrtShader)
+ * @param sweepY topo da banda relativo à área virtual (negativo entrando por cima)
+ * @return false = banda vazia
+ */
+bool postEffectsSweepBand(const LayoutCache& layout, const VisualEffectsView& vis, int& sweepY, int& bandH);
 
 class BackgroundLayer : public RenderLayer {
 public:
@@ -20,17 +35,86 @@ public:
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
     int getZOrder() const override;
     std::string getName() const override;
+    bool getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const override;
 };
 
+/**
+ * @brief Miniaturas (rotação 0 de cada peça) baked numa render target, um slot por peça
+ *
+ * Refeito só quando o layout (cellRectsVersion), o CELL_SKIN ou as cores de
+ * PIECES mudam; desenhar uma miniatura vira um SDL_RenderCopy.
+ */
+class PieceAtlas {
+private:
+    SDL_Texture* texture_ = nullptr;
+    int cols_ = 0, slotW_ = 0, slotH_ = 0, count_ = 0;
+    Uint32 epoch_ = 0;   // TexturePool::targetsEpoch() do bake
+    Uint32 layout_ = 0;                 // LayoutCache::cellRectsVersion
+    Uint32 skin_ = 0;                   // CellSkin::generation
+    std::uint64_t colors_ = 0;
+    bool failed_ = false;
+public:
+    PieceAtlas() = default;
+    PieceAtlas(const PieceAtlas&) = delete;
+    PieceAtlas& operator=(const PieceAtlas&) = delete;
+    ~PieceAtlas();
+    
+    /**
+     * @brief Garante o atlas atualizado para as células dadas (relativas ao canto do slot)
+     * @param owner nome da layer, só para o log de falha
+     * @return false = sem render target; desenhar as células em modo imediato
+     */
+    bool prepare(SDL_Renderer* renderer, const LayoutCache& layout, const std::vector<PieceRectRange>& pieces,
+                 const std::vector<SDL_Rect>& cells, int slotW, int slotH, const char* owner);
+    /** @brief Copia a miniatura de piece para dst (depois de um prepare() bem-sucedido) */
+    void blit(SDL_Renderer* renderer, int piece, const SDL_Rect& dst) const;
+};
+
+/**
+ * @brief Painel de contagem por peça, virtualizado
+ *
+ * Desenha só as linhas que cabem na caixa: com mais peças que linhas saem as
+ * top-N por contagem (empate pelo índice). As miniaturas vêm de um atlas com
+ * a rotação 0 de cada peça, baked uma vez por layout/cores/CELL_SKIN; sem
+ * render target volta às células em batch.
+ */
 class PieceStatsLayer : public RenderLayer {
+private:
+    // Contagens formatadas, refeitas só quando o valor muda
+    std::vector<int> lastCounts_;
+    std::vector<std::string> countStrs_;
+    std::vector<int> order_;            // peças das linhas visíveis, de cima para baixo
+
+    PieceAtlas atlas_;
+
+    void selectRows(const std::vector<int>& counts, int rows);
 public:
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
     int getZOrder() const override;
     std::string getName() const override;
+    bool getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const override;
+    std::uint64_t contentVersion(const GameState& state) const override;
 };
 
 class BoardLayer : public RenderLayer {
+private:
+    // Grade de fundo + stack travado retidos numa render target; refeitos só
+    // quando a versão do tabuleiro, o layout, a cor de fundo ou o CELL_SKIN mudam
+    SDL_Texture* stackTexture_ = nullptr;
+    Uint32 cachedVersion_ = 0;
+    int cachedW_ = 0, cachedH_ = 0, cachedCellW_ = 0, cachedCellH_ = 0, cachedGapW_ = 0, cachedGapH_ = 0;
+    Uint8 cachedEmptyR_ = 0, cachedEmptyG_ = 0, cachedEmptyB_ = 0;
+    Uint32 cachedSkin_ = 0;   // CellSkin::generation (0 = células lisas)
+    Uint32 stackEpoch_ = 0;   // TexturePool::targetsEpoch(): targets perdidos pedem outra
+    bool textureFailed_ = false;
+
+    // Grade + stack a partir de layout.boardCells, deslocados de (dx, dy);
+    // flush = false deixa as células no batch para irem junto com a peça ativa
+    void drawStack(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout, int dx, int dy, bool flush);
 public:
+    ~BoardLayer() override;
+    /** @brief Força o redesenho do stack (ex.: SDL_RENDER_TARGETS_RESET) */
+    void invalidate() { cachedVersion_ = 0; }
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
     int getZOrder() const override;
     std::string getName() const override;
@@ -41,20 +125,34 @@ public:
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
     int getZOrder() const override;
     std::string getName() const override;
+    bool getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const override;
 };
 
+/**
+ * @brief Caixa NEXT: a próxima peça na grade e, com NEXT_COUNT > 1, o resto da
+ * fila do randomizer em miniaturas (do PieceAtlas) numa linha abaixo dela
+ */
 class NextLayer : public RenderLayer {
+private:
+    PieceAtlas queueAtlas_;
 public:
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
     int getZOrder() const override;
     std::string getName() const override;
+    bool getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const override;
+    std::uint64_t contentVersion(const GameState& state) const override;
 };
 
 class ScoreLayer : public RenderLayer {
+private:
+    int lastScore_ = 0, lastLines_ = 0, lastLevel_ = 0;
+    std::string scoreStr_, linesStr_, levelStr_;
 public:
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
     int getZOrder() const override;
     std::string getName() const override;
+    bool getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const override;
+    std::uint64_t contentVersion(const GameState& state) const override;
 };
 
 class OverlayLayer : public RenderLayer {
@@ -67,9 +165,27 @@ public:
 class PostEffectsLayer : public RenderLayer {
 private:
     AudioSystem* audio_ = nullptr;
+    
+    // Scanlines (1 px de largura, esticado) e faixa do sweep (gradiente
+    // vertical, rolado pelo dst rect); refeitos só quando a altura da área
+    // virtual ou os parâmetros visuais mudam
+    SDL_Texture* scanlineTex_ = nullptr;
+    int scanlineH_ = 0, scanlineAlpha_ = -1;
+    SDL_Texture* sweepTex_ = nullptr;
+    int sweepBandH_ = 0, sweepAlphaMax_ = -1;
+    float sweepSoftness_ = -1.0f;
+    Uint32 texturesEpoch_ = 0;   // TexturePool::deviceEpoch() das duas
+    bool texturesFailed_ = false;
+    
+    // Device perdido: as duas são refeitas no próximo ensure
+    void dropLostTextures();
+    bool ensureScanlineTexture(SDL_Renderer* renderer, int areaH, int alpha);
+    bool ensureSweepTexture(SDL_Renderer* renderer, int bandH, int alphaMax, float softness);
 public:
     explicit PostEffectsLayer(AudioSystem* audio);
+    ~PostEffectsLayer() override;
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
+    bool isAnimated(const GameState& state) const override;   // Sweep global
     int getZOrder() const override;
     std::string getName() const override;
 };
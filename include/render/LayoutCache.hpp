@@ -1,8 +1,23 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <vector>
 #include "ConfigTypes.hpp"
 
+class TextureCache;
+class TextTextureCache;
+
+/// Grade de retângulos de célula em coordenadas de tela, linha a linha
+struct CellRectTable {
+    int cols = 0, rows = 0;
+    std::vector<SDL_Rect> rects;
+
+    const SDL_Rect& at(int x, int y) const { return rects[y * cols + x]; }
+};
+
+/// Faixa [begin, begin + count) de uma peça numa lista de retângulos
+struct PieceRectRange { int begin = 0, count = 0; };
+
 struct LayoutCache {
     // Physical screen dimensions
     int SWr, SHr;
@@ -22,6 +37,7 @@ struct LayoutCache {
     ElementLayout hudConfig;
     ElementLayout nextConfig;
     ElementLayout scoreConfig;
+    int nextCount = 1;                          // LayoutConfig::nextCount
     
     // Global border settings
     int borderRadius;
@@ -40,6 +56,27 @@ struct LayoutCache {
     int offsetY;
     ScaleMode scaleMode;
     
+    // Retângulos de célula (layoutBuildCellRects): layers só indexam, sem conta por célula
+    CellRectTable boardCells;                   // grade do tabuleiro (GX/GY); cobre COLS x ROWS
+    CellRectTable nextGrid;                     // checkerboard do NEXT (vazio sem nextRect)
+    std::vector<SDL_Rect> nextPieceCells;       // rotação 0 de cada peça, centrada no NEXT
+    std::vector<PieceRectRange> nextPieces;     // por índice de PIECES
+    std::vector<SDL_Rect> nextQueueCells;       // miniaturas da fila do NEXT, relativas ao canto do slot
+    std::vector<PieceRectRange> nextQueuePieces;
+    std::vector<SDL_Rect> statsPieceCells;      // miniaturas do painel, relativas ao canto do slot
+    std::vector<PieceRectRange> statsPieces;
+    Uint32 cellRectsVersion = 0;                // muda a cada layoutBuildCellRects (atlas de miniaturas)
+    
+    // Fatia de uma tela dividida (SPLIT_PLAYERS): o Background pinta só a área, sem limpar o alvo
+    bool region = false;
+    
+    // Pre-rendered static panels (nullptr = immediate mode, CACHED_PANELS=0)
+    const TextureCache* panels = nullptr;
+    // Pre-rendered HUD/score/stats strings (nullptr = immediate)
+    TextTextureCache* texts = nullptr;
+    // CRT_SHADER pass active this frame: PostEffectsLayer leaves scanlines/sweep to it
+    bool shaderEffects = false;
+    
     // Legacy fields (kept for compatibility during transition)
     int CW, CH, CX, CY;
     int scale;
@@ -51,3 +88,11 @@ struct LayoutCache {
     int statsBoxW, statsMargin;
 };
 
+
+/**
+ * @brief Refaz as tabelas de retângulos de célula a partir da geometria já calculada
+ *
+ * Chamada no fim de db_layoutCalculate; as miniaturas dependem de PIECES, então
+ * um reload de peças também precisa recalcular o layout.
+ */
+void layoutBuildCellRects(LayoutCache& layout);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "render/LayoutCache.hpp"
+#include "render/TextureCache.hpp"
+#include <array>
+
+/**
+ * @brief Layouts já calculados por (tamanho físico, SCALE_MODE), com os painéis assados
+ *
+ * Kiosque que gira entre retrato e paisagem, ou janela que pula entre
+ * monitores, volta sempre para os mesmos poucos tamanhos. Ao sair de um
+ * tamanho o LayoutCache e o TextureCache ativos são guardados aqui (por swap,
+ * sem copiar vetores nem texturas); ao voltar para um tamanho guardado eles
+ * retornam prontos, sem db_layoutCalculate nem bake.
+ *
+ * Tudo que muda o layout ou as cores dos painéis fora do tamanho (reload de
+ * LAYOUT/PIECES/COLORS/PANELS, troca de tema, CACHED_PANELS) chama clear().
+ * Sob TEXTURE_BUDGET_MB o pool despeja primeiro o tamanho guardado há mais
+ * tempo: voltar a ele só custa o cálculo e o bake de sempre.
+ */
+class LayoutVariants : public TextureEvictor {
+public:
+    static constexpr int MAX_ENTRIES = 4;
+
+    LayoutVariants();
+    ~LayoutVariants() override;
+    LayoutVariants(const LayoutVariants&) = delete;
+    LayoutVariants& operator=(const LayoutVariants&) = delete;
+
+    /**
+     * @brief Guarda o ativo sob a chave dele e traz (w, h, mode) se já existir
+     * @return true = layout e painéis do novo tamanho já estão no ativo;
+     *         false = o ativo ficou sem painéis: recalcule o layout e refaça
+     *
+     * Painéis no meio de um rebake (ou faltando) não são guardados.
+     */
+    bool swapTo(int w, int h, ScaleMode mode, LayoutCache& layout, TextureCache& panels);
+    /// Devolve as texturas guardadas ao renderTargetPool()
+    void clear();
+
+    int size() const;
+    unsigned hits() const { return hits_; }
+    unsigned misses() const { return misses_; }
+
+    Uint32 oldestTextureUse() const override;
+    void evictOldestTexture() override;
+
+private:
+    struct Entry {
+        bool used = false;
+        int w = 0, h = 0;
+        ScaleMode mode = ScaleMode::AUTO;
+        unsigned stamp = 0;
+        Uint32 frame = 0;    // TexturePool::frame() de quando foi guardada
+        LayoutCache layout{};
+        TextureCache panels;
+    };
+    Entry* find(int w, int h, ScaleMode mode);
+
+    std::array<Entry, MAX_ENTRIES> entries_;
+    unsigned clock_ = 0;
+    unsigned hits_ = 0;
+    unsigned misses_ = 0;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <string>
+#include <vector>
+
+class GameState;
+class SessionLog;
+
+/**
+ * @brief Janela do topper (MARQUEE_DISPLAY): placar, NEXT, ranking e o tabuleiro
+ *
+ * Um segundo renderer sobre outra tela, sem as layers: o tabuleiro é o
+ * próprio snapshot (uma textura streaming de COLS x ROWS pixels, um por
+ * célula, ampliada sem filtro) e o texto sai do atlas de glifos do
+ * Primitives. Texturas do SDL não passam de um renderer para outro, então
+ * "compartilhar" aqui é reusar os dados já prontos do frame principal, não
+ * as texturas da GPU.
+ *
+ * update() roda depois do Present da tela principal, no máximo MARQUEE_FPS
+ * vezes por segundo e só quando algo visível mudou; o renderer não usa
+ * vsync para nunca esperar o refresh da outra tela.
+ *
+ * O ranking vem da tabela persistente do SESSION_LOG quando há uma
+ * (setHighScores); sem ela, só as partidas desta sessão.
+ */
+class MarqueeDisplay {
+public:
+    static constexpr int TOP_COUNT = 5;
+    static constexpr int NEXT_SHOWN = 3;
+
+    MarqueeDisplay() = default;
+    ~MarqueeDisplay() { stop(); }
+    MarqueeDisplay(const MarqueeDisplay&) = delete;
+    MarqueeDisplay& operator=(const MarqueeDisplay&) = delete;
+
+    /// Janela sem borda do tamanho da tela `display`; o foco volta para mainWindow
+    bool start(int display, int fps, int boardCols, int boardRows, SDL_Window* mainWindow);
+    void stop();
+    bool isRunning() const { return renderer_ != nullptr; }
+
+    /// Ranking persistente (SESSION_LOG); nullptr = melhores desta execução
+    void setHighScores(const SessionLog* log) { scores_ = log; hasDrawn_ = false; }
+
+    /// Depois do Present principal (com o snapshot ligado no modo threaded)
+    void update(const GameState& state, Uint32 now);
+
+    /// "N fps, M frames, X ms" para o overlay de debug
+    std::string statusLine() const;
+
+private:
+    // O que está na tela: igual = nem desenha nem faz Present
+    struct Stamp {
+        Uint32 board = 0;
+        int active[4] = {-1, 0, 0, 0};
+        int next[NEXT_SHOWN] = {-1, -1, -1};
+        int score = -1, lines = -1, level = -1;
+        bool paused = false, over = false;
+        const void* theme = nullptr;
+        uint32_t scores = 0;
+        bool operator==(const Stamp& o) const;
+    };
+
+    void computeLayout(int w, int h);
+    void trackScores(const GameState& state);
+    void draw(const GameState& state);
+    void drawBoard(const GameState& state);
+    void drawInfo(const GameState& state);
+
+    SDL_Window* window_ = nullptr;
+    SDL_Renderer* renderer_ = nullptr;
+    SDL_Texture* board_ = nullptr;      // STREAMING, COLS x ROWS
+    std::vector<Uint32> pixels_;
+    int cols_ = 0, rows_ = 0;
+
+    SDL_Rect boardRect_{0, 0, 0, 0};
+    SDL_Rect infoRect_{0, 0, 0, 0};
+    int textScale_ = 1;
+
+    Uint32 intervalMs_ = 66;
+    Uint32 nextFrame_ = 0;
+    Stamp drawn_;
+    bool hasDrawn_ = false;
+
+    // Sem SESSION_LOG: melhores desta execução, contados no game over
+    const SessionLog* scores_ = nullptr;
+    std::array<int, TOP_COUNT> top_{};
+    int topCount_ = 0;
+    bool wasOver_ = false;
+
+    unsigned frames_ = 0;
+    double lastMs_ = 0.0;
+    int fps_ = 0;
+};
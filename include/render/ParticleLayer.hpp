@@ -0,0 +1,83 @@
+#pragma once
+
+#include "render/RenderLayer.hpp"
+#include "render/Primitives.hpp"
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class GameState;
+class LayoutCache;
+struct LockEvent;
+
+/**
+ * @brief Pool de partículas de capacidade fixa em structure-of-arrays
+ *
+ * Posição, velocidade e vida em arrays de float separados, alocados uma vez
+ * em setCapacity(): update() é um laço sem desvio nem chamada por partícula
+ * (o compilador vetoriza) seguido de uma compactação das mortas. Unidades
+ * em células do tabuleiro, y para baixo; quem desenha converte para pixels.
+ * Pool cheio = as novas são descartadas (dropped()).
+ */
+class ParticlePool {
+public:
+    static constexpr int BLOCK = 8;   ///< Largura do laço de update (2 x SSE, 1 x AVX)
+
+    void setCapacity(int capacity);
+    int capacity() const { return capacity_; }
+    int size() const { return count_; }
+    uint32_t dropped() const { return dropped_; }
+    void clear() { count_ = 0; }
+
+    void spawn(float x, float y, float vx, float vy, float lifeSec, Uint8 r, Uint8 g, Uint8 b);
+    /// Integra dt segundos (gravidade em células/s²) e remove as que morreram ou saíram de [0,w]x[0,h]
+    void update(float dt, float gravity, float w, float h);
+
+    // Arrays crus para o desenho (índices [0, size()))
+    const float* x() const { return x_.get(); }
+    const float* y() const { return y_.get(); }
+    const float* life() const { return life_.get(); }
+    const float* maxLife() const { return maxLife_.get(); }
+    const Uint8* r() const { return r_.get(); }
+    const Uint8* g() const { return g_.get(); }
+    const Uint8* b() const { return b_.get(); }
+
+private:
+    int capacity_ = 0, count_ = 0;
+    uint32_t dropped_ = 0;
+    std::unique_ptr<float[]> x_, y_, vx_, vy_, life_, maxLife_;
+    std::unique_ptr<Uint8[]> r_, g_, b_;
+};
+
+/**
+ * @brief Estouro nas linhas limpas e faíscas no lock, um SDL_RenderGeometry por frame
+ *
+ * Lê o LockEvent pelo bridge (GameState vivo ou snapshot da thread de
+ * render): seq novo = spawn a partir das linhas limpas e das células da peça
+ * travada. O sorteio das partículas é um xorshift próprio, fora do RNG do
+ * jogo (replays e netplay não mudam). PARTICLE_CAPACITY e PARTICLE_DENSITY
+ * vêm do tema; capacidade 0 desliga. Pausa congela, game over deixa acabar.
+ */
+class ParticleLayer : public RenderLayer {
+public:
+    void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
+    int getZOrder() const override;
+    std::string getName() const override;
+    bool isAnimated(const GameState& state) const override;   // Enquanto houver partícula viva
+
+    /// Gera as partículas de um lock num tabuleiro de cols x rows (também usado no bench)
+    void spawnLock(const LockEvent& ev, int cols, int rows, float density);
+    const ParticlePool& pool() const { return pool_; }
+    ParticlePool& pool() { return pool_; }
+
+private:
+    float random01();
+
+    ParticlePool pool_;
+    QuadBatch batch_;
+    Uint32 seenSeq_ = 0;
+    bool seen_ = false;
+    Uint32 lastMs_ = 0;
+    uint32_t rng_ = 0x9E3779B9u;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <vector>
 #include <SDL2/SDL.h>
 
 void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int rad,
@@ -11,17 +13,84 @@ void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int rad, in
                         Uint8 R, Uint8 G, Uint8 B, Uint8 A);
 void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int radX, int radY, int thickness,
                         Uint8 R, Uint8 G, Uint8 B, Uint8 A);
-void drawPixelText(SDL_Renderer* r, int x, int y, const std::string& text, int scale,
+void drawPixelText(SDL_Renderer* r, int x, int y, std::string_view text, int scale,
                    Uint8 R, Uint8 G, Uint8 B);
-void drawPixelText(SDL_Renderer* r, int x, int y, const std::string& text, float scaleX, float scaleY,
+void drawPixelText(SDL_Renderer* r, int x, int y, std::string_view text, float scaleX, float scaleY,
                    Uint8 R, Uint8 G, Uint8 B);
-void drawPixelTextOutlined(SDL_Renderer* r, int x, int y, const std::string& text, int scale,
+void drawPixelTextOutlined(SDL_Renderer* r, int x, int y, std::string_view text, int scale,
                            Uint8 R, Uint8 G, Uint8 B,
                            Uint8 oR, Uint8 oG, Uint8 oB);
-void drawPixelTextOutlined(SDL_Renderer* r, int x, int y, const std::string& text, float scaleX, float scaleY,
+void drawPixelTextOutlined(SDL_Renderer* r, int x, int y, std::string_view text, float scaleX, float scaleY,
                            Uint8 R, Uint8 G, Uint8 B,
                            Uint8 oR, Uint8 oG, Uint8 oB);
-int textWidthPx(const std::string& text, int scale);
-int textWidthPx(const std::string& text, float scaleX);
+int textWidthPx(std::string_view text, int scale);
+int textWidthPx(std::string_view text, float scaleX);
 
+/**
+ * @brief Libera os atlas de glifos do texto pixelado
+ *
+ * O texto é desenhado com um atlas branco por par de escalas (SDL_RenderCopy
+ * por glifo, cor via color mod). Chame antes de destruir o renderer.
+ */
+void releaseGlyphAtlases();
+/// Só os atlas de um renderer (janela extra que fecha antes do jogo)
+void releaseGlyphAtlases(SDL_Renderer* renderer);
 
+
+
+/**
+ * @brief Agrupa retângulos por cor e os envia com SDL_RenderFillRects
+ *
+ * Caminho sem SDL_RenderGeometry do QuadBatch (e útil para rects soltos):
+ * cada cor vira uma troca de estado e uma chamada ao driver.
+ * Os buckets são reaproveitados entre frames (sem alocação depois do
+ * aquecimento). A ordem entre cores é a da primeira ocorrência, então só use
+ * o mesmo batch para rects que não se sobrepõem com cores diferentes depois
+ * de um flush().
+ */
+class RectBatch {
+public:
+    void add(const SDL_Rect& rect, Uint8 R, Uint8 G, Uint8 B, Uint8 A = 255);
+    void flush(SDL_Renderer* r);
+    void clear();
+    bool empty() const { return used_ == 0; }
+
+private:
+    struct Bucket {
+        Uint32 rgba = 0;
+        std::vector<SDL_Rect> rects;
+    };
+    std::vector<Bucket> buckets_;
+    size_t used_ = 0;
+};
+
+/**
+ * @brief Quads com cor por vértice (e textura opcional) num SDL_RenderGeometry
+ *
+ * Os layers de células empurram tudo do frame aqui (células, peça ativa,
+ * NEXT, miniaturas dos stats) e dão flush() na fronteira do layer: uma
+ * chamada ao driver por flush. Diferente do RectBatch, a ordem de submissão
+ * é preservada (a peça sobre a grade no mesmo draw). Vértices e índices são
+ * reaproveitados entre frames; reserve() evita o crescimento no primeiro.
+ *
+ * SDL < 2.0.18, ou o driver recusou a geometria: flush() cai para
+ * SDL_RenderFillRects agrupado por cor (RectBatch) e devolve false. Nesse modo
+ * a ordem entre cores se perde; preservesOrder() diz se é preciso um flush()
+ * entre camadas que se sobrepõem.
+ */
+class QuadBatch {
+public:
+    void reserve(size_t quads);
+    void add(const SDL_Rect& rect, Uint8 R, Uint8 G, Uint8 B, Uint8 A = 255);
+    void add(const SDL_Rect& rect, const SDL_FRect& uv, Uint8 R, Uint8 G, Uint8 B, Uint8 A = 255);
+    /// @return true = saiu num SDL_RenderGeometry; false = caminho de rects (a textura é ignorada)
+    bool flush(SDL_Renderer* r, SDL_Texture* texture = nullptr);
+    void clear() { verts_.clear(); }
+    bool empty() const { return verts_.empty(); }
+    static bool preservesOrder();
+
+private:
+    std::vector<SDL_Vertex> verts_;
+    std::vector<int> indices_;   // 0,1,2, 2,3,0 por quad; só cresce
+    RectBatch fallback_;
+};
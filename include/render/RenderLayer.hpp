@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 class GameState;
 class LayoutCache;
+struct SDL_Rect;
 struct SDL_Renderer;
 
 class RenderLayer {
@@ -18,6 +20,31 @@ public:
 
     virtual std::string getName() const = 0;
 
+    /**
+     * @brief A layer muda sozinha com o tempo (sweep, pisca-pisca)?
+     *
+     * Com IDLE_RENDER a pausa/game over só pula frames enquanto nenhuma
+     * layer habilitada estiver animando.
+     */
+    virtual bool isAnimated(const GameState& /*state*/) const { return false; }
+
+    /**
+     * @brief Retained mode (CACHED_LAYERS): retângulo onde a layer desenha
+     *
+     * Layers que devolvem true ficam guardadas numa render target do
+     * RenderManager e só são redesenhadas quando contentVersion() ou o
+     * retângulo mudam; nos outros frames viram um blit. false = imediata.
+     */
+    virtual bool getCacheBounds(const LayoutCache& /*layout*/, SDL_Rect& /*bounds*/) const { return false; }
+
+    /**
+     * @brief Resumo dos valores que a layer mostra (contagens, placar, próxima peça)
+     *
+     * Mesmo valor = mesma imagem. Tema, layout e painéis não entram: quem os
+     * troca chama RenderManager::invalidateCache().
+     */
+    virtual std::uint64_t contentVersion(const GameState& /*state*/) const { return 0; }
+
 protected:
     bool enabled_ = true;
 };
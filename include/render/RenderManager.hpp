@@ -3,27 +3,68 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <SDL2/SDL.h>
 #include "RenderLayer.hpp"
 
+class FrameProfiler;
 class GameState;
 class LayoutCache;
 class RenderLayer;
-struct SDL_Renderer;
 
 class RenderManager {
 private:
     std::vector<std::unique_ptr<RenderLayer>> layers_;
     SDL_Renderer* renderer_ = nullptr;
+    FrameProfiler* profiler_ = nullptr;
+    std::vector<int> profileSlots_;   // Seção do profiler por layer (mesma ordem de layers_)
+    std::vector<const char*> traceNames_; // Nome da zona de trace por layer (intern, mesma ordem)
+
+    // Retained mode: uma render target do tamanho da área de desenho, com uma
+    // região por layer cacheável (getCacheBounds); o frame só copia as regiões
+    struct CacheSlot {
+        SDL_Rect bounds{0, 0, 0, 0};
+        std::uint64_t version = 0;
+        bool active = false;   // Neste frame: retângulo válido e sem sobrepor outra layer cacheada
+        bool valid = false;    // A região guarda a imagem de bounds/version
+    };
+    std::vector<CacheSlot> cacheSlots_;   // Mesma ordem de layers_
+    SDL_Texture* cacheTexture_ = nullptr;
+    int cacheW_ = 0, cacheH_ = 0;
+    Uint32 cacheEpoch_ = 0;   // TexturePool::targetsEpoch() de quando foi pedida
+    bool retained_ = false;
+    bool cacheFailed_ = false;
+    int cacheRedraws_ = 0;   // Regiões redesenhadas no último frame
+
+    void rebuildProfileSlots();
+    bool prepareCache(const LayoutCache& layout);
+    void renderCached(size_t index, const GameState& state, const LayoutCache& layout);
+    void releaseCache();
 
 public:
     explicit RenderManager(SDL_Renderer* renderer);
+    ~RenderManager();
+    RenderManager(const RenderManager&) = delete;
+    RenderManager& operator=(const RenderManager&) = delete;
 
     void addLayer(std::unique_ptr<RenderLayer> layer);
     void render(const GameState& state, const LayoutCache& layout);
+    /// Alguma layer habilitada anima com o tempo (RenderLayer::isAnimated)
+    bool isAnimated(const GameState& state) const;
     void setLayerEnabled(const std::string& name, bool enabled);
     void cleanup();
     RenderLayer* getLayer(const std::string& name);
     std::vector<std::string> getLayerNames() const;
+
+    /// Mede cada layer habilitada com o performance counter (nullptr desliga)
+    void setProfiler(FrameProfiler* profiler);
+
+    /// CACHED_LAYERS: compõe as layers cacheáveis a partir da render target
+    void setRetained(bool retained);
+    bool isRetained() const { return retained_ && !cacheFailed_; }
+    /// Tema, painéis, layout ou targets perdidos: todas as regiões refazem no próximo frame
+    void invalidateCache();
+    /// Regiões redesenhadas no último render() (0 = frame só de blits)
+    int getCacheRedraws() const { return cacheRedraws_; }
 };
 
 
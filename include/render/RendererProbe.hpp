@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+class GameState;
+
+/**
+ * @brief Escolha do driver de render (RENDER_DRIVER)
+ *
+ * Vazio/AUTO deixa o SDL escolher; um nome ("opengl", "opengles2",
+ * "direct3d11", "software"...) força o driver; PROBE mede cada driver
+ * disponível com as layers de verdade (renderer sem vsync, batching ligado)
+ * e grava o mais rápido em RENDER_PROBE_FILE. O arquivo é por máquina: se
+ * plataforma, driver de vídeo, modo de tela ou lista de drivers mudarem, a
+ * medição é refeita.
+ */
+namespace RendererProbe {
+
+struct Sample {
+    std::string driver;
+    double frameMs = 0.0;   ///< média por frame (Present incluso)
+    bool ok = false;        ///< renderer criado e frames rodados
+};
+
+/// Índice para SDL_CreateRenderer (nome sem diferenciar caixa); -1 = não existe
+int driverIndex(const std::string& name);
+/// Nome do driver de um renderer (SDL_GetRendererInfo); "" se falhar
+std::string driverName(SDL_Renderer* renderer);
+
+/// Identifica a máquina: plataforma, driver de vídeo, modo do display, drivers de render
+std::string machineKey(SDL_Window* window);
+/// Driver gravado para esta máquina; false se o arquivo falta ou é de outra máquina
+bool loadChoice(const std::string& path, const std::string& machine, std::string& driver);
+bool saveChoice(const std::string& path, const std::string& machine, const std::string& driver,
+                const std::vector<Sample>& samples);
+
+/**
+ * @brief Roda `frames` frames das layers padrão em cada driver (após warm-up)
+ *
+ * Cada driver tem renderer e layers próprios, destruídos no fim; a janela é
+ * a do jogo. Resultado na ordem de SDL_GetRenderDriverInfo.
+ */
+std::vector<Sample> measure(SDL_Window* window, const GameState& state, int frames);
+/// Mais rápido entre os ok; "" se nenhum
+std::string fastest(const std::vector<Sample>& samples);
+
+} // namespace RendererProbe
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Kernels vetoriais do raster de software: SSE2 (x86-64) ou NEON (ARM) quando
+// o compilador os oferece; -DDROPBLOCKS_SOFT_SIMD=0 força o laço escalar
+#ifndef DROPBLOCKS_SOFT_SIMD
+#define DROPBLOCKS_SOFT_SIMD 1
+#endif
+
+/**
+ * @brief Caminho de CPU para cabines sem renderer acelerado
+ *
+ * Sem GPU o jogo desenha num SDL_Surface próprio (SDL_CreateSoftwareRenderer):
+ * as layers continuam usando o mesmo SDL_Renderer, mas os primitivos que
+ * mais pesam no renderer de software do SDL (QuadBatch/RectBatch, painéis
+ * arredondados, texto pixelado) escrevem direto nos pixels do frame com os
+ * kernels daqui. present() copia o frame inteiro para a janela uma vez.
+ *
+ * O caminho direto só vale quando o alvo é o próprio frame (sem render
+ * target, escala 1); com textura-alvo tudo segue pelo SDL.
+ */
+namespace SoftRaster {
+
+/// Cria o frame do tamanho da janela e o renderer de software sobre ele; nullptr = falhou
+SDL_Renderer* createFrame(SDL_Window* window);
+/// O renderer é o do frame de software?
+bool isFrameRenderer(const SDL_Renderer* renderer);
+/// SDL_DestroyRenderer, liberando também o frame se for o caso (e o que o renderTargetPool() guardava dele)
+void destroyRenderer(SDL_Renderer* renderer);
+/// SDL_RenderPresent; no frame de software, copia os pixels para a janela
+void present(SDL_Renderer* renderer);
+/// "SSE2", "NEON" ou "scalar"
+const char* kernelName();
+
+/**
+ * @brief Pixels do frame para desenho direto (coordenadas do viewport atual)
+ */
+struct Target {
+    Uint32* pixels = nullptr;
+    int stride = 0;          ///< pixels por linha
+    int originX = 0, originY = 0;
+    SDL_Rect clip{0, 0, 0, 0};  ///< em pixels do frame, já com viewport e clip do renderer
+};
+
+/**
+ * @brief Prepara o desenho direto no frame
+ * @return false = não é o frame de software (ou há render target/escala): use o SDL
+ *
+ * Esvazia a fila de comandos do SDL antes, para manter a ordem com o que
+ * as layers já submeteram.
+ */
+bool beginDirect(SDL_Renderer* renderer, Target& out);
+
+/// Cor do frame (ARGB8888/RGB888) a partir de RGB
+inline Uint32 packColor(Uint8 r, Uint8 g, Uint8 b) {
+    return 0xFF000000u | ((Uint32)r << 16) | ((Uint32)g << 8) | b;
+}
+
+/// n pixels iguais a color
+void fillSpan(Uint32* dst, int n, Uint32 color);
+/// src-over de color com alpha a (o mesmo SDL_BLENDMODE_BLEND do renderer)
+void blendSpan(Uint32* dst, int n, Uint32 color, Uint8 alpha);
+
+/// Retângulo em coordenadas do viewport, recortado pelo clip do alvo
+void fillRect(const Target& t, int x, int y, int w, int h, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+/// Retângulo arredondado (cantos elípticos); thickness 0 = cheio, > 0 = só o anel
+void fillRounded(const Target& t, int x, int y, int w, int h, int radX, int radY, int thickness,
+                 Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+} // namespace SoftRaster
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "render/TexturePool.hpp"
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Small LRU of pre-rendered pixel-font strings
+ *
+ * Entries are keyed by (text, scaleX, scaleY, color[, outline color]) and
+ * hold a transparent texture with the string drawn once, so HUD/score/stats
+ * readouts become one SDL_RenderCopy while their values don't change.
+ * Lookup is a linear scan (no allocation); when render targets are not
+ * available it draws immediately with drawPixelText.
+ *
+ * Textures come from renderTargetPool() (counted as TextureUse::TEXT); under
+ * TEXTURE_BUDGET_MB the pool may evict entries not drawn this frame, and lost
+ * render targets drop them all. Both are simply baked again on the next draw.
+ */
+class TextTextureCache : public TextureEvictor {
+public:
+    static constexpr size_t MAX_ENTRIES = 64;
+
+    TextTextureCache();
+    ~TextTextureCache() override;
+
+    TextTextureCache(const TextTextureCache&) = delete;
+    TextTextureCache& operator=(const TextTextureCache&) = delete;
+
+    void draw(SDL_Renderer* renderer, int x, int y, const std::string& text, float scaleX, float scaleY,
+              Uint8 R, Uint8 G, Uint8 B);
+    void drawOutlined(SDL_Renderer* renderer, int x, int y, const std::string& text, float scaleX, float scaleY,
+                      Uint8 R, Uint8 G, Uint8 B, Uint8 oR, Uint8 oG, Uint8 oB);
+
+    /** @brief Drop all textures (layout/theme change, renderer reset) */
+    void clear();
+    size_t size() const { return entries_.size(); }
+    /** @brief Entradas antes do LRU descartar (várias telas compartilhando o cache) */
+    void setCapacity(size_t capacity) { capacity_ = capacity ? capacity : MAX_ENTRIES; }
+
+    Uint32 oldestTextureUse() const override;
+    void evictOldestTexture() override;
+
+private:
+    struct Entry {
+        std::string text;
+        float scaleX = 0.f, scaleY = 0.f;
+        Uint32 color = 0, outline = 0;
+        bool outlined = false;
+        SDL_Texture* tex = nullptr;
+        int w = 0, h = 0, pad = 0, padY = 0;
+        Uint32 lastUse = 0;
+        Uint32 frame = 0;   // TexturePool::frame() do último draw
+    };
+    std::vector<Entry> entries_;
+    size_t capacity_ = MAX_ENTRIES;
+    Uint32 clock_ = 0;
+    Uint32 epoch_ = 0;      // TexturePool::targetsEpoch() das entradas
+    bool failed_ = false;
+
+    const Entry* find(SDL_Renderer* renderer, const std::string& text, float scaleX, float scaleY,
+                      Uint32 color, bool outlined, Uint32 outline);
+};
@@ -1,18 +1,24 @@
 #pragma once
 
+#include "render/TexturePool.hpp"
 #include <SDL2/SDL.h>
 #include <memory>
 
 // Forward declarations
 struct LayoutCache;
 class ThemeManager;
+struct Theme;
 
 /**
  * @brief Manages pre-rendered textures for static UI panels
  * 
  * This cache stores textures for panels that don't change frequently
- * (banner, stats box, HUD panel, NEXT box). Pre-rendering these to
+ * (banner, stats box, HUD panel, NEXT box, score box). Pre-rendering these to
  * textures is much faster than redrawing them every frame.
+ *
+ * Static text that only depends on layout/theme (banner title, "NEXT" label)
+ * is baked in as well. Layers read the cache through LayoutCache::panels and
+ * fall back to immediate drawing when a texture is missing.
  */
 class TextureCache {
 public:
@@ -33,6 +39,22 @@ public:
      */
     void update(SDL_Renderer* renderer, const LayoutCache& layout, ThemeManager& themeManager);
     
+    /**
+     * @brief Troca de paleta: refaz os painéis um por frame (rebakeStep)
+     *
+     * Cada painel antigo segue na tela até o novo estar pronto, então a troca
+     * custa um painel por frame em vez de todos de uma vez.
+     */
+    void requestRebake() { if (valid_) rebakePending_ = (1u << PANEL_COUNT) - 1; }
+    /// Refaz o próximo painel pendente; true se ainda sobrou algum
+    bool rebakeStep(SDL_Renderer* renderer, const LayoutCache& layout, ThemeManager& themeManager);
+    bool isRebaking() const { return rebakePending_ != 0; }
+    
+    /// Troca as texturas com outro cache (LayoutVariants guarda os painéis de outra resolução)
+    void swap(TextureCache& other) noexcept;
+    /// Conta os painéis em outro cache do renderTargetPool() (overlay TEXTURES)
+    void retag(TextureUse use);
+    
     /**
      * @brief Check if cache is valid
      */
@@ -64,18 +86,33 @@ public:
     SDL_Texture* getNextBoxTexture() const { return nextBoxTexture_; }
     
     /**
-     * @brief Free all textures
+     * @brief Get cached score box background texture
+     */
+    SDL_Texture* getScoreBoxTexture() const { return scoreBoxTexture_; }
+    
+    /**
+     * @brief Free all textures (back to renderTargetPool())
      */
     void cleanup();
     
 private:
+    enum Panel { BANNER, STATS, HUD, NEXT, SCORE, PANEL_COUNT };
+    
     SDL_Texture* bannerTexture_ = nullptr;
     SDL_Texture* statsBoxTexture_ = nullptr;
     SDL_Texture* hudPanelTexture_ = nullptr;
     SDL_Texture* nextBoxTexture_ = nullptr;
+    SDL_Texture* scoreBoxTexture_ = nullptr;
     bool valid_ = false;
+    unsigned rebakePending_ = 0;   // Bits de Panel
+    
+    SDL_Texture** slot(int panel);
+    /// Desenha um painel numa textura nova (deixa o render target nela)
+    SDL_Texture* bake(int panel, SDL_Renderer* renderer, const LayoutCache& layout, const Theme& th);
     
     // Helper to create a texture
     SDL_Texture* createTexture(SDL_Renderer* renderer, int w, int h);
+    // Create a texture, make it the render target and clear it to transparent
+    SDL_Texture* beginPanel(SDL_Renderer* renderer, int w, int h);
 };
 
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Quem é dono da textura (contabilidade por cache no overlay)
+ */
+enum class TextureUse : Uint8 {
+    PANELS,     ///< TextureCache ativo
+    LAYOUTS,    ///< Painéis de outras resoluções guardados no LayoutVariants
+    RETAINED,   ///< Cache retido do RenderManager
+    BOARD,      ///< Stack do tabuleiro
+    TIMER,      ///< Caixa do timer
+    THUMBS,     ///< Miniaturas das peças (NEXT, estatísticas)
+    TEXT,       ///< TextTextureCache
+    GLYPHS,     ///< Atlas de glifos
+    SKIN,       ///< CELL_SKIN
+    EFFECTS,    ///< Colunas de scanlines/sweep
+    CRT,        ///< Cena do CRT_SHADER
+    CAPTURE,    ///< Anel do VIDEO_CAPTURE
+    MARQUEE,    ///< Painel do MARQUEE_DISPLAY
+    COUNT
+};
+
+const char* textureUseName(TextureUse use);
+
+/**
+ * @brief Cache que sabe refazer as próprias texturas (despejo LRU do pool)
+ *
+ * O uso é medido em TexturePool::frame(). Só texturas que não foram usadas no
+ * frame corrente são despejadas: o que já está na fila de draw não some.
+ */
+class TextureEvictor {
+public:
+    virtual ~TextureEvictor() = default;
+    /// frame() do uso mais antigo entre as que dá para refazer; UINT32_MAX = nenhuma
+    virtual Uint32 oldestTextureUse() const = 0;
+    /// Solta essa textura (TexturePool::release); o dono refaz quando precisar de novo
+    virtual void evictOldestTexture() = 0;
+};
+
+/**
+ * @brief Todas as texturas do jogo: render targets reaproveitados e a contabilidade da VRAM
+ *
+ * Painéis do TextureCache, o cache retido do RenderManager, o stack do
+ * tabuleiro e a caixa do timer pedem texturas do tamanho exato do que
+ * desenham. Ao trocar de resolução (ou de monitor) as antigas voltam para cá
+ * em vez de SDL_DestroyTexture, e a próxima troca para um tamanho já visto
+ * sai sem SDL_CreateTexture. Os baldes são por tamanho exato: entre
+ * resoluções conhecidas os tamanhos se repetem, e arredondar obrigaria todo
+ * blit a usar src rect. As demais (atlas STATIC, streaming, formato da cena
+ * do CRT) saem de create(): não são reaproveitadas, só contadas.
+ *
+ * As livres ficam sob um orçamento em bytes; acima dele a menos usada é
+ * destruída. TEXTURE_BUDGET_MB limita o total (em uso + livres): antes de
+ * criar uma textura que passaria dele, saem as livres e depois, em LRU
+ * entre os caches registrados, texturas que o dono sabe refazer (textos,
+ * atlas de glifos, painéis de outras resoluções). O que ainda não couber é
+ * criado assim mesmo: o orçamento nunca deixa um layer sem textura.
+ *
+ * Render targets perdidos (SDL_RENDER_TARGETS_RESET) ou device perdido
+ * (SDL_RENDER_DEVICE_RESET) só avançam targetsEpoch()/deviceEpoch(); cada
+ * dono compara com o que guardou e refaz no próximo uso. Só a thread de
+ * render usa.
+ */
+class TexturePool {
+public:
+    /// Orçamento padrão das texturas livres (as em uso não contam)
+    static constexpr size_t DEFAULT_BUDGET = 48u << 20;
+
+    /**
+     * @brief Textura TARGET w x h com blend BLEND e mods zerados; nullptr = falhou
+     *
+     * O conteúdo de uma textura reaproveitada é o do dono anterior: limpe antes de usar.
+     */
+    SDL_Texture* acquire(SDL_Renderer* renderer, int w, int h, TextureUse use);
+    /// SDL_CreateTexture contabilizado (fora do reaproveitamento); release() destroi
+    SDL_Texture* create(SDL_Renderer* renderer, Uint32 format, int access, int w, int h, TextureUse use);
+    /// Devolve ao pool; textura que não saiu de acquire() é só destruída
+    void release(SDL_Texture* texture);
+    /// Passa a contar a textura em outro cache (LayoutVariants guardando painéis)
+    void retag(SDL_Texture* texture, TextureUse use);
+    /// Destroi as livres do renderer e esquece as em uso (antes de SDL_DestroyRenderer)
+    void purge(SDL_Renderer* renderer);
+
+    void setBudget(size_t bytes);
+    /// Teto do total em uso + livres; 0 = sem teto
+    void setVramBudget(size_t bytes);
+    size_t vramBudget() const { return vramBudget_; }
+
+    /// Os caches despejáveis se registram aqui (e saem antes de morrer)
+    void addEvictor(TextureEvictor* evictor);
+    void removeEvictor(TextureEvictor* evictor);
+
+    /// Um por frame, antes do render: o relógio do LRU entre caches
+    void beginFrame() { ++frame_; }
+    Uint32 frame() const { return frame_; }
+
+    /// SDL_RENDER_TARGETS_RESET: o conteúdo dos render targets se perdeu
+    void markTargetsLost();
+    /// SDL_RENDER_DEVICE_RESET: todas as texturas se perderam (as livres são destruídas já)
+    void markDeviceLost();
+    Uint32 targetsEpoch() const { return targetsEpoch_; }   ///< Avança nos dois casos
+    Uint32 deviceEpoch() const { return deviceEpoch_; }
+
+    size_t freeBytes() const { return freeBytes_; }
+    size_t freeCount() const { return free_.size(); }
+    size_t liveCount() const { return live_.size(); }
+    size_t liveBytes(TextureUse use) const { return useBytes_[(int)use]; }
+    size_t totalBytes() const { return liveBytes_ + freeBytes_; }
+    unsigned hits() const { return hits_; }        ///< acquire() atendidos por uma livre
+    unsigned misses() const { return misses_; }    ///< acquire() que criaram textura
+    unsigned evictions() const { return evictions_; }
+
+    /// "6.1M/16M, 3 evicted: panels 2.4M, retained 1.9M, text 180K, free 900K"
+    std::string usageLine() const;
+
+private:
+    struct Entry {
+        SDL_Renderer* renderer;
+        SDL_Texture* texture;
+        int w, h;
+        unsigned stamp;    // Ordem de devolução (LRU)
+        TextureUse use;
+        bool pooled;       // Saiu de acquire(): volta para free_
+        bool lost;         // Device perdido: release() destroi
+    };
+    // Todos os formatos usados aqui são de 32 bits
+    static size_t bytesOf(const Entry& e) { return (size_t)e.w * (size_t)e.h * 4; }
+    void track(const Entry& entry);
+    void dropOldestFree();
+    void trim();
+    /// Despeja até caber mais `bytes` no teto (ou não sobrar o que despejar)
+    void makeRoom(size_t bytes);
+
+    std::vector<Entry> free_;
+    std::vector<Entry> live_;
+    std::vector<TextureEvictor*> evictors_;
+    size_t budget_ = DEFAULT_BUDGET;
+    size_t vramBudget_ = 0;
+    size_t freeBytes_ = 0;
+    size_t liveBytes_ = 0;
+    size_t useBytes_[(int)TextureUse::COUNT] = {};
+    unsigned clock_ = 0;
+    unsigned hits_ = 0;
+    unsigned misses_ = 0;
+    unsigned evictions_ = 0;
+    Uint32 frame_ = 1;
+    bool overBudget_ = false;     // Já avisou do estouro atual
+    Uint32 targetsEpoch_ = 0;
+    Uint32 deviceEpoch_ = 0;
+};
+
+/// Pool do processo (um renderer por vez, mais os do RENDER_PROBE)
+TexturePool& renderTargetPool();
@@ -30,9 +30,24 @@ private:
     mutable Uint32 lastBlinkTime_;
     mutable bool blinkState_;
     
+    // Caixa + MM:SS retidos numa render target; refeitos só quando
+    // TimerSystem::getVersion(), o piscar ou o tamanho/escala mudam
+    SDL_Texture* boxTexture_ = nullptr;
+    const TimerSystem* cachedTimer_ = nullptr;
+    Uint32 cachedVersion_ = 0;
+    bool cachedBlink_ = false;
+    int cachedW_ = 0, cachedH_ = 0;
+    Uint32 boxEpoch_ = 0;   // TexturePool::targetsEpoch() da caixa
+    float cachedScaleX_ = 0.0f, cachedScaleY_ = 0.0f;
+    int cachedRadiusX_ = 0, cachedRadiusY_ = 0;
+    bool textureFailed_ = false;
+    
     void updateTextTexture(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout) const;
-    void renderBackground(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout) const;
-    void renderText(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout) const;
+    // rect = caixa já em coordenadas do alvo atual (janela ou boxTexture_)
+    void renderBackground(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout, const SDL_Rect& rect) const;
+    void renderText(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout, const SDL_Rect& rect) const;
+    // boxTexture_ válida e atualizada para rect; false = desenhar em modo imediato
+    bool prepareBox(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout, const SDL_Rect& rect);
     void renderProgressBar(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout) const;
     
     // Conversão de coordenadas virtuais para físicas
@@ -49,6 +64,10 @@ public:
     void render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) override;
     std::string getName() const override { return "Timer"; }
     int getZOrder() const override { return Z_ORDER; }
+    bool isAnimated(const GameState& state) const override;   // Pisca no estado crítico
+    
+    /** @brief Força o redesenho da caixa (ex.: SDL_RENDER_TARGETS_RESET) */
+    void invalidate() { cachedTimer_ = nullptr; }
     
     // Cleanup
     void cleanup();
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "audio/SpscRing.hpp"
+
+/**
+ * @brief Gravação de gameplay em vídeo (CAPTURE_VIDEO)
+ *
+ * Cada frame é desenhado numa das DELAY+1 texturas alvo do anel e copiado
+ * para a tela; a leitura (SDL_RenderReadPixels) é do frame de DELAY frames
+ * atrás, que a GPU já terminou, então o pipeline não para esperando o frame
+ * atual. Os pixels vão para um buffer do pool (tamanho limitado por
+ * CAPTURE_BUDGET_MB) e uma thread converte para YUV 4:2:0 e grava Y4M cru ou,
+ * com ffmpeg no PATH e extensão diferente de .y4m, manda pelo pipe para ele.
+ *
+ * Sem buffer livre o frame é descartado e contado; o próximo que sai repete o
+ * anterior no lugar dos perdidos, para o vídeo não ficar acelerado.
+ */
+class VideoCapture {
+public:
+    static constexpr int MAX_DELAY = 8;
+    static constexpr int MAX_BUFFERS = 64;
+
+    VideoCapture() = default;
+    ~VideoCapture() { stop(); }
+    VideoCapture(const VideoCapture&) = delete;
+    VideoCapture& operator=(const VideoCapture&) = delete;
+
+    bool start(const std::string& path, int fps, int delayFrames, size_t budgetBytes);
+    /// Lê o que ainda está no anel, espera o encoder e fecha o arquivo
+    void stop(SDL_Renderer* renderer = nullptr);
+    bool isRunning() const { return thread_ != nullptr; }
+
+    /// Antes do draw: lê o frame de DELAY atrás e aponta o render para a textura da vez
+    void beginFrame(SDL_Renderer* renderer);
+    /// Depois do draw (overlay incluso): volta para a tela e copia o frame para ela
+    void endFrame(SDL_Renderer* renderer);
+
+    uint32_t framesWritten() const { return written_.load(std::memory_order_relaxed); }
+    uint32_t framesDropped() const { return dropped_; }
+    size_t bytesInFlight() const { return frameBytes_ * (size_t)inFlight_.load(std::memory_order_relaxed); }
+    size_t budgetBytes() const { return budget_; }
+    /// "N frames, M dropped, X/Y MB" para o overlay de debug
+    std::string statusLine() const;
+
+private:
+    struct Buffer {
+        std::vector<uint8_t> pixels;   // ARGB8888, pitch = w * 4
+        int w = 0, h = 0;
+        uint32_t repeatBefore = 0;     // Frames perdidos antes deste
+    };
+
+    bool ensureTargets(SDL_Renderer* renderer);
+    void destroyTargets();
+    void readBack(SDL_Renderer* renderer, int slot);
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    bool openOutput();
+    void writeFrame(const Buffer& buffer);
+
+    // Thread do render
+    std::vector<SDL_Texture*> targets_;
+    int w_ = 0, h_ = 0;
+    Uint32 epoch_ = 0;   // TexturePool::deviceEpoch() do anel
+    int delay_ = 2;
+    uint64_t frame_ = 0;              // Frames desenhados desde o último resize
+    int slot_ = -1;                   // Textura do frame atual
+    SDL_Texture* prevTarget_ = nullptr;
+    uint32_t dropped_ = 0;
+    uint32_t pendingRepeat_ = 0;
+    std::vector<int> free_;           // Buffers livres (devolvidos pelo encoder via returned_)
+
+    // Compartilhado
+    std::vector<Buffer> buffers_;
+    size_t frameBytes_ = 0;
+    size_t budget_ = 0;
+    SpscRing<int, 64> queue_;         // Render -> encoder
+    SpscRing<int, 64> returned_;      // Encoder -> render
+    std::atomic<int> inFlight_{0};
+    std::atomic<uint32_t> written_{0};
+    SDL_sem* wake_ = nullptr;
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+
+    // Só o encoder
+    std::string path_;
+    int fps_ = 60;
+    int outW_ = 0, outH_ = 0;         // Pares (4:2:0)
+    FILE* out_ = nullptr;
+    bool pipe_ = false;
+    std::atomic<bool> failed_{false};   // Escrito pelo encoder, lido no beginFrame()
+    std::vector<uint8_t> yuv_;
+};
@@ -3,6 +3,7 @@
 #include <SDL2/SDL.h>
 #include <string>
 #include "ConfigTypes.hpp"
+#include "app/GameClock.hpp"
 
 /**
  * @brief Sistema de countdown timer para modo kiosk
@@ -25,12 +26,16 @@ private:
     Uint32 startTime_;          // Tempo de início
     Uint32 pausedTime_;         // Tempo pausado acumulado
     Uint32 pauseStartTime_;     // Momento em que pausou (para calcular duração do pause)
-    Uint32 lastUpdateTime_;     // Último tempo de atualização
+    Uint32 nextChangeMs_;       // Próxima virada de segundo (nada visível muda antes)
+    Uint32 version_ = 1;        // Sobe quando algo que o TimerRenderLayer mostra muda
     Uint32 gamePauseStartTime_; // Tempo quando o jogo foi pausado
     bool gameWasPaused_;        // Flag para rastrear se o jogo estava pausado
     int remainingSeconds_;      // Segundos restantes (cache)
     bool wasWarning_;           // Flag para detectar mudança de estado
     bool wasCritical_;          // Flag para detectar mudança de estado
+    const IGameClock* clock_ = &systemClock();
+    
+    Uint32 now() const { return clock_->nowMs(); }
     
     void updateRemainingTime();
     
@@ -63,11 +68,24 @@ public:
     float getProgress() const; // 0.0 (início) a 1.0 (fim)
     std::string getFormattedTime() const; // Format MM:SS
     
+    /**
+     * @brief Versão do que aparece na caixa (MM:SS, cor, estado, config)
+     *
+     * Igual = mesma caixa e mesmos dígitos; o TimerRenderLayer reaproveita a
+     * textura e só refaz a barra de progresso.
+     */
+    Uint32 getVersion() const { return version_; }
+    /// Ms até a próxima mudança visível (0 = já; sem contagem rodando, -1)
+    int msUntilChange() const;
+    
     // Estados visuais
     bool isWarning() const;     // ≤ 30 segundos
     bool isCritical() const;    // ≤ 10 segundos
     RGB getCurrentColor() const;
     
+    // Fonte de tempo (padrão: SDL_GetTicks)
+    void setClock(const IGameClock* clock) { clock_ = clock ? clock : &systemClock(); }
+    
     // Configuração
     void setConfig(const TimerConfig& config);
     const TimerConfig& getConfig() const { return config_; }
@@ -76,7 +94,19 @@ public:
     
     // Layout
     const ElementLayout& getLayout() const { return config_.layout; }
-    void setLayout(const ElementLayout& layout) { config_.layout = layout; }
+    void setLayout(const ElementLayout& layout) { config_.layout = layout; ++version_; }
+    
+    // Réplica só para exibição (render lendo um GameSnapshot): copia o estado visível
+    void setDisplayState(bool enabled, State state, int remainingSeconds) {
+        if (enabled != config_.enabled || state != state_ || remainingSeconds != remainingSeconds_) ++version_;
+        config_.enabled = enabled;
+        state_ = state;
+        remainingSeconds_ = remainingSeconds;
+    }
+    
+    // Retomada (GameSnapshot): tempo corrido sem pausas e volta a ele neste relógio
+    Uint32 getElapsedMs() const;
+    void restoreElapsed(bool enabled, State state, Uint32 elapsedMs);
     
     // Update (deve ser chamado no game loop)
     void update();
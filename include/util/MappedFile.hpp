@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Arquivo inteiro em memória, só leitura: mmap quando dá, leitura comum senão
+ *
+ * data() == nullptr = arquivo ausente ou vazio. Os bytes valem enquanto o
+ * objeto existir.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    void* map_ = nullptr;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::string copy_;
+};
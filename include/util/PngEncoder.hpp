@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief PNG RGB 8 bits sem dependência (screenshots)
+ *
+ * Filtro por linha (None/Sub/Up, o de menor soma) e deflate com Huffman fixo
+ * e LZ77 guloso numa janela de 32 KB. Não compete com o zlib em tamanho, mas
+ * telas de jogo (cores chapadas, linhas repetidas) ficam bem menores que o BMP.
+ */
+namespace PngEncoder {
+
+/// rgb: h linhas de w*3 bytes separadas por pitch; out recebe o arquivo inteiro
+bool encodeRgb(const uint8_t* rgb, int w, int h, int pitch, std::vector<uint8_t>& out);
+
+} // namespace PngEncoder
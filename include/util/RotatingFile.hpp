@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+/**
+ * @brief Arquivo de texto em append com rotação por tamanho
+ *
+ * Passou de maxBytes: path.N some, path.(i) vira path.(i+1), path vira
+ * path.1 e um path novo começa vazio. Sem lock: quem usa serializa.
+ */
+class RotatingFile {
+public:
+    ~RotatingFile() { close(); }
+
+    /// keepFiles = quantos antigos manter (0 = só trunca); maxBytes 0 = nunca roda
+    bool open(const std::string& path, size_t maxBytes, int keepFiles);
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+
+    void write(const char* data, size_t length);
+    void flush() { if (file_) std::fflush(file_); }
+
+private:
+    void rotate();
+
+    FILE* file_ = nullptr;
+    std::string path_;
+    size_t bytes_ = 0;
+    size_t maxBytes_ = 0;
+    int keep_ = 0;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "audio/SpscRing.hpp"
+
+/**
+ * @brief Screenshot (F12) sem travar o jogo
+ *
+ * capture() roda na thread do render, entre o último draw e o Present: só
+ * faz o SDL_RenderReadPixels para um dos POOL_FRAMES buffers do pool
+ * (alocados uma vez e reaproveitados) e entrega o índice a uma thread que
+ * codifica em PNG e grava. Com os dois buffers ocupados o pedido é descartado.
+ *
+ * A thread do jogo chama takeCompleted() a cada tick (GameState::handleInput)
+ * e toca o beep de confirmação quando um arquivo terminou de ser gravado.
+ */
+class ScreenshotWriter {
+public:
+    static constexpr int POOL_FRAMES = 2;
+
+    ScreenshotWriter() = default;
+    ~ScreenshotWriter() { stop(); }
+    ScreenshotWriter(const ScreenshotWriter&) = delete;
+    ScreenshotWriter& operator=(const ScreenshotWriter&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const { return thread_ != nullptr; }
+
+    /// Thread do render: lê o back buffer atual; false se o pool está cheio ou a leitura falhou
+    bool capture(SDL_Renderer* renderer);
+    /// Thread do jogo: arquivos gravados desde a última chamada
+    int takeCompleted() { return completed_.exchange(0, std::memory_order_acq_rel); }
+
+private:
+    struct Frame {
+        std::vector<uint8_t> pixels;   // RGB24, pitch = w * 3
+        int w = 0;
+        int h = 0;
+        std::string path;
+        std::atomic<bool> busy{false};
+    };
+
+    static int SDLCALL threadMain(void* self);
+    void loop();
+    void write(Frame& frame);
+
+    Frame frames_[POOL_FRAMES];
+    SpscRing<int, 4> queue_;          // Render -> worker
+    SDL_sem* wake_ = nullptr;
+    SDL_Thread* thread_ = nullptr;
+    std::atomic<bool> quit_{false};
+    std::atomic<int> completed_{0};
+    std::vector<uint8_t> png_;        // Só o worker
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Conexão TCP não bloqueante (BSD sockets / Winsock)
+ *
+ * connect() bloqueia só durante a conexão; depois tudo é não bloqueante:
+ * send() aceita o que couber no buffer do kernel e devolve quantos bytes foram,
+ * receive() devolve 0 quando não há nada. Quem chama guarda o resto e tenta
+ * de novo (o espectador nunca segura o jogo por causa da rede).
+ */
+class TcpSocket {
+public:
+    TcpSocket() = default;
+    ~TcpSocket() { close(); }
+    TcpSocket(const TcpSocket&) = delete;
+    TcpSocket& operator=(const TcpSocket&) = delete;
+
+    /// Resolve e conecta (espera até timeoutMs)
+    bool connect(const std::string& host, int port, int timeoutMs = 3000);
+    /// Assume um socket já conectado (TcpListener::accept)
+    void adopt(intptr_t fd);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    /// Bytes aceitos (0 = buffer do kernel cheio), -1 = conexão caiu
+    int send(const void* data, size_t length);
+    /// Bytes lidos, 0 = nada agora, -1 = conexão fechada ou erro
+    int receive(void* buffer, size_t capacity);
+    /// Espera até timeoutMs por dados para ler; false = acabou o tempo
+    bool waitReadable(int timeoutMs);
+
+private:
+    intptr_t fd_ = -1;   // SOCKET no Windows, fd no resto
+};
+
+/**
+ * @brief Socket de escuta TCP (todas as interfaces), aceita sem bloquear
+ */
+class TcpListener {
+public:
+    TcpListener() = default;
+    ~TcpListener() { close(); }
+    TcpListener(const TcpListener&) = delete;
+    TcpListener& operator=(const TcpListener&) = delete;
+
+    bool listen(int port);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    /// Conexão pendente (já não bloqueante) ou -1
+    intptr_t accept();
+    /// Espera até timeoutMs por uma conexão pendente
+    bool waitPending(int timeoutMs);
+
+private:
+    intptr_t fd_ = -1;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Socket UDP para um destino fixo (BSD sockets / Winsock)
+ *
+ * Não bloqueia: se o kernel não aceitar o datagrama agora, send() devolve
+ * false e o pacote se perde; quem precisa de entrega (netplay) reenvia.
+ * Com localPort o socket também escuta nessa porta e receive() lê só o que
+ * vier do destino conectado.
+ */
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket() { close(); }
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    /// Resolve host:port e conecta o socket (UDP: só fixa o destino); localPort > 0 faz bind antes
+    bool open(const std::string& host, int port, int localPort = 0);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    bool send(const void* data, size_t length);
+    /// Próximo datagrama (bytes lidos); 0 = nada na fila, -1 = erro (porta do outro lado fechada etc.)
+    int receive(void* buffer, size_t capacity);
+    /// Espera até timeoutMs por um datagrama para ler; false = acabou o tempo
+    bool waitReadable(int timeoutMs);
+
+private:
+    intptr_t fd_ = -1;   // SOCKET no Windows, fd no resto
+};
@@ -4,5 +4,9 @@ struct SDL_Renderer;
 
 std::string fmtScore(int value);
 bool saveScreenshot(SDL_Renderer* renderer, const char* path);
+// dropblocks-screenshot_<data>_<hora>.<ext> no diretório atual
+std::string timestampedScreenshotName(const char* ext);
+// Síncrono (BMP); o jogo usa o ScreenshotWriter
+bool saveTimestampedScreenshot(SDL_Renderer* renderer);
 
 
@@ -1,28 +1,211 @@
 #include "../include/DebugLogger.hpp"
+#include "util/RotatingFile.hpp"
+#include <SDL2/SDL.h>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 static bool g_debug_enabled = true;
 static int g_debug_level = DebugLogger::DEBUG;
 
-void DebugLogger::setEnabled(bool enabled) { g_debug_enabled = enabled; }
-void DebugLogger::setLevel(int level) { g_debug_level = level; }
+namespace {
 
-static void logImpl(DebugLogger::Level level, const std::string& message) {
-    if (!g_debug_enabled || level > g_debug_level) return;
-    const char* prefix = "";
+const char* levelName(int level) {
     switch (level) {
-        case DebugLogger::ERROR:   prefix = "ERROR"; break;
-        case DebugLogger::WARNING: prefix = "WARNING"; break;
-        case DebugLogger::INFO:    prefix = "INFO"; break;
-        case DebugLogger::DEBUG:   prefix = "DEBUG"; break;
+        case DebugLogger::ERROR:   return "ERROR";
+        case DebugLogger::WARNING: return "WARNING";
+        case DebugLogger::INFO:    return "INFO";
+        case DebugLogger::DEBUG:   return "DEBUG";
     }
-    std::printf("[%s] %s\n", prefix, message.c_str());
+    return "";
+}
+
+// Anel MPMC de tamanho fixo (Vyukov): seq diz de quem é o slot. Produtor
+// vê seq == pos e reserva com CAS; o único consumidor vê seq == pos + 1.
+struct Record {
+    std::atomic<size_t> seq{0};
+    int level = 0;
+    size_t length = 0;
+    bool truncated = false;
+    char text[DebugLogger::TEXT_MAX];
+};
+
+Record g_ring[DebugLogger::RING_SIZE];
+std::atomic<size_t> g_head{0};
+size_t g_tail = 0;                          // só a thread de escrita
+std::atomic<unsigned> g_dropped{0};
+std::atomic<bool> g_async{false};
+std::atomic<bool> g_quit{false};
+std::atomic<bool> g_wakePending{false};     // um SemPost por lote, não por mensagem
+SDL_Thread* g_writer = nullptr;
+SDL_sem* g_wake = nullptr;
+
+// Arquivo opcional; o mutex só é disputado entre a escrita e setLogFile()
+SDL_mutex* g_fileMutex = nullptr;
+RotatingFile g_file;
+
+void initRing() {
+    for (size_t i = 0; i < DebugLogger::RING_SIZE; ++i) g_ring[i].seq.store(i, std::memory_order_relaxed);
+}
+
+bool enqueue(int level, const char* message, size_t length) {
+    size_t pos = g_head.load(std::memory_order_relaxed);
+    for (;;) {
+        Record& r = g_ring[pos & (DebugLogger::RING_SIZE - 1)];
+        size_t seq = r.seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (g_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                r.level = level;
+                r.length = length < DebugLogger::TEXT_MAX ? length : DebugLogger::TEXT_MAX;
+                r.truncated = r.length < length;
+                std::memcpy(r.text, message, r.length);
+                r.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Cheio: a escrita não acompanhou
+        } else {
+            pos = g_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Uma linha no stdout e no arquivo; o flush fica com quem chama
+void emit(int level, const char* text, size_t length, bool truncated) {
+    const char* prefix = levelName(level);
+    const char* cut = truncated ? "..." : "";
+    char line[DebugLogger::TEXT_MAX + 24];
+    int n = std::snprintf(line, sizeof(line), "[%s] %.*s%s\n", prefix, (int)length, text, cut);
+    if (n <= 0) return;
+    size_t len = (size_t)n < sizeof(line) ? (size_t)n : sizeof(line) - 1;
+    std::fwrite(line, 1, len, stdout);
+    if (!g_fileMutex) return;
+    SDL_LockMutex(g_fileMutex);
+    g_file.write(line, len);
+    SDL_UnlockMutex(g_fileMutex);
+}
+
+void flushOutputs() {
     std::fflush(stdout);
+    if (!g_fileMutex) return;
+    SDL_LockMutex(g_fileMutex);
+    g_file.flush();
+    SDL_UnlockMutex(g_fileMutex);
 }
 
-void DebugLogger::error(const std::string& message)   { logImpl(ERROR,   message); }
-void DebugLogger::warning(const std::string& message) { logImpl(WARNING, message); }
-void DebugLogger::info(const std::string& message)    { logImpl(INFO,    message); }
-void DebugLogger::debug(const std::string& message)   { logImpl(DEBUG,   message); }
+// Escreve tudo o que já foi publicado; false se o anel estava vazio
+bool drain() {
+    bool any = false;
+    for (;;) {
+        Record& r = g_ring[g_tail & (DebugLogger::RING_SIZE - 1)];
+        if (r.seq.load(std::memory_order_acquire) != g_tail + 1) break;
+        emit(r.level, r.text, r.length, r.truncated);
+        r.seq.store(g_tail + DebugLogger::RING_SIZE, std::memory_order_release);
+        ++g_tail;
+        any = true;
+    }
+    unsigned dropped = g_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped) {
+        std::string msg = std::to_string(dropped) + " log message(s) dropped (ring full)";
+        emit(DebugLogger::WARNING, msg.data(), msg.size(), false);
+        any = true;
+    }
+    if (any) flushOutputs();
+    return any;
+}
+
+int SDLCALL writerMain(void*) {
+    while (!g_quit.load(std::memory_order_acquire)) {
+        SDL_SemWaitTimeout(g_wake, 100);
+        g_wakePending.store(false, std::memory_order_release);
+        drain();
+    }
+    drain();
+    return 0;
+}
 
+} // namespace
 
+void DebugLogger::setEnabled(bool enabled) {
+    g_debug_enabled = enabled;
+    threshold_.store(g_debug_enabled ? g_debug_level : -1, std::memory_order_relaxed);
+}
+
+void DebugLogger::setLevel(int level) {
+    g_debug_level = level;
+    threshold_.store(g_debug_enabled ? g_debug_level : -1, std::memory_order_relaxed);
+}
+
+bool DebugLogger::parseLevel(const std::string& name, int& level) {
+    for (int l = ERROR; l <= DEBUG; ++l) {
+        if (name == levelName(l) || name == std::to_string(l)) { level = l; return true; }
+    }
+    return false;
+}
+
+void DebugLogger::write(Level level, const char* message, size_t length) {
+    if (!isEnabled(level)) return;
+    if (g_async.load(std::memory_order_acquire)) {
+        if (!enqueue(level, message, length)) {
+            if (level != ERROR) { g_dropped.fetch_add(1, std::memory_order_relaxed); return; }
+            emit(level, message, length < TEXT_MAX ? length : TEXT_MAX, length > TEXT_MAX);  // Erro não se perde: direto, fora de ordem
+            flushOutputs();
+            return;
+        }
+        // Erro acorda na hora; o resto espera o lote (ou o timeout da thread)
+        if (level == ERROR || !g_wakePending.exchange(true, std::memory_order_acq_rel)) SDL_SemPost(g_wake);
+        return;
+    }
+    emit(level, message, length < TEXT_MAX ? length : TEXT_MAX, length > TEXT_MAX);
+    flushOutputs();
+}
+
+void DebugLogger::error(const std::string& message)   { write(ERROR,   message.data(), message.size()); }
+void DebugLogger::warning(const std::string& message) { write(WARNING, message.data(), message.size()); }
+void DebugLogger::info(const std::string& message)    { write(INFO,    message.data(), message.size()); }
+void DebugLogger::debug(const std::string& message)   { write(DEBUG,   message.data(), message.size()); }
+
+bool DebugLogger::startAsync() {
+    if (g_writer) return true;
+    static bool registered = false;
+    if (!g_wake) g_wake = SDL_CreateSemaphore(0);
+    if (!g_fileMutex) g_fileMutex = SDL_CreateMutex();
+    if (!g_wake || !g_fileMutex) return false;
+    initRing();
+    g_head.store(0, std::memory_order_relaxed);
+    g_tail = 0;
+    g_quit.store(false, std::memory_order_release);
+    g_writer = SDL_CreateThread(&writerMain, "dropblocks-log", nullptr);
+    if (!g_writer) {
+        error(std::string("Log thread unavailable, logging synchronously: ") + SDL_GetError());
+        return false;
+    }
+    g_async.store(true, std::memory_order_release);
+    if (!registered) { std::atexit(&DebugLogger::shutdown); registered = true; }
+    return true;
+}
+
+void DebugLogger::shutdown() {
+    if (!g_writer) return;
+    g_async.store(false, std::memory_order_release);  // Quem logar daqui em diante escreve direto
+    g_quit.store(true, std::memory_order_release);
+    SDL_SemPost(g_wake);
+    SDL_WaitThread(g_writer, nullptr);
+    g_writer = nullptr;
+    SDL_LockMutex(g_fileMutex);
+    g_file.close();
+    SDL_UnlockMutex(g_fileMutex);
+}
+
+bool DebugLogger::setLogFile(const std::string& path, size_t maxBytes, int keepFiles) {
+    if (!g_fileMutex) g_fileMutex = SDL_CreateMutex();
+    if (!g_fileMutex) return false;
+    SDL_LockMutex(g_fileMutex);
+    g_file.close();
+    bool ok = path.empty() || g_file.open(path, maxBytes, keepFiles);
+    SDL_UnlockMutex(g_fileMutex);
+    if (!ok) warning("Cannot open log file: " + path);
+    return ok;
+}
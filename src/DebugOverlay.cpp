@@ -1,10 +1,25 @@
 #include "DebugOverlay.hpp"
 #include "render/Primitives.hpp"
+#include "app/FrameProfiler.hpp"
+#include "app/LatencyProbe.hpp"
+#include "app/StartupTimings.hpp"
+#include "app/AllocCounter.hpp"
+#include "app/FrameArena.hpp"
+#include <algorithm>
 #include <cmath>
-#include <sstream>
-#include <iomanip>
 #include <vector>
 
+void DebugOverlay::toggle() {
+    if (!enabled_) {
+        enabled_ = true;
+        page_ = Page::INFO;
+    } else if (page_ == Page::INFO && profiler_) {
+        page_ = Page::PERF;
+    } else {
+        enabled_ = false;
+    }
+}
+
 void DebugOverlay::update(float deltaMs) {
     // Store frame time sample
     frameSamples_[sampleIndex_] = deltaMs;
@@ -34,7 +49,7 @@ void DebugOverlay::render(SDL_Renderer* renderer, int screenWidth, int screenHei
     int virtualAreaH = (int)(virtualH_ * scaleY_);
     
     // Debug overlay dimensions
-    int debugWidth = 240;
+    int debugWidth = (page_ == Page::PERF && profiler_) ? PERF_WIDTH : 240;
     int debugMargin = 10;
     
     // Position relative to virtual area, with margin from edges
@@ -45,10 +60,15 @@ void DebugOverlay::render(SDL_Renderer* renderer, int screenWidth, int screenHei
     int lineHeight = 30;
     int scale = 2;
     
+    if (page_ == Page::PERF && profiler_) {
+        renderPerfPage(renderer, x, y);
+        return;
+    }
+    
     // Semi-transparent background (increased height for layout and config info)
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
-    SDL_Rect bg = {x - 10, y - 5, 240, 450};
+    SDL_Rect bg = {x - 10, y - 5, 240, allocs_ ? 720 : 660};
     SDL_RenderFillRect(renderer, &bg);
     
     // Border
@@ -59,30 +79,71 @@ void DebugOverlay::render(SDL_Renderer* renderer, int screenWidth, int screenHei
     drawPixelText(renderer, x, y, "DEBUG INFO", scale, 100, 255, 100);
     y += lineHeight;
     
+    // Linhas formatadas na arena do frame: nada aqui vai ao heap
+    FrameArena& arena = frameArena();
+    
     // FPS
     {
-        std::ostringstream oss;
-        oss << "FPS: " << std::fixed << std::setprecision(1) << fps_;
         Uint8 color = fps_ >= 58.0f ? 100 : (fps_ >= 30.0f ? 255 : 255);
         Uint8 g = fps_ >= 58.0f ? 255 : (fps_ >= 30.0f ? 200 : 100);
-        drawPixelText(renderer, x, y, oss.str(), scale, color, g, 100);
+        drawPixelText(renderer, x, y, arena.format("FPS: %.1f", fps_), scale, color, g, 100);
     }
     y += lineHeight;
     
     // Frame Time
     {
-        std::ostringstream oss;
-        oss << "Frame: " << std::fixed << std::setprecision(2) << frameTimeMs_ << "ms";
         Uint8 color = frameTimeMs_ <= 16.7f ? 100 : (frameTimeMs_ <= 33.0f ? 255 : 255);
         Uint8 g = frameTimeMs_ <= 16.7f ? 255 : (frameTimeMs_ <= 33.0f ? 200 : 100);
-        drawPixelText(renderer, x, y, oss.str(), scale, color, g, 100);
+        drawPixelText(renderer, x, y, arena.format("Frame: %.2fms", frameTimeMs_), scale, color, g, 100);
     }
     y += lineHeight;
     
     // Target frame time reference (split into 2 lines to avoid overflow)
-    drawPixelText(renderer, x, y, "Target: 16.67ms", scale, 150, 150, 150);
+    drawPixelText(renderer, x, y, arena.format("Target: %.2fms", targetFps_ > 0 ? 1000.0 / targetFps_ : 0.0),
+                  scale, 150, 150, 150);
+    y += lineHeight;
+    drawPixelText(renderer, x, y, arena.format("        %d FPS %s", targetFps_, pacing_.c_str()), scale, 150, 150, 150);
+    y += lineHeight;
+    
+    // Frame scheduler breakdown
+    drawPixelText(renderer, x, y, arena.format("Sim: %.3fms x%d", simMs_, simSteps_), scale, 200, 200, 200);
+    y += lineHeight;
+    drawPixelText(renderer, x, y, arena.format("Rend: %.3fms", renderMs_), scale, 200, 200, 200);
+    y += lineHeight;
+    drawPixelText(renderer, x, y, arena.format("Wait: %.3fms", waitMs_), scale, 200, 200, 200);
+    y += lineHeight;
+    
+    // Audio command queue (overflow = comandos descartados)
+    drawPixelText(renderer, x, y, arena.format("Aud: %dV Q:%d-%d", audioVoices_, audioQueued_, audioHighWater_),
+                  scale, 200, 200, 200);
     y += lineHeight;
-    drawPixelText(renderer, x, y, "        (60 FPS)", scale, 150, 150, 150);
+    {
+        bool nearFull = audioCapacity_ > 0 && audioHighWater_ * 4 >= audioCapacity_ * 3;
+        Uint8 g = (audioOverflows_ > 0 || nearFull) ? 100 : 200;
+        drawPixelText(renderer, x, y, arena.format("     OVF: %u", audioOverflows_), scale, 255, g, g);
+    }
+    y += lineHeight;
+    
+    // Heap por frame (sem o próprio overlay): o alvo em jogo é zero
+    if (allocs_) {
+        const AllocCounter::Counts& f = allocs_->last();
+        const bool clean = f.allocs == 0;
+        drawPixelText(renderer, x, y, arena.format("Alloc: %llu %lluB", (unsigned long long)f.allocs, (unsigned long long)f.bytes),
+                      scale, clean ? 100 : 255, clean ? 255 : 100, 100);
+        y += lineHeight;
+        drawPixelText(renderer, x, y, arena.format("  all:%llu pk:%llu", (unsigned long long)allocs_->lastProcess().allocs,
+                                                   (unsigned long long)allocs_->peakAllocs()),
+                      scale, 200, 200, 200);
+        y += lineHeight;
+    }
+    
+    // Arena do frame: pico para dimensionar FRAME_ARENA_KB (amarelo se já estourou)
+    {
+        const bool spilled = arena.overflows() > 0;
+        drawPixelText(renderer, x, y, arena.format("Arena: %zuK/%zuK hw:%zuK", arena.used() >> 10, arena.capacity() >> 10,
+                                                   arena.highWater() >> 10),
+                      scale, spilled ? 255 : 200, 200, spilled ? 100 : 200);
+    }
     y += lineHeight;
     
     // Layout information
@@ -91,47 +152,33 @@ void DebugOverlay::render(SDL_Renderer* renderer, int screenWidth, int screenHei
         drawPixelText(renderer, x, y, "LAYOUT:", scale, 255, 200, 100);
         y += lineHeight;
         
-        {
-            std::ostringstream oss;
-            oss << "Virt: " << virtualW_ << "x" << virtualH_;
-            drawPixelText(renderer, x, y, oss.str(), scale, 200, 200, 200);
-        }
+        drawPixelText(renderer, x, y, arena.format("Virt: %dx%d", virtualW_, virtualH_), scale, 200, 200, 200);
         y += lineHeight;
         
         {
-            std::ostringstream oss;
-            oss << "Phys: " << physicalW_ << "x" << physicalH_;
             // Highlight if different
             Uint8 r = (physicalW_ == virtualW_ && physicalH_ == virtualH_) ? 200 : 255;
             Uint8 g = (physicalW_ == virtualW_ && physicalH_ == virtualH_) ? 200 : 100;
-            drawPixelText(renderer, x, y, oss.str(), scale, r, g, 100);
+            drawPixelText(renderer, x, y, arena.format("Phys: %dx%d", physicalW_, physicalH_), scale, r, g, 100);
         }
         y += lineHeight;
         
-        {
-            std::ostringstream oss;
-            oss << "Mode: " << scaleMode_;
-            drawPixelText(renderer, x, y, oss.str(), scale, 200, 200, 200);
-        }
+        drawPixelText(renderer, x, y, arena.format("Mode: %s", scaleMode_.c_str()), scale, 200, 200, 200);
         y += lineHeight;
         
         {
-            std::ostringstream oss;
-            oss << "Scl: " << std::fixed << std::setprecision(3) << scaleX_ << "," << scaleY_;
             // Highlight if scale is not 1:1
             Uint8 r = (scaleX_ == 1.0f && scaleY_ == 1.0f) ? 200 : 255;
             Uint8 g = (scaleX_ == 1.0f && scaleY_ == 1.0f) ? 200 : 100;
-            drawPixelText(renderer, x, y, oss.str(), scale, r, g, 100);
+            drawPixelText(renderer, x, y, arena.format("Scl: %.3f,%.3f", scaleX_, scaleY_), scale, r, g, 100);
         }
         y += lineHeight;
         
         {
-            std::ostringstream oss;
-            oss << "Off: " << offsetX_ << "," << offsetY_;
             // Highlight if offset is not 0,0
             Uint8 r = (offsetX_ == 0 && offsetY_ == 0) ? 200 : 255;
             Uint8 g = (offsetX_ == 0 && offsetY_ == 0) ? 200 : 100;
-            drawPixelText(renderer, x, y, oss.str(), scale, r, g, 100);
+            drawPixelText(renderer, x, y, arena.format("Off: %d,%d", offsetX_, offsetY_), scale, r, g, 100);
         }
         y += lineHeight;
     }
@@ -146,30 +193,141 @@ void DebugOverlay::render(SDL_Renderer* renderer, int screenWidth, int screenHei
     
     // Custom values
     if (!customName1_.empty()) {
-        std::string line = customName1_ + ": " + customValue1_;
-        drawPixelText(renderer, x, y, line, scale, 200, 200, 255);
+        drawPixelText(renderer, x, y, arena.format("%s: %s", customName1_.c_str(), customValue1_.c_str()), scale, 200, 200, 255);
         y += lineHeight;
     }
     
     if (!customName2_.empty()) {
-        std::string line = customName2_ + ": " + customValue2_;
-        drawPixelText(renderer, x, y, line, scale, 200, 200, 255);
+        drawPixelText(renderer, x, y, arena.format("%s: %s", customName2_.c_str(), customValue2_.c_str()), scale, 200, 200, 255);
+        y += lineHeight;
+    }
+}
+
+void DebugOverlay::renderPerfPage(SDL_Renderer* renderer, int x, int y) {
+    const int lineHeight = 24;
+    const int scale = 2;
+    const int rows = profiler_->sectionCount() + 1;  // + FRAME
+    const int graphH = 90;
+    const int bootRows = startup_ && !startup_->phases.empty() ? (int)startup_->phases.size() + 1 : 0;
+    const int latRows = latency_ ? 1 : 0;
+    const int bgH = 5 + lineHeight * (rows + latRows + 3) + graphH + 20 + (bootRows ? 10 + lineHeight * bootRows : 0);
+    
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_Rect bg = {x - 10, y - 5, PERF_WIDTH, bgH};
+    SDL_RenderFillRect(renderer, &bg);
+    SDL_SetRenderDrawColor(renderer, 100, 200, 100, 255);
+    SDL_RenderDrawRect(renderer, &bg);
+    
+    drawPixelText(renderer, x, y, profiler_->isCsvOpen() ? "PERF MS    CSV: ON" : "PERF MS", scale, 100, 255, 100);
+    y += lineHeight;
+    drawPixelText(renderer, x, y, "           MIN  AVG  P99  MAX", scale, 255, 200, 100);
+    y += lineHeight;
+    
+    // Colunas fixas: nome (10) + 4 valores de 5 caracteres
+    FrameArena& arena = frameArena();
+    auto row = [&](const char* name, const PhaseStats& s, Uint8 r, Uint8 g, Uint8 b) {
+        drawPixelText(renderer, x, y, arena.format("%-10.9s%4.2f %4.2f %4.2f %4.2f", name, s.minMs, s.avgMs, s.p99Ms, s.maxMs),
+                      scale, r, g, b);
+        y += lineHeight;
+    };
+    
+    const double budgetMs = targetFps_ > 0 ? 1000.0 / targetFps_ : 16.7;
+    PhaseStats frame = profiler_->frameStats();
+    bool overBudget = frame.p99Ms > budgetMs * 1.05;
+    row("FRAME", frame, 255, overBudget ? 120 : 255, overBudget ? 120 : 255);
+    for (int i = 0; i < profiler_->sectionCount(); ++i) {
+        row(profiler_->sectionName(i).c_str(), profiler_->sectionStats(i), 200, 200, 200);
+    }
+    
+    // Input -> Present: um evento por ação, então a janela anda devagar
+    if (latency_) {
+        PhaseStats lat = latency_->stats();
+        drawPixelText(renderer, x, y, arena.format("INPUT LAT P50 %.1f P99 %.1f N %u", lat.p50Ms, lat.p99Ms, (unsigned)latency_->samples()),
+                      scale, 150, 200, 255);
         y += lineHeight;
     }
+    
+    // Gráfico de frame time: escala = 2x o orçamento (ou o pico, se maior)
+    y += 10;
+    const RollingStat& hist = profiler_->frameHistory();
+    const int graphW = PERF_WIDTH - 20;
+    const double topMs = std::max(budgetMs * 2.0, frame.maxMs);
+    SDL_SetRenderDrawColor(renderer, 40, 40, 40, 200);
+    SDL_Rect graphBg = {x, y, graphW, graphH};
+    SDL_RenderFillRect(renderer, &graphBg);
+    
+    // Uma chamada por cor em vez de uma por barra (três faixas de WINDOW rects na arena)
+    SDL_Rect* bars[3];
+    bars[0] = arena.allocArray<SDL_Rect>(3 * RollingStat::WINDOW);
+    bars[1] = bars[0] + RollingStat::WINDOW;
+    bars[2] = bars[1] + RollingStat::WINDOW;
+    int barCount[3] = {0, 0, 0};
+    const int n = hist.count();
+    const float barW = (float)graphW / RollingStat::WINDOW;
+    for (int i = 0; i < n; ++i) {
+        double ms = hist.sample(i);
+        int h = (int)std::min<double>(graphH, ms / topMs * graphH);
+        int bucket = ms <= budgetMs * 1.05 ? 0 : (ms <= budgetMs * 2.0 ? 1 : 2);
+        int bx = x + (int)((RollingStat::WINDOW - n + i) * barW);
+        bars[bucket][barCount[bucket]++] = SDL_Rect{bx, y + graphH - h, std::max(1, (int)barW), h};
+    }
+    const Uint8 colors[3][3] = {{100, 220, 100}, {240, 200, 80}, {240, 90, 90}};
+    for (int c = 0; c < 3; ++c) {
+        if (barCount[c] == 0) continue;
+        SDL_SetRenderDrawColor(renderer, colors[c][0], colors[c][1], colors[c][2], 255);
+        SDL_RenderFillRects(renderer, bars[c], barCount[c]);
+    }
+    
+    // Linha do orçamento
+    int budgetY = y + graphH - (int)(budgetMs / topMs * graphH);
+    SDL_SetRenderDrawColor(renderer, 150, 150, 255, 255);
+    SDL_RenderDrawLine(renderer, x, budgetY, x + graphW - 1, budgetY);
+    
+    // Boot: fases da thread de carga em azul (correm junto com as outras)
+    if (bootRows) {
+        y += graphH + 10;
+        drawPixelText(renderer, x, y, arena.format("BOOT %.1f MS", startup_->totalMs), scale, 100, 255, 100);
+        y += lineHeight;
+        for (const StartupTimings::Phase& p : startup_->phases) {
+            drawPixelText(renderer, x, y, arena.format("%-18.17s%7.1f", p.name.c_str(), p.ms),
+                          scale, p.worker ? 150 : 200, 200, p.worker ? 255 : 200);
+            y += lineHeight;
+        }
+    }
 }
 
-void DebugOverlay::setCustomValue(const std::string& name, const std::string& value) {
+void DebugOverlay::setAudioStats(int voices, int queued, int capacity, int highWater, unsigned overflows) {
+    audioVoices_ = voices;
+    audioQueued_ = queued;
+    audioCapacity_ = capacity;
+    audioHighWater_ = highWater;
+    audioOverflows_ = overflows;
+}
+
+// assign() reaproveita a capacidade: o valor de todo frame não realoca
+void DebugOverlay::setCustomValue(std::string_view name, std::string_view value) {
     if (customName1_.empty()) {
-        customName1_ = name;
-        customValue1_ = value;
+        customName1_.assign(name);
+        customValue1_.assign(value);
     } else if (customName1_ == name) {
-        customValue1_ = value;
+        customValue1_.assign(value);
     } else {
-        customName2_ = name;
-        customValue2_ = value;
+        if (customName2_ != name) customName2_.assign(name);
+        customValue2_.assign(value);
     }
 }
 
+void DebugOverlay::setFrameTimings(double simMs, double renderMs, double waitMs, int steps,
+                                   const std::string& pacing, int targetFps) {
+    simMs_ = simMs;
+    renderMs_ = renderMs;
+    waitMs_ = waitMs;
+    simSteps_ = steps;
+    if (pacing_ != pacing) pacing_ = pacing;
+    targetFps_ = targetFps;
+}
+
 void DebugOverlay::setLayoutInfo(int virtualW, int virtualH, int physicalW, int physicalH,
                                   float scaleX, float scaleY, int offsetX, int offsetY,
                                   const std::string& scaleMode) {
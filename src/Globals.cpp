@@ -0,0 +1,68 @@
+// Globais do jogo, fora de dropblocks.cpp para que outros executáveis
+// (bench/) linkem os mesmos módulos de src/ sem o main() do jogo.
+
+#include <string>
+#include <vector>
+
+#include "ConfigTypes.hpp"
+#include "ThemeManager.hpp"
+#include "pieces/Piece.hpp"
+#include "pieces/PieceManager.hpp"
+#include "pieces/PieceTable.hpp"
+#include "render/GameStateBridge.hpp"
+
+// ===========================
+//   GLOBAL CONFIGURATION
+// ===========================
+// These globals are managed by ConfigManager and applied via ConfigApplicator.
+// They remain global for performance (avoiding indirection) and backward compatibility.
+// Future: Consider moving to a GlobalConfig singleton if more encapsulation is needed.
+
+// Layout parameters (synced from VisualConfig.layout via ConfigApplicator)
+int   ROUNDED_PANELS = 1;           // 1 = rounded; 0 = rectangle
+int   CACHED_PANELS  = 1;           // 1 = static panels from TextureCache; 0 = immediate
+int   CACHED_LAYERS  = 1;           // 1 = HUD layers retained in a RenderManager target; 0 = immediate
+int   HUD_FIXED_SCALE   = 6;        // Fixed HUD scale
+int   TEXT_OUTLINES     = 1;        // 0 = outlined text drawn fill-only (QualityGovernor tier 5)
+std::string TITLE_TEXT  = "__H A C K T R I S";  // Vertical text (A-Z and space)
+std::string CELL_SKIN   = "flat";   // Block skin atlas (render/CellSkin)
+int   GAP1_SCALE        = 10;       // banner ↔ board (x scale)
+int   GAP2_SCALE        = 10;       // board ↔ panel (x scale)
+
+// Pieces configuration (managed by PieceManager)
+std::string PIECES_FILE_PATH = "";  // Optional path to pieces file from config
+
+// Visual effects bridge (provides read-only access to visual config)
+VisualEffectsView g_visualView{};
+
+// ===========================
+//   GAME MECHANICS CONSTANTS
+// ===========================
+// These constants define core game behavior and are synced from GameConfig.
+
+/** @brief Number of columns in the game board (BOARD_COLS, set before the first game) */
+int COLS = 10;
+/** @brief Number of rows in the game board (BOARD_ROWS, set before the first game) */
+int ROWS = 20;
+/** @brief Border size around the game board (pixels) */
+int BORDER = 10;
+/** @brief Speed acceleration per level (ms reduction per level) */
+int SPEED_ACCELERATION = 50;
+/** @brief Lines required to advance to next level */
+int LEVEL_STEP = 10;
+
+// ===========================
+//   GLOBAL MANAGER INSTANCES
+// ===========================
+// These are the main subsystem managers. They coordinate configuration,
+// theme, and piece management across the application.
+
+GameConfig gameConfig;              // Game timing and mechanics configuration
+ThemeManager themeManager;          // Visual theme and color management
+std::vector<Piece> PIECES;          // Active piece set (loaded from .pieces file)
+PieceTable PIECE_TABLE;             // Flat SoA copy of PIECES (see rebuildPieceTable)
+LayoutConfig layoutConfig;          // Virtual layout configuration
+
+
+// Global piece manager instance
+PieceManager pieceManager;
@@ -0,0 +1,108 @@
+#include "ThemeLibrary.hpp"
+#include "ConfigManager.hpp"
+#include "config/ConfigApplicator.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool samePalette(const Theme& a, const Theme& b) {
+    if (a.colors() != b.colors() || a.piece_colors.size() != b.piece_colors.size()) return false;
+    for (size_t i = 0; i < a.piece_colors.size(); ++i) {
+        const RGB &x = a.piece_colors[i], &y = b.piece_colors[i];
+        if (x.r != y.r || x.g != y.g || x.b != y.b) return false;
+    }
+    return true;
+}
+
+std::string stem(const std::string& path) {
+    return fs::path(path).stem().string();
+}
+
+} // namespace
+
+void ThemeLibrary::load(const ConfigManager& config, const std::string& files) {
+    entries_.clear();
+    current_ = 0;
+    const std::vector<std::string>& loaded = config.getConfigPaths();
+    if (!loaded.empty()) configName_ = stem(loaded.front());
+
+    // Só as cores entram na paleta: TITLE_TEXT, ROUNDED_PANELS e companhia seguem os da config
+    const Theme base;
+
+    std::vector<std::string> paths;
+    if (!files.empty()) {
+        std::stringstream list(files);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            item.erase(0, item.find_first_not_of(" \t"));
+            item.erase(item.find_last_not_of(" \t") + 1);
+            if (!item.empty()) paths.push_back(item);
+        }
+    } else {
+        std::error_code ec;
+        const fs::path dir = loaded.empty() ? fs::path(".") : fs::path(loaded.front()).parent_path();
+        for (fs::directory_iterator it(dir.empty() ? fs::path(".") : dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->path().extension() == ".cfg") paths.push_back(it->path().string());
+        }
+        std::sort(paths.begin(), paths.end());
+    }
+
+    for (const std::string& path : paths) {
+        bool isLoaded = false;
+        for (const std::string& own : loaded) {
+            std::error_code ec;
+            if (fs::equivalent(path, own, ec)) isLoaded = true;
+        }
+        if (!isLoaded) addFile(path, base);
+    }
+    if (!entries_.empty()) {
+        DebugLogger::info("Theme library: " + std::to_string(entries_.size()) + " palette(s) besides " + configName_);
+    }
+}
+
+bool ThemeLibrary::addFile(const std::string& path, const Theme& base) {
+    ConfigManager file;
+    if (!file.loadFromFile(path)) return false;
+
+    Entry entry;
+    entry.name = stem(path);
+    entry.theme = base;
+    ConfigApplicator::applyColorsToTheme(file.getVisual(), entry.theme);
+    for (const RGB& c : file.getPieces().pieceColors) entry.theme.piece_colors.push_back({c.r, c.g, c.b});
+
+    // Sem nenhuma cor própria (config de resolução, de modo...): não é um tema
+    Theme plain = base;
+    ConfigApplicator::applyColorsToTheme(VisualConfig{}, plain);
+    if (samePalette(entry.theme, plain)) return false;
+    for (const Entry& other : entries_) {
+        if (samePalette(entry.theme, other.theme)) return false;
+    }
+    entry.ownPieceColors = !entry.theme.piece_colors.empty();
+    entries_.push_back(std::move(entry));
+    return true;
+}
+
+const std::string& ThemeLibrary::name(int index) const {
+    return index <= 0 || index > (int)entries_.size() ? configName_ : entries_[index - 1].name;
+}
+
+int ThemeLibrary::select(ThemeManager& themeManager, int index) {
+    if (index < 0 || index >= size()) index = 0;
+    current_ = index;
+    if (index == 0) {
+        themeManager.setActiveTheme(nullptr);
+        return current_;
+    }
+    Entry& entry = entries_[index - 1];
+    // Tema sem PIECE<n>: fica com as cores de peças da config (vivas, podem ter sido recarregadas)
+    if (!entry.ownPieceColors) entry.theme.piece_colors = themeManager.getConfigTheme().piece_colors;
+    themeManager.setActiveTheme(&entry.theme);
+    return current_;
+}
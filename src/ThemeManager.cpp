@@ -21,8 +21,8 @@ static bool parseHexColor(const std::string& s, Uint8& r, Uint8& g, Uint8& b){
 }
 
 void ThemeManager::initDefaultPieceColors() {
-    if (theme_.piece_colors.empty()) {
-        theme_.piece_colors = {
+    if (active_->piece_colors.empty()) {
+        active_->piece_colors = {
             {220, 80, 80},  { 80,180,120}, { 80,120,220}, {220,180, 80},
             {180, 80,220},  { 80,220,180}, {220,120, 80}, {160,160,160}
         };
@@ -32,16 +32,16 @@ void ThemeManager::initDefaultPieceColors() {
 void ThemeManager::applyPieceColors(std::vector<Piece>& pieces) {
     initDefaultPieceColors();
     for (size_t i = 0; i < pieces.size(); ++i) {
-        if (i < theme_.piece_colors.size()) {
-            pieces[i].r = theme_.piece_colors[i].r;
-            pieces[i].g = theme_.piece_colors[i].g;
-            pieces[i].b = theme_.piece_colors[i].b;
+        if (i < active_->piece_colors.size()) {
+            pieces[i].r = active_->piece_colors[i].r;
+            pieces[i].g = active_->piece_colors[i].g;
+            pieces[i].b = active_->piece_colors[i].b;
         } else {
             if (pieces[i].r == 0 && pieces[i].g == 0 && pieces[i].b == 0) {
                 size_t idx = i % 8;
-                pieces[i].r = theme_.piece_colors[idx].r;
-                pieces[i].g = theme_.piece_colors[idx].g;
-                pieces[i].b = theme_.piece_colors[idx].b;
+                pieces[i].r = active_->piece_colors[idx].r;
+                pieces[i].g = active_->piece_colors[idx].g;
+                pieces[i].b = active_->piece_colors[idx].b;
             }
         }
     }
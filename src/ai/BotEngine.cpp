@@ -0,0 +1,335 @@
+#include "ai/BotEngine.hpp"
+#include "ai/WorkStealingPool.hpp"
+#include "app/GameBoard.hpp"
+#include "app/GameHelpers.hpp"
+#include "app/Zobrist.hpp"
+#include "game/BoardDims.hpp"
+#include "game/Mechanics.hpp"
+#include "input/SyntheticInput.hpp"
+#include "pieces/Piece.hpp"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+extern std::vector<Piece> PIECES;
+
+namespace {
+
+constexpr int XPAD = 4;             // Peças podem ter origem fora do tabuleiro
+constexpr int YPAD = 4;             // Kicks podem subir acima do topo
+constexpr float TOP_OUT = 1000.0f;  // Célula travada acima do topo
+constexpr float DEATH = 1e6f;       // Próxima peça já nasce colidindo
+
+enum Move : uint8_t { MV_LEFT, MV_RIGHT, MV_DOWN, MV_CW, MV_CCW, MV_NONE };
+
+const uint16_t MOVE_ACTION[5] = {
+    SyntheticInput::MOVE_LEFT, SyntheticInput::MOVE_RIGHT, SyntheticInput::SOFT_DROP,
+    SyntheticInput::ROTATE_CW, SyntheticInput::ROTATE_CCW,
+};
+
+/// BFS sobre (x, y, rot); um scratch por thread, refeito só quando o tabuleiro muda de tamanho
+struct Search {
+    int w = 0, h = 0;
+    std::vector<uint32_t> stamp;     // == epoch: visitado nesta busca
+    std::vector<int> parent;
+    std::vector<uint8_t> move;
+    std::vector<int> queue;
+    uint32_t epoch = 0;
+
+    void prepare(int cols, int rows) {
+        int W = cols + 2 * XPAD, H = rows + YPAD;
+        if (W != w || H != h) {
+            w = W; h = H;
+            size_t n = (size_t)w * h * 4;
+            stamp.assign(n, 0); parent.assign(n, -1); move.assign(n, MV_NONE);
+            queue.reserve(n);
+            epoch = 0;
+        }
+        if (++epoch == 0) { std::fill(stamp.begin(), stamp.end(), 0); epoch = 1; }
+        queue.clear();
+    }
+    int index(const Active& a) const {
+        int x = a.x + XPAD, y = a.y + YPAD;
+        if (x < 0 || x >= w || y < 0 || y >= h) return -1;
+        return ((a.rot & 3) * h + y) * w + x;
+    }
+    Active state(int i, int idx) const {
+        int x = i % w, y = (i / w) % h, rot = i / (w * h);
+        return Active{x - XPAD, y - YPAD, rot, idx};
+    }
+    bool visit(const Active& a, int from, uint8_t mv) {
+        int i = index(a);
+        if (i < 0 || stamp[i] == epoch) return false;
+        stamp[i] = epoch; parent[i] = from; move[i] = mv;
+        queue.push_back(i);
+        return true;
+    }
+};
+
+thread_local Search t_search;
+
+/// Vizinhos de a por cada movimento do jogador (rotação com as regras de kick do jogo)
+template <class Dims, typename Visit>
+void expand(Dims d, const BotBoard& b, const Active& a, Visit visit) {
+    if (!collidesMask(a, b.rows, d, -1, 0, 0)) visit(Active{a.x - 1, a.y, a.rot, a.idx}, MV_LEFT);
+    if (!collidesMask(a, b.rows, d, 1, 0, 0)) visit(Active{a.x + 1, a.y, a.rot, a.idx}, MV_RIGHT);
+    if (!collidesMask(a, b.rows, d, 0, 1, 0)) visit(Active{a.x, a.y + 1, a.rot, a.idx}, MV_DOWN);
+    Active r = a;
+    rotateWithKicks(r, b.rows, d, +1);
+    if (r.rot != a.rot) visit(r, MV_CW);
+    r = a;
+    rotateWithKicks(r, b.rows, d, -1);
+    if (r.rot != a.rot) visit(r, MV_CCW);
+}
+
+/// Células da peça como chave (peças simétricas dão o mesmo resultado em rotações diferentes)
+uint64_t footprint(const Active& a) {
+    uint64_t h = 1469598103934665603ull;
+    uint32_t cells[16];
+    int n = 0;
+    for (const auto& c : PIECES[a.idx].rot[a.rot]) {
+        if (n < 16) cells[n++] = (uint32_t)((a.y + c.second + YPAD) * 64 + (a.x + c.first + XPAD));
+    }
+    std::sort(cells, cells + n);
+    for (int i = 0; i < n; ++i) { h ^= cells[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+template <class Dims>
+bool lockIn(Dims d, BotBoard& b, const Active& piece, int& cleared) {
+    bool inside = true;
+    for (const auto& c : PIECES[piece.idx].rot[piece.rot]) {
+        int x = piece.x + c.first, y = piece.y + c.second;
+        if (y < 0) { inside = false; continue; }
+        if (y < d.rows && x >= 0 && x < d.cols) b.rows[y] |= 1u << x;
+    }
+    cleared = 0;
+    int write = d.rows - 1;
+    for (int y = d.rows - 1; y >= 0; --y) {
+        if (b.rows[y] == d.fullRow) { cleared++; continue; }
+        b.rows[write--] = b.rows[y];
+    }
+    while (write >= 0) b.rows[write--] = 0;
+    return inside;
+}
+
+template <class Dims>
+void placementsIn(Dims d, const BotBoard& board, const Active& from, std::vector<Active>& out) {
+    out.clear();
+    Search& s = t_search;
+    s.prepare(d.cols, d.rows);
+    if (!s.visit(from, -1, MV_NONE)) return;
+
+    std::vector<uint64_t> keys;
+    keys.reserve(64);
+    for (size_t head = 0; head < s.queue.size(); ++head) {
+        int cur = s.queue[head];
+        Active a = s.state(cur, from.idx);
+        if (collidesMask(a, board.rows, d, 0, 1, 0)) {
+            uint64_t k = footprint(a);
+            if (std::find(keys.begin(), keys.end(), k) == keys.end()) { keys.push_back(k); out.push_back(a); }
+        }
+        expand(d, board, a, [&](const Active& n, uint8_t mv) { s.visit(n, cur, mv); });
+    }
+}
+
+template <class Dims>
+void dropsIn(Dims d, const BotBoard& board, const Active& from, std::vector<Active>& out) {
+    out.clear();
+    uint64_t keys[4 * (32 + 2 * XPAD)];
+    int nkeys = 0;
+    for (int rot = 0; rot < 4; ++rot) {
+        for (int x = -XPAD; x < d.cols + XPAD; ++x) {
+            Active a{x, from.y, rot, from.idx};
+            if (collidesMask(a, board.rows, d, 0, 0, 0)) continue;
+            while (!collidesMask(a, board.rows, d, 0, 1, 0)) a.y++;
+            uint64_t k = footprint(a);
+            if (std::find(keys, keys + nkeys, k) != keys + nkeys) continue;
+            keys[nkeys++] = k;
+            out.push_back(a);
+        }
+    }
+}
+
+template <class Dims>
+bool pathIn(Dims d, const BotBoard& board, const Active& from, const Active& target, std::vector<uint16_t>& actions) {
+    actions.clear();
+    Search& s = t_search;
+    s.prepare(d.cols, d.rows);
+    if (!s.visit(from, -1, MV_NONE)) return false;
+
+    const uint64_t goal = footprint(target);
+    for (size_t head = 0; head < s.queue.size(); ++head) {
+        int cur = s.queue[head];
+        Active a = s.state(cur, from.idx);
+        // Da coluna/rotação certas, o hard drop termina o caminho
+        Active dropped = a;
+        while (!collidesMask(dropped, board.rows, d, 0, 1, 0)) dropped.y++;
+        if (footprint(dropped) == goal) {
+            actions.push_back(SyntheticInput::HARD_DROP);
+            for (int i = cur; s.parent[i] >= 0; i = s.parent[i]) actions.push_back(MOVE_ACTION[s.move[i]]);
+            std::reverse(actions.begin(), actions.end());
+            return true;
+        }
+        expand(d, board, a, [&](const Active& n, uint8_t mv) { s.visit(n, cur, mv); });
+    }
+    return false;
+}
+
+double nowMs() {
+    return (double)SDL_GetPerformanceCounter() * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+} // namespace
+
+bool BotBoard::supported() { return COLS <= 32 && ROWS <= MAX_ROWS; }
+
+void BotBoard::load(const GameBoard& board) {
+    std::memcpy(rows, board.rowMasks(), sizeof(uint32_t) * ROWS);
+}
+
+bool BotBoard::lock(const Active& piece, int& cleared) {
+    return withDims(COLS, ROWS, [&](auto d) { return lockIn(d, *this, piece, cleared); });
+}
+
+BotEngine::BotEngine(int threads) : pool_(new WorkStealingPool(threads)) {}
+BotEngine::~BotEngine() = default;
+
+int BotEngine::concurrency() const { return pool_->concurrency(); }
+
+float BotEngine::evaluate(const BotBoard& b, int linesCleared) const {
+    return withDims(COLS, ROWS, [&](auto d) { return evaluateIn(d, b, linesCleared); });
+}
+
+template <class Dims>
+float BotEngine::evaluateIn(Dims d, const BotBoard& b, int linesCleared) const {
+    int heights[32] = {0};
+    int holes = 0;
+    uint32_t seen = 0;
+    for (int y = 0; y < d.rows; ++y) {
+        uint32_t r = b.rows[y];
+        for (uint32_t fresh = r & ~seen; fresh; fresh &= fresh - 1) heights[__builtin_ctz(fresh)] = d.rows - y;
+        holes += __builtin_popcount(seen & ~r & d.fullRow);
+        seen |= r;
+    }
+    int aggregate = 0, bumpiness = 0;
+    for (int x = 0; x < d.cols; ++x) {
+        aggregate += heights[x];
+        if (x + 1 < d.cols) bumpiness += std::abs(heights[x] - heights[x + 1]);
+    }
+    return weights_.aggregateHeight * aggregate + weights_.lines * linesCleared +
+           weights_.holes * holes + weights_.bumpiness * bumpiness;
+}
+
+void BotEngine::enumeratePlacements(const BotBoard& board, const Active& from, std::vector<Active>& out) {
+    withDims(COLS, ROWS, [&](auto d) { placementsIn(d, board, from, out); });
+}
+
+void BotEngine::enumerateDrops(const BotBoard& board, const Active& from, std::vector<Active>& out) {
+    withDims(COLS, ROWS, [&](auto d) { dropsIn(d, board, from, out); });
+}
+
+bool BotEngine::planPath(const BotBoard& board, const Active& from, const Active& target,
+                         std::vector<uint16_t>& actions) {
+    return withDims(COLS, ROWS, [&](auto d) { return pathIn(d, board, from, target, actions); });
+}
+
+bool BotEngine::findBest(const GameBoard& board, const Active& current, int nextIdx,
+                         Active& out, BotSearchStats* stats) {
+    if (!BotBoard::supported()) return false;
+    // Tamanho escolhido uma vez: a busca inteira roda com limites constantes
+    return withDims(COLS, ROWS, [&](auto d) { return findBestIn(d, board, current, nextIdx, out, stats); });
+}
+
+template <class Dims>
+bool BotEngine::findBestIn(Dims d, const GameBoard& board, const Active& current, int nextIdx,
+                           Active& out, BotSearchStats* stats) {
+    const double start = nowMs();
+    const double deadline = budgetMs_ > 0 ? start + budgetMs_ : 0.0;
+
+    BotBoard root;
+    root.load(board);
+    std::vector<Active> candidates;
+    placementsIn(d, root, current, candidates);
+    const int n = (int)candidates.size();
+    if (stats) *stats = BotSearchStats{n, 0, 0.0};
+    if (n == 0) return false;
+
+    // Nível 1: avaliação direta da jogada
+    std::vector<BotBoard> after(n);
+    std::vector<int> lines(n);
+    std::vector<float> score1(n), penalty(n);
+    // Tabela de transposição: a primeira colocação com cada tabuleiro final
+    // (e linhas limpas) é a dona do ramo; as outras reaproveitam o resultado
+    std::vector<int> owner(n);
+    std::unordered_map<uint64_t, int> seen;
+    seen.reserve(n);
+    int transpositions = 0;
+    for (int i = 0; i < n; ++i) {
+        after[i] = root;
+        penalty[i] = lockIn(d, after[i], candidates[i], lines[i]) ? 0.0f : TOP_OUT;
+        score1[i] = evaluateIn(d, after[i], lines[i]) - penalty[i];
+        const uint64_t key = Zobrist::board(after[i].rows, d.rows) ^ Zobrist::mix((uint64_t)lines[i]);
+        auto it = seen.emplace(key, i).first;
+        owner[i] = it->second;
+        if (owner[i] != i) transpositions++;
+    }
+    if (stats) stats->transpositions = transpositions;
+
+    int best = (int)(std::max_element(score1.begin(), score1.end()) - score1.begin());
+    if (lookahead_ && nextIdx >= 0 && nextIdx < (int)PIECES.size()) {
+        // Nível 2: um ramo por colocação, dos mais promissores para os piores,
+        // para que um corte por tempo perca só os ramos ruins
+        std::vector<int> ranked(n);
+        for (int i = 0; i < n; ++i) ranked[i] = i;
+        std::stable_sort(ranked.begin(), ranked.end(), [&](int a, int b) { return score1[a] > score1[b]; });
+        std::vector<int> order;
+        order.reserve(n - transpositions);
+        for (int i : ranked) if (owner[i] == i) order.push_back(i);
+
+        std::vector<float> next2(n, 0.0f);
+        std::vector<uint8_t> done(n, 0);
+        auto branch = [&](int k) {
+            int i = order[k];
+            if (deadline > 0 && nowMs() > deadline) return;
+            Active spawn;
+            newActive(spawn, nextIdx);
+            float bestNext;
+            if (collidesMask(spawn, after[i].rows, d, 0, 0, 0)) {
+                bestNext = -DEATH;
+            } else {
+                std::vector<Active> next;
+                dropsIn(d, after[i], spawn, next);
+                bestNext = next.empty() ? -DEATH : -3.4e38f;
+                for (const Active& p : next) {
+                    BotBoard b2 = after[i];
+                    int l2 = 0;
+                    bool inside = lockIn(d, b2, p, l2);
+                    bestNext = std::max(bestNext, evaluateIn(d, b2, lines[i] + l2) - (inside ? 0.0f : TOP_OUT));
+                }
+            }
+            next2[i] = bestNext;
+            done[i] = 1;
+        };
+        pool_->parallelFor((int)order.size(), branch);
+
+        int bestDone = -1, completed = 0;
+        float bestScore = 0.0f;
+        for (int i : ranked) {
+            const int o = owner[i];
+            if (!done[o]) continue;
+            completed++;
+            const float s = next2[o] - penalty[i];
+            if (bestDone < 0 || s > bestScore) { bestDone = i; bestScore = s; }
+        }
+        if (bestDone >= 0) best = bestDone;
+        if (stats) stats->lookaheadDone = completed;
+    }
+
+    out = candidates[best];
+    if (stats) stats->ms = nowMs() - start;
+    return true;
+}
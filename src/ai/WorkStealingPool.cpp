@@ -0,0 +1,135 @@
+#include "ai/WorkStealingPool.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+
+namespace {
+constexpr int DEFAULT_MAX_WORKERS = 15;   // Automático (bot): além disso os ramos não rendem
+constexpr int MAX_WORKERS = 63;           // Pedido explícito (servidor de verificação)
+}
+
+WorkStealingPool::WorkStealingPool(int threads) {
+    if (threads < 0) threads = std::min(SDL_GetCPUCount() - 1, DEFAULT_MAX_WORKERS);
+    threads = std::max(0, std::min(threads, MAX_WORKERS));
+
+    queues_.resize(threads + 1);
+    for (Queue& q : queues_) q.items.reserve(64);
+    if (threads == 0) return;
+
+    mutex_ = SDL_CreateMutex();
+    wake_ = SDL_CreateCond();
+    if (!mutex_ || !wake_) {
+        DebugLogger::warning(std::string("Bot pool: no mutex/cond, running single-threaded: ") + SDL_GetError());
+        return;
+    }
+    for (int i = 0; i < threads; ++i) {
+        SDL_Thread* t = SDL_CreateThread(workerMain, "DropBlocksBot", this);
+        if (!t) {
+            DebugLogger::warning(std::string("Bot pool: SDL_CreateThread failed: ") + SDL_GetError());
+            break;
+        }
+        threads_.push_back(t);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    if (mutex_) {
+        SDL_LockMutex(mutex_);
+        quit_ = true;
+        SDL_CondBroadcast(wake_);
+        SDL_UnlockMutex(mutex_);
+    }
+    for (SDL_Thread* t : threads_) SDL_WaitThread(t, nullptr);
+    if (wake_) SDL_DestroyCond(wake_);
+    if (mutex_) SDL_DestroyMutex(mutex_);
+}
+
+int SDLCALL WorkStealingPool::workerMain(void* self) {
+    WorkStealingPool* pool = static_cast<WorkStealingPool*>(self);
+    pool->workerLoop(pool->nextSlot_.fetch_add(1, std::memory_order_relaxed));
+    return 0;
+}
+
+void WorkStealingPool::workerLoop(int slot) {
+    unsigned seen = 0;
+    for (;;) {
+        SDL_LockMutex(mutex_);
+        while (!quit_ && generation_ == seen) SDL_CondWait(wake_, mutex_);
+        if (quit_) { SDL_UnlockMutex(mutex_); return; }
+        seen = generation_;
+        SDL_UnlockMutex(mutex_);
+
+        while (runOne(slot)) {}
+    }
+}
+
+void WorkStealingPool::parallelFor(int count, Task task, void* ctx) {
+    if (count <= 0) return;
+    if (threads_.empty()) {
+        for (int i = 0; i < count; ++i) task(ctx, i);
+        return;
+    }
+
+    // task_/ctx_ são publicados pelos spinlocks das filas: um worker só os lê
+    // depois de tirar um índice
+    task_ = task;
+    ctx_ = ctx;
+    remaining_.store(count, std::memory_order_relaxed);
+    const int slots = concurrency();
+    for (int s = 0; s < slots; ++s) {
+        Queue& q = queues_[s];
+        SDL_AtomicLock(&q.lock);
+        q.items.clear();
+        q.head = 0;
+        for (int i = s; i < count; i += slots) q.items.push_back(i);
+        SDL_AtomicUnlock(&q.lock);
+    }
+
+    SDL_LockMutex(mutex_);
+    generation_++;
+    SDL_CondBroadcast(wake_);
+    SDL_UnlockMutex(mutex_);
+
+    while (runOne(0)) {}
+    // Sem mais nada para roubar: só falta quem já está executando a última tarefa
+    while (remaining_.load(std::memory_order_acquire) > 0) SDL_Delay(0);
+}
+
+bool WorkStealingPool::runOne(int slot) {
+    int index;
+    bool local = popLocal(slot, index);
+    if (!local && !steal(slot, index)) return false;
+    if (!local) stolen_.fetch_add(1, std::memory_order_relaxed);
+    task_(ctx_, index);
+    remaining_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool WorkStealingPool::popLocal(int slot, int& index) {
+    Queue& q = queues_[slot];
+    bool ok = false;
+    SDL_AtomicLock(&q.lock);
+    if (q.items.size() > q.head) {
+        index = q.items.back();
+        q.items.pop_back();
+        ok = true;
+    }
+    SDL_AtomicUnlock(&q.lock);
+    return ok;
+}
+
+bool WorkStealingPool::steal(int thief, int& index) {
+    const int slots = concurrency();
+    for (int k = 1; k < slots; ++k) {
+        Queue& q = queues_[(thief + k) % slots];
+        bool ok = false;
+        SDL_AtomicLock(&q.lock);
+        if (q.items.size() > q.head) {
+            index = q.items[q.head++];
+            ok = true;
+        }
+        SDL_AtomicUnlock(&q.lock);
+        if (ok) return true;
+    }
+    return false;
+}
@@ -0,0 +1,97 @@
+#include "app/AllocCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> g_allocs{0};
+std::atomic<uint64_t> g_bytes{0};
+std::atomic<uint64_t> g_frees{0};
+thread_local uint64_t t_allocs = 0;
+thread_local uint64_t t_bytes = 0;
+}
+
+#if DROPBLOCKS_ALLOC_TRACKING
+namespace {
+// malloc direto: nada aqui pode voltar ao operator new
+inline void* countedAlloc(std::size_t n) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(n, std::memory_order_relaxed);
+    ++t_allocs;
+    t_bytes += n;
+    return std::malloc(n ? n : 1);
+}
+inline void* countedAllocOrThrow(std::size_t n) {
+    for (;;) {
+        if (void* p = countedAlloc(n)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+inline void countedFree(void* p) {
+    if (p) g_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(p);
+}
+}
+
+void* operator new(std::size_t n) { return countedAllocOrThrow(n); }
+void* operator new[](std::size_t n) { return countedAllocOrThrow(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return countedAlloc(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return countedAlloc(n); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+#endif
+
+namespace AllocCounter {
+
+Counts process() {
+    return Counts{g_allocs.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed)};
+}
+
+Counts thread() { return Counts{t_allocs, t_bytes}; }
+
+uint64_t liveBlocks() {
+    return g_allocs.load(std::memory_order_relaxed) - g_frees.load(std::memory_order_relaxed);
+}
+
+// Sem o hook os números são sempre zero: nem ocupa slots do registro
+FrameMeter::FrameMeter()
+    : mAllocs_(enabled() ? Metrics::gauge("frame_allocs") : -1),
+      mBytes_(enabled() ? Metrics::gauge("frame_alloc_bytes") : -1),
+      mProcess_(enabled() ? Metrics::gauge("frame_allocs_process") : -1) {}
+
+void FrameMeter::beginFrame() {
+    threadStart_ = thread();
+    processStart_ = process();
+    excluded_ = Counts{};
+    paused_ = false;
+}
+
+void FrameMeter::pause() {
+    if (paused_) return;
+    pausedAt_ = thread();
+    paused_ = true;
+}
+
+void FrameMeter::resume() {
+    if (!paused_) return;
+    excluded_ += thread() - pausedAt_;
+    paused_ = false;
+}
+
+void FrameMeter::endFrame() {
+    resume();
+    last_ = thread() - threadStart_ - excluded_;
+    lastProcess_ = process() - processStart_ - excluded_;
+    if (last_.allocs > peak_) peak_ = last_.allocs;
+    Metrics::set(mAllocs_, (double)last_.allocs);
+    Metrics::set(mBytes_, (double)last_.bytes);
+    Metrics::set(mProcess_, (double)lastProcess_.allocs);
+}
+
+} // namespace AllocCounter
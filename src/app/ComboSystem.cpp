@@ -1,15 +1,13 @@
 #include "app/ComboSystem.hpp"
-#include "audio/AudioSystem.hpp"
 
-void ComboSystem::onLineClear(AudioSystem& audio) {
-    Uint32 now = SDL_GetTicks();
+int ComboSystem::onLineClear(Uint32 now) {
     if (now - lastClear < 2000) {
         combo++;
     } else {
         combo = 1;
     }
     lastClear = now;
-    audio.playComboSound(combo);
+    return combo;
 }
 
 void ComboSystem::reset() {
@@ -0,0 +1,57 @@
+#include "app/DeferredStartup.hpp"
+#include "app/GameInitializer.hpp"
+#include "app/StartupTimings.hpp"
+#include "audio/AudioSystem.hpp"
+#include "config/ConfigApplicator.hpp"
+#include "input/InputManager.hpp"
+#include "ConfigManager.hpp"
+#include "DebugLogger.hpp"
+
+void DeferredStartup::begin(AudioSystem& audio, InputManager& input, ConfigManager& config, StartupTimings* timings) {
+    audio_ = &audio;
+    input_ = &input;
+    config_ = &config;
+    timings_ = timings;
+    beginTicks_ = SDL_GetPerformanceCounter();
+    pending_ = AUDIO | JOYSTICKS;
+    done_ = 0;
+    audio.startAsync();  // Sem thread abre inline; isStarting() já volta false
+}
+
+unsigned DeferredStartup::update() {
+    unsigned now = 0;
+    if (pending_ & JOYSTICKS) {
+        startJoysticks();
+        now |= JOYSTICKS;
+    }
+    if ((pending_ & AUDIO) && !audio_->isStarting()) {
+        audio_->waitAsync();
+        addPhase("Audio", audio_->lastStartMs(), true);
+        if (audio_->isReady()) DebugLogger::info("Audio ready");
+        now |= AUDIO;
+    }
+    pending_ &= ~now;
+    done_ |= now;
+    if (now && !pending_) {
+        double ms = (double)(SDL_GetPerformanceCounter() - beginTicks_) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+        DebugLogger::info("Deferred startup done in " + std::to_string(ms) + "ms");
+    }
+    return now;
+}
+
+void DeferredStartup::addPhase(const char* name, double ms, bool worker) {
+    if (!timings_) return;
+    StartupTimings::Phase p;
+    p.name = name;
+    p.ms = ms;
+    p.worker = worker;
+    timings_->phases.push_back(p);
+}
+
+void DeferredStartup::startJoysticks() {
+    Uint64 t = SDL_GetPerformanceCounter();
+    if (GameInit::initializeJoysticks(*input_)) {
+        ConfigApplicator::applyConfigToJoystick(*input_, config_->getInput());
+    }
+    addPhase("Joysticks", (double)(SDL_GetPerformanceCounter() - t) * 1000.0 / (double)SDL_GetPerformanceFrequency(), false);
+}
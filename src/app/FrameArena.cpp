@@ -0,0 +1,93 @@
+#include "app/FrameArena.hpp"
+#include "DebugLogger.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <new>
+
+namespace {
+inline size_t alignUp(size_t v, size_t align) { return (v + align - 1) & ~(align - 1); }
+}
+
+FrameArena::FrameArena(size_t capacity) { reserve(capacity); }
+
+FrameArena::~FrameArena() {
+    for (void* p : spills_) ::operator delete(p);
+    ::operator delete(base_);
+}
+
+void FrameArena::reserve(size_t capacity) {
+    for (void* p : spills_) ::operator delete(p);
+    spills_.clear();
+    ::operator delete(base_);
+    capacity_ = capacity;
+    base_ = capacity_ ? static_cast<unsigned char*>(::operator new(capacity_)) : nullptr;
+    used_ = 0;
+    spilledBytes_ = 0;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t align) {
+    // Alinhamento pelo endereço: o bloco do operator new já vem alinhado a max_align_t
+    const uintptr_t start = reinterpret_cast<uintptr_t>(base_) + used_;
+    const size_t pad = alignUp(start, align) - start;
+    if (base_ && used_ + pad + bytes <= capacity_) {
+        void* p = base_ + used_ + pad;
+        used_ += pad + bytes;
+        if (used() > highWater_) highWater_ = used();
+        return p;
+    }
+    return spill(bytes, align);
+}
+
+void* FrameArena::spill(size_t bytes, size_t align) {
+    // Estouro: um bloco do heap por pedido, liberado no reset()
+    if (spills_.empty()) ++overflows_;
+    void* raw = ::operator new(bytes + align);
+    spills_.push_back(raw);
+    spilledBytes_ += bytes;
+    if (used() > highWater_) highWater_ = used();
+    const uintptr_t p = reinterpret_cast<uintptr_t>(raw);
+    return reinterpret_cast<void*>(alignUp(p, align));
+}
+
+std::string_view FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list retry;
+    va_copy(retry, args);
+
+    // Primeira tentativa direto no espaço livre; só formata de novo se não coube
+    char* out = reinterpret_cast<char*>(base_ + used_);
+    const size_t room = base_ ? capacity_ - used_ : 0;
+    int n = std::vsnprintf(room ? out : nullptr, room, fmt, args);
+    va_end(args);
+    if (n < 0) { va_end(retry); return std::string_view(); }
+
+    if ((size_t)n < room) {
+        used_ += (size_t)n + 1;
+        if (used() > highWater_) highWater_ = used();
+    } else {
+        out = static_cast<char*>(allocate((size_t)n + 1, 1));
+        std::vsnprintf(out, (size_t)n + 1, fmt, retry);
+    }
+    va_end(retry);
+    return std::string_view(out, (size_t)n);
+}
+
+void FrameArena::reset() {
+    if (!spills_.empty()) {
+        for (void* p : spills_) ::operator delete(p);
+        spills_.clear();
+        // Cresce para o pico (+25%) e volta a não alocar nos próximos frames
+        const size_t grown = alignUp(highWater_ + highWater_ / 4, 4096);
+        DebugLogger::info("FrameArena: " + std::to_string(highWater_) + " B no pico, bloco de " +
+                          std::to_string(capacity_) + " para " + std::to_string(grown) + " B");
+        reserve(grown);
+    }
+    used_ = 0;
+    spilledBytes_ = 0;
+}
+
+FrameArena& frameArena() {
+    static FrameArena arena;
+    return arena;
+}
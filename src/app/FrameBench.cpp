@@ -0,0 +1,238 @@
+#include "app/FrameBench.hpp"
+#include "render/SoftRaster.hpp"
+#include "ConfigManager.hpp"
+#include "ConfigTypes.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+// Herdado pelo processo filho
+void setChildEnv(const char* name, const std::string& value) {
+#ifdef _WIN32
+    _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 1);
+#endif
+}
+
+// std::system devolve o status do wait() fora do Windows
+int exitStatus(int rc) {
+#ifdef _WIN32
+    return rc;
+#else
+    return rc != -1 && WIFEXITED(rc) ? WEXITSTATUS(rc) : -1;
+#endif
+}
+
+std::string quoteArg(const std::string& arg) { return "\"" + arg + "\""; }
+
+std::vector<std::string> shippedConfigs() {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (fs::directory_iterator it(".", ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() == ".cfg" && it->is_regular_file(ec)) paths.push_back(it->path().filename().string());
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+double elapsedMs(Uint64 since) {
+    return (double)(SDL_GetPerformanceCounter() - since) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+} // namespace
+
+void setFrameBenchOverrides(ConfigManager& configManager, const FrameBenchOptions& options) {
+    static const char* const fixed[][2] = {
+        {"FRAME_PACING", "UNCAPPED"},
+        {"REPLAY_SPEED", "REALTIME"},
+        {"REPLAY_RECORD_DIR", ""},
+        {"THREADED_MODE", "0"},        // Passos fixos e fim do replay só no loop single-threaded
+        {"IDLE_RENDER", "0"},
+        {"ATTRACT_IDLE_SECONDS", "0"},
+        {"QUALITY_GOVERNOR", "0"},
+        {"BOT_ENABLED", "0"},
+        {"SPLIT_PLAYERS", "1"},
+        {"NET_PEER", ""},
+        {"SPECTATE_SOURCE", ""},
+        {"SPECTATE_PORT", "0"},
+        {"SESSION_LOG", ""},
+        {"RESUME_FILE", ""},
+        {"PRACTICE_MODE", "0"},
+        {"CAPTURE_VIDEO", ""},
+        {"MARQUEE_DISPLAY", "-1"},
+        {"PROFILE_CSV", ""},
+        {"METRICS_TARGET", ""},
+        {"TRACE_SECONDS", "0"},
+    };
+    for (const auto& kv : fixed) configManager.setOverride(kv[0], kv[1]);
+    configManager.setOverride("REPLAY_FILE", options.replayFile);
+}
+
+void FrameBench::begin(FrameProfiler* profiler, int stepsPerFrame) {
+    profiler_ = profiler;
+    stepsPerFrame_ = stepsPerFrame;
+    warmup_ = WARMUP_FRAMES;
+    frames_.clear();
+    drawSum_ = 0;
+    drawMax_ = 0;
+    replayFinished_ = false;
+    DebugLogger::info("Bench: " + std::to_string(stepsPerFrame) + " step(s) per frame, " +
+                      std::to_string(WARMUP_FRAMES) + " warm-up frame(s)" +
+                      (maxFrames_ > 0 ? ", up to " + std::to_string(maxFrames_) + " frame(s)" : std::string()));
+}
+
+void FrameBench::onFrame(double frameMs, unsigned drawCalls) {
+    if (warmup_ > 0) {
+        // Caches prontos: daqui em diante é o custo do frame em regime
+        if (--warmup_ == 0) {
+            if (profiler_) profiler_->resetTotals();
+            startTicks_ = SDL_GetPerformanceCounter();
+        }
+        return;
+    }
+    frames_.add(frameMs);
+    drawSum_ += drawCalls;
+    drawMax_ = std::max(drawMax_, drawCalls);
+}
+
+void FrameBench::end(bool replayFinished) {
+    replayFinished_ = replayFinished;
+    wallMs_ = frames_.count() ? elapsedMs(startTicks_) : 0.0;
+    sections_.clear();
+    if (profiler_ && profiler_->totalFrames()) {
+        const double frames = (double)profiler_->totalFrames();
+        for (int i = 0; i < profiler_->sectionCount(); ++i) {
+            sections_.push_back(Section{profiler_->sectionName(i), profiler_->sectionTotalMs(i) / frames});
+        }
+    }
+    profiler_ = nullptr;
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "Bench: %llu frame(s), avg %.3fms, p99 %.3fms, max %.3fms, %.0f draw calls/frame",
+                  (unsigned long long)frames_.count(), frames_.avgMs(), frames_.percentileMs(0.99), frames_.maxMs(),
+                  frames_.count() ? (double)drawSum_ / (double)frames_.count() : 0.0);
+    DebugLogger::info(buf);
+}
+
+bool FrameBench::writeJson(const std::string& path, const ConfigManager& configManager, SDL_Renderer* renderer) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.good()) return false;
+
+    SDL_RendererInfo info{};
+    int outW = 0, outH = 0;
+    if (renderer) {
+        SDL_GetRendererInfo(renderer, &info);
+        SDL_GetRendererOutputSize(renderer, &outW, &outH);
+    }
+    const std::vector<std::string>& cfgPaths = configManager.getConfigPaths();
+    const LayoutConfig& layout = configManager.getLayout();
+    const double frames = (double)frames_.count();
+
+    char buf[1280];
+    std::snprintf(buf, sizeof(buf),
+                  "{\"config\": \"%s\", \"status\": \"%s\", \"renderer\": \"%s\", \"soft_kernels\": \"%s\""
+                  ", \"output\": [%d, %d], \"virtual\": [%d, %d], \"steps_per_frame\": %d, \"warmup_frames\": %d"
+                  ", \"frames\": %llu, \"replay_finished\": %s, \"wall_ms\": %.3f, \"fps\": %.1f"
+                  ", \"frame_ms\": {\"avg\": %.4f, \"p50\": %.4f, \"p99\": %.4f, \"max\": %.4f}"
+                  ", \"draw_calls\": {\"avg\": %.1f, \"max\": %u}, \"cpu_ms_per_frame\": {",
+                  jsonEscape(cfgPaths.empty() ? std::string() : cfgPaths.front()).c_str(),
+                  frames_.count() ? "ok" : "no_frames", info.name ? jsonEscape(info.name).c_str() : "",
+                  SoftRaster::isFrameRenderer(renderer) ? SoftRaster::kernelName() : "", outW, outH,
+                  layout.virtualWidth, layout.virtualHeight, stepsPerFrame_, WARMUP_FRAMES,
+                  (unsigned long long)frames_.count(), replayFinished_ ? "true" : "false", wallMs_,
+                  wallMs_ > 0.0 ? frames * 1000.0 / wallMs_ : 0.0, frames_.avgMs(), frames_.percentileMs(0.50),
+                  frames_.percentileMs(0.99), frames_.maxMs(), frames ? (double)drawSum_ / frames : 0.0, drawMax_);
+    out << buf;
+    for (size_t i = 0; i < sections_.size(); ++i) {
+        std::snprintf(buf, sizeof(buf), "%s\"%s\": %.4f", i ? ", " : "", jsonEscape(sections_[i].name).c_str(),
+                      sections_[i].msPerFrame);
+        out << buf;
+    }
+    out << "}}";
+    return out.good();
+}
+
+int runFrameBenchmarks(const std::string& executable, const FrameBenchOptions& options) {
+    if (options.replayFile.empty()) {
+        DebugLogger::error("Bench: --bench-frames needs --replay FILE.dbr (record one with REPLAY_RECORD_DIR)");
+        return 1;
+    }
+    const std::vector<std::string> configs = options.configs.empty() ? shippedConfigs() : options.configs;
+    if (configs.empty()) {
+        DebugLogger::error("Bench: no .cfg files in the current directory");
+        return 1;
+    }
+
+    const std::string partPath = options.jsonPath + ".part";
+    std::string results;
+    int failed = 0;
+    const Uint64 t0 = SDL_GetPerformanceCounter();
+    for (size_t i = 0; i < configs.size(); ++i) {
+        const std::string& cfg = configs[i];
+        DebugLogger::info("Bench: [" + std::to_string(i + 1) + "/" + std::to_string(configs.size()) + "] " + cfg);
+        std::error_code ec;
+        fs::remove(partPath, ec);
+        setChildEnv("DROPBLOCKS_CFG", cfg);
+        setChildEnv("DROPBLOCKS_CACHE", "");   // Cache compilado seria de outra config
+        std::string command = quoteArg(executable) + " --bench-child --replay " + quoteArg(options.replayFile) +
+                              " --json " + quoteArg(partPath);
+        if (options.maxFrames > 0) command += " --frames " + std::to_string(options.maxFrames);
+#ifdef _WIN32
+        command = "\"" + command + "\"";   // cmd /c tira as aspas de fora
+#endif
+        const int rc = exitStatus(std::system(command.c_str()));
+
+        std::ifstream part(partPath);
+        std::stringstream body;
+        if (part.good()) body << part.rdbuf();
+        part.close();
+        fs::remove(partPath, ec);
+        if (rc == 0 && !body.str().empty()) {
+            results += (results.empty() ? "    " : ",\n    ") + body.str();
+        } else {
+            failed++;
+            DebugLogger::warning("Bench: " + cfg + " failed (exit " + std::to_string(rc) + ")");
+            results += (results.empty() ? "    " : ",\n    ") + std::string("{\"config\": \"") + jsonEscape(cfg) +
+                       "\", \"status\": \"failed\", \"exit_code\": " + std::to_string(rc) + "}";
+        }
+    }
+    const double wallMs = elapsedMs(t0);
+
+    std::ofstream out(options.jsonPath, std::ios::trunc);
+    if (out.good()) {
+        char buf[256];
+        std::snprintf(buf, sizeof(buf), "{\n  \"replay\": \"%s\",\n  \"max_frames\": %d,\n  \"wall_ms\": %.3f,\n  \"failed\": %d,\n",
+                      jsonEscape(options.replayFile).c_str(), options.maxFrames, wallMs, failed);
+        out << buf << "  \"results\": [\n" << results << "\n  ]\n}\n";
+    }
+    const bool written = out.good();
+    if (!written) DebugLogger::error("Bench: could not write " + options.jsonPath);
+    DebugLogger::info("Bench: " + std::to_string(configs.size() - failed) + "/" + std::to_string(configs.size()) +
+                      " config(s) measured in " + std::to_string(wallMs / 1000.0) + "s" +
+                      (written ? " -> " + options.jsonPath : std::string()));
+    return written && failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include "app/FrameProfiler.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void RollingStat::add(double ms) {
+    samples_[head_] = (float)ms;
+    head_ = (head_ + 1) % WINDOW;
+    if (count_ < WINDOW) count_++;
+}
+
+PhaseStats RollingStat::stats() const {
+    PhaseStats s;
+    if (count_ == 0) return s;
+
+    float sorted[WINDOW];
+    double sum = 0.0;
+    for (int i = 0; i < count_; ++i) {
+        sorted[i] = sample(i);
+        sum += sorted[i];
+    }
+    s.lastMs = sample(count_ - 1);
+    std::sort(sorted, sorted + count_);
+    s.minMs = sorted[0];
+    s.maxMs = sorted[count_ - 1];
+    s.avgMs = sum / count_;
+    s.p50Ms = sorted[(count_ - 1) / 2];
+    int p99 = (count_ * 99 + 99) / 100 - 1;  // ceil(0.99 * n) - 1
+    s.p99Ms = sorted[std::max(0, std::min(p99, count_ - 1))];
+    return s;
+}
+
+void FrameHistogram::add(double ms) {
+    const int bucket = (int)(ms / BUCKET_MS);
+    buckets_[std::max(0, std::min(BUCKETS - 1, bucket))]++;
+    count_++;
+    sum_ += ms;
+    if (ms > max_) max_ = ms;
+}
+
+void FrameHistogram::clear() {
+    std::fill(buckets_.begin(), buckets_.end(), 0u);
+    count_ = 0;
+    sum_ = 0.0;
+    max_ = 0.0;
+}
+
+double FrameHistogram::percentileMs(double fraction) const {
+    if (!count_) return 0.0;
+    const uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(fraction * (double)count_));
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) return std::min(max_, (i + 1) * BUCKET_MS);
+    }
+    return max_;
+}
+
+int FrameProfiler::addSection(const std::string& name) {
+    for (size_t i = 0; i < sections_.size(); ++i) {
+        if (sections_[i].name == name) return (int)i;
+    }
+    if (csvHeaderDone_) {
+        DebugLogger::warning("Profiler section '" + name + "' added after CSV header; it will not be dumped");
+    }
+    sections_.push_back(Section{name, 0.0, RollingStat{}});
+    return (int)sections_.size() - 1;
+}
+
+void FrameProfiler::endFrame(double frameMs) {
+    frame_.add(frameMs);
+    for (auto& s : sections_) {
+        s.window.add(s.pending);
+        s.totalMs += s.pending;
+    }
+    totalFrames_++;
+
+    if (csv_.is_open()) {
+        if (!csvHeaderDone_) writeCsvHeader();
+        csv_ << frameIndex_ << ',' << frameMs;
+        for (auto& s : sections_) csv_ << ',' << s.pending;
+        csv_ << '\n';
+    }
+
+    for (auto& s : sections_) s.pending = 0.0;
+    frameIndex_++;
+}
+
+void FrameProfiler::resetTotals() {
+    for (auto& s : sections_) s.totalMs = 0.0;
+    totalFrames_ = 0;
+}
+
+bool FrameProfiler::openCsv(const std::string& path) {
+    closeCsv();
+    csv_.open(path, std::ios::out | std::ios::trunc);
+    if (!csv_.is_open()) {
+        DebugLogger::error("Could not open profile CSV: " + path);
+        return false;
+    }
+    csv_.setf(std::ios::fixed);
+    csv_.precision(4);
+    csvHeaderDone_ = false;  // Cabeçalho no primeiro frame: as layers já estão registradas
+    DebugLogger::info("Profiling frames to " + path);
+    return true;
+}
+
+void FrameProfiler::closeCsv() {
+    if (!csv_.is_open()) return;
+    csv_.flush();
+    csv_.close();
+    csvHeaderDone_ = false;
+}
+
+void FrameProfiler::writeCsvHeader() {
+    csv_ << "frame,frame_ms";
+    for (auto& s : sections_) csv_ << ',' << s.name << "_ms";
+    csv_ << '\n';
+    csvHeaderDone_ = true;
+}
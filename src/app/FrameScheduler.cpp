@@ -0,0 +1,98 @@
+#include "app/FrameScheduler.hpp"
+#include "app/Tracing.hpp"
+#include <algorithm>
+#include <cctype>
+
+FramePacing parseFramePacing(const std::string& value) {
+    std::string v;
+    for (char c : value) v += (char)std::toupper((unsigned char)c);
+    if (v == "CAPPED") return FramePacing::CAPPED;
+    if (v == "UNCAPPED") return FramePacing::UNCAPPED;
+    if (v == "LOW_LATENCY" || v == "LATE_LATCH") return FramePacing::LOW_LATENCY;
+    return FramePacing::VSYNC;
+}
+
+const char* framePacingName(FramePacing mode) {
+    switch (mode) {
+        case FramePacing::CAPPED: return "CAPPED";
+        case FramePacing::UNCAPPED: return "UNCAPPED";
+        case FramePacing::LOW_LATENCY: return "LOW-LATENCY";
+        default: return "VSYNC";
+    }
+}
+
+FrameScheduler::FrameScheduler() {
+    freq_ = SDL_GetPerformanceFrequency();
+    if (freq_ == 0) freq_ = 1000;
+}
+
+void FrameScheduler::configure(FramePacing mode, int targetFps, int stepMs) {
+    mode_ = mode;
+    stepMs_ = std::max(1, std::min(50, stepMs));
+    bool paced = (mode == FramePacing::CAPPED || mode == FramePacing::LOW_LATENCY);
+    frameTicks_ = (paced && targetFps > 0) ? freq_ / (Uint64)std::min(targetFps, 1000) : 0;
+}
+
+void FrameScheduler::start() {
+    accumulatorMs_ = 0.0;
+    workEmaMs_ = 0.0;
+    lastFrameStart_ = SDL_GetPerformanceCounter();
+    nextDeadline_ = lastFrameStart_ + frameTicks_;
+    timings_ = FrameTimings{};
+}
+
+void FrameScheduler::sleepUntil(Uint64 target) const {
+    DB_TRACE_ZONE("Pacing sleep");
+    // SDL_Delay para o grosso (granularidade do SO ~1ms), spin no final
+    for (;;) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (now >= target) return;
+        double remainingMs = ticksToMs(target - now);
+        if (remainingMs > 2.0) SDL_Delay((Uint32)(remainingMs - 1.5));
+    }
+}
+
+void FrameScheduler::waitBeforeFrame() {
+    if (mode_ != FramePacing::LOW_LATENCY || frameTicks_ == 0) return;
+    // Acorda a tempo de ler input, simular e renderizar até o prazo (+0.5ms de folga)
+    Uint64 lead = (Uint64)((workEmaMs_ + 0.5) * (double)freq_ / 1000.0);
+    if (nextDeadline_ > lead) sleepUntil(nextDeadline_ - lead);
+}
+
+int FrameScheduler::beginFrame() {
+    frameStart_ = SDL_GetPerformanceCounter();
+    double delta = ticksToMs(frameStart_ - lastFrameStart_);
+    timings_.frameMs = delta;
+    lastFrameStart_ = frameStart_;
+    
+    int steps = fixedSteps_;
+    if (!steps) {
+        accumulatorMs_ = std::min(accumulatorMs_ + delta, MAX_ACCUMULATED_MS);
+        steps = (int)(accumulatorMs_ / stepMs_);
+        accumulatorMs_ -= steps * (double)stepMs_;
+    }
+    timings_.steps = steps;
+    simEnd_ = renderEnd_ = frameStart_;
+    return steps;
+}
+
+void FrameScheduler::markSimDone() { simEnd_ = SDL_GetPerformanceCounter(); }
+void FrameScheduler::markRenderDone() { renderEnd_ = SDL_GetPerformanceCounter(); }
+
+void FrameScheduler::endFrame() {
+    if (simEnd_ < frameStart_) simEnd_ = frameStart_;
+    if (renderEnd_ < simEnd_) renderEnd_ = simEnd_;
+    timings_.simMs = ticksToMs(simEnd_ - frameStart_);
+    timings_.renderMs = ticksToMs(renderEnd_ - simEnd_);
+    double work = timings_.simMs + timings_.renderMs;
+    workEmaMs_ = (workEmaMs_ == 0.0) ? work : workEmaMs_ * 0.9 + work * 0.1;
+    
+    if (frameTicks_ != 0) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if (mode_ == FramePacing::CAPPED) sleepUntil(nextDeadline_);
+        // Prazo seguinte; se atrasou mais de um frame, realinha em vez de correr atrás
+        nextDeadline_ += frameTicks_;
+        if (now > nextDeadline_) nextDeadline_ = now + frameTicks_;
+    }
+    timings_.waitMs = ticksToMs(SDL_GetPerformanceCounter() - renderEnd_);
+}
@@ -1,31 +1,247 @@
 #include "app/GameBoard.hpp"
-#include "audio/AudioSystem.hpp"
+#include "app/Zobrist.hpp"
+#include "Interfaces.hpp"
+#include "pieces/Piece.hpp"
 #include "game/Mechanics.hpp"
+#include "game/BoardDims.hpp"
+#include "DebugLogger.hpp"
 #include <algorithm>
 
-// now provided by Mechanics.hpp/cpp
+extern std::vector<Piece> PIECES;
 
-bool GameBoard::canPlacePiece(const Active& piece, int dx, int dy, int drot) const { return !collides(piece, grid_, dx, dy, drot); }
-void GameBoard::placePiece(const Active& piece) { lockPiece(piece, grid_); }
+GameBoard::GameBoard() { resize(COLS, ROWS); }
+
+void GameBoard::resize(int cols, int rows) {
+    if (cols < MIN_BOARD_COLS || cols > MAX_BOARD_COLS || rows < MIN_BOARD_ROWS || rows > MAX_BOARD_ROWS) {
+        DebugLogger::error("GameBoard: " + std::to_string(cols) + "x" + std::to_string(rows) + " fora dos limites, ajustado");
+        cols = std::max(MIN_BOARD_COLS, std::min(MAX_BOARD_COLS, cols));
+        rows = std::max(MIN_BOARD_ROWS, std::min(MAX_BOARD_ROWS, rows));
+    }
+    width_ = cols;
+    height_ = rows;
+    rows_.assign(rows, 0);
+    hash_ = 0;
+    slot_.resize(rows);
+    cells_.assign((size_t)rows * cols, Cell{});
+    colHeight_.assign(cols, 0);
+    rowFill_.assign(rows, 0);
+    grid_.assign(rows, std::vector<Cell>(cols));
+    fullRow_ = fullRowFor(cols);
+    clearedRows_.reserve(rows);
+    freeSlots_.reserve(rows);
+    reset();
+}
+
+const std::vector<std::vector<Cell>>& GameBoard::getGrid() const {
+    if (gridDirty_) {
+        withDims(width_, height_, [&](auto d) {
+            for (int y = 0; y < d.rows; y++) {
+                const Cell* src = &cells_[slot_[y] * d.cols];
+                std::copy(src, src + d.cols, grid_[y].begin());
+            }
+        });
+        gridDirty_ = false;
+    }
+    return grid_;
+}
+
+void GameBoard::recomputeHeights() {
+    // Varre de cima para baixo; a primeira vez que um bit aparece define a altura
+    std::fill(colHeight_.begin(), colHeight_.end(), 0);
+    withDims(width_, height_, [&](auto d) {
+        RowMask seen = 0;
+        for (int y = 0; y < d.rows && seen != fullRow_; y++) {
+            RowMask fresh = rows_[y] & ~seen;
+            for (; fresh; fresh &= fresh - 1) colHeight_[__builtin_ctz(fresh)] = d.rows - y;
+            seen |= rows_[y];
+        }
+    });
+}
+
+void GameBoard::recomputeTension() {
+    tension_ = 0;
+    for (int y = std::max(0, height_ - 6); y < height_; y++) if (rows_[y]) tension_++;
+}
+
+int GameBoard::getMaxHeight() const {
+    return colHeight_.empty() ? 0 : *std::max_element(colHeight_.begin(), colHeight_.end());
+}
+
+int GameBoard::dropDistance(const Active& piece) const {
+    // Caminho rápido: se a peça está acima da superfície em todas as suas
+    // colunas, a distância é o menor vão até a superfície
+    const auto& pc = PIECES[piece.idx];
+    const RotationMask& m = pc.masks[(piece.rot % 4 + 4) % 4];
+    if (m.valid) {
+        int best = 2 * height_;
+        bool ok = true;
+        for (int i = 0; i < m.height() && ok; i++) {
+            int y = piece.y + m.minY + i;
+            for (uint32_t bits = m.rows[i]; bits; bits &= bits - 1) {
+                int x = piece.x + m.minX + __builtin_ctz(bits);
+                if (x < 0 || x >= width_) { ok = false; break; }
+                int gap = (height_ - colHeight_[x]) - 1 - y;
+                if (gap < 0) { ok = false; break; }
+                best = std::min(best, gap);
+            }
+        }
+        if (ok) return best;
+    }
+    // Peça sob um overhang: desce passo a passo
+    return withDims(width_, height_, [&](auto d) {
+        int n = 0;
+        while (n < d.rows + 10 && !collidesMask(piece, rows_.data(), d, 0, n + 1, 0)) n++;
+        return n;
+    });
+}
+
+bool GameBoard::canPlacePiece(const Active& piece, int dx, int dy, int drot) const {
+    return withDims(width_, height_, [&](auto d) { return !collidesMask(piece, rows_.data(), d, dx, dy, drot); });
+}
+
+void GameBoard::placePiece(const Active& piece) {
+    const auto& pc = PIECES[piece.idx];
+    auto put = [&](int x, int y) {
+        if (y < 0 || y >= height_ || x < 0 || x >= width_) return;
+        RowMask bit = RowMask(1) << x;
+        if (!(rows_[y] & bit)) {
+            rows_[y] |= bit;
+            hash_ ^= Zobrist::cell(x, y);
+            if (++rowFill_[y] == width_) fullRows_++;
+            colHeight_[x] = std::max(colHeight_[x], height_ - y);
+        }
+        Cell& c = cells_[slot_[y] * width_ + x];
+        c.occ = true; c.r = pc.r; c.g = pc.g; c.b = pc.b;
+        if (!gridDirty_) grid_[y][x] = c;
+    };
+    const RotationMask& m = pc.masks[piece.rot];
+    if (!m.valid) {
+        for (const auto& p : pc.rot[piece.rot]) put(piece.x + p.first, piece.y + p.second);
+    } else {
+        for (int i = 0; i < m.height(); i++)
+            for (uint32_t bits = m.rows[i]; bits; bits &= bits - 1) put(piece.x + m.minX + __builtin_ctz(bits), piece.y + m.minY + i);
+    }
+    recomputeTension();
+    version_++;
+}
 
 int GameBoard::clearLines() {
+    // Passo único de baixo para cima: compacta máscaras e índices de slot,
+    // guardando os slots das linhas cheias para reaproveitar no topo
+    clearedRows_.clear();
+    if (fullRows_ == 0) return 0;
+    freeSlots_.clear();
+    // Só as linhas até a cheia mais baixa mudam de lugar: tira as chaves delas agora, recoloca depois
+    int lowest = height_ - 1;
+    while (lowest > 0 && rows_[lowest] != fullRow_) lowest--;
+    for (int y = 0; y <= lowest; y++) if (rows_[y]) hash_ ^= Zobrist::row(y, rows_[y]);
     int linesCleared = 0;
-    for (int y = ROWS - 1; y >= 0; y--) {
-        bool fullLine = true;
-        for (int x = 0; x < COLS; x++) if (!grid_[y][x].occ) { fullLine = false; break; }
-        if (fullLine) { grid_.erase(grid_.begin() + y); grid_.insert(grid_.begin(), std::vector<Cell>(COLS)); linesCleared++; y++; }
-    }
+    withDims(width_, height_, [&](auto d) {
+        int write = d.rows - 1;
+        for (int read = d.rows - 1; read >= 0; read--) {
+            if (rows_[read] == fullRow_) {
+                clearedRows_.push_back(read);
+                freeSlots_.push_back(slot_[read]);
+                continue;
+            }
+            if (write != read) { rows_[write] = rows_[read]; slot_[write] = slot_[read]; rowFill_[write] = rowFill_[read]; }
+            write--;
+        }
+        linesCleared = (int)clearedRows_.size();
+        for (int y = 0; y < linesCleared; y++) {
+            rows_[y] = 0;
+            rowFill_[y] = 0;
+            slot_[y] = freeSlots_[y];
+            Cell* row = &cells_[slot_[y] * d.cols];
+            std::fill(row, row + d.cols, Cell{});
+        }
+    });
+    for (int y = 0; y <= lowest; y++) if (rows_[y]) hash_ ^= Zobrist::row(y, rows_[y]);
+    if (linesCleared == 0) return 0;
+
+    fullRows_ = 0;
+    recomputeHeights();
+    recomputeTension();
+    gridDirty_ = true;
+    version_++;
     return linesCleared;
 }
 
-bool GameBoard::isGameOver(const Active& piece) const { return collides(piece, grid_, 0, 0, 0); }
-void GameBoard::reset() { for (auto& row : grid_) for (auto& cell : row) cell.occ = false; }
+bool GameBoard::isGameOver(const Active& piece) const { return !canPlacePiece(piece, 0, 0, 0); }
 
-int GameBoard::getTensionLevel() const {
-    int filledRows = 0; for (int y = ROWS - 6; y < ROWS; y++) { bool hasBlocks = false; for (int x = 0; x < COLS; x++) if (grid_[y][x].occ) { hasBlocks = true; break; } if (hasBlocks) filledRows++; }
-    return filledRows;
+bool GameBoard::addGarbage(int lines, int holeCol, const Cell& color) {
+    lines = std::min(lines, height_);
+    if (lines <= 0) return false;
+    holeCol = ((holeCol % width_) + width_) % width_;
+    // Mesma indireção do clearLines: os slots que saem pelo topo viram as linhas de lixo
+    bool overflow = false;
+    freeSlots_.clear();
+    for (int y = 0; y < lines; y++) {
+        if (rows_[y]) overflow = true;
+        freeSlots_.push_back(slot_[y]);
+    }
+    for (int y = 0; y + lines < height_; y++) {
+        rows_[y] = rows_[y + lines];
+        slot_[y] = slot_[y + lines];
+        rowFill_[y] = rowFill_[y + lines];
+    }
+    const RowMask garbage = fullRow_ & ~(RowMask(1) << holeCol);
+    for (int i = 0; i < lines; i++) {
+        int y = height_ - lines + i;
+        rows_[y] = garbage;
+        rowFill_[y] = width_ - 1;
+        slot_[y] = freeSlots_[i];
+        Cell* row = &cells_[slot_[y] * width_];
+        for (int x = 0; x < width_; x++) {
+            row[x] = color;
+            row[x].occ = x != holeCol;
+        }
+    }
+    hash_ = Zobrist::board(rows_.data(), height_);   // Tudo subiu: mais barato recalcular
+    recomputeHeights();
+    recomputeTension();
+    gridDirty_ = true;
+    version_++;
+    return overflow;
 }
 
-void GameBoard::checkTension(AudioSystem& audio) const { audio.playTensionSound(getTensionLevel()); }
+void GameBoard::restore(const RowMask* masks, const Cell* cells, int cellStride) {
+    fullRows_ = 0;
+    for (int y = 0; y < height_; y++) {
+        const RowMask bits = masks[y] & fullRow_;
+        rows_[y] = bits;
+        slot_[y] = y;
+        rowFill_[y] = __builtin_popcount(bits);
+        if (bits == fullRow_) fullRows_++;
+        const Cell* src = cells + (size_t)y * cellStride;
+        Cell* dst = &cells_[(size_t)y * width_];
+        for (int x = 0; x < width_; x++) {
+            dst[x] = src[x];
+            dst[x].occ = (bits >> x) & 1u;
+        }
+    }
+    hash_ = Zobrist::board(rows_.data(), height_);
+    clearedRows_.clear();
+    recomputeHeights();
+    recomputeTension();
+    gridDirty_ = true;
+    version_++;
+}
+
+void GameBoard::reset() {
+    std::fill(rows_.begin(), rows_.end(), 0);
+    for (auto& c : cells_) c.occ = false;
+    for (int y = 0; y < height_; y++) slot_[y] = y;
+    std::fill(colHeight_.begin(), colHeight_.end(), 0);
+    std::fill(rowFill_.begin(), rowFill_.end(), 0);
+    fullRows_ = 0;
+    tension_ = 0;
+    hash_ = 0;
+    clearedRows_.clear();
+    gridDirty_ = true;
+    version_++;
+}
 
+int GameBoard::getTensionLevel() const { return tension_; }
 
+void GameBoard::checkTension(IAudioSystem& audio) const { audio.playTensionSound(getTensionLevel()); }
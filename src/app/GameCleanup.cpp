@@ -4,11 +4,16 @@
 #include "audio/AudioSystem.hpp"
 #include "input/InputManager.hpp"
 #include "render/RenderManager.hpp"
+#include "render/Primitives.hpp"
+#include "render/CellSkin.hpp"
+#include "render/SoftRaster.hpp"
 
 void GameCleanup::cleanupAudio(AudioSystem& audio) { audio.cleanup(); DebugLogger::info("Audio system cleaned up"); }
 void GameCleanup::cleanupInput(InputManager& inputManager) { inputManager.cleanup(); DebugLogger::info("Input system cleaned up"); }
 void GameCleanup::cleanupWindow(SDL_Window* win, SDL_Renderer* ren) {
-    if (ren) { SDL_DestroyRenderer(ren); DebugLogger::info("Renderer destroyed"); }
+    releaseGlyphAtlases();
+    releaseCellSkin();
+    if (ren) { SoftRaster::destroyRenderer(ren); DebugLogger::info("Renderer destroyed"); }
     if (win) { SDL_DestroyWindow(win); DebugLogger::info("Window destroyed"); }
 }
 void GameCleanup::cleanupRender(RenderManager& renderManager) { renderManager.cleanup(); DebugLogger::info("Render system cleaned up"); }
@@ -0,0 +1,6 @@
+#include "app/GameClock.hpp"
+
+IGameClock& systemClock() {
+    static SdlClock clock;
+    return clock;
+}
@@ -0,0 +1,68 @@
+#include "app/GameEvents.hpp"
+#include "app/Metrics.hpp"
+#include "Interfaces.hpp"
+
+void GameEventQueue::dispatch() {
+    if (count_ == 0) return;
+    // Assinante que der push durante a entrega cai no próximo lote
+    const int n = count_;
+    count_ = 0;
+    for (int i = 0; i < listenerCount_; ++i) listeners_[i]->onGameEvents(events_, n);
+}
+
+bool GameEventQueue::subscribe(IGameEventListener* listener) {
+    if (!listener) return false;
+    for (int i = 0; i < listenerCount_; ++i) if (listeners_[i] == listener) return true;
+    if (listenerCount_ == MAX_LISTENERS) return false;
+    listeners_[listenerCount_++] = listener;
+    return true;
+}
+
+void GameEventQueue::unsubscribe(IGameEventListener* listener) {
+    for (int i = 0; i < listenerCount_; ++i) {
+        if (listeners_[i] != listener) continue;
+        for (int j = i + 1; j < listenerCount_; ++j) listeners_[j - 1] = listeners_[j];
+        listeners_[--listenerCount_] = nullptr;
+        return;
+    }
+}
+
+void GameAudioEvents::onGameEvents(const GameEvent* events, int count) {
+    if (!audio_) return;
+    IAudioSystem& audio = *audio_;
+    for (int i = 0; i < count; ++i) {
+        const GameEvent& ev = events[i];
+        switch (ev.type) {
+            case GameEventType::ROUND_STARTED: audio.playBeep(520.0, 40, 0.15f, false); break;
+            case GameEventType::PAUSED:        audio.playBeep(ev.count ? 440.0 : 520.0, 30, 0.12f, false); break;
+            case GameEventType::MOVED:         audio.playMovementSound(); break;
+            case GameEventType::SOFT_DROP:     audio.playSoftDropSound(); break;
+            case GameEventType::HARD_DROP:     audio.playHardDropSound(); break;
+            case GameEventType::KICKED:        audio.playKickSound(); break;
+            case GameEventType::ROTATED:       audio.playRotationSound(ev.count > 0); break;
+            case GameEventType::LOCKED:        audio.playBeep(220.0, 25, 0.12f, true); break;
+            case GameEventType::LINES_CLEARED:
+                audio.playComboSound(ev.value);
+                if (ev.count == 4) audio.playTetrisSound();
+                else audio.playBeep(440.0 + ev.count * 110.0, 30 + ev.count * 10, 0.18f, false);
+                break;
+            case GameEventType::LEVEL_UP:      audio.setMusicLevel(ev.value); break;
+            case GameEventType::GAME_OVER:
+                audio.playGameOverSound();
+                audio.setMusicLevel(-1);
+                break;
+        }
+    }
+}
+
+void GameMetricsEvents::onGameEvents(const GameEvent* events, int count) {
+    static const Metrics::Id mLocked = Metrics::counter("pieces_locked");
+    static const Metrics::Id mLines = Metrics::counter("lines_cleared");
+    uint64_t locked = 0, lines = 0;
+    for (int i = 0; i < count; ++i) {
+        if (events[i].type == GameEventType::LOCKED) locked++;
+        else if (events[i].type == GameEventType::LINES_CLEARED) lines += (uint64_t)events[i].count;
+    }
+    if (locked) Metrics::add(mLocked, locked);
+    if (lines) Metrics::add(mLines, lines);
+}
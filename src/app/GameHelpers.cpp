@@ -1,6 +1,6 @@
 #include "app/GameHelpers.hpp"
 
-extern const int COLS;
+extern int COLS;
 
 void newActive(Active& a, int idx) {
     a.idx = idx;
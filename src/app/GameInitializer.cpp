@@ -5,6 +5,7 @@
 #include "input/InputManager.hpp"
 #include "ConfigManager.hpp"
 #include "config/ConfigApplicator.hpp"
+#include "config/ConfigCache.hpp"
 #include "render/RenderLayer.hpp"
 #include "render/RenderManager.hpp"
 #include "input/KeyboardInput.hpp"
@@ -15,18 +16,53 @@
 #include "pieces/Piece.hpp"
 #include "app/GameState.hpp"
 #include "app/GameHelpers.hpp"
+#include "app/FrameScheduler.hpp"
+#include "app/Tracing.hpp"
 #include "render/GameStateBridge.hpp"
+#include "render/LayoutCache.hpp"
+#include "render/Layers.hpp"
+#include "render/RendererProbe.hpp"
+#include "render/SoftRaster.hpp"
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
+#include <cstdlib>
 
 // External globals from dropblocks.cpp
 extern ThemeManager themeManager;
 extern PieceManager pieceManager;
 extern VisualEffectsView g_visualView;
 extern std::vector<Piece> PIECES;
+extern std::string PIECES_FILE_PATH;
+
+namespace {
+
+// Carga que não depende de SDL de vídeo: config e peças
+struct LoadJob {
+    explicit LoadJob(ConfigManager& c) : config(c) {}
+
+    ConfigManager& config;
+    bool ok = false;
+    StartupTimings timings;
+};
+
+void runLoadJob(LoadJob& job) {
+    Trace::setThreadName("Loader");
+    job.ok = GameInit::loadGameData(job.config, &job.timings);
+    for (StartupTimings::Phase& p : job.timings.phases) p.worker = true;
+}
+
+int SDLCALL loadJobMain(void* job) {
+    runLoadJob(*static_cast<LoadJob*>(job));
+    return 0;
+}
+
+} // namespace
 
 bool GameInitializer::initializeSDL() {
     if (sdlInitialized_) return true;
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_JOYSTICK) < 0) {
+    // Joysticks entram depois (GameInit::initializeJoysticks): a enumeração é o que pesa
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         DebugLogger::error(std::string("SDL could not initialize: ") + SDL_GetError());
         return false;
     }
@@ -47,58 +83,176 @@ bool GameInitializer::initializeAudio(AudioSystem& audio) {
     return true;
 }
 
-bool GameInitializer::initializeInput(InputManager& inputManager) {
+bool GameInitializer::initializeInput(InputManager& inputManager, bool joysticks) {
     if (inputInitialized_) return true;
     
     // Add keyboard input
     auto keyboardInput = std::make_unique<KeyboardInput>();
     inputManager.addHandler(std::move(keyboardInput));
     
-    // Add joystick input
-    auto joystickInput = std::make_unique<JoystickInput>();
-    if (joystickInput->initialize()) {
-        DebugLogger::info("Joystick input initialized successfully");
-        inputManager.addHandler(std::move(joystickInput));
-    } else {
-        DebugLogger::warning("No joystick/controller found, continuing with keyboard only");
-    }
+    if (joysticks) GameInit::initializeJoysticks(inputManager);
     
     inputInitialized_ = true;
     return true;
 }
 
-bool GameInitializer::initializeConfig(ConfigManager& /*configManager*/) {
+bool GameInitializer::initializeConfig(ConfigManager& configManager) {
     if (configInitialized_) return true;
+    if (!GameInit::loadGameData(configManager)) return false;
     configInitialized_ = true;
     return true;
 }
 
-bool GameInitializer::initializeWindow(SDL_Window*& win, SDL_Renderer*& ren) {
-    if (windowInitialized_) return true;
+bool GameInitializer::createWindow(SDL_Window*& win) {
     SDL_DisplayMode dm; if (SDL_GetCurrentDisplayMode(0, &dm) != 0) return false;
     int SW = dm.w, SH = dm.h;
     win = SDL_CreateWindow("DropBlocks", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SW, SH, SDL_WINDOW_FULLSCREEN | SDL_WINDOW_ALLOW_HIGHDPI);
-    if (!win) return false;
-    ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    return win != nullptr;
+}
+
+bool GameInitializer::createRenderer(SDL_Window* win, SDL_Renderer*& ren, bool vsync, int driver) {
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+    // Só o modo VSYNC bloqueia no Present; os outros são ritmados pelo FrameScheduler
+    const Uint32 vsyncFlag = vsync ? SDL_RENDERER_PRESENTVSYNC : 0;
+    // RENDER_DRIVER=software (ou o probe escolheu) vai para o frame de software, não para o do SDL
+    const bool forcedSoftware = driver >= 0 && driver == RendererProbe::driverIndex("software");
+    ren = driver >= 0 && !forcedSoftware ? SDL_CreateRenderer(win, driver, vsyncFlag) : nullptr;
+    if (!ren && driver >= 0 && !forcedSoftware) DebugLogger::warning(std::string("Render driver failed, using SDL default: ") + SDL_GetError());
+    if (!ren && !forcedSoftware) ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED | vsyncFlag);
+    if (!ren) {
+        // Sem GPU: o frame inteiro na CPU e uma cópia para a janela por Present
+        if (!forcedSoftware) DebugLogger::warning(std::string("No accelerated renderer, using the software frame: ") + SDL_GetError());
+        ren = SoftRaster::createFrame(win);
+    }
     if (!ren) { SDL_DestroyWindow(win); return false; }
+    DebugLogger::info("Renderer: " + RendererProbe::driverName(ren) + (SoftRaster::isFrameRenderer(ren) ? " (frame)" : ""));
+    return true;
+}
+
+int GameInitializer::pickRenderDriver(SDL_Window* win, const GameConfig& game) {
+    probeRenderer_ = false;
+    std::string mode = game.renderDriver;
+    for (char& c : mode) c = (char)toupper((unsigned char)c);
+    if (mode.empty() || mode == "AUTO") return -1;
+    if (mode == "PROBE") {
+        std::string cached;
+        if (RendererProbe::loadChoice(game.renderProbeFile, RendererProbe::machineKey(win), cached)) {
+            int index = RendererProbe::driverIndex(cached);
+            if (index >= 0) return index;
+        }
+        probeRenderer_ = true;  // Mede depois da config aplicada (as layers precisam de tema/layout)
+        return -1;
+    }
+    int index = RendererProbe::driverIndex(game.renderDriver);
+    if (index < 0) DebugLogger::warning("Unknown RENDER_DRIVER '" + game.renderDriver + "', using SDL default");
+    return index;
+}
+
+bool GameInitializer::probeRenderer(SDL_Window* win, SDL_Renderer*& ren, bool vsync, const GameState& state,
+                                    const GameConfig& game) {
+    const int PROBE_FRAMES = 120;
+    SoftRaster::destroyRenderer(ren);  // Um renderer por janela: o probe cria os seus
+    ren = nullptr;
+    std::vector<RendererProbe::Sample> samples = RendererProbe::measure(win, state, PROBE_FRAMES);
+    std::string best = RendererProbe::fastest(samples);
+    int index = best.empty() ? -1 : RendererProbe::driverIndex(best);
+    if (!createRenderer(win, ren, vsync, index)) return false;
+    if (!best.empty()) RendererProbe::saveChoice(game.renderProbeFile, RendererProbe::machineKey(win), best, samples);
+    return true;
+}
+
+bool GameInitializer::initializeWindow(SDL_Window*& win, SDL_Renderer*& ren, bool vsync) {
+    if (windowInitialized_) return true;
+    if (!createWindow(win) || !createRenderer(win, ren, vsync)) return false;
     windowInitialized_ = true;
     return true;
 }
 
 bool GameInitializer::initializeGameState(GameState& state, AudioSystem& audio, ConfigManager& configManager, InputManager& inputManager) {
     if (gameStateInitialized_) return true;
-    if (!GameInit::initializeGame(state, audio, configManager, inputManager)) return false;
+    if (!initializeConfig(configManager)) return false;
+    if (!GameInit::applyGameConfig(state, audio, configManager, inputManager)) return false;
     gameStateInitialized_ = true;
     return true;
 }
 
+void GameInitializer::presentFirstFrame(const GameState& state, SDL_Renderer* ren) {
+    // Fundo + banner do layout já calculado; os painéis ainda sem cache de textura
+    LayoutCache layout;
+    db_layoutCalculate(layout, ren);
+    BackgroundLayer().render(ren, state, layout);
+    BannerLayer().render(ren, state, layout);
+    SDL_RenderSetClipRect(ren, nullptr);
+    SDL_ShowCursor(SDL_DISABLE);
+    SoftRaster::present(ren);
+}
+
 bool GameInitializer::initializeComplete(AudioSystem& audio, InputManager& inputManager, ConfigManager& configManager, GameState& state, SDL_Window*& win, SDL_Renderer*& ren) {
+    timings_ = StartupTimings();
+    const Uint64 bootStart = SDL_GetPerformanceCounter();
     if (!initializeSDL()) return false;
-    if (!initializeAudio(audio)) return false;
-    if (!initializeInput(inputManager)) return false;
-    if (!initializeConfig(configManager)) return false;
+    Uint64 t = timings_.add("SDL init", bootStart);
+    
+    // Config/peças em paralelo com a janela
+    LoadJob job(configManager);
+    SDL_Thread* loader = configInitialized_ ? nullptr : SDL_CreateThread(&loadJobMain, "dropblocks-load", &job);
+    if (!loader && !configInitialized_) {
+        DebugLogger::warning(std::string("Load thread unavailable, loading inline: ") + SDL_GetError());
+        runLoadJob(job);
+    }
+    
+    bool inputOk = initializeInput(inputManager, false);  // Sem return antes do join: job vive nesta pilha
+    bool windowOk = windowInitialized_ || createWindow(win);
+    t = timings_.add("Window", t);
+    
+    if (loader) {
+        SDL_WaitThread(loader, nullptr);
+        t = timings_.add("Wait for load", t);
+    }
+    timings_.merge(job.timings);
+    if (!inputOk) return false;
+    if (!configInitialized_) {
+        if (!job.ok) { DebugLogger::error("Failed to load configuration"); return false; }
+        configInitialized_ = true;
+    }
+    if (!windowOk) { DebugLogger::error(std::string("Failed to create window: ") + SDL_GetError()); return false; }
+    
+    // O renderer espera a config: VSYNC ou não depende de FRAME_PACING, o driver de RENDER_DRIVER
+    const GameConfig& gameCfg = configManager.getGame();
+    const bool vsync = parseFramePacing(gameCfg.framePacing) == FramePacing::VSYNC;
+    if (!windowInitialized_) {
+        if (!createRenderer(win, ren, vsync, pickRenderDriver(win, gameCfg))) {
+            DebugLogger::error(std::string("Failed to create renderer: ") + SDL_GetError());
+            return false;
+        }
+        windowInitialized_ = true;
+        t = timings_.add("Renderer", t);
+    }
+    
+    // Tema e layout aplicados antes do primeiro frame; o áudio recebe a config
+    // aqui e só abre no segundo estágio
     if (!initializeGameState(state, audio, configManager, inputManager)) return false;
-    if (!initializeWindow(win, ren)) return false;
+    t = timings_.add("Apply config", t);
+    
+    if (probeRenderer_) {
+        probeRenderer_ = false;
+        if (!probeRenderer(win, ren, vsync, state, gameCfg)) {
+            DebugLogger::error(std::string("Failed to create renderer: ") + SDL_GetError());
+            return false;
+        }
+        t = timings_.add("Renderer probe", t);
+    }
+    
+    presentFirstFrame(state, ren);
+    timings_.add("First frame", t);
+    timings_.totalMs = (double)(SDL_GetPerformanceCounter() - bootStart) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    DebugLogger::info("Startup: " + timings_.summary());
+    
+    // Segundo estágio: áudio numa thread, joysticks no primeiro frame do GameLoop
+    if (!audioInitialized_) {
+        deferred_.begin(audio, inputManager, configManager, &timings_);
+        audioInitialized_ = true;
+    }
     return true;
 }
 
@@ -168,15 +322,76 @@ bool initializeWindow(SDL_Window*& win, SDL_Renderer*& ren) {
     return true;
 }
 
+bool initializeJoysticks(InputManager& inputManager) {
+    if (SDL_InitSubSystem(SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER) != 0) {
+        DebugLogger::warning(std::string("SDL joystick init failed: ") + SDL_GetError());
+        return false;
+    }
+    // Sem controle agora o handler fica desconectado: SDL_JOYDEVICEADDED o liga depois
+    auto joystickInput = std::make_unique<JoystickInput>();
+    if (joystickInput->initialize()) DebugLogger::info("Joystick input initialized successfully");
+    inputManager.addHandler(std::move(joystickInput));
+    return true;
+}
+
 bool initializeGame(GameState& state, AudioSystem& audio, ConfigManager& configManager, InputManager& inputManager) {
+    return loadGameData(configManager) && applyGameConfig(state, audio, configManager, inputManager);
+}
+
+bool loadGameData(ConfigManager& configManager, StartupTimings* timings) {
+    Uint64 t = SDL_GetPerformanceCounter();
+    
+    // Cache binário opcional (quiosque): pula o parse dos .cfg/.pieces se ainda valer
+    const char* cachePath = std::getenv("DROPBLOCKS_CACHE");
+    bool fromCache = cachePath && *cachePath && ConfigCache::load(cachePath, configManager, pieceManager);
+    if (fromCache) {
+        if (timings) timings->add("Config cache", t);
+        configManager.applyOverrides();
+        return true;
+    }
+    
     // Load configuration using new system
     if (!configManager.loadAll()) {
         DebugLogger::error("Failed to load configuration");
         return false;
     }
+    if (timings) t = timings->add("Config", t);
+    
+    // Carregar peças (PIECES_FILE do .cfg; vazio = conjunto embutido, sem parse)
+    if (!configManager.getPieces().piecesFilePath.empty()) PIECES_FILE_PATH = configManager.getPieces().piecesFilePath;
+    bool piecesOk = pieceManager.loadPiecesFile();
+    if (!piecesOk) {
+        pieceManager.seedFallback();
+    }
+    if (timings) t = timings->add("Pieces", t);
+    
+    if (cachePath && *cachePath) {
+        ConfigCache::save(cachePath, configManager, pieceManager);
+        if (timings) timings->add("Cache write", t);
+    }
+    configManager.applyOverrides();  // Depois do save: o cache guarda só o que veio dos arquivos
+    return true;
+}
+
+bool applyGameConfig(GameState& state, AudioSystem& audio, ConfigManager& configManager, InputManager& inputManager) {
+    // Log: nível e arquivo valem a partir daqui (o parse do .cfg já saiu no stdout)
+    const GameConfig& gameCfg = configManager.getGame();
+    int logLevel = DebugLogger::DEBUG;
+    if (DebugLogger::parseLevel(gameCfg.logLevel, logLevel)) DebugLogger::setLevel(logLevel);
+    if (!gameCfg.logFile.empty()) {
+        DebugLogger::setLogFile(gameCfg.logFile, (size_t)std::max(0, gameCfg.logFileMaxKb) * 1024, gameCfg.logFileKeep);
+    }
+    if (gameCfg.traceSeconds > 0) Trace::enable(gameCfg.traceSeconds);
     
-    // Set dependencies for GameState (legacy compatibility)
-    state.setDependencies(&audio, &themeManager, &pieceManager, &inputManager, &configManager);
+    // Dependências do GameState: um slot tipado por interface
+    GameServices services;
+    services.provide<IAudioSystem>(&audio);
+    services.provide<IThemeManager>(&themeManager);
+    services.provide<IPieceManager>(&pieceManager);
+    services.provide<IInputManager>(&inputManager);
+    services.provide<IGameConfig>(&configManager);
+    if (!services.complete()) DebugLogger::error("GameState services missing: " + services.describe());
+    state.setServices(services);
     
     // Apply configuration to existing systems using ConfigApplicator
     ConfigApplicator::applyConfigToAudio(audio, configManager.getAudio());
@@ -191,21 +406,23 @@ bool initializeGame(GameState& state, AudioSystem& audio, ConfigManager& configM
     // Apply joystick configuration to InputManager
     ConfigApplicator::applyConfigToJoystick(inputManager, configManager.getInput());
     
-    // Carregar peças
-    bool piecesOk = pieceManager.loadPiecesFile();
-    if (!piecesOk) {
-        pieceManager.seedFallback();
-    }
-    
     // Aplicar tema
     ConfigApplicator::applyThemePieceColors(themeManager, PIECES);
     
+    // Gerador do sorteio: tipo e semente fixa opcional (replays re-semeiam por partida)
+    const PiecesConfig& piecesCfg = configManager.getPieces();
+    RngType rngType = RngType::PCG;
+    PieceRng::parseType(piecesCfg.rngType, rngType);
+    pieceManager.getRng().setType(rngType);
+    if (piecesCfg.rngSeed) pieceManager.seed(piecesCfg.rngSeed);
+
     // Initialize PieceManager after PIECES is loaded
     state.getPieces().initialize();
     
     char piecesInfo[256];
-    snprintf(piecesInfo, sizeof(piecesInfo), "Pieces: %zu, PreviewGrid=%d, Randomizer=%s, BagSize=%d",
-           PIECES.size(), pieceManager.getPreviewGrid(), (pieceManager.getRandomizerType() == RandType::BAG ? "bag" : "simple"), pieceManager.getRandBagSize());
+    snprintf(piecesInfo, sizeof(piecesInfo), "Pieces: %zu, PreviewGrid=%d, Randomizer=%s, BagSize=%d, RNG=%s",
+           PIECES.size(), pieceManager.getPreviewGrid(), PieceManager::randTypeName(pieceManager.getRandomizerType()), pieceManager.getRandBagSize(),
+           PieceRng::typeName(pieceManager.getRng().type()));
     DebugLogger::info(piecesInfo);
     
     char audioInfo[256];
@@ -2,31 +2,223 @@
 #include "app/GameState.hpp"
 #include "render/LayoutCache.hpp"
 #include "render/TextureCache.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
+#include "render/LayoutVariants.hpp"
+#include "render/TextTextureCache.hpp"
 #include "DebugOverlay.hpp"
 #include "DebugLogger.hpp"
 #include "ThemeManager.hpp"
+#include "ThemeLibrary.hpp"
 #include "input/KeyboardInput.hpp"
 #include "input/InputManager.hpp"
 #include "ConfigManager.hpp"
 #include <SDL2/SDL.h>
 #include "render/RenderManager.hpp"
 #include "render/GameStateBridge.hpp"
+#include "render/VideoCapture.hpp"
+#include "render/CrtShader.hpp"
+#include "render/SoftRaster.hpp"
+#include "render/MarqueeDisplay.hpp"
+#include "app/FrameScheduler.hpp"
+#include "app/GameClock.hpp"
+#include "app/DeferredStartup.hpp"
+#include "app/SimulationThread.hpp"
+#include "app/FrameProfiler.hpp"
+#include "app/Tracing.hpp"
+#include "app/Metrics.hpp"
+#include "app/LatencyProbe.hpp"
+#include "app/QualityGovernor.hpp"
+#include "app/AllocCounter.hpp"
+#include "app/FrameArena.hpp"
+#include "app/Replay.hpp"
+#include "app/SessionLog.hpp"
+#include "app/RewindBuffer.hpp"
+#include "app/ResumeFile.hpp"
+#include "app/SoakTest.hpp"
+#include "app/FrameBench.hpp"
+#include "input/ReplayInput.hpp"
+#include "input/BotInput.hpp"
+#include "input/AttractInput.hpp"
+#include "input/InputSampler.hpp"
+#include "ai/BotEngine.hpp"
+#include "net/SpectatorClient.hpp"
+#include "net/SpectatorPublisher.hpp"
+#include "config/ConfigApplicator.hpp"
+#include "config/ConfigWatcher.hpp"
+#include "pieces/PieceManager.hpp"
+#include "util/UiUtil.hpp"
+#include "util/ScreenshotWriter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
 
 extern ThemeManager themeManager;
+extern int CACHED_PANELS;
+extern int CACHED_LAYERS;
+extern PieceManager pieceManager;
+extern VisualEffectsView g_visualView;
+extern std::vector<Piece> PIECES;
+extern LayoutConfig layoutConfig;
+
+/**
+ * @brief Uma chamada de run(): tudo que vive enquanto o loop roda
+ *
+ * Cada modo (bot, attract, replay, telão, prática, resume, soak, bench...)
+ * monta o seu estado num setup*() próprio, entra no frame por um gancho e sai
+ * em teardown(). Os membros seguem a ordem em que eram criados, então também
+ * são destruídos na mesma ordem de antes.
+ */
+struct GameLoop::Session {
+    Session(GameLoop& loop, GameState& state, RenderManager& renderManager, SDL_Renderer* ren,
+            ConfigManager& configManager, InputManager& inputManager)
+        : loop(loop), state(state), renderManager(renderManager), ren(ren), configManager(configManager),
+          inputManager(inputManager), gameCfg(configManager.getGame()), spectating(!gameCfg.spectateSource.empty()),
+          player(&inputManager), stepMs(gameCfg.simStepMs) {}
+
+    void setup();
+    /// Um frame; false = sair do loop
+    bool frame();
+    void teardown();
+    bool gameRunning() const { return sim ? sim->isRunning() || sim->snapshots().readBuffer().running : db_isRunning(state); }
+
+    // Setup, na ordem em que roda
+    void setupLayout();
+    void setupPlayers();
+    void setupReplay();
+    void setupPractice();
+    void setupFrameServices();
+    void setupSessionOutputs();
+    void bindInput();
+    void startSimulation();
+
+    // Ganchos do frame
+    void updateLayoutInfo();
+    void refreshPanels();
+    void applyQuality();
+    void selectTheme(int index);
+    void trackResume(Uint32 boardVersion, bool over, const GameSnapshot* snap);
+    void updateAttract();
+    bool updateRunModes();
+    void checkLostTargets();
+    void checkResize();
+    void pollReload();
+    bool threadedFrame();
+    void singleThreadedFrame(int steps);
+    int planSpectator(int steps);
+    void runSteps(int steps);
+    bool skipIdleFrame();
+    void drawFrame();
+    void drawOverlay();
+    void screenshotIfRequested(Uint32 requests);
+    void present(Uint32 inputVersion, Uint64 inputStamp, const GameSnapshot* snap);
+    void finishFrame(double workMs, double simMs, int steps);
+
+    GameLoop& loop;
+    GameState& state;
+    RenderManager& renderManager;
+    SDL_Renderer* ren;
+    ConfigManager& configManager;
+    InputManager& inputManager;
+    const GameConfig& gameCfg;
+    const bool spectating;    // SPECTATE_SOURCE: esta cópia só assiste; sem bot, attract nem replay
 
-void GameLoop::run(GameState& state, RenderManager& renderManager, SDL_Renderer* ren, ConfigManager& configManager, InputManager& inputManager) {
-    if (running_) { DebugLogger::warning("Game loop is already running"); return; }
-    running_ = true;
     LayoutCache layoutCache;
     TextureCache textureCache;
+    LayoutVariants layoutVariants;  // Outras resoluções já vistas, com os painéis assados
+    TextTextureCache textCache;
     DebugOverlay debugOverlay;
+    int lastWidth = 0, lastHeight = 0;
+    bool panelsWarm = false;
+
+    std::unique_ptr<BotEngine> botEngine;
+    std::unique_ptr<BotInput> bot;
+    IInputManager* player;
+    std::unique_ptr<BotEngine> attractEngine;
+    std::unique_ptr<AttractInput> attract;
+
+    ReplayData replay;
+    std::unique_ptr<ReplayPlayer> replayPlayer;
+    std::unique_ptr<ReplayRecorder> replayRecorder;
+    int stepMs;
+    std::unique_ptr<SpectatorPublisher> publisher;
+    std::unique_ptr<SpectatorClient> spectatorClient;
+    std::unique_ptr<SpectatorInput> spectator;
+
+    std::unique_ptr<RewindBuffer> rewind;
+    ResumeFile resume;
+    std::unique_ptr<GameSnapshot> resumeSnap;
+    Uint32 resumeVersion = 0, resumeSavedAt = 0;
+    bool resumeOver = false;
+
+    std::unique_ptr<ConfigWatcher> watcher;
+    FrameScheduler scheduler;
+    FramePacing pacing = FramePacing::VSYNC;
+    bool attractPacing = false;  // Scheduler reconfigurado para a demo
+    std::string pacingName;
+    std::unique_ptr<SimulationThread> sim;
+    FrameProfiler profiler;
+    int secUpdate = -1, secInput = -1, secRender = -1, secPresent = -1;
+    QualityGovernor quality;
+    const Metrics::Id mFrame = Metrics::histogram("frame_ms", {4, 8, 12, 16.7, 20, 25, 33.3, 50, 100});
+    const Metrics::Id mPresent = Metrics::histogram("present_ms", {0.5, 1, 2, 4, 8, 16.7, 33.3});
+    std::unique_ptr<MetricsExporter> metrics;
+    std::unique_ptr<LatencyProbe> latency;
+    InputSampler sampler;
+    AllocCounter::FrameMeter allocMeter;
+    FrameArena& arena = frameArena();
+    ManualClock simClock;
+    ScreenshotWriter screenshots;
+    Uint32 lastScreenshotRequests = 0;
+    VideoCapture video;
+    CrtShader crt;
+    SessionLog sessionLog;
+    MarqueeDisplay marquee;
+    ThemeLibrary themes;
+    int themeBeforeDemo = 0;
+    Uint32 nextDemoTheme = 0;
+    Uint32 soakThemeMs = 0, nextSoakTheme = 0;
+
+    bool firstFrame = true;
+    bool idleAllowed = false;
+    Uint32 drawnRedraw = 0, drawnWindowEvents = 0;
+    bool drawnIdle = false;   // O último frame desenhado já era a tela parada
+    Uint32 seenTargetsResets = 0, seenDeviceResets = 0;
+};
+
+void GameLoop::Session::setup() {
+    setupLayout();
+    setupPlayers();
+    setupReplay();
+    setupPractice();
+    setupFrameServices();
+    setupSessionOutputs();
+    bindInput();
+    startSimulation();
+    scheduler.start();
     
+    // IDLE_RENDER: pausa/game over parados não redesenham; o último Present fica na tela
+    idleAllowed = gameCfg.idleRender && !sim && !spectator && !video.isRunning();
+    seenTargetsResets = inputManager.getTargetsResetCount();
+    seenDeviceResets = inputManager.getDeviceResetCount();
+}
+
+void GameLoop::Session::setupLayout() {
     // Calculate layout once at startup
     db_layoutCalculate(layoutCache, ren);
-    int lastWidth = layoutCache.SWr;
-    int lastHeight = layoutCache.SHr;
+    lastWidth = layoutCache.SWr;
+    lastHeight = layoutCache.SHr;
+    updateLayoutInfo();
     
-    // Update debug overlay with layout info
+    // Update debug overlay with config file info
+    debugOverlay.setConfigInfo(configManager.getConfigPaths());
+    debugOverlay.setStartupTimings(loop.startupTimings_);
+    // Sem refreshPanels() aqui: o primeiro frame sai pelo caminho imediato e o
+    // cache aquece logo depois do primeiro Present (boot em dois estágios)
+}
+
+// Update debug overlay with layout info
+void GameLoop::Session::updateLayoutInfo() {
     std::string scaleModeStr = (layoutCache.scaleMode == ScaleMode::STRETCH) ? "STRETCH" : 
                                 (layoutCache.scaleMode == ScaleMode::NATIVE) ? "NATIVE" : "AUTO";
     debugOverlay.setLayoutInfo(layoutCache.virtualWidth, layoutCache.virtualHeight,
@@ -34,82 +226,687 @@ void GameLoop::run(GameState& state, RenderManager& renderManager, SDL_Renderer*
                                layoutCache.scaleX, layoutCache.scaleY,
                                layoutCache.offsetX, layoutCache.offsetY,
                                scaleModeStr);
+}
+
+// Pre-render static textures (CACHED_PANELS=0 keeps the immediate path for comparison)
+void GameLoop::Session::refreshPanels() {
+    panelsWarm = true;
+    textCache.clear();  // scales/colors may have changed
+    if (CACHED_PANELS) {
+        textureCache.update(ren, layoutCache, themeManager);
+        layoutCache.panels = &textureCache;
+        layoutCache.texts = &textCache;
+    } else {
+        textureCache.cleanup();
+        layoutCache.panels = nullptr;
+        layoutCache.texts = nullptr;
+    }
+    debugOverlay.setCustomValue("PANELS", CACHED_PANELS ? (textureCache.isValid() ? "CACHED" : "FALLBACK") : "IMMEDIATE");
+    renderManager.setRetained(CACHED_LAYERS != 0);
+    renderManager.invalidateCache();
+    state.requestRedraw();
+}
+
+void GameLoop::Session::setupPlayers() {
+    // BOT_ENABLED: o bot joga no lugar do jogador (pause/ESC/D/F12 seguem no input vivo)
+    if (gameCfg.botEnabled && gameCfg.replayFile.empty() && !spectating) {
+        botEngine.reset(new BotEngine(gameCfg.botThreads));
+        botEngine->setWeights(BotWeights{gameCfg.botWeightHeight, gameCfg.botWeightLines,
+                                         gameCfg.botWeightHoles, gameCfg.botWeightBumpiness});
+        botEngine->setLookahead(gameCfg.botLookahead);
+        botEngine->setBudgetMs(gameCfg.botBudgetMs);
+        bot.reset(new BotInput(*botEngine, state, &inputManager));
+        bot->setActionDelayMs((Uint32)std::max(0, gameCfg.botActionDelayMs));
+        bot->setAutoRestart(true, 3000);
+        player = bot.get();
+        DebugLogger::info("Bot enabled: " + std::to_string(botEngine->concurrency()) + " search thread(s), budget " +
+                          std::to_string(gameCfg.botBudgetMs) + "ms");
+    }
     
-    // Update debug overlay with config file info
-    debugOverlay.setConfigInfo(configManager.getConfigPaths());
+    // ATTRACT_IDLE_SECONDS: demo do bot (barata) quando ninguém mexe; o render cai para ATTRACT_FPS
+    if (gameCfg.attractIdleSeconds > 0 && !bot && gameCfg.replayFile.empty() && !spectating) {
+        attractEngine.reset(new BotEngine(gameCfg.attractBotThreads));
+        attractEngine->setWeights(BotWeights{gameCfg.botWeightHeight, gameCfg.botWeightLines,
+                                             gameCfg.botWeightHoles, gameCfg.botWeightBumpiness});
+        attractEngine->setLookahead(gameCfg.attractLookahead);
+        attractEngine->setBudgetMs(gameCfg.attractBotBudgetMs);
+        attract.reset(new AttractInput(inputManager, state, *attractEngine, (Uint32)gameCfg.attractIdleSeconds * 1000));
+        attract->setActionDelayMs((Uint32)std::max(0, gameCfg.attractActionDelayMs));
+        player = attract.get();
+        DebugLogger::info("Attract mode after " + std::to_string(gameCfg.attractIdleSeconds) + "s idle, demo at " +
+                          std::to_string(gameCfg.attractFps) + " fps");
+    }
+}
+
+void GameLoop::Session::setupReplay() {
+    // Replay: tocar REPLAY_FILE no lugar do input ou gravar cada partida
+    if (spectating) {
+        // Nada a tocar nem gravar: a partida vem do gabinete
+    } else if (!gameCfg.replayFile.empty()) {
+        if (loadReplay(gameCfg.replayFile, replay)) {
+            if (replay.configHash != replayConfigHash(replay.stepMs)) {
+                DebugLogger::warning("Replay was recorded with a different config; playback will likely diverge");
+            }
+            replayPlayer.reset(new ReplayPlayer(replay, &inputManager, &state));
+            stepMs = replay.stepMs;  // Os ticks só batem com o mesmo passo
+        }
+    } else if (!gameCfg.replayRecordDir.empty()) {
+        replayRecorder.reset(new ReplayRecorder(*player, state, pieceManager.getRng(),
+                                                gameCfg.replayRecordDir, (uint16_t)stepMs));
+        if (attract) attract->setRecorder(replayRecorder.get());
+    }
     
-    // Pre-render static textures
-    textureCache.update(ren, layoutCache, themeManager);
+    // SPECTATE_PORT: o stream do recorder vai para os telões (sem arquivo se não há REPLAY_RECORD_DIR)
+    if (gameCfg.spectatePort > 0 && !replayPlayer && !spectating) {
+        publisher.reset(new SpectatorPublisher(state, gameCfg.netChecksumTicks));
+        if (publisher->start(gameCfg.spectatePort, replayConfigHash((uint16_t)stepMs), (uint16_t)stepMs)) {
+            if (!replayRecorder) {
+                replayRecorder.reset(new ReplayRecorder(*player, state, pieceManager.getRng(), "", (uint16_t)stepMs));
+                replayRecorder->setEnabled(false);  // Sem setRecorder() no attract: ele religaria a gravação
+            }
+            replayRecorder->setObserver(publisher.get());
+        } else {
+            publisher.reset();
+        }
+    }
+    if (spectating) {
+        spectatorClient.reset(new SpectatorClient());
+        if (spectatorClient->start(gameCfg.spectateSource, replayConfigHash((uint16_t)stepMs), (uint16_t)stepMs)) {
+            spectator.reset(new SpectatorInput(*spectatorClient, inputManager, pieceManager.getRng(),
+                                               (uint32_t)(gameCfg.spectateBufferMs / std::max(1, stepMs))));
+        } else {
+            spectatorClient.reset();
+        }
+    }
+}
+
+void GameLoop::Session::setupPractice() {
+    // PRACTICE_MODE: anel de snapshots para o KEY_REWIND; precisa da lógica nesta
+    // thread e de uma partida que ninguém reproduz depois (replay, telão)
+    if (gameCfg.practiceMode) {
+        if (gameCfg.threadedMode || replayPlayer || replayRecorder || spectating || bot) {
+            DebugLogger::warning("PRACTICE_MODE is ignored with THREADED_MODE, replays, spectating, publishing or the bot");
+        } else {
+            rewind.reset(new RewindBuffer(gameCfg.rewindSlots, gameCfg.rewindIntervalTicks));
+            DebugLogger::info("Practice mode: " + std::to_string(rewind->capacity()) + " rewind slot(s), " +
+                              std::to_string(rewind->capacity() * sizeof(GameSnapshot) / 1024) + " KB");
+        }
+    }
+    // RESUME_FILE: a partida em andamento vai para o disco e volta depois de um corte
+    if (!gameCfg.resumeFile.empty() && !replayPlayer && !replayRecorder && !spectating && !bot) {
+        resume.start(gameCfg.resumeFile, replayConfigHash((uint16_t)stepMs));
+    }
+    if (resume.isRunning()) resumeSnap.reset(new GameSnapshot());
+}
+
+// Depois de cada lote de passos (ou snapshot novo do THREADED_MODE): grava o
+// último lock quando RESUME_SAVE_MS venceu; game over apaga o arquivo
+void GameLoop::Session::trackResume(Uint32 boardVersion, bool over, const GameSnapshot* snap) {
+    if (over) {
+        if (!resumeOver) resume.discard();
+        resumeOver = true;
+        return;
+    }
+    resumeOver = false;
+    if (boardVersion == resumeVersion || SDL_GetTicks() - resumeSavedAt < (Uint32)gameCfg.resumeSaveMs) return;
+    if (!snap) {
+        db_captureSnapshot(state, *resumeSnap);
+        snap = resumeSnap.get();
+    }
+    resume.submit(*snap);
+    resumeVersion = boardVersion;
+    resumeSavedAt = SDL_GetTicks();
+}
+
+void GameLoop::Session::setupFrameServices() {
+    // CONFIG_WATCH_MS: os arquivos são relidos numa thread; aqui só o diff/aplicação
+    if (gameCfg.configWatchMs > 0) {
+        watcher.reset(new ConfigWatcher(configManager.getConfigPaths(), pieceManager.getLoadedPath(),
+                                        (Uint32)gameCfg.configWatchMs));
+        if (!watcher->start()) watcher.reset();
+    }
     
-    // Frame timing
-    Uint32 lastFrameTime = SDL_GetTicks();
+    // Frame pacing + fixed-step simulation: the logic clock only advances in
+    // SIM_STEP_MS increments, so gravity/timer don't depend on the display rate
+    pacing = parseFramePacing(gameCfg.framePacing);
+    if (pacing == FramePacing::VSYNC && SoftRaster::isFrameRenderer(ren)) pacing = FramePacing::CAPPED;  // Present não espera o refresh
+    scheduler.configure(pacing, gameCfg.targetFps, stepMs);
+    pacingName = framePacingName(scheduler.getMode());
+    DebugLogger::info("Frame pacing: " + pacingName + ", sim step " + std::to_string(scheduler.getStepMs()) + "ms");
     
-    while (db_isRunning(state) && running_) {
-        if (!ren) { DebugLogger::error("Renderer is null; aborting main loop"); break; }
-        
-        // Garantir que o cursor permaneça oculto
-        SDL_ShowCursor(SDL_DISABLE);
-        
-        // Measure frame start time
-        Uint32 frameStart = SDL_GetTicks();
-        
-        // Debug toggle is now handled by InputManager in state.update()
-        
-        // Only recalculate layout if window size changed
-        int currentWidth, currentHeight;
-        SDL_GetRendererOutputSize(ren, &currentWidth, &currentHeight);
-        if (currentWidth != lastWidth || currentHeight != lastHeight) {
-            db_layoutCalculate(layoutCache, ren);
-            
-            // Update debug overlay with new layout info
-            std::string scaleModeStr = (layoutCache.scaleMode == ScaleMode::STRETCH) ? "STRETCH" : 
-                                        (layoutCache.scaleMode == ScaleMode::NATIVE) ? "NATIVE" : "AUTO";
-            debugOverlay.setLayoutInfo(layoutCache.virtualWidth, layoutCache.virtualHeight,
-                                       layoutCache.SWr, layoutCache.SHr,
-                                       layoutCache.scaleX, layoutCache.scaleY,
-                                       layoutCache.offsetX, layoutCache.offsetY,
-                                       scaleModeStr);
-            
-            textureCache.update(ren, layoutCache, themeManager);
-            lastWidth = currentWidth;
-            lastHeight = currentHeight;
+    // Tempos por fase e por layer (página PERF do overlay / PROFILE_CSV)
+    secUpdate = profiler.addSection("Update");    // inclui Input
+    secInput = profiler.addSection("Input");
+    secRender = profiler.addSection("Render");    // layers + overlay
+    secPresent = profiler.addSection("Present");
+    renderManager.setProfiler(&profiler);
+    debugOverlay.setProfiler(&profiler);
+    if (!gameCfg.profileCsv.empty()) profiler.openCsv(gameCfg.profileCsv);
+    // QUALITY_GOVERNOR: efeitos caros saem em ordem quando os frames estouram o orçamento
+    quality.configure(gameCfg.qualityGovernor, gameCfg.qualityBudgetMs > 0.0f ? (double)gameCfg.qualityBudgetMs
+                                                                              : 1000.0 / std::max(1, gameCfg.targetFps));
+    // TEXTURE_BUDGET_MB: teto para tudo que sai do renderTargetPool()
+    renderTargetPool().setVramBudget((size_t)std::max(0, gameCfg.textureBudgetMb) << 20);
+    // --bench-frames: timedemo, cada frame desenhado avança um frame de TARGET_FPS da partida
+    if (loop.bench_) {
+        const int steps = std::max(1, (int)std::lround(1000.0 / std::max(1, gameCfg.targetFps) / scheduler.getStepMs()));
+        scheduler.setFixedSteps(steps);
+        loop.bench_->begin(&profiler, steps);
+    }
+    
+    // METRICS_TARGET: gravar é um atômico por amostra; o envio roda numa thread
+    if (!gameCfg.metricsTarget.empty()) {
+        metrics.reset(new MetricsExporter(gameCfg.metricsTarget, gameCfg.metricsPrefix, (Uint32)std::max(0, gameCfg.metricsIntervalMs),
+                                          (size_t)std::max(0, gameCfg.metricsFileMaxKb) * 1024));
+        if (!metrics->start()) metrics.reset();
+    }
+    // LATENCY_PROBE: evento de input -> primeiro Present que mostra a ação
+    if (gameCfg.latencyProbe) latency.reset(new LatencyProbe());
+    debugOverlay.setLatencyProbe(latency.get());
+    // INPUT_THREAD: teclas do evdev com o timestamp do kernel, aplicadas no passo certo
+    if (gameCfg.inputThread && sampler.start()) inputManager.setSampler(&sampler);
+    // Build com DROPBLOCKS_ALLOC_TRACKING: alocações por frame no overlay e em Metrics
+    debugOverlay.setAllocMeter(AllocCounter::enabled() ? &allocMeter : nullptr);
+    // Rascunho do frame (textos do overlay, batches temporários): reset no topo de cada volta
+    arena.reserve((size_t)gameCfg.frameArenaKb << 10);
+    
+    simClock.set(SDL_GetTicks());
+    state.setClock(&simClock);
+}
+
+void GameLoop::Session::applyQuality() {
+    quality.apply(configManager.getVisual(), g_visualView);
+    layoutVariants.clear();  // Painéis assados no tier anterior
+    refreshPanels();
+}
+
+void GameLoop::Session::setupSessionOutputs() {
+    // F12: leitura do back buffer aqui, PNG e disco numa thread (sem thread: BMP na hora)
+    if (screenshots.start()) state.setScreenshotWriter(&screenshots);
+    lastScreenshotRequests = state.getScreenshotRequests();
+    // CAPTURE_VIDEO: cada frame numa textura do anel, lida alguns frames depois
+    if (!gameCfg.captureVideo.empty()) {
+        video.start(gameCfg.captureVideo, gameCfg.captureFps > 0 ? gameCfg.captureFps : gameCfg.targetFps,
+                    gameCfg.captureDelayFrames, (size_t)gameCfg.captureBudgetMb << 20);
+    }
+    // SESSION_LOG: cada game over vai para o log e o ranking por uma thread (não espera o disco)
+    if (!gameCfg.sessionLog.empty() && !spectating && gameCfg.replayFile.empty() &&
+        sessionLog.start(gameCfg.sessionLog, gameCfg.highScoreCount, gameCfg.sessionFsyncMs)) {
+        state.setSessionLog(&sessionLog, (gameCfg.botEnabled ? SessionRecord::BOT : 0u) |
+                                         (rewind ? SessionRecord::PRACTICE : 0u));
+    }
+    // MARQUEE_DISPLAY: topper na outra tela, depois do Present desta
+    if (sessionLog.isRunning()) marquee.setHighScores(&sessionLog);
+    int boardRows = 0, boardCols = 0;
+    if (gameCfg.marqueeDisplay >= 0 && db_getBoardSize(state, boardRows, boardCols)) {
+        marquee.start(gameCfg.marqueeDisplay, gameCfg.marqueeFps, boardCols, boardRows, SDL_RenderGetWindow(ren));
+    }
+    // KEY_THEME: paletas dos outros .cfg lidas agora; trocar é só trocar o ponteiro
+    themes.load(configManager, gameCfg.themeFiles);
+    // --soak: todas as paletas passam pela tela (caches refeitos a cada troca)
+    soakThemeMs = loop.soak_ && themes.size() > 1 ? (Uint32)loop.soak_->themeSeconds() * 1000 : 0;
+    nextSoakTheme = SDL_GetTicks() + soakThemeMs;
+}
+
+void GameLoop::Session::selectTheme(int index) {
+    themes.select(themeManager, index);
+    // A simulação lê as cores de PIECES no lock da peça e sobe o redraw no input
+    auto applyPieceColors = [&]() {
+        ConfigApplicator::applyThemePieceColors(themeManager, PIECES);
+        state.requestRedraw();
+    };
+    if (sim) sim->betweenSteps(applyPieceColors);
+    else applyPieceColors();
+    textureCache.requestRebake();  // Um painel por frame; textos e tabuleiro seguem a cor sozinhos
+    layoutVariants.clear();        // Painéis guardados estão na paleta antiga
+    renderManager.invalidateCache();
+    debugOverlay.setCustomValue("THEME", themes.name(themes.current()));
+    DebugLogger::info("Theme: " + themes.name(themes.current()));
+}
+
+void GameLoop::Session::bindInput() {
+    // A partida do replay começa do zero, com a semente conhecida
+    if (replayPlayer) {
+        state.setInput(replayPlayer.get());
+        pieceManager.seed(replay.seed);
+        state.restartRound();
+    } else if (replayRecorder) {
+        state.setInput(replayRecorder.get());
+        replayRecorder->beginRound();
+        state.restartRound();
+    } else if (bot) {
+        state.setInput(bot.get());
+    } else if (attract) {
+        state.setInput(attract.get());
+    } else if (spectator) {
+        state.setInput(spectator.get());
+    }
+    
+    // Corte de energia no meio da partida: ela volta de onde o último lock gravou, pausada
+    if (const GameSnapshot* saved = resume.saved()) {
+        if (state.restoreSnapshot(*saved)) {
+            state.setPaused(true);
+            DebugLogger::info("Resumed saved round: score " + std::to_string(state.getScoreValue()) +
+                              ", " + std::to_string(state.getLinesValue()) + " lines");
+        } else {
+            DebugLogger::warning("Resume file: saved round does not fit this game, starting fresh");
         }
-        
+        resume.dropSaved();
+    }
+    resumeVersion = state.getBoard().getVersion();
+    resumeSavedAt = SDL_GetTicks();
+}
+
+void GameLoop::Session::startSimulation() {
+    // THREADED_MODE: simulação numa thread própria publicando snapshots; esta
+    // thread só bombeia eventos, renderiza e apresenta (SDL exige as duas
+    // coisas na thread do vídeo). O telão precisa cercar cada passo
+    // (beforeStep/afterStep): só no loop single-threaded
+    if (gameCfg.threadedMode && !spectator) {
+        if (loop.deferred_) loop.deferred_->update();  // Joysticks antes: a simulação lê os handlers de input
+        db_prepareSnapshotView(state);
+        sim.reset(new SimulationThread(state, inputManager, scheduler.getStepMs()));
+        if (!sim->start()) sim.reset();  // Sem thread: cai no loop single-threaded
+    }
+    if (sim) {
+        lastScreenshotRequests = sim->snapshots().readBuffer().screenshotRequests;
+        DebugLogger::info("Threaded mode: simulation and render on separate threads");
+    }
+}
+
+bool GameLoop::Session::frame() {
+    arena.reset();
+    
+    // Garantir que o cursor permaneça oculto
+    SDL_ShowCursor(SDL_DISABLE);
+    
+    // Segundo estágio do boot: joysticks/áudio conforme ficam prontos, painéis após o primeiro Present
+    if (loop.deferred_ && loop.deferred_->isPending()) loop.deferred_->update();
+    if (!panelsWarm && !firstFrame) refreshPanels();
+    firstFrame = false;
+    
+    updateAttract();
+    if (!updateRunModes()) return false;
+    
+    // LOW_LATENCY: sleep here so input is read right before the deadline
+    scheduler.waitBeforeFrame();
+    int steps = scheduler.beginFrame();
+    allocMeter.beginFrame();
+    renderTargetPool().beginFrame();
+    DrawCalls::reset();
+    
+    checkLostTargets();
+    checkResize();
+    pollReload();
+    
+    if (sim) return threadedFrame();
+    singleThreadedFrame(steps);
+    return true;
+}
+
+// Demo do attract mode: menos frames; a simulação segue no mesmo passo
+void GameLoop::Session::updateAttract() {
+    if (attract && attract->isActive() != attractPacing) {
+        attractPacing = !attractPacing;
+        sessionLog.setSuspended(attractPacing);  // Partidas da demo não são de ninguém
+        if (attractPacing) scheduler.configure(FramePacing::CAPPED, std::max(4, gameCfg.attractFps), scheduler.getStepMs());
+        else scheduler.configure(pacing, gameCfg.targetFps, scheduler.getStepMs());
+        scheduler.start();
+        // THEME_ATTRACT_SECONDS: a demo passeia pelas paletas e a partida volta para a de antes
+        if (gameCfg.themeAttractSeconds > 0 && themes.size() > 1) {
+            if (attractPacing) {
+                themeBeforeDemo = themes.current();
+                nextDemoTheme = SDL_GetTicks() + (Uint32)gameCfg.themeAttractSeconds * 1000;
+            } else if (themes.current() != themeBeforeDemo) {
+                selectTheme(themeBeforeDemo);
+            }
+        }
+    }
+    if (attractPacing && gameCfg.themeAttractSeconds > 0 && themes.size() > 1 &&
+        (Sint32)(SDL_GetTicks() - nextDemoTheme) >= 0) {
+        nextDemoTheme += (Uint32)gameCfg.themeAttractSeconds * 1000;
+        selectTheme((themes.current() + 1) % themes.size());
+    }
+}
+
+// --bench-frames e --soak: false quando a rodada acabou
+bool GameLoop::Session::updateRunModes() {
+    if (loop.bench_ && (!replayPlayer || replayPlayer->done() || loop.bench_->full())) return false;
+    if (loop.soak_) {
+        if (loop.soak_->expired(SDL_GetTicks())) {
+            DebugLogger::info("Soak: duration reached");
+            return false;
+        }
+        if (soakThemeMs && (Sint32)(SDL_GetTicks() - nextSoakTheme) >= 0) {
+            nextSoakTheme += soakThemeMs;
+            selectTheme((themes.current() + 1) % themes.size());
+        }
+    }
+    return true;
+}
+
+// Render targets (ou o device) perdidos: cada cache refaz no próximo uso, os painéis já aqui
+void GameLoop::Session::checkLostTargets() {
+    if (inputManager.getTargetsResetCount() == seenTargetsResets && inputManager.getDeviceResetCount() == seenDeviceResets) return;
+    if (inputManager.getDeviceResetCount() != seenDeviceResets) renderTargetPool().markDeviceLost();
+    else renderTargetPool().markTargetsLost();
+    seenTargetsResets = inputManager.getTargetsResetCount();
+    seenDeviceResets = inputManager.getDeviceResetCount();
+    layoutVariants.clear();
+    if (panelsWarm) refreshPanels();
+}
+
+// Only recalculate layout if window size changed
+void GameLoop::Session::checkResize() {
+    int currentWidth, currentHeight;
+    SDL_GetRendererOutputSize(ren, &currentWidth, &currentHeight);
+    if (currentWidth == lastWidth && currentHeight == lastHeight) return;
+    // Tamanho já visto (rotação do kiosque, outro monitor): layout e painéis voltam prontos
+    if (CACHED_PANELS && panelsWarm &&
+        layoutVariants.swapTo(currentWidth, currentHeight, layoutConfig.scaleMode, layoutCache, textureCache)) {
+        textCache.clear();
+        renderManager.invalidateCache();
+        state.requestRedraw();
+    } else {
+        db_layoutCalculate(layoutCache, ren);
+        refreshPanels();
+    }
+    updateLayoutInfo();
+    const TexturePool& pool = renderTargetPool();
+    debugOverlay.setCustomValue("LAYOUTS", arena.format("%d kept, %u/%u reused, pool %zuK in %zu", layoutVariants.size(),
+                                                        layoutVariants.hits(), layoutVariants.hits() + layoutVariants.misses(),
+                                                        pool.freeBytes() >> 10, pool.freeCount()));
+    lastWidth = currentWidth;
+    lastHeight = currentHeight;
+}
+
+// Hot reload: invalida só os caches que dependem do que mudou
+void GameLoop::Session::pollReload() {
+    ConfigReload reload;
+    if (!watcher || !watcher->poll(reload)) return;
+    DB_TRACE_ZONE("Config reload");
+    unsigned changed = 0;
+    if (reload.config) {
+        changed |= ConfigApplicator::applyReloadedConfig(configManager, *reload.config, state, inputManager,
+                                                         themeManager, g_visualView, sim != nullptr);
+        if (quality.tier() > 0) quality.apply(configManager.getVisual(), g_visualView);  // A config nova com os cortes do tier
+    }
+    if (reload.pieces) {
+        bool shared = sim || botEngine || attractEngine;  // Outra thread lê as formas
+        changed |= ConfigApplicator::applyReloadedPieces(*reload.pieces, themeManager, shared);
+    }
+    if (changed & (ConfigChange::LAYOUT | ConfigChange::PIECES | ConfigChange::COLORS | ConfigChange::PANELS |
+                   ConfigChange::PIECE_COLORS)) {
+        layoutVariants.clear();  // Os outros tamanhos seriam refeitos com a config antiga
+    }
+    if (changed & (ConfigChange::LAYOUT | ConfigChange::PIECES)) {  // PIECES: miniaturas de NEXT/stats
+        db_layoutCalculate(layoutCache, ren);
+        updateLayoutInfo();
+    }
+    if ((changed & ConfigChange::PIECE_COLORS) && themes.current() != 0) {
+        selectTheme(themes.current());  // Paleta sem PIECE<n> pega as cores novas da config
+    }
+    if (changed & (ConfigChange::COLORS | ConfigChange::PANELS | ConfigChange::PIECE_COLORS | ConfigChange::LAYOUT)) {
+        refreshPanels();
+    }
+    if (changed) {
+        renderManager.invalidateCache();  // Formas, cores ou HUD das layers retidas
+        state.requestRedraw();
+    }
+}
+
+// THREADED_MODE: desenha o último snapshot publicado; false quando o jogo acabou
+bool GameLoop::Session::threadedFrame() {
+    SDL_PumpEvents();  // Fila de eventos consumida pela thread de simulação
+    bool freshSnapshot = sim->snapshots().acquire();
+    const GameSnapshot& snap = sim->snapshots().readBuffer();
+    if (!snap.running) return false;
+    for (int t = sim->takeDebugToggles(); t > 0; --t) debugOverlay.toggle();
+    if (int t = sim->takeThemeCycles()) selectTheme((themes.current() + t) % themes.size());
+    if (sim->takeTraceDumps()) Trace::dump(gameCfg.traceFile);
+    if (freshSnapshot && resume.isRunning()) trackResume(snap.boardVersion, snap.gameOver, &snap);
+    scheduler.markSimDone();
+    
+    db_bindSnapshot(&snap);
+    drawFrame();
+    db_bindSnapshot(nullptr);
+    screenshotIfRequested(snap.screenshotRequests);
+    scheduler.markRenderDone();
+    present(snap.inputVersion, snap.inputStamp, &snap);
+    
+    if (freshSnapshot) profiler.record(secUpdate, sim->lastBatchMs());  // Input fica na outra thread
+    finishFrame(scheduler.timings().renderMs, sim->lastBatchMs(), sim->lastBatchSteps());  // A simulação corre em paralelo
+    return true;
+}
+
+void GameLoop::Session::singleThreadedFrame(int steps) {
+    if (spectator) steps = planSpectator(steps);
+    else if (publisher && debugOverlay.isEnabled()) {
+        allocMeter.pause();
+        debugOverlay.setCustomValue("SPECTATE", arena.format("%d watching, %u KB sent, %u dropped",
+                                    publisher->subscribers(), publisher->bytesSent() / 1024,
+                                    publisher->dropped()));
+        allocMeter.resume();
+    }
+    
+    runSteps(steps);
+    state.dispatchEvents();  // Som e métricas dos passos do frame, num lote só
+    if (loop.soak_ && replayPlayer && replayPlayer->done()) {
+        // Fim do replay: a mesma partida de novo, do zero
+        replayPlayer.reset(new ReplayPlayer(replay, &inputManager, &state));
+        state.setInput(replayPlayer.get());
+        pieceManager.seed(replay.seed);
+        state.restartRound();
+    }
+    if (resume.isRunning()) trackResume(state.getBoard().getVersion(), state.isGameOver(), nullptr);
+    scheduler.markSimDone();
+    
+    if (skipIdleFrame()) return;
+    drawFrame();
+    screenshotIfRequested(state.getScreenshotRequests());
+    scheduler.markRenderDone();
+    present(state.getInputVersion(), state.getInputStamp(), nullptr);
+    
+    const FrameTimings& ft = scheduler.timings();
+    profiler.record(secUpdate, ft.simMs);
+    profiler.recordTicks(secInput, state.takeInputTicks());
+    finishFrame(ft.simMs + ft.renderMs, ft.simMs, ft.steps);
+}
+
+// SPECTATE_SOURCE: quantos passos o stream do gabinete já cobre
+int GameLoop::Session::planSpectator(int steps) {
+    steps = spectator->plan(steps);
+    if (steps == 0) {
+        // Esperando o gabinete: eventos continuam (ESC sai, D liga o overlay)
+        inputManager.update();
+        if (inputManager.shouldQuit()) state.setRunning(false);
+        if (inputManager.shouldToggleDebug()) debugOverlay.toggle();
+    }
+    if (debugOverlay.isEnabled()) {
+        allocMeter.pause();
+        const char* status = spectatorClient->incompatible() ? "incompatible"
+                           : !spectatorClient->connected() ? "connecting"
+                           : !spectator->watching() ? "waiting" : "live";
+        debugOverlay.setCustomValue("SPECTATE", arena.format("%s, lag %u ticks, %u KB, desync %u", status,
+                                    spectator->lagTicks(), spectatorClient->bytesReceived() / 1024,
+                                    spectator->desyncs()));
+        allocMeter.resume();
+    }
+    return steps;
+}
+
+void GameLoop::Session::runSteps(int steps) {
+    const Uint32 stepsTicks = SDL_GetTicks();
+    for (int i = 0; i < steps && db_isRunning(state) && loop.running_; ++i) {
+        if (spectator) spectator->beforeStep(state);
+        // Os passos deste frame cobrem os últimos steps * SIM_STEP_MS: cada um vê as teclas até o seu instante
+        if (sampler.isRunning()) inputManager.setSampleCutoff(stepsTicks - (Uint32)((steps - 1 - i) * scheduler.getStepMs()));
+        simClock.advance((Uint32)scheduler.getStepMs());
         db_update(state, ren);
+        if (spectator) spectator->afterStep(state);
         
-        // Check for debug toggle input
+        // Toggles are one-shot flags of the update that just ran
         if (inputManager.shouldToggleDebug()) {
             debugOverlay.toggle();
         }
-        
-        // Check for timer toggle input
         if (inputManager.shouldToggleTimer()) {
             state.getTimer().toggle();
+            state.requestRedraw();
         }
-        
-        db_render(state, renderManager, layoutCache);
-        
-        // Render debug overlay
-        if (debugOverlay.isEnabled()) {
-            debugOverlay.render(ren, currentWidth, currentHeight);
+        if (inputManager.shouldCycleTheme()) {
+            selectTheme((themes.current() + 1) % themes.size());
+        }
+        if (inputManager.shouldDumpTrace()) Trace::dump(gameCfg.traceFile);
+        if (rewind) {
+            if (inputManager.shouldRewind() && rewind->rewind(state)) state.requestRedraw();
+            rewind->afterStep(state);
         }
-        
-        SDL_RenderPresent(ren);
-        
-        // Calculate frame time
-        Uint32 frameEnd = SDL_GetTicks();
-        float deltaMs = (frameEnd - frameStart);
-        debugOverlay.update(deltaMs);
-        
-        SDL_Delay(1);
-        lastFrameTime = frameEnd;
     }
-    
+}
+
+// IDLE_RENDER: true = nada mudou desde o último frame desenhado e este não desenha
+bool GameLoop::Session::skipIdleFrame() {
+    const bool still = idleAllowed && (state.isPaused() || state.isGameOver()) && !debugOverlay.isEnabled();
+    if (still && drawnIdle && panelsWarm && !textureCache.isRebaking() && state.getRedrawVersion() == drawnRedraw &&
+        inputManager.getWindowEventCount() == drawnWindowEvents && state.getScreenshotRequests() == lastScreenshotRequests &&
+        !renderManager.isAnimated(state)) {
+        // Nada mudou: sem draw nem Present; acorda no próximo evento ou em IDLE_WAIT_MS
+        scheduler.markRenderDone();
+        scheduler.endFrame();
+        DB_TRACE_ZONE("Idle wait");
+        SDL_WaitEventTimeout(nullptr, gameCfg.idleWaitMs);
+        return true;
+    }
+    // Janela exposta ou SDL_RENDER_TARGETS_RESET: as regiões retidas podem ter se perdido
+    if (inputManager.getWindowEventCount() != drawnWindowEvents) renderManager.invalidateCache();
+    drawnRedraw = state.getRedrawVersion();
+    drawnWindowEvents = inputManager.getWindowEventCount();
+    drawnIdle = still;
+    return false;
+}
+
+void GameLoop::Session::drawFrame() {
+    if (textureCache.isRebaking()) {
+        textureCache.rebakeStep(ren, layoutCache, themeManager);
+        renderManager.invalidateCache();
+    }
+    video.beginFrame(ren);
+    layoutCache.shaderEffects = crt.begin(ren, g_visualView, layoutCache.SWr, layoutCache.SHr);
+    db_render(state, renderManager, layoutCache);
+    if (layoutCache.shaderEffects) crt.end(ren, layoutCache, g_visualView);
+    if (debugOverlay.isEnabled()) drawOverlay();
+    video.endFrame(ren);
+}
+
+void GameLoop::Session::drawOverlay() {
+    DB_TRACE_ZONE("Debug overlay");
+    allocMeter.pause();  // As strings do overlay não entram na conta do frame
+    if (video.isRunning()) debugOverlay.setCustomValue("CAPTURE", video.statusLine());
+    debugOverlay.setCustomValue("LAYERS", renderManager.isRetained() ? arena.format("RETAINED, %d redrawn", renderManager.getCacheRedraws()) : "IMMEDIATE");
+    debugOverlay.setCustomValue("DRAWS", arena.format("%u", DrawCalls::count()));
+    if (g_visualView.crtShader) debugOverlay.setCustomValue("CRT", crt.statusLine());
+    if (quality.isEnabled()) debugOverlay.setCustomValue("QUALITY", quality.statusLine());
+    debugOverlay.setCustomValue("TEXTURES", renderTargetPool().usageLine());
+    if (loop.soak_) debugOverlay.setCustomValue("SOAK", loop.soak_->statusLine());
+    if (marquee.isRunning()) debugOverlay.setCustomValue("MARQUEE", marquee.statusLine());
+    if (rewind) {
+        debugOverlay.setCustomValue("REWIND", arena.format("%d/%d slots, %u rewinds, restore %.1f us", rewind->size(),
+                                    rewind->capacity(), rewind->rewinds(), rewind->lastRestoreUs()));
+    }
+    debugOverlay.render(ren, lastWidth, lastHeight);
+    allocMeter.resume();
+}
+
+// Antes do Present: o back buffer ainda é este frame
+void GameLoop::Session::screenshotIfRequested(Uint32 requests) {
+    if (requests == lastScreenshotRequests) return;
+    lastScreenshotRequests = requests;
+    if (screenshots.isRunning()) screenshots.capture(ren);
+    else saveTimestampedScreenshot(ren);
+}
+
+// snap: o topper desenha o snapshot do THREADED_MODE (nullptr = o GameState desta thread)
+void GameLoop::Session::present(Uint32 inputVersion, Uint64 inputStamp, const GameSnapshot* snap) {
+    Uint64 presentStart = SDL_GetPerformanceCounter();
+    SoftRaster::present(ren);
+    Uint64 presentTicks = SDL_GetPerformanceCounter() - presentStart;
+    if (Trace::isEnabled()) Trace::record("Present", presentStart, presentStart + presentTicks);
+    if (latency) latency->onPresent(inputVersion, inputStamp);
+    if (marquee.isRunning()) {
+        if (snap) db_bindSnapshot(snap);
+        marquee.update(state, SDL_GetTicks());
+        if (snap) db_bindSnapshot(nullptr);
+    }
+    profiler.recordTicks(secPresent, presentTicks);
+    Metrics::observe(mPresent, (double)presentTicks * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    scheduler.endFrame();
+}
+
+// Fecha o frame: profiler, governor, métricas, soak/bench e o overlay (workMs = o que conta no orçamento)
+void GameLoop::Session::finishFrame(double workMs, double simMs, int steps) {
+    const FrameTimings& ft = scheduler.timings();
+    profiler.record(secRender, ft.renderMs);
+    profiler.endFrame(ft.frameMs);
+    if (quality.onFrame(ft.frameMs, workMs)) applyQuality();
+    Metrics::observe(mFrame, ft.frameMs);
+    if (loop.soak_) {
+        loop.soak_->onFrame(ft.frameMs);
+        loop.soak_->poll(SDL_GetTicks(), state.getAudio());
+    }
+    if (loop.bench_) loop.bench_->onFrame(ft.frameMs, DrawCalls::count());
+    allocMeter.endFrame();
+    debugOverlay.update((float)ft.frameMs);
+    debugOverlay.setFrameTimings(simMs, ft.renderMs, ft.waitMs, steps, pacingName, gameCfg.targetFps);
+    if (const IAudioSystem* audio = state.getAudio()) {
+        AudioQueueStats aq = audio->getQueueStats();
+        debugOverlay.setAudioStats(aq.activeVoices, aq.queued, aq.capacity, aq.highWater, aq.overflows);
+    }
+}
+
+void GameLoop::Session::teardown() {
+    if (loop.bench_) loop.bench_->end(replayPlayer && replayPlayer->done());  // Antes do profiler sair de escopo
+    if (sim) sim->stop();     // Restaura o pump de eventos e o relógio
+    inputManager.setSampler(nullptr);  // sampler goes out of scope
+    sampler.stop();
+    state.setSessionLog(nullptr, 0);  // sessionLog goes out of scope
+    state.setScreenshotWriter(nullptr);  // screenshots goes out of scope
+    video.stop(ren);  // Últimos frames do anel antes das texturas irem embora
+    crt.release();
+    if (watcher) watcher->stop();
+    if (metrics) metrics->stop();   // Último envio com o fim da sessão
+    if (replayRecorder) replayRecorder->finishRound();
+    if (publisher) {
+        publisher->stop();
+        replayRecorder->setObserver(nullptr);
+    }
+    if (spectatorClient) spectatorClient->stop();
+    if (replayPlayer || replayRecorder || bot || attract || spectator) state.setInput(&inputManager);
+    renderManager.setProfiler(nullptr);  // profiler goes out of scope
+    debugOverlay.setLatencyProbe(nullptr);
+    debugOverlay.setAllocMeter(nullptr);
+    profiler.closeCsv();
+    state.setClock(nullptr);  // simClock goes out of scope
+    layoutVariants.clear();
     textureCache.cleanup();
+    textCache.clear();
+    themeManager.setActiveTheme(nullptr);  // themes goes out of scope
+}
+
+void GameLoop::run(GameState& state, RenderManager& renderManager, SDL_Renderer* ren, ConfigManager& configManager, InputManager& inputManager) {
+    if (running_) { DebugLogger::warning("Game loop is already running"); return; }
+    running_ = true;
+    Session session(*this, state, renderManager, ren, configManager, inputManager);
+    session.setup();
+    
+    while (running_ && session.gameRunning()) {
+        if (!ren) { DebugLogger::error("Renderer is null; aborting main loop"); break; }
+        DB_TRACE_ZONE("Frame");
+        if (!session.frame()) break;
+    }
+    
+    session.teardown();
     running_ = false;
     DebugLogger::info("Main game loop ended");
 }
 
 void GameLoop::stop() { running_ = false; DebugLogger::info("Game loop stop requested"); }
-
-
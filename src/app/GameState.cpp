@@ -1,4 +1,5 @@
 #include "app/GameState.hpp"
+#include "app/GameSnapshot.hpp"
 #include "app/GameHelpers.hpp"
 #include "audio/AudioSystem.hpp"
 #include "ThemeManager.hpp"
@@ -9,56 +10,60 @@
 #include "render/LayoutCache.hpp"
 #include "game/Mechanics.hpp"
 #include "util/UiUtil.hpp"
+#include "util/ScreenshotWriter.hpp"
+#include "app/SessionLog.hpp"
 #include "DebugLogger.hpp"
 #include "pieces/Piece.hpp"
+#include "app/Metrics.hpp"
+#include "app/Tracing.hpp"
 #include <ctime>
 
 extern std::vector<Piece> PIECES;
 
-// DependencyContainer forward (defined in dropblocks.cpp)
-class DependencyContainer;
-
-GameState::GameState(DependencyContainer& container)
-    : grid(board_.getGrid()), act(activePiece_), running(running_), paused(paused_),
-      gameover(gameover_), lastTick(lastTick_), combo(combo_)
-{
-    // DI constructor stub (container.resolve not implemented here yet)
-    lastTick_ = SDL_GetTicks();
-    
-    // Initialize timer with default config
-    timer_ = std::make_unique<TimerSystem>();
+GameState::GameState(const GameServices& services) : GameState() {
+    setServices(services);
 }
 
 GameState::GameState()
     : grid(board_.getGrid()), act(activePiece_), running(running_), paused(paused_),
       gameover(gameover_), lastTick(lastTick_), combo(combo_)
 {
-    lastTick_ = SDL_GetTicks();
-    audio_ = nullptr;
-    theme_ = nullptr;
-    pieces_ = nullptr;
-    input_ = nullptr;
-    config_ = nullptr;
+    lastTick_ = clock_->nowMs();
+    wheel_.reset(lastTick_);
+    events_.subscribe(&audioEvents_);
+    events_.subscribe(&metricsEvents_);
     
     // Initialize timer with default config
     timer_ = std::make_unique<TimerSystem>();
 }
 
-void GameState::setDependencies(AudioSystem* audio, ThemeManager* theme, PieceManager* pieces, InputManager* input, ConfigManager* config) {
-    DebugLogger::info("Setting dependencies for GameState");
-    audio_ = std::unique_ptr<IAudioSystem>(audio);
-    theme_ = std::unique_ptr<IThemeManager>(theme);
-    pieces_ = std::unique_ptr<IPieceManager>(pieces);
-    input_ = std::unique_ptr<IInputManager>(input);
-    config_ = std::unique_ptr<IGameConfig>(config);
-    
-    if (!audio_) DebugLogger::error("Audio dependency not set");
-    if (!theme_) DebugLogger::error("Theme dependency not set");
-    if (!pieces_) DebugLogger::error("Pieces dependency not set");
-    if (!input_) DebugLogger::error("Input dependency not set");
-    if (!config_) DebugLogger::error("Config dependency not set");
-    
-    DebugLogger::info("Dependencies set successfully");
+void GameState::setServices(const GameServices& services) {
+    audio_ = services.get<IAudioSystem>();
+    theme_ = services.get<IThemeManager>();
+    pieces_ = services.get<IPieceManager>();
+    input_ = services.get<IInputManager>();
+    config_ = services.get<IGameConfig>();
+    audioEvents_.setAudio(audio_);
+}
+
+void GameState::setCoreDependencies(IAudioSystem* audio, IPieceManager* pieces, IInputManager* input) {
+    GameServices services;
+    services.provide<IAudioSystem>(audio);
+    services.provide<IPieceManager>(pieces);
+    services.provide<IInputManager>(input);
+    setServices(services);
+}
+
+void GameState::setClock(const IGameClock* clock) {
+    clock_ = clock ? clock : &systemClock();
+    if (timer_) timer_->setClock(clock_);
+    lastTick_ = clock_->nowMs();
+    roundStartMs_ = lastTick_;
+    pausedMs_ = 0;
+    // Prazos do relógio anterior não valem neste
+    wheel_.reset(lastTick_);
+    gravityTimer_ = ambientTimer_ = 0;
+    gravityArmedMs_ = -1;
 }
 
 GameBoard& GameState::getBoard() { return board_; }
@@ -88,7 +93,12 @@ bool GameState::isPaused() const { return paused_; }
 bool GameState::isGameOver() const { return gameover_; }
 void GameState::setRunning(bool v) { running_ = v; }
 void GameState::setPaused(bool v) { 
+    if (v != paused_) {
+        if (v) pauseStartMs_ = clock_->nowMs();
+        else pausedMs_ += clock_->nowMs() - pauseStartMs_;
+    }
     paused_ = v; 
+    redrawVersion_++;
     
     // Pause/resume timer accordingly
     if (timer_) {
@@ -99,7 +109,7 @@ void GameState::setPaused(bool v) {
         }
     }
 }
-void GameState::setGameOver(bool v) { gameover_ = v; }
+void GameState::setGameOver(bool v) { gameover_ = v; redrawVersion_++; }
 
 Uint32 GameState::getLastTick() const { return lastTick_; }
 void GameState::setLastTick(Uint32 t) { lastTick_ = t; }
@@ -110,8 +120,14 @@ void GameState::reset() {
     combo_.reset();
     gameover_ = false;
     paused_ = false;
-    lastTick_ = SDL_GetTicks();
+    redrawVersion_++;
+    roundVersion_++;
+    lastTick_ = clock_->nowMs();
+    roundStartMs_ = lastTick_;
+    pausedMs_ = 0;
     resetPieceStats();
+    events_.dispatch();  // Sons da partida anterior antes da música do nível 0
+    if (audio_) audio_->setMusicLevel(score_.getLevel());
     
     // Reset timer
     if (timer_) {
@@ -119,6 +135,45 @@ void GameState::reset() {
     }
 }
 
+void GameState::saveResumeState(GameSnapshot& out) const {
+    const Uint32 now = clock_->nowMs();
+    out.resumable = pieces_ && pieces_->saveDeal(out.deal);
+    out.tickMs = score_.getTickMs();
+    out.combo = combo_.combo;
+    out.comboAgeMs = now - combo_.lastClear;
+    out.gravityAgeMs = now - lastTick_;
+    out.roundMs = now - roundStartMs_ - pausedMs_ - (paused_ ? now - pauseStartMs_ : 0);
+    out.timerElapsedMs = timer_ ? timer_->getElapsedMs() : 0;
+}
+
+bool GameState::restoreSnapshot(const GameSnapshot& snap) {
+    const int n = (int)PIECES.size();
+    if (!snap.resumable || !pieces_ || snap.rows != board_.height() || snap.cols != board_.width() ||
+        snap.activeIdx < 0 || snap.activeIdx >= n || snap.pieceStatCount != n) {
+        return false;
+    }
+    if (!pieces_->restoreDeal(snap.deal)) return false;
+    
+    const Uint32 now = clock_->nowMs();
+    board_.restore(snap.rowMasks, snap.cells, GameSnapshot::MAX_COLS);
+    activePiece_ = Active{snap.activeX, snap.activeY, snap.activeRot & 3, snap.activeIdx};
+    score_.restore(snap.score, snap.lines, snap.level, snap.tickMs);
+    combo_.combo = snap.combo;
+    combo_.lastClear = now - snap.comboAgeMs;
+    lastTick_ = now - snap.gravityAgeMs;
+    roundStartMs_ = now - snap.roundMs;
+    pausedMs_ = 0;
+    paused_ = false;
+    gameover_ = snap.gameOver;
+    pieceStats_.assign(snap.pieceStats, snap.pieceStats + snap.pieceStatCount);
+    if (timer_) timer_->restoreElapsed(snap.timerEnabled, (TimerSystem::State)snap.timerState, snap.timerElapsedMs);
+    if (input_) input_->resetTimers();
+    events_.dispatch();
+    if (audio_) audio_->setMusicLevel(gameover_ ? -1 : score_.getLevel());
+    redrawVersion_++;
+    return true;
+}
+
 void GameState::restartRound() {
     reset();
     if (pieces_) {
@@ -129,9 +184,9 @@ void GameState::restartRound() {
     newActive(activePiece_, first);
     incrementPieceStat(first);
     if (pieces_) pieces_->setNextPiece(pieces_->getNextPiece());
-    setLastTick(SDL_GetTicks());
+    setLastTick(clock_->nowMs());
     if (input_) input_->resetTimers();
-    if (audio_) static_cast<AudioSystem&>(*audio_).playBeep(520.0, 40, 0.15f, false);
+    emit(GameEventType::ROUND_STARTED);
     
     // Start timer if enabled
     if (timer_ && timer_->isEnabled()) {
@@ -147,19 +202,15 @@ void GameState::updatePiece() {
         activePiece_.y++;
     } else {
         board_.placePiece(activePiece_);
-        audio_->playBeep(220.0, 25, 0.12f, true);
+        emit(GameEventType::LOCKED);
         
         int c = board_.clearLines();
+        recordLock(c);
         if (c > 0) {
+            const int levelBefore = score_.getLevel();
             score_.addLines(c);
-            combo_.onLineClear(static_cast<AudioSystem&>(*audio_));
-            
-            if (c == 4) {
-                audio_->playTetrisSound();
-            } else {
-                double freq = 440.0 + (c * 110.0);
-                audio_->playBeep(freq, 30 + c * 10, 0.18f, false);
-            }
+            emit(GameEventType::LINES_CLEARED, c, combo_.onLineClear(clock_->nowMs()));
+            if (score_.getLevel() != levelBefore) emit(GameEventType::LEVEL_UP, 0, score_.getLevel());
             
             int points = (c == 1 ? 100 : c == 2 ? 300 : c == 3 ? 500 : 800) * (score_.getLevel() + 1);
             score_.addScore(points);
@@ -171,20 +222,87 @@ void GameState::updatePiece() {
         newActive(activePiece_, nextPiece);
         incrementPieceStat(nextPiece);
         pieces_->setNextPiece(pieces_->getNextPiece());
-        if (board_.isGameOver(activePiece_)) {
-            gameover_ = true;
-            paused_ = false;
-            combo_.reset();
-            audio_->playGameOverSound();
-            
-            // Parar o timer quando game over
-            if (timer_) {
-                timer_->stop();
-            }
-        }
+        if (board_.isGameOver(activePiece_)) topOut();
     }
 }
 
+void GameState::recordLock(int cleared) {
+    LockEvent& ev = lockEvent_;
+    ev.seq++;
+    ev.clearedRows = 0;
+    if (cleared > 0)
+        for (int y : board_.getLastClearedRows())
+            if (y >= 0 && y < MAX_BOARD_ROWS) ev.clearedRows |= Uint64(1) << y;
+    const Piece& pc = PIECES[activePiece_.idx];
+    ev.r = pc.r; ev.g = pc.g; ev.b = pc.b;
+    ev.cellCount = 0;
+    auto push = [&](int x, int y) {
+        if (y < 0 || ev.cellCount >= LockEvent::MAX_CELLS) return;
+        ev.cellX[ev.cellCount] = (Sint8)x;
+        ev.cellY[ev.cellCount] = (Sint8)y;
+        ev.cellCount++;
+    };
+    const RotationMask& m = pc.masks[activePiece_.rot];
+    if (!m.valid) {
+        for (const auto& p : pc.rot[activePiece_.rot]) push(activePiece_.x + p.first, activePiece_.y + p.second);
+    } else {
+        for (int i = 0; i < m.height(); i++)
+            for (uint32_t bits = m.rows[i]; bits; bits &= bits - 1) push(activePiece_.x + m.minX + __builtin_ctz(bits), activePiece_.y + m.minY + i);
+    }
+}
+
+void GameState::emit(GameEventType type, int count, int value) {
+    GameEvent ev;
+    ev.type = type;
+    ev.piece = (Sint8)activePiece_.idx;
+    ev.count = (Sint8)count;
+    ev.value = (Sint16)value;
+    ev.atMs = (Uint16)clock_->nowMs();
+    events_.push(ev);
+}
+
+void GameState::topOut() {
+    gameover_ = true;
+    redrawVersion_++;
+    if (paused_) pausedMs_ += clock_->nowMs() - pauseStartMs_;  // Lixo do versus durante a pausa
+    paused_ = false;
+    endRound();
+    combo_.reset();
+    emit(GameEventType::GAME_OVER);
+    
+    // Parar o timer quando game over
+    if (timer_) {
+        timer_->stop();
+    }
+}
+
+void GameState::endRound() {
+    static const Metrics::Id id = Metrics::counter("games_played");
+    Metrics::add(id);
+    if (!sessionLog_) return;
+    
+    SessionRecord record;
+    record.endedAt = (uint64_t)std::time(nullptr);
+    record.score = getScoreValue();
+    record.lines = getLinesValue();
+    record.level = getLevelValue();
+    record.durationMs = clock_->nowMs() - roundStartMs_ - pausedMs_;
+    record.flags = sessionFlags_ | (timer_ && timer_->isEnabled() ? SessionRecord::TIMER_MODE : 0u);
+    record.pieceStats.assign(pieceStats_.begin(), pieceStats_.end());
+    sessionLog_->submit(record);
+}
+
+bool GameState::addGarbage(int lines, int holeCol) {
+    if (lines <= 0 || gameover_ || !audio_) return false;
+    static const Cell GARBAGE{110, 110, 110, true};
+    bool overflow = board_.addGarbage(lines, holeCol, GARBAGE);
+    if (overflow || board_.isGameOver(activePiece_)) {
+        topOut();
+        return true;
+    }
+    return false;
+}
+
 int GameState::getScoreValue() const { return score_.getScore(); }
 int GameState::getLinesValue() const { return score_.getLines(); }
 int GameState::getLevelValue() const { return score_.getLevel(); }
@@ -199,8 +317,22 @@ void GameState::setLevel(int level) {
 void GameState::setTickMs(int tickMs) { score_.setTickMs(tickMs); }
 int GameState::getNextIdx() const { return pieces_->getCurrentNextPiece(); }
 
+int GameState::getNextQueue(int* out, int max) const {
+    if (max <= 0) return 0;
+    int count = 0;
+    out[count++] = pieces_->getCurrentNextPiece();
+    if (PIECES.empty()) return count;
+    while (count < max) {
+        const int idx = pieces_->peek(count - 1);
+        if (idx < 0) break;
+        out[count++] = idx;
+    }
+    return count;
+}
+
 void GameState::update(SDL_Renderer* renderer) {
     if (!input_ || !audio_) { DebugLogger::error("Dependencies not initialized in update()"); return; }
+    DB_TRACE_ZONE("GameState::update");
     
     // Notificar timer sobre estado de pause
     if (timer_) {
@@ -214,6 +346,7 @@ void GameState::update(SDL_Renderer* renderer) {
         // Check if timer expired and force game over
         if (timer_->isExpired() && !isGameOver()) {
             setGameOver(true);
+            endRound();
             timer_->stop();  // Parar o timer quando ele próprio causa game over
             DebugLogger::info("Game over - timer expired");
         }
@@ -222,15 +355,42 @@ void GameState::update(SDL_Renderer* renderer) {
     handleInput(renderer);
     
     if (!isPaused() && !isGameOver()) {
-        Uint32 now = SDL_GetTicks();
-        if (now - getLastTick() >= (Uint32)getScore().getTickMs()) {
-            updatePiece();
-            setLastTick(now);
-        }
-        
-        getBoard().checkTension(static_cast<AudioSystem&>(*audio_));
-        audio_->playBackgroundMelody(getScore().getLevel());
+        const Uint32 now = clock_->nowMs();
+        armTimers(now);
+        wheel_.advance(now);
+    }
+}
+
+namespace {
+constexpr Uint32 AMBIENT_INTERVAL_MS = 250;  // O intervalo de cada som continua no AudioSystem
+}
+
+void GameState::armTimers(Uint32 now) {
+    // Mesmo prazo do antigo "now - lastTick >= tickMs": vence no mesmo update
+    const int tickMs = score_.getTickMs();
+    if (gravityArmedMs_ != tickMs || gravityArmedTick_ != lastTick_ || !wheel_.isPending(gravityTimer_)) {
+        wheel_.cancel(gravityTimer_);
+        gravityTimer_ = wheel_.schedule(lastTick_ + (Uint32)tickMs, &GameState::onGravity, this);
+        gravityArmedTick_ = lastTick_;
+        gravityArmedMs_ = tickMs;
     }
+    if (!wheel_.isPending(ambientTimer_)) ambientTimer_ = wheel_.schedule(now, &GameState::onAmbient, this);
+}
+
+void GameState::onGravity(void* self, Uint32 now) {
+    GameState& s = *static_cast<GameState*>(self);
+    if (s.paused_ || s.gameover_) return;
+    s.updatePiece();
+    s.setLastTick(now);   // Rearmada no próximo update (lastTick_ mudou)
+}
+
+void GameState::onAmbient(void* self, Uint32 now) {
+    GameState& s = *static_cast<GameState*>(self);
+    if (!s.paused_ && !s.gameover_) {
+        s.board_.checkTension(*s.audio_);
+        s.audio_->playBackgroundMelody(s.score_.getLevel());
+    }
+    s.ambientTimer_ = s.wheel_.schedule(now + AMBIENT_INTERVAL_MS, &GameState::onAmbient, self);
 }
 
 void GameState::render(RenderManager& renderManager, const LayoutCache& layout) {
@@ -239,15 +399,27 @@ void GameState::render(RenderManager& renderManager, const LayoutCache& layout)
 
 void GameState::handleInput(SDL_Renderer* renderer) {
     if (!input_ || !audio_) { DebugLogger::error("Dependencies not initialized in handleInput()"); return; }
+    DB_TRACE_ZONE("GameState::handleInput");
     
+    Uint64 inputStart = SDL_GetPerformanceCounter();
     input_->update();
+    inputTicks_ += SDL_GetPerformanceCounter() - inputStart;
+    // Só conta se a ação mudou algo na tela: evento sem efeito não vira amostra
+    const Uint64 stamp = input_->takeInputStamp();
+    auto applied = [&]() {
+        if (!stamp) return;
+        inputVersion_++;
+        inputStamp_ = stamp;
+        redrawVersion_++;
+    };
     
+    if (screenshots_ && screenshots_->takeCompleted() > 0) audio_->playBeep(880.0, 80, 0.18f, false);
     if (input_->shouldScreenshot()) {
-        time_t now = time(0);
-        struct tm* timeinfo = localtime(&now);
-        char filename[64];
-        strftime(filename, sizeof(filename), "dropblocks-screenshot_%Y-%m-%d_%H-%M-%S.bmp", timeinfo);
-        if (saveScreenshot(renderer, filename)) audio_->playBeep(880.0, 80, 0.18f, false);
+        if (renderer && !screenshots_) {
+            if (saveTimestampedScreenshot(renderer)) audio_->playBeep(880.0, 80, 0.18f, false);
+        } else {
+            screenshotRequests_++;  // Fica para quem renderiza
+        }
     }
     
     if (input_->shouldQuit()) {
@@ -256,55 +428,72 @@ void GameState::handleInput(SDL_Renderer* renderer) {
     
     if (input_->shouldPause()) {
         setPaused(!isPaused());
-        audio_->playBeep(isPaused() ? 440.0 : 520.0, 30, 0.12f, false);
+        emit(GameEventType::PAUSED, isPaused() ? 1 : 0);
+        applied();
     }
     
     // Force restart (R key) - works anytime
     if (input_->shouldForceRestart()) {
         restartRound();
+        applied();
         return;
     }
     
     // Normal restart (RETURN) - only on game over
     if (isGameOver() && input_->shouldRestart()) {
         restartRound();
+        applied();
         return;
     }
     
     if (!isPaused() && !isGameOver()) {
         auto coll = [&](int dx, int dy, int drot) { return !board_.canPlacePiece(activePiece_, dx, dy, drot); };
         
-        if (input_->shouldMoveLeft() && !coll(-1, 0, 0)) {
+        // Passos de DAS/ARR vencidos desde o último update, aplicados em ordem
+        int leftSteps = input_->moveLeftSteps();
+        int rightSteps = input_->moveRightSteps();
+        int dropSteps = input_->softDropSteps();
+        
+        int moved = 0;
+        for (int i = 0; i < leftSteps && !coll(-1, 0, 0); ++i) {
             activePiece_.x--;
-            audio_->playMovementSound();
+            moved++;
         }
-        
-        if (input_->shouldMoveRight() && !coll(1, 0, 0)) {
+        for (int i = 0; i < rightSteps && !coll(1, 0, 0); ++i) {
             activePiece_.x++;
-            audio_->playMovementSound();
+            moved++;
         }
+        if (moved) emit(GameEventType::MOVED, moved);
+        bool acted = moved > 0;
         
-        if (input_->shouldSoftDrop()) {
-            audio_->playSoftDropSound();
-            updatePiece();
+        if (dropSteps > 0) {
+            acted = true;
+            emit(GameEventType::SOFT_DROP, dropSteps);
+            for (int i = 0; i < dropSteps && !isGameOver(); ++i) {
+                // O passo que trava a peça encerra a sequência (não vaza para a próxima)
+                bool locks = coll(0, 1, 0);
+                updatePiece();
+                if (locks) break;
+            }
         }
         
         if (input_->shouldHardDrop()) {
-            int maxSteps = (int)board_.getGrid().size() + 10;
-            for (int i = 0; i < maxSteps && !coll(0, 1, 0); i++) { activePiece_.y++; }
-            audio_->playHardDropSound();
+            const int distance = board_.dropDistance(activePiece_);
+            activePiece_.y += distance;
+            emit(GameEventType::HARD_DROP, distance);
             updatePiece();
+            acted = true;
         }
         
-        if (input_->shouldRotateCCW()) {
-            rotateWithKicks(activePiece_, board_.getGrid(), -1, static_cast<AudioSystem&>(*audio_));
-            audio_->playRotationSound(false);
-        }
-        
-        if (input_->shouldRotateCW()) {
-            rotateWithKicks(activePiece_, board_.getGrid(), +1, static_cast<AudioSystem&>(*audio_));
-            audio_->playRotationSound(true);
-        }
+        auto rotate = [&](int dir) {
+            const RotateResult r = rotateWithKicks(activePiece_, board_, dir);
+            if (r == RotateResult::KICKED) emit(GameEventType::KICKED, dir);
+            emit(GameEventType::ROTATED, dir, r != RotateResult::BLOCKED);
+            acted = true;
+        };
+        if (input_->shouldRotateCCW()) rotate(-1);
+        if (input_->shouldRotateCW()) rotate(+1);
+        if (acted) applied();
     }
 }
 
@@ -322,9 +511,6 @@ void GameState::incrementPieceStat(int pieceIdx) {
 }
 
 void GameState::resetPieceStats() {
-    pieceStats_.clear();
-    // Inicializar com zeros para todas as peças conhecidas
-    if (!PIECES.empty()) {
-        pieceStats_.resize(PIECES.size(), 0);
-    }
+    // Zeros para todas as peças conhecidas; assign reaproveita a capacidade entre partidas
+    pieceStats_.assign(PIECES.size(), 0);
 }
@@ -0,0 +1,32 @@
+#include "app/HeadlessSim.hpp"
+
+HeadlessSim::HeadlessSim(Uint32 stepMs) : stepMs_(stepMs ? stepMs : DEFAULT_STEP_MS) {
+    state_.setClock(&clock_);
+    state_.setCoreDependencies(&audio_, &pieces_, &input_);
+}
+
+void HeadlessSim::setInput(IInputManager* input) {
+    state_.setInput(input ? input : &input_);
+}
+
+void HeadlessSim::start(uint32_t seed) {
+    ticks_ = 0;
+    clock_.set(0);
+    pieces_.seed(seed);
+    // restartRound() resorteia o bag usando o RNG recém-semeado
+    state_.restartRound();
+}
+
+void HeadlessSim::step(uint16_t actions) {
+    clock_.advance(stepMs_);
+    input_.setActions(actions);
+    state_.update(nullptr);
+    state_.dispatchEvents();
+    ticks_++;
+}
+
+uint64_t HeadlessSim::run(uint64_t maxTicks) {
+    uint64_t n = 0;
+    while (n < maxTicks && !state_.isGameOver() && state_.isRunning()) { step(); n++; }
+    return n;
+}
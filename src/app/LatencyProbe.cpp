@@ -0,0 +1,15 @@
+#include "app/LatencyProbe.hpp"
+
+LatencyProbe::LatencyProbe()
+    : metric_(Metrics::histogram("input_latency_ms", {8, 16.7, 25, 33.3, 50, 66.7, 100, 150})) {}
+
+void LatencyProbe::onPresent(Uint32 inputVersion, Uint64 inputStamp) {
+    if (inputVersion == lastVersion_) return;
+    lastVersion_ = inputVersion;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (!inputStamp || inputStamp > now) return;
+    double ms = FrameProfiler::ticksToMs(now - inputStamp);
+    window_.add(ms);
+    Metrics::observe(metric_, ms);
+    samples_++;
+}
@@ -0,0 +1,247 @@
+#include "app/Metrics.hpp"
+#include "util/RotatingFile.hpp"
+#include "util/UdpSocket.hpp"
+#include "DebugLogger.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+struct Slot {
+    Metrics::Kind kind = Metrics::Kind::COUNTER;
+    char name[Metrics::NAME_MAX] = {};
+    std::atomic<uint64_t> value{0};          // contador, ou os bits do double do gauge
+    int buckets = 0;
+    double bounds[Metrics::MAX_BUCKETS] = {};
+    std::atomic<uint64_t> counts[Metrics::MAX_BUCKETS + 1];
+    std::atomic<int64_t> sumMilli{0};        // soma em milésimos (fetch_add inteiro)
+    std::atomic<uint64_t> maxBits{0};
+};
+
+Slot g_slots[Metrics::MAX_METRICS];
+std::atomic<int> g_count{0};
+SDL_SpinLock g_registerLock = 0;
+
+uint64_t toBits(double v) { uint64_t b; std::memcpy(&b, &v, sizeof b); return b; }
+double fromBits(uint64_t b) { double v; std::memcpy(&v, &b, sizeof v); return v; }
+
+Metrics::Id registerSlot(const char* name, Metrics::Kind kind, const double* bounds, int buckets) {
+    SDL_AtomicLock(&g_registerLock);
+    int n = g_count.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i) {
+        if (std::strncmp(g_slots[i].name, name, Metrics::NAME_MAX - 1) == 0) {
+            SDL_AtomicUnlock(&g_registerLock);
+            return g_slots[i].kind == kind ? i : -1;
+        }
+    }
+    if (n >= Metrics::MAX_METRICS) {
+        SDL_AtomicUnlock(&g_registerLock);
+        DebugLogger::warning(std::string("Metrics: registry full, dropping ") + name);
+        return -1;
+    }
+    Slot& s = g_slots[n];
+    s.kind = kind;
+    std::snprintf(s.name, sizeof(s.name), "%s", name);
+    s.buckets = buckets < Metrics::MAX_BUCKETS ? buckets : Metrics::MAX_BUCKETS;
+    for (int b = 0; b < s.buckets; ++b) s.bounds[b] = bounds[b];
+    for (auto& c : s.counts) c.store(0, std::memory_order_relaxed);
+    g_count.store(n + 1, std::memory_order_release);  // Publica o slot pronto
+    SDL_AtomicUnlock(&g_registerLock);
+    return n;
+}
+
+inline bool valid(Metrics::Id id) { return (unsigned)id < (unsigned)Metrics::MAX_METRICS; }
+
+} // namespace
+
+namespace Metrics {
+
+Id counter(const char* name) { return registerSlot(name, Kind::COUNTER, nullptr, 0); }
+Id gauge(const char* name) { return registerSlot(name, Kind::GAUGE, nullptr, 0); }
+Id histogram(const char* name, std::initializer_list<double> upperBounds) {
+    return registerSlot(name, Kind::HISTOGRAM, upperBounds.begin(), (int)upperBounds.size());
+}
+
+void add(Id id, uint64_t n) {
+    if (valid(id)) g_slots[id].value.fetch_add(n, std::memory_order_relaxed);
+}
+
+void set(Id id, double value) {
+    if (valid(id)) g_slots[id].value.store(toBits(value), std::memory_order_relaxed);
+}
+
+void observe(Id id, double value) {
+    if (!valid(id)) return;
+    Slot& s = g_slots[id];
+    int b = 0;
+    while (b < s.buckets && value > s.bounds[b]) ++b;
+    s.counts[b].fetch_add(1, std::memory_order_relaxed);
+    s.sumMilli.fetch_add((int64_t)(value * 1000.0), std::memory_order_relaxed);
+    uint64_t prev = s.maxBits.load(std::memory_order_relaxed);
+    while (value > fromBits(prev) && !s.maxBits.compare_exchange_weak(prev, toBits(value), std::memory_order_relaxed)) {}
+}
+
+int count() { return g_count.load(std::memory_order_acquire); }
+const char* name(Id id) { return valid(id) ? g_slots[id].name : ""; }
+Kind kind(Id id) { return valid(id) ? g_slots[id].kind : Kind::COUNTER; }
+uint64_t counterValue(Id id) { return valid(id) ? g_slots[id].value.load(std::memory_order_relaxed) : 0; }
+double gaugeValue(Id id) { return valid(id) ? fromBits(g_slots[id].value.load(std::memory_order_relaxed)) : 0.0; }
+
+void takeHistogram(Id id, HistogramSnapshot& out) {
+    out = HistogramSnapshot();
+    if (!valid(id)) return;
+    Slot& s = g_slots[id];
+    out.buckets = s.buckets;
+    for (int b = 0; b < s.buckets; ++b) out.bounds[b] = s.bounds[b];
+    for (int b = 0; b <= s.buckets; ++b) {
+        out.counts[b] = s.counts[b].load(std::memory_order_relaxed);
+        out.total += out.counts[b];
+    }
+    out.sum = (double)s.sumMilli.load(std::memory_order_relaxed) / 1000.0;
+    out.max = fromBits(s.maxBits.exchange(0, std::memory_order_relaxed));
+}
+
+} // namespace Metrics
+
+// ---- MetricsExporter ----
+
+struct MetricsExporter::State {
+    UdpSocket socket;
+    RotatingFile file;
+    uint64_t lastCounter[Metrics::MAX_METRICS] = {};
+    uint64_t lastCounts[Metrics::MAX_METRICS][Metrics::MAX_BUCKETS + 1] = {};
+    double lastSum[Metrics::MAX_METRICS] = {};
+    std::string packet;
+};
+
+MetricsExporter::MetricsExporter(const std::string& target, const std::string& prefix, Uint32 intervalMs, size_t maxFileBytes)
+    : target_(target), prefix_(prefix), intervalMs_(intervalMs < 100 ? 100 : intervalMs), maxFileBytes_(maxFileBytes) {}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+    delete state_;
+}
+
+bool MetricsExporter::start() {
+    if (thread_) return true;
+    if (!state_) state_ = new State();
+    const std::string udp = "udp://";
+    if (target_.compare(0, udp.size(), udp) == 0) {
+        std::string hostPort = target_.substr(udp.size());
+        size_t colon = hostPort.rfind(':');
+        int port = colon == std::string::npos ? 8125 : std::atoi(hostPort.c_str() + colon + 1);
+        if (!state_->socket.open(hostPort.substr(0, colon), port)) return false;
+    } else if (!state_->file.open(target_, maxFileBytes_, 3)) {
+        DebugLogger::warning("Metrics: cannot open " + target_);
+        return false;
+    }
+    quit_.store(false, std::memory_order_release);
+    thread_ = SDL_CreateThread(&MetricsExporter::threadMain, "dropblocks-metrics", this);
+    if (!thread_) { DebugLogger::error(std::string("SDL_CreateThread failed: ") + SDL_GetError()); return false; }
+    DebugLogger::info("Metrics: sending to " + target_ + " every " + std::to_string(intervalMs_) + "ms");
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!thread_) return;
+    quit_.store(true, std::memory_order_release);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+}
+
+int SDLCALL MetricsExporter::threadMain(void* self) {
+    static_cast<MetricsExporter*>(self)->loop();
+    return 0;
+}
+
+void MetricsExporter::loop() {
+    const Uint32 slice = 20;  // stop() não espera um intervalo inteiro
+    Uint64 last = SDL_GetPerformanceCounter();
+    Uint32 waited = 0;
+    while (!quit_.load(std::memory_order_acquire)) {
+        SDL_Delay(slice);
+        waited += slice;
+        if (waited < intervalMs_) continue;
+        waited = 0;
+        Uint64 now = SDL_GetPerformanceCounter();
+        flush((double)(now - last) / (double)SDL_GetPerformanceFrequency());
+        last = now;
+    }
+    flush((double)(SDL_GetPerformanceCounter() - last) / (double)SDL_GetPerformanceFrequency());
+}
+
+void MetricsExporter::flush(double seconds) {
+    State& st = *state_;
+    const bool udp = st.socket.isOpen();
+    const size_t MAX_PACKET = 1400;  // Abaixo do MTU típico
+    char stamp[32];
+    std::snprintf(stamp, sizeof(stamp), "%lld ", (long long)std::time(nullptr));
+
+    auto emit = [&](const char* metric, const char* suffix, double value, const char* type) {
+        char line[160];
+        int n = std::snprintf(line, sizeof(line), "%s%s.%s%s:%.10g|%s\n", udp ? "" : stamp,
+                              prefix_.c_str(), metric, suffix, value, type);
+        if (n <= 0) return;
+        size_t len = (size_t)n < sizeof(line) ? (size_t)n : sizeof(line) - 1;
+        if (udp && !st.packet.empty() && st.packet.size() + len > MAX_PACKET) {
+            st.socket.send(st.packet.data(), st.packet.size() - 1);  // Sem o último '\n'
+            st.packet.clear();
+        }
+        st.packet.append(line, len);
+    };
+
+    int n = Metrics::count();
+    for (int id = 0; id < n; ++id) {
+        const char* metric = Metrics::name(id);
+        switch (Metrics::kind(id)) {
+        case Metrics::Kind::COUNTER: {
+            uint64_t v = Metrics::counterValue(id);
+            uint64_t delta = v - st.lastCounter[id];
+            st.lastCounter[id] = v;
+            emit(metric, "", (double)delta, "c");
+            if (!udp && seconds > 0.0) emit(metric, ".rate", (double)delta / seconds, "g");  // StatsD calcula a taxa sozinho
+            break;
+        }
+        case Metrics::Kind::GAUGE:
+            emit(metric, "", Metrics::gaugeValue(id), "g");
+            break;
+        case Metrics::Kind::HISTOGRAM: {
+            Metrics::HistogramSnapshot h;
+            Metrics::takeHistogram(id, h);
+            uint64_t delta[Metrics::MAX_BUCKETS + 1];
+            uint64_t total = 0;
+            for (int b = 0; b <= h.buckets; ++b) {
+                delta[b] = h.counts[b] - st.lastCounts[id][b];
+                st.lastCounts[id][b] = h.counts[b];
+                total += delta[b];
+            }
+            double sum = h.sum - st.lastSum[id];
+            st.lastSum[id] = h.sum;
+            emit(metric, ".count", (double)total, "c");
+            if (total == 0) break;
+            // Percentil = limite superior do bucket onde ele cai (overflow: o máximo visto)
+            auto quantile = [&](double q) {
+                uint64_t want = (uint64_t)(q * (double)total + 0.5), seen = 0;
+                for (int b = 0; b < h.buckets; ++b) {
+                    seen += delta[b];
+                    if (seen >= want) return h.bounds[b];
+                }
+                return h.max;
+            };
+            emit(metric, ".avg", sum / (double)total, "g");
+            emit(metric, ".p50", quantile(0.50), "g");
+            emit(metric, ".p99", quantile(0.99), "g");
+            emit(metric, ".max", h.max, "g");
+            break;
+        }
+        }
+    }
+
+    if (st.packet.empty()) return;
+    if (udp) st.socket.send(st.packet.data(), st.packet.size() - 1);
+    else { st.file.write(st.packet.data(), st.packet.size()); st.file.flush(); }
+    st.packet.clear();
+}
@@ -0,0 +1,109 @@
+#include "app/QualityGovernor.hpp"
+#include "app/Metrics.hpp"
+#include "render/GameStateBridge.hpp"
+#include "ConfigTypes.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+extern int ROUNDED_PANELS;
+extern int TEXT_OUTLINES;
+
+namespace {
+constexpr double LATE_FACTOR = 1.25;     // Frame acima disso do orçamento conta como atrasado
+constexpr double OVER_LATE_RATIO = 0.10;
+constexpr double OVER_WORK_RATIO = 0.90;
+constexpr double CALM_LATE_RATIO = 0.02;
+constexpr double CALM_WORK_RATIO = 0.60;
+constexpr double HITCH_MS = 250.0;       // Pausa longa (idle, reload, arrastar janela): fora da conta
+constexpr int OVER_WINDOWS = 2;
+constexpr int BOUNCE_WINDOWS = 20;       // Estourou até aqui depois de subir = a subida foi cedo demais
+}
+
+void QualityGovernor::configure(bool enabled, double budgetMs) {
+    enabled_ = enabled && budgetMs > 0.0;
+    budgetMs_ = budgetMs;
+    frames_ = late_ = 0;
+    workSum_ = 0.0;
+    overWindows_ = calmWindows_ = sinceChange_ = 0;
+    upWindows_ = BASE_UP_WINDOWS;
+    lastWasUp_ = false;
+    if (!enabled_) setTier(0);
+}
+
+const char* QualityGovernor::tierName(int tier) {
+    switch (tier) {
+        case 0: return "full";
+        case 1: return "no sweep";
+        case 2: return "no scanlines";
+        case 3: return "no particles";
+        case 4: return "square panels";
+        case 5: return "plain text";
+    }
+    return "?";
+}
+
+bool QualityGovernor::setTier(int tier) {
+    tier = std::max(0, std::min(MAX_TIER, tier));
+    static const Metrics::Id mTier = Metrics::gauge("quality_tier");
+    Metrics::set(mTier, (double)tier);
+    if (tier == tier_) return false;
+    DebugLogger::info(std::string("Quality: tier ") + std::to_string(tier) + " (" + tierName(tier) + ")");
+    tier_ = tier;
+    sinceChange_ = 0;
+    overWindows_ = calmWindows_ = 0;
+    return true;
+}
+
+bool QualityGovernor::onFrame(double frameMs, double workMs) {
+    if (!enabled_ || frameMs > HITCH_MS) return false;
+    frames_++;
+    late_ += frameMs > budgetMs_ * LATE_FACTOR;
+    workSum_ += workMs;
+    if (frames_ < EVAL_FRAMES) return false;
+
+    lastLatePct_ = 100.0 * late_ / frames_;
+    lastWorkMs_ = workSum_ / frames_;
+    const double lateRatio = (double)late_ / frames_;
+    frames_ = late_ = 0;
+    workSum_ = 0.0;
+    sinceChange_++;
+
+    const bool over = lateRatio > OVER_LATE_RATIO || lastWorkMs_ > budgetMs_ * OVER_WORK_RATIO;
+    const bool calm = lateRatio <= CALM_LATE_RATIO && lastWorkMs_ < budgetMs_ * CALM_WORK_RATIO;
+    overWindows_ = over ? overWindows_ + 1 : 0;
+    calmWindows_ = calm ? calmWindows_ + 1 : 0;
+
+    if (overWindows_ >= OVER_WINDOWS && tier_ < MAX_TIER) {
+        // Voltou a estourar logo depois de subir: espera o dobro na próxima
+        if (lastWasUp_ && sinceChange_ <= BOUNCE_WINDOWS) upWindows_ = std::min(MAX_UP_WINDOWS, upWindows_ * 2);
+        lastWasUp_ = false;
+        return setTier(tier_ + 1);
+    }
+    if (calmWindows_ >= upWindows_ && tier_ > 0) {
+        lastWasUp_ = true;
+        return setTier(tier_ - 1);
+    }
+    // Estável por muito tempo no mesmo tier: a próxima subida volta a ser rápida
+    if (sinceChange_ > MAX_UP_WINDOWS) upWindows_ = BASE_UP_WINDOWS;
+    return false;
+}
+
+void QualityGovernor::apply(const VisualConfig& config, VisualEffectsView& view) const {
+    const auto& fx = config.effects;
+    view.bannerSweep = fx.bannerSweep && tier_ < 1;
+    view.globalSweep = fx.globalSweep && tier_ < 1;
+    view.scanlineAlpha = tier_ < 2 ? fx.scanlineAlpha : 0;
+    view.particleDensity = tier_ < 3 ? fx.particleDensity : 0.0f;   // As que já estão no ar terminam
+    ROUNDED_PANELS = tier_ < 4 ? config.layout.roundedPanels : 0;
+    TEXT_OUTLINES = tier_ < 5 ? 1 : 0;
+}
+
+std::string QualityGovernor::statusLine() const {
+    if (!enabled_) return "OFF";
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "tier %d/%d %s, late %.0f%%, work %.1f/%.1fms", tier_, MAX_TIER, tierName(tier_),
+                  lastLatePct_, lastWorkMs_, budgetMs_);
+    return buf;
+}
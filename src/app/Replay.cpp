@@ -0,0 +1,232 @@
+#include "app/Replay.hpp"
+#include "app/HeadlessSim.hpp"
+#include "input/ReplayInput.hpp"
+#include "pieces/Piece.hpp"
+#include "pieces/PieceManager.hpp"
+#include "ConfigTypes.hpp"
+#include "DebugLogger.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+extern int COLS;
+extern int ROWS;
+extern std::vector<Piece> PIECES;
+extern GameConfig gameConfig;
+extern int SPEED_ACCELERATION;
+extern PieceManager pieceManager;
+
+namespace {
+
+const char MAGIC[4] = {'D', 'B', 'R', 'P'};
+constexpr uint16_t MULTI_STEPS = 1 << 15;   // Só no arquivo: passos != 1 seguem
+constexpr uint16_t REPEATING[3] = {SyntheticInput::MOVE_LEFT, SyntheticInput::MOVE_RIGHT, SyntheticInput::SOFT_DROP};
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) { out.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((uint8_t)v);
+}
+
+void putLE(std::vector<uint8_t>& out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+// Varint com sinal (zigzag), para o placar final
+void putSigned(std::vector<uint8_t>& out, int64_t v) {
+    putVarint(out, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+class Reader {
+public:
+    Reader(const uint8_t* p, size_t n) : p_(p), end_(p + n) {}
+    bool ok() const { return ok_; }
+    void fail() { ok_ = false; }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p_ >= end_) { ok_ = false; return 0; }
+            uint8_t b = *p_++;
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok_ = false;
+        return 0;
+    }
+    int64_t signedVarint() { uint64_t z = varint(); return (int64_t)(z >> 1) ^ -(int64_t)(z & 1); }
+    uint64_t le(int bytes) {
+        if (end_ - p_ < bytes) { ok_ = false; return 0; }
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i) v |= (uint64_t)*p_++ << (8 * i);
+        return v;
+    }
+    bool bytes(void* dst, size_t n) {
+        if ((size_t)(end_ - p_) < n) { ok_ = false; return false; }
+        std::memcpy(dst, p_, n);
+        p_ += n;
+        return true;
+    }
+
+private:
+    const uint8_t* p_;
+    const uint8_t* end_;
+    bool ok_ = true;
+};
+
+struct Fnv1a {
+    uint64_t h = 1469598103934665603ull;
+    void add(int64_t v) {
+        for (int i = 0; i < 8; ++i) { h ^= (uint8_t)(v >> (8 * i)); h *= 1099511628211ull; }
+    }
+};
+
+} // namespace
+
+std::vector<uint8_t> encodeReplay(const ReplayData& data) {
+    std::vector<uint8_t> out;
+    out.reserve(32 + data.events.size() * 3);
+    for (char c : MAGIC) out.push_back((uint8_t)c);
+    out.push_back(ReplayData::VERSION);
+    putLE(out, data.stepMs, 2);
+    putLE(out, data.seed, 4);
+    putLE(out, data.configHash, 8);
+
+    uint32_t prev = 0;
+    for (const ReplayEvent& e : data.events) {
+        if (!e.actions) continue;
+        uint16_t bits = e.actions & ~MULTI_STEPS;
+        bool multi = false;
+        for (int i = 0; i < 3; ++i) multi |= (bits & REPEATING[i]) && e.steps[i] != 1;
+        putVarint(out, e.tick - prev);
+        putVarint(out, multi ? (bits | MULTI_STEPS) : bits);
+        if (multi) {
+            for (int i = 0; i < 3; ++i) if (bits & REPEATING[i]) putVarint(out, e.steps[i] - 1u);
+        }
+        prev = e.tick;
+    }
+    putVarint(out, data.endTick >= prev ? data.endTick - prev : 0);
+    putVarint(out, 0);
+    putSigned(out, data.finalScore);
+    putSigned(out, data.finalLines);
+    putSigned(out, data.finalLevel);
+    putVarint(out, data.checkpoints.empty() ? 0 : data.checkpointTicks);
+    putVarint(out, data.checkpoints.size());
+    for (uint64_t h : data.checkpoints) putLE(out, h, 8);
+    return out;
+}
+
+bool decodeReplay(const uint8_t* bytes, size_t size, ReplayData& out) {
+    Reader r(bytes, size);
+    char magic[4];
+    if (!r.bytes(magic, 4) || std::memcmp(magic, MAGIC, 4) != 0) {
+        DebugLogger::error("Replay: bad magic");
+        return false;
+    }
+    uint8_t version = (uint8_t)r.le(1);
+    if (version != ReplayData::VERSION && version != 2) {
+        DebugLogger::error("Replay: unsupported version " + std::to_string(version));
+        return false;
+    }
+
+    ReplayData d;
+    d.stepMs = (uint16_t)r.le(2);
+    d.seed = (uint32_t)r.le(4);
+    d.configHash = r.le(8);
+
+    uint32_t tick = 0;
+    for (;;) {
+        tick += (uint32_t)r.varint();
+        uint16_t bits = (uint16_t)r.varint();
+        if (!r.ok()) break;
+        if (bits == 0) { d.endTick = tick; break; }
+
+        ReplayEvent e;
+        e.tick = tick;
+        e.actions = bits & ~MULTI_STEPS;
+        if (bits & MULTI_STEPS) {
+            for (int i = 0; i < 3; ++i) {
+                if (e.actions & REPEATING[i]) e.steps[i] = (uint8_t)(r.varint() + 1);
+            }
+        }
+        d.events.push_back(e);
+    }
+    d.finalScore = (int32_t)r.signedVarint();
+    d.finalLines = (int32_t)r.signedVarint();
+    d.finalLevel = (int32_t)r.signedVarint();
+    if (version >= 3) {
+        d.checkpointTicks = (uint32_t)r.varint();
+        const uint64_t count = r.varint();
+        // Um checkpoint por intervalo dentro da partida; mais que isso é lixo
+        if (r.ok() && d.checkpointTicks > 0 && count <= d.endTick / d.checkpointTicks) {
+            d.checkpoints.reserve((size_t)count);
+            for (uint64_t i = 0; i < count && r.ok(); ++i) d.checkpoints.push_back(r.le(8));
+        } else if (count > 0) {
+            r.fail();
+        }
+    }
+
+    if (!r.ok() || d.stepMs == 0) {
+        DebugLogger::error("Replay: truncated or corrupt stream");
+        return false;
+    }
+    out = std::move(d);
+    return true;
+}
+
+bool saveReplay(const std::string& path, const ReplayData& data) {
+    std::vector<uint8_t> bytes = encodeReplay(data);
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f.good()) { DebugLogger::error("Replay: could not write " + path); return false; }
+    f.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    return f.good();
+}
+
+bool loadReplay(const std::string& path, ReplayData& out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.good()) { DebugLogger::error("Replay: could not open " + path); return false; }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (!decodeReplay(bytes.data(), bytes.size(), out)) return false;
+    DebugLogger::info("Replay loaded: " + path + " (" + std::to_string(bytes.size()) + " bytes, " +
+                      std::to_string(out.events.size()) + " events, " + std::to_string(out.endTick) + " ticks)");
+    return true;
+}
+
+uint64_t replayConfigHash(uint16_t stepMs) {
+    Fnv1a h;
+    h.add(COLS); h.add(ROWS); h.add(stepMs);
+    h.add(gameConfig.tickMsStart); h.add(gameConfig.tickMsMin); h.add(SPEED_ACCELERATION);
+    h.add((int64_t)pieceManager.getRng().type()); h.add(pieceManager.getRandBagSize());
+    h.add((int64_t)PIECES.size());
+    for (const Piece& p : PIECES) {
+        for (const auto& rot : p.rot) {
+            h.add((int64_t)rot.size());
+            for (const auto& c : rot) { h.add(c.first); h.add(c.second); }
+        }
+        h.add((int64_t)p.kickTable.size());
+        for (const auto& k : p.kickTable) { h.add(k.first); h.add(k.second); }
+    }
+    return h.h;
+}
+
+ReplayResult runReplayHeadless(const ReplayData& data) {
+    ReplayResult res;
+    res.configMatches = data.configHash == replayConfigHash(data.stepMs);
+
+    HeadlessSim sim(data.stepMs);
+    sim.pieces().getRng().setType(pieceManager.getRng().type());
+    ReplayPlayer player(data, nullptr, &sim.state());
+    sim.setInput(&player);
+    sim.start(data.seed);
+    while (!player.done() && sim.state().isRunning()) sim.step();
+
+    const GameState& st = sim.state();
+    res.ticks = player.ticksPlayed();
+    res.score = st.getScoreValue();
+    res.lines = st.getLinesValue();
+    res.level = st.getLevelValue();
+    res.matches = res.score == data.finalScore && res.lines == data.finalLines && res.level == data.finalLevel;
+    res.checkpoints = player.checkpointsChecked();
+    res.divergedTick = player.divergedTick();
+    return res;
+}
@@ -0,0 +1,158 @@
+#include "app/ReplayVerifier.hpp"
+#include "util/MappedFile.hpp"
+#include "DebugLogger.hpp"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+double elapsedMs(Uint64 t0) {
+    return (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+void verifyOne(const std::string& path, ReplayVerdict& v) {
+    const Uint64 t0 = SDL_GetPerformanceCounter();
+    v.file = path;
+    {
+        MappedFile file(path);
+        if (!file.data() || !decodeReplay((const uint8_t*)file.data(), file.size(), v.recorded)) {
+            DebugLogger::warning("Verify: " + path + ": unreadable replay");
+            v.status = ReplayVerdict::CORRUPT;
+            return;
+        }
+    }
+    if ((uint64_t)v.recorded.endTick * v.recorded.stepMs > ReplayVerifier::MAX_GAME_MS) {
+        DebugLogger::warning("Verify: " + path + ": " + std::to_string(v.recorded.endTick) + " ticks, over the limit");
+        v.status = ReplayVerdict::TOO_LONG;
+        return;
+    }
+
+    v.result = runReplayHeadless(v.recorded);
+    v.status = v.result.divergedTick >= 0 ? ReplayVerdict::DIVERGED
+             : !v.result.matches          ? ReplayVerdict::MISMATCH
+                                          : ReplayVerdict::VERIFIED;
+    // Milhares de arquivos: o stream de ações não serve mais ao relatório
+    std::vector<ReplayEvent>().swap(v.recorded.events);
+    v.ms = elapsedMs(t0);
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) { out += ' '; continue; }
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+const char* ReplayVerdict::statusName(Status s) {
+    switch (s) {
+        case VERIFIED: return "verified";
+        case MISMATCH: return "mismatch";
+        case DIVERGED: return "diverged";
+        case CORRUPT:  return "corrupt";
+        case TOO_LONG: return "too_long";
+    }
+    return "unknown";
+}
+
+ReplayVerifier::ReplayVerifier(int threads)
+    : pool_((threads > 0 ? threads : SDL_GetCPUCount()) - 1) {
+}
+
+std::vector<std::string> ReplayVerifier::listReplays(const std::string& dir) {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() == ".dbr" && it->is_regular_file(ec)) paths.push_back(it->path().string());
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+void ReplayVerifier::verify(const std::vector<std::string>& paths, std::vector<ReplayVerdict>& out) {
+    out.assign(paths.size(), ReplayVerdict{});
+    // Uma tarefa por arquivo; cada uma escreve só no próprio veredito
+    auto body = [&paths, &out](int i) { verifyOne(paths[(size_t)i], out[(size_t)i]); };
+    pool_.parallelFor((int)paths.size(), body);
+}
+
+bool ReplayVerifier::writeJson(const std::string& path, const std::vector<ReplayVerdict>& verdicts,
+                               double wallMs, int threads) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.good()) return false;
+
+    int counts[5] = {};
+    for (const ReplayVerdict& v : verdicts) counts[v.status]++;
+    char buf[768];
+    std::snprintf(buf, sizeof(buf),
+                  "{\n  \"replays\": %zu,\n  \"threads\": %d,\n  \"wall_ms\": %.3f,\n"
+                  "  \"verified\": %d,\n  \"mismatch\": %d,\n  \"diverged\": %d,\n  \"corrupt\": %d,\n  \"too_long\": %d,\n"
+                  "  \"results\": [\n",
+                  verdicts.size(), threads, wallMs, counts[ReplayVerdict::VERIFIED], counts[ReplayVerdict::MISMATCH],
+                  counts[ReplayVerdict::DIVERGED], counts[ReplayVerdict::CORRUPT], counts[ReplayVerdict::TOO_LONG]);
+    out << buf;
+    for (size_t i = 0; i < verdicts.size(); ++i) {
+        const ReplayVerdict& v = verdicts[i];
+        const ReplayData& d = v.recorded;
+        const ReplayResult& r = v.result;
+        out << "    {\"file\": \"" << jsonEscape(v.file) << "\", \"status\": \"" << ReplayVerdict::statusName(v.status) << "\"";
+        if (v.status != ReplayVerdict::CORRUPT) {
+            std::snprintf(buf, sizeof(buf),
+                          ", \"seed\": %u, \"step_ms\": %u, \"ticks\": %u"
+                          ", \"score\": %d, \"recorded_score\": %d, \"lines\": %d, \"recorded_lines\": %d"
+                          ", \"level\": %d, \"recorded_level\": %d"
+                          ", \"checkpoints\": %u, \"recorded_checkpoints\": %zu, \"diverged_tick\": %lld"
+                          ", \"config_match\": %s, \"ms\": %.3f",
+                          d.seed, (unsigned)d.stepMs, v.status == ReplayVerdict::TOO_LONG ? d.endTick : r.ticks,
+                          r.score, d.finalScore, r.lines, d.finalLines, r.level, d.finalLevel,
+                          r.checkpoints, d.checkpoints.size(), (long long)r.divergedTick,
+                          r.configMatches ? "true" : "false", v.ms);
+            out << buf;
+        }
+        out << "}" << (i + 1 < verdicts.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return out.good();
+}
+
+int runReplayVerification(const std::string& dir, const std::string& jsonPath, int threads) {
+    std::error_code ec;
+    if (!fs::is_directory(dir, ec)) {
+        DebugLogger::error("Verify: " + dir + " is not a directory");
+        return 1;
+    }
+    const std::vector<std::string> paths = ReplayVerifier::listReplays(dir);
+    if (paths.empty()) DebugLogger::warning("Verify: no .dbr files in " + dir);
+
+    ReplayVerifier verifier(threads);
+    std::vector<ReplayVerdict> verdicts;
+    // Um "Replay finished" por arquivo enterraria o resumo: só avisos durante o lote
+    const int level = DebugLogger::getLevel();
+    if (level > DebugLogger::WARNING) DebugLogger::setLevel(DebugLogger::WARNING);
+    const Uint64 t0 = SDL_GetPerformanceCounter();
+    verifier.verify(paths, verdicts);
+    const double wallMs = elapsedMs(t0);
+    DebugLogger::setLevel(level);
+
+    int verified = 0;
+    for (const ReplayVerdict& v : verdicts) verified += v.status == ReplayVerdict::VERIFIED;
+    const bool written = ReplayVerifier::writeJson(jsonPath, verdicts, wallMs, verifier.concurrency());
+    if (!written) DebugLogger::error("Verify: could not write " + jsonPath);
+
+    DebugLogger::info("Verify: " + std::to_string(verified) + "/" + std::to_string(verdicts.size()) +
+                      " replay(s) verified in " + std::to_string(wallMs) + "ms on " +
+                      std::to_string(verifier.concurrency()) + " thread(s), " +
+                      std::to_string(verifier.stolenCount()) + " stolen" + (written ? " -> " + jsonPath : std::string()));
+    return written && verified == (int)verdicts.size() ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+#include "app/ResumeFile.hpp"
+#include "DebugLogger.hpp"
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIC[4] = {'D', 'B', 'R', 'S'};
+constexpr size_t HEADER = 24;   // magic + versão + tamanho da struct + hash da config + checksum
+
+void putLE(uint8_t* p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+uint64_t getLE(const uint8_t* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+uint32_t checksum(const uint8_t* p, size_t n) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+void syncFile(FILE* f) {
+    std::fflush(f);
+#if defined(_WIN32)
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+}
+
+} // namespace
+
+bool ResumeFile::load(const std::string& path, uint64_t configHash, GameSnapshot& out) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    uint8_t header[HEADER];
+    bool ok = std::fread(header, 1, HEADER, f) == HEADER &&
+              std::memcmp(header, MAGIC, 4) == 0 &&
+              getLE(header + 4, 4) == VERSION &&
+              getLE(header + 8, 4) == sizeof(GameSnapshot) &&
+              getLE(header + 12, 8) == configHash &&
+              std::fread(&out, 1, sizeof(GameSnapshot), f) == sizeof(GameSnapshot) &&
+              checksum(reinterpret_cast<const uint8_t*>(&out), sizeof(GameSnapshot)) == (uint32_t)getLE(header + 20, 4);
+    std::fclose(f);
+    if (!ok) DebugLogger::warning("Resume file: " + path + " is from another build/config or incomplete, ignored");
+    return ok && out.resumable && !out.gameOver;
+}
+
+bool ResumeFile::start(const std::string& path, uint64_t configHash) {
+    stop();
+    if (path.empty()) return false;
+    path_ = path;
+    configHash_ = configHash;
+    if (!mutex_) mutex_ = SDL_CreateMutex();
+    if (!wake_) wake_ = SDL_CreateSemaphore(0);
+    if (!mutex_ || !wake_) {
+        DebugLogger::error(std::string("Resume file: SDL_CreateMutex/Semaphore failed: ") + SDL_GetError());
+        stop();
+        return false;
+    }
+
+    // Os dois buffers de escrita já vêm do boot: submit() só copia
+    saved_.reset(new GameSnapshot());
+    if (!load(path_, configHash_, *saved_)) saved_.reset();
+    pending_.reset(new GameSnapshot());
+    writing_.reset(new GameSnapshot());
+    hasPending_ = discard_ = false;
+
+    quit_.store(false, std::memory_order_relaxed);
+    thread_ = SDL_CreateThread(&ResumeFile::threadMain, "dropblocks-resume", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("Resume file: SDL_CreateThread failed: ") + SDL_GetError());
+        stop();
+        return false;
+    }
+    DebugLogger::info("Resume file: " + path_ + (saved_ ? ", saved round found" : ", nothing to resume"));
+    return true;
+}
+
+void ResumeFile::stop() {
+    if (thread_) {
+        quit_.store(true, std::memory_order_release);
+        SDL_SemPost(wake_);
+        SDL_WaitThread(thread_, nullptr);
+        thread_ = nullptr;
+    }
+    if (wake_) { SDL_DestroySemaphore(wake_); wake_ = nullptr; }
+    if (mutex_) { SDL_DestroyMutex(mutex_); mutex_ = nullptr; }
+    pending_.reset();
+    writing_.reset();
+    hasPending_ = discard_ = false;
+}
+
+void ResumeFile::submit(const GameSnapshot& snap) {
+    if (!thread_ || !snap.resumable || snap.gameOver) return;
+    SDL_LockMutex(mutex_);
+    *pending_ = snap;
+    hasPending_ = true;
+    discard_ = false;
+    SDL_UnlockMutex(mutex_);
+    SDL_SemPost(wake_);
+}
+
+void ResumeFile::discard() {
+    if (!thread_) return;
+    SDL_LockMutex(mutex_);
+    hasPending_ = false;
+    discard_ = true;
+    SDL_UnlockMutex(mutex_);
+    SDL_SemPost(wake_);
+}
+
+int SDLCALL ResumeFile::threadMain(void* self) {
+    static_cast<ResumeFile*>(self)->loop();
+    return 0;
+}
+
+void ResumeFile::loop() {
+    for (;;) {
+        SDL_SemWait(wake_);
+        const bool quitting = quit_.load(std::memory_order_acquire);
+
+        SDL_LockMutex(mutex_);
+        const bool haveSnap = hasPending_, erase = discard_;
+        if (haveSnap) std::swap(pending_, writing_);
+        hasPending_ = discard_ = false;
+        SDL_UnlockMutex(mutex_);
+
+        if (erase) std::remove(path_.c_str());
+        else if (haveSnap && write(*writing_)) writes_.fetch_add(1, std::memory_order_relaxed);
+        if (quitting) break;
+    }
+}
+
+bool ResumeFile::write(const GameSnapshot& snap) {
+    uint8_t header[HEADER];
+    std::memcpy(header, MAGIC, 4);
+    putLE(header + 4, VERSION, 4);
+    putLE(header + 8, sizeof(GameSnapshot), 4);
+    putLE(header + 12, configHash_, 8);
+    putLE(header + 20, checksum(reinterpret_cast<const uint8_t*>(&snap), sizeof(GameSnapshot)), 4);
+
+    const std::string tmp = path_ + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) { DebugLogger::warning("Resume file: cannot write " + tmp); return false; }
+    const bool ok = std::fwrite(header, 1, HEADER, f) == HEADER &&
+                    std::fwrite(&snap, 1, sizeof(GameSnapshot), f) == sizeof(GameSnapshot);
+    syncFile(f);
+    std::fclose(f);
+    if (!ok) { DebugLogger::warning("Resume file: write failed for " + tmp); return false; }
+    std::remove(path_.c_str());  // rename não sobrescreve no Windows
+    if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+        DebugLogger::warning("Resume file: cannot rename " + tmp);
+        return false;
+    }
+    return true;
+}
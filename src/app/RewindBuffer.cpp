@@ -0,0 +1,59 @@
+#include "app/RewindBuffer.hpp"
+#include "app/GameState.hpp"
+#include "render/GameStateBridge.hpp"
+
+#include <algorithm>
+
+RewindBuffer::RewindBuffer(int slots, int intervalTicks)
+    : ring_((size_t)std::max(2, slots)), intervalTicks_(std::max(0, intervalTicks)) {}
+
+void RewindBuffer::capture(const GameState& state) {
+    const int slot = count_ ? (head_ + 1) % (int)ring_.size() : head_;
+    db_captureSnapshot(state, ring_[slot]);
+    if (!ring_[slot].resumable) return;  // mt19937: nada a guardar
+    head_ = slot;
+    count_ = std::min(count_ + 1, (int)ring_.size());
+    capturedTick_ = tick_;
+    unsaved_ = false;
+    captures_++;
+}
+
+void RewindBuffer::afterStep(const GameState& state) {
+    tick_++;
+    const Uint32 version = state.getBoard().getVersion();
+    const Uint32 round = state.getRoundVersion();
+    const bool changed = version != boardVersion_;
+    boardVersion_ = version;
+    if (!seen_ || round != roundVersion_) {
+        // Partida nova: o que havia era da anterior
+        seen_ = true;
+        roundVersion_ = round;
+        clear();
+        if (!state.isGameOver()) capture(state);
+        return;
+    }
+    if (state.isGameOver() || state.isPaused()) {
+        if (changed) unsaved_ = true;  // A peça que acabou a partida: o rewind volta para antes dela
+        return;
+    }
+    if (changed || (intervalTicks_ > 0 && tick_ - capturedTick_ >= (Uint32)intervalTicks_)) capture(state);
+}
+
+bool RewindBuffer::rewind(GameState& state) {
+    if (count_ == 0) return false;
+    // Jogando a peça do snapshot mais novo: desfazer é voltar ao anterior.
+    // Depois de um lock sem captura (game over), o mais novo já é o "antes"
+    if (!unsaved_ && count_ > 1) {
+        head_ = (head_ + (int)ring_.size() - 1) % (int)ring_.size();
+        count_--;
+    }
+    const Uint64 start = SDL_GetPerformanceCounter();
+    if (!state.restoreSnapshot(ring_[head_])) return false;
+    lastRestoreUs_ = (double)(SDL_GetPerformanceCounter() - start) * 1e6 / (double)SDL_GetPerformanceFrequency();
+    // O restore muda a versão do tabuleiro: não é um lock novo
+    boardVersion_ = state.getBoard().getVersion();
+    capturedTick_ = tick_;
+    unsaved_ = false;
+    rewinds_++;
+    return true;
+}
@@ -17,5 +17,8 @@ void ScoreSystem::addLines(int lines) {
 }
 void ScoreSystem::reset() { score_ = 0; lines_ = 0; level_ = 0; tickMs_ = gameConfig.tickMsStart; }
 void ScoreSystem::setTickMs(int ms) { tickMs_ = ms; }
+void ScoreSystem::restore(int score, int lines, int level, int tickMs) {
+    score_ = score; lines_ = lines; level_ = level; tickMs_ = tickMs;
+}
 
 
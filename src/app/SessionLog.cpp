@@ -0,0 +1,377 @@
+#include "app/SessionLog.hpp"
+#include "util/MappedFile.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char LOG_MAGIC[4] = {'D', 'B', 'S', 'L'};
+const char INDEX_MAGIC[4] = {'D', 'B', 'H', 'I'};
+constexpr uint32_t LOG_VERSION = 1;
+constexpr uint32_t INDEX_VERSION = 1;
+constexpr size_t LOG_HEADER = 8;        // magic + versão
+constexpr size_t FRAME_HEADER = 8;      // tamanho + checksum do payload
+constexpr size_t INDEX_HEADER = 20;     // magic + versão + bytes do log cobertos + quantidade
+constexpr size_t INDEX_ENTRY = 24;
+constexpr uint32_t MAX_PIECE_STATS = 4096;
+
+void putLE(std::vector<uint8_t>& out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+uint64_t getLE(const uint8_t* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+uint32_t checksum(const uint8_t* p, size_t n) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+// Cartão SD: sem isto o "gravado" pode estar só no cache do kernel
+void syncFile(FILE* f) {
+    std::fflush(f);
+#if defined(_WIN32)
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+}
+
+bool truncateFile(const std::string& path, uint64_t size) {
+#if defined(_WIN32)
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _chsize_s(fd, (long long)size) == 0;
+    _close(fd);
+    return ok;
+#else
+    return truncate(path.c_str(), (off_t)size) == 0;
+#endif
+}
+
+// Maior placar primeiro; empate fica com quem chegou antes
+bool ranksAbove(const HighScore& a, const HighScore& b) { return a.score > b.score; }
+
+} // namespace
+
+std::vector<uint8_t> encodeSessionRecord(const SessionRecord& r) {
+    std::vector<uint8_t> out;
+    out.reserve(30 + r.pieceStats.size() * 4);
+    putLE(out, r.endedAt, 8);
+    putLE(out, (uint32_t)r.score, 4);
+    putLE(out, (uint32_t)r.lines, 4);
+    putLE(out, (uint32_t)r.level, 4);
+    putLE(out, r.durationMs, 4);
+    putLE(out, r.flags, 4);
+    const uint32_t count = (uint32_t)std::min<size_t>(r.pieceStats.size(), MAX_PIECE_STATS);
+    putLE(out, count, 2);
+    for (uint32_t i = 0; i < count; ++i) putLE(out, r.pieceStats[i], 4);
+    return out;
+}
+
+bool decodeSessionRecord(const uint8_t* p, size_t n, SessionRecord& out) {
+    constexpr size_t FIXED = 30;
+    if (!p || n < FIXED) return false;
+    out.endedAt = getLE(p, 8);
+    out.score = (int32_t)getLE(p + 8, 4);
+    out.lines = (int32_t)getLE(p + 12, 4);
+    out.level = (int32_t)getLE(p + 16, 4);
+    out.durationMs = (uint32_t)getLE(p + 20, 4);
+    out.flags = (uint32_t)getLE(p + 24, 4);
+    const size_t count = (size_t)getLE(p + 28, 2);
+    // Campos novos entram depois das peças: payload maior que o esperado é aceito
+    if (n < FIXED + count * 4) return false;
+    out.pieceStats.resize(count);
+    for (size_t i = 0; i < count; ++i) out.pieceStats[i] = (uint32_t)getLE(p + FIXED + i * 4, 4);
+    return true;
+}
+
+bool SessionLog::start(const std::string& path, int highScoreCount, int fsyncMs) {
+    stop();
+    if (path.empty()) return false;
+    path_ = path;
+    capacity_ = std::max(1, std::min(highScoreCount, MAX_HIGH_SCORES));
+    fsyncMs_ = (Uint32)std::max(0, fsyncMs);
+    if (!mutex_) mutex_ = SDL_CreateMutex();
+    if (!wake_) wake_ = SDL_CreateSemaphore(0);
+    if (!mutex_ || !wake_) {
+        DebugLogger::error(std::string("Session log: SDL_CreateMutex/Semaphore failed: ") + SDL_GetError());
+        stop();
+        return false;
+    }
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    table_.clear();
+    const bool fromIndex = loadTable();
+
+    file_ = std::fopen(path_.c_str(), "ab");
+    if (!file_) {
+        DebugLogger::warning("Session log: cannot open " + path_ + ", sessions will not be saved");
+        stop();
+        return false;
+    }
+    if (logBytes_ == 0) {
+        std::fwrite(LOG_MAGIC, 1, 4, file_);
+        const uint8_t version[4] = {(uint8_t)LOG_VERSION, 0, 0, 0};
+        std::fwrite(version, 1, 4, file_);
+        std::fflush(file_);
+        logBytes_ = LOG_HEADER;
+    }
+
+    quit_.store(false, std::memory_order_relaxed);
+    thread_ = SDL_CreateThread(&SessionLog::threadMain, "dropblocks-sessions", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("Session log: SDL_CreateThread failed: ") + SDL_GetError());
+        stop();
+        return false;
+    }
+    if (tableDirty_) SDL_SemPost(wake_);  // Índice refeito a partir do log: a thread regrava
+
+    const double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    char line[160];
+    std::snprintf(line, sizeof(line), "Session log: %s, %d high score(s) from %s in %.2f ms, top %d",
+                  path_.c_str(), (int)table_.size(), fromIndex ? "index" : "log scan", ms,
+                  table_.empty() ? 0 : table_.front().score);
+    DebugLogger::info(line);
+    return true;
+}
+
+void SessionLog::stop() {
+    if (thread_) {
+        // A thread grava a fila, faz o último fsync e regrava o índice antes de sair
+        quit_.store(true, std::memory_order_release);
+        SDL_SemPost(wake_);
+        SDL_WaitThread(thread_, nullptr);
+        thread_ = nullptr;
+    }
+    if (file_) { std::fclose(file_); file_ = nullptr; }
+    if (wake_) { SDL_DestroySemaphore(wake_); wake_ = nullptr; }
+    if (mutex_) { SDL_DestroyMutex(mutex_); mutex_ = nullptr; }
+    queue_.clear();
+    tableDirty_ = false;
+}
+
+bool SessionLog::loadTable() {
+    const std::string indexPath = path_ + ".idx";
+    uint64_t covered = 0;
+    bool indexed = false;
+    bool partial = false;
+    {
+        MappedFile index(indexPath);
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(index.data());
+        const size_t n = index.size();
+        if (p && n >= INDEX_HEADER + 4 && std::memcmp(p, INDEX_MAGIC, 4) == 0 && getLE(p + 4, 4) == INDEX_VERSION) {
+            const size_t count = (size_t)getLE(p + 16, 4);
+            if (n == INDEX_HEADER + count * INDEX_ENTRY + 4 && checksum(p, n - 4) == (uint32_t)getLE(p + n - 4, 4)) {
+                covered = getLE(p + 8, 8);
+                const uint8_t* e = p + INDEX_HEADER;
+                for (size_t i = 0; i < count && (int)table_.size() < capacity_; ++i, e += INDEX_ENTRY) {
+                    HighScore h;
+                    h.score = (int32_t)getLE(e, 4);
+                    h.lines = (int32_t)getLE(e + 4, 4);
+                    h.level = (int32_t)getLE(e + 8, 4);
+                    h.durationMs = (uint32_t)getLE(e + 12, 4);
+                    h.endedAt = getLE(e + 16, 8);
+                    table_.push_back(h);
+                }
+                indexed = true;
+                // HIGH_SCORE_COUNT mudou: o índice é regravado com o novo tamanho
+                if (count > (size_t)capacity_) tableDirty_ = true;
+                // Índice com menos que o pedido (poucas partidas ou o ranking cresceu): relê o log todo
+                if (count < (size_t)capacity_) { table_.clear(); partial = true; }
+            }
+        }
+        if (p && !indexed) DebugLogger::warning("Session log: " + indexPath + " is invalid, rebuilding from the log");
+    }
+    if (partial) indexed = false;
+    const uint64_t end = scanLog(indexed ? covered : 0);
+    if (end == 0 && indexed) {
+        table_.clear();   // O log que o índice cobria sumiu: ranking vazio de novo
+        tableDirty_ = true;
+        indexed = false;
+    }
+    return indexed;
+}
+
+uint64_t SessionLog::scanLog(uint64_t from) {
+    uint64_t fileSize = 0;
+    uint64_t end = 0;
+    int records = 0;
+    {
+        MappedFile log(path_);
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(log.data());
+        fileSize = log.size();
+        if (!p) { logBytes_ = 0; return 0; }
+        if (fileSize < LOG_HEADER || std::memcmp(p, LOG_MAGIC, 4) != 0 || getLE(p + 4, 4) != LOG_VERSION) {
+            // Não é um log nosso (ou de outra versão): fica de lado, começa um novo
+            const std::string aside = path_ + ".old";
+            std::remove(aside.c_str());
+            std::rename(path_.c_str(), aside.c_str());
+            DebugLogger::warning("Session log: " + path_ + " is not a version " + std::to_string(LOG_VERSION) +
+                                 " session log, moved to " + aside);
+            logBytes_ = 0;
+            return 0;
+        }
+        if (from > fileSize) {
+            // O índice cobre mais do que o log tem (log trocado ou perdido): relê tudo
+            table_.clear();
+            tableDirty_ = true;
+            from = 0;
+        }
+        uint64_t off = std::max<uint64_t>(from, LOG_HEADER);
+        SessionRecord record;
+        while (off + FRAME_HEADER <= fileSize) {
+            const uint64_t len = getLE(p + off, 4);
+            const uint32_t sum = (uint32_t)getLE(p + off + 4, 4);
+            if (off + FRAME_HEADER + len > fileSize) break;
+            const uint8_t* payload = p + off + FRAME_HEADER;
+            if (checksum(payload, (size_t)len) != sum || !decodeSessionRecord(payload, (size_t)len, record)) break;
+            if (!(record.flags & (SessionRecord::BOT | SessionRecord::PRACTICE)) && insertScore(record)) tableDirty_ = true;
+            off += FRAME_HEADER + len;
+            ++records;
+        }
+        end = off;
+    }
+    if (end < fileSize) {
+        // Registro pela metade (queda de energia): o próximo append começa no último inteiro
+        DebugLogger::warning("Session log: dropping " + std::to_string(fileSize - end) + " byte(s) of a torn record");
+        if (!truncateFile(path_, end)) DebugLogger::warning("Session log: cannot truncate " + path_);
+    }
+    if (records > 0 && from > 0) tableDirty_ = true;   // Partidas depois do índice: regrava
+    logBytes_ = end;
+    return end;
+}
+
+bool SessionLog::insertScore(const SessionRecord& record) {
+    HighScore h;
+    h.score = record.score;
+    h.lines = record.lines;
+    h.level = record.level;
+    h.durationMs = record.durationMs;
+    h.endedAt = record.endedAt;
+    auto at = std::upper_bound(table_.begin(), table_.end(), h, ranksAbove);
+    if (at - table_.begin() >= capacity_) return false;
+    table_.insert(at, h);
+    if ((int)table_.size() > capacity_) table_.pop_back();
+    return true;
+}
+
+void SessionLog::submit(const SessionRecord& record) {
+    if (!thread_ || suspended_.load(std::memory_order_relaxed)) return;
+    const std::vector<uint8_t> payload = encodeSessionRecord(record);
+    std::vector<uint8_t> frame;
+    frame.reserve(FRAME_HEADER + payload.size());
+    putLE(frame, payload.size(), 4);
+    putLE(frame, checksum(payload.data(), payload.size()), 4);
+    frame.insert(frame.end(), payload.begin(), payload.end());
+
+    SDL_LockMutex(mutex_);
+    queue_.push_back(std::move(frame));
+    if (!(record.flags & (SessionRecord::BOT | SessionRecord::PRACTICE)) && insertScore(record)) {
+        tableDirty_ = true;
+        tableVersion_.fetch_add(1, std::memory_order_release);
+    }
+    SDL_UnlockMutex(mutex_);
+    SDL_SemPost(wake_);
+}
+
+int SessionLog::highScores(HighScore* out, int max) const {
+    if (!mutex_ || !out || max <= 0) return 0;
+    SDL_LockMutex(mutex_);
+    const int n = std::min(max, (int)table_.size());
+    std::copy(table_.begin(), table_.begin() + n, out);
+    SDL_UnlockMutex(mutex_);
+    return n;
+}
+
+int SDLCALL SessionLog::threadMain(void* self) {
+    static_cast<SessionLog*>(self)->loop();
+    return 0;
+}
+
+void SessionLog::loop() {
+    Uint32 lastSync = SDL_GetTicks();
+    bool unsynced = false;
+    std::vector<HighScore> table;
+    for (;;) {
+        // Com dados sem fsync, acorda sozinho quando o lote vence
+        if (unsynced) SDL_SemWaitTimeout(wake_, fsyncMs_);
+        else SDL_SemWait(wake_);
+        const bool quitting = quit_.load(std::memory_order_acquire);
+
+        SDL_LockMutex(mutex_);
+        batch_.swap(queue_);
+        const bool dirty = tableDirty_;
+        tableDirty_ = false;
+        if (dirty) table = table_;
+        SDL_UnlockMutex(mutex_);
+
+        if (!batch_.empty()) {
+            for (const std::vector<uint8_t>& frame : batch_) {
+                if (std::fwrite(frame.data(), 1, frame.size(), file_) != frame.size()) {
+                    DebugLogger::warning("Session log: write failed for " + path_);
+                    break;
+                }
+                logBytes_ += frame.size();
+                written_.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::fflush(file_);
+            batch_.clear();
+            unsynced = true;
+        }
+        const Uint32 now = SDL_GetTicks();
+        if (unsynced && (quitting || now - lastSync >= fsyncMs_)) {
+            syncFile(file_);
+            lastSync = now;
+            unsynced = false;
+        }
+        if (dirty) writeIndex(table, logBytes_);
+        if (quitting) break;
+    }
+}
+
+bool SessionLog::writeIndex(const std::vector<HighScore>& table, uint64_t logBytes) {
+    std::vector<uint8_t> out;
+    out.reserve(INDEX_HEADER + table.size() * INDEX_ENTRY + 4);
+    for (char c : INDEX_MAGIC) out.push_back((uint8_t)c);
+    putLE(out, INDEX_VERSION, 4);
+    putLE(out, logBytes, 8);
+    putLE(out, table.size(), 4);
+    for (const HighScore& h : table) {
+        putLE(out, (uint32_t)h.score, 4);
+        putLE(out, (uint32_t)h.lines, 4);
+        putLE(out, (uint32_t)h.level, 4);
+        putLE(out, h.durationMs, 4);
+        putLE(out, h.endedAt, 8);
+    }
+    putLE(out, checksum(out.data(), out.size()), 4);
+
+    const std::string indexPath = path_ + ".idx";
+    const std::string tmp = indexPath + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) { DebugLogger::warning("Session log: cannot write " + tmp); return false; }
+    const bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    syncFile(f);
+    std::fclose(f);
+    if (!ok) { DebugLogger::warning("Session log: write failed for " + tmp); return false; }
+    std::remove(indexPath.c_str());  // rename não sobrescreve no Windows
+    if (std::rename(tmp.c_str(), indexPath.c_str()) != 0) {
+        DebugLogger::warning("Session log: cannot rename " + tmp);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,120 @@
+#include "app/SimulationThread.hpp"
+#include "app/GameState.hpp"
+#include "input/InputManager.hpp"
+#include "render/GameStateBridge.hpp"
+#include "app/Tracing.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+
+SimulationThread::SimulationThread(GameState& state, InputManager& input, int stepMs)
+    : state_(state), input_(input), stepMs_(std::max(1, stepMs)), stepMutex_(SDL_CreateMutex()) {
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+    if (stepMutex_) SDL_DestroyMutex(stepMutex_);
+}
+
+bool SimulationThread::start() {
+    if (thread_) return true;
+
+    const IGameClock* previous = &state_.getClock();
+    clock_.set(previous->nowMs());  // Continua o relógio lógico atual
+    state_.setClock(&clock_);
+    input_.setPumpEvents(false);  // Eventos bombeados pela thread principal
+
+    // Render já tem o que desenhar no primeiro frame
+    publish();
+
+    quit_.store(false, std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    thread_ = SDL_CreateThread(&SimulationThread::threadMain, "dropblocks-sim", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("SDL_CreateThread failed: ") + SDL_GetError());
+        running_.store(false, std::memory_order_release);
+        input_.setPumpEvents(true);
+        state_.setClock(previous);
+        return false;
+    }
+    DebugLogger::info("Simulation thread started (" + std::to_string(stepMs_) + "ms step)");
+    return true;
+}
+
+void SimulationThread::stop() {
+    if (!thread_) return;
+    quit_.store(true, std::memory_order_release);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+    running_.store(false, std::memory_order_release);
+    input_.setPumpEvents(true);
+    state_.setClock(nullptr);  // clock_ morre com este objeto
+    DebugLogger::info("Simulation thread stopped");
+}
+
+int SDLCALL SimulationThread::threadMain(void* self) {
+    static_cast<SimulationThread*>(self)->loop();
+    return 0;
+}
+
+void SimulationThread::publish() {
+    GameSnapshot& snap = snapshots_.writeBuffer();
+    db_captureSnapshot(state_, snap);
+    snap.simTick = tick_;
+    snapshots_.publish();
+}
+
+void SimulationThread::loop() {
+    Trace::setThreadName("Simulation");
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    const Uint64 stepTicks = std::max<Uint64>(1, freq * (Uint64)stepMs_ / 1000);
+    Uint64 next = SDL_GetPerformanceCounter();
+
+    while (!quit_.load(std::memory_order_acquire)) {
+        Uint64 now = SDL_GetPerformanceCounter();
+
+        // Atraso maior que um lote (debugger, suspensão): descarta em vez de acelerar
+        if (now > next && now - next > stepTicks * MAX_STEPS_PER_BATCH) {
+            next = now - stepTicks * MAX_STEPS_PER_BATCH;
+        }
+
+        int steps = 0;
+        const Uint32 nowTicks = SDL_GetTicks();
+        SDL_LockMutex(stepMutex_);
+        while (now >= next && steps < MAX_STEPS_PER_BATCH && state_.isRunning()) {
+            DB_TRACE_ZONE("Sim step");
+            // INPUT_THREAD: o passo vê as teclas até o instante agendado dele, não até agora
+            input_.setSampleCutoff(nowTicks - (Uint32)((now - next) * 1000 / freq));
+            clock_.advance((Uint32)stepMs_);
+            db_update(state_, nullptr);  // Sem renderer: screenshot vira pedido no snapshot
+
+            if (input_.shouldToggleDebug()) debugToggles_.fetch_add(1, std::memory_order_acq_rel);
+            if (input_.shouldCycleTheme()) themeCycles_.fetch_add(1, std::memory_order_acq_rel);
+            if (input_.shouldDumpTrace()) traceDumps_.fetch_add(1, std::memory_order_acq_rel);
+            if (input_.shouldToggleTimer()) state_.getTimer().toggle();
+
+            next += stepTicks;
+            ++steps;
+            ++tick_;
+        }
+
+        if (steps > 0) {
+            state_.dispatchEvents();  // O lote é o "frame" desta thread
+            publish();
+            lastBatchUs_.store((Uint32)((SDL_GetPerformanceCounter() - now) * 1000000 / freq), std::memory_order_relaxed);
+            lastBatchSteps_.store(steps, std::memory_order_relaxed);
+        }
+        SDL_UnlockMutex(stepMutex_);
+        if (!state_.isRunning()) break;
+
+        // Dormir até o próximo passo; o último ~1 ms fica no yield (granularidade do SDL_Delay)
+        now = SDL_GetPerformanceCounter();
+        if (next > now) {
+            Uint32 waitMs = (Uint32)((next - now) * 1000 / freq);
+            SDL_Delay(waitMs > 1 ? waitMs - 1 : 0);
+        }
+    }
+
+    publish();  // Estado final (running=false quando o jogo encerrou)
+    running_.store(false, std::memory_order_release);
+}
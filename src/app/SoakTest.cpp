@@ -0,0 +1,221 @@
+#include "app/SoakTest.hpp"
+#include "app/AllocCounter.hpp"
+#include "render/GameStateBridge.hpp"
+#include "render/TexturePool.hpp"
+#include "ConfigManager.hpp"
+#include "ConfigTypes.hpp"
+#include "DebugLogger.hpp"
+#include "Interfaces.hpp"
+
+#include <algorithm>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+extern VisualEffectsView g_visualView;
+
+namespace {
+// Folga por série: oscilação normal (páginas do allocator, uma textura a mais) não é vazamento
+constexpr double MIN_GROWTH[] = {
+    2048.0,   // RSS, KB
+    256.0,    // blocos vivos do heap
+    4.0,      // texturas
+    1024.0,   // KB de textura
+    8.0,      // comandos na fila do mixer
+    0.5,      // ms médio por frame
+};
+
+// Residente em KB (/proc/self/statm); 0 onde não há /proc
+double residentKb() {
+#ifdef _WIN32
+    return 0.0;
+#else
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0.0;
+    unsigned long size = 0, resident = 0;
+    const int n = std::fscanf(f, "%lu %lu", &size, &resident);
+    std::fclose(f);
+    if (n != 2) return 0.0;
+    return (double)resident * (double)sysconf(_SC_PAGESIZE) / 1024.0;
+#endif
+}
+}
+
+void applySoakOverrides(ConfigManager& configManager, const SoakOptions& options) {
+    GameConfig& g = configManager.getGame();
+    g.replayFile = options.replayFile;
+    g.replaySpeed = "REALTIME";
+    g.botEnabled = options.replayFile.empty();
+    if (!options.replayFile.empty()) g.threadedMode = false;  // O loop do replay reinicia a partida nesta thread
+    g.idleRender = false;           // Game over parado também desenha: o soak mede frames
+    g.attractIdleSeconds = 0;
+    g.qualityGovernor = false;      // Desligaria justamente o que está sendo exercitado
+    g.sessionLog.clear();           // Horas de partidas do bot não vão para o ranking
+    g.resumeFile.clear();
+    g.splitPlayers = 1;             // Só o GameLoop amostra
+    g.netPeer.clear();
+    g.spectateSource.clear();
+
+    VisualConfig::Effects& fx = configManager.getVisual().effects;
+    fx.bannerSweep = fx.globalSweep = true;
+    fx.scanlineAlpha = std::max(fx.scanlineAlpha, 20);
+    fx.crtShader = true;            // Sem GL o CrtShader desiste sozinho e o resto segue
+    if (fx.particleCapacity <= 0) fx.particleCapacity = VisualConfig::Effects().particleCapacity;
+    if (fx.particleDensity <= 0.0f) fx.particleDensity = 1.0f;
+    g_visualView.bannerSweep = g_visualView.globalSweep = true;
+    g_visualView.scanlineAlpha = fx.scanlineAlpha;
+    g_visualView.crtShader = true;
+    g_visualView.particleCapacity = fx.particleCapacity;
+    g_visualView.particleDensity = fx.particleDensity;
+}
+
+const char* SoakMonitor::seriesName(int series) {
+    switch (series) {
+        case RSS:          return "rss";
+        case HEAP:         return "heap";
+        case TEXTURES:     return "textures";
+        case TEXTURE_KB:   return "texture_kb";
+        case AUDIO_QUEUED: return "audio_queued";
+        case FRAME_AVG:    return "frame_avg";
+    }
+    return "?";
+}
+
+bool SoakMonitor::start(const SoakOptions& options) {
+    if (options.hours <= 0.0) return false;
+    csv_ = std::fopen(options.csvPath.c_str(), "w");
+    if (!csv_) {
+        DebugLogger::error("Soak: cannot write " + options.csvPath);
+        return false;
+    }
+    std::fprintf(csv_, "sample,elapsed_s,rss_kb,heap_live_blocks,heap_allocs,heap_alloc_kb,textures,texture_kb,"
+                       "audio_queued,audio_voices,audio_overflows,frames,frame_avg_ms,frame_p50_ms,frame_p99_ms,frame_max_ms,flags\n");
+    std::fflush(csv_);
+    csvPath_ = options.csvPath;
+    hours_ = options.hours;
+    sampleMs_ = (Uint32)std::max(1, options.sampleSeconds) * 1000;
+    themeSeconds_ = std::max(0, options.themeSeconds);
+    startedAt_ = SDL_GetTicks();
+    endAt_ = startedAt_ + (Uint32)std::min(options.hours * 3600000.0, 2.0e9);  // expired() compara com sinal
+    nextSample_ = startedAt_ + sampleMs_;
+    const AllocCounter::Counts heap = AllocCounter::process();
+    allocsAtSample_ = heap.allocs;
+    bytesAtSample_ = heap.bytes;
+    DebugLogger::info("Soak: " + std::to_string(options.hours) + "h, " +
+                      (options.replayFile.empty() ? std::string("bot") : "replay " + options.replayFile) +
+                      ", a sample every " + std::to_string(sampleMs_ / 1000) + "s into " + options.csvPath +
+                      (AllocCounter::enabled() ? "" : " (heap columns need DROPBLOCKS_ALLOC_TRACKING)"));
+    return true;
+}
+
+void SoakMonitor::onFrame(double frameMs) {
+    if (csv_) frames_.add(frameMs);
+}
+
+void SoakMonitor::track(int series, double value) {
+    Trend& t = trends_[series];
+    if (samples_ <= WARMUP_SAMPLES || value < t.last) {
+        t.runStart = value;
+        t.runLength = 0;
+    } else {
+        t.runLength++;
+    }
+    t.last = value;
+    if (!t.flagged && t.runLength >= GROWTH_SAMPLES && value - t.runStart > MIN_GROWTH[series]) {
+        t.flagged = true;
+        char buf[160];
+        std::snprintf(buf, sizeof(buf), "Soak: %s grew for %d samples in a row (%.1f -> %.1f) at minute %.0f",
+                      seriesName(series), t.runLength, t.runStart, value,
+                      (double)(SDL_GetTicks() - startedAt_) / 60000.0);
+        DebugLogger::warning(buf);
+    }
+}
+
+void SoakMonitor::writeSample(Uint32 now, const IAudioSystem* audio) {
+    samples_++;
+    const TexturePool& pool = renderTargetPool();
+    const AllocCounter::Counts heap = AllocCounter::process();
+    const uint64_t heapLive = AllocCounter::liveBlocks();
+    AudioQueueStats aq;
+    if (audio) aq = audio->getQueueStats();
+    const double rssKb = residentKb();
+    const double textures = (double)(pool.liveCount() + pool.freeCount());
+    const double textureKb = (double)(pool.totalBytes() >> 10);
+    const double avg = frames_.avgMs();
+    const double p50 = frames_.percentileMs(0.50);
+    const double p99 = frames_.percentileMs(0.99);
+
+    track(RSS, rssKb);
+    if (AllocCounter::enabled()) track(HEAP, (double)heapLive);
+    track(TEXTURES, textures);
+    track(TEXTURE_KB, textureKb);
+    track(AUDIO_QUEUED, (double)aq.queued);
+    if (frames_.count()) track(FRAME_AVG, avg);
+
+    std::string flags;
+    for (int i = 0; i < SERIES_COUNT; ++i) {
+        if (!trends_[i].flagged) continue;
+        if (!flags.empty()) flags += ';';
+        flags += seriesName(i);
+    }
+    const double elapsed = (double)(now - startedAt_) / 1000.0;
+    std::fprintf(csv_, "%d,%.0f,%.0f,%llu,%llu,%llu,%.0f,%.0f,%d,%d,%u,%llu,%.3f,%.3f,%.3f,%.3f,%s\n",
+                 samples_, elapsed, rssKb, (unsigned long long)heapLive,
+                 (unsigned long long)(heap.allocs - allocsAtSample_), (unsigned long long)((heap.bytes - bytesAtSample_) >> 10),
+                 textures, textureKb, aq.queued, aq.activeVoices, aq.overflows, (unsigned long long)frames_.count(),
+                 avg, p50, p99, frames_.maxMs(), flags.c_str());
+    std::fflush(csv_);  // Um corte no meio das horas não leva as amostras junto
+
+    if (firstRssKb_ < 0.0) firstRssKb_ = rssKb;
+    lastRssKb_ = rssKb;
+    lastP99_ = p99;
+    allocsAtSample_ = heap.allocs;
+    bytesAtSample_ = heap.bytes;
+    frames_.clear();
+}
+
+bool SoakMonitor::poll(Uint32 now, const IAudioSystem* audio) {
+    if (!csv_ || (Sint32)(now - nextSample_) < 0) return false;
+    nextSample_ += sampleMs_;
+    if ((Sint32)(now - nextSample_) >= 0) nextSample_ = now + sampleMs_;  // Uma pausa longa não vira rajada de linhas
+    writeSample(now, audio);
+    return true;
+}
+
+void SoakMonitor::finish(const IAudioSystem* audio) {
+    if (!csv_) return;
+    if (frames_.count()) writeSample(SDL_GetTicks(), audio);
+    std::fclose(csv_);
+    csv_ = nullptr;
+
+    std::string growing;
+    for (int i = 0; i < SERIES_COUNT; ++i) {
+        if (trends_[i].flagged) growing += std::string(growing.empty() ? "" : ", ") + seriesName(i);
+    }
+    char buf[192];
+    std::snprintf(buf, sizeof(buf), "Soak: %d sample(s) in %s, rss %.0f -> %.0f KB, last p99 %.2fms", samples_,
+                  csvPath_.c_str(), std::max(0.0, firstRssKb_), lastRssKb_, lastP99_);
+    if (growing.empty()) DebugLogger::info(std::string(buf) + ", no monotonic growth");
+    else DebugLogger::warning(std::string(buf) + ", GROWING: " + growing);
+}
+
+bool SoakMonitor::flagged() const {
+    for (const Trend& t : trends_) if (t.flagged) return true;
+    return false;
+}
+
+std::string SoakMonitor::statusLine() const {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "min %.0f/%.0f, rss %.1fM, p99 %.1fms", (double)samples_ * sampleMs_ / 60000.0,
+                  hours_ * 60.0, lastRssKb_ / 1024.0, lastP99_);
+    std::string out = buf;
+    const char* sep = ", growing: ";
+    for (int i = 0; i < SERIES_COUNT; ++i) {
+        if (!trends_[i].flagged) continue;
+        out += sep;
+        out += seriesName(i);
+        sep = ";";
+    }
+    return out;
+}
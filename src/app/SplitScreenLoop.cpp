@@ -0,0 +1,421 @@
+#include "app/SplitScreenLoop.hpp"
+#include "app/GameState.hpp"
+#include "app/GameClock.hpp"
+#include "app/FrameScheduler.hpp"
+#include "app/DeferredStartup.hpp"
+#include "app/Replay.hpp"
+#include "app/FrameArena.hpp"
+#include "ai/BotEngine.hpp"
+#include "audio/NullAudioSystem.hpp"
+#include "config/ConfigApplicator.hpp"
+#include "di/ServiceRegistry.hpp"
+#include "input/BotInput.hpp"
+#include "input/InputManager.hpp"
+#include "input/SeatInput.hpp"
+#include "net/NetSession.hpp"
+#include "net/NetVersus.hpp"
+#include "pieces/PieceManager.hpp"
+#include "render/GameStateBridge.hpp"
+#include "render/Layers.hpp"
+#include "render/LayoutCache.hpp"
+#include "render/RenderManager.hpp"
+#include "render/SoftRaster.hpp"
+#include "render/TextureCache.hpp"
+#include "render/TextTextureCache.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
+#include "util/ScreenshotWriter.hpp"
+#include "ConfigManager.hpp"
+#include "DebugLogger.hpp"
+#include "DebugOverlay.hpp"
+#include "ThemeManager.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+extern ThemeManager themeManager;
+extern int CACHED_PANELS;
+extern int CACHED_LAYERS;
+extern PieceManager pieceManager;
+
+namespace {
+
+/// Jogadores 2..N: tudo que o GameState do assento usa e que não é compartilhado
+struct Seat {
+    NullAudioSystem audio;   // Um tabuleiro só toca música/efeitos: o do jogador 1
+    PieceManager pieces;
+    SeatInput keys;
+    std::unique_ptr<BotEngine> engine;
+    std::unique_ptr<BotInput> bot;
+    ManualClock clock;
+    GameState state;
+    RenderManager render;    // Layers guardam texturas do próprio tabuleiro (pilha)
+
+    Seat(int seatNumber, SDL_Renderer* ren) : keys(seatNumber), render(ren) {}
+};
+
+/**
+ * Passos dos assentos em paralelo: a thread principal e os workers pegam o
+ * próximo assento de um contador atômico até acabar; run() volta quando todos
+ * terminaram. Semáforos do SDL (o build não liga -pthread).
+ */
+class SeatWorkers {
+public:
+    ~SeatWorkers() { stop(); }
+
+    bool start(int threads) {
+        done_ = SDL_CreateSemaphore(0);
+        if (!done_) return false;
+        for (int i = 0; i < threads; ++i) {
+            Worker w;
+            w.owner = this;
+            w.go = SDL_CreateSemaphore(0);
+            if (!w.go) break;
+            workers_.push_back(w);
+        }
+        // Ponteiros estáveis: as threads só nascem com o vetor pronto, e na primeira
+        // falha o resto sai do fim (nada antes dela se move)
+        size_t started = 0;
+        for (; started < workers_.size(); ++started) {
+            Worker& w = workers_[started];
+            w.thread = SDL_CreateThread(&SeatWorkers::threadMain, "dropblocks-seat", &w);
+            if (!w.thread) {
+                DebugLogger::warning(std::string("SeatWorkers: SDL_CreateThread failed: ") + SDL_GetError());
+                break;
+            }
+        }
+        for (size_t i = started; i < workers_.size(); ++i) SDL_DestroySemaphore(workers_[i].go);
+        workers_.resize(started);
+        return !workers_.empty();
+    }
+
+    void stop() {
+        quit_.store(true, std::memory_order_release);
+        for (Worker& w : workers_) SDL_SemPost(w.go);
+        for (Worker& w : workers_) {
+            SDL_WaitThread(w.thread, nullptr);
+            SDL_DestroySemaphore(w.go);
+        }
+        workers_.clear();
+        if (done_) { SDL_DestroySemaphore(done_); done_ = nullptr; }
+    }
+
+    int threads() const { return (int)workers_.size(); }
+
+    /// steps passos de stepMs em cada assento; a thread principal participa
+    void run(std::vector<std::unique_ptr<Seat>>& seats, int steps, int stepMs) {
+        seats_ = &seats;
+        steps_ = steps;
+        stepMs_ = stepMs;
+        next_.store(0, std::memory_order_release);
+        for (Worker& w : workers_) SDL_SemPost(w.go);
+        drain();
+        for (size_t i = 0; i < workers_.size(); ++i) SDL_SemWait(done_);
+    }
+
+    static void stepSeat(Seat& seat, int steps, int stepMs) {
+        for (int i = 0; i < steps && seat.state.isRunning(); ++i) {
+            seat.clock.advance((Uint32)stepMs);
+            db_update(seat.state, nullptr);  // Sem renderer: screenshot é só do jogador 1
+        }
+        seat.state.dispatchEvents();  // Na thread que rodou os passos do assento
+    }
+
+private:
+    struct Worker {
+        SeatWorkers* owner = nullptr;
+        SDL_sem* go = nullptr;
+        SDL_Thread* thread = nullptr;
+    };
+
+    static int SDLCALL threadMain(void* data) {
+        Worker& w = *static_cast<Worker*>(data);
+        SeatWorkers& self = *w.owner;
+        for (;;) {
+            SDL_SemWait(w.go);
+            if (self.quit_.load(std::memory_order_acquire)) break;
+            self.drain();
+            SDL_SemPost(self.done_);
+        }
+        return 0;
+    }
+
+    void drain() {
+        const int count = (int)seats_->size();
+        for (int i = next_.fetch_add(1, std::memory_order_acq_rel); i < count;
+             i = next_.fetch_add(1, std::memory_order_acq_rel)) {
+            stepSeat(*(*seats_)[i], steps_, stepMs_);
+        }
+    }
+
+    std::vector<Worker> workers_;
+    SDL_sem* done_ = nullptr;
+    std::atomic<bool> quit_{false};
+    std::atomic<int> next_{0};
+    std::vector<std::unique_ptr<Seat>>* seats_ = nullptr;
+    int steps_ = 0;
+    int stepMs_ = 0;
+};
+
+} // namespace
+
+void SplitScreenLoop::run(GameState& state, RenderManager& renderManager, SDL_Renderer* ren,
+                          ConfigManager& configManager, InputManager& inputManager) {
+    if (running_) { DebugLogger::warning("Split-screen loop is already running"); return; }
+    if (!ren) { DebugLogger::error("Renderer is null; split-screen not started"); return; }
+    running_ = true;
+    const GameConfig& gameCfg = configManager.getGame();
+    const InputConfig& inputCfg = configManager.getInput();
+    // NET_PEER: o segundo tabuleiro é o espelho do par, não um assento local
+    const bool netplay = !gameCfg.netPeer.empty();
+    const int players = netplay ? 2 : std::max(2, std::min(4, gameCfg.splitPlayers));
+
+    // O DAS/ARR dos assentos é o mesmo do jogador 1
+    InputTimingManager::TimingConfig timing;
+    timing.DAS = inputCfg.moveRepeatDelayDAS;
+    timing.ARR = inputCfg.moveRepeatDelayARR;
+    timing.softDropDelay = inputCfg.softDropRepeatDelay;
+
+    ManualClock primaryClock;
+    primaryClock.set(SDL_GetTicks());
+    state.setClock(&primaryClock);
+    // F12 do jogador 1: captura a tela inteira depois do draw (ver GameLoop)
+    ScreenshotWriter screenshots;
+    if (screenshots.start()) state.setScreenshotWriter(&screenshots);
+    Uint32 lastScreenshotRequests = state.getScreenshotRequests();
+
+    std::vector<std::unique_ptr<Seat>> seats;
+    for (int p = 2; p <= players; ++p) {
+        std::unique_ptr<Seat> seat(new Seat(p, ren));
+        IInputManager* input = &seat->keys;
+        if (netplay) {
+            // O NetVersus troca pelo input remoto; SeatInput parado até lá
+        } else if (gameCfg.splitBots) {
+            // Só a thread da lógica: a busca roda dentro do passo do assento (já paralelo)
+            seat->engine.reset(new BotEngine(0));
+            seat->engine->setWeights(BotWeights{gameCfg.botWeightHeight, gameCfg.botWeightLines,
+                                                gameCfg.botWeightHoles, gameCfg.botWeightBumpiness});
+            seat->engine->setLookahead(gameCfg.botLookahead);
+            seat->engine->setBudgetMs(gameCfg.botBudgetMs);
+            seat->bot.reset(new BotInput(*seat->engine, seat->state, nullptr));
+            seat->bot->setActionDelayMs((Uint32)std::max(0, gameCfg.botActionDelayMs));
+            seat->bot->setAutoRestart(true, 3000);
+            input = seat->bot.get();
+        } else {
+            seat->keys.keyboard().getTimingManager().setConfig(timing);
+            inputManager.addSeatKeyboard(&seat->keys.keyboard());
+        }
+
+        GameServices services;
+        services.provide<IAudioSystem>(&seat->audio);
+        services.provide<IThemeManager>(&themeManager);
+        services.provide<IPieceManager>(&seat->pieces);
+        services.provide<IInputManager>(input);
+        services.provide<IGameConfig>(&configManager);
+        seat->state.setServices(services);
+        ConfigApplicator::applyConfigToGame(seat->state, gameCfg);
+        seat->state.setTimerConfig(configManager.getTimer());
+        seat->clock.set(primaryClock.nowMs());
+        seat->state.setClock(&seat->clock);
+        addDefaultLayers(seat->render, nullptr);
+        seats.push_back(std::move(seat));
+    }
+
+    // Mesma sequência de peças para todos: o sorteio parte do estado do jogador 1
+    const PieceManager::Snapshot deal = pieceManager.saveState();
+    for (auto& seat : seats) {
+        seat->pieces.restoreState(deal);
+        seat->state.restartRound();
+    }
+    pieceManager.restoreState(deal);
+    state.restartRound();
+
+    FrameScheduler scheduler;
+    FramePacing pacing = parseFramePacing(gameCfg.framePacing);
+    if (pacing == FramePacing::VSYNC && SoftRaster::isFrameRenderer(ren)) pacing = FramePacing::CAPPED;  // Present não espera o refresh
+    scheduler.configure(pacing, gameCfg.targetFps, gameCfg.simStepMs);
+    const std::string pacingName = framePacingName(scheduler.getMode());
+    const int stepMs = scheduler.getStepMs();
+
+    NetSession session;
+    std::unique_ptr<NetVersus> net;
+    bool netStarted = false;  // Primeiro passo só com o par conectado
+    if (netplay) {
+        if (!session.start(gameCfg.netPeer, gameCfg.netPort, replayConfigHash((uint16_t)stepMs), (uint16_t)stepMs)) {
+            running_ = false;
+            seats.clear();
+            state.setClock(nullptr);
+            state.setScreenshotWriter(nullptr);
+            return;
+        }
+        Seat& mirror = *seats[0];
+        net.reset(new NetVersus(session, state, inputManager, pieceManager.getRng(), mirror.state, mirror.pieces.getRng()));
+        net->setChecksumTicks(gameCfg.netChecksumTicks);
+        net->setGarbageEnabled(gameCfg.netGarbage);
+        net->install();
+    }
+
+    SeatWorkers workers;
+    if (!netplay && gameCfg.splitParallel && seats.size() > 1 && SDL_GetCPUCount() > 1) {
+        // A thread principal pega um assento também
+        int threads = std::min((int)seats.size() - 1, SDL_GetCPUCount() - 1);
+        if (!workers.start(threads)) DebugLogger::info("Split-screen: seat workers unavailable, updating in sequence");
+    }
+    DebugLogger::info("Split-screen: " + std::to_string(players) + " boards" +
+                      (netplay ? " (board 2 mirrors " + gameCfg.netPeer + ")" : "") +
+                      (gameCfg.splitBots && !netplay ? " (seats 2-" + std::to_string(players) + " played by the bot)" : "") +
+                      ", " + std::to_string(workers.threads()) + " seat worker thread(s)");
+
+    // Uma fatia de largura W/N por tabuleiro; o layout é o mesmo para todas
+    LayoutCache layout;
+    TextureCache textureCache;
+    TextTextureCache textCache;
+    textCache.setCapacity(TextTextureCache::MAX_ENTRIES * (size_t)players);
+    DebugOverlay debugOverlay;
+    debugOverlay.setConfigInfo(configManager.getConfigPaths());
+    std::vector<SDL_Rect> viewports((size_t)players);
+    int screenW = -1, screenH = -1;
+    auto relayout = [&](int w, int h) {
+        screenW = w;
+        screenH = h;
+        const int regionW = std::max(1, w / players);
+        const int x0 = (w - regionW * players) / 2;  // Sobra de pixels dividida nas bordas
+        db_layoutCalculateSize(layout, regionW, h);
+        layout.region = true;
+        for (int i = 0; i < players; ++i) viewports[i] = SDL_Rect{x0 + i * regionW, 0, regionW, h};
+        textCache.clear();
+        if (CACHED_PANELS) {
+            textureCache.update(ren, layout, themeManager);
+            layout.panels = &textureCache;
+            layout.texts = &textCache;
+        } else {
+            textureCache.cleanup();
+            layout.panels = nullptr;
+            layout.texts = nullptr;
+        }
+        // Cada assento retém as próprias layers, numa target do tamanho da fatia
+        renderManager.setRetained(CACHED_LAYERS != 0);
+        renderManager.invalidateCache();
+        for (auto& seat : seats) {
+            seat->render.setRetained(CACHED_LAYERS != 0);
+            seat->render.invalidateCache();
+        }
+    };
+
+    debugOverlay.setCustomValue("SPLIT", std::to_string(players) + " boards, " +
+                                std::to_string(workers.threads() + 1) + " update thread(s)");
+    scheduler.start();
+    FrameArena& arena = frameArena();
+    arena.reserve((size_t)gameCfg.frameArenaKb << 10);
+
+    while (running_ && db_isRunning(state)) {
+        arena.reset();
+        SDL_ShowCursor(SDL_DISABLE);
+        if (deferred_ && deferred_->isPending()) deferred_->update();
+
+        scheduler.waitBeforeFrame();
+        int steps = scheduler.beginFrame();
+        renderTargetPool().beginFrame();
+
+        int w, h;
+        SDL_GetRendererOutputSize(ren, &w, &h);
+        if (w != screenW || h != screenH) relayout(w, h);
+
+        if (net) {
+            net->poll();
+            if (!netStarted && session.connected()) netStarted = true;
+            if (!netStarted) {
+                // Sem passos até o par aparecer; eventos continuam (ESC sai)
+                inputManager.update();
+                if (inputManager.shouldQuit()) state.setRunning(false);
+                steps = 0;
+            }
+        }
+
+        // Jogador 1 primeiro: o update dele bombeia os eventos dos teclados dos assentos
+        for (int i = 0; i < steps && db_isRunning(state) && running_; ++i) {
+            if (net) net->beforeLocalStep();
+            primaryClock.advance((Uint32)stepMs);
+            db_update(state, ren);
+            if (net) net->afterLocalStep();
+            if (inputManager.shouldToggleDebug()) debugOverlay.toggle();
+            if (inputManager.shouldToggleTimer()) state.getTimer().toggle();
+        }
+        state.dispatchEvents();
+        if (net) {
+            // Espelho: todo tick que já chegou inteiro, com teto para não travar o frame ao recuperar
+            Seat& mirror = *seats[0];
+            net->poll();
+            const int budget = std::max(8, steps * 4);
+            for (int i = 0; i < budget && net->mirrorReady(); ++i) {
+                net->beforeMirrorStep();
+                mirror.clock.advance((Uint32)stepMs);
+                db_update(mirror.state, nullptr);
+                net->afterMirrorStep();
+            }
+            mirror.state.dispatchEvents();
+            debugOverlay.setCustomValue("NET", arena.format("%s, rtt %dms, lag %u ticks, garbage %d, desync %u",
+                                        NetSession::statusName(session.status()), (int)session.rttMs(),
+                                        net->mirrorLag(), net->pendingGarbage(), net->desyncs()));
+        } else {
+            for (auto& seat : seats) {
+                if (!seat->state.isGameOver() && seat->state.isPaused() != state.isPaused()) {
+                    seat->state.setPaused(state.isPaused());
+                }
+            }
+            if (workers.threads() > 0) {
+                workers.run(seats, steps, stepMs);
+            } else {
+                for (auto& seat : seats) SeatWorkers::stepSeat(*seat, steps, stepMs);
+            }
+        }
+        scheduler.markSimDone();
+
+        // Viewport desliga antes do clear: SDL_RenderClear ignora o viewport e limpa a janela toda
+        SDL_RenderSetViewport(ren, nullptr);
+        SDL_SetRenderDrawColor(ren, 0, 0, 0, 255);
+        DrawCalls::clear(ren);
+        for (int i = 0; i < players; ++i) {
+            SDL_RenderSetViewport(ren, &viewports[i]);
+            if (i == 0) db_render(state, renderManager, layout);
+            else db_render(seats[i - 1]->state, seats[i - 1]->render, layout);
+            SDL_RenderSetClipRect(ren, nullptr);  // O Background prende o clip na área virtual da fatia
+        }
+        SDL_RenderSetViewport(ren, nullptr);
+        if (debugOverlay.isEnabled()) debugOverlay.render(ren, screenW, screenH);
+        if (state.getScreenshotRequests() != lastScreenshotRequests) {
+            lastScreenshotRequests = state.getScreenshotRequests();
+            screenshots.capture(ren);
+        }
+        scheduler.markRenderDone();
+
+        SoftRaster::present(ren);
+        scheduler.endFrame();
+
+        const FrameTimings& ft = scheduler.timings();
+        debugOverlay.update((float)ft.frameMs);
+        debugOverlay.setFrameTimings(ft.simMs, ft.renderMs, ft.waitMs, ft.steps, pacingName, gameCfg.targetFps);
+    }
+
+    workers.stop();
+    if (net) {
+        session.stop();
+        DebugLogger::info("Netplay: " + std::string(NetSession::statusName(session.status())) + ", " +
+                          std::to_string(net->localTick()) + " local / " + std::to_string(net->mirrorTick()) +
+                          " peer ticks, " + std::to_string(net->checksumsMatched()) + " checksums matched, " +
+                          std::to_string(net->desyncs()) + " desync(s), " + std::to_string(session.packetsSent()) +
+                          " packets sent / " + std::to_string(session.packetsReceived()) + " received");
+        state.setInput(&inputManager);
+        net.reset();
+    }
+    for (auto& seat : seats) inputManager.removeSeatKeyboard(&seat->keys.keyboard());
+    seats.clear();  // Layers dos assentos antes do renderer
+    state.setClock(nullptr);  // primaryClock goes out of scope
+    state.setScreenshotWriter(nullptr);
+    textureCache.cleanup();
+    textCache.clear();
+    running_ = false;
+    DebugLogger::info("Split-screen loop ended");
+}
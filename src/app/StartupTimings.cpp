@@ -0,0 +1,32 @@
+#include "app/StartupTimings.hpp"
+#include "app/Tracing.hpp"
+
+#include <cstdio>
+
+Uint64 StartupTimings::add(const char* name, Uint64 startTicks, bool worker) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (Trace::isEnabled()) Trace::record(name, startTicks, now);  // DROPBLOCKS_TRACE: o boot na timeline
+    Phase p;
+    p.name = name;
+    p.ms = (double)(now - startTicks) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    p.worker = worker;
+    phases.push_back(p);
+    return now;
+}
+
+void StartupTimings::merge(const StartupTimings& other) {
+    phases.insert(phases.end(), other.phases.begin(), other.phases.end());
+}
+
+std::string StartupTimings::summary() const {
+    std::string out;
+    char buf[96];
+    for (const Phase& p : phases) {
+        // Entre colchetes: outra thread, em paralelo com a principal
+        std::snprintf(buf, sizeof(buf), p.worker ? "[%s %.1fms]" : "%s %.1fms", p.name.c_str(), p.ms);
+        if (!out.empty()) out += ", ";
+        out += buf;
+    }
+    std::snprintf(buf, sizeof(buf), " = %.1fms", totalMs);
+    return out + buf;
+}
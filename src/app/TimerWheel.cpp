@@ -0,0 +1,144 @@
+#include "app/TimerWheel.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <string>
+
+static_assert((TimerWheel::SLOTS & (TimerWheel::SLOTS - 1)) == 0, "SLOTS precisa ser potência de 2");
+
+namespace {
+constexpr Uint32 SLOT_MASK = TimerWheel::SLOTS - 1;
+bool reached(Uint32 deadline, Uint32 now) { return (Sint32)(now - deadline) >= 0; }  // tolera wrap do relógio
+}
+
+TimerWheel::TimerWheel(int capacity)
+    : entries_((size_t)std::max(1, capacity)) {
+    free_.reserve(entries_.size());
+    due_.reserve(entries_.size());
+    calls_.reserve(entries_.size());
+    reset(0);
+}
+
+void TimerWheel::reset(Uint32 now) {
+    std::fill(heads_, heads_ + SLOTS + 1, -1);
+    free_.clear();
+    for (int i = (int)entries_.size() - 1; i >= 0; --i) {
+        Entry& e = entries_[i];
+        if (e.list >= 0) e.gen++;   // Ids antigos deixam de valer
+        e.list = e.prev = e.next = -1;
+        free_.push_back(i);
+    }
+    active_ = 0;
+    cursor_ = now;
+}
+
+void TimerWheel::link(int idx, int list) {
+    Entry& e = entries_[idx];
+    e.list = list;
+    e.prev = -1;
+    e.next = heads_[list];
+    if (e.next >= 0) entries_[e.next].prev = idx;
+    heads_[list] = idx;
+}
+
+void TimerWheel::unlink(int idx) {
+    Entry& e = entries_[idx];
+    if (e.prev >= 0) entries_[e.prev].next = e.next;
+    else heads_[e.list] = e.next;
+    if (e.next >= 0) entries_[e.next].prev = e.prev;
+    e.prev = e.next = -1;
+    e.list = -1;
+}
+
+int TimerWheel::take(Id id) const {
+    const int idx = (int)(id & 0xFFFFu) - 1;
+    if (idx < 0 || idx >= (int)entries_.size()) return -1;
+    const Entry& e = entries_[idx];
+    return e.list >= 0 && e.gen == (uint16_t)(id >> 16) ? idx : -1;
+}
+
+TimerWheel::Id TimerWheel::schedule(Uint32 deadline, Callback fn, void* user) {
+    if (!fn) return 0;
+    if (free_.empty()) {
+        DebugLogger::error("TimerWheel: pool cheio (" + std::to_string(entries_.size()) + " timers)");
+        return 0;
+    }
+    const int idx = free_.back();
+    free_.pop_back();
+    Entry& e = entries_[idx];
+    e.deadline = deadline;
+    e.fn = fn;
+    e.user = user;
+    e.seq = seq_++;
+    // Vencido antes do cursor: o slot dele já passou nesta volta
+    link(idx, reached(deadline, cursor_ - 1) ? OVERDUE : (int)(deadline & SLOT_MASK));
+    active_++;
+    return ((Id)e.gen << 16) | (Id)(idx + 1);
+}
+
+bool TimerWheel::cancel(Id id) {
+    const int idx = take(id);
+    if (idx < 0) return false;
+    unlink(idx);
+    entries_[idx].gen++;
+    free_.push_back(idx);
+    active_--;
+    return true;
+}
+
+bool TimerWheel::isPending(Id id) const { return take(id) >= 0; }
+
+void TimerWheel::collect(int list, Uint32 now) {
+    for (int idx = heads_[list]; idx >= 0;) {
+        const int next = entries_[idx].next;
+        if (reached(entries_[idx].deadline, now)) {
+            unlink(idx);
+            due_.push_back(idx);
+        }
+        idx = next;
+    }
+}
+
+int TimerWheel::advance(Uint32 now) {
+    due_.clear();
+    collect(OVERDUE, now);
+    if (reached(now, cursor_)) {
+        // Só os ms que passaram; mais de uma volta = todos os slots uma vez
+        const Uint32 steps = now - cursor_ + 1;
+        if (steps >= (Uint32)SLOTS) {
+            for (int s = 0; s < SLOTS; ++s) collect(s, now);
+        } else {
+            for (Uint32 t = cursor_; t != now + 1; ++t) collect((int)(t & SLOT_MASK), now);
+        }
+        cursor_ = now + 1;
+    } else if (now != cursor_ - 1) {
+        // Relógio voltou (ManualClock.set no restart headless): os slots são
+        // absolutos, então basta uma varredura e recomeçar o cursor daqui
+        for (int s = 0; s < SLOTS; ++s) collect(s, now);
+        cursor_ = now + 1;
+    }
+    if (due_.empty()) return 0;
+
+    std::sort(due_.begin(), due_.end(), [this](int a, int b) {
+        const Entry& ea = entries_[a];
+        const Entry& eb = entries_[b];
+        if (ea.deadline != eb.deadline) return (Sint32)(ea.deadline - eb.deadline) < 0;
+        return (Sint32)(ea.seq - eb.seq) < 0;
+    });
+    // Copia e libera antes de chamar: um callback pode reagendar e pegar a
+    // entrada de outro que ainda vai disparar
+    calls_.clear();
+    for (int idx : due_) {
+        Entry& e = entries_[idx];
+        calls_.push_back({e.fn, e.user});
+        e.gen++;
+        free_.push_back(idx);
+        active_--;
+    }
+    const int count = (int)calls_.size();
+    for (int i = 0; i < count; ++i) {
+        fired_++;
+        calls_[i].fn(calls_[i].user, now);
+    }
+    return count;
+}
@@ -0,0 +1,252 @@
+#include "app/Tracing.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace Trace {
+namespace {
+
+// Campos atômicos (relaxed): o dump lê o anel enquanto a dona escreve
+struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<Uint64> begin{0};
+    std::atomic<Uint64> end{0};
+};
+
+struct Ring {
+    std::unique_ptr<Event[]> events;
+    uint64_t capacity = 0;
+    std::atomic<uint64_t> head{0};       // Zonas já gravadas (só cresce)
+    std::atomic<uint64_t> base{0};       // Slot reaproveitado: o que veio antes é de outra thread
+    std::atomic<const char*> threadName{nullptr};
+    std::atomic<bool> owned{false};
+    std::atomic<bool> ready{false};      // events alocado
+};
+
+Ring g_rings[MAX_THREADS];
+std::atomic<int> g_ringsUsed{0};
+std::atomic<uint64_t> g_capacity{0};
+std::atomic<int> g_seconds{0};
+std::atomic<Uint64> g_origin{0};
+
+SDL_SpinLock g_internLock = 0;
+std::deque<std::string> g_interned;     // deque: push_back não move as strings antigas
+
+// Dono do anel na thread; o destrutor devolve o slot quando a thread acaba
+struct Owner {
+    Ring* ring = nullptr;
+    const char* name = nullptr;
+    bool full = false;                  // Sem slot livre: não tenta de novo a cada zona
+    ~Owner() { if (ring) ring->owned.store(false, std::memory_order_release); }
+};
+thread_local Owner t_owner;
+
+Ring* acquireRing(const char* name) {
+    const uint64_t capacity = g_capacity.load(std::memory_order_acquire);
+    if (!capacity) return nullptr;
+    // Primeiro um slot de thread que já terminou (anel já alocado)
+    const int used = std::min(g_ringsUsed.load(std::memory_order_acquire), MAX_THREADS);
+    for (int i = 0; i < used; ++i) {
+        Ring& r = g_rings[i];
+        bool expected = false;
+        if (r.ready.load(std::memory_order_acquire) && r.owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            r.threadName.store(name, std::memory_order_relaxed);
+            r.base.store(r.head.load(std::memory_order_relaxed), std::memory_order_release);
+            return &r;
+        }
+    }
+    const int idx = g_ringsUsed.fetch_add(1, std::memory_order_acq_rel);
+    if (idx >= MAX_THREADS) return nullptr;
+    Ring& r = g_rings[idx];
+    r.owned.store(true, std::memory_order_relaxed);
+    r.events.reset(new Event[capacity]);
+    r.capacity = capacity;
+    r.threadName.store(name, std::memory_order_relaxed);
+    r.ready.store(true, std::memory_order_release);
+    return &r;
+}
+
+struct Copied {
+    const char* name;
+    Uint64 begin, end;
+    int tid;
+};
+
+struct DumpJob {
+    std::string path;
+    std::vector<Copied> zones;
+    std::vector<std::pair<int, const char*>> threads;
+    Uint64 origin = 0;
+};
+
+SDL_Thread* g_writer = nullptr;
+std::atomic<bool> g_writing{false};
+
+std::string jsonEscape(const char* s) {
+    std::string out;
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out += '\\';
+        out += (unsigned char)*s < 0x20 ? ' ' : *s;
+    }
+    return out;
+}
+
+// trace.json -> trace_20261014_153000.json
+std::string stampedPath(const std::string& path) {
+    char stamp[32];
+    std::time_t t = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "_%Y%m%d_%H%M%S", std::localtime(&t));
+    const size_t slash = path.find_last_of("/\\");
+    const size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + stamp;
+    return path.substr(0, dot) + stamp + path.substr(dot);
+}
+
+bool writeJob(const DumpJob& job) {
+    std::ofstream out(job.path, std::ios::trunc);
+    if (!out.good()) return false;
+    const double usPerTick = 1e6 / (double)SDL_GetPerformanceFrequency();
+    char buf[512];
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    for (const auto& t : job.threads) {
+        const std::string name = t.second ? jsonEscape(t.second) : "Thread " + std::to_string(t.first);
+        std::snprintf(buf, sizeof(buf), "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                      first ? "" : ",\n", t.first, name.c_str());
+        out << buf;
+        first = false;
+    }
+    for (const Copied& z : job.zones) {
+        std::snprintf(buf, sizeof(buf), "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                      first ? "" : ",\n", jsonEscape(z.name).c_str(), z.tid,
+                      (double)(Sint64)(z.begin - job.origin) * usPerTick, (double)(z.end - z.begin) * usPerTick);
+        out << buf;
+        first = false;
+    }
+    out << "\n]}\n";
+    return out.good();
+}
+
+int SDLCALL writerMain(void* data) {
+    std::unique_ptr<DumpJob> job(static_cast<DumpJob*>(data));
+    if (writeJob(*job)) {
+        DebugLogger::info("Trace: " + std::to_string(job->zones.size()) + " zone(s) from " +
+                          std::to_string(job->threads.size()) + " thread(s) -> " + job->path);
+    } else {
+        DebugLogger::error("Trace: could not write " + job->path);
+    }
+    g_writing.store(false, std::memory_order_release);
+    return 0;
+}
+
+} // namespace
+
+void enable(int seconds) {
+    if (seconds <= 0) {
+        g_enabled.store(false, std::memory_order_relaxed);
+        return;
+    }
+    uint64_t expected = 0;
+    uint64_t capacity = 1024;
+    while (capacity < (uint64_t)seconds * ZONES_PER_SECOND && capacity < (1u << 22)) capacity <<= 1;
+    if (g_capacity.compare_exchange_strong(expected, capacity, std::memory_order_acq_rel)) {
+        g_origin.store(SDL_GetPerformanceCounter(), std::memory_order_relaxed);
+    }
+    g_seconds.store(seconds, std::memory_order_relaxed);
+    g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void record(const char* name, Uint64 begin, Uint64 end) {
+    Owner& o = t_owner;
+    if (!o.ring) {
+        if (o.full) return;
+        o.ring = acquireRing(o.name);
+        if (!o.ring) { o.full = true; return; }
+    }
+    Ring& r = *o.ring;
+    const uint64_t h = r.head.load(std::memory_order_relaxed);
+    Event& e = r.events[h & (r.capacity - 1)];
+    e.name.store(name, std::memory_order_relaxed);
+    e.begin.store(begin, std::memory_order_relaxed);
+    e.end.store(end, std::memory_order_relaxed);
+    r.head.store(h + 1, std::memory_order_release);
+}
+
+void setThreadName(const char* name) {
+    t_owner.name = name;
+    if (t_owner.ring) t_owner.ring->threadName.store(name, std::memory_order_relaxed);
+}
+
+const char* intern(const std::string& name) {
+    SDL_AtomicLock(&g_internLock);
+    const char* out = nullptr;
+    for (const std::string& s : g_interned) if (s == name) { out = s.c_str(); break; }
+    if (!out) { g_interned.push_back(name); out = g_interned.back().c_str(); }
+    SDL_AtomicUnlock(&g_internLock);
+    return out;
+}
+
+bool dump(const std::string& path) {
+    if (!isEnabled()) {
+        DebugLogger::info("Trace: recording is off (TRACE_SECONDS=0)");
+        return false;
+    }
+    if (g_writing.load(std::memory_order_acquire)) {
+        DebugLogger::warning("Trace: previous dump still being written");
+        return false;
+    }
+    if (g_writer) { SDL_WaitThread(g_writer, nullptr); g_writer = nullptr; }
+
+    std::unique_ptr<DumpJob> job(new DumpJob());
+    job->path = stampedPath(path);
+    job->origin = g_origin.load(std::memory_order_relaxed);
+    const Uint64 now = SDL_GetPerformanceCounter();
+    const Uint64 window = (Uint64)g_seconds.load(std::memory_order_relaxed) * SDL_GetPerformanceFrequency();
+    const Uint64 since = now > window ? now - window : 0;
+
+    const int used = std::min(g_ringsUsed.load(std::memory_order_acquire), MAX_THREADS);
+    for (int i = 0; i < used; ++i) {
+        Ring& r = g_rings[i];
+        if (!r.ready.load(std::memory_order_acquire)) continue;
+        const uint64_t head = r.head.load(std::memory_order_acquire);
+        const uint64_t base = r.base.load(std::memory_order_acquire);
+        uint64_t from = std::max(base, head > r.capacity ? head - r.capacity : 0);
+        const size_t start = job->zones.size();
+        for (uint64_t k = from; k < head; ++k) {
+            const Event& e = r.events[k & (r.capacity - 1)];
+            job->zones.push_back({e.name.load(std::memory_order_relaxed), e.begin.load(std::memory_order_relaxed),
+                                  e.end.load(std::memory_order_relaxed), i + 1});
+        }
+        // O que a dona sobrescreveu durante a cópia (e o slot que ela está
+        // escrevendo agora) pode ter saído rasgado: fica de fora
+        const uint64_t after = r.head.load(std::memory_order_acquire);
+        const uint64_t valid = after >= r.capacity ? after - r.capacity + 1 : 0;
+        if (valid > from) {
+            const size_t drop = (size_t)std::min(valid - from, head - from);
+            job->zones.erase(job->zones.begin() + (std::ptrdiff_t)start, job->zones.begin() + (std::ptrdiff_t)(start + drop));
+        }
+        // Só a janela pedida
+        job->zones.erase(std::remove_if(job->zones.begin() + (std::ptrdiff_t)start, job->zones.end(),
+                                        [since](const Copied& z) { return !z.name || z.end < since; }),
+                         job->zones.end());
+        job->threads.push_back({i + 1, r.threadName.load(std::memory_order_relaxed)});
+    }
+
+    g_writing.store(true, std::memory_order_release);
+    DumpJob* raw = job.release();
+    g_writer = SDL_CreateThread(writerMain, "DropBlocksTrace", raw);
+    if (!g_writer) writerMain(raw);   // Sem thread: grava aqui mesmo
+    return true;
+}
+
+void shutdown() {
+    if (g_writer) { SDL_WaitThread(g_writer, nullptr); g_writer = nullptr; }
+}
+
+} // namespace Trace
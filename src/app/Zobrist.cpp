@@ -0,0 +1,66 @@
+#include "app/Zobrist.hpp"
+#include "app/GameBoard.hpp"
+#include "app/GameState.hpp"
+
+namespace {
+
+constexpr int KEY_COUNT = MAX_BOARD_COLS * MAX_BOARD_ROWS;
+
+struct Keys {
+    uint64_t cell[KEY_COUNT] = {};
+    constexpr Keys() {
+        // splitmix64 de uma semente fixa: mudar aqui invalida replays e netplay com builds antigos
+        uint64_t s = 0x44524F50424C4B53ull;   // "DROPBLKS"
+        for (int i = 0; i < KEY_COUNT; ++i) {
+            s += 0x9E3779B97F4A7C15ull;
+            uint64_t z = s;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            cell[i] = z ^ (z >> 31);
+        }
+    }
+};
+
+constexpr Keys KEYS{};
+
+// Sais dos campos do estado: o mesmo valor em campos diferentes não se cancela
+enum : uint64_t {
+    SALT_PIECE = 0x01ull << 56, SALT_NEXT = 0x02ull << 56, SALT_SCORE = 0x03ull << 56,
+    SALT_LINES = 0x04ull << 56, SALT_LEVEL = 0x05ull << 56, SALT_OVER = 0x06ull << 56, SALT_SEED = 0x07ull << 56,
+};
+
+} // namespace
+
+namespace Zobrist {
+
+uint64_t cell(int x, int y) { return KEYS.cell[y * MAX_BOARD_COLS + x]; }
+
+uint64_t row(int y, uint32_t mask) {
+    uint64_t h = 0;
+    const uint64_t* keys = &KEYS.cell[y * MAX_BOARD_COLS];
+    for (; mask; mask &= mask - 1) h ^= keys[__builtin_ctz(mask)];
+    return h;
+}
+
+uint64_t board(const uint32_t* rows, int height) {
+    uint64_t h = 0;
+    for (int y = 0; y < height; ++y) if (rows[y]) h ^= row(y, rows[y]);
+    return h;
+}
+
+uint64_t stateHash(const GameState& state, uint64_t roundSeed) {
+    uint64_t h = state.getBoard().getHash();
+    const Active& a = state.getActivePiece();
+    const uint64_t piece = (uint64_t)(uint8_t)a.idx | (uint64_t)(a.rot & 3) << 8 |
+                           (uint64_t)(uint16_t)a.x << 16 | (uint64_t)(uint16_t)a.y << 32;
+    h ^= mix(SALT_PIECE ^ piece);
+    h ^= mix(SALT_NEXT ^ (uint32_t)state.getNextIdx());
+    h ^= mix(SALT_SCORE ^ (uint32_t)state.getScoreValue());
+    h ^= mix(SALT_LINES ^ (uint32_t)state.getLinesValue());
+    h ^= mix(SALT_LEVEL ^ (uint32_t)state.getLevelValue());
+    h ^= mix(SALT_OVER ^ (state.isGameOver() ? 1u : 0u));
+    h ^= mix(SALT_SEED ^ (roundSeed & 0x00FFFFFFFFFFFFFFull));
+    return h;
+}
+
+} // namespace Zobrist
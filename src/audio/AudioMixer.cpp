@@ -0,0 +1,256 @@
+#include "audio/AudioMixer.hpp"
+#include "audio/MusicStream.hpp"
+#include "DebugLogger.hpp"
+#include "app/Metrics.hpp"
+#include "app/Tracing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+AudioMixer::AudioMixer() {
+    for (auto& g : busGain_) g = 1.0f;
+    for (auto& g : postedBus_) g = -1.0f;
+}
+
+AudioMixer::~AudioMixer() { close(); }
+
+bool AudioMixer::open() {
+    if (device_) return true;
+
+    clock_ = 0;
+    lastCallbackTicks_ = 0;
+    for (auto& used : slotUsed_) used = false;
+    highWater_.store(0, std::memory_order_relaxed);
+    overflows_.store(0, std::memory_order_relaxed);
+
+    SDL_AudioSpec want{};
+    want.freq = 44100; want.format = AUDIO_F32SYS; want.channels = 1;
+    want.samples = 512;  // ~11.6 ms: limite de latência de qualquer som
+    want.callback = &AudioMixer::audioCallback;
+    want.userdata = this;
+
+    // Sem flags de allowed changes: o SDL converte para o formato real do dispositivo
+    device_ = SDL_OpenAudioDevice(nullptr, 0, &want, &spec_, 0);
+    if (!device_) {
+        DebugLogger::error(std::string("SDL_OpenAudioDevice failed: ") + SDL_GetError());
+        return false;
+    }
+    SDL_PauseAudioDevice(device_, 0);
+    return true;
+}
+
+void AudioMixer::close() {
+    if (!device_) return;
+    SDL_CloseAudioDevice(device_);  // Para o callback antes de liberar o estado
+    device_ = 0;
+    music_ = nullptr;
+    while (commands_.front()) commands_.pop();
+    for (auto& v : voices_) v.active = false;
+    activeVoices_.store(0, std::memory_order_relaxed);
+    postedMaster_ = -1.0f;  // Reenviar ganhos no próximo open()
+    for (auto& g : postedBus_) g = -1.0f;
+}
+
+bool AudioMixer::post(const Command& cmd) {
+    if (!device_) return false;
+    // Em THREADED_MODE simulação e render postam; o lock serializa só os
+    // produtores, o callback continua sem lock
+    SDL_AtomicLock(&producerLock_);
+    bool ok = commands_.push(cmd);
+    if (ok) {
+        int queued = (int)commands_.size();
+        if (queued > highWater_.load(std::memory_order_relaxed)) highWater_.store(queued, std::memory_order_relaxed);
+    }
+    SDL_AtomicUnlock(&producerLock_);
+    static const Metrics::Id mQueue = Metrics::gauge("audio_queue");
+    static const Metrics::Id mOverflows = Metrics::counter("audio_overflows");
+    Metrics::set(mQueue, (double)commands_.size());
+    if (!ok) { overflows_.fetch_add(1, std::memory_order_relaxed); Metrics::add(mOverflows); }
+    return ok;
+}
+
+bool AudioMixer::playGroup(const VoiceParams* voices, int count, int throttleSlot, int throttleMs) {
+    if (!voices || count <= 0) return false;
+    Command cmd;
+    cmd.type = Command::Type::PLAY;
+    cmd.voiceCount = (Uint8)std::min(count, MAX_VOICES_PER_COMMAND);
+    cmd.throttleSlot = (Uint8)((throttleSlot > 0 && throttleSlot < MAX_THROTTLE_SLOTS) ? throttleSlot : 0);
+    cmd.throttleMs = (Uint32)std::max(0, throttleMs);
+    for (int i = 0; i < cmd.voiceCount; ++i) {
+        const VoiceParams& p = voices[i];
+        if (p.wave == Wave::SAMPLE && (!p.samples || p.sampleCount <= 0)) return false;
+        cmd.voices[i] = p;
+    }
+    return post(cmd);
+}
+
+bool AudioMixer::stopAll() {
+    Command cmd;
+    cmd.type = Command::Type::STOP_ALL;
+    return post(cmd);
+}
+
+void AudioMixer::flush() {
+    if (!device_) return;
+    // Com o lock do dispositivo o callback não roda: o produtor pode consumir a fila
+    SDL_LockAudioDevice(device_);
+    while (commands_.front()) commands_.pop();
+    for (auto& v : voices_) v.active = false;
+    SDL_UnlockAudioDevice(device_);
+}
+
+void AudioMixer::setMusic(MusicStream* music) {
+    if (!device_) { music_ = nullptr; return; }
+    SDL_LockAudioDevice(device_);
+    music_ = music;
+    SDL_UnlockAudioDevice(device_);
+}
+
+void AudioMixer::setMasterGain(float gain) {
+    if (gain == postedMaster_) return;
+    Command cmd;
+    cmd.type = Command::Type::SET_MASTER_GAIN;
+    cmd.gain = gain;
+    if (post(cmd)) postedMaster_ = gain;
+}
+
+void AudioMixer::setBusGain(Bus bus, float gain) {
+    if (gain == postedBus_[(int)bus]) return;
+    Command cmd;
+    cmd.type = Command::Type::SET_BUS_GAIN;
+    cmd.bus = bus;
+    cmd.gain = gain;
+    if (post(cmd)) postedBus_[(int)bus] = gain;
+}
+
+AudioMixer::Stats AudioMixer::stats() const {
+    Stats st;
+    st.activeVoices = activeVoices_.load(std::memory_order_relaxed);
+    st.queued = (int)commands_.size();
+    st.highWater = highWater_.load(std::memory_order_relaxed);
+    st.overflows = overflows_.load(std::memory_order_relaxed);
+    return st;
+}
+
+void SDLCALL AudioMixer::audioCallback(void* userdata, Uint8* stream, int len) {
+    static_cast<AudioMixer*>(userdata)->mix(reinterpret_cast<float*>(stream), len / (int)sizeof(float));
+}
+
+void AudioMixer::startVoice(const VoiceParams& p) {
+    const int rate = spec_.freq;
+
+    // Voz livre ou, com o pool cheio, a que está mais perto de terminar
+    Voice* slot = nullptr;
+    int bestRemaining = 0;
+    for (auto& v : voices_) {
+        if (!v.active) { slot = &v; break; }
+        int remaining = v.delay + (v.length - v.pos);
+        if (!slot || remaining < bestRemaining) { slot = &v; bestRemaining = remaining; }
+    }
+
+    Voice& v = *slot;
+    v = Voice{};
+    v.active = true;
+    v.wave = p.wave;
+    v.bus = p.bus;
+    v.volume = p.volume;
+    v.delay = std::max(0, p.delayMs) * rate / 1000;
+    v.length = (p.wave == Wave::SAMPLE) ? p.sampleCount : std::max(1, p.durationMs * rate / 1000);
+    v.attack = std::clamp(p.attackMs * rate / 1000, 1, std::max(1, v.length / 2));
+    v.release = std::clamp(p.releaseMs * rate / 1000, 1, std::max(1, v.length / 2));
+    v.samples = p.samples;
+    v.phaseInc = 2.0 * M_PI * p.freq / rate;
+    if (p.freqEnd > 0.0f) {
+        double endInc = 2.0 * M_PI * p.freqEnd / rate;
+        v.phaseIncDelta = (endInc - v.phaseInc) / v.length;
+    }
+}
+
+void AudioMixer::execute(const Command& cmd) {
+    switch (cmd.type) {
+        case Command::Type::PLAY: {
+            if (cmd.throttleSlot) {
+                Uint64 interval = (Uint64)cmd.throttleMs * (Uint64)spec_.freq / 1000;
+                if (slotUsed_[cmd.throttleSlot] && clock_ - slotLastStart_[cmd.throttleSlot] < interval) break;
+                slotUsed_[cmd.throttleSlot] = true;
+                slotLastStart_[cmd.throttleSlot] = clock_;
+            }
+            for (int i = 0; i < cmd.voiceCount; ++i) startVoice(cmd.voices[i]);
+            break;
+        }
+        case Command::Type::STOP_ALL:
+            for (auto& v : voices_) v.active = false;
+            break;
+        case Command::Type::SET_MASTER_GAIN:
+            masterGain_ = cmd.gain;
+            break;
+        case Command::Type::SET_BUS_GAIN:
+            busGain_[(int)cmd.bus] = cmd.gain;
+            break;
+    }
+}
+
+void AudioMixer::mix(float* out, int frames) {
+    Trace::setThreadName("Audio");
+    DB_TRACE_ZONE("Audio mix");
+    std::memset(out, 0, (size_t)frames * sizeof(float));
+    
+    // O SDL não avisa de underrun; um callback atrasado mais de dois buffers é o sinal
+    static const Metrics::Id mUnderruns = Metrics::counter("audio_underruns");
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastCallbackTicks_ && spec_.freq > 0) {
+        double gapMs = (double)(now - lastCallbackTicks_) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+        if (gapMs > 2000.0 * (double)spec_.samples / (double)spec_.freq) Metrics::add(mUnderruns);
+    }
+    lastCallbackTicks_ = now;
+
+    while (const Command* cmd = commands_.front()) {
+        execute(*cmd);
+        commands_.pop();
+    }
+
+    float gains[(int)Bus::COUNT];
+    for (int b = 0; b < (int)Bus::COUNT; ++b) gains[b] = masterGain_ * busGain_[b];
+
+    int active = 0;
+    for (auto& v : voices_) {
+        if (!v.active) continue;
+        ++active;
+
+        const float amp = v.volume * gains[(int)v.bus];
+        int i = 0;
+        if (v.delay > 0) {
+            int skip = std::min(v.delay, frames);
+            v.delay -= skip;
+            i = skip;
+        }
+        for (; i < frames && v.pos < v.length; ++i, ++v.pos) {
+            float s;
+            switch (v.wave) {
+                case Wave::SQUARE: s = (v.phase < M_PI) ? 1.0f : -1.0f; break;
+                case Wave::SAMPLE: s = v.samples[v.pos]; break;
+                default:           s = (float)std::sin(v.phase); break;
+            }
+            v.phase += v.phaseInc;
+            v.phaseInc += v.phaseIncDelta;
+            if (v.phase >= 2.0 * M_PI) v.phase -= 2.0 * M_PI;
+
+            float env = 1.0f;
+            if (v.pos < v.attack) env = (float)v.pos / v.attack;
+            else if (v.length - v.pos < v.release) env = (float)(v.length - v.pos) / v.release;
+
+            out[i] += s * env * amp;
+        }
+        if (v.pos >= v.length) v.active = false;
+    }
+    activeVoices_.store(active, std::memory_order_relaxed);
+    clock_ += (Uint64)frames;
+
+    if (music_) music_->mix(out, frames, gains[(int)Bus::MUSIC]);
+
+    for (int i = 0; i < frames; ++i) out[i] = std::clamp(out[i], -1.0f, 1.0f);
+}
@@ -1,64 +1,200 @@
 #include "audio/AudioSystem.hpp"
 
-#include <vector>
-#include <cmath>
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+#include "audio/AudioMixer.hpp"
+#include "audio/MusicStream.hpp"
+#include "audio/SfxBank.hpp"
+#include "app/Tracing.hpp"
+#include "DebugLogger.hpp"
+
+#include <atomic>
 
 struct AudioSystem::Impl {
-    struct AudioDevice {
-        SDL_AudioDeviceID device = 0;
-        SDL_AudioSpec spec{};
-        bool initialize() {
-            spec.freq = 44100; spec.format = AUDIO_F32SYS; spec.channels = 1; spec.samples = 1024;
-            device = SDL_OpenAudioDevice(nullptr, 0, &spec, &spec, 0);
-            if (device) SDL_PauseAudioDevice(device, 0);
-            return device != 0;
-        }
-        void cleanup() { if (device) SDL_CloseAudioDevice(device); device = 0; }
-        void playBeep(double freq, int ms, float vol, bool square) {
-            if (!device) return; int N = (int)(spec.freq * (ms / 1000.0)); std::vector<float> buf(N);
-            double ph = 0, st = 2.0 * M_PI * freq / spec.freq; for (int i=0;i<N;i++){ float s = square ? (std::sin(ph)>=0?1.f:-1.f) : (float)std::sin(ph); buf[i]=s*vol; ph+=st; if (ph>2*M_PI) ph-=2*M_PI; }
-            SDL_QueueAudio(device, buf.data(), (Uint32)(buf.size()*sizeof(float)));
-        }
-        void playChord(double baseFreq, int notes[], int count, int ms, float vol) {
-            if (!device) return; for (int i=0;i<count;i++) playBeep(baseFreq*notes[i], ms, vol, false);
+    using Bus = AudioMixer::Bus;
+    using Sfx = SfxBank::Sfx;
+
+    AudioMixer mixer;
+    SfxBank bank;
+    MusicStream music;
+    int musicLevel = -1;
+    std::string musicPath;   // Faixa pedida ao stream (vazio = silêncio)
+    bool bankDirty = true;
+    AudioConfig config;
+    
+    // startAsync(): a thread abre o dispositivo e monta o banco; os play* só
+    // passam de ready, então o jogo roda mudo até lá sem tocar no mixer
+    std::atomic<bool> ready{false};
+    std::atomic<bool> starting{false};
+    SDL_Thread* opener = nullptr;
+    double startMs = 0.0;
+
+    // Slots de throttle dos sons ambientes (intervalo decidido no callback)
+    enum AmbientSlot { MELODY_SLOT = 1, TENSION_SLOT, SWEEP_SLOT, SCANLINE_SLOT };
+
+    // Ganhos por barramento lidos da config a cada pedido (comando só quando mudam)
+    void syncGains() {
+        mixer.setMasterGain(config.masterVolume);
+        mixer.setBusGain(Bus::SFX, config.sfxVolume);
+        mixer.setBusGain(Bus::AMBIENT, config.ambientVolume);
+        mixer.setBusGain(Bus::MUSIC, config.musicVolume);
+    }
+
+    // Thread do jogo: pede ao stream a faixa do nível atual se ela mudou (a
+    // thread de música abre e decodifica; aqui é só uma comparação)
+    void syncMusic() {
+        if (!ready.load(std::memory_order_acquire)) return;   // Nível fica guardado até o dispositivo abrir
+        const std::string& path = config.musicFor(musicLevel);
+        if (path == musicPath) return;
+        if (!music.isRunning()) {
+            if (path.empty() || !music.start(mixer.sampleRate())) return;
+            mixer.setMusic(&music);
         }
-        void playArpeggio(double baseFreq, int notes[], int count, int noteMs, float vol) {
-            if (!device) return; for (int i=0;i<count;i++) playBeep(baseFreq*notes[i], noteMs, vol, false);
+        syncGains();
+        music.request(path, config.musicCrossfadeMs);
+        musicPath = path;
+    }
+
+    static AudioMixer::VoiceParams toneParams(double freq, int ms, float vol, bool square, Bus bus, int delayMs = 0) {
+        AudioMixer::VoiceParams p;
+        p.wave = square ? AudioMixer::Wave::SQUARE : AudioMixer::Wave::SINE;
+        p.bus = bus;
+        p.freq = (float)freq;
+        p.volume = vol;
+        p.durationMs = ms;
+        p.delayMs = delayMs;
+        return p;
+    }
+
+    void tone(double freq, int ms, float vol, bool square, Bus bus = Bus::MAIN, int delayMs = 0) {
+        if (!ready.load(std::memory_order_acquire)) return;
+        syncGains();
+        mixer.play(toneParams(freq, ms, vol, square, bus, delayMs));
+    }
+
+    void ambient(AmbientSlot slot, int intervalMs, const AudioMixer::VoiceParams* voices, int count) {
+        if (!ready.load(std::memory_order_acquire)) return;
+        syncGains();
+        mixer.playGroup(voices, count, slot, intervalMs);
+    }
+
+    // Banco construído na abertura do dispositivo e refeito quando SFX_FILE_* muda
+    bool ensureBank() {
+        if (!mixer.isOpen()) return false;
+        if (bankDirty || !bank.isBuilt()) {
+            DB_TRACE_ZONE("SFX bank build");
+            mixer.flush();  // Nenhuma voz pode apontar para os buffers antigos
+            bank.build(mixer.sampleRate(), config);
+            bankDirty = false;
         }
-        void playSweep(double startFreq, double endFreq, int ms, float vol) {
-            if (!device) return; int steps=20; for(int i=0;i<=steps;i++){ double f=startFreq+(endFreq-startFreq)*(i/(double)steps); playBeep(f, ms/steps, vol, false);} }
-    };
+        return true;
+    }
 
-    AudioDevice device;
-    AudioConfig config;
-    Uint32 lastSweepSound = 0, lastScanlineSound = 0, lastMelody = 0, lastTension = 0;
+    void playSfx(Sfx sfx) {
+        if (!ready.load(std::memory_order_acquire) || !ensureBank()) return;
+        syncGains();
+        const SfxBank::Clip& clip = bank.get(sfx);
+        AudioMixer::VoiceParams p;
+        p.wave = AudioMixer::Wave::SAMPLE;
+        p.bus = clip.bus;
+        p.volume = 1.0f;
+        p.attackMs = 0;   // Envelope já está no PCM
+        p.releaseMs = 0;
+        p.samples = clip.pcm.data();
+        p.sampleCount = (int)clip.pcm.size();
+        mixer.play(p);
+    }
 };
 
 AudioSystem::AudioSystem() : impl_(new Impl()) {}
 
-bool AudioSystem::initialize() { return impl_->device.initialize(); }
-void AudioSystem::cleanup() { impl_->device.cleanup(); }
-
-// Synthesis
-void AudioSystem::playBeep(double freq, int ms, float vol, bool square) { impl_->device.playBeep(freq, ms, vol * getConfig().masterVolume, square); }
-void AudioSystem::playChord(double baseFreq, int notes[], int count, int ms, float vol) { impl_->device.playChord(baseFreq, notes, count, ms, vol * getConfig().masterVolume * getConfig().sfxVolume); }
-void AudioSystem::playRotationSound(bool clockwise) { if (getConfig().enableMovementSounds) impl_->device.playBeep(clockwise?350.0:300.0, 15, 0.10f*getConfig().masterVolume, false); }
-void AudioSystem::playMovementSound() { if (getConfig().enableMovementSounds) impl_->device.playBeep(150.0, 8, 0.06f*getConfig().masterVolume, true); }
-void AudioSystem::playSoftDropSound() { if (getConfig().enableMovementSounds) impl_->device.playBeep(200.0, 12, 0.08f*getConfig().masterVolume, true); }
-void AudioSystem::playHardDropSound() { if (getConfig().enableMovementSounds) impl_->device.playBeep(400.0, 20, 0.12f*getConfig().masterVolume, true); }
-void AudioSystem::playKickSound() { if (getConfig().enableMovementSounds) impl_->device.playBeep(250.0, 15, 0.08f*getConfig().masterVolume, true); }
-void AudioSystem::playLevelUpSound() { if (getConfig().enableLevelUpSounds) { float v=0.25f*getConfig().masterVolume; impl_->device.playBeep(880.0,100,v,false); impl_->device.playBeep(1320.0,80,v*0.8f,false);} }
-void AudioSystem::playGameOverSound() { if (getConfig().enableLevelUpSounds){ float v=0.3f*getConfig().masterVolume; impl_->device.playBeep(440.0,200,v,false); impl_->device.playBeep(392.0,200,v,false); impl_->device.playBeep(349.0,200,v,false); impl_->device.playBeep(294.0,300,v*1.33f,false);} }
-void AudioSystem::playComboSound(int combo) { if (getConfig().enableComboSounds && combo>1){ double f=440.0+(combo*50.0); float v=(0.15f+combo*0.02f)*getConfig().masterVolume*getConfig().sfxVolume; impl_->device.playBeep(f, 100+combo*20, v, true);} }
-void AudioSystem::playTetrisSound() { if (getConfig().enableComboSounds){ int notes[]={1,5,8,12}; float v=0.20f*getConfig().masterVolume*getConfig().sfxVolume; impl_->device.playArpeggio(220.0, notes, 4, 50, v);} }
-void AudioSystem::playBackgroundMelody(int level) { if (!getConfig().enableAmbientSounds) return; Uint32 now=SDL_GetTicks(); if (now-impl_->lastMelody>3000){ double base=220.0+(level*20.0); double melody[]={1.0,1.25,1.5,1.875,2.0}; for(int i=0;i<3;i++){ double f=base*melody[i%5]; float v=0.05f*getConfig().ambientVolume*getConfig().masterVolume; impl_->device.playBeep(f,200,v,false);} impl_->lastMelody=now; } }
-void AudioSystem::playTensionSound(int filledRows) { if (!getConfig().enableAmbientSounds || filledRows<6) return; Uint32 now=SDL_GetTicks(); if (now-impl_->lastTension>1000){ float v=0.08f*getConfig().ambientVolume*getConfig().masterVolume; impl_->device.playBeep(80.0,300,v,true); impl_->lastTension=now; } }
-void AudioSystem::playSweepEffect() { if (!getConfig().enableAmbientSounds) return; Uint32 now=SDL_GetTicks(); if (now-impl_->lastSweepSound>2000){ float v=0.03f*getConfig().ambientVolume*getConfig().masterVolume; impl_->device.playBeep(50.0,100,v,false); impl_->lastSweepSound=now; } }
-void AudioSystem::playScanlineEffect() { if (!getConfig().enableAmbientSounds) return; Uint32 now=SDL_GetTicks(); if (now-impl_->lastScanlineSound>5000){ float v=0.02f*getConfig().ambientVolume*getConfig().masterVolume; impl_->device.playBeep(15.0,200,v,true); impl_->lastScanlineSound=now; } }
-bool AudioSystem::loadFromConfig(const std::string& key, const std::string& value) { return getConfig().loadFromConfig(key, value); }
+bool AudioSystem::initialize() { return openDevice() && prepareBank(); }
+bool AudioSystem::openDevice() { return impl_->mixer.isOpen() || impl_->mixer.open(); }
+bool AudioSystem::prepareBank() {
+    if (!impl_->ensureBank()) return false;
+    impl_->ready.store(true, std::memory_order_release);
+    return true;
+}
+void AudioSystem::cleanup() {
+    waitAsync();
+    impl_->ready.store(false, std::memory_order_release);
+    impl_->mixer.setMusic(nullptr);
+    impl_->music.stop();
+    impl_->musicPath.clear();
+    impl_->mixer.close();
+    impl_->bank.clear();
+}
+
+int SDLCALL AudioSystem::asyncMain(void* self) {
+    AudioSystem* audio = static_cast<AudioSystem*>(self);
+    Uint64 t = SDL_GetPerformanceCounter();
+    if (!audio->initialize()) DebugLogger::warning("Audio initialization failed, continuing without sound");
+    audio->impl_->startMs = (double)(SDL_GetPerformanceCounter() - t) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    audio->impl_->starting.store(false, std::memory_order_release);
+    return 0;
+}
+
+bool AudioSystem::startAsync() {
+    if (impl_->opener || isReady()) return true;
+    impl_->starting.store(true, std::memory_order_release);
+    impl_->opener = SDL_CreateThread(&AudioSystem::asyncMain, "dropblocks-audio", this);
+    if (impl_->opener) return true;
+    DebugLogger::warning(std::string("Audio thread unavailable, opening inline: ") + SDL_GetError());
+    asyncMain(this);
+    return isReady();
+}
+
+bool AudioSystem::isReady() const { return impl_->ready.load(std::memory_order_acquire); }
+bool AudioSystem::isStarting() const { return impl_->starting.load(std::memory_order_acquire); }
+double AudioSystem::lastStartMs() const { return impl_->startMs; }
+
+void AudioSystem::waitAsync() {
+    if (!impl_->opener) return;
+    SDL_WaitThread(impl_->opener, nullptr);
+    impl_->opener = nullptr;
+}
+
+// Synthesis (vozes do mixer; master/sfx/ambient são ganhos de barramento)
+using Bus = AudioMixer::Bus;
+using Sfx = SfxBank::Sfx;
+void AudioSystem::playBeep(double freq, int ms, float vol, bool square) { impl_->tone(freq, ms, vol, square); }
+void AudioSystem::playChord(double baseFreq, int notes[], int count, int ms, float vol) { for (int i=0;i<count;i++) impl_->tone(baseFreq*notes[i], ms, vol, false, Bus::SFX); }
+void AudioSystem::playRotationSound(bool clockwise) { if (getConfig().enableMovementSounds) impl_->playSfx(clockwise ? Sfx::ROTATE_CW : Sfx::ROTATE_CCW); }
+void AudioSystem::playMovementSound() { if (getConfig().enableMovementSounds) impl_->playSfx(Sfx::MOVE); }
+void AudioSystem::playSoftDropSound() { if (getConfig().enableMovementSounds) impl_->playSfx(Sfx::SOFT_DROP); }
+void AudioSystem::playHardDropSound() { if (getConfig().enableMovementSounds) impl_->playSfx(Sfx::HARD_DROP); }
+void AudioSystem::playKickSound() { if (getConfig().enableMovementSounds) impl_->playSfx(Sfx::KICK); }
+void AudioSystem::playLevelUpSound() { if (getConfig().enableLevelUpSounds) impl_->playSfx(Sfx::LEVEL_UP); }
+void AudioSystem::playGameOverSound() { if (getConfig().enableLevelUpSounds) impl_->playSfx(Sfx::GAME_OVER); }
+void AudioSystem::playComboSound(int combo) { if (getConfig().enableComboSounds && combo>1){ double f=440.0+(combo*50.0); float v=0.15f+combo*0.02f; impl_->tone(f, 100+combo*20, v, true, Bus::SFX);} }
+void AudioSystem::playTetrisSound() { if (getConfig().enableComboSounds) impl_->playSfx(Sfx::TETRIS); }
+void AudioSystem::setMusicLevel(int level) { impl_->musicLevel = level; impl_->syncMusic(); }
+// Com MUSIC_FILE_* configurado a faixa substitui a melodia sintetizada
+void AudioSystem::playBackgroundMelody(int level) { impl_->syncMusic(); if (!impl_->musicPath.empty() || !getConfig().enableAmbientSounds) return; double base=220.0+(level*20.0); double melody[]={1.0,1.25,1.5}; AudioMixer::VoiceParams v[3]; for(int i=0;i<3;i++) v[i]=Impl::toneParams(base*melody[i],200,0.05f,false,Bus::AMBIENT,i*200); impl_->ambient(Impl::MELODY_SLOT, 3000, v, 3); }
+void AudioSystem::playTensionSound(int filledRows) { if (!getConfig().enableAmbientSounds || filledRows<6) return; auto v=Impl::toneParams(80.0,300,0.08f,true,Bus::AMBIENT); impl_->ambient(Impl::TENSION_SLOT, 1000, &v, 1); }
+void AudioSystem::playSweepEffect() { if (!getConfig().enableAmbientSounds) return; auto v=Impl::toneParams(50.0,100,0.03f,false,Bus::AMBIENT); impl_->ambient(Impl::SWEEP_SLOT, 2000, &v, 1); }
+void AudioSystem::playScanlineEffect() { if (!getConfig().enableAmbientSounds) return; auto v=Impl::toneParams(15.0,200,0.02f,true,Bus::AMBIENT); impl_->ambient(Impl::SCANLINE_SLOT, 5000, &v, 1); }
+bool AudioSystem::loadFromConfig(const std::string& key, const std::string& value) {
+    waitAsync();  // A thread de abertura lê a config
+    if (getConfig().loadSfxFile(key, value)) { impl_->bankDirty = true; return true; }
+    return getConfig().loadFromConfig(key, value);
+}
+
+void AudioSystem::setConfig(const AudioConfig& config) {
+    waitAsync();
+    if (config.sfxFiles != impl_->config.sfxFiles) impl_->bankDirty = true;
+    impl_->config = config;
+}
+
+AudioQueueStats AudioSystem::getQueueStats() const {
+    if (!isReady()) return AudioQueueStats();
+    AudioMixer::Stats st = impl_->mixer.stats();
+    AudioQueueStats out;
+    out.activeVoices = st.activeVoices;
+    out.queued = st.queued;
+    out.capacity = AudioMixer::MAX_COMMANDS;
+    out.highWater = st.highWater;
+    out.overflows = st.overflows;
+    return out;
+}
 
 AudioConfig& AudioSystem::getConfig() { return impl_->config; }
 const AudioConfig& AudioSystem::getConfig() const { return impl_->config; }
@@ -0,0 +1,464 @@
+#include "audio/MusicStream.hpp"
+#include "DebugLogger.hpp"
+#include "app/Metrics.hpp"
+#include "app/Tracing.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+#ifdef DROPBLOCKS_STB_VORBIS
+#include "stb_vorbis.c"
+#endif
+
+// ============================================================================
+// Decoders: quadros intercalados do arquivo -> mono float na taxa de saída
+// ============================================================================
+
+class MusicDecoder {
+public:
+    virtual ~MusicDecoder() = default;
+
+    /// nullptr (com warning no log) se o arquivo não abre ou o formato não é suportado
+    static std::unique_ptr<MusicDecoder> open(const std::string& path, int outRate);
+
+    /// Até maxFrames amostras mono na taxa de saída; 0 = fim do arquivo
+    int read(float* out, int maxFrames) {
+        int produced = 0;
+        while (produced < maxFrames) {
+            const size_t i = (size_t)pos_;
+            if (i + 1 >= mono_.size()) {
+                if (eof_ || !refill()) break;
+                continue;
+            }
+            // Interpolação linear entre as amostras vizinhas da origem
+            const float f = (float)(pos_ - (double)i);
+            out[produced++] = mono_[i] + (mono_[i + 1] - mono_[i]) * f;
+            pos_ += step_;
+        }
+        return produced;
+    }
+
+    /// Volta ao começo (loop); o resto do buffer emenda sem clique
+    bool rewind() {
+        if (!seekStart()) return false;
+        eof_ = false;
+        return true;
+    }
+
+protected:
+    /// Até maxFrames quadros intercalados (channels_ floats cada) em [-1, 1]; 0 = fim
+    virtual int readSource(float* interleaved, int maxFrames) = 0;
+    virtual bool seekStart() = 0;
+
+    void setFormat(int channels, int rate, int outRate) {
+        channels_ = std::max(1, channels);
+        step_ = (double)rate / (double)std::max(1, outRate);
+        interleaved_.resize((size_t)MusicStream::DECODE_FRAMES * channels_);
+        mono_.reserve((size_t)MusicStream::DECODE_FRAMES + 2);
+    }
+
+    int channels_ = 1;
+
+private:
+    bool refill() {
+        // Descarta o que o resampler já passou e acrescenta um bloco da origem
+        const size_t used = std::min((size_t)pos_, mono_.size());
+        mono_.erase(mono_.begin(), mono_.begin() + (ptrdiff_t)used);
+        pos_ -= (double)used;
+        const int frames = readSource(interleaved_.data(), MusicStream::DECODE_FRAMES);
+        if (frames <= 0) { eof_ = true; return false; }
+        const float scale = 1.0f / (float)channels_;
+        for (int f = 0; f < frames; ++f) {
+            float sum = 0.0f;
+            for (int c = 0; c < channels_; ++c) sum += interleaved_[(size_t)f * channels_ + c];
+            mono_.push_back(sum * scale);
+        }
+        return true;
+    }
+
+    double step_ = 1.0, pos_ = 0.0;
+    bool eof_ = false;
+    std::vector<float> interleaved_;
+    std::vector<float> mono_;
+};
+
+namespace {
+
+uint32_t le32(const unsigned char* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+uint16_t le16(const unsigned char* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+/// RIFF/WAVE lido em blocos direto do arquivo
+class WavDecoder : public MusicDecoder {
+public:
+    bool open(const std::string& path, int outRate) {
+        file_.open(path.c_str(), std::ios::binary);
+        if (!file_) return fail(path, "cannot open");
+        unsigned char hdr[12];
+        if (!file_.read((char*)hdr, 12) || std::memcmp(hdr, "RIFF", 4) || std::memcmp(hdr + 8, "WAVE", 4)) return fail(path, "not a RIFF/WAVE file");
+
+        bool haveFmt = false;
+        unsigned char chunk[8];
+        while (file_.read((char*)chunk, 8)) {
+            const uint32_t size = le32(chunk + 4);
+            if (!std::memcmp(chunk, "fmt ", 4)) {
+                unsigned char fmt[40] = {};
+                const uint32_t n = std::min<uint32_t>(size, sizeof(fmt));
+                if (size < 16 || !file_.read((char*)fmt, n)) return fail(path, "bad fmt chunk");
+                uint16_t tag = le16(fmt);
+                if (tag == 0xFFFE && size >= 26) tag = le16(fmt + 24);   // WAVE_FORMAT_EXTENSIBLE: subformato
+                channels_ = le16(fmt + 2);
+                rate_ = (int)le32(fmt + 4);
+                blockAlign_ = le16(fmt + 12);
+                bits_ = le16(fmt + 14);
+                isFloat_ = tag == 3;
+                if ((tag != 1 && tag != 3) || (isFloat_ && bits_ != 32) || (bits_ != 8 && bits_ != 16 && bits_ != 24 && bits_ != 32))
+                    return fail(path, "unsupported sample format (tag " + std::to_string(tag) + ", " + std::to_string(bits_) + " bits)");
+                if (channels_ <= 0 || rate_ <= 0 || blockAlign_ != channels_ * bits_ / 8) return fail(path, "bad fmt chunk");
+                file_.seekg((std::streamoff)(size + (size & 1) - n), std::ios::cur);
+                haveFmt = true;
+            } else if (!std::memcmp(chunk, "data", 4)) {
+                if (!haveFmt) return fail(path, "data before fmt");
+                dataStart_ = file_.tellg();
+                dataBytes_ = size;
+                break;
+            } else {
+                file_.seekg((std::streamoff)(size + (size & 1)), std::ios::cur);
+            }
+        }
+        if (dataStart_ < 0 || dataBytes_ < (uint32_t)blockAlign_) return fail(path, "no audio data");
+        remaining_ = dataBytes_;
+        raw_.resize((size_t)MusicStream::DECODE_FRAMES * blockAlign_);
+        setFormat(channels_, rate_, outRate);
+        return true;
+    }
+
+protected:
+    int readSource(float* out, int maxFrames) override {
+        const uint32_t want = std::min<uint32_t>(remaining_, (uint32_t)maxFrames * blockAlign_);
+        const int frames = (int)(want / blockAlign_);
+        if (frames <= 0 || !file_.read((char*)raw_.data(), (std::streamsize)frames * blockAlign_)) return 0;
+        remaining_ -= (uint32_t)frames * blockAlign_;
+
+        const int samples = frames * channels_;
+        const unsigned char* p = raw_.data();
+        switch (bits_) {
+            case 8:  for (int i = 0; i < samples; ++i) out[i] = ((int)p[i] - 128) * (1.0f / 128.0f); break;
+            case 16: for (int i = 0; i < samples; ++i) out[i] = (int16_t)le16(p + 2 * i) * (1.0f / 32768.0f); break;
+            case 24:
+                for (int i = 0; i < samples; ++i) {
+                    const unsigned char* s = p + 3 * i;
+                    const int32_t v = (int32_t)(((uint32_t)s[0] << 8) | ((uint32_t)s[1] << 16) | ((uint32_t)s[2] << 24)) >> 8;
+                    out[i] = (float)v * (1.0f / 8388608.0f);
+                }
+                break;
+            default:
+                for (int i = 0; i < samples; ++i) {
+                    const uint32_t u = le32(p + 4 * i);
+                    if (isFloat_) { float f; std::memcpy(&f, &u, 4); out[i] = f; }
+                    else out[i] = (float)(int32_t)u * (1.0f / 2147483648.0f);
+                }
+                break;
+        }
+        return frames;
+    }
+
+    bool seekStart() override {
+        file_.clear();
+        file_.seekg(dataStart_);
+        remaining_ = dataBytes_;
+        return (bool)file_;
+    }
+
+private:
+    bool fail(const std::string& path, const std::string& why) {
+        DebugLogger::warning("Music: " + path + ": " + why);
+        return false;
+    }
+
+    std::ifstream file_;
+    std::vector<unsigned char> raw_;
+    std::streamoff dataStart_ = -1;
+    uint32_t dataBytes_ = 0, remaining_ = 0;
+    int rate_ = 0, blockAlign_ = 0, bits_ = 0;
+    bool isFloat_ = false;
+};
+
+#ifdef DROPBLOCKS_STB_VORBIS
+/// OGG Vorbis pela API pull do stb_vorbis (só o bloco de decode fica em memória)
+class VorbisDecoder : public MusicDecoder {
+public:
+    ~VorbisDecoder() override { if (vorbis_) stb_vorbis_close(vorbis_); }
+
+    bool open(const std::string& path, int outRate) {
+        int error = 0;
+        vorbis_ = stb_vorbis_open_filename(path.c_str(), &error, nullptr);
+        if (!vorbis_) {
+            DebugLogger::warning("Music: " + path + ": cannot open OGG (stb_vorbis error " + std::to_string(error) + ")");
+            return false;
+        }
+        const stb_vorbis_info info = stb_vorbis_get_info(vorbis_);
+        setFormat(info.channels, (int)info.sample_rate, outRate);
+        return true;
+    }
+
+protected:
+    int readSource(float* out, int maxFrames) override {
+        return stb_vorbis_get_samples_float_interleaved(vorbis_, channels_, out, maxFrames * channels_);
+    }
+    bool seekStart() override { return stb_vorbis_seek_start(vorbis_) != 0; }
+
+private:
+    stb_vorbis* vorbis_ = nullptr;
+};
+#endif
+
+std::string lowerExtension(const std::string& path) {
+    const size_t dot = path.find_last_of('.');
+    std::string ext = dot == std::string::npos ? std::string() : path.substr(dot);
+    for (char& c : ext) c = (char)std::tolower((unsigned char)c);
+    return ext;
+}
+
+} // namespace
+
+std::unique_ptr<MusicDecoder> MusicDecoder::open(const std::string& path, int outRate) {
+    const std::string ext = lowerExtension(path);
+    if (ext == ".ogg" || ext == ".oga") {
+#ifdef DROPBLOCKS_STB_VORBIS
+        std::unique_ptr<VorbisDecoder> dec(new VorbisDecoder());
+        if (dec->open(path, outRate)) return dec;
+#else
+        DebugLogger::warning("Music: " + path + ": OGG support not compiled in (build with DROPBLOCKS_STB_VORBIS)");
+#endif
+        return nullptr;
+    }
+    if (ext == ".opus") {
+        DebugLogger::warning("Music: " + path + ": Opus is not supported, use OGG Vorbis or WAV");
+        return nullptr;
+    }
+    std::unique_ptr<WavDecoder> dec(new WavDecoder());
+    if (dec->open(path, outRate)) return dec;
+    return nullptr;
+}
+
+// ============================================================================
+// MusicStream
+// ============================================================================
+
+MusicStream::MusicStream() = default;
+
+MusicStream::~MusicStream() { stop(); }
+
+bool MusicStream::start(int sampleRate) {
+    if (thread_) return true;
+    if (sampleRate <= 0) return false;
+    rate_ = sampleRate;
+    quit_ = false;
+    pendingPath_.clear();
+    pendingSeq_ = takenSeq_ = 0;
+    decodeBuf_.assign(DECODE_FRAMES, 0.0f);
+    for (Deck& d : decks_) { d.ring.reset(); d.decoder.reset(); d.state.store(IDLE, std::memory_order_relaxed); }
+    live_.store(-1, std::memory_order_relaxed);
+    switchSeq_.store(0, std::memory_order_relaxed);
+    seenSwitch_ = 0;
+    cur_ = old_ = -1;
+    fadePos_ = fadeLen_ = 0;
+    fading_.store(false, std::memory_order_relaxed);
+
+    mutex_ = SDL_CreateMutex();
+    wake_ = SDL_CreateCond();
+    if (mutex_ && wake_) thread_ = SDL_CreateThread(&MusicStream::threadMain, "dropblocks-music", this);
+    if (!thread_) {
+        DebugLogger::warning(std::string("Music thread unavailable, music disabled: ") + SDL_GetError());
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void MusicStream::stop() {
+    if (thread_) {
+        SDL_LockMutex(mutex_);
+        quit_ = true;
+        SDL_CondSignal(wake_);
+        SDL_UnlockMutex(mutex_);
+        SDL_WaitThread(thread_, nullptr);
+        thread_ = nullptr;
+    }
+    if (wake_) { SDL_DestroyCond(wake_); wake_ = nullptr; }
+    if (mutex_) { SDL_DestroyMutex(mutex_); mutex_ = nullptr; }
+    for (Deck& d : decks_) {
+        d.decoder.reset();
+        d.streaming.store(false, std::memory_order_relaxed);
+        d.ring.reset();
+        d.state.store(IDLE, std::memory_order_relaxed);
+    }
+    live_.store(-1, std::memory_order_relaxed);
+}
+
+void MusicStream::request(const std::string& path, int crossfadeMs) {
+    if (!thread_) return;
+    SDL_LockMutex(mutex_);
+    pendingPath_ = path;
+    pendingFadeMs_ = std::max(0, crossfadeMs);
+    pendingSeq_++;
+    SDL_CondSignal(wake_);
+    SDL_UnlockMutex(mutex_);
+}
+
+int SDLCALL MusicStream::threadMain(void* self) {
+    static_cast<MusicStream*>(self)->run();
+    return 0;
+}
+
+void MusicStream::run() {
+    Trace::setThreadName("Music");
+    std::string path;
+    int fadeMs = 0;
+    SDL_LockMutex(mutex_);
+    while (!quit_) {
+        const uint32_t seq = pendingSeq_;
+        if (seq != takenSeq_) { path = pendingPath_; fadeMs = pendingFadeMs_; }
+        SDL_UnlockMutex(mutex_);
+
+        // Deck que o callback soltou no fim do fade-out: fecha o arquivo e volta a IDLE
+        for (Deck& d : decks_) {
+            if (d.state.load(std::memory_order_acquire) != RELEASED) continue;
+            d.decoder.reset();
+            d.streaming.store(false, std::memory_order_relaxed);
+            d.ring.reset();
+            d.state.store(IDLE, std::memory_order_release);
+        }
+        if (seq != takenSeq_ && startTrack(path, fadeMs)) takenSeq_ = seq;
+        for (Deck& d : decks_) {
+            if (d.state.load(std::memory_order_acquire) != PLAYING || !d.decoder) continue;
+            DB_TRACE_ZONE("Music decode");
+            fill(d);
+        }
+
+        // Dorme até o próximo pedido ou o próximo refill (também quando o deck
+        // para a faixa nova ainda está no fade-out)
+        SDL_LockMutex(mutex_);
+        if (!quit_ && pendingSeq_ == seq) SDL_CondWaitTimeout(wake_, mutex_, FILL_INTERVAL_MS);
+    }
+    SDL_UnlockMutex(mutex_);
+}
+
+bool MusicStream::startTrack(const std::string& path, int crossfadeMs) {
+    const int live = live_.load(std::memory_order_relaxed);
+    if (path.empty()) {
+        if (live >= 0) publish(-1, crossfadeMs);
+        return true;
+    }
+    // O deck livre é o que não está tocando; se ele ainda sai num fade, espera
+    int target = -1;
+    for (int d = 0; d < 2 && target < 0; ++d)
+        if (d != live && decks_[d].state.load(std::memory_order_acquire) == IDLE) target = d;
+    if (target < 0) return false;
+
+    std::unique_ptr<MusicDecoder> decoder = MusicDecoder::open(path, rate_);
+    if (!decoder) return true;   // Mantém a faixa atual
+    Deck& deck = decks_[target];
+    deck.decoder = std::move(decoder);
+    deck.streaming.store(true, std::memory_order_relaxed);
+    fill(deck);                  // Ring cheio antes de o callback enxergar o deck
+    deck.switchSeq.store(0, std::memory_order_relaxed);   // PLAYING mas ainda fora de qualquer troca
+    deck.state.store(PLAYING, std::memory_order_release);
+    publish(target, crossfadeMs);
+    DebugLogger::info("Music: " + path);
+    return true;
+}
+
+void MusicStream::fill(Deck& deck) {
+    bool rewound = false;
+    while (deck.ring.writable() >= (size_t)DECODE_FRAMES) {
+        const int n = deck.decoder->read(decodeBuf_.data(), DECODE_FRAMES);
+        if (n > 0) { deck.ring.write(decodeBuf_.data(), (size_t)n); rewound = false; continue; }
+        // Fim do arquivo: loop (um arquivo sem nenhuma amostra para aqui)
+        if (rewound || !deck.decoder->rewind()) {
+            deck.streaming.store(false, std::memory_order_relaxed);
+            deck.decoder.reset();
+            break;
+        }
+        rewound = true;
+    }
+}
+
+void MusicStream::publish(int deck, int crossfadeMs) {
+    uint32_t seq = switchSeq_.load(std::memory_order_relaxed) + 1;   // Só esta thread escreve
+    if (seq == 0) seq = 1;                                           // 0 = deck não publicado
+    if (deck >= 0) decks_[deck].switchSeq.store(seq, std::memory_order_relaxed);
+    live_.store(deck, std::memory_order_relaxed);
+    switchFade_.store((int)((int64_t)crossfadeMs * rate_ / 1000), std::memory_order_relaxed);
+    switchSeq_.store(seq, std::memory_order_release);
+}
+
+void MusicStream::mixDeck(int deck, float* out, int frames, float gain, int fadeDir) {
+    Deck& d = decks_[deck];
+    const int got = (int)d.ring.read(scratch_, (size_t)frames);
+    if (got < frames && d.streaming.load(std::memory_order_relaxed)) underruns_.fetch_add(1, std::memory_order_relaxed);
+    if (fadeDir == 0 || fadeLen_ <= 0) {
+        for (int i = 0; i < got; ++i) out[i] += scratch_[i] * gain;
+        return;
+    }
+    // Rampa linear: +1 entrando, -1 saindo
+    const float inv = 1.0f / (float)fadeLen_;
+    for (int i = 0; i < got; ++i) {
+        float t = std::min(1.0f, (float)(fadePos_ + i) * inv);
+        if (fadeDir < 0) t = 1.0f - t;
+        out[i] += scratch_[i] * gain * t;
+    }
+}
+
+void MusicStream::mix(float* out, int frames, float gain) {
+    const uint32_t seq = switchSeq_.load(std::memory_order_acquire);
+    if (seq != seenSwitch_) {
+        seenSwitch_ = seq;
+        const int next = live_.load(std::memory_order_relaxed);
+        if (next != cur_) {
+            // Troca no meio de um fade: a faixa que já saía corta aqui
+            if (old_ >= 0) decks_[old_].state.store(RELEASED, std::memory_order_release);
+            old_ = cur_;
+            cur_ = next;
+            fadeLen_ = switchFade_.load(std::memory_order_relaxed);
+            fadePos_ = 0;
+        }
+        // Duas trocas antes deste callback: o deck da primeira nunca vira cur_/old_
+        // e ficaria PLAYING para sempre (a thread não teria deck livre). Solta aqui.
+        for (int d = 0; d < 2; ++d) {
+            if (d == cur_ || d == old_ || decks_[d].state.load(std::memory_order_acquire) != PLAYING) continue;
+            const uint32_t published = decks_[d].switchSeq.load(std::memory_order_relaxed);
+            if (published != 0 && (int32_t)(published - seq) <= 0) decks_[d].state.store(RELEASED, std::memory_order_release);
+        }
+    }
+    if (cur_ < 0 && old_ < 0) return;
+
+    static const Metrics::Id mUnderruns = Metrics::counter("music_underruns");
+    const unsigned before = underruns_.load(std::memory_order_relaxed);
+    const int block = (int)(sizeof(scratch_) / sizeof(scratch_[0]));
+    for (int done = 0; done < frames;) {
+        const int n = std::min(block, frames - done);
+        const bool fadingNow = old_ >= 0 && fadePos_ < fadeLen_;
+        if (cur_ >= 0) mixDeck(cur_, out + done, n, gain, fadingNow ? 1 : 0);
+        if (fadingNow) mixDeck(old_, out + done, n, gain, -1);
+        fadePos_ += n;
+        if (old_ >= 0 && fadePos_ >= fadeLen_) {
+            decks_[old_].state.store(RELEASED, std::memory_order_release);
+            old_ = -1;
+        }
+        done += n;
+    }
+    fading_.store(old_ >= 0, std::memory_order_relaxed);
+    if (underruns_.load(std::memory_order_relaxed) != before) Metrics::add(mUnderruns);
+}
+
+MusicStream::Stats MusicStream::stats() const {
+    Stats st;
+    st.underruns = underruns_.load(std::memory_order_relaxed);
+    const int live = live_.load(std::memory_order_relaxed);
+    if (live >= 0) st.buffered = (int)decks_[live].ring.readable();
+    st.fading = fading_.load(std::memory_order_relaxed);
+    return st;
+}
@@ -0,0 +1,149 @@
+#include "audio/SfxBank.hpp"
+#include "ConfigTypes.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+struct ToneSpec {
+    float freq;
+    int ms;
+    float vol;       // Ganho "cru": master/sfx entram como ganho de barramento
+    bool square;
+    int delayMs;
+};
+
+struct SfxSpec {
+    const char* name;
+    AudioMixer::Bus bus;
+    int toneCount;
+    ToneSpec tones[4];
+};
+
+// Mesmos parâmetros que antes eram sintetizados a cada tecla
+constexpr SfxSpec kSfxSpecs[] = {
+    {"MOVE",       AudioMixer::Bus::MAIN, 1, {{150.0f,   8, 0.06f, true,  0}}},
+    {"ROTATE_CW",  AudioMixer::Bus::MAIN, 1, {{350.0f,  15, 0.10f, false, 0}}},
+    {"ROTATE_CCW", AudioMixer::Bus::MAIN, 1, {{300.0f,  15, 0.10f, false, 0}}},
+    {"SOFT_DROP",  AudioMixer::Bus::MAIN, 1, {{200.0f,  12, 0.08f, true,  0}}},
+    {"HARD_DROP",  AudioMixer::Bus::MAIN, 1, {{400.0f,  20, 0.12f, true,  0}}},
+    {"KICK",       AudioMixer::Bus::MAIN, 1, {{250.0f,  15, 0.08f, true,  0}}},
+    {"LEVEL_UP",   AudioMixer::Bus::MAIN, 2, {{880.0f, 100, 0.25f, false, 0},
+                                              {1320.0f, 80, 0.20f, false, 100}}},
+    {"GAME_OVER",  AudioMixer::Bus::MAIN, 4, {{440.0f, 200, 0.30f, false, 0},
+                                              {392.0f, 200, 0.30f, false, 200},
+                                              {349.0f, 200, 0.30f, false, 400},
+                                              {294.0f, 300, 0.40f, false, 600}}},
+    {"TETRIS",     AudioMixer::Bus::SFX,  4, {{220.0f,  50, 0.20f, false, 0},
+                                              {1100.0f, 50, 0.20f, false, 50},
+                                              {1760.0f, 50, 0.20f, false, 100},
+                                              {2640.0f, 50, 0.20f, false, 150}}},
+};
+static_assert(sizeof(kSfxSpecs) / sizeof(kSfxSpecs[0]) == (size_t)SfxBank::Sfx::COUNT,
+              "kSfxSpecs precisa de uma entrada por SfxBank::Sfx");
+
+// Envelope igual ao das vozes do mixer (attack 2 ms, release 5 ms)
+void renderTone(std::vector<float>& out, int rate, const ToneSpec& t) {
+    int start = t.delayMs * rate / 1000;
+    int length = std::max(1, t.ms * rate / 1000);
+    int attack = std::clamp(2 * rate / 1000, 1, std::max(1, length / 2));
+    int release = std::clamp(5 * rate / 1000, 1, std::max(1, length / 2));
+    double phase = 0.0, inc = 2.0 * M_PI * t.freq / rate;
+
+    for (int i = 0; i < length; ++i) {
+        float s = t.square ? (phase < M_PI ? 1.0f : -1.0f) : (float)std::sin(phase);
+        phase += inc;
+        if (phase >= 2.0 * M_PI) phase -= 2.0 * M_PI;
+
+        float env = 1.0f;
+        if (i < attack) env = (float)i / attack;
+        else if (length - i < release) env = (float)(length - i) / release;
+        out[start + i] += s * env * t.vol;
+    }
+}
+
+} // namespace
+
+const char* SfxBank::name(Sfx sfx) {
+    return kSfxSpecs[(int)sfx].name;
+}
+
+void SfxBank::clear() {
+    for (auto& c : clips_) c = Clip{};
+    sampleRate_ = 0;
+}
+
+void SfxBank::build(int sampleRate, const AudioConfig& config) {
+    clear();
+    if (sampleRate <= 0) return;
+    sampleRate_ = sampleRate;
+
+    size_t totalSamples = 0;
+    int fromFiles = 0;
+    for (int i = 0; i < (int)Sfx::COUNT; ++i) {
+        Clip& clip = clips_[i];
+        clip.bus = kSfxSpecs[i].bus;
+
+        auto it = config.sfxFiles.find(kSfxSpecs[i].name);
+        if (it != config.sfxFiles.end() && !it->second.empty() && loadWav(it->second, clip)) {
+            clip.fromFile = true;
+            ++fromFiles;
+        } else {
+            synthesize((Sfx)i, clip);
+        }
+        totalSamples += clip.pcm.size();
+    }
+
+    DebugLogger::info("SFX bank built: " + std::to_string((int)Sfx::COUNT) + " clips (" +
+                      std::to_string(fromFiles) + " from WAV), " +
+                      std::to_string(totalSamples * sizeof(float) / 1024) + " KB");
+}
+
+void SfxBank::synthesize(Sfx sfx, Clip& clip) const {
+    const SfxSpec& spec = kSfxSpecs[(int)sfx];
+    int end = 0;
+    for (int t = 0; t < spec.toneCount; ++t) {
+        const ToneSpec& tone = spec.tones[t];
+        end = std::max(end, (tone.delayMs + tone.ms) * sampleRate_ / 1000 + 1);
+    }
+    clip.pcm.assign(end, 0.0f);
+    for (int t = 0; t < spec.toneCount; ++t) renderTone(clip.pcm, sampleRate_, spec.tones[t]);
+}
+
+bool SfxBank::loadWav(const std::string& path, Clip& clip) const {
+    SDL_AudioSpec wav{};
+    Uint8* buf = nullptr;
+    Uint32 len = 0;
+    if (!SDL_LoadWAV(path.c_str(), &wav, &buf, &len)) {
+        DebugLogger::warning("SFX WAV load failed (" + path + "): " + SDL_GetError());
+        return false;
+    }
+
+    // Converter para float mono na taxa do dispositivo
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, wav.format, wav.channels, wav.freq, AUDIO_F32SYS, 1, sampleRate_) < 0) {
+        DebugLogger::warning("SFX WAV conversion unsupported (" + path + "): " + SDL_GetError());
+        SDL_FreeWAV(buf);
+        return false;
+    }
+    std::vector<Uint8> work((size_t)len * cvt.len_mult);
+    std::memcpy(work.data(), buf, len);
+    SDL_FreeWAV(buf);
+    cvt.buf = work.data();
+    cvt.len = (int)len;
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        DebugLogger::warning("SFX WAV conversion failed (" + path + "): " + SDL_GetError());
+        return false;
+    }
+
+    int outBytes = cvt.needed ? cvt.len_cvt : (int)len;
+    clip.pcm.resize(outBytes / sizeof(float));
+    std::memcpy(clip.pcm.data(), work.data(), clip.pcm.size() * sizeof(float));
+    return !clip.pcm.empty();
+}
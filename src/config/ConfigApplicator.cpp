@@ -4,20 +4,133 @@
 #include "app/GameState.hpp"
 #include "input/InputManager.hpp"
 #include "input/JoystickInput.hpp"
+#include "input/KeyboardInput.hpp"
 #include "pieces/Piece.hpp"
+#include "pieces/PieceManager.hpp"
+#include "ConfigManager.hpp"
 #include "render/GameStateBridge.hpp"
 #include "DebugLogger.hpp"
 #include <sstream>
 #include <iomanip>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
 
 // External globals from dropblocks.cpp
 extern int ROUNDED_PANELS;
+extern int CACHED_PANELS;
+extern int CACHED_LAYERS;
+extern std::string CELL_SKIN;
 extern int HUD_FIXED_SCALE;
 extern std::string TITLE_TEXT;
 extern int SPEED_ACCELERATION;
 extern int LEVEL_STEP;
 extern GameConfig gameConfig;
 extern LayoutConfig layoutConfig;
+extern std::vector<Piece> PIECES;
+
+// ---- Comparação para o hot reload ----
+namespace {
+
+// memcmp só onde não há padding nem float (has_unique_object_representations garante)
+template <class T> bool sameBytes(const T& a, const T& b) {
+    static_assert(std::has_unique_object_representations<T>::value, "compare field by field");
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+bool sameEffects(const VisualConfig::Effects& a, const VisualConfig::Effects& b) {
+    auto t = [](const VisualConfig::Effects& e) {
+        return std::tie(e.bannerSweep, e.globalSweep, e.sweepSpeedPxps, e.sweepBandHS, e.sweepAlphaMax, e.sweepSoftness,
+                        e.sweepGSpeedPxps, e.sweepGBandHPx, e.sweepGAlphaMax, e.sweepGSoftness, e.scanlineAlpha,
+                        e.crtShader, e.crtCurvature, e.crtVignette, e.crtGlow, e.particleCapacity, e.particleDensity);
+    };
+    return t(a) == t(b);
+}
+
+bool sameAudio(const AudioConfig& a, const AudioConfig& b) {
+    auto t = [](const AudioConfig& c) {
+        return std::tie(c.masterVolume, c.sfxVolume, c.ambientVolume, c.enableMovementSounds, c.enableAmbientSounds,
+                        c.enableComboSounds, c.enableLevelUpSounds, c.sfxFiles, c.musicVolume, c.musicCrossfadeMs,
+                        c.musicFiles);
+    };
+    return t(a) == t(b);
+}
+
+bool sameInput(const InputConfig& a, const InputConfig& b) {
+    auto t = [](const InputConfig& c) {
+        return std::tie(c.buttonLeft, c.buttonRight, c.buttonDown, c.buttonUp, c.buttonRotateCCW, c.buttonRotateCW,
+                        c.buttonSoftDrop, c.buttonHardDrop, c.buttonPause, c.buttonStart, c.buttonQuit,
+                        c.analogDeadzone, c.analogSensitivity, c.invertYAxis,
+                        c.moveRepeatDelayDAS, c.moveRepeatDelayARR, c.softDropRepeatDelay);
+    };
+    return t(a) == t(b) && std::memcmp(a.keys, b.keys, sizeof(a.keys)) == 0;
+}
+
+bool sameTimer(const TimerConfig& a, const TimerConfig& b) {
+    auto t = [](const TimerConfig& c) {
+        return std::tie(c.enabled, c.durationSeconds, c.showWarningAt30s, c.showWarningAt10s);
+    };
+    auto rgb = [](const TimerConfig& c) {
+        return std::make_tuple(c.normalColor, c.warningColor, c.criticalColor, c.progressBarBg, c.progressBarBorder);
+    };
+    auto bytes = [](const std::tuple<RGB, RGB, RGB, RGB, RGB>& x, const std::tuple<RGB, RGB, RGB, RGB, RGB>& y) {
+        return sameBytes(std::get<0>(x), std::get<0>(y)) && sameBytes(std::get<1>(x), std::get<1>(y)) &&
+               sameBytes(std::get<2>(x), std::get<2>(y)) && sameBytes(std::get<3>(x), std::get<3>(y)) &&
+               sameBytes(std::get<4>(x), std::get<4>(y));
+    };
+    return t(a) == t(b) && sameBytes(a.layout, b.layout) && bytes(rgb(a), rgb(b));
+}
+
+bool sameSpeed(const GameConfig& a, const GameConfig& b) {
+    return std::tie(a.tickMsStart, a.tickMsMin, a.speedAcceleration, a.levelStep) ==
+           std::tie(b.tickMsStart, b.tickMsMin, b.speedAcceleration, b.levelStep);
+}
+
+// Campos lidos só na montagem do loop (pacing, threads, bot, replay, attract)
+bool sameGameStartup(const GameConfig& a, const GameConfig& b) {
+    auto t = [](const GameConfig& g) {
+        return std::tie(g.framePacing, g.targetFps, g.simStepMs, g.threadedMode, g.inputThread, g.profileCsv, g.replayRecordDir,
+                        g.replayFile, g.replaySpeed, g.botEnabled, g.botThreads, g.botBudgetMs, g.botLookahead,
+                        g.botActionDelayMs, g.botWeightHeight, g.botWeightLines, g.botWeightHoles, g.botWeightBumpiness,
+                        g.attractIdleSeconds, g.attractFps, g.attractActionDelayMs, g.attractBotThreads,
+                        g.attractBotBudgetMs, g.attractLookahead, g.configWatchMs, g.renderDriver, g.renderProbeFile,
+                        g.boardCols, g.boardRows, g.splitPlayers, g.splitBots, g.splitParallel,
+                        g.netPeer, g.netPort, g.netChecksumTicks, g.netGarbage,
+                        g.spectatePort, g.spectateSource, g.spectateBufferMs,
+                        g.captureVideo, g.captureFps, g.captureDelayFrames, g.captureBudgetMb,
+                        g.themeFiles, g.themeAttractSeconds, g.idleRender, g.idleWaitMs,
+                        g.frameArenaKb, g.marqueeDisplay, g.marqueeFps,
+                        g.sessionLog, g.highScoreCount, g.sessionFsyncMs,
+                        g.practiceMode, g.rewindSlots, g.rewindIntervalTicks, g.resumeFile, g.resumeSaveMs,
+                        g.traceSeconds, g.traceFile, g.qualityGovernor, g.qualityBudgetMs, g.textureBudgetMb);
+    };
+    return t(a) == t(b);
+}
+
+bool samePieceColors(const std::vector<RGB>& a, const std::vector<RGB>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) if (!sameBytes(a[i], b[i])) return false;
+    return true;
+}
+
+// Tudo do PiecesConfig menos as cores (lido no boot: arquivo, randomizer, RNG)
+bool samePiecesStartup(const PiecesConfig& a, const PiecesConfig& b) {
+    return std::tie(a.piecesFilePath, a.previewGrid, a.randomizerType, a.randBagSize, a.rngType, a.rngSeed) ==
+           std::tie(b.piecesFilePath, b.previewGrid, b.randomizerType, b.randBagSize, b.rngType, b.rngSeed);
+}
+
+bool sameShape(const Piece& a, const Piece& b) {
+    return a.name == b.name && a.rot == b.rot && a.kicksPerTrans == b.kicksPerTrans &&
+           a.hasPerTransKicks == b.hasPerTransKicks && a.kicksCW == b.kicksCW && a.kicksCCW == b.kicksCCW &&
+           a.hasKicks == b.hasKicks && a.weight == b.weight;
+}
+
+void appendName(std::string& list, const char* name) {
+    if (!list.empty()) list += ", ";
+    list += name;
+}
+
+} // namespace
 
 namespace ConfigApplicator {
 
@@ -26,6 +139,7 @@ void applyThemePieceColors(ThemeManager& themeManager, std::vector<Piece>& piece
 }
 
 void applyConfigToAudio(AudioSystem& audio, const AudioConfig& config) {
+    audio.setConfig(config);
     audio.masterVolume = config.masterVolume;
     audio.sfxVolume = config.sfxVolume;
     audio.ambientVolume = config.ambientVolume;
@@ -35,136 +149,141 @@ void applyConfigToAudio(AudioSystem& audio, const AudioConfig& config) {
     audio.enableLevelUpSounds = config.enableLevelUpSounds;
 }
 
-void applyConfigToTheme(const VisualConfig& config, ThemeManager& themeManager, VisualEffectsView& visualView) {
-    // Debug: Log colors being applied
-    std::stringstream ss;
-    ss << "Applying theme colors - Background: #" 
-       << std::hex << std::setfill('0') << std::setw(2) << (int)config.colors.background.r
-       << std::setw(2) << (int)config.colors.background.g 
-       << std::setw(2) << (int)config.colors.background.b
-       << ", Panel Fill: #"
-       << std::setw(2) << (int)config.colors.panelFill.r
-       << std::setw(2) << (int)config.colors.panelFill.g
-       << std::setw(2) << (int)config.colors.panelFill.b
-       << ", Banner: #"
-       << std::setw(2) << (int)config.colors.bannerBg.r
-       << std::setw(2) << (int)config.colors.bannerBg.g
-       << std::setw(2) << (int)config.colors.bannerBg.b;
-    DebugLogger::info(ss.str());
-
-    // Apply colors
-    themeManager.getTheme().bg_r = config.colors.background.r;
-    themeManager.getTheme().bg_g = config.colors.background.g;
-    themeManager.getTheme().bg_b = config.colors.background.b;
-    
-    themeManager.getTheme().board_empty_r = config.colors.boardEmpty.r;
-    themeManager.getTheme().board_empty_g = config.colors.boardEmpty.g;
-    themeManager.getTheme().board_empty_b = config.colors.boardEmpty.b;
-    
-    themeManager.getTheme().panel_fill_r = config.colors.panelFill.r;
-    themeManager.getTheme().panel_fill_g = config.colors.panelFill.g;
-    themeManager.getTheme().panel_fill_b = config.colors.panelFill.b;
-    
-    themeManager.getTheme().panel_outline_r = config.colors.panelOutline.r;
-    themeManager.getTheme().panel_outline_g = config.colors.panelOutline.g;
-    themeManager.getTheme().panel_outline_b = config.colors.panelOutline.b;
+void applyColorsToTheme(const VisualConfig& config, Theme& theme) {
+    theme.bg_r = config.colors.background.r;
+    theme.bg_g = config.colors.background.g;
+    theme.bg_b = config.colors.background.b;
+    
+    theme.board_empty_r = config.colors.boardEmpty.r;
+    theme.board_empty_g = config.colors.boardEmpty.g;
+    theme.board_empty_b = config.colors.boardEmpty.b;
+    
+    theme.panel_fill_r = config.colors.panelFill.r;
+    theme.panel_fill_g = config.colors.panelFill.g;
+    theme.panel_fill_b = config.colors.panelFill.b;
+    
+    theme.panel_outline_r = config.colors.panelOutline.r;
+    theme.panel_outline_g = config.colors.panelOutline.g;
+    theme.panel_outline_b = config.colors.panelOutline.b;
     
     // Banner
-    themeManager.getTheme().banner_bg_r = config.colors.bannerBg.r;
-    themeManager.getTheme().banner_bg_g = config.colors.bannerBg.g;
-    themeManager.getTheme().banner_bg_b = config.colors.bannerBg.b;
+    theme.banner_bg_r = config.colors.bannerBg.r;
+    theme.banner_bg_g = config.colors.bannerBg.g;
+    theme.banner_bg_b = config.colors.bannerBg.b;
     
-    themeManager.getTheme().banner_outline_r = config.colors.bannerOutline.r;
-    themeManager.getTheme().banner_outline_g = config.colors.bannerOutline.g;
-    themeManager.getTheme().banner_outline_b = config.colors.bannerOutline.b;
+    theme.banner_outline_r = config.colors.bannerOutline.r;
+    theme.banner_outline_g = config.colors.bannerOutline.g;
+    theme.banner_outline_b = config.colors.bannerOutline.b;
     
-    themeManager.getTheme().banner_text_r = config.colors.bannerText.r;
-    themeManager.getTheme().banner_text_g = config.colors.bannerText.g;
-    themeManager.getTheme().banner_text_b = config.colors.bannerText.b;
+    theme.banner_text_r = config.colors.bannerText.r;
+    theme.banner_text_g = config.colors.bannerText.g;
+    theme.banner_text_b = config.colors.bannerText.b;
     
     // HUD
-    themeManager.getTheme().hud_label_r = config.colors.hudLabel.r;
-    themeManager.getTheme().hud_label_g = config.colors.hudLabel.g;
-    themeManager.getTheme().hud_label_b = config.colors.hudLabel.b;
+    theme.hud_label_r = config.colors.hudLabel.r;
+    theme.hud_label_g = config.colors.hudLabel.g;
+    theme.hud_label_b = config.colors.hudLabel.b;
     
-    themeManager.getTheme().hud_score_r = config.colors.hudScore.r;
-    themeManager.getTheme().hud_score_g = config.colors.hudScore.g;
-    themeManager.getTheme().hud_score_b = config.colors.hudScore.b;
+    theme.hud_score_r = config.colors.hudScore.r;
+    theme.hud_score_g = config.colors.hudScore.g;
+    theme.hud_score_b = config.colors.hudScore.b;
     
-    themeManager.getTheme().hud_lines_r = config.colors.hudLines.r;
-    themeManager.getTheme().hud_lines_g = config.colors.hudLines.g;
-    themeManager.getTheme().hud_lines_b = config.colors.hudLines.b;
+    theme.hud_lines_r = config.colors.hudLines.r;
+    theme.hud_lines_g = config.colors.hudLines.g;
+    theme.hud_lines_b = config.colors.hudLines.b;
     
-    themeManager.getTheme().hud_level_r = config.colors.hudLevel.r;
-    themeManager.getTheme().hud_level_g = config.colors.hudLevel.g;
-    themeManager.getTheme().hud_level_b = config.colors.hudLevel.b;
+    theme.hud_level_r = config.colors.hudLevel.r;
+    theme.hud_level_g = config.colors.hudLevel.g;
+    theme.hud_level_b = config.colors.hudLevel.b;
     
     // SCORE
-    themeManager.getTheme().score_fill_r = config.colors.scoreFill.r;
-    themeManager.getTheme().score_fill_g = config.colors.scoreFill.g;
-    themeManager.getTheme().score_fill_b = config.colors.scoreFill.b;
+    theme.score_fill_r = config.colors.scoreFill.r;
+    theme.score_fill_g = config.colors.scoreFill.g;
+    theme.score_fill_b = config.colors.scoreFill.b;
     
-    themeManager.getTheme().score_outline_r = config.colors.scoreOutline.r;
-    themeManager.getTheme().score_outline_g = config.colors.scoreOutline.g;
-    themeManager.getTheme().score_outline_b = config.colors.scoreOutline.b;
+    theme.score_outline_r = config.colors.scoreOutline.r;
+    theme.score_outline_g = config.colors.scoreOutline.g;
+    theme.score_outline_b = config.colors.scoreOutline.b;
     
     // NEXT
-    themeManager.getTheme().next_fill_r = config.colors.nextFill.r;
-    themeManager.getTheme().next_fill_g = config.colors.nextFill.g;
-    themeManager.getTheme().next_fill_b = config.colors.nextFill.b;
+    theme.next_fill_r = config.colors.nextFill.r;
+    theme.next_fill_g = config.colors.nextFill.g;
+    theme.next_fill_b = config.colors.nextFill.b;
     
-    themeManager.getTheme().next_outline_r = config.colors.nextOutline.r;
-    themeManager.getTheme().next_outline_g = config.colors.nextOutline.g;
-    themeManager.getTheme().next_outline_b = config.colors.nextOutline.b;
+    theme.next_outline_r = config.colors.nextOutline.r;
+    theme.next_outline_g = config.colors.nextOutline.g;
+    theme.next_outline_b = config.colors.nextOutline.b;
     
-    themeManager.getTheme().next_label_r = config.colors.nextLabel.r;
-    themeManager.getTheme().next_label_g = config.colors.nextLabel.g;
-    themeManager.getTheme().next_label_b = config.colors.nextLabel.b;
+    theme.next_label_r = config.colors.nextLabel.r;
+    theme.next_label_g = config.colors.nextLabel.g;
+    theme.next_label_b = config.colors.nextLabel.b;
     
-    themeManager.getTheme().next_grid_dark_r = config.colors.nextGridDark.r;
-    themeManager.getTheme().next_grid_dark_g = config.colors.nextGridDark.g;
-    themeManager.getTheme().next_grid_dark_b = config.colors.nextGridDark.b;
+    theme.next_grid_dark_r = config.colors.nextGridDark.r;
+    theme.next_grid_dark_g = config.colors.nextGridDark.g;
+    theme.next_grid_dark_b = config.colors.nextGridDark.b;
     
-    themeManager.getTheme().next_grid_light_r = config.colors.nextGridLight.r;
-    themeManager.getTheme().next_grid_light_g = config.colors.nextGridLight.g;
-    themeManager.getTheme().next_grid_light_b = config.colors.nextGridLight.b;
-    themeManager.getTheme().next_grid_use_rgb = config.colors.nextGridUseRgb;
+    theme.next_grid_light_r = config.colors.nextGridLight.r;
+    theme.next_grid_light_g = config.colors.nextGridLight.g;
+    theme.next_grid_light_b = config.colors.nextGridLight.b;
+    theme.next_grid_use_rgb = config.colors.nextGridUseRgb;
     
     // Overlay
-    themeManager.getTheme().overlay_fill_r = config.colors.overlayFill.r;
-    themeManager.getTheme().overlay_fill_g = config.colors.overlayFill.g;
-    themeManager.getTheme().overlay_fill_b = config.colors.overlayFill.b;
-    themeManager.getTheme().overlay_fill_a = config.colors.overlayFillAlpha;
+    theme.overlay_fill_r = config.colors.overlayFill.r;
+    theme.overlay_fill_g = config.colors.overlayFill.g;
+    theme.overlay_fill_b = config.colors.overlayFill.b;
+    theme.overlay_fill_a = config.colors.overlayFillAlpha;
     
-    themeManager.getTheme().overlay_outline_r = config.colors.overlayOutline.r;
-    themeManager.getTheme().overlay_outline_g = config.colors.overlayOutline.g;
-    themeManager.getTheme().overlay_outline_b = config.colors.overlayOutline.b;
-    themeManager.getTheme().overlay_outline_a = config.colors.overlayOutlineAlpha;
+    theme.overlay_outline_r = config.colors.overlayOutline.r;
+    theme.overlay_outline_g = config.colors.overlayOutline.g;
+    theme.overlay_outline_b = config.colors.overlayOutline.b;
+    theme.overlay_outline_a = config.colors.overlayOutlineAlpha;
     
-    themeManager.getTheme().overlay_top_r = config.colors.overlayTop.r;
-    themeManager.getTheme().overlay_top_g = config.colors.overlayTop.g;
-    themeManager.getTheme().overlay_top_b = config.colors.overlayTop.b;
+    theme.overlay_top_r = config.colors.overlayTop.r;
+    theme.overlay_top_g = config.colors.overlayTop.g;
+    theme.overlay_top_b = config.colors.overlayTop.b;
     
-    themeManager.getTheme().overlay_sub_r = config.colors.overlaySub.r;
-    themeManager.getTheme().overlay_sub_g = config.colors.overlaySub.g;
-    themeManager.getTheme().overlay_sub_b = config.colors.overlaySub.b;
+    theme.overlay_sub_r = config.colors.overlaySub.r;
+    theme.overlay_sub_g = config.colors.overlaySub.g;
+    theme.overlay_sub_b = config.colors.overlaySub.b;
     
     // Statistics
-    themeManager.getTheme().stats_fill_r = config.colors.statsFill.r;
-    themeManager.getTheme().stats_fill_g = config.colors.statsFill.g;
-    themeManager.getTheme().stats_fill_b = config.colors.statsFill.b;
+    theme.stats_fill_r = config.colors.statsFill.r;
+    theme.stats_fill_g = config.colors.statsFill.g;
+    theme.stats_fill_b = config.colors.statsFill.b;
     
-    themeManager.getTheme().stats_outline_r = config.colors.statsOutline.r;
-    themeManager.getTheme().stats_outline_g = config.colors.statsOutline.g;
-    themeManager.getTheme().stats_outline_b = config.colors.statsOutline.b;
+    theme.stats_outline_r = config.colors.statsOutline.r;
+    theme.stats_outline_g = config.colors.statsOutline.g;
+    theme.stats_outline_b = config.colors.statsOutline.b;
     
-    themeManager.getTheme().stats_label_r = config.colors.statsLabel.r;
-    themeManager.getTheme().stats_label_g = config.colors.statsLabel.g;
-    themeManager.getTheme().stats_label_b = config.colors.statsLabel.b;
+    theme.stats_label_r = config.colors.statsLabel.r;
+    theme.stats_label_g = config.colors.statsLabel.g;
+    theme.stats_label_b = config.colors.statsLabel.b;
     
-    themeManager.getTheme().stats_count_r = config.colors.statsCount.r;
-    themeManager.getTheme().stats_count_g = config.colors.statsCount.g;
-    themeManager.getTheme().stats_count_b = config.colors.statsCount.b;
+    theme.stats_count_r = config.colors.statsCount.r;
+    theme.stats_count_g = config.colors.statsCount.g;
+    theme.stats_count_b = config.colors.statsCount.b;
+}
+
+void applyConfigToTheme(const VisualConfig& config, ThemeManager& themeManager, VisualEffectsView& visualView) {
+    // Debug: Log colors being applied (stringstream só com DEBUG ligado)
+    if (DB_LOG_ENABLED(DebugLogger::DEBUG)) {
+        std::stringstream ss;
+        ss << "Applying theme colors - Background: #" 
+           << std::hex << std::setfill('0') << std::setw(2) << (int)config.colors.background.r
+           << std::setw(2) << (int)config.colors.background.g 
+           << std::setw(2) << (int)config.colors.background.b
+           << ", Panel Fill: #"
+           << std::setw(2) << (int)config.colors.panelFill.r
+           << std::setw(2) << (int)config.colors.panelFill.g
+           << std::setw(2) << (int)config.colors.panelFill.b
+           << ", Banner: #"
+           << std::setw(2) << (int)config.colors.bannerBg.r
+           << std::setw(2) << (int)config.colors.bannerBg.g
+           << std::setw(2) << (int)config.colors.bannerBg.b;
+        DB_LOG_DEBUG(ss.str());
+    }
+
+    applyColorsToTheme(config, themeManager.getConfigTheme());  // Paleta da ThemeLibrary ativa: aparece ao voltar para esta
     
     // Apply effects
     // Visual effects now flow via g_visualView and bridge only
@@ -179,13 +298,22 @@ void applyConfigToTheme(const VisualConfig& config, ThemeManager& themeManager,
     visualView.sweepGAlphaMax = config.effects.sweepGAlphaMax;
     visualView.sweepGSoftness = config.effects.sweepGSoftness;
     visualView.scanlineAlpha = config.effects.scanlineAlpha;
+    visualView.crtShader = config.effects.crtShader;
+    visualView.crtCurvature = config.effects.crtCurvature;
+    visualView.crtVignette = config.effects.crtVignette;
+    visualView.crtGlow = config.effects.crtGlow;
+    visualView.particleCapacity = config.effects.particleCapacity;
+    visualView.particleDensity = config.effects.particleDensity;
     
     // Apply layout
     ROUNDED_PANELS = config.layout.roundedPanels;
+    CACHED_PANELS = config.layout.cachedPanels;
+    CACHED_LAYERS = config.layout.cachedLayers;
     HUD_FIXED_SCALE = config.layout.hudFixedScale;
     
     // Apply text
     TITLE_TEXT = config.titleText;
+    CELL_SKIN = config.cellSkin;
 }
 
 void applyConfigToGame(GameState& state, const GameConfig& config) {
@@ -194,6 +322,12 @@ void applyConfigToGame(GameState& state, const GameConfig& config) {
     SPEED_ACCELERATION = config.speedAcceleration;
     LEVEL_STEP = config.levelStep;
     
+    // Tamanho do tabuleiro: só no boot, antes do primeiro layout/partida
+    COLS = config.boardCols;
+    ROWS = config.boardRows;
+    GameBoard& board = state.getBoard();
+    if (board.width() != COLS || board.height() != ROWS) board.resize(COLS, ROWS);
+    
     // Apply configuration to the new modular systems
     state.getScore().setTickMs(config.tickMsStart);
 }
@@ -201,17 +335,31 @@ void applyConfigToGame(GameState& state, const GameConfig& config) {
 void applyConfigToPieces(const PiecesConfig& config, ThemeManager& themeManager) {
     // Apply piece colors
     if (!config.pieceColors.empty()) {
-        themeManager.getTheme().piece_colors.clear();
+        themeManager.getConfigTheme().piece_colors.clear();
         for (const auto& color : config.pieceColors) {
-            themeManager.getTheme().piece_colors.push_back({color.r, color.g, color.b});
+            themeManager.getConfigTheme().piece_colors.push_back({color.r, color.g, color.b});
         }
     }
 }
 
 void applyConfigToJoystick(InputManager& inputManager, const InputConfig& config) {
-    // Find JoystickInput handler in InputManager
+    // DAS/ARR compartilhado por teclado e joystick
+    InputTimingManager::TimingConfig timing;
+    timing.DAS = config.moveRepeatDelayDAS;
+    timing.ARR = config.moveRepeatDelayARR;
+    timing.softDropDelay = config.softDropRepeatDelay;
+    
+    bool joystickConfigured = false;
     for (auto& handler : inputManager.getHandlers()) {
-        if (auto* joystickInput = dynamic_cast<JoystickInput*>(handler.get())) {
+        if (auto* keyboardInput = dynamic_cast<KeyboardInput*>(handler.get())) {
+            keyboardInput->getTimingManager().setConfig(timing);
+            KeyMap keyMap;
+            keyMap.load(config);
+            keyboardInput->setKeyMap(keyMap);
+        } else if (auto* joystickInput = dynamic_cast<JoystickInput*>(handler.get())) {
+            if (joystickConfigured) continue; // Only configure the first joystick found
+            joystickConfigured = true;
+            
             JoystickConfig& joystickConfig = joystickInput->getConfig();
             
             // Apply button mappings
@@ -236,8 +384,7 @@ void applyConfigToJoystick(InputManager& inputManager, const InputConfig& config
             joystickConfig.moveRepeatDelayDAS = config.moveRepeatDelayDAS;
             joystickConfig.moveRepeatDelayARR = config.moveRepeatDelayARR;
             joystickConfig.softDropRepeatDelay = config.softDropRepeatDelay;
-            
-            break; // Only configure the first joystick found
+            joystickInput->getTimingManager().setConfig(joystickConfig.getTimingConfig());
         }
     }
 }
@@ -247,5 +394,116 @@ void applyConfigToLayout(const LayoutConfig& config) {
     layoutConfig = config;
 }
 
+unsigned applyReloadedConfig(ConfigManager& live, const ConfigManager& fresh, GameState& state, InputManager& input,
+                             ThemeManager& themeManager, VisualEffectsView& visualView, bool simThreaded) {
+    unsigned changed = 0;
+    std::string applied, deferred;
+
+    const VisualConfig& v = fresh.getVisual();
+    const VisualConfig& lv = live.getVisual();
+    if (!sameBytes(v.colors, lv.colors)) { changed |= ConfigChange::COLORS; appendName(applied, "colors"); }
+    if (!sameEffects(v.effects, lv.effects)) { changed |= ConfigChange::EFFECTS; appendName(applied, "effects"); }
+    if (!sameBytes(v.layout, lv.layout) || v.titleText != lv.titleText || v.cellSkin != lv.cellSkin) { changed |= ConfigChange::PANELS; appendName(applied, "panels"); }
+    if (changed) {
+        applyConfigToTheme(v, themeManager, visualView);
+        live.getVisual() = v;
+    }
+
+    if (!samePieceColors(fresh.getPieces().pieceColors, live.getPieces().pieceColors)) {
+        themeManager.getConfigTheme().piece_colors.clear();  // Sem PIECE<n>: volta para as cores padrão
+        applyConfigToPieces(fresh.getPieces(), themeManager);
+        applyThemePieceColors(themeManager, PIECES);
+        live.getPieces().pieceColors = fresh.getPieces().pieceColors;
+        changed |= ConfigChange::PIECE_COLORS;
+        appendName(applied, "piece colors");
+    }
+    if (!samePiecesStartup(fresh.getPieces(), live.getPieces())) appendName(deferred, "pieces options");
+
+    if (!sameBytes(fresh.getLayout(), live.getLayout())) {
+        applyConfigToLayout(fresh.getLayout());
+        live.getLayout() = fresh.getLayout();
+        changed |= ConfigChange::LAYOUT;
+        appendName(applied, "layout");
+    }
+
+    // Lidos pela simulação: só com ela nesta thread
+    if (!sameAudio(fresh.getAudio(), live.getAudio())) {
+        AudioSystem* audio = dynamic_cast<AudioSystem*>(state.getAudio());
+        if (simThreaded || !audio) appendName(deferred, "audio");
+        else {
+            applyConfigToAudio(*audio, fresh.getAudio());
+            live.getAudio() = fresh.getAudio();
+            changed |= ConfigChange::AUDIO;
+            appendName(applied, "audio");
+        }
+    }
+    if (!sameInput(fresh.getInput(), live.getInput())) {
+        if (simThreaded) appendName(deferred, "input");
+        else {
+            applyConfigToJoystick(input, fresh.getInput());
+            live.getInput() = fresh.getInput();
+            changed |= ConfigChange::INPUT;
+            appendName(applied, "input");
+        }
+    }
+    const GameConfig& g = fresh.getGame();
+    if (!sameSpeed(g, live.getGame())) {
+        if (simThreaded) appendName(deferred, "speed");
+        else {
+            // Sem setTickMs: a partida atual não volta para a velocidade inicial
+            gameConfig.tickMsStart = g.tickMsStart;
+            gameConfig.tickMsMin = g.tickMsMin;
+            SPEED_ACCELERATION = g.speedAcceleration;
+            LEVEL_STEP = g.levelStep;
+            GameConfig& lg = live.getGame();
+            lg.tickMsStart = g.tickMsStart; lg.tickMsMin = g.tickMsMin;
+            lg.speedAcceleration = g.speedAcceleration; lg.levelStep = g.levelStep;
+            changed |= ConfigChange::GAME;
+            appendName(applied, "speed");
+        }
+    }
+    if (!sameGameStartup(g, live.getGame())) appendName(deferred, "game/bot/replay options");
+    if (!sameTimer(fresh.getTimer(), live.getTimer())) {
+        if (simThreaded) appendName(deferred, "timer");
+        else {
+            state.setTimerConfig(fresh.getTimer());
+            live.getTimer() = fresh.getTimer();
+            changed |= ConfigChange::TIMER;
+            appendName(applied, "timer");
+        }
+    }
+
+    DebugLogger::info("Config reload: " + (applied.empty() ? std::string("nothing to apply") : "applied " + applied));
+    if (!deferred.empty()) DebugLogger::info("Config reload: restart to apply " + deferred);
+    return changed;
+}
+
+unsigned applyReloadedPieces(PieceSet& set, ThemeManager& themeManager, bool piecesShared) {
+    bool sameShapes = set.pieces.size() == PIECES.size();
+    bool sameColors = sameShapes;
+    for (size_t i = 0; sameShapes && i < PIECES.size(); ++i) {
+        sameShapes = sameShape(set.pieces[i], PIECES[i]);
+        sameColors = sameColors && set.pieces[i].r == PIECES[i].r && set.pieces[i].g == PIECES[i].g && set.pieces[i].b == PIECES[i].b;
+    }
+
+    if (sameShapes) {
+        // Só cores/opções: r,g,b não são lidos pela busca do bot nem pela simulação
+        for (size_t i = 0; i < PIECES.size(); ++i) {
+            PIECES[i].r = set.pieces[i].r; PIECES[i].g = set.pieces[i].g; PIECES[i].b = set.pieces[i].b;
+        }
+        applyThemePieceColors(themeManager, PIECES);
+        DebugLogger::info(sameColors ? "Pieces reload: no shape or color change" : "Pieces reload: applied colors");
+        return sameColors ? 0u : (unsigned)ConfigChange::PIECE_COLORS;
+    }
+    if (piecesShared || set.pieces.size() != PIECES.size()) {
+        DebugLogger::info("Pieces reload: restart to apply the new piece set (" + std::to_string(set.pieces.size()) + " pieces)");
+        return 0;
+    }
+    PieceManager::installPieceSet(std::move(set));
+    applyThemePieceColors(themeManager, PIECES);
+    DebugLogger::info("Pieces reload: applied " + std::to_string(PIECES.size()) + " pieces");
+    return ConfigChange::PIECES | ConfigChange::PIECE_COLORS;
+}
+
 } // namespace ConfigApplicator
 
@@ -0,0 +1,369 @@
+#include "config/ConfigCache.hpp"
+#include "ConfigManager.hpp"
+#include "pieces/Piece.hpp"
+#include "pieces/PieceManager.hpp"
+#include "pieces/PieceTable.hpp"
+#include "DebugLogger.hpp"
+#include "util/MappedFile.hpp"
+
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+extern std::vector<Piece> PIECES;
+
+namespace {
+
+const char MAGIC[4] = {'D', 'B', 'C', 'C'};
+constexpr uint32_t VERSION = 26;   // Mudou uma struct com string/vector? Sobe aqui e em put/get
+
+static_assert(std::is_trivially_copyable<VisualConfig::Colors>::value, "raw block");
+static_assert(std::is_trivially_copyable<VisualConfig::Effects>::value, "raw block");
+static_assert(std::is_trivially_copyable<VisualConfig::Layout>::value, "raw block");
+static_assert(std::is_trivially_copyable<InputConfig>::value, "raw block");
+static_assert(std::is_trivially_copyable<LayoutConfig>::value, "raw block");
+static_assert(std::is_trivially_copyable<TimerConfig>::value, "raw block");
+
+// Tamanhos dos blocos crus: outro compilador/plataforma ou struct alterada = blob recusado
+uint32_t layoutFingerprint() {
+    const size_t sizes[] = {sizeof(VisualConfig::Colors), sizeof(VisualConfig::Effects), sizeof(VisualConfig::Layout),
+                            sizeof(InputConfig), sizeof(LayoutConfig), sizeof(TimerConfig), sizeof(RGB)};
+    uint32_t h = 2166136261u;
+    for (size_t s : sizes) { h ^= (uint32_t)s; h *= 16777619u; }
+    return h;
+}
+
+uint64_t fnv1a(const char* p, size_t n) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < n; ++i) { h ^= (uint8_t)p[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+struct Source {
+    std::string path;
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+};
+
+bool statFile(const std::string& path, uint64_t& size, int64_t& mtime) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !(st.st_mode & S_IFREG)) return false;
+    size = (uint64_t)st.st_size;
+    mtime = (int64_t)st.st_mtime;
+    return true;
+}
+
+bool hashFile(const std::string& path, uint64_t& hash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.good()) return false;
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    hash = fnv1a(data.data(), data.size());
+    return true;
+}
+
+bool stampSource(const std::string& path, Source& out) {
+    out.path = path;
+    return statFile(path, out.size, out.mtime) && hashFile(path, out.hash);
+}
+
+// Tamanho/mtime iguais: confia. Senão o conteúdo decide (cópia, checkout, touch)
+bool sourceUnchanged(const Source& s) {
+    uint64_t size; int64_t mtime;
+    if (!statFile(s.path, size, mtime)) return false;
+    if (size == s.size && mtime == s.mtime) return true;
+    uint64_t hash;
+    return size == s.size && hashFile(s.path, hash) && hash == s.hash;
+}
+
+// Primeiro candidato que existe (o mesmo que o loader abriria)
+std::string firstExisting(const std::vector<std::string>& candidates) {
+    for (const std::string& p : candidates) {
+        uint64_t size; int64_t mtime;
+        if (statFile(p, size, mtime)) return p;
+    }
+    return std::string();
+}
+
+std::string envOrEmpty(const char* name) {
+    const char* v = std::getenv(name);
+    return v ? std::string(v) : std::string();
+}
+
+// ---- Escrita/leitura ----
+class Writer {
+public:
+    template <class T> void raw(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "raw() only for trivially copyable types");
+        const char* p = reinterpret_cast<const char*>(&v);
+        out_.insert(out_.end(), p, p + sizeof(T));
+    }
+    void str(const std::string& s) { raw((uint32_t)s.size()); out_.insert(out_.end(), s.begin(), s.end()); }
+    void pairs(const std::vector<std::pair<int,int>>& v) {
+        raw((uint32_t)v.size());
+        for (const auto& p : v) { raw((int32_t)p.first); raw((int32_t)p.second); }
+    }
+    const std::string& data() const { return out_; }
+
+private:
+    std::string out_;
+};
+
+class Reader {
+public:
+    Reader(const char* p, size_t n) : p_(p), end_(p + n) {}
+    bool ok() const { return ok_; }
+    bool atEnd() const { return p_ == end_; }
+
+    template <class T> void raw(T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "raw() only for trivially copyable types");
+        if ((size_t)(end_ - p_) < sizeof(T)) { ok_ = false; return; }
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+    }
+    uint32_t count() {
+        uint32_t n = 0; raw(n);
+        if (n > (size_t)(end_ - p_)) { ok_ = false; return 0; }  // Cada item ocupa >= 1 byte
+        return n;
+    }
+    void str(std::string& s) {
+        uint32_t n = count();
+        if (!ok_) return;
+        s.assign(p_, n);
+        p_ += n;
+    }
+    void pairs(std::vector<std::pair<int,int>>& v) {
+        uint32_t n = count();
+        v.clear();
+        v.reserve(n);
+        for (uint32_t i = 0; i < n && ok_; ++i) {
+            int32_t a = 0, b = 0; raw(a); raw(b);
+            v.emplace_back(a, b);
+        }
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+    bool ok_ = true;
+};
+
+// Campos um a um: as structs com string/vector/map
+template <class IO, class Audio> void audioFields(IO& io, Audio& a) {
+    io.raw(a.masterVolume); io.raw(a.sfxVolume); io.raw(a.ambientVolume);
+    io.raw(a.enableMovementSounds); io.raw(a.enableAmbientSounds);
+    io.raw(a.enableComboSounds); io.raw(a.enableLevelUpSounds);
+    io.raw(a.musicVolume); io.raw(a.musicCrossfadeMs);
+}
+
+template <class IO, class Pieces> void piecesFields(IO& io, Pieces& p) {
+    io.str(p.piecesFilePath); io.raw(p.previewGrid); io.str(p.randomizerType);
+    io.raw(p.randBagSize); io.str(p.rngType); io.raw(p.rngSeed);
+}
+
+template <class IO, class Game> void gameFields(IO& io, Game& g) {
+    io.raw(g.tickMsStart); io.raw(g.tickMsMin); io.raw(g.speedAcceleration); io.raw(g.levelStep);
+    io.raw(g.boardCols); io.raw(g.boardRows);
+    io.str(g.framePacing); io.raw(g.targetFps); io.raw(g.simStepMs); io.raw(g.threadedMode); io.raw(g.inputThread);
+    io.raw(g.splitPlayers); io.raw(g.splitBots); io.raw(g.splitParallel);
+    io.str(g.netPeer); io.raw(g.netPort); io.raw(g.netChecksumTicks); io.raw(g.netGarbage);
+    io.raw(g.spectatePort); io.str(g.spectateSource); io.raw(g.spectateBufferMs);
+    io.str(g.captureVideo); io.raw(g.captureFps); io.raw(g.captureDelayFrames); io.raw(g.captureBudgetMb);
+    io.str(g.themeFiles); io.raw(g.themeAttractSeconds); io.raw(g.idleRender); io.raw(g.idleWaitMs);
+    io.raw(g.frameArenaKb); io.raw(g.marqueeDisplay); io.raw(g.marqueeFps);
+    io.str(g.profileCsv); io.raw(g.latencyProbe); io.str(g.renderDriver); io.str(g.renderProbeFile);
+    io.raw(g.traceSeconds); io.str(g.traceFile); io.raw(g.qualityGovernor); io.raw(g.qualityBudgetMs);
+    io.raw(g.textureBudgetMb);
+    io.str(g.replayRecordDir); io.str(g.replayFile); io.str(g.replaySpeed);
+    io.str(g.sessionLog); io.raw(g.highScoreCount); io.raw(g.sessionFsyncMs);
+    io.raw(g.practiceMode); io.raw(g.rewindSlots); io.raw(g.rewindIntervalTicks);
+    io.str(g.resumeFile); io.raw(g.resumeSaveMs);
+    io.raw(g.botEnabled); io.raw(g.botThreads); io.raw(g.botBudgetMs); io.raw(g.botLookahead);
+    io.raw(g.botActionDelayMs); io.raw(g.botWeightHeight); io.raw(g.botWeightLines);
+    io.raw(g.botWeightHoles); io.raw(g.botWeightBumpiness);
+    io.raw(g.attractIdleSeconds); io.raw(g.attractFps); io.raw(g.attractActionDelayMs);
+    io.raw(g.attractBotThreads); io.raw(g.attractBotBudgetMs); io.raw(g.attractLookahead);
+    io.raw(g.configWatchMs);
+    io.str(g.logLevel); io.str(g.logFile); io.raw(g.logFileMaxKb); io.raw(g.logFileKeep);
+    io.str(g.metricsTarget); io.str(g.metricsPrefix); io.raw(g.metricsIntervalMs); io.raw(g.metricsFileMaxKb);
+}
+
+template <class IO, class P> void pieceFields(IO& io, P& p) {
+    io.str(p.name);
+    io.raw(p.r); io.raw(p.g); io.raw(p.b); io.raw(p.weight);
+    for (auto& dir : p.kicksPerTrans) for (auto& seq : dir) io.pairs(seq);
+    io.raw(p.hasPerTransKicks);
+    io.pairs(p.kicksCW); io.pairs(p.kicksCCW);
+    io.raw(p.hasKicks);
+}
+
+} // namespace
+
+namespace ConfigCache {
+
+bool save(const std::string& path, const ConfigManager& config, const PieceManager& pieces) {
+    std::vector<Source> sources;
+    for (const std::string& p : config.getConfigPaths()) {
+        Source s;
+        if (!stampSource(p, s)) { DebugLogger::warning("Config cache: cannot stamp " + p + ", not writing " + path); return false; }
+        sources.push_back(s);
+    }
+    if (!pieces.getLoadedPath().empty()) {
+        Source s;
+        if (!stampSource(pieces.getLoadedPath(), s)) { DebugLogger::warning("Config cache: cannot stamp " + pieces.getLoadedPath()); return false; }
+        sources.push_back(s);
+    }
+
+    Writer w;
+    for (char c : MAGIC) w.raw(c);
+    w.raw(VERSION);
+    w.raw(layoutFingerprint());
+    w.str(envOrEmpty("DROPBLOCKS_CFG"));
+    w.str(envOrEmpty("DROPBLOCKS_PIECES"));
+    w.str(config.getConfigPaths().empty() ? std::string() : config.getConfigPaths().front());
+    w.str(pieces.getLoadedPath());
+    w.raw((uint32_t)sources.size());
+    for (const Source& s : sources) { w.str(s.path); w.raw(s.size); w.raw(s.mtime); w.raw(s.hash); }
+
+    const VisualConfig& visual = config.getVisual();
+    w.raw(visual.colors); w.raw(visual.effects); w.raw(visual.layout); w.str(visual.titleText); w.str(visual.cellSkin);
+    const AudioConfig& audio = config.getAudio();
+    audioFields(w, audio);
+    w.raw((uint32_t)audio.sfxFiles.size());
+    for (const auto& kv : audio.sfxFiles) { w.str(kv.first); w.str(kv.second); }
+    w.raw((uint32_t)audio.musicFiles.size());
+    for (const auto& kv : audio.musicFiles) { w.raw((int32_t)kv.first); w.str(kv.second); }
+    w.raw(config.getInput());
+    const PiecesConfig& piecesCfg = config.getPieces();
+    piecesFields(w, piecesCfg);
+    w.raw((uint32_t)piecesCfg.pieceColors.size());
+    for (const RGB& c : piecesCfg.pieceColors) w.raw(c);
+    gameFields(w, config.getGame());
+    w.raw(config.getLayout());
+    w.raw(config.getTimer());
+
+    // Peças e opções do arquivo de peças
+    w.raw((int32_t)pieces.getPreviewGrid());
+    w.raw((int32_t)pieces.getRandomizerType());
+    w.raw((int32_t)pieces.getRandBagSize());
+    w.raw((uint32_t)PIECES.size());
+    for (const Piece& p : PIECES) {
+        w.raw((uint32_t)p.rot.size());
+        for (const auto& r : p.rot) w.pairs(r);
+        pieceFields(w, p);
+    }
+
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.good()) { DebugLogger::warning("Config cache: cannot write " + tmp); return false; }
+        out.write(w.data().data(), (std::streamsize)w.data().size());
+        if (!out.good()) { DebugLogger::warning("Config cache: write failed for " + tmp); return false; }
+    }
+    std::remove(path.c_str());  // rename não sobrescreve no Windows
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) { DebugLogger::warning("Config cache: cannot rename " + tmp); return false; }
+    DebugLogger::info("Config cache written: " + path + " (" + std::to_string(w.data().size()) + " bytes, " +
+                      std::to_string(sources.size()) + " source file(s))");
+    return true;
+}
+
+bool load(const std::string& path, ConfigManager& config, PieceManager& pieces) {
+    MappedFile file(path);
+    if (!file.data()) return false;
+    Reader r(file.data(), file.size());
+
+    char magic[4] = {};
+    for (char& c : magic) r.raw(c);
+    uint32_t version = 0, fingerprint = 0;
+    r.raw(version); r.raw(fingerprint);
+    if (!r.ok() || std::memcmp(magic, MAGIC, 4) != 0 || version != VERSION || fingerprint != layoutFingerprint()) {
+        DebugLogger::info("Config cache: " + path + " is from another build, ignoring");
+        return false;
+    }
+
+    // Mesmas escolhas de arquivo e mesmos arquivos
+    std::string envCfg, envPieces, cfgPath, piecesPath;
+    r.str(envCfg); r.str(envPieces); r.str(cfgPath); r.str(piecesPath);
+    std::vector<Source> sources(r.count());
+    for (Source& s : sources) { r.str(s.path); r.raw(s.size); r.raw(s.mtime); r.raw(s.hash); }
+    if (!r.ok()) { DebugLogger::warning("Config cache: " + path + " is truncated"); return false; }
+    if (envCfg != envOrEmpty("DROPBLOCKS_CFG") || envPieces != envOrEmpty("DROPBLOCKS_PIECES") ||
+        firstExisting(ConfigManager::candidatePaths()) != cfgPath) {
+        DebugLogger::info("Config cache: config file selection changed, rebuilding");
+        return false;
+    }
+    for (const Source& s : sources) {
+        if (!sourceUnchanged(s)) { DebugLogger::info("Config cache: " + s.path + " changed, rebuilding"); return false; }
+    }
+
+    // Payload em temporários: só aplica se tudo leu
+    VisualConfig visual;
+    r.raw(visual.colors); r.raw(visual.effects); r.raw(visual.layout); r.str(visual.titleText); r.str(visual.cellSkin);
+    AudioConfig audio;
+    audioFields(r, audio);
+    for (uint32_t n = r.count(), i = 0; i < n && r.ok(); ++i) {
+        std::string k, v; r.str(k); r.str(v);
+        audio.sfxFiles[k] = v;
+    }
+    for (uint32_t n = r.count(), i = 0; i < n && r.ok(); ++i) {
+        int32_t level = 0; std::string v;
+        r.raw(level); r.str(v);
+        audio.musicFiles[level] = v;
+    }
+    InputConfig input;
+    r.raw(input);
+    PiecesConfig piecesCfg;
+    piecesFields(r, piecesCfg);
+    piecesCfg.pieceColors.resize(r.count());
+    for (RGB& c : piecesCfg.pieceColors) r.raw(c);
+    GameConfig game;
+    gameFields(r, game);
+    LayoutConfig layout;
+    r.raw(layout);
+    TimerConfig timer;
+    r.raw(timer);
+
+    int32_t previewGrid = 0, randType = 0, bagSize = 0;
+    r.raw(previewGrid); r.raw(randType); r.raw(bagSize);
+    std::vector<Piece> loaded(r.count());
+    for (Piece& p : loaded) {
+        p.rot.resize(r.count());
+        for (auto& rot : p.rot) r.pairs(rot);
+        pieceFields(r, p);
+        if (!r.ok()) break;
+    }
+    if (!r.ok() || !r.atEnd()) { DebugLogger::warning("Config cache: " + path + " is corrupted, ignoring"); return false; }
+    // Mesmo critério do loader: PIECES_FILE (do próprio cache) decide qual .pieces valeria
+    if (firstExisting(PieceManager::piecesCandidates(piecesCfg.piecesFilePath)) != piecesPath) {
+        DebugLogger::info("Config cache: pieces file selection changed, rebuilding");
+        return false;
+    }
+
+    for (Piece& p : loaded) compilePieceTables(p);
+    config.getVisual() = visual;
+    config.getAudio() = audio;
+    config.getInput() = input;
+    config.getPieces() = piecesCfg;
+    config.getGame() = game;
+    config.getLayout() = layout;
+    config.getTimer() = timer;
+    std::vector<std::string> cfgPaths;
+    if (!cfgPath.empty()) cfgPaths.push_back(cfgPath);
+    config.markLoaded(cfgPaths);
+
+    PIECES.swap(loaded);
+    rebuildPieceTable(PIECES);
+    pieces.setPreviewGrid(previewGrid);
+    pieces.setRandomizerType((RandType)randType);
+    pieces.setRandBagSize(bagSize);
+    pieces.setLoadedPath(piecesPath);
+    DebugLogger::info("Config cache loaded: " + path + " (" + std::to_string(PIECES.size()) + " pieces)");
+    return true;
+}
+
+} // namespace ConfigCache
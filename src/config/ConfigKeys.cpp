@@ -0,0 +1,499 @@
+#include "config/ConfigKeys.hpp"
+#include "app/GameTypes.hpp"
+#include "pieces/PieceRng.hpp"
+#include "DebugLogger.hpp"
+
+#include <SDL2/SDL.h>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+using Cfg = ConfigTargets;
+using Val = std::string_view;   // data() termina em '\0'
+using Handler = bool (*)(Cfg&, Val);
+
+struct KeyDef {
+    std::string_view name;
+    Handler apply;
+};
+
+// ---- Conversões: atoi/atof direto no valor, bool aceita 1/true/on/yes ----
+int toInt(Val v) { return std::atoi(v.data()); }
+float toFloat(Val v) { return (float)std::atof(v.data()); }
+float toVolume(Val v) { float f = toFloat(v); return f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f); }
+
+bool toBool(Val v) {
+    if (v.size() > 4) return false;
+    char s[5] = {};
+    for (size_t i = 0; i < v.size(); ++i) s[i] = (char)std::tolower((unsigned char)v[i]);
+    Val l(s, v.size());
+    return l == "1" || l == "true" || l == "on" || l == "yes";
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// #RRGGBB ou RRGGBB
+bool toColor(Val v, RGB& out) {
+    if (!v.empty() && v[0] == '#') v.remove_prefix(1);
+    if (v.size() != 6) return false;
+    int d[6];
+    for (int i = 0; i < 6; ++i) if ((d[i] = hexDigit(v[i])) < 0) return false;
+    out.r = (unsigned char)(d[0] * 16 + d[1]);
+    out.g = (unsigned char)(d[2] * 16 + d[3]);
+    out.b = (unsigned char)(d[4] * 16 + d[5]);
+    return true;
+}
+
+ScaleMode toScaleMode(Val v) {
+    char s[8] = {};
+    if (v.size() >= sizeof(s)) return ScaleMode::AUTO;
+    for (size_t i = 0; i < v.size(); ++i) s[i] = (char)std::toupper((unsigned char)v[i]);
+    Val u(s, v.size());
+    if (u == "STRETCH") return ScaleMode::STRETCH;
+    if (u == "NATIVE") return ScaleMode::NATIVE;
+    return ScaleMode::AUTO;
+}
+
+// Nomes de tecla do SDL separados por vírgula ("Left,A", "Space"); NONE = sem tecla.
+// Só escreve em out se a lista toda for válida
+bool toKeys(Val v, int (&out)[KEYS_PER_ACTION]) {
+    int keys[KEYS_PER_ACTION] = {};
+    int n = 0;
+    while (!v.empty()) {
+        size_t comma = v.find(',');
+        Val name = v.substr(0, comma);
+        v = comma == Val::npos ? Val() : v.substr(comma + 1);
+        while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+        while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+        if (name.empty()) continue;
+        char buf[32] = {};
+        if (name.size() >= sizeof(buf) || n >= KEYS_PER_ACTION) return false;
+        for (size_t i = 0; i < name.size(); ++i) buf[i] = name[i];
+        if (n == 0 && v.empty() && Val(buf) == "NONE") { keys[n++] = -1; break; }
+        SDL_Scancode sc = SDL_GetScancodeFromName(buf);
+        if (sc == SDL_SCANCODE_UNKNOWN) return false;
+        keys[n++] = (int)sc;
+    }
+    if (n == 0) return false;
+    for (int k = 0; k < KEYS_PER_ACTION; ++k) out[k] = keys[k];
+    return true;
+}
+
+template <KeyAction A> bool keyBinding(Cfg& t, Val v) { return toKeys(v, t.input.keys[(int)A]); }
+
+constexpr KeyDef KEYS[] = {
+    // ---- Visual ----
+    {"BACKGROUND", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.background); }},
+    {"BOARD_EMPTY", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.boardEmpty); }},
+    {"PANEL_FILL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.panelFill); }},
+    {"PANEL_OUTLINE", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.panelOutline); }},
+    {"PANEL_OUTLINE_A", [](Cfg& t, Val v) { t.visual.colors.panelOutlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"BANNER_BG", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.bannerBg); }},
+    {"BANNER_OUTLINE", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.bannerOutline); }},
+    {"BANNER_OUTLINE_A", [](Cfg& t, Val v) { t.visual.colors.bannerOutlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"BANNER_TEXT", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.bannerText); }},
+    {"HUD_LABEL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.hudLabel); }},
+    {"HUD_SCORE", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.hudScore); }},
+    {"HUD_LINES", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.hudLines); }},
+    {"HUD_LEVEL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.hudLevel); }},
+    {"SCORE_FILL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.scoreFill); }},
+    {"SCORE_OUTLINE", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.scoreOutline); }},
+    {"SCORE_OUTLINE_A", [](Cfg& t, Val v) { t.visual.colors.scoreOutlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"NEXT_FILL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.nextFill); }},
+    {"NEXT_OUTLINE", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.nextOutline); }},
+    {"NEXT_OUTLINE_A", [](Cfg& t, Val v) { t.visual.colors.nextOutlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"NEXT_LABEL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.nextLabel); }},
+    {"NEXT_GRID_DARK", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.nextGridDark); }},
+    {"NEXT_GRID_LIGHT", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.nextGridLight); }},
+    {"NEXT_GRID_USE_RGB", [](Cfg& t, Val v) { t.visual.colors.nextGridUseRgb = toBool(v); return true; }},
+    {"OVERLAY_FILL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.overlayFill); }},
+    {"OVERLAY_FILL_A", [](Cfg& t, Val v) { t.visual.colors.overlayFillAlpha = (unsigned char)toInt(v); return true; }},
+    {"OVERLAY_OUTLINE", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.overlayOutline); }},
+    {"OVERLAY_OUTLINE_A", [](Cfg& t, Val v) { t.visual.colors.overlayOutlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"OVERLAY_TOP", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.overlayTop); }},
+    {"OVERLAY_SUB", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.overlaySub); }},
+    {"STATS_FILL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.statsFill); }},
+    {"STATS_OUTLINE", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.statsOutline); }},
+    {"STATS_OUTLINE_A", [](Cfg& t, Val v) { t.visual.colors.statsOutlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"STATS_LABEL", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.statsLabel); }},
+    {"STATS_COUNT", [](Cfg& t, Val v) { return toColor(v, t.visual.colors.statsCount); }},
+    {"ENABLE_BANNER_SWEEP", [](Cfg& t, Val v) { t.visual.effects.bannerSweep = toBool(v); return true; }},
+    {"ENABLE_GLOBAL_SWEEP", [](Cfg& t, Val v) { t.visual.effects.globalSweep = toBool(v); return true; }},
+    {"SWEEP_SPEED_PXPS", [](Cfg& t, Val v) { t.visual.effects.sweepSpeedPxps = toFloat(v); return true; }},
+    {"SWEEP_BAND_H_S", [](Cfg& t, Val v) { t.visual.effects.sweepBandHS = toInt(v); return true; }},
+    {"SWEEP_ALPHA_MAX", [](Cfg& t, Val v) { t.visual.effects.sweepAlphaMax = toInt(v); return true; }},
+    {"SWEEP_SOFTNESS", [](Cfg& t, Val v) { t.visual.effects.sweepSoftness = toFloat(v); return true; }},
+    {"SWEEP_G_SPEED_PXPS", [](Cfg& t, Val v) { t.visual.effects.sweepGSpeedPxps = toFloat(v); return true; }},
+    {"SWEEP_G_BAND_H_PX", [](Cfg& t, Val v) { t.visual.effects.sweepGBandHPx = toInt(v); return true; }},
+    {"SWEEP_G_ALPHA_MAX", [](Cfg& t, Val v) { t.visual.effects.sweepGAlphaMax = toInt(v); return true; }},
+    {"SWEEP_G_SOFTNESS", [](Cfg& t, Val v) { t.visual.effects.sweepGSoftness = toFloat(v); return true; }},
+    {"SCANLINE_ALPHA", [](Cfg& t, Val v) { t.visual.effects.scanlineAlpha = toInt(v); return true; }},
+    {"CRT_SHADER", [](Cfg& t, Val v) { t.visual.effects.crtShader = toBool(v); return true; }},
+    {"CRT_CURVATURE", [](Cfg& t, Val v) { float f = toFloat(v); if (f < 0.0f || f > 1.0f) return false; t.visual.effects.crtCurvature = f; return true; }},
+    {"CRT_VIGNETTE", [](Cfg& t, Val v) { float f = toFloat(v); if (f < 0.0f || f > 1.0f) return false; t.visual.effects.crtVignette = f; return true; }},
+    {"CRT_GLOW", [](Cfg& t, Val v) { float f = toFloat(v); if (f < 0.0f || f > 1.0f) return false; t.visual.effects.crtGlow = f; return true; }},
+    {"PARTICLE_CAPACITY", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 65536) return false; t.visual.effects.particleCapacity = n; return true; }},
+    {"PARTICLE_DENSITY", [](Cfg& t, Val v) { float f = toFloat(v); if (f < 0.0f || f > 4.0f) return false; t.visual.effects.particleDensity = f; return true; }},
+    {"ROUNDED_PANELS", [](Cfg& t, Val v) { t.visual.layout.roundedPanels = toInt(v); return true; }},
+    {"CELL_SKIN", [](Cfg& t, Val v) {
+        std::string s(v);
+        std::string lower = s; for (char& c : lower) c = (char)std::tolower((unsigned char)c);
+        t.visual.cellSkin = (lower == "flat" || lower == "bevel" || lower == "gloss") ? lower : s;
+        return !s.empty(); }},
+    {"CACHED_PANELS", [](Cfg& t, Val v) { t.visual.layout.cachedPanels = toInt(v); return true; }},
+    {"CACHED_LAYERS", [](Cfg& t, Val v) { t.visual.layout.cachedLayers = toInt(v); return true; }},
+    {"HUD_FIXED_SCALE", [](Cfg& t, Val v) { t.visual.layout.hudFixedScale = toInt(v); return true; }},
+    {"TITLE_TEXT", [](Cfg& t, Val v) { t.visual.titleText = std::string(v); return true; }},
+
+    // ---- Audio ----
+    {"AUDIO_MASTER_VOLUME", [](Cfg& t, Val v) { t.audio.masterVolume = toVolume(v); return true; }},
+    {"AUDIO_SFX_VOLUME", [](Cfg& t, Val v) { t.audio.sfxVolume = toVolume(v); return true; }},
+    {"AUDIO_AMBIENT_VOLUME", [](Cfg& t, Val v) { t.audio.ambientVolume = toVolume(v); return true; }},
+    {"AUDIO_MUSIC_VOLUME", [](Cfg& t, Val v) { t.audio.musicVolume = toVolume(v); return true; }},
+    {"MUSIC_CROSSFADE_MS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 10000) return false; t.audio.musicCrossfadeMs = n; return true; }},
+    {"ENABLE_MOVEMENT_SOUNDS", [](Cfg& t, Val v) { t.audio.enableMovementSounds = toBool(v); return true; }},
+    {"ENABLE_AMBIENT_SOUNDS", [](Cfg& t, Val v) { t.audio.enableAmbientSounds = toBool(v); return true; }},
+    {"ENABLE_COMBO_SOUNDS", [](Cfg& t, Val v) { t.audio.enableComboSounds = toBool(v); return true; }},
+    {"ENABLE_LEVEL_UP_SOUNDS", [](Cfg& t, Val v) { t.audio.enableLevelUpSounds = toBool(v); return true; }},
+
+    // ---- Input ----
+    {"KEY_LEFT", &keyBinding<KeyAction::LEFT>},
+    {"KEY_RIGHT", &keyBinding<KeyAction::RIGHT>},
+    {"KEY_SOFT_DROP", &keyBinding<KeyAction::SOFT_DROP>},
+    {"KEY_HARD_DROP", &keyBinding<KeyAction::HARD_DROP>},
+    {"KEY_ROTATE_CCW", &keyBinding<KeyAction::ROTATE_CCW>},
+    {"KEY_ROTATE_CW", &keyBinding<KeyAction::ROTATE_CW>},
+    {"KEY_PAUSE", &keyBinding<KeyAction::PAUSE>},
+    {"KEY_RESTART", &keyBinding<KeyAction::RESTART>},
+    {"KEY_FORCE_RESTART", &keyBinding<KeyAction::FORCE_RESTART>},
+    {"KEY_QUIT", &keyBinding<KeyAction::QUIT>},
+    {"KEY_SCREENSHOT", &keyBinding<KeyAction::SCREENSHOT>},
+    {"KEY_DEBUG", &keyBinding<KeyAction::DEBUG>},
+    {"KEY_TIMER", &keyBinding<KeyAction::TIMER>},
+    {"KEY_THEME", &keyBinding<KeyAction::THEME>},
+    {"KEY_REWIND", &keyBinding<KeyAction::REWIND>},
+    {"KEY_TRACE", &keyBinding<KeyAction::TRACE>},
+    {"JOYSTICK_BUTTON_LEFT", [](Cfg& t, Val v) { t.input.buttonLeft = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_RIGHT", [](Cfg& t, Val v) { t.input.buttonRight = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_DOWN", [](Cfg& t, Val v) { t.input.buttonDown = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_UP", [](Cfg& t, Val v) { t.input.buttonUp = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_ROTATE_CCW", [](Cfg& t, Val v) { t.input.buttonRotateCCW = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_ROTATE_CW", [](Cfg& t, Val v) { t.input.buttonRotateCW = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_SOFT_DROP", [](Cfg& t, Val v) { t.input.buttonSoftDrop = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_HARD_DROP", [](Cfg& t, Val v) { t.input.buttonHardDrop = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_PAUSE", [](Cfg& t, Val v) { t.input.buttonPause = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_START", [](Cfg& t, Val v) { t.input.buttonStart = toInt(v); return true; }},
+    {"JOYSTICK_BUTTON_QUIT", [](Cfg& t, Val v) { t.input.buttonQuit = toInt(v); return true; }},
+    {"JOYSTICK_ANALOG_DEADZONE", [](Cfg& t, Val v) { t.input.analogDeadzone = toFloat(v); return true; }},
+    {"JOYSTICK_ANALOG_SENSITIVITY", [](Cfg& t, Val v) { t.input.analogSensitivity = toFloat(v); return true; }},
+    {"JOYSTICK_INVERT_Y_AXIS", [](Cfg& t, Val v) { t.input.invertYAxis = toBool(v); return true; }},
+    {"JOYSTICK_MOVE_REPEAT_DELAY_DAS", [](Cfg& t, Val v) { t.input.moveRepeatDelayDAS = (unsigned int)toInt(v); return true; }},
+    {"JOYSTICK_MOVE_REPEAT_DELAY_ARR", [](Cfg& t, Val v) { t.input.moveRepeatDelayARR = (unsigned int)toInt(v); return true; }},
+    {"JOYSTICK_MOVE_REPEAT_DELAY", [](Cfg& t, Val v) { t.input.moveRepeatDelayDAS = (unsigned int)toInt(v); return true; }},
+    {"JOYSTICK_SOFT_DROP_REPEAT_DELAY", [](Cfg& t, Val v) { t.input.softDropRepeatDelay = (unsigned int)toInt(v); return true; }},
+    {"JOYSTICK_SOFT_DROP_DELAY", [](Cfg& t, Val v) { t.input.softDropRepeatDelay = (unsigned int)toInt(v); return true; }},
+
+    // ---- Pieces ----
+    {"PIECES_FILE", [](Cfg& t, Val v) { t.pieces.piecesFilePath = std::string(v); return true; }},
+    {"PREVIEW_GRID", [](Cfg& t, Val v) { t.pieces.previewGrid = toInt(v); return true; }},
+    {"RAND_TYPE", [](Cfg& t, Val v) { t.pieces.randomizerType = std::string(v); return true; }},
+    {"RAND_BAG_SIZE", [](Cfg& t, Val v) { t.pieces.randBagSize = toInt(v); return true; }},
+    {"RAND_RNG", [](Cfg& t, Val v) { RngType type; if (!PieceRng::parseType(std::string(v), type)) return false; t.pieces.rngType = PieceRng::typeName(type); return true; }},
+    {"RAND_SEED", [](Cfg& t, Val v) { t.pieces.rngSeed = (unsigned)std::strtoul(v.data(), nullptr, 0); return true; }},
+
+    // ---- Game ----
+    {"TICK_MS_START", [](Cfg& t, Val v) { t.game.tickMsStart = toInt(v); return true; }},
+    {"GAME_SPEED_START_MS", [](Cfg& t, Val v) { t.game.tickMsStart = toInt(v); return true; }},
+    {"TICK_MS_MIN", [](Cfg& t, Val v) { t.game.tickMsMin = toInt(v); return true; }},
+    {"GAME_SPEED_MIN_MS", [](Cfg& t, Val v) { t.game.tickMsMin = toInt(v); return true; }},
+    {"SPEED_ACCELERATION", [](Cfg& t, Val v) { t.game.speedAcceleration = toInt(v); return true; }},
+    {"GAME_SPEED_ACCELERATION", [](Cfg& t, Val v) { t.game.speedAcceleration = toInt(v); return true; }},
+    {"LEVEL_STEP", [](Cfg& t, Val v) { t.game.levelStep = toInt(v); return true; }},
+    {"BOARD_COLS", [](Cfg& t, Val v) { int n = toInt(v); if (n < MIN_BOARD_COLS || n > MAX_BOARD_COLS) return false; t.game.boardCols = n; return true; }},
+    {"BOARD_ROWS", [](Cfg& t, Val v) { int n = toInt(v); if (n < MIN_BOARD_ROWS || n > MAX_BOARD_ROWS) return false; t.game.boardRows = n; return true; }},
+    {"FRAME_PACING", [](Cfg& t, Val v) { t.game.framePacing = std::string(v); return true; }},
+    {"RENDER_DRIVER", [](Cfg& t, Val v) { t.game.renderDriver = std::string(v); return true; }},
+    {"RENDER_PROBE_FILE", [](Cfg& t, Val v) { t.game.renderProbeFile = std::string(v); return true; }},
+    {"TARGET_FPS", [](Cfg& t, Val v) { t.game.targetFps = toInt(v); return true; }},
+    {"SIM_STEP_MS", [](Cfg& t, Val v) { t.game.simStepMs = toInt(v); return true; }},
+    {"THREADED_MODE", [](Cfg& t, Val v) { t.game.threadedMode = toBool(v); return true; }},
+    {"INPUT_THREAD", [](Cfg& t, Val v) { t.game.inputThread = toBool(v); return true; }},
+    {"SPLIT_PLAYERS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 1 || n > 4) return false; t.game.splitPlayers = n; return true; }},
+    {"SPLIT_BOTS", [](Cfg& t, Val v) { t.game.splitBots = toBool(v); return true; }},
+    {"SPLIT_PARALLEL", [](Cfg& t, Val v) { t.game.splitParallel = toBool(v); return true; }},
+    {"NET_PEER", [](Cfg& t, Val v) { t.game.netPeer = std::string(v); return true; }},
+    {"NET_PORT", [](Cfg& t, Val v) { int n = toInt(v); if (n < 1 || n > 65535) return false; t.game.netPort = n; return true; }},
+    {"NET_CHECKSUM_TICKS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0) return false; t.game.netChecksumTicks = n; return true; }},
+    {"NET_GARBAGE", [](Cfg& t, Val v) { t.game.netGarbage = toBool(v); return true; }},
+    {"SPECTATE_PORT", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 65535) return false; t.game.spectatePort = n; return true; }},
+    {"SPECTATE_SOURCE", [](Cfg& t, Val v) { t.game.spectateSource = std::string(v); return true; }},
+    {"SPECTATE_BUFFER_MS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 5000) return false; t.game.spectateBufferMs = n; return true; }},
+    {"PROFILE_CSV", [](Cfg& t, Val v) { t.game.profileCsv = std::string(v); return true; }},
+    {"LATENCY_PROBE", [](Cfg& t, Val v) { t.game.latencyProbe = toBool(v); return true; }},
+    {"TRACE_SECONDS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 600) return false; t.game.traceSeconds = n; return true; }},
+    {"TRACE_FILE", [](Cfg& t, Val v) { t.game.traceFile = std::string(v); return true; }},
+    {"QUALITY_GOVERNOR", [](Cfg& t, Val v) { t.game.qualityGovernor = toBool(v); return true; }},
+    {"QUALITY_BUDGET_MS", [](Cfg& t, Val v) { float ms = toFloat(v); if (ms < 0.0f || ms > 100.0f) return false; t.game.qualityBudgetMs = ms; return true; }},
+    {"TEXTURE_BUDGET_MB", [](Cfg& t, Val v) { int mb = toInt(v); if (mb < 0 || mb > 4096) return false; t.game.textureBudgetMb = mb; return true; }},
+    {"CAPTURE_VIDEO", [](Cfg& t, Val v) { t.game.captureVideo = std::string(v); return true; }},
+    {"CAPTURE_FPS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 240) return false; t.game.captureFps = n; return true; }},
+    {"CAPTURE_DELAY_FRAMES", [](Cfg& t, Val v) { int n = toInt(v); if (n < 1 || n > 8) return false; t.game.captureDelayFrames = n; return true; }},
+    {"CAPTURE_BUDGET_MB", [](Cfg& t, Val v) { int n = toInt(v); if (n < 16 || n > 4096) return false; t.game.captureBudgetMb = n; return true; }},
+    {"REPLAY_RECORD_DIR", [](Cfg& t, Val v) { t.game.replayRecordDir = std::string(v); return true; }},
+    {"SESSION_LOG", [](Cfg& t, Val v) { t.game.sessionLog = std::string(v); return true; }},
+    {"HIGH_SCORE_COUNT", [](Cfg& t, Val v) { int n = toInt(v); if (n < 1 || n > 50) return false; t.game.highScoreCount = n; return true; }},
+    {"SESSION_FSYNC_MS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 60000) return false; t.game.sessionFsyncMs = n; return true; }},
+    {"PRACTICE_MODE", [](Cfg& t, Val v) { t.game.practiceMode = toBool(v); return true; }},
+    {"REWIND_SLOTS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 2 || n > 4096) return false; t.game.rewindSlots = n; return true; }},
+    {"REWIND_INTERVAL_TICKS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 100000) return false; t.game.rewindIntervalTicks = n; return true; }},
+    {"RESUME_FILE", [](Cfg& t, Val v) { t.game.resumeFile = std::string(v); return true; }},
+    {"RESUME_SAVE_MS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 600000) return false; t.game.resumeSaveMs = n; return true; }},
+    {"REPLAY_FILE", [](Cfg& t, Val v) { t.game.replayFile = std::string(v); return true; }},
+    {"REPLAY_SPEED", [](Cfg& t, Val v) { t.game.replaySpeed = std::string(v); for (char& c : t.game.replaySpeed) c = (char)std::toupper((unsigned char)c); return true; }},
+    {"BOT_ENABLED", [](Cfg& t, Val v) { t.game.botEnabled = toBool(v); return true; }},
+    {"BOT_THREADS", [](Cfg& t, Val v) { t.game.botThreads = toInt(v); return true; }},
+    {"BOT_BUDGET_MS", [](Cfg& t, Val v) { t.game.botBudgetMs = toInt(v); return true; }},
+    {"BOT_LOOKAHEAD", [](Cfg& t, Val v) { t.game.botLookahead = toBool(v); return true; }},
+    {"BOT_ACTION_DELAY_MS", [](Cfg& t, Val v) { t.game.botActionDelayMs = toInt(v); return true; }},
+    {"BOT_WEIGHT_HEIGHT", [](Cfg& t, Val v) { t.game.botWeightHeight = toFloat(v); return true; }},
+    {"BOT_WEIGHT_LINES", [](Cfg& t, Val v) { t.game.botWeightLines = toFloat(v); return true; }},
+    {"BOT_WEIGHT_HOLES", [](Cfg& t, Val v) { t.game.botWeightHoles = toFloat(v); return true; }},
+    {"BOT_WEIGHT_BUMPINESS", [](Cfg& t, Val v) { t.game.botWeightBumpiness = toFloat(v); return true; }},
+    {"ATTRACT_IDLE_SECONDS", [](Cfg& t, Val v) { t.game.attractIdleSeconds = toInt(v); return true; }},
+    {"ATTRACT_FPS", [](Cfg& t, Val v) { t.game.attractFps = toInt(v); return true; }},
+    {"ATTRACT_ACTION_DELAY_MS", [](Cfg& t, Val v) { t.game.attractActionDelayMs = toInt(v); return true; }},
+    {"ATTRACT_BOT_THREADS", [](Cfg& t, Val v) { t.game.attractBotThreads = toInt(v); return true; }},
+    {"ATTRACT_BOT_BUDGET_MS", [](Cfg& t, Val v) { t.game.attractBotBudgetMs = toInt(v); return true; }},
+    {"ATTRACT_LOOKAHEAD", [](Cfg& t, Val v) { t.game.attractLookahead = toBool(v); return true; }},
+    {"THEME_FILES", [](Cfg& t, Val v) { t.game.themeFiles = std::string(v); return true; }},
+    {"THEME_ATTRACT_SECONDS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 0 || n > 3600) return false; t.game.themeAttractSeconds = n; return true; }},
+    {"IDLE_RENDER", [](Cfg& t, Val v) { t.game.idleRender = toBool(v); return true; }},
+    {"IDLE_WAIT_MS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 1 || n > 1000) return false; t.game.idleWaitMs = n; return true; }},
+    {"FRAME_ARENA_KB", [](Cfg& t, Val v) { int n = toInt(v); if (n < 4 || n > 65536) return false; t.game.frameArenaKb = n; return true; }},
+    {"MARQUEE_DISPLAY", [](Cfg& t, Val v) { int n = toInt(v); if (n < -1 || n > 15) return false; t.game.marqueeDisplay = n; return true; }},
+    {"MARQUEE_FPS", [](Cfg& t, Val v) { int n = toInt(v); if (n < 1 || n > 60) return false; t.game.marqueeFps = n; return true; }},
+    {"CONFIG_WATCH_MS", [](Cfg& t, Val v) { t.game.configWatchMs = toInt(v); return true; }},
+    {"LOG_LEVEL", [](Cfg& t, Val v) {
+        std::string name(v); for (char& c : name) c = (char)std::toupper((unsigned char)c);
+        int level; if (!DebugLogger::parseLevel(name, level)) return false;
+        t.game.logLevel = name; return true; }},
+    {"LOG_FILE", [](Cfg& t, Val v) { t.game.logFile = std::string(v); return true; }},
+    {"LOG_FILE_MAX_KB", [](Cfg& t, Val v) { t.game.logFileMaxKb = toInt(v); return true; }},
+    {"LOG_FILE_KEEP", [](Cfg& t, Val v) { t.game.logFileKeep = toInt(v); return true; }},
+    {"METRICS_TARGET", [](Cfg& t, Val v) { t.game.metricsTarget = std::string(v); return true; }},
+    {"METRICS_PREFIX", [](Cfg& t, Val v) { t.game.metricsPrefix = std::string(v); return !v.empty(); }},
+    {"METRICS_INTERVAL_MS", [](Cfg& t, Val v) { t.game.metricsIntervalMs = toInt(v); return true; }},
+    {"METRICS_FILE_MAX_KB", [](Cfg& t, Val v) { t.game.metricsFileMaxKb = toInt(v); return true; }},
+
+    // ---- Layout ----
+    {"LAYOUT_VIRTUAL_WIDTH", [](Cfg& t, Val v) { t.layout.virtualWidth = toInt(v); return true; }},
+    {"LAYOUT_VIRTUAL_HEIGHT", [](Cfg& t, Val v) { t.layout.virtualHeight = toInt(v); return true; }},
+    {"LAYOUT_SCALE_MODE", [](Cfg& t, Val v) { t.layout.scaleMode = toScaleMode(v); return true; }},
+    {"LAYOUT_OFFSET_X", [](Cfg& t, Val v) { t.layout.offsetX = toInt(v); return true; }},
+    {"LAYOUT_OFFSET_Y", [](Cfg& t, Val v) { t.layout.offsetY = toInt(v); return true; }},
+    {"PANEL_BORDER_RADIUS", [](Cfg& t, Val v) { t.layout.borderRadius = toInt(v); return true; }},
+    {"PANEL_BORDER_THICKNESS", [](Cfg& t, Val v) { t.layout.borderThickness = toInt(v); return true; }},
+    {"BANNER_X", [](Cfg& t, Val v) { t.layout.banner.x = toInt(v); return true; }},
+    {"BANNER_Y", [](Cfg& t, Val v) { t.layout.banner.y = toInt(v); return true; }},
+    {"BANNER_WIDTH", [](Cfg& t, Val v) { t.layout.banner.width = toInt(v); return true; }},
+    {"BANNER_HEIGHT", [](Cfg& t, Val v) { t.layout.banner.height = toInt(v); return true; }},
+    {"BANNER_BG_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.banner.backgroundColor); }},
+    {"BANNER_OUTLINE_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.banner.outlineColor); }},
+    {"BANNER_TEXT_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.banner.textColor); }},
+    {"BANNER_BG_ALPHA", [](Cfg& t, Val v) { t.layout.banner.backgroundAlpha = (unsigned char)toInt(v); return true; }},
+    {"BANNER_OUTLINE_ALPHA", [](Cfg& t, Val v) { t.layout.banner.outlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"BANNER_ENABLED", [](Cfg& t, Val v) { t.layout.banner.enabled = (toInt(v) != 0); return true; }},
+    {"STATS_X", [](Cfg& t, Val v) { t.layout.stats.x = toInt(v); return true; }},
+    {"STATS_Y", [](Cfg& t, Val v) { t.layout.stats.y = toInt(v); return true; }},
+    {"STATS_WIDTH", [](Cfg& t, Val v) { t.layout.stats.width = toInt(v); return true; }},
+    {"STATS_HEIGHT", [](Cfg& t, Val v) { t.layout.stats.height = toInt(v); return true; }},
+    {"STATS_BG_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.stats.backgroundColor); }},
+    {"STATS_OUTLINE_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.stats.outlineColor); }},
+    {"STATS_TEXT_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.stats.textColor); }},
+    {"STATS_BG_ALPHA", [](Cfg& t, Val v) { t.layout.stats.backgroundAlpha = (unsigned char)toInt(v); return true; }},
+    {"STATS_OUTLINE_ALPHA", [](Cfg& t, Val v) { t.layout.stats.outlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"STATS_ENABLED", [](Cfg& t, Val v) { t.layout.stats.enabled = (toInt(v) != 0); return true; }},
+    {"BOARD_X", [](Cfg& t, Val v) { t.layout.board.x = toInt(v); return true; }},
+    {"BOARD_Y", [](Cfg& t, Val v) { t.layout.board.y = toInt(v); return true; }},
+    {"BOARD_WIDTH", [](Cfg& t, Val v) { t.layout.board.width = toInt(v); return true; }},
+    {"BOARD_HEIGHT", [](Cfg& t, Val v) { t.layout.board.height = toInt(v); return true; }},
+    {"BOARD_ENABLED", [](Cfg& t, Val v) { t.layout.board.enabled = (toInt(v) != 0); return true; }},
+    {"HUD_X", [](Cfg& t, Val v) { t.layout.hud.x = toInt(v); return true; }},
+    {"HUD_Y", [](Cfg& t, Val v) { t.layout.hud.y = toInt(v); return true; }},
+    {"HUD_WIDTH", [](Cfg& t, Val v) { t.layout.hud.width = toInt(v); return true; }},
+    {"HUD_HEIGHT", [](Cfg& t, Val v) { t.layout.hud.height = toInt(v); return true; }},
+    {"HUD_BG_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.hud.backgroundColor); }},
+    {"HUD_OUTLINE_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.hud.outlineColor); }},
+    {"HUD_TEXT_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.hud.textColor); }},
+    {"HUD_BG_ALPHA", [](Cfg& t, Val v) { t.layout.hud.backgroundAlpha = (unsigned char)toInt(v); return true; }},
+    {"HUD_OUTLINE_ALPHA", [](Cfg& t, Val v) { t.layout.hud.outlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"HUD_ENABLED", [](Cfg& t, Val v) { t.layout.hud.enabled = (toInt(v) != 0); return true; }},
+    {"NEXT_X", [](Cfg& t, Val v) { t.layout.next.x = toInt(v); return true; }},
+    {"NEXT_Y", [](Cfg& t, Val v) { t.layout.next.y = toInt(v); return true; }},
+    {"NEXT_WIDTH", [](Cfg& t, Val v) { t.layout.next.width = toInt(v); return true; }},
+    {"NEXT_HEIGHT", [](Cfg& t, Val v) { t.layout.next.height = toInt(v); return true; }},
+    {"NEXT_BG_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.next.backgroundColor); }},
+    {"NEXT_OUTLINE_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.next.outlineColor); }},
+    {"NEXT_TEXT_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.next.textColor); }},
+    {"NEXT_BG_ALPHA", [](Cfg& t, Val v) { t.layout.next.backgroundAlpha = (unsigned char)toInt(v); return true; }},
+    {"NEXT_OUTLINE_ALPHA", [](Cfg& t, Val v) { t.layout.next.outlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"NEXT_ENABLED", [](Cfg& t, Val v) { t.layout.next.enabled = (toInt(v) != 0); return true; }},
+    {"NEXT_COUNT", [](Cfg& t, Val v) { int n = toInt(v); if (n < 1 || n > 6) return false; t.layout.nextCount = n; return true; }},
+    {"SCORE_X", [](Cfg& t, Val v) { t.layout.score.x = toInt(v); return true; }},
+    {"SCORE_Y", [](Cfg& t, Val v) { t.layout.score.y = toInt(v); return true; }},
+    {"SCORE_WIDTH", [](Cfg& t, Val v) { t.layout.score.width = toInt(v); return true; }},
+    {"SCORE_HEIGHT", [](Cfg& t, Val v) { t.layout.score.height = toInt(v); return true; }},
+    {"SCORE_BG_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.score.backgroundColor); }},
+    {"SCORE_OUTLINE_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.score.outlineColor); }},
+    {"SCORE_TEXT_COLOR", [](Cfg& t, Val v) { return toColor(v, t.layout.score.textColor); }},
+    {"SCORE_BG_ALPHA", [](Cfg& t, Val v) { t.layout.score.backgroundAlpha = (unsigned char)toInt(v); return true; }},
+    {"SCORE_OUTLINE_ALPHA", [](Cfg& t, Val v) { t.layout.score.outlineAlpha = (unsigned char)toInt(v); return true; }},
+    {"SCORE_ENABLED", [](Cfg& t, Val v) { t.layout.score.enabled = (toInt(v) != 0); return true; }},
+
+    // ---- Timer ----
+    {"TIMER_ENABLED", [](Cfg& t, Val v) { t.timer.enabled = toBool(v); return true; }},
+    {"TIMER_DURATION_SECONDS", [](Cfg& t, Val v) { int s = toInt(v); if (s <= 0 || s > 7200) return false; t.timer.durationSeconds = s; return true; }},
+    {"TIMER_SHOW_WARNING_AT_30S", [](Cfg& t, Val v) { t.timer.showWarningAt30s = toBool(v); return true; }},
+    {"TIMER_SHOW_WARNING_AT_10S", [](Cfg& t, Val v) { t.timer.showWarningAt10s = toBool(v); return true; }},
+    {"TIMER_X", [](Cfg& t, Val v) { t.timer.layout.x = toInt(v); return true; }},
+    {"TIMER_Y", [](Cfg& t, Val v) { t.timer.layout.y = toInt(v); return true; }},
+    {"TIMER_WIDTH", [](Cfg& t, Val v) { t.timer.layout.width = toInt(v); return true; }},
+    {"TIMER_HEIGHT", [](Cfg& t, Val v) { t.timer.layout.height = toInt(v); return true; }},
+    {"TIMER_FILL", [](Cfg& t, Val v) { return toColor(v, t.timer.layout.backgroundColor); }},
+    {"TIMER_TEXT_COLOR", [](Cfg& t, Val v) { return toColor(v, t.timer.normalColor); }},
+    {"TIMER_WARNING_COLOR", [](Cfg& t, Val v) { return toColor(v, t.timer.warningColor); }},
+    {"TIMER_CRITICAL_COLOR", [](Cfg& t, Val v) { return toColor(v, t.timer.criticalColor); }},
+    {"TIMER_PROGRESS_BG", [](Cfg& t, Val v) { return toColor(v, t.timer.progressBarBg); }},
+    {"TIMER_PROGRESS_BORDER", [](Cfg& t, Val v) { return toColor(v, t.timer.progressBarBorder); }},
+    {"TIMER_BG_ALPHA", [](Cfg& t, Val v) { int a = toInt(v); if (a < 0 || a > 255) return false; t.timer.layout.backgroundAlpha = (unsigned char)a; return true; }},
+    {"TIMER_LAYOUT_ENABLED", [](Cfg& t, Val v) { t.timer.layout.enabled = toBool(v); return true; }},
+};
+
+constexpr size_t KEY_COUNT = sizeof(KEYS) / sizeof(KEYS[0]);
+
+// ---- Hash perfeito (hash-and-displace), montado pelo compilador ----
+// Uma passada pela chave: a metade baixa escolhe o bucket, a alta (misturada
+// com o seed do bucket) escolhe o slot
+constexpr uint64_t hashKey(std::string_view s) {
+    uint64_t h = 14695981039346656037ull;
+    for (char c : s) { h ^= (uint8_t)c; h *= 1099511628211ull; }
+    return h;
+}
+
+constexpr uint32_t slotHash(uint64_t h, uint32_t seed) {
+    uint32_t x = (uint32_t)(h >> 32) ^ (seed * 0x9E3779B9u);
+    x ^= x >> 16; x *= 0x7feb352du; x ^= x >> 15;
+    return x;
+}
+
+constexpr size_t nextPow2(size_t n) { size_t p = 1; while (p < n) p <<= 1; return p; }
+constexpr size_t SLOTS = nextPow2(KEY_COUNT * 2);        // carga <= 50%
+constexpr size_t BUCKETS = nextPow2(KEY_COUNT / 4 + 1);  // ~4 chaves por bucket
+
+struct PerfectHash {
+    uint16_t seed[BUCKETS] = {};   // seed do bucket para slotHash
+    int16_t slot[SLOTS] = {};      // índice em KEYS ou -1
+    bool ok = true;
+};
+
+constexpr bool uniqueNames() {
+    for (size_t i = 0; i < KEY_COUNT; ++i)
+        for (size_t j = i + 1; j < KEY_COUNT; ++j)
+            if (KEYS[i].name == KEYS[j].name) return false;
+    return true;
+}
+
+constexpr PerfectHash buildHash() {
+    PerfectHash t;
+    for (size_t s = 0; s < SLOTS; ++s) t.slot[s] = -1;
+
+    // Chaves agrupadas por bucket (counting sort)
+    size_t bucketOf[KEY_COUNT] = {};
+    size_t bucketSize[BUCKETS] = {};
+    size_t bucketStart[BUCKETS + 1] = {};
+    size_t members[KEY_COUNT] = {};
+    for (size_t k = 0; k < KEY_COUNT; ++k) {
+        bucketOf[k] = (size_t)hashKey(KEYS[k].name) & (BUCKETS - 1);
+        bucketSize[bucketOf[k]]++;
+    }
+    size_t maxSize = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        bucketStart[b + 1] = bucketStart[b] + bucketSize[b];
+        if (bucketSize[b] > maxSize) maxSize = bucketSize[b];
+    }
+    size_t fill[BUCKETS] = {};
+    for (size_t k = 0; k < KEY_COUNT; ++k) members[bucketStart[bucketOf[k]] + fill[bucketOf[k]]++] = k;
+
+    // Buckets maiores primeiro: cada um procura um seed que caia só em slots livres
+    for (size_t size = maxSize; size > 0; --size) {
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            if (bucketSize[b] != size) continue;
+            bool placed = false;
+            for (uint32_t seed = 1; seed < 65536 && !placed; ++seed) {
+                size_t pos[KEY_COUNT] = {};
+                bool fits = true;
+                for (size_t m = 0; m < size && fits; ++m) {
+                    pos[m] = slotHash(hashKey(KEYS[members[bucketStart[b] + m]].name), seed) & (SLOTS - 1);
+                    if (t.slot[pos[m]] >= 0) fits = false;
+                    for (size_t o = 0; o < m && fits; ++o) if (pos[o] == pos[m]) fits = false;
+                }
+                if (!fits) continue;
+                for (size_t m = 0; m < size; ++m) t.slot[pos[m]] = (int16_t)members[bucketStart[b] + m];
+                t.seed[b] = (uint16_t)seed;
+                placed = true;
+            }
+            if (!placed) t.ok = false;
+        }
+    }
+    return t;
+}
+
+static_assert(uniqueNames(), "config key declared twice");
+constexpr PerfectHash TABLE = buildHash();
+static_assert(TABLE.ok, "no perfect hash seed found for the config keys");
+
+const KeyDef* findKey(std::string_view key) {
+    uint64_t h = hashKey(key);
+    int idx = TABLE.slot[slotHash(h, TABLE.seed[h & (BUCKETS - 1)]) & (SLOTS - 1)];
+    return (idx >= 0 && KEYS[idx].name == key) ? &KEYS[idx] : nullptr;
+}
+
+// PIECE<n>=#RRGGBB
+bool applyPieceColor(Cfg& t, std::string_view key, Val v) {
+    key.remove_prefix(5);
+    if (key.empty() || key.size() > 4) return false;
+    int index = 0;
+    for (char c : key) { if (c < '0' || c > '9') return false; index = index * 10 + (c - '0'); }
+    RGB color;
+    if (!toColor(v, color)) return false;
+    if (index >= (int)t.pieces.pieceColors.size()) t.pieces.pieceColors.resize(index + 1, RGB{200, 200, 200});
+    t.pieces.pieceColors[index] = color;
+    return true;
+}
+
+} // namespace
+
+namespace ConfigKeys {
+
+Result apply(ConfigTargets& targets, std::string_view key, std::string_view value) {
+    if (const KeyDef* def = findKey(key)) return def->apply(targets, value) ? Result::APPLIED : Result::INVALID_VALUE;
+
+    if (key.size() > 5 && key.compare(0, 5, "PIECE") == 0 && key[5] >= '0' && key[5] <= '9') {
+        return applyPieceColor(targets, key, value) ? Result::APPLIED : Result::INVALID_VALUE;
+    }
+    if (targets.audio.loadSfxFile(std::string(key), std::string(value))) return Result::APPLIED;
+    if (targets.audio.loadMusicFile(std::string(key), std::string(value))) return Result::APPLIED;
+    return Result::UNKNOWN_KEY;
+}
+
+size_t count() { return KEY_COUNT; }
+
+} // namespace ConfigKeys
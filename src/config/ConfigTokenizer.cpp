@@ -0,0 +1,57 @@
+#include "config/ConfigTokenizer.hpp"
+
+#include <cstring>
+
+namespace {
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; }
+
+struct SpecialChars {
+    bool table[256] = {};
+    constexpr SpecialChars() { table[(unsigned char)';'] = table[(unsigned char)'#'] = table[(unsigned char)'='] = true; }
+    constexpr bool operator[](unsigned char c) const { return table[c]; }
+};
+constexpr SpecialChars SPECIAL;
+}
+
+bool ConfigTokenizer::next(ConfigEntry& out) {
+    while (p_ < end_) {
+        char* line = p_;
+        char* eol = static_cast<char*>(std::memchr(p_, '\n', (size_t)(end_ - p_)));
+        if (!eol) eol = end_;
+        p_ = eol + 1;
+        line_++;
+
+        // Fim útil: ';' ou '#' no início/depois de espaço; '=' é o primeiro da linha
+        char* stop = line;
+        char* eq = nullptr;
+        for (; stop < eol; ++stop) {
+            if (!SPECIAL[(unsigned char)*stop]) continue;  // Quase todo caractere cai aqui
+            char c = *stop;
+            if (c == ';') break;
+            if (c == '#' && (stop == line || isBlank(stop[-1]))) break;
+            if (c == '=' && !eq) eq = stop;
+        }
+        if (!eq) continue;
+
+        char* keyBegin = line;
+        char* keyEnd = eq;
+        while (keyBegin < keyEnd && isBlank(*keyBegin)) keyBegin++;
+        while (keyEnd > keyBegin && isBlank(keyEnd[-1])) keyEnd--;
+        if (keyBegin == keyEnd) continue;
+        for (char* c = keyBegin; c < keyEnd; ++c) {
+            if (*c >= 'a' && *c <= 'z') *c = (char)(*c - 'a' + 'A');
+        }
+
+        char* valBegin = eq + 1;
+        char* valEnd = stop;
+        while (valBegin < valEnd && isBlank(*valBegin)) valBegin++;
+        while (valEnd > valBegin && isBlank(valEnd[-1])) valEnd--;
+        *valEnd = '\0';  // valEnd <= eol, que é '\n' ou o byte extra do fim
+
+        out.line = line_;
+        out.key = std::string_view(keyBegin, (size_t)(keyEnd - keyBegin));
+        out.value = std::string_view(valBegin, (size_t)(valEnd - valBegin));
+        return true;
+    }
+    return false;
+}
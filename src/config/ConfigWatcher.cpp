@@ -0,0 +1,143 @@
+#include "config/ConfigWatcher.hpp"
+#include "ConfigManager.hpp"
+#include "pieces/PieceManager.hpp"
+#include "app/Tracing.hpp"
+#include "DebugLogger.hpp"
+
+#include <sys/stat.h>
+#include <algorithm>
+
+ConfigReload::ConfigReload() = default;
+ConfigReload::~ConfigReload() = default;
+ConfigReload::ConfigReload(ConfigReload&&) noexcept = default;
+ConfigReload& ConfigReload::operator=(ConfigReload&&) noexcept = default;
+
+ConfigWatcher::ConfigWatcher(const std::vector<std::string>& cfgPaths, const std::string& piecesPath, Uint32 intervalMs)
+    : intervalMs_(std::max<Uint32>(50, intervalMs)) {
+    for (const std::string& p : cfgPaths) {
+        Watched w;
+        w.path = p;
+        w.loaded = w.last = stampOf(p);
+        cfgFiles_.push_back(w);
+    }
+    if (!piecesPath.empty()) {
+        Watched w;
+        w.path = piecesPath;
+        w.loaded = w.last = stampOf(piecesPath);
+        piecesFiles_.push_back(w);
+    }
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+    if (mutex_) SDL_DestroyMutex(mutex_);
+}
+
+bool ConfigWatcher::start() {
+    if (thread_) return true;
+    if (cfgFiles_.empty() && piecesFiles_.empty()) {
+        DebugLogger::info("Config watch: no config or pieces file to watch");
+        return false;
+    }
+    if (!mutex_) mutex_ = SDL_CreateMutex();
+    if (!mutex_) { DebugLogger::error(std::string("SDL_CreateMutex failed: ") + SDL_GetError()); return false; }
+    quit_.store(false, std::memory_order_release);
+    thread_ = SDL_CreateThread(&ConfigWatcher::threadMain, "dropblocks-cfgwatch", this);
+    if (!thread_) { DebugLogger::error(std::string("SDL_CreateThread failed: ") + SDL_GetError()); return false; }
+    DebugLogger::info("Config watch: polling " + std::to_string(cfgFiles_.size() + piecesFiles_.size()) +
+                      " file(s) every " + std::to_string(intervalMs_) + "ms");
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    if (!thread_) return;
+    quit_.store(true, std::memory_order_release);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+}
+
+bool ConfigWatcher::poll(ConfigReload& out) {
+    if (!hasReady_.load(std::memory_order_acquire)) return false;
+    if (SDL_TryLockMutex(mutex_) != 0) return false;  // A thread está publicando: fica para o próximo frame
+    out = std::move(ready_);
+    ready_ = ConfigReload();
+    hasReady_.store(false, std::memory_order_release);
+    SDL_UnlockMutex(mutex_);
+    return true;
+}
+
+ConfigWatcher::Stamp ConfigWatcher::stampOf(const std::string& path) {
+    Stamp s;
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0 && (st.st_mode & S_IFREG)) {
+        s.exists = true;
+        s.size = (uint64_t)st.st_size;
+        s.mtime = (int64_t)st.st_mtime * 1000000000LL;
+#if defined(__linux__)
+        s.mtime += st.st_mtim.tv_nsec;  // Dois saves no mesmo segundo com o mesmo tamanho
+#endif
+    }
+    return s;
+}
+
+bool ConfigWatcher::settled(Watched& w) {
+    Stamp now = stampOf(w.path);
+    bool stable = (now == w.last);
+    w.last = now;
+    return now.exists && stable && now != w.loaded;
+}
+
+int SDLCALL ConfigWatcher::threadMain(void* self) {
+    static_cast<ConfigWatcher*>(self)->loop();
+    return 0;
+}
+
+void ConfigWatcher::loop() {
+    Trace::setThreadName("Config watcher");
+    const Uint32 slice = 20;  // stop() não espera um intervalo inteiro
+    Uint32 waited = 0;
+    while (!quit_.load(std::memory_order_acquire)) {
+        SDL_Delay(slice);
+        waited += slice;
+        if (waited < intervalMs_) continue;
+        waited = 0;
+        scan();
+    }
+}
+
+void ConfigWatcher::scan() {
+    DB_TRACE_ZONE("Config scan");
+    bool cfgChanged = false;
+    for (Watched& w : cfgFiles_) cfgChanged |= settled(w);
+    bool piecesChanged = false;
+    for (Watched& w : piecesFiles_) piecesChanged |= settled(w);
+    if (!cfgChanged && !piecesChanged) return;
+
+    ConfigReload reload;
+    if (cfgChanged) {
+        // Relê todos: um .cfg só não diz o valor final das chaves
+        std::unique_ptr<ConfigManager> fresh(new ConfigManager());
+        bool ok = true;
+        for (Watched& w : cfgFiles_) {
+            ok = fresh->loadFromFile(w.path) && ok;
+            w.loaded = w.last;
+        }
+        if (ok) reload.config = std::move(fresh);  // Mesmo critério do boot: parse vale, chave ruim só avisa
+        else DebugLogger::warning("Config watch: could not read the config again, keeping the live one");
+    }
+    if (piecesChanged) {
+        std::unique_ptr<PieceSet> set(new PieceSet());
+        Watched& w = piecesFiles_.front();
+        w.loaded = w.last;
+        if (PieceManager::parsePiecesFile(w.path, *set)) reload.pieces = std::move(set);
+        else DebugLogger::warning("Config watch: " + w.path + " has no valid piece, keeping the live set");
+    }
+    if (!reload.config && !reload.pieces) return;
+
+    // Junta com o que a thread principal ainda não pegou
+    SDL_LockMutex(mutex_);
+    if (reload.config) ready_.config = std::move(reload.config);
+    if (reload.pieces) ready_.pieces = std::move(reload.pieces);
+    hasReady_.store(true, std::memory_order_release);
+    SDL_UnlockMutex(mutex_);
+}
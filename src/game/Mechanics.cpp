@@ -1,17 +1,71 @@
 #include "game/Mechanics.hpp"
 #include "pieces/Piece.hpp"
 #include <vector>
-#include "audio/AudioSystem.hpp"
+#include "Interfaces.hpp"
+#include "app/GameBoard.hpp"
+#include "game/BoardDims.hpp"
 
 bool collides(const Active& a, const std::vector<std::vector<Cell>>& g, int dx, int dy, int drot){
     int R = (a.rot + drot + 4)%4;
     extern std::vector<Piece> PIECES;
-    for (const auto& p : PIECES[a.idx].rot[R]){
-        int x = a.x + dx + p.first;
-        int y = a.y + dy + p.second;
+    const auto& pc = PIECES[a.idx];
+    const RotationMask& m = pc.masks[R];
+    if (!m.valid) {
+        for (const auto& p : pc.rot[R]){
+            int x = a.x + dx + p.first;
+            int y = a.y + dy + p.second;
+            if (y < 0) continue;
+            if (x<0 || x>=COLS || y>=ROWS) return true;
+            if (g[y][x].occ) return true;
+        }
+        return false;
+    }
+    int ox = a.x + dx + m.minX, oy = a.y + dy + m.minY;
+    for (int i = 0; i < m.height(); i++){
+        int y = oy + i;
         if (y < 0) continue;
-        if (x<0 || x>=COLS || y>=ROWS) return true;
-        if (g[y][x].occ) return true;
+        for (uint32_t bits = m.rows[i]; bits; bits &= bits - 1){
+            int x = ox + __builtin_ctz(bits);
+            if (x<0 || x>=COLS || y>=ROWS) return true;
+            if (g[y][x].occ) return true;
+        }
+    }
+    return false;
+}
+
+template <class Dims>
+bool collidesMask(const Active& a, const uint32_t* rows, Dims dims, int dx, int dy, int drot){
+    int R = (a.rot + drot + 4)%4;
+    extern std::vector<Piece> PIECES;
+    const auto& pc = PIECES[a.idx];
+    const RotationMask& m = pc.masks[R];
+    if (!m.valid) {
+        for (const auto& p : pc.rot[R]){
+            int x = a.x + dx + p.first;
+            int y = a.y + dy + p.second;
+            if (y < 0) continue;
+            if (x<0 || x>=dims.cols || y>=dims.rows) return true;
+            if ((rows[y] >> x) & 1u) return true;
+        }
+        return false;
+    }
+    // Uma comparação por linha da peça: desloca a máscara para a coluna alvo
+    int ox = a.x + dx + m.minX, oy = a.y + dy + m.minY;
+    for (int i = 0; i < m.height(); i++){
+        uint32_t row = m.rows[i];
+        int y = oy + i;
+        if (!row || y < 0) continue;
+        if (y >= dims.rows) return true;
+        uint64_t shifted;
+        if (ox < 0) {
+            if (ox <= -32 || (row & ((uint32_t(1) << -ox) - 1))) return true;
+            shifted = row >> -ox;
+        } else {
+            if (ox >= 32) return true;
+            shifted = uint64_t(row) << ox;
+        }
+        if (shifted & ~uint64_t(dims.fullRow)) return true;
+        if (shifted & rows[y]) return true;
     }
     return false;
 }
@@ -19,19 +73,71 @@ bool collides(const Active& a, const std::vector<std::vector<Cell>>& g, int dx,
 void lockPiece(const Active& a, std::vector<std::vector<Cell>>& g){
     extern std::vector<Piece> PIECES;
     const auto &pc = PIECES[a.idx];
-    for (const auto& p : pc.rot[a.rot]){
-        int x=a.x+p.first;
-        int y=a.y+p.second;
+    auto put = [&](int x, int y){
         if (y>=0 && y<ROWS && x>=0 && x<COLS){ g[y][x].occ=true; g[y][x].r=pc.r; g[y][x].g=pc.g; g[y][x].b=pc.b; }
+    };
+    const RotationMask& m = pc.masks[a.rot];
+    if (!m.valid) { for (const auto& p : pc.rot[a.rot]) put(a.x+p.first, a.y+p.second); return; }
+    for (int i = 0; i < m.height(); i++)
+        for (uint32_t bits = m.rows[i]; bits; bits &= bits - 1) put(a.x + m.minX + __builtin_ctz(bits), a.y + m.minY + i);
+}
+
+
+extern std::vector<Piece> PIECES;
+
+namespace {
+// Varredura única da sequência compilada (compilePieceTables); o ajuste de parede
+// depende da posição e por isso é feito entre as duas metades da faixa
+template <typename Collides>
+RotateResult rotateWithKicksImpl(Active& act, int dir, int cols, Collides coll){
+    const auto& p = PIECES[act.idx];
+    int to = (act.rot + (dir>0?1:3)) % 4;
+    const KickSeq& seq = p.kickSeq[dir>0?0:1][act.rot];
+    auto attempt = [&](int kx, int ky){
+        if (coll(kx, ky)) return false;
+        act.x+=kx; act.y+=ky; act.rot=to; return true;
+    };
+    auto result = [](int kx, int ky){ return (kx||ky) ? RotateResult::KICKED : RotateResult::ROTATED; };
+    for (uint16_t i = seq.begin; i < seq.split; i++) {
+        const auto& k = p.kickTable[i];
+        if (attempt(k.first, k.second)) return result(k.first, k.second);
+    }
+    {
+        int minX, maxX; const RotationMask& m = p.masks[to];
+        if (m.valid) { minX = act.x + m.minX; maxX = act.x + m.maxX; }
+        else { minX=999; maxX=-999; for (auto [px,py] : p.rot[to]) { (void)py; int x = act.x + px; if (x < minX) minX = x; if (x > maxX) maxX = x; } }
+        int dx=0; if (minX < 0) dx = -minX; else if (maxX >= cols) dx = (cols - 1) - maxX;
+        if (dx != 0) { if (attempt(dx, 0) || attempt(dx, -1)) return RotateResult::KICKED; }
     }
+    for (uint16_t i = seq.split; i < seq.end; i++) {
+        const auto& k = p.kickTable[i];
+        if (attempt(k.first, k.second)) return result(k.first, k.second);
+    }
+    return RotateResult::BLOCKED;
+}
 }
 
+RotateResult rotateWithKicks(Active& act, const std::vector<std::vector<Cell>>& grid, int dir){
+    return rotateWithKicksImpl(act, dir, COLS, [&](int kx, int ky){ return collides(act, grid, kx, ky, dir); });
+}
+
+RotateResult rotateWithKicks(Active& act, const GameBoard& board, int dir){
+    // Uma escolha de tamanho para a sequência inteira de kicks
+    return withDims(board.width(), board.height(), [&](auto d){ return rotateWithKicks(act, board.rowMasks(), d, dir); });
+}
 
-void rotateWithKicks(Active& act, const std::vector<std::vector<Cell>>& grid, int dir, AudioSystem& audio){
-    extern std::vector<Piece> PIECES; const auto& p = PIECES[act.idx]; int from = act.rot; int to = (act.rot + (dir>0?1:3)) % 4;
-    if(p.hasPerTransKicks){ int dirIdx = (dir>0?0:1); const auto& lst = p.kicksPerTrans[dirIdx][from]; for(auto [kx,ky] : lst){ if(!collides(act, grid, kx, ky, dir)){ act.x+=kx; act.y+=ky; act.rot=to; if(kx||ky) audio.playKickSound(); return; } } }
-    if(p.hasKicks){ const auto& lst = (dir>0? p.kicksCW : p.kicksCCW); for(auto [kx,ky] : lst){ if(!collides(act, grid, kx, ky, dir)){ act.x+=kx; act.y+=ky; act.rot=to; if(kx||ky) audio.playKickSound(); return; } } }
-    { int minX=999, maxX=-999; for (auto [px,py] : p.rot[to]) { int x = act.x + px; if (x < minX) minX = x; if (x > maxX) maxX = x; } int dx=0; if (minX < 0) dx = -minX; else if (maxX >= COLS) dx = (COLS - 1) - maxX; if (dx != 0) { const std::pair<int,int> boundTests[] = {{dx,0},{dx,-1}}; for (auto [kx,ky] : boundTests) { if (!collides(act, grid, kx, ky, dir)) { act.x+=kx; act.y+=ky; act.rot=to; if(kx||ky) audio.playKickSound(); return; } } } }
-    { const std::pair<int,int> tests[] = {{0,0},{-1,0},{1,0},{0,-1},{-1,-1},{1,-1},{0,-2},{-2,0},{2,0},{0,1}}; for (auto [kx,ky] : tests) { if (!collides(act, grid, kx, ky, dir)) { act.x+=kx; act.y+=ky; act.rot=to; if(kx||ky) audio.playKickSound(); return; } } }
-    if(!collides(act, grid, 0, 0, dir)) { act.rot=to; return; } int sx=(dir>0?1:-1); if(!collides(act, grid, sx, 0, dir)) { act.x+=sx; act.rot=to; return; } if(!collides(act, grid, 0,-1, dir)) { act.y-=1; act.rot=to; return; }
+template <class Dims>
+RotateResult rotateWithKicks(Active& act, const uint32_t* rowMasks, Dims dims, int dir){
+    // Com FixedDims o ajuste de parede compara contra a largura constante
+    return rotateWithKicksImpl(act, dir, dims.cols, [&](int kx, int ky){ return collidesMask(act, rowMasks, dims, kx, ky, dir); });
 }
+
+// Uma instância por entrada de withDims() (game/BoardDims.hpp)
+template bool collidesMask(const Active&, const uint32_t*, FixedDims<10, 20>, int, int, int);
+template bool collidesMask(const Active&, const uint32_t*, FixedDims<10, 40>, int, int, int);
+template bool collidesMask(const Active&, const uint32_t*, FixedDims<20, 20>, int, int, int);
+template bool collidesMask(const Active&, const uint32_t*, DynamicDims, int, int, int);
+template RotateResult rotateWithKicks(Active&, const uint32_t*, FixedDims<10, 20>, int);
+template RotateResult rotateWithKicks(Active&, const uint32_t*, FixedDims<10, 40>, int);
+template RotateResult rotateWithKicks(Active&, const uint32_t*, FixedDims<20, 20>, int);
+template RotateResult rotateWithKicks(Active&, const uint32_t*, DynamicDims, int);
@@ -0,0 +1,66 @@
+#include "input/AttractInput.hpp"
+#include "input/InputManager.hpp"
+#include "input/ReplayInput.hpp"
+#include "app/GameState.hpp"
+#include "DebugLogger.hpp"
+
+AttractInput::AttractInput(InputManager& live, const GameState& state, BotEngine& engine, Uint32 idleMs)
+    : live_(live), state_(state), bot_(new BotInput(engine, state)), idleMs_(idleMs) {
+    bot_->setAutoRestart(true, 3000);
+    lastActivity_ = live_.getActivityCount();
+    lastActivityMs_ = state_.getClock().nowMs();
+}
+
+AttractInput::~AttractInput() = default;
+
+IInputManager& AttractInput::live() { return live_; }
+
+uint64_t AttractInput::takeInputStamp() {
+    uint64_t stamp = live_.takeInputStamp();  // Lido sempre: não sobra para depois da demo
+    return passLive() ? stamp : 0;
+}
+
+void AttractInput::setActive(bool on) {
+    active_.store(on, std::memory_order_relaxed);
+    restartPending_ = true;
+    // Antes do restart: o recorder fecha a partida atual e decide se grava a próxima
+    if (recorder_) recorder_->setEnabled(!on);
+    if (on) {
+        demos_++;
+        DebugLogger::info("Attract mode: idle for " + std::to_string(idleMs_ / 1000) + "s, demo started");
+    } else {
+        DebugLogger::info("Attract mode: input detected, starting a new round");
+    }
+}
+
+void AttractInput::update() {
+    restartPending_ = false;
+    live_.update();
+
+    const Uint32 now = state_.getClock().nowMs();
+    const Uint32 activity = live_.getActivityCount();
+    const bool touched = activity != lastActivity_;
+    lastActivity_ = activity;
+    if (touched) lastActivityMs_ = now;
+
+    if (isActive()) {
+        if (touched) setActive(false);  // Este tick é descartado; o próximo já é do jogador
+        else bot_->update();
+        return;
+    }
+    if (idleMs_ > 0 && now - lastActivityMs_ >= idleMs_) setActive(true);
+}
+
+void AttractInput::resetTimers() {
+    live_.resetTimers();
+    bot_->resetTimers();
+}
+
+bool AttractInput::shouldForceRestart() {
+    if (restartPending_) return true;
+    return passLive() && live_.shouldForceRestart();
+}
+
+bool AttractInput::shouldQuit() {
+    return live_.shouldQuit();  // ESC e fechar a janela valem também na demo
+}
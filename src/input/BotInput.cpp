@@ -0,0 +1,60 @@
+#include "input/BotInput.hpp"
+#include "ai/BotEngine.hpp"
+#include "app/GameState.hpp"
+
+#include <numeric>
+
+BotInput::BotInput(BotEngine& engine, const GameState& state, IInputManager* live)
+    : engine_(engine), state_(state), live_(live) {
+    path_.reserve(64);
+}
+
+void BotInput::think() {
+    const Active& piece = state_.getActivePiece();
+    BotSearchStats stats;
+    havePlan_ = engine_.findBest(state_.getBoard(), piece, state_.getNextIdx(), target_, &stats);
+    lastSearchMs_ = stats.ms;
+}
+
+void BotInput::update() {
+    if (live_) live_->update();
+    current_ = 0;
+
+    const Uint32 now = state_.getClock().nowMs();
+    if (state_.isGameOver()) {
+        if (!wasGameOver_) { wasGameOver_ = true; gameOverAtMs_ = now; }
+        if (autoRestart_ && now - gameOverAtMs_ >= restartDelayMs_) current_ = SyntheticInput::RESTART;
+        havePlan_ = false;
+        piecesSeen_ = -1;
+        return;
+    }
+    wasGameOver_ = false;
+    if (state_.isPaused()) return;
+
+    // Cada peça sorteada incrementa uma estatística: soma mudou = peça nova
+    const std::vector<int>& counts = state_.getPieceStats();
+    int pieces = std::accumulate(counts.begin(), counts.end(), 0);
+    if (pieces != piecesSeen_) {
+        piecesSeen_ = pieces;
+        piecesPlayed_++;
+        think();
+        lastActionMs_ = now - actionDelayMs_;  // A primeira ação não espera
+    }
+    if (!havePlan_ || now - lastActionMs_ < actionDelayMs_) return;
+
+    // Caminho sempre a partir da posição real: a gravidade pode ter descido a peça
+    BotBoard board;
+    board.load(state_.getBoard());
+    const Active& piece = state_.getActivePiece();
+    if (!BotEngine::planPath(board, piece, target_, path_)) {
+        think();  // Alvo ficou inalcançável: escolhe outro daqui
+        if (!havePlan_ || !BotEngine::planPath(board, piece, target_, path_)) {
+            current_ = SyntheticInput::HARD_DROP;
+            havePlan_ = false;
+            return;
+        }
+    }
+    current_ = path_.front();
+    lastActionMs_ = now;
+    if (current_ == SyntheticInput::HARD_DROP) havePlan_ = false;
+}
@@ -1,5 +1,8 @@
 #include "input/InputManager.hpp"
 #include "input/KeyboardInput.hpp"
+#include "input/JoystickInput.hpp"
+#include "input/InputSampler.hpp"
+#include "app/Metrics.hpp"
 #include <typeinfo>
 
 void InputManager::addHandler(std::unique_ptr<InputHandler> handler) {
@@ -8,6 +11,10 @@ void InputManager::addHandler(std::unique_ptr<InputHandler> handler) {
     if (keyboardPtr) {
         keyboardHandler = keyboardPtr;
     }
+    JoystickInput* joystickPtr = dynamic_cast<JoystickInput*>(handler.get());
+    if (joystickPtr && !joystickHandler) {
+        joystickHandler = joystickPtr;
+    }
     
     handlers.push_back(std::move(handler));
     if (!primaryHandler) primaryHandler = handlers.back().get();
@@ -15,12 +22,27 @@ void InputManager::addHandler(std::unique_ptr<InputHandler> handler) {
 
 void InputManager::update() {
     // Process SDL events and forward to appropriate handlers
+    // SDL_PumpEvents só pode rodar na thread do vídeo; fora dela a fila é lida com PeepEvents
     SDL_Event e; 
-    while (SDL_PollEvent(&e)) {
+    auto nextEvent = [&]() {
+        return pumpEvents ? SDL_PollEvent(&e) != 0
+                          : SDL_PeepEvents(&e, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) > 0;
+    };
+    static const Metrics::Id mEvents = Metrics::counter("input_events");
+    while (nextEvent()) {
+        Metrics::add(mEvents);
+        // Joystick e GameController: o estado vem só daqui (nada é lido por polling)
+        if (joystickHandler && e.type >= SDL_JOYAXISMOTION && e.type <= SDL_CONTROLLERDEVICEREMAPPED) {
+            joystickHandler->handleEvent(e);
+        }
         if (e.type == SDL_QUIT) {
             quitRequested = true;
         } else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_CLOSE) {
             quitRequested = true;
+        } else if (e.type == SDL_WINDOWEVENT || e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+            windowEventCount++;
+            if (e.type == SDL_RENDER_TARGETS_RESET) targetsResetCount++;
+            if (e.type == SDL_RENDER_DEVICE_RESET) deviceResetCount++;
         } else if (e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) {
             // Handle global quit shortcuts
             if (e.type == SDL_KEYDOWN) {
@@ -30,18 +52,75 @@ void InputManager::update() {
                     continue;
                 }
             }
+            if (sampler) continue;  // A mesma tecla chega pelo evdev, com o timestamp do kernel
             
             // Forward keyboard events to KeyboardInput handler
+            if (e.type == SDL_KEYDOWN && !e.key.repeat) { activityCount++; stampEvent(e); }
             handleKeyboardEvent(e.key);
+        } else if (e.type == SDL_JOYBUTTONDOWN || e.type == SDL_CONTROLLERBUTTONDOWN ||
+                   e.type == SDL_MOUSEBUTTONDOWN ||
+                   (e.type == SDL_JOYHATMOTION && e.jhat.value != SDL_HAT_CENTERED)) {
+            activityCount++;
+            stampEvent(e);
+        } else if (e.type == SDL_JOYAXISMOTION && (e.jaxis.value > 16000 || e.jaxis.value < -16000)) {
+            activityCount++;  // Analógico parado com drift não conta
+            stampEvent(e);
         }
     }
     
+    if (sampler) {
+        // Passos em ordem: o instante nunca volta (o scheduler pode ter descartado passos)
+        Uint32 cutoff = sampleCutoff ? sampleCutoff : SDL_GetTicks();
+        sampleCutoff = 0;
+        if (lastCutoff && (Sint32)(cutoff - lastCutoff) < 0) cutoff = lastCutoff;
+        lastCutoff = cutoff;
+        drainSamples(cutoff);
+    }
+    
     // Update all handlers (but KeyboardInput no longer polls SDL_GetKeyboardState)
     for (auto& h : handlers) h->update();
 }
 
+void InputManager::setSampler(InputSampler* s) {
+    sampler = s;
+    sampleCutoff = lastCutoff = 0;
+    if (!s) {
+        if (keyboardHandler) keyboardHandler->setStepTime(0);
+        for (KeyboardInput* seat : seatKeyboards) seat->setStepTime(0);
+    }
+}
+
+void InputManager::drainSamples(Uint32 cutoff) {
+    static const Metrics::Id mSamples = Metrics::counter("input_samples");
+    while (const InputSampler::Sample* s = sampler->front()) {
+        if ((Sint32)(s->timestamp - cutoff) > 0) break;  // Ainda no futuro deste passo
+        SDL_KeyboardEvent ev{};
+        ev.type = s->down ? SDL_KEYDOWN : SDL_KEYUP;
+        ev.timestamp = s->timestamp;
+        ev.state = s->down ? SDL_PRESSED : SDL_RELEASED;
+        ev.keysym.scancode = s->scancode;
+        if (s->down) { activityCount++; stampTicks(s->timestamp); }
+        sampler->pop();
+        Metrics::add(mSamples);
+        handleKeyboardEvent(ev);
+    }
+    if (keyboardHandler) keyboardHandler->setStepTime(cutoff);
+    for (KeyboardInput* seat : seatKeyboards) seat->setStepTime(cutoff);
+}
+
+void InputManager::stampTicks(Uint32 timestamp) {
+    if (pendingStamp) return;  // Vale o mais antigo: é o que esperou mais
+    // O timestamp do evento é SDL_GetTicks (ms); vira performance counter
+    // descontando a idade dele, para a ponta do Present medir fino
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint32 ageMs = SDL_GetTicks() - timestamp;
+    Uint64 age = (Uint64)ageMs * SDL_GetPerformanceFrequency() / 1000;
+    pendingStamp = age < now ? now - age : now;
+}
+
 void InputManager::handleKeyboardEvent(const SDL_KeyboardEvent& event) {
     if (keyboardHandler) {
         keyboardHandler->handleKeyEvent(event);
     }
+    for (KeyboardInput* seat : seatKeyboards) seat->handleKeyEvent(event);
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "input/InputSampler.hpp"
+#include "DebugLogger.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if DROPBLOCKS_EVDEV
+#  include <cerrno>
+#  include <dirent.h>
+#  include <fcntl.h>
+#  include <linux/input.h>
+#  include <poll.h>
+#  include <sys/ioctl.h>
+#  include <time.h>
+#  include <unistd.h>
+// Headers anteriores ao 4.16 só têm o timeval
+#  ifndef input_event_sec
+#    define input_event_sec time.tv_sec
+#    define input_event_usec time.tv_usec
+#  endif
+#endif
+
+#if DROPBLOCKS_EVDEV
+namespace {
+
+// KEY_* do kernel -> scancode do SDL (o KeyMap é por scancode)
+struct KeyPair { unsigned short code; SDL_Scancode scancode; };
+const KeyPair KEY_TABLE[] = {
+    {KEY_ESC, SDL_SCANCODE_ESCAPE}, {KEY_1, SDL_SCANCODE_1}, {KEY_2, SDL_SCANCODE_2}, {KEY_3, SDL_SCANCODE_3},
+    {KEY_4, SDL_SCANCODE_4}, {KEY_5, SDL_SCANCODE_5}, {KEY_6, SDL_SCANCODE_6}, {KEY_7, SDL_SCANCODE_7},
+    {KEY_8, SDL_SCANCODE_8}, {KEY_9, SDL_SCANCODE_9}, {KEY_0, SDL_SCANCODE_0},
+    {KEY_MINUS, SDL_SCANCODE_MINUS}, {KEY_EQUAL, SDL_SCANCODE_EQUALS}, {KEY_BACKSPACE, SDL_SCANCODE_BACKSPACE},
+    {KEY_TAB, SDL_SCANCODE_TAB},
+    {KEY_Q, SDL_SCANCODE_Q}, {KEY_W, SDL_SCANCODE_W}, {KEY_E, SDL_SCANCODE_E}, {KEY_R, SDL_SCANCODE_R},
+    {KEY_T, SDL_SCANCODE_T}, {KEY_Y, SDL_SCANCODE_Y}, {KEY_U, SDL_SCANCODE_U}, {KEY_I, SDL_SCANCODE_I},
+    {KEY_O, SDL_SCANCODE_O}, {KEY_P, SDL_SCANCODE_P},
+    {KEY_LEFTBRACE, SDL_SCANCODE_LEFTBRACKET}, {KEY_RIGHTBRACE, SDL_SCANCODE_RIGHTBRACKET},
+    {KEY_ENTER, SDL_SCANCODE_RETURN}, {KEY_LEFTCTRL, SDL_SCANCODE_LCTRL},
+    {KEY_A, SDL_SCANCODE_A}, {KEY_S, SDL_SCANCODE_S}, {KEY_D, SDL_SCANCODE_D}, {KEY_F, SDL_SCANCODE_F},
+    {KEY_G, SDL_SCANCODE_G}, {KEY_H, SDL_SCANCODE_H}, {KEY_J, SDL_SCANCODE_J}, {KEY_K, SDL_SCANCODE_K},
+    {KEY_L, SDL_SCANCODE_L},
+    {KEY_SEMICOLON, SDL_SCANCODE_SEMICOLON}, {KEY_APOSTROPHE, SDL_SCANCODE_APOSTROPHE}, {KEY_GRAVE, SDL_SCANCODE_GRAVE},
+    {KEY_LEFTSHIFT, SDL_SCANCODE_LSHIFT}, {KEY_BACKSLASH, SDL_SCANCODE_BACKSLASH},
+    {KEY_Z, SDL_SCANCODE_Z}, {KEY_X, SDL_SCANCODE_X}, {KEY_C, SDL_SCANCODE_C}, {KEY_V, SDL_SCANCODE_V},
+    {KEY_B, SDL_SCANCODE_B}, {KEY_N, SDL_SCANCODE_N}, {KEY_M, SDL_SCANCODE_M},
+    {KEY_COMMA, SDL_SCANCODE_COMMA}, {KEY_DOT, SDL_SCANCODE_PERIOD}, {KEY_SLASH, SDL_SCANCODE_SLASH},
+    {KEY_RIGHTSHIFT, SDL_SCANCODE_RSHIFT}, {KEY_KPASTERISK, SDL_SCANCODE_KP_MULTIPLY},
+    {KEY_LEFTALT, SDL_SCANCODE_LALT}, {KEY_SPACE, SDL_SCANCODE_SPACE}, {KEY_CAPSLOCK, SDL_SCANCODE_CAPSLOCK},
+    {KEY_F1, SDL_SCANCODE_F1}, {KEY_F2, SDL_SCANCODE_F2}, {KEY_F3, SDL_SCANCODE_F3}, {KEY_F4, SDL_SCANCODE_F4},
+    {KEY_F5, SDL_SCANCODE_F5}, {KEY_F6, SDL_SCANCODE_F6}, {KEY_F7, SDL_SCANCODE_F7}, {KEY_F8, SDL_SCANCODE_F8},
+    {KEY_F9, SDL_SCANCODE_F9}, {KEY_F10, SDL_SCANCODE_F10}, {KEY_F11, SDL_SCANCODE_F11}, {KEY_F12, SDL_SCANCODE_F12},
+    {KEY_NUMLOCK, SDL_SCANCODE_NUMLOCKCLEAR}, {KEY_SCROLLLOCK, SDL_SCANCODE_SCROLLLOCK},
+    {KEY_KP7, SDL_SCANCODE_KP_7}, {KEY_KP8, SDL_SCANCODE_KP_8}, {KEY_KP9, SDL_SCANCODE_KP_9},
+    {KEY_KPMINUS, SDL_SCANCODE_KP_MINUS},
+    {KEY_KP4, SDL_SCANCODE_KP_4}, {KEY_KP5, SDL_SCANCODE_KP_5}, {KEY_KP6, SDL_SCANCODE_KP_6},
+    {KEY_KPPLUS, SDL_SCANCODE_KP_PLUS},
+    {KEY_KP1, SDL_SCANCODE_KP_1}, {KEY_KP2, SDL_SCANCODE_KP_2}, {KEY_KP3, SDL_SCANCODE_KP_3},
+    {KEY_KP0, SDL_SCANCODE_KP_0}, {KEY_KPDOT, SDL_SCANCODE_KP_PERIOD},
+    {KEY_KPENTER, SDL_SCANCODE_KP_ENTER}, {KEY_RIGHTCTRL, SDL_SCANCODE_RCTRL}, {KEY_KPSLASH, SDL_SCANCODE_KP_DIVIDE},
+    {KEY_SYSRQ, SDL_SCANCODE_PRINTSCREEN}, {KEY_RIGHTALT, SDL_SCANCODE_RALT},
+    {KEY_HOME, SDL_SCANCODE_HOME}, {KEY_UP, SDL_SCANCODE_UP}, {KEY_PAGEUP, SDL_SCANCODE_PAGEUP},
+    {KEY_LEFT, SDL_SCANCODE_LEFT}, {KEY_RIGHT, SDL_SCANCODE_RIGHT}, {KEY_END, SDL_SCANCODE_END},
+    {KEY_DOWN, SDL_SCANCODE_DOWN}, {KEY_PAGEDOWN, SDL_SCANCODE_PAGEDOWN},
+    {KEY_INSERT, SDL_SCANCODE_INSERT}, {KEY_DELETE, SDL_SCANCODE_DELETE}, {KEY_PAUSE, SDL_SCANCODE_PAUSE},
+    {KEY_LEFTMETA, SDL_SCANCODE_LGUI}, {KEY_RIGHTMETA, SDL_SCANCODE_RGUI},
+};
+
+// Tabela direta por código, montada uma vez
+SDL_Scancode scancodeOf(unsigned code) {
+    static const auto table = [] {
+        std::vector<SDL_Scancode> t(KEY_MAX + 1, SDL_SCANCODE_UNKNOWN);
+        for (const KeyPair& k : KEY_TABLE) t[k.code] = k.scancode;
+        return t;
+    }();
+    return code < table.size() ? table[code] : SDL_SCANCODE_UNKNOWN;
+}
+
+inline bool testBit(const unsigned long* bits, unsigned bit) {
+    const unsigned per = sizeof(unsigned long) * 8;
+    return (bits[bit / per] >> (bit % per)) & 1ul;
+}
+
+// Teclado ou encoder de arcade: tem teclas de jogo, não só power/volume/botões de mouse
+bool isKeyboard(int fd) {
+    unsigned long evBits[(EV_MAX + 1 + sizeof(unsigned long) * 8 - 1) / (sizeof(unsigned long) * 8)] = {0};
+    unsigned long keyBits[(KEY_MAX + 1 + sizeof(unsigned long) * 8 - 1) / (sizeof(unsigned long) * 8)] = {0};
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(evBits)), evBits) < 0 || !testBit(evBits, EV_KEY)) return false;
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0) return false;
+    return testBit(keyBits, KEY_A) || testBit(keyBits, KEY_UP) || testBit(keyBits, KEY_SPACE);
+}
+
+Uint64 monotonicUs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000 + (Uint64)ts.tv_nsec / 1000;
+}
+
+} // namespace
+#endif
+
+bool InputSampler::start() {
+    if (thread_) return true;
+#if DROPBLOCKS_EVDEV
+    rescan();
+    if (fds_.empty()) {
+        DebugLogger::warning("INPUT_THREAD: no readable keyboard in /dev/input (user not in the 'input' group?); using SDL events");
+        return false;
+    }
+    quit_.store(false, std::memory_order_release);
+    thread_ = SDL_CreateThread(&InputSampler::threadMain, "dropblocks-input", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("INPUT_THREAD: SDL_CreateThread failed: ") + SDL_GetError());
+        closeDevices();
+        return false;
+    }
+    DebugLogger::info("Input thread started (" + std::to_string(fds_.size()) + " evdev keyboard(s))");
+    return true;
+#else
+    DebugLogger::warning("INPUT_THREAD needs evdev (Linux); using SDL events");
+    return false;
+#endif
+}
+
+void InputSampler::stop() {
+    if (thread_) {
+        quit_.store(true, std::memory_order_release);
+        SDL_WaitThread(thread_, nullptr);
+        thread_ = nullptr;
+        DebugLogger::info("Input thread stopped (" + std::to_string(samples()) + " key samples, " +
+                          std::to_string(overflows()) + " dropped)");
+    }
+    closeDevices();
+    while (ring_.front()) ring_.pop();
+}
+
+int SDLCALL InputSampler::threadMain(void* self) {
+    static_cast<InputSampler*>(self)->loop();
+    return 0;
+}
+
+void InputSampler::closeDevices() {
+#if DROPBLOCKS_EVDEV
+    for (const Device& d : fds_) ::close(d.fd);
+#endif
+    fds_.clear();
+    devices_.store(0, std::memory_order_relaxed);
+}
+
+void InputSampler::rescan() {
+    lastScan_ = SDL_GetTicks();
+#if DROPBLOCKS_EVDEV
+    DIR* dir = opendir("/dev/input");
+    if (!dir) return;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "event", 5) != 0) continue;
+        const int node = std::atoi(entry->d_name + 5);
+        if (std::any_of(fds_.begin(), fds_.end(), [node](const Device& d) { return d.node == node; })) continue;
+        if ((int)fds_.size() >= MAX_DEVICES) break;
+
+        const std::string path = std::string("/dev/input/") + entry->d_name;
+        const int fd = ::open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) continue;
+        if (!isKeyboard(fd)) { ::close(fd); continue; }
+        int clock = CLOCK_MONOTONIC;   // Mesmo relógio do monotonicUs(), não o de parede
+        ioctl(fd, EVIOCSCLOCKID, &clock);
+
+        char name[128] = "?";
+        ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+        DebugLogger::info("INPUT_THREAD: reading " + path + " (" + name + ")");
+        fds_.push_back(Device{fd, node});
+    }
+    closedir(dir);
+#endif
+    devices_.store((int)fds_.size(), std::memory_order_relaxed);
+}
+
+void InputSampler::readDevice(size_t index) {
+#if DROPBLOCKS_EVDEV
+    input_event events[64];
+    for (;;) {
+        const ssize_t n = ::read(fds_[index].fd, events, sizeof(events));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN) {
+                // Teclado desconectado (ENODEV): o rescan reabre se ele voltar
+                ::close(fds_[index].fd);
+                fds_[index].fd = -1;
+            }
+            return;
+        }
+        if (n == 0) return;
+
+        // Kernel (monotônico) -> SDL ticks: mesma idade nos dois relógios
+        const Uint64 nowUs = monotonicUs();
+        const Uint32 nowTicks = SDL_GetTicks();
+        const size_t count = (size_t)n / sizeof(input_event);
+        for (size_t i = 0; i < count; ++i) {
+            const input_event& ev = events[i];
+            if (ev.type != EV_KEY || ev.value == 2) continue;   // 2 = auto-repeat do kernel
+            Sample s;
+            s.scancode = scancodeOf(ev.code);
+            if (s.scancode == SDL_SCANCODE_UNKNOWN) continue;
+            const Uint64 evUs = (Uint64)ev.input_event_sec * 1000000 + (Uint64)ev.input_event_usec;
+            const Uint32 ageMs = evUs < nowUs ? (Uint32)((nowUs - evUs) / 1000) : 0;
+            s.timestamp = ageMs < nowTicks ? nowTicks - ageMs : 0;
+            s.down = ev.value != 0;
+            if (ring_.push(s)) samples_.fetch_add(1, std::memory_order_relaxed);
+            else overflows_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (count < sizeof(events) / sizeof(events[0])) return;
+    }
+#else
+    (void)index;
+#endif
+}
+
+void InputSampler::loop() {
+#if DROPBLOCKS_EVDEV
+    std::vector<pollfd> polls;
+    while (!quit_.load(std::memory_order_acquire)) {
+        polls.clear();
+        for (const Device& d : fds_) polls.push_back(pollfd{d.fd, POLLIN, 0});
+        const int ready = ::poll(polls.data(), (nfds_t)polls.size(), POLL_TIMEOUT_MS);
+        if (ready > 0) {
+            for (size_t i = 0; i < polls.size(); ++i) {
+                if (polls[i].revents & (POLLIN | POLLERR | POLLHUP)) readDevice(i);
+            }
+            fds_.erase(std::remove_if(fds_.begin(), fds_.end(), [](const Device& d) { return d.fd < 0; }), fds_.end());
+            devices_.store((int)fds_.size(), std::memory_order_relaxed);
+        }
+        if (SDL_GetTicks() - lastScan_ >= RESCAN_MS) rescan();
+    }
+#endif
+}
@@ -16,12 +16,16 @@ InputTimingManager::InputTimingManager(const TimingConfig& config)
 }
 
 bool InputTimingManager::shouldTriggerHorizontal(bool isActive, bool isLeft) {
-    DirectionTimer& timer = isLeft ? leftTimer_ : rightTimer_;
-    return shouldTriggerWithTiming(isActive, timer, false);
+    Direction dir = isLeft ? Direction::LEFT : Direction::RIGHT;
+    Uint32 now = SDL_GetTicks();
+    setHeld(dir, isActive, now);
+    return consumeSteps(dir, now) > 0;
 }
 
 bool InputTimingManager::shouldTriggerVertical(bool isActive) {
-    return shouldTriggerWithTiming(isActive, downTimer_, true);
+    Uint32 now = SDL_GetTicks();
+    setHeld(Direction::DOWN, isActive, now);
+    return consumeSteps(Direction::DOWN, now) > 0;
 }
 
 bool InputTimingManager::shouldTriggerOnce(bool isActive, DirectionTimer& timer) {
@@ -59,37 +63,64 @@ void InputTimingManager::setSoftDropTiming(Uint32 delay) {
     config_.softDropDelay = delay;
 }
 
-bool InputTimingManager::shouldTriggerWithTiming(bool isActive, DirectionTimer& timer, bool useSpecialDelay) {
-    Uint32 now = SDL_GetTicks();
+void InputTimingManager::press(Direction dir, Uint32 timestamp) {
+    DirectionTimer& timer = timerFor(dir);
+    if (timer.held) return;
     
-    // Detect press (transition from inactive to active)
-    bool justPressed = isActive && !timer.wasActive;
-    timer.wasActive = isActive;
+    // Press conta um passo imediato, mesmo que o release chegue no mesmo update
+    timer.held = true;
+    timer.pressTime = timestamp;
+    timer.lastTriggerTime = timestamp;
+    timer.nextRepeatTime = timestamp + config_.DAS;
+    if (timer.pendingSteps < MAX_STEPS_PER_UPDATE) timer.pendingSteps++;
+}
+
+void InputTimingManager::release(Direction dir, Uint32 timestamp) {
+    DirectionTimer& timer = timerFor(dir);
+    if (!timer.held) return;
     
-    if (!isActive) {
-        // Reset timer when input becomes inactive
-        timer.pressTime = 0;
-        return false;
-    }
+    // Repetições que venceram antes do release ainda contam
+    accumulateRepeats(timer, timestamp, repeatRate(dir));
+    timer.held = false;
+}
+
+void InputTimingManager::setHeld(Direction dir, bool isHeld, Uint32 timestamp) {
+    if (isHeld) press(dir, timestamp);
+    else release(dir, timestamp);
+}
+
+int InputTimingManager::consumeSteps(Direction dir, Uint32 now) {
+    DirectionTimer& timer = timerFor(dir);
+    if (timer.held) accumulateRepeats(timer, now, repeatRate(dir));
     
-    // Just pressed - immediate response
-    if (justPressed) {
-        timer.pressTime = now;
-        timer.lastTriggerTime = now;
-        return true;
+    int steps = timer.pendingSteps;
+    timer.pendingSteps = 0;
+    return steps;
+}
+
+InputTimingManager::DirectionTimer& InputTimingManager::timerFor(Direction dir) {
+    switch (dir) {
+        case Direction::LEFT:  return leftTimer_;
+        case Direction::RIGHT: return rightTimer_;
+        default:               return downTimer_;
     }
-    
-    // Held down - apply DAS/ARR logic
-    if (timer.pressTime > 0) {
-        Uint32 heldTime = now - timer.pressTime;
-        Uint32 repeatDelay = useSpecialDelay ? config_.softDropDelay : config_.ARR;
-        
-        // After DAS delay, check ARR for continuous triggering
-        if (heldTime > config_.DAS && (now - timer.lastTriggerTime) > repeatDelay) {
-            timer.lastTriggerTime = now;
-            return true;
+}
+
+Uint32 InputTimingManager::repeatRate(Direction dir) const {
+    Uint32 rate = (dir == Direction::DOWN) ? config_.softDropDelay : config_.ARR;
+    return rate > 0 ? rate : 1;  // ARR=0 vira "instantâneo" limitado por MAX_STEPS_PER_UPDATE
+}
+
+void InputTimingManager::accumulateRepeats(DirectionTimer& timer, Uint32 until, Uint32 rate) {
+    // Comparação com sinal para tolerar wrap-around de SDL_GetTicks
+    while ((Sint32)(until - timer.nextRepeatTime) >= 0) {
+        if (timer.pendingSteps >= MAX_STEPS_PER_UPDATE) {
+            // Travamento longo: descarta o atraso em vez de despejar passos depois
+            timer.nextRepeatTime = until + rate;
+            break;
         }
+        timer.pendingSteps++;
+        timer.lastTriggerTime = timer.nextRepeatTime;
+        timer.nextRepeatTime += rate;
     }
-    
-    return false;
-}
\ No newline at end of file
+}
@@ -1,5 +1,4 @@
 #include "input/JoystickInput.hpp"
-#include <cmath>
 #include <stdexcept>
 
 JoystickInput::JoystickInput() 
@@ -17,6 +16,18 @@ bool JoystickInput::shouldSoftDrop() {
     return joystickSystem_ ? joystickSystem_->shouldSoftDrop() : false;
 }
 
+int JoystickInput::moveLeftSteps() {
+    return joystickSystem_ ? joystickSystem_->moveLeftSteps() : 0;
+}
+
+int JoystickInput::moveRightSteps() {
+    return joystickSystem_ ? joystickSystem_->moveRightSteps() : 0;
+}
+
+int JoystickInput::softDropSteps() {
+    return joystickSystem_ ? joystickSystem_->softDropSteps() : 0;
+}
+
 bool JoystickInput::shouldHardDrop() {
     return joystickSystem_ ? joystickSystem_->shouldHardDrop() : false;
 }
@@ -58,6 +69,12 @@ bool JoystickInput::shouldToggleTimer() {
     return false; // Timer toggle not supported on joystick (keyboard only)
 }
 
+void JoystickInput::handleEvent(const SDL_Event& event) {
+    if (joystickSystem_) {
+        joystickSystem_->handleEvent(event);
+    }
+}
+
 void JoystickInput::update() {
     if (joystickSystem_) {
         joystickSystem_->update();
@@ -92,24 +109,19 @@ JoystickConfig& JoystickInput::getConfig() {
     return joystickSystem_->getConfig();
 }
 
+InputTimingManager& JoystickInput::getTimingManager() {
+    if (!joystickSystem_) {
+        throw std::runtime_error("JoystickSystem not initialized");
+    }
+    return joystickSystem_->getTimingManager();
+}
+
 // Check if joystick has active input (for fallback to keyboard)
 bool JoystickInput::hasActiveInput() {
     if (!joystickSystem_) return false;
     
+    // Botão cru (mesmo sem ação mapeada), hat, D-pad ou analógico fora da zona morta
     const auto& state = joystickSystem_->getState();
-    const auto& config = joystickSystem_->getConfig();
-    
-    // Verificar se há botões pressionados ou movimento analógico
-    for (int i = 0; i < 32; i++) {
-        if (state.buttonStates[i]) return true;
-    }
-    
-    // Verificar movimento analógico
-    if (std::abs(state.leftStickX) > config.analogDeadzone || 
-        std::abs(state.leftStickY) > config.analogDeadzone) {
-        return true;
-    }
-    
-    return false;
+    return state.buttons != 0 || state.held != 0;
 }
 
@@ -1,6 +1,5 @@
 #include "input/JoystickSystem.hpp"
 #include "DebugLogger.hpp"
-#include <cmath>
 
 // ===========================
 //   JoystickDevice
@@ -17,47 +16,52 @@ bool JoystickDevice::initialize() {
         return false;
     }
     
-    int numJoysticks = SDL_NumJoysticks();
-    if (numJoysticks > 0) {
-        if (SDL_IsGameController(0)) {
-            controller_ = SDL_GameControllerOpen(0);
-            if (controller_) {
-                joystick_ = SDL_GameControllerGetJoystick(controller_);
-                joystickId_ = 0;
-                isConnected_ = true;
-                deviceName_ = SDL_GameControllerName(controller_);
-                DebugLogger::info("Game controller connected: " + deviceName_);
-                return true;
-            } else {
-                DebugLogger::error("Failed to open game controller: " + std::string(SDL_GetError()));
-            }
-        }
-        
-        joystick_ = SDL_JoystickOpen(0);
-        if (joystick_) {
-            joystickId_ = 0;
+    if (SDL_NumJoysticks() > 0 && open(0)) return true;
+    
+    DebugLogger::info("No joystick/controller found, waiting for one to be plugged in");
+    return false;
+}
+
+bool JoystickDevice::open(int deviceIndex) {
+    cleanup();
+    if (SDL_IsGameController(deviceIndex)) {
+        controller_ = SDL_GameControllerOpen(deviceIndex);
+        if (controller_) {
+            joystick_ = SDL_GameControllerGetJoystick(controller_);
+            joystickId_ = deviceIndex;
+            instanceId_ = SDL_JoystickInstanceID(joystick_);
             isConnected_ = true;
-            deviceName_ = SDL_JoystickName(joystick_);
-            DebugLogger::info("Joystick connected: " + deviceName_);
+            deviceName_ = SDL_GameControllerName(controller_);
+            DebugLogger::info("Game controller connected: " + deviceName_);
             return true;
         } else {
-            DebugLogger::error("Failed to open joystick: " + std::string(SDL_GetError()));
+            DebugLogger::error("Failed to open game controller: " + std::string(SDL_GetError()));
         }
     }
     
-    DebugLogger::warning("No joystick/controller found");
+    joystick_ = SDL_JoystickOpen(deviceIndex);
+    if (joystick_) {
+        joystickId_ = deviceIndex;
+        instanceId_ = SDL_JoystickInstanceID(joystick_);
+        isConnected_ = true;
+        deviceName_ = SDL_JoystickName(joystick_);
+        DebugLogger::info("Joystick connected: " + deviceName_);
+        return true;
+    }
+    DebugLogger::error("Failed to open joystick: " + std::string(SDL_GetError()));
     return false;
 }
 
 void JoystickDevice::cleanup() {
     if (controller_) {
-        SDL_GameControllerClose(controller_);
+        SDL_GameControllerClose(controller_);  // Fecha também o joystick dele
         controller_ = nullptr;
-    }
-    if (joystick_) {
+    } else if (joystick_) {
         SDL_JoystickClose(joystick_);
-        joystick_ = nullptr;
     }
+    joystick_ = nullptr;
+    joystickId_ = -1;
+    instanceId_ = -1;
     isConnected_ = false;
     deviceName_.clear();
 }
@@ -90,143 +94,137 @@ void JoystickConfig::setTiming(Uint32 moveDelayDAS, Uint32 moveDelayARR, Uint32
 //   JoystickState
 // ===========================
 
-void JoystickState::updateButtonStates(const JoystickDevice& device, const JoystickConfig& config) {
-    // Copy current states to last states
-    for (int i = 0; i < 32; i++) {
-        lastButtonStates[i] = buttonStates[i];
-    }
-    
-    // Update current button states
-    // Always use joystick API for generic joysticks, even if detected as game controller
-    if (device.getJoystick()) {
-        // Regular joystick buttons - this works for both generic joysticks and game controllers
-        for (int i = 0; i < 32; i++) {
-            buttonStates[i] = SDL_JoystickGetButton(device.getJoystick(), i);
+Uint32 JoystickState::applyEvent(const SDL_Event& e, const JoystickConfig& config) {
+    switch (e.type) {
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+            // Botões crus valem também para GameController (o mapeamento do .cfg é por índice)
+            if (e.jbutton.button < 32) {
+                Uint32 bit = 1u << e.jbutton.button;
+                buttons = e.type == SDL_JOYBUTTONDOWN ? (buttons | bit) : (buttons & ~bit);
+            }
+            break;
+        case SDL_JOYHATMOTION:
+            if (e.jhat.hat != 0) return 0;
+            hatActions = ((e.jhat.value & SDL_HAT_LEFT) ? Uint32(LEFT) : 0u) | ((e.jhat.value & SDL_HAT_RIGHT) ? Uint32(RIGHT) : 0u) |
+                         ((e.jhat.value & SDL_HAT_DOWN) ? Uint32(DOWN) : 0u) | ((e.jhat.value & SDL_HAT_UP) ? Uint32(ROTATE_CCW) : 0u);
+            break;
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP: {
+            Uint32 action = 0;
+            switch (e.cbutton.button) {
+                case SDL_CONTROLLER_BUTTON_DPAD_LEFT:  action = LEFT; break;
+                case SDL_CONTROLLER_BUTTON_DPAD_RIGHT: action = RIGHT; break;
+                case SDL_CONTROLLER_BUTTON_DPAD_DOWN:  action = DOWN; break;
+                case SDL_CONTROLLER_BUTTON_DPAD_UP:    action = ROTATE_CCW; break;
+                default: return 0;
+            }
+            padActions = e.type == SDL_CONTROLLERBUTTONDOWN ? (padActions | action) : (padActions & ~action);
+            break;
         }
-    }
-    
-    // Update analog states
-    // Always use joystick API for generic joysticks, even if detected as game controller
-    if (device.getJoystick()) {
-        // Store previous analog values
-        lastLeftStickX = leftStickX;
-        lastLeftStickY = leftStickY;
-        
-        // Regular joystick axes - this works for both generic joysticks and game controllers
-        leftStickX = SDL_JoystickGetAxis(device.getJoystick(), 0) / 32767.0f;
-        leftStickY = SDL_JoystickGetAxis(device.getJoystick(), 1) / 32767.0f;
-        rightStickX = SDL_JoystickGetAxis(device.getJoystick(), 2) / 32767.0f;
-        rightStickY = SDL_JoystickGetAxis(device.getJoystick(), 3) / 32767.0f;
-        
-        // Apply sensitivity and invert Y if needed
-        leftStickX *= config.analogSensitivity;
-        leftStickY *= config.analogSensitivity;
-        rightStickX *= config.analogSensitivity;
-        rightStickY *= config.analogSensitivity;
-        
-        if (config.invertYAxis) {
-            leftStickY = -leftStickY;
-            rightStickY = -rightStickY;
+        case SDL_JOYAXISMOTION: {
+            float v = e.jaxis.value / 32767.0f * config.analogSensitivity;
+            switch (e.jaxis.axis) {
+                case 0: leftStickX = v; break;
+                case 1: leftStickY = config.invertYAxis ? -v : v; break;
+                case 2: rightStickX = v; break;
+                case 3: rightStickY = config.invertYAxis ? -v : v; break;
+                default: return 0;
+            }
+            updateAxisActions(config);
+            break;
         }
+        default:
+            return 0;
     }
+    
+    Uint32 before = held;
+    held = buttonActions(config) | hatActions | padActions | axisActions;
+    pendingPressed |= held & ~before;
+    return held ^ before;
 }
 
-bool JoystickState::isButtonPressed(int button) const {
-    if (button < 0 || button >= 32) return false;
-    return buttonStates[button] && !lastButtonStates[button];
+Uint32 JoystickState::buttonActions(const JoystickConfig& config) const {
+    auto on = [&](int button) { return button >= 0 && button < 32 && (buttons & (1u << button)); };
+    Uint32 a = 0;
+    if (on(config.buttonLeft)) a |= LEFT;
+    if (on(config.buttonRight)) a |= RIGHT;
+    if (on(config.buttonSoftDrop) || on(config.buttonDown)) a |= DOWN;
+    if (on(config.buttonRotateCCW) || on(config.buttonUp)) a |= ROTATE_CCW;
+    if (on(config.buttonRotateCW)) a |= ROTATE_CW;
+    if (on(config.buttonHardDrop)) a |= HARD_DROP;
+    if (on(config.buttonPause)) a |= PAUSE;
+    if (on(config.buttonStart)) a |= START;
+    if (on(config.buttonQuit)) a |= QUIT;
+    return a;
 }
 
-// Analog press detection (for rotation - single press only)
-bool JoystickState::isAnalogPressed(float currentValue, float lastValue, float deadzone, bool checkNegative) const {
-    if (checkNegative) {
-        // Check if moved from not-pressed to pressed in negative direction
-        return (currentValue < -deadzone) && (lastValue >= -deadzone);
-    } else {
-        // Check if moved from not-pressed to pressed in positive direction
-        return (currentValue > deadzone) && (lastValue <= deadzone);
-    }
+void JoystickState::updateAxisActions(const JoystickConfig& config) {
+    const float dz = config.analogDeadzone;
+    axisActions = (leftStickX < -dz ? Uint32(LEFT) : 0u) | (leftStickX > dz ? Uint32(RIGHT) : 0u) |
+                  (leftStickY > dz ? Uint32(DOWN) : 0u) | (leftStickY < -dz ? Uint32(ROTATE_CCW) : 0u) |
+                  (rightStickX > dz ? Uint32(ROTATE_CW) : 0u);
+}
+
+void JoystickState::clear() {
+    buttons = hatActions = padActions = axisActions = 0;
+    held = pressed = pendingPressed = 0;
+    leftStickX = leftStickY = rightStickX = rightStickY = 0.0f;
 }
 
 // ===========================
 //   JoystickInputProcessor
 // ===========================
 
-JoystickInputProcessor::JoystickInputProcessor(const JoystickConfig& config, const JoystickState& state, const JoystickDevice& device)
-    : config_(config), state_(state), device_(device), timingManager_(config.getTimingConfig()) {
+JoystickInputProcessor::JoystickInputProcessor(const JoystickConfig& config, JoystickState& state)
+    : state_(state), timingManager_(config.getTimingConfig()) {
 }
 
-bool JoystickInputProcessor::shouldMoveLeft() const {
-    // Button press (instant response)
-    bool buttonPressed = state_.isButtonPressed(config_.buttonLeft) ||
-                        (device_.getController() && SDL_GameControllerGetButton(device_.getController(), SDL_CONTROLLER_BUTTON_DPAD_LEFT));
-    
-    if (buttonPressed) return true;
-    
-    // Analog stick with unified DAS/ARR timing
-    bool analogActive = (state_.leftStickX < -config_.analogDeadzone);
-    return timingManager_.shouldTriggerHorizontal(analogActive, true);
+void JoystickInputProcessor::onActionsChanged(Uint32 changed, Uint32 timestamp) {
+    // Botão, hat, D-pad e analógico alimentam o mesmo timer DAS/ARR
+    if (changed & JoystickState::LEFT)
+        timingManager_.setHeld(InputTimingManager::Direction::LEFT, state_.isHeld(JoystickState::LEFT), timestamp);
+    if (changed & JoystickState::RIGHT)
+        timingManager_.setHeld(InputTimingManager::Direction::RIGHT, state_.isHeld(JoystickState::RIGHT), timestamp);
+    if (changed & JoystickState::DOWN)
+        timingManager_.setHeld(InputTimingManager::Direction::DOWN, state_.isHeld(JoystickState::DOWN), timestamp);
 }
 
-bool JoystickInputProcessor::shouldMoveRight() const {
-    // Button press (instant response)
-    bool buttonPressed = state_.isButtonPressed(config_.buttonRight) ||
-                        (device_.getController() && SDL_GameControllerGetButton(device_.getController(), SDL_CONTROLLER_BUTTON_DPAD_RIGHT));
-    
-    if (buttonPressed) return true;
+void JoystickInputProcessor::resetTimers() {
+    timingManager_.resetAllTimers();
     
-    // Analog stick with unified DAS/ARR timing
-    bool analogActive = (state_.leftStickX > config_.analogDeadzone);
-    return timingManager_.shouldTriggerHorizontal(analogActive, false);
+    // Direções ainda seguras não geram novo evento: rearmar o DAS a partir de agora
+    Uint32 now = SDL_GetTicks();
+    if (state_.isHeld(JoystickState::LEFT)) timingManager_.press(InputTimingManager::Direction::LEFT, now);
+    if (state_.isHeld(JoystickState::RIGHT)) timingManager_.press(InputTimingManager::Direction::RIGHT, now);
+    if (state_.isHeld(JoystickState::DOWN)) timingManager_.press(InputTimingManager::Direction::DOWN, now);
 }
 
-bool JoystickInputProcessor::shouldSoftDrop() const {
-    // Button press (instant response)
-    bool buttonPressed = state_.isButtonPressed(config_.buttonSoftDrop) ||
-                        (device_.getController() && SDL_GameControllerGetButton(device_.getController(), SDL_CONTROLLER_BUTTON_DPAD_DOWN));
-    
-    if (buttonPressed) return true;
-    
-    // Analog stick with unified vertical timing
-    bool analogActive = (state_.leftStickY > config_.analogDeadzone);
-    return timingManager_.shouldTriggerVertical(analogActive);
+int JoystickInputProcessor::moveLeftSteps() const {
+    return timingManager_.consumeSteps(InputTimingManager::Direction::LEFT, SDL_GetTicks());
 }
 
-bool JoystickInputProcessor::shouldHardDrop() const {
-    bool buttonPressed = state_.isButtonPressed(config_.buttonHardDrop);
-    return timingManager_.shouldTriggerOnce(buttonPressed, hardDropTimer_);
+int JoystickInputProcessor::moveRightSteps() const {
+    return timingManager_.consumeSteps(InputTimingManager::Direction::RIGHT, SDL_GetTicks());
 }
 
-bool JoystickInputProcessor::shouldRotateCCW() const {
-    // Button press (instant response, no auto-repeat)
-    bool buttonPressed = state_.isButtonPressed(config_.buttonRotateCCW) || 
-                        state_.isButtonPressed(config_.buttonUp) ||
-                        (device_.getController() && SDL_GameControllerGetButton(device_.getController(), SDL_CONTROLLER_BUTTON_DPAD_UP));
-    
-    // Analog stick UP press (single press only)
-    bool analogUpPressed = state_.isAnalogPressed(state_.leftStickY, state_.lastLeftStickY, config_.analogDeadzone, true);
-    
-    bool isActive = buttonPressed || analogUpPressed;
-    return timingManager_.shouldTriggerOnce(isActive, rotateCCWTimer_);
+int JoystickInputProcessor::softDropSteps() const {
+    return timingManager_.consumeSteps(InputTimingManager::Direction::DOWN, SDL_GetTicks());
 }
 
-bool JoystickInputProcessor::shouldRotateCW() const {
-    bool buttonPressed = state_.isButtonPressed(config_.buttonRotateCW) || 
-                        (state_.rightStickX > config_.analogDeadzone);
-    return timingManager_.shouldTriggerOnce(buttonPressed, rotateCWTimer_);
-}
+bool JoystickInputProcessor::shouldMoveLeft() const { return moveLeftSteps() > 0; }
+bool JoystickInputProcessor::shouldMoveRight() const { return moveRightSteps() > 0; }
+bool JoystickInputProcessor::shouldSoftDrop() const { return softDropSteps() > 0; }
 
-bool JoystickInputProcessor::shouldPause() const {
-    bool buttonPressed = state_.isButtonPressed(config_.buttonPause);
-    return timingManager_.shouldTriggerOnce(buttonPressed, pauseTimer_);
-}
-
-bool JoystickInputProcessor::shouldRestart() const {
-    bool buttonPressed = state_.isButtonPressed(config_.buttonStart);
-    return timingManager_.shouldTriggerOnce(buttonPressed, restartTimer_);
-}
+// Ações de um toque: a borda de subida latched, sem auto-repeat
+bool JoystickInputProcessor::shouldHardDrop() const { return state_.takePressed(JoystickState::HARD_DROP); }
+bool JoystickInputProcessor::shouldRotateCCW() const { return state_.takePressed(JoystickState::ROTATE_CCW); }
+bool JoystickInputProcessor::shouldRotateCW() const { return state_.takePressed(JoystickState::ROTATE_CW); }
+bool JoystickInputProcessor::shouldPause() const { return state_.takePressed(JoystickState::PAUSE); }
+bool JoystickInputProcessor::shouldRestart() const { return state_.takePressed(JoystickState::START); }
 
 bool JoystickInputProcessor::shouldQuit() const {
-    return state_.isButtonPressed(config_.buttonQuit);
+    return (state_.pressed & JoystickState::QUIT) != 0;  // Consultado por mais de um decorator: não consome
 }
 
 bool JoystickInputProcessor::shouldScreenshot() const {
@@ -238,7 +236,7 @@ bool JoystickInputProcessor::shouldScreenshot() const {
 // ===========================
 
 JoystickSystem::JoystickSystem() {
-    processor_ = std::make_unique<JoystickInputProcessor>(config_, state_, device_);
+    processor_ = std::make_unique<JoystickInputProcessor>(config_, state_);
 }
 
 bool JoystickSystem::initialize() {
@@ -247,17 +245,42 @@ bool JoystickSystem::initialize() {
 
 void JoystickSystem::cleanup() {
     device_.cleanup();
+    state_.clear();
 }
 
 void JoystickSystem::update() {
-    if (device_.isConnected()) {
-        state_.updateButtonStates(device_, config_);
+    // Os eventos deste frame já chegaram por handleEvent()
+    state_.latchPressed();
+}
+
+void JoystickSystem::handleEvent(const SDL_Event& e) {
+    // Hot-plug: o SDL avisa, nada de reenumerar
+    if (e.type == SDL_JOYDEVICEADDED) {
+        if (!device_.isConnected()) device_.open(e.jdevice.which);  // which = índice do dispositivo
+        return;
     }
+    if (e.type == SDL_JOYDEVICEREMOVED) {
+        if (device_.isConnected() && e.jdevice.which == device_.getInstanceId()) {
+            DebugLogger::info("Joystick disconnected: " + device_.getDeviceName());
+            device_.cleanup();
+            state_.clear();
+            processor_->getTimingManager().resetAllTimers();
+        }
+        return;
+    }
+    
+    // Todos os eventos de joystick/controller trazem o instance id no mesmo lugar
+    if (!device_.isConnected() || e.jbutton.which != device_.getInstanceId()) return;
+    Uint32 changed = state_.applyEvent(e, config_);
+    if (changed) processor_->onActionsChanged(changed, e.jbutton.timestamp);
 }
 
 bool JoystickSystem::shouldMoveLeft() const { return processor_->shouldMoveLeft(); }
 bool JoystickSystem::shouldMoveRight() const { return processor_->shouldMoveRight(); }
 bool JoystickSystem::shouldSoftDrop() const { return processor_->shouldSoftDrop(); }
+int JoystickSystem::moveLeftSteps() const { return processor_->moveLeftSteps(); }
+int JoystickSystem::moveRightSteps() const { return processor_->moveRightSteps(); }
+int JoystickSystem::softDropSteps() const { return processor_->softDropSteps(); }
 bool JoystickSystem::shouldHardDrop() const { return processor_->shouldHardDrop(); }
 bool JoystickSystem::shouldRotateCCW() const { return processor_->shouldRotateCCW(); }
 bool JoystickSystem::shouldRotateCW() const { return processor_->shouldRotateCW(); }
@@ -271,11 +294,10 @@ bool JoystickSystem::isConnected() const {
 }
 
 void JoystickSystem::resetTimers() { 
-    processor_->getTimingManager().resetAllTimers(); 
+    processor_->resetTimers(); 
 }
 
 // Access to timing manager for configuration
 InputTimingManager& JoystickSystem::getTimingManager() const {
     return processor_->getTimingManager();
 }
-
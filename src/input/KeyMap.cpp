@@ -0,0 +1,103 @@
+#include "input/KeyMap.hpp"
+
+#include <cstring>
+
+namespace {
+
+struct DefaultBinding {
+    KeyAction action;
+    SDL_Scancode key;
+};
+
+const DefaultBinding DEFAULTS[] = {
+    {KeyAction::LEFT, SDL_SCANCODE_LEFT},
+    {KeyAction::RIGHT, SDL_SCANCODE_RIGHT},
+    {KeyAction::SOFT_DROP, SDL_SCANCODE_DOWN},
+    {KeyAction::HARD_DROP, SDL_SCANCODE_SPACE},
+    {KeyAction::ROTATE_CCW, SDL_SCANCODE_Z},
+    {KeyAction::ROTATE_CCW, SDL_SCANCODE_UP},
+    {KeyAction::ROTATE_CW, SDL_SCANCODE_X},
+    {KeyAction::PAUSE, SDL_SCANCODE_P},
+    {KeyAction::RESTART, SDL_SCANCODE_RETURN},
+    {KeyAction::FORCE_RESTART, SDL_SCANCODE_R},
+    {KeyAction::QUIT, SDL_SCANCODE_ESCAPE},
+    {KeyAction::SCREENSHOT, SDL_SCANCODE_F12},
+    {KeyAction::DEBUG, SDL_SCANCODE_D},
+    {KeyAction::TIMER, SDL_SCANCODE_T},
+    {KeyAction::THEME, SDL_SCANCODE_F9},
+    {KeyAction::REWIND, SDL_SCANCODE_BACKSPACE},
+    {KeyAction::TRACE, SDL_SCANCODE_F8},
+};
+
+// Assentos 2..4 do split-screen: só jogo + restart, longe das teclas do jogador 1
+const DefaultBinding SEAT2[] = {
+    {KeyAction::LEFT, SDL_SCANCODE_J},
+    {KeyAction::RIGHT, SDL_SCANCODE_L},
+    {KeyAction::SOFT_DROP, SDL_SCANCODE_K},
+    {KeyAction::HARD_DROP, SDL_SCANCODE_O},
+    {KeyAction::ROTATE_CCW, SDL_SCANCODE_U},
+    {KeyAction::ROTATE_CW, SDL_SCANCODE_I},
+    {KeyAction::RESTART, SDL_SCANCODE_Y},
+};
+
+const DefaultBinding SEAT3[] = {
+    {KeyAction::LEFT, SDL_SCANCODE_KP_4},
+    {KeyAction::RIGHT, SDL_SCANCODE_KP_6},
+    {KeyAction::SOFT_DROP, SDL_SCANCODE_KP_5},
+    {KeyAction::HARD_DROP, SDL_SCANCODE_KP_0},
+    {KeyAction::ROTATE_CCW, SDL_SCANCODE_KP_7},
+    {KeyAction::ROTATE_CW, SDL_SCANCODE_KP_8},
+    {KeyAction::RESTART, SDL_SCANCODE_KP_ENTER},
+};
+
+const DefaultBinding SEAT4[] = {
+    {KeyAction::LEFT, SDL_SCANCODE_C},
+    {KeyAction::RIGHT, SDL_SCANCODE_B},
+    {KeyAction::SOFT_DROP, SDL_SCANCODE_V},
+    {KeyAction::HARD_DROP, SDL_SCANCODE_N},
+    {KeyAction::ROTATE_CCW, SDL_SCANCODE_F},
+    {KeyAction::ROTATE_CW, SDL_SCANCODE_G},
+    {KeyAction::RESTART, SDL_SCANCODE_H},
+};
+
+template <size_t N>
+void bindAll(KeyMap& map, const DefaultBinding (&bindings)[N]) {
+    for (const DefaultBinding& d : bindings) map.bind(d.action, d.key);
+}
+
+} // namespace
+
+void KeyMap::setDefaults() {
+    std::memset(table_, NONE, sizeof(table_));
+    bindAll(*this, DEFAULTS);
+}
+
+void KeyMap::setSeatDefaults(int seat) {
+    if (seat <= 1) { setDefaults(); return; }
+    std::memset(table_, NONE, sizeof(table_));
+    if (seat == 2) bindAll(*this, SEAT2);
+    else if (seat == 3) bindAll(*this, SEAT3);
+    else if (seat == 4) bindAll(*this, SEAT4);
+}
+
+void KeyMap::load(const InputConfig& config) {
+    setDefaults();
+    for (int a = 0; a < KEY_ACTION_COUNT; ++a) {
+        const int* keys = config.keys[a];
+        if (keys[0] == 0) continue;  // Sem KEY_x no .cfg: padrão
+        unbind((KeyAction)a);
+        for (int k = 0; k < KEYS_PER_ACTION; ++k) {
+            if (keys[k] > 0) bind((KeyAction)a, (SDL_Scancode)keys[k]);
+        }
+    }
+}
+
+void KeyMap::bind(KeyAction action, SDL_Scancode key) {
+    if ((unsigned)key < (unsigned)SDL_NUM_SCANCODES) table_[key] = (uint8_t)action;
+}
+
+void KeyMap::unbind(KeyAction action) {
+    for (uint8_t& a : table_) {
+        if (a == (uint8_t)action) a = NONE;
+    }
+}
@@ -2,10 +2,46 @@
 
 void KeyboardInput::handleKeyEvent(const SDL_KeyboardEvent& event) {
     // Only handle key press/release, ignore repeat events from OS
-    if (event.repeat == 0) {
-        SDL_Scancode scancode = event.keysym.scancode;
-        if (scancode >= 0 && scancode < SDL_NUM_SCANCODES) {
-            keyStates[scancode] = (event.type == SDL_KEYDOWN);
-        }
+    if (event.repeat != 0) return;
+    int action = keyMap_.actionOf(event.keysym.scancode);
+    if (action < 0) return;
+    
+    // Várias teclas na mesma ação: solta só quando a última sobe
+    bool down = (event.type == SDL_KEYDOWN);
+    if (down) downKeys_[action]++;
+    else if (downKeys_[action] > 0) downKeys_[action]--;
+    
+    const uint32_t bit = 1u << action;
+    const uint32_t before = held_;
+    held_ = downKeys_[action] ? (held_ | bit) : (held_ & ~bit);
+    if (held_ == before) return;
+    if (down) pendingPressed_ |= bit;
+    
+    // Direções repetidas: DAS/ARR agendado a partir do timestamp do evento
+    InputTimingManager::Direction dir;
+    switch ((KeyAction)action) {
+        case KeyAction::LEFT:      dir = InputTimingManager::Direction::LEFT; break;
+        case KeyAction::RIGHT:     dir = InputTimingManager::Direction::RIGHT; break;
+        case KeyAction::SOFT_DROP: dir = InputTimingManager::Direction::DOWN; break;
+        default: return;
     }
-}
\ No newline at end of file
+    timingManager_.setHeld(dir, down, event.timestamp);
+}
+
+void KeyboardInput::resetTimers() {
+    timingManager_.resetAllTimers();
+    
+    // Teclas ainda seguras não geram novo KEYDOWN: rearmar o DAS a partir de agora
+    const Uint32 t = now();
+    if (held_ & KeyMap::bit(KeyAction::LEFT)) timingManager_.press(InputTimingManager::Direction::LEFT, t);
+    if (held_ & KeyMap::bit(KeyAction::RIGHT)) timingManager_.press(InputTimingManager::Direction::RIGHT, t);
+    if (held_ & KeyMap::bit(KeyAction::SOFT_DROP)) timingManager_.press(InputTimingManager::Direction::DOWN, t);
+}
+
+void KeyboardInput::setKeyMap(const KeyMap& keyMap) {
+    keyMap_ = keyMap;
+    // As contagens eram das teclas antigas; o KEYUP delas já não achará a ação
+    for (uint8_t& n : downKeys_) n = 0;
+    held_ = pressed_ = pendingPressed_ = 0;
+    timingManager_.resetAllTimers();
+}
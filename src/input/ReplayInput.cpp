@@ -0,0 +1,146 @@
+#include "input/ReplayInput.hpp"
+#include "app/GameState.hpp"
+#include "app/Zobrist.hpp"
+#include "DebugLogger.hpp"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+ReplayRecorder::ReplayRecorder(IInputManager& live, const GameState& state, PieceRng& rng,
+                               const std::string& dir, uint16_t stepMs)
+    : live_(live), state_(state), rng_(rng), dir_(dir), stepMs_(stepMs) {
+    data_.events.reserve(4096);
+}
+
+void ReplayRecorder::beginRound() {
+    finishRound();
+
+    uint32_t seed = (uint32_t)SDL_GetPerformanceCounter() * 2654435761u ^ (uint32_t)std::time(nullptr);
+    rng_.seed(seed);
+
+    data_.events.clear();
+    data_.stepMs = stepMs_;
+    data_.seed = seed;
+    data_.configHash = replayConfigHash(stepMs_);
+    data_.checkpointTicks = ReplayData::CHECKPOINT_TICKS;
+    data_.checkpoints.clear();
+    pending_ = ReplayEvent{};
+    tick_ = -1;
+    active_ = enabled_;
+    if (observer_) observer_->onRoundStart(seed);
+}
+
+void ReplayRecorder::commitPending() {
+    if (tick_ >= 0 && pending_.actions) {
+        pending_.tick = (uint32_t)tick_;
+        if (active_) data_.events.push_back(pending_);
+        if (observer_) observer_->onActions(pending_);
+    }
+    pending_ = ReplayEvent{};
+}
+
+void ReplayRecorder::finishRound() {
+    commitPending();  // Mesmo sem arquivo: o observer recebe o último tick
+    if (!active_) return;
+    active_ = false;
+
+    data_.endTick = (uint32_t)(tick_ + 1);
+    data_.finalScore = state_.getScoreValue();
+    data_.finalLines = state_.getLinesValue();
+    data_.finalLevel = state_.getLevelValue();
+    if (data_.endTick == 0) return;  // Nada jogado
+
+    // Semente no nome: duas partidas no mesmo segundo não se sobrescrevem
+    char name[64];
+    std::time_t t = std::time(nullptr);
+    size_t n = std::strftime(name, sizeof(name), "replay_%Y%m%d_%H%M%S", std::localtime(&t));
+    std::snprintf(name + n, sizeof(name) - n, "_%08x.dbr", data_.seed);
+    std::string path = (dir_.empty() ? std::string(".") : dir_) + "/" + name;
+    if (saveReplay(path, data_)) {
+        DebugLogger::info("Replay saved: " + path + " (score " + std::to_string(data_.finalScore) + ", " +
+                          std::to_string(data_.endTick) + " ticks, " + std::to_string(data_.events.size()) + " events)");
+    }
+}
+
+void ReplayRecorder::update() {
+    // A partida acabou no tick anterior: fecha o arquivo antes de anotar mais nada
+    if (active_ && state_.isGameOver()) finishRound();
+    commitPending();
+    // Checkpoint do tick que acabou de fechar: o player confere o mesmo ponto
+    if (active_ && tick_ >= 0 && (tick_ + 1) % ReplayData::CHECKPOINT_TICKS == 0) {
+        data_.checkpoints.push_back(Zobrist::stateHash(state_, data_.seed));
+    }
+    if (observer_) observer_->onTick();
+    tick_++;
+    live_.update();
+}
+
+int ReplayRecorder::steps(int n, uint16_t bit, int slot) {
+    if (n > 0) {
+        pending_.actions |= bit;
+        pending_.steps[slot] = (uint8_t)std::min(n, 255);
+    }
+    return n;
+}
+
+bool ReplayRecorder::shouldRestart() {
+    bool r = live_.shouldRestart();
+    if (r) beginRound();  // A lógica chama restartRound() logo em seguida
+    return r;
+}
+
+bool ReplayRecorder::shouldForceRestart() {
+    bool r = live_.shouldForceRestart();
+    if (r) beginRound();  // Fecha a partida interrompida e semeia a próxima
+    return r;
+}
+
+bool ReplayRecorder::shouldQuit() {
+    bool r = live_.shouldQuit();
+    if (r) finishRound();
+    return r;
+}
+
+ReplayPlayer::ReplayPlayer(const ReplayData& data, IInputManager* live, const GameState* state)
+    : data_(data), live_(live), state_(state) {
+}
+
+void ReplayPlayer::update() {
+    if (live_) live_->update();
+
+    current_ = ReplayEvent{};
+    if (done()) {
+        if (!finished_) {
+            finished_ = true;
+            if (state_) {
+                bool match = state_->getScoreValue() == data_.finalScore && state_->getLinesValue() == data_.finalLines &&
+                             state_->getLevelValue() == data_.finalLevel;
+                DebugLogger::info(std::string("Replay finished: ") + (match ? "MATCH" : "MISMATCH") +
+                                  " (score " + std::to_string(state_->getScoreValue()) + "/" + std::to_string(data_.finalScore) +
+                                  ", " + std::to_string(checked_) + " checkpoint(s)" +
+                                  (divergedTick_ >= 0 ? ", diverged at tick " + std::to_string(divergedTick_) : std::string()) + ")");
+                // Congela o estado final em vez de deixar a gravidade seguir
+                if (!state_->isGameOver() && !state_->isPaused()) current_.actions = SyntheticInput::PAUSE;
+            }
+        }
+        return;
+    }
+
+    if (state_ && tick_ >= 0 && data_.checkpointTicks && (uint32_t)(tick_ + 1) % data_.checkpointTicks == 0) {
+        const size_t i = (size_t)(tick_ + 1) / data_.checkpointTicks - 1;
+        if (i < data_.checkpoints.size()) {
+            checked_++;
+            if (divergedTick_ < 0 && Zobrist::stateHash(*state_, data_.seed) != data_.checkpoints[i]) {
+                divergedTick_ = tick_;
+                DebugLogger::warning("Replay: state diverged from the recording at tick " + std::to_string(tick_) +
+                                     " (checkpoint " + std::to_string(i + 1) + "/" + std::to_string(data_.checkpoints.size()) + ")");
+            }
+        }
+    }
+    tick_++;
+    if (next_ < data_.events.size() && data_.events[next_].tick == (uint32_t)tick_) {
+        current_ = data_.events[next_++];
+    }
+}
@@ -0,0 +1,230 @@
+#include "net/NetProtocol.hpp"
+#include "input/SyntheticInput.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace NetProtocol {
+
+namespace {
+
+const char MAGIC[3] = {'D', 'B', 'N'};
+constexpr uint16_t MULTI_STEPS = 1 << 15;   // Como no .dbr: passos != 1 seguem
+constexpr uint16_t REPEATING[3] = {SyntheticInput::MOVE_LEFT, SyntheticInput::MOVE_RIGHT, SyntheticInput::SOFT_DROP};
+constexpr size_t MAX_EVENT_BYTES = 1 + 5 + 3 + 3 * 2;   // tipo, delta, ações, passos (pior caso)
+
+// Escrita num buffer fixo; estourou, ok() fica false e o resto é ignorado
+class Writer {
+public:
+    Writer(uint8_t* p, size_t n) : begin_(p), p_(p), end_(p + n) {}
+    bool ok() const { return ok_; }
+    size_t size() const { return (size_t)(p_ - begin_); }
+
+    void byte(uint8_t b) {
+        if (p_ >= end_) { ok_ = false; return; }
+        *p_++ = b;
+    }
+    void varint(uint64_t v) {
+        while (v >= 0x80) { byte((uint8_t)(v | 0x80)); v >>= 7; }
+        byte((uint8_t)v);
+    }
+    void header(Kind kind) {
+        for (char c : MAGIC) byte((uint8_t)c);
+        byte(VERSION);
+        byte(kind);
+    }
+
+private:
+    uint8_t* begin_;
+    uint8_t* p_;
+    uint8_t* end_;
+    bool ok_ = true;
+};
+
+class Reader {
+public:
+    Reader(const uint8_t* p, size_t n) : p_(p), end_(p + n) {}
+    bool ok() const { return ok_; }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p_ >= end_) { ok_ = false; return 0; }
+            uint8_t b = *p_++;
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok_ = false;
+        return 0;
+    }
+    uint8_t byte() {
+        if (p_ >= end_) { ok_ = false; return 0; }
+        return *p_++;
+    }
+    uint64_t le(int bytes) {
+        if (end_ - p_ < bytes) { ok_ = false; return 0; }
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i) v |= (uint64_t)*p_++ << (8 * i);
+        return v;
+    }
+    void skip(size_t n) { if ((size_t)(end_ - p_) < n) ok_ = false; else p_ += n; }
+
+private:
+    const uint8_t* p_;
+    const uint8_t* end_;
+    bool ok_ = true;
+};
+
+void putEvent(Writer& w, const NetEvent& e, uint32_t prevTick) {
+    w.byte(e.type);
+    w.varint(e.tick - prevTick);
+    if (e.type != NetEvent::ACTIONS) {
+        w.varint(e.value);
+        return;
+    }
+    uint16_t bits = e.actions & ~MULTI_STEPS;
+    bool multi = false;
+    for (int i = 0; i < 3; ++i) if ((bits & REPEATING[i]) && e.steps[i] != 1) multi = true;
+    w.varint(multi ? (bits | MULTI_STEPS) : bits);
+    if (multi) {
+        for (int i = 0; i < 3; ++i) if (bits & REPEATING[i]) w.varint(e.steps[i] - 1u);
+    }
+}
+
+size_t eventSize(const NetEvent& e, uint32_t prevTick) {
+    uint8_t scratch[MAX_EVENT_BYTES];
+    Writer w(scratch, sizeof(scratch));
+    putEvent(w, e, prevTick);
+    return w.size();
+}
+
+bool readEvent(Reader& r, NetEvent& e, uint32_t& tick) {
+    e = NetEvent{};
+    e.type = r.byte();
+    tick += (uint32_t)r.varint();
+    e.tick = tick;
+    if (e.type < NetEvent::ACTIONS || e.type > NetEvent::START) return false;
+    if (e.type != NetEvent::ACTIONS) {
+        e.value = r.varint();
+        return r.ok();
+    }
+    uint16_t bits = (uint16_t)r.varint();
+    e.actions = bits & ~MULTI_STEPS;
+    if (bits & MULTI_STEPS) {
+        for (int i = 0; i < 3; ++i) {
+            if (e.actions & REPEATING[i]) e.steps[i] = (uint8_t)(r.varint() + 1);
+        }
+    }
+    return r.ok();
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeHello(const Hello& hello) {
+    uint8_t buf[32];
+    Writer w(buf, sizeof(buf));
+    w.header(HELLO);
+    for (int i = 0; i < 8; ++i) w.byte((uint8_t)(hello.configHash >> (8 * i)));
+    w.varint(hello.nonce);
+    w.varint(hello.stepMs);
+    w.byte(hello.seen ? 1 : 0);
+    return std::vector<uint8_t>(buf, buf + w.size());
+}
+
+std::vector<uint8_t> encodeBye() {
+    uint8_t buf[8];
+    Writer w(buf, sizeof(buf));
+    w.header(BYE);
+    return std::vector<uint8_t>(buf, buf + w.size());
+}
+
+size_t encodeDataTo(uint8_t* out, size_t capacity, uint32_t ack, uint32_t horizon, uint32_t firstSeq,
+                    const NetEvent* events, size_t count, size_t& included) {
+    // Primeiro quantos cabem: o horizon e o count do cabeçalho dependem disso
+    const size_t limit = std::min(capacity, MAX_DATAGRAM);
+    const size_t headerMax = 5 + 4 * 5;
+    size_t body = 0;
+    included = 0;
+    while (included < count) {
+        size_t n = eventSize(events[included], included ? events[included - 1].tick : 0);
+        if (headerMax + body + n > limit) break;
+        body += n;
+        included++;
+    }
+    if (included < count && events[included].tick < horizon) horizon = events[included].tick;
+
+    Writer w(out, capacity);
+    w.header(DATA);
+    w.varint(ack);
+    w.varint(horizon);
+    w.varint(firstSeq);
+    w.varint(included);
+    for (size_t i = 0; i < included; ++i) putEvent(w, events[i], i ? events[i - 1].tick : 0);
+    return w.ok() ? w.size() : 0;
+}
+
+std::vector<uint8_t> encodeData(uint32_t ack, uint32_t horizon, uint32_t firstSeq,
+                                const NetEvent* events, size_t count, size_t& included) {
+    uint8_t buf[MAX_DATAGRAM];
+    size_t n = encodeDataTo(buf, sizeof(buf), ack, horizon, firstSeq, events, count, included);
+    return std::vector<uint8_t>(buf, buf + n);
+}
+
+uint8_t peekKind(const uint8_t* bytes, size_t size) {
+    if (size < 5 || bytes[0] != MAGIC[0] || bytes[1] != MAGIC[1] || bytes[2] != MAGIC[2]) return 0;
+    if (bytes[3] != VERSION) return 0;
+    return bytes[4];
+}
+
+bool decodeHello(const uint8_t* bytes, size_t size, Hello& out) {
+    if (peekKind(bytes, size) != HELLO) return false;
+    Reader r(bytes, size);
+    r.skip(5);
+    out.configHash = r.le(8);
+    out.nonce = (uint32_t)r.varint();
+    out.stepMs = (uint16_t)r.varint();
+    out.seen = r.byte() != 0;
+    return r.ok();
+}
+
+bool decodeData(const uint8_t* bytes, size_t size, Data& out) {
+    if (peekKind(bytes, size) != DATA) return false;
+    Reader r(bytes, size);
+    r.skip(5);
+    out.ack = (uint32_t)r.varint();
+    out.horizon = (uint32_t)r.varint();
+    out.firstSeq = (uint32_t)r.varint();
+    uint64_t count = r.varint();
+    if (!r.ok() || count > MAX_DATAGRAM) return false;
+    out.events.resize((size_t)count);
+    uint32_t tick = 0;
+    for (NetEvent& e : out.events) {
+        if (!readEvent(r, e, tick)) return false;
+    }
+    return r.ok();
+}
+
+bool splitAddress(const std::string& peer, int defaultPort, std::string& host, int& port) {
+    host = peer;
+    port = defaultPort;
+    size_t colon = peer.rfind(':');
+    if (!peer.empty() && peer[0] == '[') {
+        size_t close = peer.find(']');
+        if (close == std::string::npos) return false;
+        host = peer.substr(1, close - 1);
+        colon = (close + 1 < peer.size() && peer[close + 1] == ':') ? close + 1 : std::string::npos;
+    } else if (colon != std::string::npos && peer.find(':') != colon) {
+        colon = std::string::npos;  // IPv6 sem colchetes: sem porta
+    } else if (colon != std::string::npos) {
+        host = peer.substr(0, colon);
+    }
+    if (colon != std::string::npos) {
+        const std::string digits = peer.substr(colon + 1);
+        char* end = nullptr;
+        port = (int)std::strtol(digits.c_str(), &end, 10);
+        if (digits.empty() || *end) return false;
+    }
+    return !host.empty() && port > 0 && port < 65536;
+}
+
+} // namespace NetProtocol
@@ -0,0 +1,227 @@
+#include "net/NetSession.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+
+namespace {
+
+// Eventos por DATA: o pior caso de um evento cabe 32 vezes num datagrama
+constexpr size_t MAX_EVENTS_PER_PACKET = 64;
+
+} // namespace
+
+const char* NetSession::statusName(Status s) {
+    switch (s) {
+        case Status::IDLE: return "idle";
+        case Status::WAITING: return "waiting for peer";
+        case Status::CONNECTED: return "connected";
+        case Status::INCOMPATIBLE: return "incompatible peer";
+        case Status::LOST: return "connection lost";
+        case Status::CLOSED: return "closed";
+    }
+    return "?";
+}
+
+bool NetSession::start(const std::string& peer, int localPort, uint64_t configHash, uint16_t stepMs) {
+    if (thread_) return true;
+    std::string host;
+    int port = 0;
+    if (!NetProtocol::splitAddress(peer, localPort, host, port)) {
+        DebugLogger::error("Netplay: invalid NET_PEER '" + peer + "' (expected host:port)");
+        return false;
+    }
+    if (!socket_.open(host, port, localPort)) {
+        DebugLogger::error("Netplay: cannot open UDP " + std::to_string(localPort) + " -> " + host + ":" +
+                           std::to_string(port));
+        return false;
+    }
+    hello_.configHash = configHash;
+    hello_.stepMs = stepMs;
+    hello_.nonce = (uint32_t)(SDL_GetPerformanceCounter() ^ ((uint64_t)SDL_GetTicks() << 16)) | 1u;
+    quit_.store(false, std::memory_order_relaxed);
+    status_.store((int)Status::WAITING, std::memory_order_release);
+    thread_ = SDL_CreateThread(&NetSession::threadMain, "dropblocks-net", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("Netplay: SDL_CreateThread failed: ") + SDL_GetError());
+        socket_.close();
+        status_.store((int)Status::IDLE, std::memory_order_release);
+        return false;
+    }
+    DebugLogger::info("Netplay: UDP port " + std::to_string(localPort) + ", waiting for " + host + ":" +
+                      std::to_string(port));
+    return true;
+}
+
+void NetSession::stop() {
+    if (!thread_) return;
+    quit_.store(true, std::memory_order_release);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+    // Thread parada: o socket volta a ser só desta thread
+    const std::vector<uint8_t> bye = NetProtocol::encodeBye();
+    for (int i = 0; i < 3; ++i) socket_.send(bye.data(), bye.size());
+    socket_.close();
+    Status s = status();
+    if (s == Status::WAITING || s == Status::CONNECTED) status_.store((int)Status::CLOSED, std::memory_order_release);
+}
+
+void NetSession::send(const NetEvent& event) {
+    flushBacklog();
+    if (!backlog_.empty() || !outbound_.push(event)) backlog_.push_back(event);
+}
+
+void NetSession::flushBacklog() {
+    size_t n = 0;
+    while (n < backlog_.size() && outbound_.push(backlog_[n])) ++n;
+    backlog_.erase(backlog_.begin(), backlog_.begin() + (std::ptrdiff_t)n);
+}
+
+void NetSession::setLocalHorizon(uint32_t horizon) {
+    flushBacklog();
+    // Evento ainda fora da fila: o tick dele não está completo para a rede
+    if (!backlog_.empty()) horizon = std::min(horizon, backlog_.front().tick);
+    localHorizon_.store(horizon, std::memory_order_release);
+}
+
+bool NetSession::receive(NetEvent& out) {
+    const NetEvent* e = inbound_.front();
+    if (!e) return false;
+    out = *e;
+    inbound_.pop();
+    return true;
+}
+
+int SDLCALL NetSession::threadMain(void* self) {
+    static_cast<NetSession*>(self)->loop();
+    return 0;
+}
+
+void NetSession::loop() {
+    uint8_t buffer[NetProtocol::MAX_DATAGRAM * 2];
+    while (!quit_.load(std::memory_order_acquire)) {
+        Uint32 now = SDL_GetTicks();
+        for (;;) {
+            int n = socket_.receive(buffer, sizeof(buffer));
+            if (n <= 0) break;  // -1: par ainda não abriu a porta (ICMP) - continua tentando
+            packetsReceived_.fetch_add(1, std::memory_order_relaxed);
+            handleDatagram(buffer, (size_t)n, now);
+        }
+
+        Status s = status();
+        if (s == Status::INCOMPATIBLE || s == Status::LOST) break;
+        if (!peerSeen_ && now - lastHelloMs_ >= HELLO_INTERVAL_MS) {
+            const std::vector<uint8_t> hello = NetProtocol::encodeHello(hello_);
+            if (socket_.send(hello.data(), hello.size())) packetsSent_.fetch_add(1, std::memory_order_relaxed);
+            lastHelloMs_ = now;
+        }
+        if (s == Status::CONNECTED) {
+            if (now - lastHeardMs_ > TIMEOUT_MS) {
+                DebugLogger::warning("Netplay: no packets from peer for " + std::to_string(TIMEOUT_MS) + " ms");
+                status_.store((int)Status::LOST, std::memory_order_release);
+                break;
+            }
+            // Horizonte antes de drenar: cobre só eventos que já estão na fila
+            const uint32_t horizon = localHorizon_.load(std::memory_order_acquire);
+            bool fresh = false;
+            while (const NetEvent* e = outbound_.front()) {
+                unacked_.push_back(Sent{*e, now});
+                outbound_.pop();
+                nextSeq_++;
+                fresh = true;
+            }
+            if (fresh || horizon != sentHorizon_ || now - lastSendMs_ >= SEND_INTERVAL_MS) {
+                sentHorizon_ = horizon;
+                sendData(now);
+            }
+        }
+        socket_.waitReadable(2);
+    }
+}
+
+void NetSession::handleDatagram(const uint8_t* bytes, size_t size, Uint32 now) {
+    using namespace NetProtocol;
+    switch (peekKind(bytes, size)) {
+        case HELLO: {
+            Hello peer;
+            if (!decodeHello(bytes, size, peer)) return;
+            if (peerSeen_ && peer.nonce != peerNonce_) {
+                DebugLogger::warning("Netplay: peer restarted its session");
+                status_.store((int)Status::LOST, std::memory_order_release);
+                return;
+            }
+            if (!peerSeen_) {
+                if (peer.configHash != hello_.configHash || peer.stepMs != hello_.stepMs) {
+                    DebugLogger::error("Netplay: peer runs different rules (config hash/SIM_STEP_MS mismatch)");
+                    status_.store((int)Status::INCOMPATIBLE, std::memory_order_release);
+                    return;
+                }
+                peerSeen_ = true;
+                peerNonce_ = peer.nonce;
+                status_.store((int)Status::CONNECTED, std::memory_order_release);
+                DebugLogger::info("Netplay: connected");
+            }
+            lastHeardMs_ = now;
+            // O par ainda não ouviu o nosso: responde (uma resposta não gera outra)
+            if (!peer.seen) {
+                Hello reply = hello_;
+                reply.seen = true;
+                const std::vector<uint8_t> hello = encodeHello(reply);
+                if (socket_.send(hello.data(), hello.size())) packetsSent_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        case DATA: {
+            if (!peerSeen_) return;  // Antes do HELLO do par não há o que validar
+            Data d;
+            if (!decodeData(bytes, size, d)) return;
+            lastHeardMs_ = now;
+
+            // Ack: tudo abaixo de d.ack chegou do outro lado
+            if (d.ack > ackedSeq_ && d.ack <= nextSeq_) {
+                Uint32 sentAt = 0;
+                while (ackedSeq_ < d.ack) {
+                    sentAt = unacked_.front().firstSentMs;
+                    unacked_.pop_front();
+                    ackedSeq_++;
+                }
+                const uint32_t sample = (now - sentAt) * 1000u;
+                const uint32_t rtt = rttUs_.load(std::memory_order_relaxed);
+                rttUs_.store(rtt ? rtt - rtt / 8 + sample / 8 : sample, std::memory_order_relaxed);
+            }
+
+            // Eventos em ordem de seq; repetidos são ignorados e fila cheia segura o ack
+            bool complete = true;
+            for (size_t i = 0; i < d.events.size(); ++i) {
+                const uint32_t seq = d.firstSeq + (uint32_t)i;
+                if (seq < expectedSeq_) continue;
+                if (seq > expectedSeq_ || !inbound_.push(d.events[i])) { complete = false; break; }
+                expectedSeq_++;
+            }
+            if (d.firstSeq > expectedSeq_) complete = false;
+            if (complete && d.horizon > remoteHorizon_.load(std::memory_order_relaxed)) {
+                remoteHorizon_.store(d.horizon, std::memory_order_release);
+            }
+            return;
+        }
+        case BYE:
+            if (!peerSeen_) return;
+            DebugLogger::info("Netplay: peer left");
+            status_.store((int)Status::LOST, std::memory_order_release);
+            return;
+        default:
+            return;
+    }
+}
+
+void NetSession::sendData(Uint32 now) {
+    NetEvent events[MAX_EVENTS_PER_PACKET];
+    const size_t count = std::min(unacked_.size(), MAX_EVENTS_PER_PACKET);
+    for (size_t i = 0; i < count; ++i) events[i] = unacked_[i].event;
+    uint32_t horizon = sentHorizon_;
+    // Sem espaço para todos: o horizonte para no primeiro evento que não foi
+    if (count < unacked_.size()) horizon = std::min(horizon, unacked_[count].event.tick);
+    size_t included = 0;
+    const std::vector<uint8_t> packet =
+        NetProtocol::encodeData(expectedSeq_, horizon, ackedSeq_, events, count, included);
+    if (socket_.send(packet.data(), packet.size())) packetsSent_.fetch_add(1, std::memory_order_relaxed);
+    lastSendMs_ = now;
+}
@@ -0,0 +1,218 @@
+#include "net/NetVersus.hpp"
+#include "net/NetSession.hpp"
+#include "app/GameState.hpp"
+#include "app/Zobrist.hpp"
+#include "DebugLogger.hpp"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <ctime>
+
+namespace {
+
+// Linhas de lixo mandadas por linhas limpas de uma vez (0..4)
+const int ATTACK_TABLE[5] = {0, 0, 1, 2, 4};
+
+// Coluna do buraco: só do tick, para não depender de RNG compartilhado
+int holeColumn(uint32_t tick, int width) {
+    uint32_t h = tick * 2654435761u;
+    h ^= h >> 15;
+    return (int)(h % (uint32_t)std::max(1, width));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// NetLocalInput
+// ---------------------------------------------------------------------------
+
+void NetLocalInput::update() {
+    pending_ = NetEvent{};
+    tick_++;
+    live_.update();
+}
+
+void NetLocalInput::flush() {
+    if (tick_ < 0 || !pending_.actions) return;
+    pending_.type = NetEvent::ACTIONS;
+    pending_.tick = (uint32_t)tick_;
+    session_.send(pending_);
+    pending_ = NetEvent{};
+}
+
+int NetLocalInput::steps(int n, uint16_t bit, int slot) {
+    if (n > 0) {
+        pending_.actions |= bit;
+        pending_.steps[slot] = (uint8_t)std::min(n, 255);
+    }
+    return n;
+}
+
+void NetLocalInput::beginRound() {
+    uint32_t seed = (uint32_t)SDL_GetPerformanceCounter() * 2654435761u ^ (uint32_t)std::time(nullptr);
+    rng_.seed(seed);
+    NetEvent e;
+    e.type = NetEvent::ROUND;
+    e.tick = (uint32_t)tick_;
+    e.value = seed;
+    session_.send(e);
+    roundStarted_ = true;
+}
+
+bool NetLocalInput::shouldForceRestart() {
+    // Tick 0 abre a primeira partida pela mesma consulta que o espelho vai ver
+    bool r = live_.shouldForceRestart() || tick_ == 0;
+    if (r) beginRound();
+    return r;
+}
+
+bool NetLocalInput::shouldRestart() {
+    bool r = live_.shouldRestart();
+    if (r) beginRound();  // A lógica chama restartRound() logo em seguida
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// NetRemoteInput
+// ---------------------------------------------------------------------------
+
+void NetRemoteInput::load(const NetEvent* actions, bool round, uint32_t seed) {
+    current_ = actions ? *actions : NetEvent{};
+    round_ = round;
+    seed_ = seed;
+}
+
+bool NetRemoteInput::shouldForceRestart() {
+    if (!round_) return false;
+    round_ = false;
+    rng_.seed(seed_);  // Antes do restartRound(), como do lado de lá
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// NetVersus
+// ---------------------------------------------------------------------------
+
+NetVersus::NetVersus(NetSession& session, GameState& local, IInputManager& live, PieceRng& localRng,
+                     GameState& mirror, PieceRng& mirrorRng)
+    : session_(session), local_(local), mirror_(mirror), localInput_(live, localRng, session),
+      remoteInput_(mirrorRng), localRng_(localRng), mirrorRng_(mirrorRng) {
+}
+
+void NetVersus::install() {
+    local_.setInput(&localInput_);
+    mirror_.setInput(&remoteInput_);
+    lockVersion_ = local_.getBoard().getVersion();
+}
+
+void NetVersus::poll() {
+    // Horizonte antes dos eventos: tudo abaixo dele já está na fila
+    const uint32_t horizon = session_.remoteHorizon();
+    NetEvent e;
+    while (session_.receive(e)) {
+        if (e.type == NetEvent::ATTACK) {
+            if (garbage_) pendingGarbage_ += (int)e.value;
+        } else {
+            stream_.push_back(e);
+        }
+    }
+    remoteHorizon_ = std::max(remoteHorizon_, horizon);
+}
+
+void NetVersus::beforeLocalStep() {
+    const uint32_t tick = localTick();
+    GameBoard& board = local_.getBoard();
+    // Só entre peças: depois de um lock, antes da próxima ação
+    if (pendingGarbage_ <= 0 || board.getVersion() == lockVersion_ || local_.isGameOver() || local_.isPaused()) return;
+    const int lines = std::min(pendingGarbage_, GARBAGE_PER_LOCK);
+    const int hole = holeColumn(tick, board.width());
+    pendingGarbage_ -= lines;
+    local_.addGarbage(lines, hole);
+    lockVersion_ = board.getVersion();
+
+    NetEvent g;
+    g.type = NetEvent::GARBAGE;
+    g.tick = tick;
+    g.value = (uint32_t)lines | ((uint32_t)hole << 8);
+    session_.send(g);
+}
+
+void NetVersus::afterLocalStep() {
+    const uint32_t tick = (uint32_t)localInput_.tick();
+    localInput_.flush();
+
+    if (localInput_.takeRoundStart()) {
+        pendingGarbage_ = 0;
+        prevLines_ = local_.getLinesValue();
+        lockVersion_ = local_.getBoard().getVersion();
+    }
+
+    const int lines = local_.getLinesValue();
+    int attack = ATTACK_TABLE[std::min(4, std::max(0, lines - prevLines_))];
+    prevLines_ = lines;
+    if (attack > 0) {
+        // Lixo pendente cancela primeiro
+        const int cancel = std::min(attack, pendingGarbage_);
+        pendingGarbage_ -= cancel;
+        attack -= cancel;
+        if (attack > 0 && garbage_) {
+            NetEvent a;
+            a.type = NetEvent::ATTACK;
+            a.tick = tick;
+            a.value = (uint32_t)attack;
+            session_.send(a);
+        }
+    }
+
+    if (checksumTicks_ > 0 && tick % (uint32_t)checksumTicks_ == 0) {
+        NetEvent c;
+        c.type = NetEvent::CHECKSUM;
+        c.tick = tick;
+        c.value = Zobrist::stateHash(local_, localRng_.getSeed());
+        session_.send(c);
+    }
+    session_.setLocalHorizon(tick + 1);
+}
+
+void NetVersus::beforeMirrorStep() {
+    const NetEvent* actions = nullptr;
+    NetEvent current;
+    bool round = false;
+    uint32_t seed = 0;
+    while (!stream_.empty() && stream_.front().tick <= mirrorTick_ && stream_.front().type != NetEvent::CHECKSUM) {
+        const NetEvent e = stream_.front();
+        stream_.pop_front();
+        if (e.tick < mirrorTick_) continue;  // Não acontece com um stream bem formado
+        switch (e.type) {
+            case NetEvent::GARBAGE:
+                mirror_.addGarbage((int)(e.value & 0xFF), (int)(e.value >> 8));
+                break;
+            case NetEvent::ROUND:
+                round = true;
+                seed = (uint32_t)e.value;
+                break;
+            case NetEvent::ACTIONS:
+                current = e;
+                actions = &current;
+                break;
+            default:
+                break;
+        }
+    }
+    remoteInput_.load(actions, round, seed);
+}
+
+void NetVersus::afterMirrorStep() {
+    while (!stream_.empty() && stream_.front().tick <= mirrorTick_) {
+        const NetEvent e = stream_.front();
+        stream_.pop_front();
+        if (e.type != NetEvent::CHECKSUM || e.tick != mirrorTick_) continue;
+        if (e.value == Zobrist::stateHash(mirror_, mirrorRng_.getSeed())) {
+            matched_++;
+        } else if (desyncs_++ == 0) {
+            DebugLogger::warning("Netplay: peer board diverged at tick " + std::to_string(mirrorTick_) +
+                                 " (different build or config?)");
+        }
+    }
+    mirrorTick_++;
+}
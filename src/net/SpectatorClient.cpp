@@ -0,0 +1,199 @@
+#include "net/SpectatorClient.hpp"
+#include "app/Zobrist.hpp"
+#include "app/GameState.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// SpectatorClient
+// ---------------------------------------------------------------------------
+
+bool SpectatorClient::start(const std::string& source, uint64_t configHash, uint16_t stepMs) {
+    if (thread_) return true;
+    if (!NetProtocol::splitAddress(source, 0, host_, port_)) {
+        DebugLogger::error("Spectator: invalid SPECTATE_SOURCE '" + source + "' (expected host:port)");
+        return false;
+    }
+    configHash_ = configHash;
+    stepMs_ = stepMs;
+    rx_.reserve(64 * 1024);
+    quit_.store(false, std::memory_order_relaxed);
+    thread_ = SDL_CreateThread(&SpectatorClient::threadMain, "dropblocks-watch", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("Spectator: SDL_CreateThread failed: ") + SDL_GetError());
+        return false;
+    }
+    DebugLogger::info("Spectator: watching " + host_ + ":" + std::to_string(port_));
+    return true;
+}
+
+void SpectatorClient::stop() {
+    if (!thread_) return;
+    quit_.store(true, std::memory_order_release);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+    socket_.close();
+    connected_.store(false, std::memory_order_release);
+}
+
+bool SpectatorClient::receive(NetEvent& out) {
+    const NetEvent* e = ring_.front();
+    if (!e) return false;
+    out = *e;
+    ring_.pop();
+    return true;
+}
+
+int SDLCALL SpectatorClient::threadMain(void* self) {
+    static_cast<SpectatorClient*>(self)->loop();
+    return 0;
+}
+
+void SpectatorClient::loop() {
+    uint8_t buffer[4096];
+    Uint32 lastTry = 0;
+    bool first = true;
+    while (!quit_.load(std::memory_order_acquire) && !incompatible()) {
+        if (!socket_.isOpen()) {
+            const Uint32 now = SDL_GetTicks();
+            if (!first && now - lastTry < RETRY_MS) { SDL_Delay(50); continue; }
+            first = false;
+            lastTry = now;
+            if (!socket_.connect(host_, port_, 500)) continue;
+            rx_.clear();
+            helloSeen_ = false;
+            connected_.store(true, std::memory_order_release);
+            DebugLogger::info("Spectator: connected to " + host_ + ":" + std::to_string(port_));
+        }
+
+        for (;;) {
+            int n = socket_.receive(buffer, sizeof(buffer));
+            if (n == 0) break;
+            if (n < 0) {
+                DebugLogger::warning("Spectator: connection lost, retrying");
+                socket_.close();
+                connected_.store(false, std::memory_order_release);
+                break;
+            }
+            rx_.insert(rx_.end(), buffer, buffer + n);
+            bytesReceived_.fetch_add((uint32_t)n, std::memory_order_relaxed);
+            // Alcançando uma partida longa: não junta tudo de uma vez na memória
+            if (!backlog_.empty() || rx_.size() >= 256 * 1024) break;
+        }
+        if (socket_.isOpen() && !parse()) {
+            DebugLogger::warning("Spectator: invalid stream, reconnecting");
+            socket_.close();
+            connected_.store(false, std::memory_order_release);
+        }
+        deliver();
+        if (socket_.isOpen()) socket_.waitReadable(backlog_.empty() ? 5 : 1);
+    }
+}
+
+bool SpectatorClient::parse() {
+    size_t pos = 0;
+    while (backlog_.size() < ring_.capacity() && rx_.size() - pos >= 2) {
+        const size_t len = (size_t)rx_[pos] | ((size_t)rx_[pos + 1] << 8);
+        if (len == 0 || len > NetProtocol::MAX_DATAGRAM) return false;
+        if (rx_.size() - pos < 2 + len) break;
+        const uint8_t* frame = rx_.data() + pos + 2;
+        pos += 2 + len;
+
+        const uint8_t kind = NetProtocol::peekKind(frame, len);
+        if (kind == NetProtocol::HELLO) {
+            NetProtocol::Hello hello;
+            if (!NetProtocol::decodeHello(frame, len, hello)) return false;
+            if (hello.configHash != configHash_ || hello.stepMs != stepMs_) {
+                DebugLogger::error("Spectator: the cabinet runs different rules (config hash/SIM_STEP_MS mismatch)");
+                incompatible_.store(true, std::memory_order_release);
+                return false;
+            }
+            helloSeen_ = true;
+        } else if (kind == NetProtocol::DATA && helloSeen_) {
+            if (!NetProtocol::decodeData(frame, len, data_)) return false;
+            backlog_.insert(backlog_.end(), data_.events.begin(), data_.events.end());
+            pendingHorizon_ = data_.horizon;
+        } else {
+            return false;
+        }
+    }
+    rx_.erase(rx_.begin(), rx_.begin() + (std::ptrdiff_t)pos);
+    return true;
+}
+
+void SpectatorClient::deliver() {
+    size_t n = 0;
+    while (n < backlog_.size() && ring_.push(backlog_[n])) ++n;
+    backlog_.erase(backlog_.begin(), backlog_.begin() + (std::ptrdiff_t)n);
+    // Horizonte só depois que todos os eventos abaixo dele estão na fila
+    if (backlog_.empty()) horizon_.store(pendingHorizon_, std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// SpectatorInput
+// ---------------------------------------------------------------------------
+
+void SpectatorInput::poll() {
+    // Horizonte antes dos eventos: tudo abaixo dele já está na fila
+    const uint32_t horizon = client_.horizon();
+    NetEvent e;
+    while (client_.receive(e)) {
+        // START no passado = reconexão ou gabinete reiniciado: recomeça dali
+        if (e.type == NetEvent::START && (!started_ || e.tick < tick_)) {
+            stream_.clear();
+            tick_ = e.tick;
+            started_ = true;
+            buffering_ = true;
+        }
+        if (!started_ || e.tick < tick_) continue;
+        stream_.push_back(e);
+    }
+    horizon_ = horizon;
+}
+
+int SpectatorInput::plan(int steps) {
+    poll();
+    if (!started_) return 0;
+    const uint32_t avail = lagTicks();
+    if (avail == 0) {
+        buffering_ = true;  // Esvaziou: junta folga de novo antes de voltar
+        return 0;
+    }
+    if (buffering_) {
+        if (avail < bufferTicks_) return 0;
+        buffering_ = false;
+    }
+    // Muito atrás (entrou no meio da partida): corre até a folga normal
+    if (avail > bufferTicks_ * 2 + (uint32_t)steps) {
+        return (int)std::min<uint32_t>(avail - bufferTicks_, MAX_CATCHUP_STEPS);
+    }
+    return (int)std::min<uint32_t>((uint32_t)steps, avail);
+}
+
+void SpectatorInput::beforeStep(GameState& state) {
+    current_ = NetEvent{};
+    while (!stream_.empty() && stream_.front().tick <= tick_ && stream_.front().type != NetEvent::CHECKSUM) {
+        const NetEvent e = stream_.front();
+        stream_.pop_front();
+        if (e.tick < tick_) continue;
+        if (e.type == NetEvent::START) {
+            rng_.seed(e.value);
+            state.restartRound();  // Antes do relógio andar, como o começo de um replay
+        } else if (e.type == NetEvent::ACTIONS) {
+            current_ = e;
+        }
+    }
+}
+
+void SpectatorInput::afterStep(const GameState& state) {
+    while (!stream_.empty() && stream_.front().tick <= tick_) {
+        const NetEvent e = stream_.front();
+        stream_.pop_front();
+        if (e.type != NetEvent::CHECKSUM || e.tick != tick_) continue;
+        if (e.value != Zobrist::stateHash(state, rng_.getSeed()) && desyncs_++ == 0) {
+            DebugLogger::warning("Spectator: board diverged from the cabinet at tick " + std::to_string(tick_));
+        }
+    }
+    current_ = NetEvent{};
+    tick_++;
+}
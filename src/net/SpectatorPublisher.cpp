@@ -0,0 +1,255 @@
+#include "net/SpectatorPublisher.hpp"
+#include "app/Zobrist.hpp"
+#include "app/GameState.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+
+namespace {
+
+// Um frame: tamanho (u16 LE) e o datagrama; devolve o total ou 0
+size_t encodeFrame(uint8_t* out, size_t capacity, uint32_t horizon, const NetEvent* events, size_t count,
+                   size_t& included) {
+    size_t n = NetProtocol::encodeDataTo(out + 2, capacity - 2, 0, horizon, 0, events, count, included);
+    if (!n) return 0;
+    out[0] = (uint8_t)(n & 0xFF);
+    out[1] = (uint8_t)(n >> 8);
+    return n + 2;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Lado da lógica
+// ---------------------------------------------------------------------------
+
+void SpectatorPublisher::push(const NetEvent& event) {
+    if (!thread_) return;
+    // Fila cheia (rede parada?): o resto desta partida se perde, a próxima sai inteira
+    if (overflow_ && event.type != NetEvent::START) return;
+    if (ring_.push(event)) {
+        overflow_ = false;
+        return;
+    }
+    if (!overflow_) DebugLogger::warning("Spectator: event queue full, stream resumes at the next round");
+    overflow_ = true;
+}
+
+void SpectatorPublisher::onRoundStart(uint32_t seed) {
+    // Sai no onTick(): o CHECKSUM do tick em andamento vem antes e em ordem
+    roundPending_ = true;
+    roundSeed_ = seed;
+}
+
+void SpectatorPublisher::onActions(const ReplayEvent& event) {
+    if (streamTick_ == 0) return;
+    NetEvent e;
+    e.type = NetEvent::ACTIONS;
+    e.tick = streamTick_ - 1;
+    e.actions = event.actions;
+    std::copy(event.steps, event.steps + 3, e.steps);
+    push(e);
+}
+
+void SpectatorPublisher::onTick() {
+    // O tick streamTick_ - 1 acabou; com restart nele o espectador só reinicia antes do próximo
+    if (streamTick_ > 0 && !roundPending_ && checksumTicks_ > 0 && (streamTick_ - 1) % (uint32_t)checksumTicks_ == 0) {
+        NetEvent c;
+        c.type = NetEvent::CHECKSUM;
+        c.tick = streamTick_ - 1;
+        c.value = Zobrist::stateHash(state_, roundSeed_);
+        push(c);
+    }
+    if (roundPending_) {
+        roundPending_ = false;
+        NetEvent s;
+        s.type = NetEvent::START;
+        s.tick = streamTick_;
+        s.value = roundSeed_;
+        push(s);
+    }
+    if (!overflow_) horizon_.store(streamTick_, std::memory_order_release);
+    streamTick_++;
+}
+
+// ---------------------------------------------------------------------------
+// Thread da rede
+// ---------------------------------------------------------------------------
+
+bool SpectatorPublisher::start(int port, uint64_t configHash, uint16_t stepMs) {
+    if (thread_) return true;
+    if (!listener_.listen(port)) {
+        DebugLogger::error("Spectator: cannot listen on TCP port " + std::to_string(port));
+        return false;
+    }
+    hello_.configHash = configHash;
+    hello_.stepMs = stepMs;
+    hello_.seen = true;  // Não há resposta no stream
+    pool_.assign(POOL_BLOCKS, Block{});
+    freeBlocks_.clear();
+    freeBlocks_.reserve(POOL_BLOCKS);
+    for (int i = POOL_BLOCKS - 1; i >= 0; --i) freeBlocks_.push_back(i);
+    batch_.reserve(1024);
+    round_.reserve(4096);
+    quit_.store(false, std::memory_order_relaxed);
+    thread_ = SDL_CreateThread(&SpectatorPublisher::threadMain, "dropblocks-spectate", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("Spectator: SDL_CreateThread failed: ") + SDL_GetError());
+        listener_.close();
+        return false;
+    }
+    DebugLogger::info("Spectator: publishing on TCP port " + std::to_string(port));
+    return true;
+}
+
+void SpectatorPublisher::stop() {
+    if (!thread_) return;
+    quit_.store(true, std::memory_order_release);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+    subs_.clear();
+    listener_.close();
+    subscribers_.store(0, std::memory_order_relaxed);
+}
+
+int SDLCALL SpectatorPublisher::threadMain(void* self) {
+    static_cast<SpectatorPublisher*>(self)->loop();
+    return 0;
+}
+
+void SpectatorPublisher::loop() {
+    while (!quit_.load(std::memory_order_acquire)) {
+        const Uint32 now = SDL_GetTicks();
+        // Horizonte antes de drenar: cobre só eventos que já estão na fila
+        const uint32_t horizon = horizon_.load(std::memory_order_acquire);
+        while (const NetEvent* e = ring_.front()) {
+            if (e->type == NetEvent::START) round_.clear();
+            round_.push_back(*e);
+            batch_.push_back(*e);
+            ring_.pop();
+        }
+        if (now - lastFlushMs_ >= FLUSH_MS) {
+            flush(horizon);
+            lastFlushMs_ = now;
+        }
+        accept();
+        for (size_t i = 0; i < subs_.size();) {
+            if (pump(*subs_[i])) ++i;
+            else drop(i, "disconnected");
+        }
+        listener_.waitPending(5);
+    }
+}
+
+void SpectatorPublisher::accept() {
+    for (intptr_t fd = listener_.accept(); fd >= 0; fd = listener_.accept()) {
+        std::unique_ptr<Subscriber> sub(new Subscriber());
+        sub->socket.adopt(fd);
+        if ((int)subs_.size() >= MAX_SUBSCRIBERS) {
+            DebugLogger::warning("Spectator: refusing connection (" + std::to_string(MAX_SUBSCRIBERS) + " already watching)");
+            continue;
+        }
+        // Quem chega recebe a partida desde o START, o espectador roda até alcançar
+        const std::vector<uint8_t> hello = NetProtocol::encodeHello(hello_);
+        sub->catchup.push_back((uint8_t)(hello.size() & 0xFF));
+        sub->catchup.push_back((uint8_t)(hello.size() >> 8));
+        sub->catchup.insert(sub->catchup.end(), hello.begin(), hello.end());
+        // O que está em batch_ sai no próximo flush para todos, inclusive este
+        const size_t history = round_.size() - std::min(round_.size(), batch_.size());
+        uint8_t frame[NetProtocol::MAX_DATAGRAM + 2];
+        for (size_t done = 0; done < history;) {
+            size_t included = 0;
+            size_t n = encodeFrame(frame, sizeof(frame), flushedHorizon_, round_.data() + done, history - done, included);
+            if (!n || !included) break;
+            sub->catchup.insert(sub->catchup.end(), frame, frame + n);
+            done += included;
+        }
+        subs_.push_back(std::move(sub));
+        subscribers_.store((int)subs_.size(), std::memory_order_relaxed);
+        DebugLogger::info("Spectator: client connected (" + std::to_string(subs_.size()) + " watching)");
+    }
+}
+
+void SpectatorPublisher::flush(uint32_t horizon) {
+    size_t done = 0;
+    do {
+        int b = allocBlock();
+        while (b < 0 && !subs_.empty()) {
+            // Pool esgotado: quem tem mais blocos presos é o mais lento
+            size_t slowest = 0;
+            for (size_t i = 1; i < subs_.size(); ++i) {
+                if (subs_[i]->queue.size() > subs_[slowest]->queue.size()) slowest = i;
+            }
+            drop(slowest, "too slow (buffer pool exhausted)");
+            b = allocBlock();
+        }
+        if (b < 0) break;
+        Block& block = pool_[b];
+        size_t included = 0;
+        block.size = (uint16_t)encodeFrame(block.data, sizeof(block.data), horizon, batch_.data() + done,
+                                           batch_.size() - done, included);
+        if (!block.size || !included) { releaseBlock(b); break; }
+        done += included;
+        // Um bloco, N leitores: cada um guarda só o índice e quanto já foi
+        block.refs = 0;
+        for (auto& sub : subs_) {
+            sub->queue.push_back(Queued{b, 0});
+            block.refs++;
+        }
+        if (block.refs == 0) releaseBlock(b);
+    } while (done < batch_.size());
+    batch_.clear();
+    flushedHorizon_ = horizon;
+
+    for (size_t i = 0; i < subs_.size();) {
+        if (subs_[i]->queue.size() > MAX_QUEUED_BLOCKS) drop(i, "too slow");
+        else ++i;
+    }
+}
+
+bool SpectatorPublisher::pump(Subscriber& sub) {
+    uint8_t sink[256];
+    if (sub.socket.receive(sink, sizeof(sink)) < 0) return false;  // Nada esperado de volta: só detecta o fim
+    while (sub.catchupSent < sub.catchup.size()) {
+        int n = sub.socket.send(sub.catchup.data() + sub.catchupSent, sub.catchup.size() - sub.catchupSent);
+        if (n < 0) return false;
+        if (n == 0) return true;
+        sub.catchupSent += (size_t)n;
+        bytesSent_.fetch_add((uint32_t)n, std::memory_order_relaxed);
+    }
+    if (!sub.catchup.empty()) std::vector<uint8_t>().swap(sub.catchup);
+    while (!sub.queue.empty()) {
+        Queued& q = sub.queue.front();
+        const Block& block = pool_[q.block];
+        int n = sub.socket.send(block.data + q.offset, block.size - q.offset);
+        if (n < 0) return false;
+        if (n == 0) return true;
+        q.offset += (size_t)n;
+        bytesSent_.fetch_add((uint32_t)n, std::memory_order_relaxed);
+        if (q.offset < block.size) return true;
+        releaseBlock(q.block);
+        sub.queue.pop_front();
+    }
+    return true;
+}
+
+void SpectatorPublisher::drop(size_t index, const char* reason) {
+    for (const Queued& q : subs_[index]->queue) releaseBlock(q.block);
+    subs_.erase(subs_.begin() + (std::ptrdiff_t)index);
+    subscribers_.store((int)subs_.size(), std::memory_order_relaxed);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    DebugLogger::info(std::string("Spectator: client ") + reason + " (" + std::to_string(subs_.size()) + " watching)");
+}
+
+int SpectatorPublisher::allocBlock() {
+    if (freeBlocks_.empty()) return -1;
+    int b = freeBlocks_.back();
+    freeBlocks_.pop_back();
+    return b;
+}
+
+void SpectatorPublisher::releaseBlock(int block) {
+    if (--pool_[block].refs <= 0) {
+        pool_[block].refs = 0;
+        freeBlocks_.push_back(block);
+    }
+}
@@ -0,0 +1,83 @@
+#include "pieces/BuiltinPieces.hpp"
+#include "pieces/PieceManager.hpp"
+
+namespace BuiltinPieces {
+namespace {
+
+constexpr std::array<Compiled, COUNT> COMPILED = compileAll();
+
+constexpr bool sameCells(const Shape& a, const Shape& b) {
+    // Mesmo conjunto de células, em qualquer ordem
+    for (int i = 0; i < CELLS; ++i) {
+        bool found = false;
+        for (int j = 0; j < CELLS && !found; ++j) found = a[i].x == b[j].x && a[i].y == b[j].y;
+        if (!found) return false;
+    }
+    return true;
+}
+
+constexpr bool tablesOk() {
+    for (int i = 0; i < COUNT; ++i) {
+        const Compiled& c = COMPILED[i];
+        if (!sameCells(rotate90(c.rot[3]), c.rot[0])) return false;           // Quatro giros = identidade
+        for (int r = 0; r < 4; ++r) {
+            const RotationMask& m = c.masks[r];
+            if (m.cells != CELLS || m.maxY - m.minY + 1 > RotationMask::MAX_ROWS || m.maxX - m.minX + 1 > 32) return false;
+        }
+        for (int d = 0; d < 2; ++d)
+            for (int f = 0; f < 4; ++f) {
+                const KickSeq& s = c.kicks.seq[d][f];
+                if (s.begin > s.split || s.split > s.end || c.kicks.cells[s.begin].x || c.kicks.cells[s.begin].y) return false;
+            }
+    }
+    return true;
+}
+static_assert(tablesOk(), "conjunto embutido inconsistente");
+static_assert(COMPILED[0].kicks.seq[0][0].split - COMPILED[0].kicks.seq[0][0].begin == 6, "I 0->1 perdeu o (2,0) extra");
+
+void toPairs(const Shape& s, std::vector<std::pair<int,int>>& out) {
+    out.resize(CELLS);
+    for (int i = 0; i < CELLS; ++i) out[i] = {s[i].x, s[i].y};
+}
+
+} // namespace
+
+void build(PieceSet& out) {
+    out = PieceSet{};
+    out.previewGrid = PREVIEW_GRID;
+    out.randomizerType = RandType::SIMPLE;
+    out.pieces.resize(COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        const Def& def = DEFS[i];
+        const Compiled& c = COMPILED[i];
+        Piece& p = out.pieces[i];
+        p.name = def.name;
+        p.r = def.r; p.g = def.g; p.b = def.b;
+        for (int r = 0; r < 4; ++r) toPairs(c.rot[r], p.rot[r]);
+
+        // Os campos de origem também, para o cache/hot reload compararem como se viesse do arquivo
+        if (def.kicks == Kicks::LEGACY_ZERO) {
+            p.kicksCW.assign(1, {0, 0});
+            p.kicksCCW.assign(1, {0, 0});
+            p.hasKicks = true;
+        } else {
+            const TransKicks& trans = def.kicks == Kicks::I ? I_KICKS : JLSTZ_KICKS;
+            for (int d = 0; d < 2; ++d)
+                for (int f = 0; f < 4; ++f) {
+                    const KickList& list = trans[d][f];
+                    auto& seq = p.kicksPerTrans[d][f];
+                    seq.resize(list.n);
+                    for (int k = 0; k < list.n; ++k) seq[k] = {list.k[k].x, list.k[k].y};
+                }
+            p.hasPerTransKicks = true;
+        }
+
+        // Já compilado: compilePieceTables não roda
+        p.masks = c.masks;
+        p.kickTable.resize(c.kicks.size);
+        for (int k = 0; k < c.kicks.size; ++k) p.kickTable[k] = {c.kicks.cells[k].x, c.kicks.cells[k].y};
+        p.kickSeq = c.kicks.seq;
+    }
+}
+
+} // namespace BuiltinPieces
@@ -0,0 +1,51 @@
+#include "pieces/Piece.hpp"
+#include <algorithm>
+
+void buildPieceMasks(Piece& piece) {
+    for (int r = 0; r < 4; r++) {
+        RotationMask& m = piece.masks[r];
+        m = RotationMask{};
+        if (r >= (int)piece.rot.size() || piece.rot[r].empty()) continue;
+
+        const auto& cells = piece.rot[r];
+        m.minX = m.maxX = cells[0].first;
+        m.minY = m.maxY = cells[0].second;
+        for (auto [x, y] : cells) {
+            m.minX = std::min(m.minX, x); m.maxX = std::max(m.maxX, x);
+            m.minY = std::min(m.minY, y); m.maxY = std::max(m.maxY, y);
+        }
+        if (m.height() > RotationMask::MAX_ROWS || m.width() > 32) continue;
+
+        for (auto [x, y] : cells) {
+            uint32_t bit = uint32_t(1) << (x - m.minX);
+            uint32_t& row = m.rows[y - m.minY];
+            if (!(row & bit)) { row |= bit; m.cells++; }
+        }
+        m.valid = true;
+    }
+}
+
+void buildKickSequences(Piece& piece) {
+    piece.kickTable.clear();
+    for (int dirIdx = 0; dirIdx < 2; dirIdx++) {
+        for (int from = 0; from < 4; from++) {
+            KickSeq& seq = piece.kickSeq[dirIdx][from];
+            seq.begin = (uint16_t)piece.kickTable.size();
+            auto push = [&](std::pair<int,int> k) {
+                // Um kick repetido já falhou antes; testá-lo de novo não muda o resultado
+                if (std::find(piece.kickTable.begin() + seq.begin, piece.kickTable.end(), k) != piece.kickTable.end()) return;
+                piece.kickTable.push_back(k);
+            };
+            if (piece.hasPerTransKicks) for (auto k : piece.kicksPerTrans[dirIdx][from]) push(k);
+            if (piece.hasKicks) for (auto k : (dirIdx == 0 ? piece.kicksCW : piece.kicksCCW)) push(k);
+            seq.split = (uint16_t)piece.kickTable.size();
+            for (auto k : WALL_FALLBACK_KICKS) push(k);
+            seq.end = (uint16_t)piece.kickTable.size();
+        }
+    }
+}
+
+void compilePieceTables(Piece& piece) {
+    buildPieceMasks(piece);
+    buildKickSequences(piece);
+}
@@ -1,52 +1,218 @@
 #include "pieces/PieceManager.hpp"
 #include "pieces/Piece.hpp"
+#include "pieces/PieceTable.hpp"
+#include "pieces/BuiltinPieces.hpp"
 #include "ConfigTypes.hpp"
 #include <SDL2/SDL.h>
 #include <algorithm>
+#include <cstdint>
 #include <ctime>
 #include <string>
 #include <istream>
+#include <iterator>
+#include <string_view>
+#include <fstream>
 #include <cctype>
 
 // External data owned by main app
 extern std::vector<Piece> PIECES;
 extern std::string PIECES_FILE_PATH;
 
-// Local state
-static std::vector<int> g_bag;
-static size_t g_bagPos = 0;
-static std::mt19937 g_rng((unsigned)time(nullptr));
-static int g_nextIdx = 0;
+// Shared configuration (filled by the pieces file)
 static int g_previewGrid = 6;
 static RandType g_randomizerType = (RandType)0; // default to SIMPLE without including its definition here
 static int g_randBagSize = 0;
 
-PieceManager::PieceManager() {}
+PieceManager::PieceManager()
+    : rng_(RngType::PCG, (uint64_t)time(nullptr) ^ ((uint64_t)(uintptr_t)this << 16)) {}
 
 int PieceManager::getNextPiece() {
-    if (g_bagPos >= g_bag.size()) {
+    if (aheadCount_ > 0) {
+        const int piece = ahead_[aheadHead_];
+        aheadHead_ = (aheadHead_ + 1) % LOOKAHEAD_MAX;
+        --aheadCount_;
+        return piece;
+    }
+    return drawPiece();
+}
+
+int PieceManager::peek(int ahead) {
+    if (ahead < 0 || ahead >= LOOKAHEAD_MAX) return -1;
+    while (aheadCount_ <= ahead) {
+        ahead_[(aheadHead_ + aheadCount_) % LOOKAHEAD_MAX] = drawPiece();
+        ++aheadCount_;
+    }
+    return ahead_[(aheadHead_ + ahead) % LOOKAHEAD_MAX];
+}
+
+int PieceManager::drawPiece() {
+    switch (g_randomizerType) {
+        case RandType::HISTORY: return drawHistory();
+        case RandType::BAG14: return drawMultiBag();
+        case RandType::WEIGHTED: return drawWeighted();
+        default: return drawBag();
+    }
+}
+
+int PieceManager::drawBag() {
+    if (bagPos_ >= bag_.size()) {
         refillBag();
     }
-    int piece = g_bag[g_bagPos++];
+    int piece = bag_[bagPos_++];
+    return piece;
+}
+
+static_assert(PieceManager::HISTORY_SIZE == 4, "drawHistory compara as 4 posições sem laço");
+
+int PieceManager::drawHistory() {
+    const uint32_t n = (uint32_t)PIECES.size();
+    const auto& h = history_;
+    int piece = 0;
+    for (int roll = 0; roll < HISTORY_ROLLS; ++roll) {
+        piece = (int)rng_.below(n);
+        if (piece != h[0] && piece != h[1] && piece != h[2] && piece != h[3]) break;
+    }
+    history_[historyPos_] = piece;
+    historyPos_ = (historyPos_ + 1) & (HISTORY_SIZE - 1);
     return piece;
 }
 
-int PieceManager::getCurrentNextPiece() const { return g_nextIdx; }
-void PieceManager::setNextPiece(int id) { g_nextIdx = id; }
+int PieceManager::drawMultiBag() {
+    const size_t n = PIECES.size(), size = n * 2;
+    if (pool_.size() != size) {
+        pool_.resize(size);
+        for (size_t i = 0; i < size; ++i) pool_[i] = (int)(i % n);
+        poolLeft_ = 0;
+    }
+    if (poolLeft_ == 0) poolLeft_ = size;
+    const size_t j = rng_.below((uint32_t)poolLeft_);
+    --poolLeft_;
+    std::swap(pool_[j], pool_[poolLeft_]);
+    return pool_[poolLeft_];
+}
+
+int PieceManager::drawWeighted() {
+    const PieceTable& t = PIECE_TABLE;
+    const uint32_t n = (uint32_t)t.alias.size();
+    if (n == 0 || n != PIECES.size()) return (int)rng_.below((uint32_t)PIECES.size());
+    const uint32_t i = rng_.below(n);
+    return rng_() < t.aliasProb[i] ? (int)i : t.alias[i];
+}
+
+void PieceManager::resetDrawState() {
+    history_.fill(-1);
+    historyPos_ = 0;
+    poolLeft_ = 0;
+    aheadHead_ = aheadCount_ = 0;
+}
+
+int PieceManager::getCurrentNextPiece() const { return nextIdx_; }
+void PieceManager::setNextPiece(int id) { nextIdx_ = id; }
 
 void PieceManager::refillBag() {
-    g_bag.clear();
     int n = (g_randBagSize > 0 ? g_randBagSize : (int)PIECES.size());
     n = std::min(n, (int)PIECES.size());
-    for (int i = 0; i < n; i++) g_bag.push_back(i);
-    std::shuffle(g_bag.begin(), g_bag.end(), g_rng);
-    g_bagPos = 0;
+    bag_.resize(n);
+    for (int i = 0; i < n; i++) bag_[i] = i;
+    // Fisher-Yates com below(): mesma ordem para a mesma semente em qualquer STL
+    for (int i = n - 1; i > 0; --i) std::swap(bag_[i], bag_[rng_.below((uint32_t)i + 1)]);
+    bagPos_ = 0;
 }
 
-void PieceManager::initialize() { refillBag(); g_nextIdx = getNextPiece(); }
-void PieceManager::reset() { g_bagPos = 0; initialize(); }
+void PieceManager::initialize() { resetDrawState(); refillBag(); nextIdx_ = getNextPiece(); }
+void PieceManager::reset() { bagPos_ = 0; initialize(); }
+
+PieceRng& PieceManager::getRng() { return rng_; }
+void PieceManager::seed(uint64_t seed) { rng_.seed(seed); }
+
+PieceManager::Snapshot PieceManager::saveState() const {
+    Snapshot snap;
+    snap.rng = rng_.save();
+    snap.bag = bag_;
+    snap.bagPos = bagPos_;
+    snap.nextIdx = nextIdx_;
+    snap.pool = pool_;
+    snap.poolLeft = poolLeft_;
+    snap.history = history_;
+    snap.historyPos = historyPos_;
+    snap.ahead = ahead_;
+    snap.aheadHead = aheadHead_;
+    snap.aheadCount = aheadCount_;
+    return snap;
+}
+
+void PieceManager::restoreState(const Snapshot& snap) {
+    rng_.restore(snap.rng);
+    bag_ = snap.bag;
+    bagPos_ = std::min(snap.bagPos, bag_.size());
+    nextIdx_ = snap.nextIdx;
+    pool_ = snap.pool;
+    poolLeft_ = std::min(snap.poolLeft, pool_.size());
+    history_ = snap.history;
+    historyPos_ = snap.historyPos;
+    ahead_ = snap.ahead;
+    aheadHead_ = snap.aheadHead;
+    aheadCount_ = snap.aheadCount;
+}
+
+static_assert(DealState::HISTORY == PieceManager::HISTORY_SIZE && DealState::LOOKAHEAD == PieceManager::LOOKAHEAD_MAX,
+              "DealState espelha as filas do PieceManager");
+
+bool PieceManager::saveDeal(DealState& out) const {
+    if (rng_.type() == RngType::MT19937 || bag_.size() > (size_t)DealState::MAX_BAG ||
+        pool_.size() > (size_t)DealState::MAX_POOL) return false;
+    const RngState rng = rng_.save();
+    out.rngType = (uint8_t)rng.type;
+    out.rngSeed = rng.seed;
+    out.rngWords[0] = rng.words[0];
+    out.rngWords[1] = rng.words[1];
+    out.bagCount = (uint16_t)bag_.size();
+    out.bagPos = (uint16_t)std::min(bagPos_, bag_.size());
+    for (size_t i = 0; i < bag_.size(); ++i) out.bag[i] = (uint16_t)bag_[i];
+    out.poolCount = (uint16_t)pool_.size();
+    out.poolLeft = (uint16_t)std::min(poolLeft_, pool_.size());
+    for (size_t i = 0; i < pool_.size(); ++i) out.pool[i] = (uint16_t)pool_[i];
+    out.nextIdx = (int16_t)nextIdx_;
+    for (int i = 0; i < HISTORY_SIZE; ++i) out.history[i] = (int16_t)history_[i];
+    out.historyPos = (int16_t)historyPos_;
+    for (int i = 0; i < LOOKAHEAD_MAX; ++i) out.ahead[i] = (int16_t)ahead_[i];
+    out.aheadHead = (int16_t)aheadHead_;
+    out.aheadCount = (int16_t)aheadCount_;
+    return true;
+}
+
+bool PieceManager::restoreDeal(const DealState& in) {
+    // Vem também do disco (RESUME_FILE): índices fora do PIECES atual = estado de outro conjunto
+    const int n = (int)PIECES.size();
+    auto valid = [n](int idx) { return idx >= 0 && idx < n; };
+    if (in.rngType > (uint8_t)RngType::PCG || in.bagCount > DealState::MAX_BAG || in.bagCount > n ||
+        in.bagPos > in.bagCount || in.poolCount > DealState::MAX_POOL || in.poolLeft > in.poolCount ||
+        !valid(in.nextIdx) || in.aheadCount < 0 || in.aheadCount > LOOKAHEAD_MAX ||
+        in.aheadHead < 0 || in.aheadHead >= LOOKAHEAD_MAX || in.historyPos < 0 || in.historyPos >= HISTORY_SIZE) {
+        return false;
+    }
+    for (int i = 0; i < in.bagCount; ++i) if (!valid(in.bag[i])) return false;
+    for (int i = 0; i < in.poolCount; ++i) if (!valid(in.pool[i])) return false;
+    for (int i = 0; i < in.aheadCount; ++i) if (!valid(in.ahead[(in.aheadHead + i) % LOOKAHEAD_MAX])) return false;
 
-std::mt19937& PieceManager::getRng() { return g_rng; }
+    RngState rng;
+    rng.type = (RngType)in.rngType;
+    rng.seed = in.rngSeed;
+    rng.words[0] = in.rngWords[0];
+    rng.words[1] = in.rngWords[1];
+    rng_.restore(rng);
+    bag_.assign(in.bag, in.bag + in.bagCount);
+    bagPos_ = in.bagPos;
+    pool_.assign(in.pool, in.pool + in.poolCount);
+    poolLeft_ = in.poolLeft;
+    nextIdx_ = in.nextIdx;
+    for (int i = 0; i < HISTORY_SIZE; ++i) history_[i] = in.history[i];
+    historyPos_ = in.historyPos;
+    for (int i = 0; i < LOOKAHEAD_MAX; ++i) ahead_[i] = in.ahead[i];
+    aheadHead_ = in.aheadHead;
+    aheadCount_ = in.aheadCount;
+    return true;
+}
 
 int PieceManager::getPreviewGrid() const { return g_previewGrid; }
 void PieceManager::setPreviewGrid(int grid) { g_previewGrid = grid; }
@@ -55,46 +221,85 @@ void PieceManager::setRandBagSize(int size) { g_randBagSize = size; }
 int PieceManager::getRandBagSize() const { return g_randBagSize; }
 RandType PieceManager::getRandomizerType() const { return g_randomizerType; }
 
+namespace {
+const struct { RandType type; const char* name; } kRandTypes[] = {
+    {RandType::SIMPLE, "simple"}, {RandType::BAG, "bag"}, {RandType::HISTORY, "history"},
+    {RandType::BAG14, "bag14"}, {RandType::WEIGHTED, "weighted"},
+};
+}
+
+const char* PieceManager::randTypeName(RandType type) {
+    for (const auto& t : kRandTypes) if (t.type == type) return t.name;
+    return "simple";
+}
+
+bool PieceManager::parseRandType(const std::string& name, RandType& out) {
+    std::string lower = name;
+    for (char& c : lower) c = (char)std::tolower((unsigned char)c);
+    for (const auto& t : kRandTypes) {
+        if (lower == t.name) { out = t.type; return true; }
+    }
+    return false;
+}
+
 // Bridge helper implemented in main TU (dropblocks.cpp)
 extern bool db_loadPiecesPath(const std::string& p);
 
-bool PieceManager::loadPiecesFile() {
+std::vector<std::string> PieceManager::piecesCandidates(const std::string& configured) {
+    std::vector<std::string> paths;
     // 1) Environment override
-    if (const char* env = std::getenv("DROPBLOCKS_PIECES")) {
-        if (db_loadPiecesPath(env)) return true;
-    }
+    if (const char* env = std::getenv("DROPBLOCKS_PIECES")) paths.push_back(env);
     // 2) Configured path
-    if (!PIECES_FILE_PATH.empty()) {
-        if (db_loadPiecesPath(PIECES_FILE_PATH)) return true;
-    }
-    // 3) Default file in CWD
-    if (db_loadPiecesPath("default.pieces")) return true;
-    // 4) User config dir
-    if (const char* home = std::getenv("HOME")) {
-        std::string p = std::string(home) + "/.config/default.pieces";
-        if (db_loadPiecesPath(p)) return true;
+    if (!configured.empty()) paths.push_back(configured);
+    // 3) User config dir (o default.pieces do CWD é o conjunto embutido: não é lido)
+    if (const char* home = std::getenv("HOME")) paths.push_back(std::string(home) + "/.config/default.pieces");
+    return paths;
+}
+
+bool PieceManager::loadPiecesFile() {
+    for (const std::string& path : piecesCandidates(PIECES_FILE_PATH)) {
+        if (db_loadPiecesPath(path)) { loadedPath_ = path; return true; }
     }
-    return false;
+    // Nenhum .pieces próprio: o conjunto compilado, sem abrir nem parsear arquivo
+    if (!PIECES_FILE_PATH.empty()) SDL_Log("PIECES_FILE '%s' não carregou; usando o conjunto embutido.", PIECES_FILE_PATH.c_str());
+    installBuiltinSet();
+    return true;
 }
 
 // ---------- Internal parsing helpers (migrated from dropblocks.cpp) ----------
-static bool pm_parseHexColor(const std::string& s, Uint8& r, Uint8& g, Uint8& b){
-    std::string color = s;
-    if (color.size() == 6 && color[0] != '#') color = "#" + color;
-    if (color.size()!=7 || color[0]!='#') return false;
+// Tudo em string_view sobre o buffer do arquivo: com conjuntos de centenas de
+// peças o parse antigo gastava mais em cópias de std::string por linha do que
+// nas coordenadas em si.
+static std::string_view pm_trim(std::string_view s) {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    if (a == std::string_view::npos) return {};
+    size_t b = s.find_last_not_of(" \t\r\n");
+    return s.substr(a, b - a + 1);
+}
+
+static void pm_upperInto(std::string_view s, std::string& out) {
+    out.assign(s.data(), s.size());
+    for (char& c : out) c = (char)std::toupper((unsigned char)c);
+}
+
+static bool pm_parseHexColor(std::string_view color, Uint8& r, Uint8& g, Uint8& b){
+    if (color.size() == 6 && color[0] != '#') { char buf[7] = {'#'}; std::copy(color.begin(), color.end(), buf + 1); return pm_parseHexColor(std::string_view(buf, 7), r, g, b); }
+    if(color.size()!=7 || color[0]!='#') return false;
     auto cv=[&](char c)->int{ if(c>='0'&&c<='9') return c-'0'; c=(char)std::toupper((unsigned char)c); if(c>='A'&&c<='F') return 10+(c-'A'); return -1; };
     auto hx=[&](char a,char b){int A=cv(a),B=cv(b); return (A<0||B<0)?-1:(A*16+B);} ;
     int R=hx(color[1],color[2]), G=hx(color[3],color[4]), B=hx(color[5],color[6]);
     if(R<0||G<0||B<0) return false; r=(Uint8)R; g=(Uint8)G; b=(Uint8)B; return true;
 }
 
-static bool pm_parseInt(const std::string& s, int& out){
+static bool pm_parseInt(std::string_view sv, int& out){
+    const std::string s(sv);
     char* e=nullptr; long v=strtol(s.c_str(), &e, 10);
     if(e==s.c_str()||*e!='\0') return false; out=(int)v; return true;
 }
 
-static bool pm_parseCoordList(const std::string& val, std::vector<std::pair<int,int>>& out){
+static bool pm_parseCoordList(std::string_view val, std::vector<std::pair<int,int>>& out){
     out.clear(); size_t pos = 0;
+    out.reserve((size_t)std::count(val.begin(), val.end(), '('));
     while(pos < val.size()){
         while(pos < val.size() && (val[pos] == ' ' || val[pos] == '\t')) pos++;
         if(pos >= val.size()) break; if(val[pos] != '('){ pos++; continue; } pos++;
@@ -109,22 +314,21 @@ static bool pm_parseCoordList(const std::string& val, std::vector<std::pair<int,
     return !out.empty();
 }
 
-static bool pm_parseKicks(const std::string& v, std::vector<std::pair<int,int>>& out){ return pm_parseCoordList(v,out); }
+static bool pm_parseKicks(std::string_view v, std::vector<std::pair<int,int>>& out){ return pm_parseCoordList(v,out); }
 static void pm_rotate90(std::vector<std::pair<int,int>>& pts){ for(auto& p:pts){ int x=p.first,y=p.second; p.first=-y; p.second=x; } }
 
-static std::string pm_parsePiecesLine(const std::string& line) {
-    size_t semi = line.find(';'); size_t cut = std::string::npos;
-    if (semi != std::string::npos) {
+static std::string_view pm_parsePiecesLine(std::string_view line) {
+    size_t semi = line.find(';'); size_t cut = std::string_view::npos;
+    if (semi != std::string_view::npos) {
         if (semi == 0 || (semi > 0 && line[semi-1] == ' ')) { cut = semi; }
         else {
-            size_t eq_probe = line.find('='); if (eq_probe != std::string::npos && semi > eq_probe) {
+            size_t eq_probe = line.find('='); if (eq_probe != std::string_view::npos && semi > eq_probe) {
                 size_t paren_after_semi = line.find('(', semi);
-                if (paren_after_semi == std::string::npos) { cut = semi; }
+                if (paren_after_semi == std::string_view::npos) { cut = semi; }
             }
         }
     }
-    if (cut != std::string::npos) { std::string result = line; result.resize(cut); return result; }
-    return line;
+    return cut != std::string_view::npos ? line.substr(0, cut) : line;
 }
 
 static void pm_buildPieceRotations(Piece& piece, const std::vector<std::pair<int,int>>& base,
@@ -150,7 +354,7 @@ static void pm_buildPieceRotations(Piece& piece, const std::vector<std::pair<int
     }
 }
 
-static bool pm_processPieceProperty(Piece& cur, const std::string& key, const std::string& val,
+static bool pm_processPieceProperty(Piece& cur, const std::string& key, std::string_view val,
                                     std::vector<std::pair<int,int>>& base,
                                     std::vector<std::pair<int,int>>& rot0,
                                     std::vector<std::pair<int,int>>& rot1,
@@ -158,7 +362,8 @@ static bool pm_processPieceProperty(Piece& cur, const std::string& key, const st
                                     std::vector<std::pair<int,int>>& rot3,
                                     bool& rotExplicit) {
     if (key == "COLOR") { Uint8 r, g, b; if (pm_parseHexColor(val, r, g, b)) { cur.r=r; cur.g=g; cur.b=b; } return true; }
-    if (key == "ROTATIONS") { std::string vv = val; for (char& c : vv) c = (char)std::tolower((unsigned char)c); rotExplicit = (vv == "explicit"); return true; }
+    if (key == "ROTATIONS") { std::string vv(val); for (char& c : vv) c = (char)std::tolower((unsigned char)c); rotExplicit = (vv == "explicit"); return true; }
+    if (key == "WEIGHT") { int w; if (pm_parseInt(val, w) && w >= 0 && w <= 65535) cur.weight = (Uint16)w; return true; }
     if (key == "BASE") { pm_parseCoordList(val, base); return true; }
     if (key == "ROT0") { if (val.rfind("sameas:", 0) == 0) { /* keep rot0 */ } else pm_parseCoordList(val, rot0); rotExplicit = true; return true; }
     if (key == "ROT1") { if (val.rfind("sameas:", 0) == 0) { rot1 = rot0; } else pm_parseCoordList(val, rot1); rotExplicit = true; return true; }
@@ -166,109 +371,87 @@ static bool pm_processPieceProperty(Piece& cur, const std::string& key, const st
     if (key == "ROT3") { if (val.rfind("sameas:", 0) == 0) { rot3 = rot1.empty() ? rot0 : rot1; } else pm_parseCoordList(val, rot3); rotExplicit = true; return true; }
     if (key == "KICKS.CW") { pm_parseKicks(val, cur.kicksCW); cur.hasKicks = true; return true; }
     if (key == "KICKS.CCW") { pm_parseKicks(val, cur.kicksCCW); cur.hasKicks = true; return true; }
-    auto setKPT = [&](int dirIdx, int fromState, const std::string& v) {
+    auto setKPT = [&](int dirIdx, int fromState, std::string_view v) {
         std::vector<std::pair<int,int>> tmp; if (pm_parseCoordList(v, tmp)) { cur.kicksPerTrans[dirIdx][fromState] = tmp; cur.hasPerTransKicks = true; return true; } return false; };
-    if (key.rfind("KICKS.CW.", 0) == 0) { std::string t = key.substr(10); if (t=="0TO1") { setKPT(0,0,val); return true; } if (t=="1TO2") { setKPT(0,1,val); return true; } if (t=="2TO3") { setKPT(0,2,val); return true; } if (t=="3TO0") { setKPT(0,3,val); return true; } }
-    if (key.rfind("KICKS.CCW.", 0) == 0) { std::string t = key.substr(11); if (t=="0TO3") { setKPT(1,0,val); return true; } if (t=="3TO2") { setKPT(1,3,val); return true; } if (t=="2TO1") { setKPT(1,2,val); return true; } if (t=="1TO0") { setKPT(1,1,val); return true; } }
+    if (key.rfind("KICKS.CW.", 0) == 0) { std::string t = key.substr(9); if (t=="0TO1") { setKPT(0,0,val); return true; } if (t=="1TO2") { setKPT(0,1,val); return true; } if (t=="2TO3") { setKPT(0,2,val); return true; } if (t=="3TO0") { setKPT(0,3,val); return true; } }
+    if (key.rfind("KICKS.CCW.", 0) == 0) { std::string t = key.substr(10); if (t=="0TO3") { setKPT(1,0,val); return true; } if (t=="3TO2") { setKPT(1,3,val); return true; } if (t=="2TO1") { setKPT(1,2,val); return true; } if (t=="1TO0") { setKPT(1,1,val); return true; } }
     return false;
 }
 
-bool pm_loadPiecesFromStream(std::istream& in) {
-    PIECES.clear(); g_randomizerType = (RandType)0; g_randBagSize = 0;
-    std::string line, section; Piece cur; bool inPiece = false; bool rotExplicit = false;
+static bool pm_parsePieces(std::istream& in, PieceSet& out) {
+    out = PieceSet{};
+    // Arquivo inteiro num buffer; linhas e campos viram views para dentro dele
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    out.pieces.reserve((size_t)std::count(text.begin(), text.end(), '['));
+    std::string section, K; Piece cur; bool inPiece = false; bool rotExplicit = false;
     std::vector<std::pair<int,int>> rot0, rot1, rot2, rot3, base;
     auto flushPiece = [&]() {
         if (!inPiece) return; pm_buildPieceRotations(cur, base, rot0, rot1, rot2, rot3, rotExplicit);
-        if (!cur.rot.empty()) { PIECES.push_back(cur); }
+        if (!cur.rot.empty()) { compilePieceTables(cur); out.pieces.push_back(std::move(cur)); }
         cur = Piece{}; rotExplicit = false; rot0.clear(); rot1.clear(); rot2.clear(); rot3.clear(); base.clear(); inPiece = false; };
-    while (std::getline(in, line)) {
-        line = pm_parsePiecesLine(line); auto trim = [&](std::string& s){ size_t a=s.find_first_not_of(" \t\r\n"); size_t b=s.find_last_not_of(" \t\r\n"); if (a==std::string::npos) { s.clear(); return; } s=s.substr(a,b-a+1); };
-        trim(line); if (line.empty()) continue;
+    for (size_t pos = 0; pos < text.size(); ) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos) eol = text.size();
+        std::string_view line = pm_trim(pm_parsePiecesLine(std::string_view(text).substr(pos, eol - pos)));
+        pos = eol + 1;
+        if (line.empty()) continue;
         if (line.front() == '[' && line.back() == ']') {
-            std::string sec = line.substr(1, line.size() - 2); std::string SEC = sec; for (char& c : SEC) c = (char)std::toupper((unsigned char)c);
-            if (SEC.rfind("PIECE.", 0) == 0) { flushPiece(); inPiece = true; cur = Piece{}; rotExplicit = false; rot0.clear(); rot1.clear(); rot2.clear(); rot3.clear(); base.clear(); cur.name = sec.substr(6); }
-            else { flushPiece(); inPiece = false; section = SEC; }
+            std::string_view sec = line.substr(1, line.size() - 2); pm_upperInto(sec, K);
+            if (K.rfind("PIECE.", 0) == 0) { flushPiece(); inPiece = true; cur = Piece{}; rotExplicit = false; rot0.clear(); rot1.clear(); rot2.clear(); rot3.clear(); base.clear(); cur.name = std::string(sec.substr(6)); }
+            else { flushPiece(); inPiece = false; section = K; }
             continue;
         }
-        size_t eq = line.find('='); if (eq == std::string::npos) continue;
-        std::string k = line.substr(0, eq), v = line.substr(eq + 1); auto trim2 = [&](std::string& s){ size_t a=s.find_first_not_of(" \t\r\n"); size_t b=s.find_last_not_of(" \t\r\n"); if (a==std::string::npos) { s.clear(); return; } s=s.substr(a,b-a+1); };
-        trim2(k); trim2(v); std::string K = k; for (char& c : K) c = (char)std::toupper((unsigned char)c);
+        size_t eq = line.find('='); if (eq == std::string_view::npos) continue;
+        std::string_view v = pm_trim(line.substr(eq + 1));
+        pm_upperInto(pm_trim(line.substr(0, eq)), K);
         if (inPiece) { if (pm_processPieceProperty(cur, K, v, base, rot0, rot1, rot2, rot3, rotExplicit)) continue; }
         else {
-            if (section == "SET") { if (K == "NAME") { /* optional */ continue; } if (K == "PREVIEWGRID" || K == "PREVIEW_GRID") { int n; if (pm_parseInt(v, n) && n > 0 && n <= 10) g_previewGrid = n; continue; } }
-            if (section == "RANDOMIZER") { if (K == "TYPE") { std::string vv = v; for (char& c : vv) c = (char)std::tolower((unsigned char)c); g_randomizerType = (vv == "bag" ? (RandType)1 : (RandType)0); continue; }
-                if (K == "BAGSIZE") { int n; if (pm_parseInt(v, n) && n >= 0) g_randBagSize = n; continue; } }
+            if (section == "SET") { if (K == "NAME") { /* optional */ continue; } if (K == "PREVIEWGRID" || K == "PREVIEW_GRID") { int n; if (pm_parseInt(v, n) && n > 0 && n <= 10) out.previewGrid = n; continue; }
+                if (K == "RANDOMIZER") { if (!PieceManager::parseRandType(std::string(v), out.randomizerType)) out.randomizerType = RandType::SIMPLE; continue; }
+                if (K == "BAGSIZE") { int n; if (pm_parseInt(v, n) && n >= 0) out.randBagSize = n; continue; } }
+            if (section == "RANDOMIZER") { if (K == "TYPE") { if (!PieceManager::parseRandType(std::string(v), out.randomizerType)) out.randomizerType = RandType::SIMPLE; continue; }
+                if (K == "BAGSIZE") { int n; if (pm_parseInt(v, n) && n >= 0) out.randBagSize = n; continue; } }
         }
     }
-    flushPiece(); return !PIECES.empty();
+    flushPiece(); return !out.pieces.empty();
+}
+
+bool pm_loadPiecesFromStream(std::istream& in) {
+    PieceSet set;
+    bool ok = pm_parsePieces(in, set);
+    PieceManager::installPieceSet(std::move(set));
+    return ok;
+}
+
+bool PieceManager::parsePiecesFile(const std::string& path, PieceSet& out) {
+    std::ifstream f(path.c_str());
+    return f.good() && pm_parsePieces(f, out);
+}
+
+void PieceManager::installPieceSet(PieceSet&& set) {
+    PIECES.swap(set.pieces);
+    rebuildPieceTable(PIECES);
+    if (set.previewGrid > 0) g_previewGrid = set.previewGrid;
+    g_randomizerType = set.randomizerType;
+    g_randBagSize = set.randBagSize;
 }
 
 void PieceManager::seedFallback() {
     SDL_Log("Usando fallback interno de peças.");
-    PIECES.clear();
-    auto rotate90 = [](std::vector<std::pair<int,int>>& pts){
-        for (auto& p : pts) { int x = p.first, y = p.second; p.first = -y; p.second = x; }
-    };
-    auto mk = [&](const char* name, std::initializer_list<std::pair<int,int>> c, Uint8 r, Uint8 g, Uint8 b){
-        Piece p; p.name = name; p.r=r; p.g=g; p.b=b; 
-        for (auto& coord : c) p.rot[0].push_back(coord);
-        // Build 4 rotations from base
-        p.rot[1] = p.rot[0]; rotate90(p.rot[1]);
-        p.rot[2] = p.rot[1]; rotate90(p.rot[2]);
-        p.rot[3] = p.rot[2]; rotate90(p.rot[3]);
-        return p; };
-
-    // 7 tetrominós padrão (Guideline)
-    PIECES.push_back(mk("I", {{0,0},{1,0},{2,0},{3,0}}, 80,120,220));
-    PIECES.push_back(mk("O", {{0,0},{1,0},{0,1},{1,1}}, 220,180,80));
-    PIECES.push_back(mk("T", {{0,0},{1,0},{2,0},{1,1}}, 160,80,220));
-    PIECES.push_back(mk("S", {{1,0},{2,0},{0,1},{1,1}}, 80,220,80));
-    PIECES.push_back(mk("Z", {{0,0},{1,0},{1,1},{2,1}}, 220,80,80));
-    PIECES.push_back(mk("L", {{0,0},{0,1},{0,2},{1,2}}, 220,160,80));
-    PIECES.push_back(mk("J", {{1,0},{1,1},{1,2},{0,2}}, 80,180,220));
-
-    // SRS kicks oficiais (fallback) para JLSTZ
-    auto setJLSTZ = [](Piece& p){
-        p.hasPerTransKicks = true;
-        // CW (dirIdx=0)
-        p.kicksPerTrans[0][0] = {{0,0},{-1,0},{-1,1},{0,-2},{-1,-2}}; // 0->1
-        p.kicksPerTrans[0][1] = {{0,0},{1,0},{1,-1},{0,2},{1,2}};     // 1->2
-        p.kicksPerTrans[0][2] = {{0,0},{1,0},{1,1},{0,-2},{1,-2}};    // 2->3
-        p.kicksPerTrans[0][3] = {{0,0},{-1,0},{-1,-1},{0,2},{-1,2}};  // 3->0
-        // CCW (dirIdx=1)
-        p.kicksPerTrans[1][0] = {{0,0},{1,0},{1,1},{0,-2},{1,-2}};    // 0->3
-        p.kicksPerTrans[1][3] = {{0,0},{1,0},{1,-1},{0,2},{1,2}};     // 3->2
-        p.kicksPerTrans[1][2] = {{0,0},{-1,0},{-1,1},{0,-2},{-1,-2}}; // 2->1
-        p.kicksPerTrans[1][1] = {{0,0},{-1,0},{-1,-1},{0,2},{-1,2}};  // 1->0
-    };
-
-    // SRS kicks oficiais (fallback) para I
-    auto setI = [](Piece& p){
-        p.hasPerTransKicks = true;
-        // CW (dirIdx=0)
-        p.kicksPerTrans[0][0] = {{0,0},{-2,0},{1,0},{-2,-1},{1,2}};   // 0->1
-        p.kicksPerTrans[0][1] = {{0,0},{-1,0},{2,0},{-1,2},{2,-1}};   // 1->2
-        p.kicksPerTrans[0][2] = {{0,0},{2,0},{-1,0},{2,1},{-1,-2}};   // 2->3
-        p.kicksPerTrans[0][3] = {{0,0},{1,0},{-2,0},{1,-2},{-2,1}};   // 3->0
-        // CCW (dirIdx=1)
-        p.kicksPerTrans[1][0] = {{0,0},{-1,0},{2,0},{-1,2},{2,-1}};   // 0->3
-        p.kicksPerTrans[1][3] = {{0,0},{-2,0},{1,0},{-2,-1},{1,2}};   // 3->2
-        p.kicksPerTrans[1][2] = {{0,0},{1,0},{-2,0},{1,-2},{-2,1}};   // 2->1
-        p.kicksPerTrans[1][1] = {{0,0},{2,0},{-1,0},{2,1},{-1,-2}};   // 1->0
-    };
-
-    // Aplicar kicks aos respectivos tetrominós
-    for (auto& p : PIECES) {
-        if (p.name == "I") setI(p);
-        else if (p.name == "O") { /* O não precisa; rotação não altera shape */ }
-        else setJLSTZ(p);
-    }
+    installBuiltinSet();
+}
+
+void PieceManager::installBuiltinSet() {
+    PieceSet set;
+    BuiltinPieces::build(set);
+    installPieceSet(std::move(set));
+    loadedPath_.clear();
 }
 
 void PieceManager::initializeRandomizer() {
-    // Default randomizer settings (SIMPLE, full bag)
-    g_randomizerType = (RandType)0; // SIMPLE
-    g_randBagSize = 0;
+    // O tipo e o tamanho do bag vêm do [RANDOMIZER] do .pieces (installPieceSet);
+    // aqui só recomeça o estado do sorteio desta instância
+    resetDrawState();
 }
 
 
@@ -0,0 +1,115 @@
+#include "pieces/PieceRng.hpp"
+
+#include <cctype>
+
+namespace {
+
+// Espalha a semente pelos 128 bits de estado (recomendado pelos autores do xoshiro)
+uint64_t splitmix64(uint64_t& s) {
+    uint64_t z = (s += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+PieceRng::PieceRng(RngType type, uint64_t seed) : type_(type) {
+    this->seed(seed);
+}
+
+PieceRng::PieceRng(const PieceRng& other) : type_(other.type_) {
+    restore(other.save());
+}
+
+PieceRng& PieceRng::operator=(const PieceRng& other) {
+    if (this != &other) restore(other.save());
+    return *this;
+}
+
+void PieceRng::setType(RngType type) {
+    type_ = type;
+    seed(seed_);
+}
+
+void PieceRng::seed(uint64_t seed) {
+    seed_ = seed;
+    switch (type_) {
+        case RngType::PCG: {
+            // pcg32_srandom(seed, seq) com a sequência padrão da referência
+            pcgInc_ = (0xDA3E39CB94B95BDBull << 1) | 1u;
+            pcgState_ = 0;
+            nextPcg();
+            pcgState_ += seed;
+            nextPcg();
+            break;
+        }
+        case RngType::MT19937:
+            if (!mt_) mt_.reset(new std::mt19937());
+            mt_->seed((std::mt19937::result_type)seed);
+            break;
+        default: {
+            uint64_t s = seed;
+            xa_ = splitmix64(s);
+            xb_ = splitmix64(s);
+            if (!(xa_ | xb_)) xa_ = 1;  // Estado todo zero é ponto fixo
+            break;
+        }
+    }
+}
+
+RngState PieceRng::save() const {
+    RngState st;
+    st.type = type_;
+    st.seed = seed_;
+    switch (type_) {
+        case RngType::PCG:
+            st.words[0] = pcgState_;
+            st.words[1] = pcgInc_;
+            break;
+        case RngType::MT19937:
+            st.mt = std::make_shared<const std::mt19937>(*mt_);
+            break;
+        default:
+            st.words[0] = xa_;
+            st.words[1] = xb_;
+            break;
+    }
+    return st;
+}
+
+void PieceRng::restore(const RngState& st) {
+    type_ = st.type;
+    seed_ = st.seed;
+    switch (type_) {
+        case RngType::PCG:
+            pcgState_ = st.words[0];
+            pcgInc_ = st.words[1];
+            break;
+        case RngType::MT19937:
+            if (st.mt) mt_.reset(new std::mt19937(*st.mt));
+            else seed(seed_);
+            break;
+        default:
+            xa_ = st.words[0];
+            xb_ = st.words[1];
+            break;
+    }
+}
+
+const char* PieceRng::typeName(RngType type) {
+    switch (type) {
+        case RngType::PCG: return "pcg";
+        case RngType::MT19937: return "mt19937";
+        default: return "xoshiro";
+    }
+}
+
+bool PieceRng::parseType(const std::string& name, RngType& out) {
+    std::string v = name;
+    for (char& c : v) c = (char)std::tolower((unsigned char)c);
+    if (v == "xoshiro" || v == "xoshiro128++") { out = RngType::XOSHIRO; return true; }
+    if (v == "pcg" || v == "pcg32") { out = RngType::PCG; return true; }
+    if (v == "mt19937" || v == "mt") { out = RngType::MT19937; return true; }
+    return false;
+}
@@ -0,0 +1,67 @@
+#include "pieces/PieceTable.hpp"
+#include "pieces/Piece.hpp"
+#include <algorithm>
+
+namespace {
+// Vose em inteiros: scaled[i] = peso * n contra o total, sem float (mesma tabela em qualquer máquina)
+void buildAliasTable(const std::vector<Piece>& pieces, PieceTable& t) {
+    const size_t n = pieces.size();
+    t.aliasProb.assign(n, 0xFFFFFFFFu);
+    t.alias.resize(n);
+    for (size_t i = 0; i < n; ++i) t.alias[i] = (int)i;
+    uint64_t total = 0;
+    for (const Piece& p : pieces) total += p.weight;
+    if (n == 0 || total == 0) return;
+
+    std::vector<uint64_t> scaled(n);
+    std::vector<int> small, large;
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = (uint64_t)pieces[i].weight * n;
+        (scaled[i] < total ? small : large).push_back((int)i);
+    }
+    while (!small.empty() && !large.empty()) {
+        const int l = small.back(); small.pop_back();
+        const int g = large.back();
+        t.aliasProb[l] = (uint32_t)((scaled[l] << 32) / total);
+        t.alias[l] = g;
+        scaled[g] -= total - scaled[l];
+        if (scaled[g] < total) { large.pop_back(); small.push_back(g); }
+    }
+    // Sobras (só arredondamento): ficam com a própria coluna
+}
+}
+
+void rebuildPieceTable(const std::vector<Piece>& pieces) {
+    PieceTable& t = PIECE_TABLE;
+    const size_t slots = pieces.size() * 4;
+    size_t cells = 0;
+    for (const Piece& p : pieces) for (const auto& r : p.rot) cells += r.size();
+
+    t.cellX.clear(); t.cellY.clear();
+    t.cellX.reserve(cells); t.cellY.reserve(cells);
+    t.rotBegin.assign(slots + 1, 0);
+    t.minX.assign(slots, 0); t.minY.assign(slots, 0);
+    t.maxX.assign(slots, -1); t.maxY.assign(slots, -1);
+
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        for (int r = 0; r < 4; ++r) {
+            const size_t s = (size_t)PieceTable::slot((int)i, r);
+            t.rotBegin[s] = (uint32_t)t.cellX.size();
+            if (r >= (int)pieces[i].rot.size()) continue;
+            const auto& rot = pieces[i].rot[r];
+            if (rot.empty()) continue;
+            int minX = rot[0].first, maxX = minX, minY = rot[0].second, maxY = minY;
+            for (auto [x, y] : rot) {
+                t.cellX.push_back((int16_t)x);
+                t.cellY.push_back((int16_t)y);
+                minX = std::min(minX, x); maxX = std::max(maxX, x);
+                minY = std::min(minY, y); maxY = std::max(maxY, y);
+            }
+            t.minX[s] = (int16_t)minX; t.maxX[s] = (int16_t)maxX;
+            t.minY[s] = (int16_t)minY; t.maxY[s] = (int16_t)maxY;
+        }
+    }
+    t.rotBegin[slots] = (uint32_t)t.cellX.size();
+    buildAliasTable(pieces, t);
+    ++t.generation;
+}
@@ -0,0 +1,135 @@
+#include "render/CellSkin.hpp"
+#include "render/TexturePool.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+#include <vector>
+
+extern std::string CELL_SKIN;  // global visual option from config
+
+namespace {
+
+constexpr int TILE = 32;            // Tile procedural (escala linear até o tamanho da célula)
+
+CellSkin g_skin;
+SDL_Renderer* g_skinRen = nullptr;
+std::string g_skinSpec = "flat";    // O que está montado (ou falhou) para g_skinRen
+bool g_skinFailed = false;
+Uint32 g_skinGeneration = 0;
+Uint32 g_skinEpoch = 0;             // TexturePool::deviceEpoch() do atlas
+
+inline Uint32 gray(int v) {
+    const Uint32 c = (Uint32)std::max(0, std::min(255, v));
+    return (c << 24) | (c << 16) | (c << 8) | 0xFFu;
+}
+
+// Bevel: borda clara em cima/esquerda, escura embaixo/direita, miolo um pouco abaixo do branco
+void paintBevel(std::vector<Uint32>& px, int stride) {
+    const int edge = 4;
+    for (int y = 0; y < TILE; ++y) {
+        for (int x = 0; x < TILE; ++x) {
+            const int lightSide = std::min(x, y), darkSide = std::min(TILE - 1 - x, TILE - 1 - y);
+            int v = 225;
+            if (std::min(lightSide, darkSide) < edge) v = lightSide <= darkSide ? 255 : 140;
+            px[(size_t)y * stride + x] = gray(v);
+        }
+    }
+}
+
+// Gloss: reflexo na metade de cima, gradiente escurecendo embaixo, aro de 1px
+void paintGloss(std::vector<Uint32>& px, int stride) {
+    for (int y = 0; y < TILE; ++y) {
+        for (int x = 0; x < TILE; ++x) {
+            int v;
+            if (y < TILE / 2) v = 255 - (y * 30) / (TILE / 2);
+            else v = 200 - ((y - TILE / 2) * 40) / (TILE / 2);
+            if (x == 0 || y == 0) v = 255;
+            if (x == TILE - 1 || y == TILE - 1) v = 120;
+            px[(size_t)y * stride + x] = gray(v);
+        }
+    }
+}
+
+// .bmp do usuário convertido para RGBA8888 (cores valem como multiplicador da peça)
+bool paintImage(const std::string& path, std::vector<Uint32>& px, int& w, int& h) {
+    SDL_Surface* loaded = SDL_LoadBMP(path.c_str());
+    if (!loaded) return false;
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA8888, 0);
+    SDL_FreeSurface(loaded);
+    if (!rgba) return false;
+    w = rgba->w;
+    h = rgba->h;
+    px.assign((size_t)(w + 1) * h, 0u);
+    SDL_LockSurface(rgba);
+    for (int y = 0; y < h; ++y) {
+        const Uint32* row = (const Uint32*)((const Uint8*)rgba->pixels + (size_t)y * rgba->pitch);
+        std::copy(row, row + w, &px[(size_t)y * (w + 1)]);
+    }
+    SDL_UnlockSurface(rgba);
+    SDL_FreeSurface(rgba);
+    return w > 0 && h > 0;
+}
+
+bool buildSkin(SDL_Renderer* ren, const std::string& spec) {
+    // Atlas = tile + uma coluna branca à direita (texel das células lisas)
+    std::vector<Uint32> px;
+    int w = TILE, h = TILE;
+    if (spec == "bevel" || spec == "gloss") {
+        px.assign((size_t)(w + 1) * h, 0u);
+        if (spec == "bevel") paintBevel(px, w + 1);
+        else paintGloss(px, w + 1);
+    } else if (!paintImage(spec, px, w, h)) {
+        DebugLogger::warning("CELL_SKIN: cannot load '" + spec + "' (" + SDL_GetError() + "), flat cells");
+        return false;
+    }
+    const int stride = w + 1;
+    for (int y = 0; y < h; ++y) px[(size_t)y * stride + w] = 0xFFFFFFFFu;
+
+    SDL_Texture* tex = renderTargetPool().create(ren, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, stride, h, TextureUse::SKIN);
+    if (!tex) {
+        DebugLogger::warning("CELL_SKIN: atlas texture failed (" + std::string(SDL_GetError()) + "), flat cells");
+        return false;
+    }
+    SDL_UpdateTexture(tex, nullptr, px.data(), stride * (int)sizeof(Uint32));
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(tex, SDL_ScaleModeLinear);
+
+    // Meio texel para dentro: o filtro linear não mistura o tile com a coluna branca
+    const float tw = (float)stride, th = (float)h;
+    g_skin.texture = tex;
+    g_skin.blockUV = {0.5f / tw, 0.5f / th, (w - 1.0f) / tw, (h - 1.0f) / th};
+    g_skin.flatUV = {(w + 0.5f) / tw, 0.5f / th, 0.f, 0.f};
+    g_skin.generation = ++g_skinGeneration;
+    DebugLogger::info("CELL_SKIN: " + spec + " (" + std::to_string(w) + "x" + std::to_string(h) + " tile)");
+    return true;
+}
+
+} // namespace
+
+const CellSkin* acquireCellSkin(SDL_Renderer* ren) {
+    if (!ren) return nullptr;
+    // Device perdido também remonta: generation nova refaz o stack do tabuleiro
+    if (ren != g_skinRen || CELL_SKIN != g_skinSpec || g_skinEpoch != renderTargetPool().deviceEpoch()) {
+        releaseCellSkin();
+        g_skinRen = ren;
+        g_skinSpec = CELL_SKIN;
+        g_skinEpoch = renderTargetPool().deviceEpoch();
+        g_skinFailed = g_skinSpec.empty() || g_skinSpec == "flat" || !buildSkin(ren, g_skinSpec);
+    }
+    return g_skinFailed ? nullptr : &g_skin;
+}
+
+void disableCellSkin() {
+    if (g_skinFailed) return;
+    DebugLogger::warning("CELL_SKIN: SDL_RenderGeometry unavailable, flat cells: " + std::string(SDL_GetError()));
+    renderTargetPool().release(g_skin.texture);
+    g_skin.texture = nullptr;
+    g_skinFailed = true;
+}
+
+void releaseCellSkin() {
+    renderTargetPool().release(g_skin.texture);
+    g_skin = CellSkin{};
+    g_skinRen = nullptr;
+    g_skinSpec = "flat";
+    g_skinFailed = false;
+}
@@ -0,0 +1,361 @@
+#include "render/CrtShader.hpp"
+#include "render/GameStateBridge.hpp"
+#include "render/Layers.hpp"
+#include "render/LayoutCache.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
+#include "DebugLogger.hpp"
+
+#include <SDL2/SDL_opengl.h>
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Só o subconjunto comum a OpenGL 2.0 e OpenGL ES 2.0, carregado em runtime
+struct CrtShader::Gl {
+    GLuint (APIENTRY* CreateShader)(GLenum) = nullptr;
+    void (APIENTRY* ShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*) = nullptr;
+    void (APIENTRY* CompileShader)(GLuint) = nullptr;
+    void (APIENTRY* GetShaderiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY* GetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = nullptr;
+    void (APIENTRY* DeleteShader)(GLuint) = nullptr;
+    GLuint (APIENTRY* CreateProgram)() = nullptr;
+    void (APIENTRY* AttachShader)(GLuint, GLuint) = nullptr;
+    void (APIENTRY* BindAttribLocation)(GLuint, GLuint, const GLchar*) = nullptr;
+    void (APIENTRY* LinkProgram)(GLuint) = nullptr;
+    void (APIENTRY* GetProgramiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY* GetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = nullptr;
+    void (APIENTRY* DeleteProgram)(GLuint) = nullptr;
+    void (APIENTRY* UseProgram)(GLuint) = nullptr;
+    GLint (APIENTRY* GetUniformLocation)(GLuint, const GLchar*) = nullptr;
+    void (APIENTRY* Uniform1i)(GLint, GLint) = nullptr;
+    void (APIENTRY* Uniform1f)(GLint, GLfloat) = nullptr;
+    void (APIENTRY* Uniform2f)(GLint, GLfloat, GLfloat) = nullptr;
+    void (APIENTRY* Uniform3f)(GLint, GLfloat, GLfloat, GLfloat) = nullptr;
+    void (APIENTRY* Uniform4f)(GLint, GLfloat, GLfloat, GLfloat, GLfloat) = nullptr;
+    void (APIENTRY* VertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = nullptr;
+    void (APIENTRY* EnableVertexAttribArray)(GLuint) = nullptr;
+    void (APIENTRY* DisableVertexAttribArray)(GLuint) = nullptr;
+    void (APIENTRY* GetVertexAttribiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY* BindBuffer)(GLenum, GLuint) = nullptr;
+    void (APIENTRY* ActiveTexture)(GLenum) = nullptr;
+    void (APIENTRY* BindTexture)(GLenum, GLuint) = nullptr;
+    void (APIENTRY* GetIntegerv)(GLenum, GLint*) = nullptr;
+    GLboolean (APIENTRY* IsEnabled)(GLenum) = nullptr;
+    void (APIENTRY* Enable)(GLenum) = nullptr;
+    void (APIENTRY* Disable)(GLenum) = nullptr;
+    void (APIENTRY* Viewport)(GLint, GLint, GLsizei, GLsizei) = nullptr;
+    void (APIENTRY* DrawArrays)(GLenum, GLint, GLsizei) = nullptr;
+
+    bool load() {
+        bool ok = true;
+        auto get = [&ok](auto& fn, const char* name) {
+            fn = reinterpret_cast<typename std::remove_reference<decltype(fn)>::type>(SDL_GL_GetProcAddress(name));
+            if (!fn) ok = false;
+        };
+        get(CreateShader, "glCreateShader"); get(ShaderSource, "glShaderSource");
+        get(CompileShader, "glCompileShader"); get(GetShaderiv, "glGetShaderiv");
+        get(GetShaderInfoLog, "glGetShaderInfoLog"); get(DeleteShader, "glDeleteShader");
+        get(CreateProgram, "glCreateProgram"); get(AttachShader, "glAttachShader");
+        get(BindAttribLocation, "glBindAttribLocation"); get(LinkProgram, "glLinkProgram");
+        get(GetProgramiv, "glGetProgramiv"); get(GetProgramInfoLog, "glGetProgramInfoLog");
+        get(DeleteProgram, "glDeleteProgram"); get(UseProgram, "glUseProgram");
+        get(GetUniformLocation, "glGetUniformLocation"); get(Uniform1i, "glUniform1i");
+        get(Uniform1f, "glUniform1f"); get(Uniform2f, "glUniform2f");
+        get(Uniform3f, "glUniform3f"); get(Uniform4f, "glUniform4f");
+        get(VertexAttribPointer, "glVertexAttribPointer"); get(EnableVertexAttribArray, "glEnableVertexAttribArray");
+        get(DisableVertexAttribArray, "glDisableVertexAttribArray"); get(GetVertexAttribiv, "glGetVertexAttribiv");
+        get(BindBuffer, "glBindBuffer"); get(ActiveTexture, "glActiveTexture");
+        get(BindTexture, "glBindTexture"); get(GetIntegerv, "glGetIntegerv");
+        get(IsEnabled, "glIsEnabled"); get(Enable, "glEnable"); get(Disable, "glDisable");
+        get(Viewport, "glViewport"); get(DrawArrays, "glDrawArrays");
+        return ok;
+    }
+};
+
+namespace {
+    constexpr GLuint kAttrPosition = 0;
+    constexpr GLuint kAttrTexCoord = 1;
+
+    // GLSL 1.10 / GLSL ES 1.00: o mesmo texto compila nos dois backends do SDL
+    const char* kVertexSource =
+        "attribute vec2 a_position;\n"
+        "attribute vec2 a_texCoord;\n"
+        "varying vec2 v_uv;\n"
+        "void main() {\n"
+        "    v_uv = a_texCoord;\n"
+        "    gl_Position = vec4(a_position, 0.0, 1.0);\n"
+        "}\n";
+
+    const char* kFragmentSource =
+        "#ifdef GL_ES\n"
+        "#ifdef GL_FRAGMENT_PRECISION_HIGH\n"
+        "precision highp float;\n"
+        "#else\n"
+        "precision mediump float;\n"
+        "#endif\n"
+        "#endif\n"
+        "uniform sampler2D u_scene;\n"
+        "uniform vec2 u_uvScale;\n"     // Coordenada máxima da textura (SDL_GL_BindTexture)
+        "uniform vec2 u_size;\n"        // Cena em pixels
+        "uniform vec4 u_area;\n"        // Área virtual: x, y, w, h (origem no topo)
+        "uniform float u_scanline;\n"   // SCANLINE_ALPHA / 255
+        "uniform vec3 u_sweep;\n"       // Topo da banda (relativo à área), altura, SWEEP_G_ALPHA_MAX / 255
+        "uniform float u_sweepSigma;\n"
+        "uniform float u_curvature;\n"
+        "uniform float u_vignette;\n"
+        "uniform float u_glow;\n"
+        "varying vec2 v_uv;\n"          // (0,0) = canto superior esquerdo da cena
+        "vec3 scene(vec2 px) { return texture2D(u_scene, px / u_size * u_uvScale).rgb; }\n"
+        "void main() {\n"
+        "    vec2 px = v_uv * u_size;\n"
+        "    vec2 q = (px - u_area.xy) / u_area.zw;\n"
+        "    if (q.x < 0.0 || q.y < 0.0 || q.x > 1.0 || q.y > 1.0) { gl_FragColor = vec4(scene(px), 1.0); return; }\n"
+        "    vec2 c = q * 2.0 - 1.0;\n"
+        "    c += c * (c.yx * c.yx) * (0.25 * u_curvature);\n"
+        "    if (abs(c.x) > 1.0 || abs(c.y) > 1.0) { gl_FragColor = vec4(0.0, 0.0, 0.0, 1.0); return; }\n"
+        "    q = c * 0.5 + 0.5;\n"
+        "    px = u_area.xy + q * u_area.zw;\n"
+        "    vec3 col = scene(px);\n"
+        "    if (u_glow > 0.0) {\n"
+        "        vec3 sum = vec3(0.0);\n"
+        "        for (int i = 0; i < 8; ++i) {\n"
+        "            float a = float(i) * 0.785398;\n"
+        "            sum += max(scene(px + vec2(cos(a), sin(a)) * 2.5) - 0.55, 0.0);\n"
+        "        }\n"
+        "        col += sum * (u_glow * 0.25);\n"
+        "    }\n"
+        "    float ly = px.y - u_area.y;\n"
+        "    if (mod(floor(ly), 2.0) < 1.0) col *= 1.0 - u_scanline;\n"
+        "    if (u_sweep.y > 0.0) {\n"
+        "        float t = (ly - u_sweep.x) / u_sweep.y;\n"
+        "        if (t >= 0.0 && t < 1.0) {\n"
+        "            float d = (t - 0.5) * 2.0;\n"
+        "            col += vec3(u_sweep.z * exp(-(d * d) / (2.0 * u_sweepSigma * u_sweepSigma)));\n"
+        "        }\n"
+        "    }\n"
+        "    float vig = 16.0 * q.x * q.y * (1.0 - q.x) * (1.0 - q.y);\n"
+        "    col *= mix(1.0, pow(vig, 0.35), u_vignette);\n"
+        "    gl_FragColor = vec4(clamp(col, 0.0, 1.0), 1.0);\n"
+        "}\n";
+
+    std::string shaderLog(CrtShader::Gl& gl, GLuint shader) {
+        GLint len = 0;
+        gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &len);
+        std::vector<GLchar> log((size_t)std::max(1, len));
+        gl.GetShaderInfoLog(shader, (GLsizei)log.size(), nullptr, log.data());
+        return std::string(log.data());
+    }
+
+    GLuint compile(CrtShader::Gl& gl, GLenum type, const char* source, std::string& error) {
+        GLuint shader = gl.CreateShader(type);
+        if (!shader) { error = "glCreateShader"; return 0; }
+        gl.ShaderSource(shader, 1, &source, nullptr);
+        gl.CompileShader(shader);
+        GLint ok = GL_FALSE;
+        gl.GetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (ok != GL_TRUE) {
+            error = shaderLog(gl, shader);
+            gl.DeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+}
+
+CrtShader::CrtShader() = default;
+
+CrtShader::~CrtShader() {
+    release();
+}
+
+void CrtShader::fail(const std::string& why) {
+    failed_ = true;
+    failure_ = why;
+    DebugLogger::warning("CRT_SHADER indisponivel (" + why + "); scanlines e sweep voltam para o PostEffectsLayer");
+}
+
+bool CrtShader::init(SDL_Renderer* renderer) {
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) != 0 || !info.name) { fail("SDL_GetRendererInfo"); return false; }
+    driver_ = info.name;
+    if (driver_ != "opengl" && driver_ != "opengles2") { fail("renderer " + driver_ + " sem GL"); return false; }
+    if (!(info.flags & SDL_RENDERER_TARGETTEXTURE)) { fail("sem render targets"); return false; }
+    if (!SDL_GL_GetCurrentContext()) { fail("sem contexto GL"); return false; }
+
+    gl_.reset(new Gl);
+    if (!gl_->load()) { fail("funcoes GL 2.0 ausentes"); return false; }
+    Gl& gl = *gl_;
+
+    // O SDL guarda o programa atual em cache: volta para ele depois do link
+    GLint prevProgram = 0;
+    gl.GetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
+
+    std::string error;
+    GLuint vs = compile(gl, GL_VERTEX_SHADER, kVertexSource, error);
+    GLuint fs = vs ? compile(gl, GL_FRAGMENT_SHADER, kFragmentSource, error) : 0;
+    if (!vs || !fs) {
+        if (vs) gl.DeleteShader(vs);
+        fail("GLSL: " + error);
+        return false;
+    }
+    GLuint program = gl.CreateProgram();
+    gl.AttachShader(program, vs);
+    gl.AttachShader(program, fs);
+    gl.BindAttribLocation(program, kAttrPosition, "a_position");
+    gl.BindAttribLocation(program, kAttrTexCoord, "a_texCoord");
+    gl.LinkProgram(program);
+    gl.DeleteShader(vs);   // Ficam até o programa sair
+    gl.DeleteShader(fs);
+    GLint linked = GL_FALSE;
+    gl.GetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        GLint len = 0;
+        gl.GetProgramiv(program, GL_INFO_LOG_LENGTH, &len);
+        std::vector<GLchar> log((size_t)std::max(1, len));
+        gl.GetProgramInfoLog(program, (GLsizei)log.size(), nullptr, log.data());
+        gl.DeleteProgram(program);
+        fail("link: " + std::string(log.data()));
+        return false;
+    }
+
+    program_ = program;
+    locScene_ = gl.GetUniformLocation(program, "u_scene");
+    locUvScale_ = gl.GetUniformLocation(program, "u_uvScale");
+    locSize_ = gl.GetUniformLocation(program, "u_size");
+    locArea_ = gl.GetUniformLocation(program, "u_area");
+    locScanline_ = gl.GetUniformLocation(program, "u_scanline");
+    locSweep_ = gl.GetUniformLocation(program, "u_sweep");
+    locSweepSigma_ = gl.GetUniformLocation(program, "u_sweepSigma");
+    locCurvature_ = gl.GetUniformLocation(program, "u_curvature");
+    locVignette_ = gl.GetUniformLocation(program, "u_vignette");
+    locGlow_ = gl.GetUniformLocation(program, "u_glow");
+    gl.UseProgram((GLuint)prevProgram);
+    DebugLogger::info("CRT_SHADER: GLSL pass on " + driver_);
+    return true;
+}
+
+bool CrtShader::begin(SDL_Renderer* renderer, const VisualEffectsView& fx, int w, int h) {
+    active_ = false;
+    if (!fx.crtShader || failed_ || !renderer || w <= 0 || h <= 0) return false;
+    if (!program_ && !init(renderer)) return false;
+
+    if (!scene_ || w != w_ || h != h_ || sceneEpoch_ != renderTargetPool().deviceEpoch()) {
+        renderTargetPool().release(scene_);
+        scene_ = renderTargetPool().create(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h, TextureUse::CRT);
+        sceneEpoch_ = renderTargetPool().deviceEpoch();
+        if (!scene_) { fail(std::string("textura da cena: ") + SDL_GetError()); return false; }
+        SDL_SetTextureBlendMode(scene_, SDL_BLENDMODE_NONE);
+        w_ = w;
+        h_ = h;
+    }
+    prevTarget_ = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, scene_) != 0) { fail(std::string("SDL_SetRenderTarget: ") + SDL_GetError()); return false; }
+    active_ = true;
+    return true;
+}
+
+void CrtShader::end(SDL_Renderer* renderer, const LayoutCache& layout, const VisualEffectsView& fx) {
+    if (!active_) return;
+    active_ = false;
+
+    // Volta para o alvo anterior e esvazia a fila do SDL: daqui para frente é GL direto
+    SDL_SetRenderTarget(renderer, prevTarget_);
+    SDL_RenderFlush(renderer);
+    int outW = w_, outH = h_;
+    if (prevTarget_) SDL_QueryTexture(prevTarget_, nullptr, nullptr, &outW, &outH);
+    else SDL_GetRendererOutputSize(renderer, &outW, &outH);
+
+    Gl& gl = *gl_;
+    GLint prevActive = GL_TEXTURE0, prevTexture = 0;
+    gl.GetIntegerv(GL_ACTIVE_TEXTURE, &prevActive);
+    gl.ActiveTexture(GL_TEXTURE0);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_2D, &prevTexture);
+    const bool desktop = driver_ == "opengl";
+    const GLboolean prevTexturing = desktop ? gl.IsEnabled(GL_TEXTURE_2D) : GL_FALSE;
+    float uvW = 1.0f, uvH = 1.0f;
+    const bool bound = SDL_GL_BindTexture(scene_, &uvW, &uvH) == 0;
+    if (!bound || uvW > 1.5f || uvH > 1.5f) {
+        // Sem textura 2D normalizada (GL_TEXTURE_RECTANGLE): este frame sai sem efeitos
+        const std::string why = bound ? "textura retangular" : std::string("SDL_GL_BindTexture: ") + SDL_GetError();
+        if (bound) SDL_GL_UnbindTexture(scene_);
+        gl.BindTexture(GL_TEXTURE_2D, (GLuint)prevTexture);
+        gl.ActiveTexture((GLenum)prevActive);
+        fail(why);
+        DrawCalls::copy(renderer, scene_, nullptr, nullptr);
+        return;
+    }
+
+    // Estado que o SDL guarda em cache e que este draw mexe
+    GLint prevProgram = 0, prevBuffer = 0, prevViewport[4] = {0, 0, 0, 0};
+    gl.GetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
+    gl.GetIntegerv(GL_ARRAY_BUFFER_BINDING, &prevBuffer);
+    gl.GetIntegerv(GL_VIEWPORT, prevViewport);
+    const GLboolean prevBlend = gl.IsEnabled(GL_BLEND);
+    const GLboolean prevScissor = gl.IsEnabled(GL_SCISSOR_TEST);
+    GLint prevAttr[2] = {0, 0};
+    gl.GetVertexAttribiv(kAttrPosition, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &prevAttr[0]);
+    gl.GetVertexAttribiv(kAttrTexCoord, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &prevAttr[1]);
+
+    const float areaX = (float)layout.offsetX, areaY = (float)layout.offsetY;
+    const float areaW = (float)(int)(layout.virtualWidth * layout.scaleX);
+    const float areaH = (float)(int)(layout.virtualHeight * layout.scaleY);
+    int sweepY = 0, bandH = 0;
+    if (!fx.globalSweep || !postEffectsSweepBand(layout, fx, sweepY, bandH)) bandH = 0;
+
+    gl.UseProgram(program_);
+    gl.Uniform1i(locScene_, 0);
+    gl.Uniform2f(locUvScale_, uvW, uvH);
+    gl.Uniform2f(locSize_, (GLfloat)w_, (GLfloat)h_);
+    gl.Uniform4f(locArea_, areaX, areaY, areaW > 0.0f ? areaW : 1.0f, areaH > 0.0f ? areaH : 1.0f);
+    gl.Uniform1f(locScanline_, (GLfloat)fx.scanlineAlpha / 255.0f);
+    gl.Uniform3f(locSweep_, (GLfloat)sweepY, (GLfloat)bandH, (GLfloat)fx.sweepGAlphaMax / 255.0f);
+    gl.Uniform1f(locSweepSigma_, 0.3f + (1.0f - fx.sweepGSoftness) * 0.4f);   // Mesmo sigma do PostEffectsLayer
+    gl.Uniform1f(locCurvature_, fx.crtCurvature);
+    gl.Uniform1f(locVignette_, fx.crtVignette);
+    gl.Uniform1f(locGlow_, fx.crtGlow);
+
+    // Textura do alvo do SDL tem a linha 0 no topo; na janela o topo é y = +1
+    const float top = prevTarget_ ? 0.0f : 1.0f, bottom = 1.0f - top;
+    const GLfloat positions[8] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+    const GLfloat texCoords[8] = {0.0f, top, 1.0f, top, 0.0f, bottom, 1.0f, bottom};
+    gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    gl.Viewport(0, 0, outW, outH);
+    gl.Disable(GL_BLEND);
+    gl.Disable(GL_SCISSOR_TEST);
+    gl.VertexAttribPointer(kAttrPosition, 2, GL_FLOAT, GL_FALSE, 0, positions);
+    gl.VertexAttribPointer(kAttrTexCoord, 2, GL_FLOAT, GL_FALSE, 0, texCoords);
+    gl.EnableVertexAttribArray(kAttrPosition);
+    gl.EnableVertexAttribArray(kAttrTexCoord);
+    gl.DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    DrawCalls::add();
+
+    if (!prevAttr[0]) gl.DisableVertexAttribArray(kAttrPosition);
+    if (!prevAttr[1]) gl.DisableVertexAttribArray(kAttrTexCoord);
+    if (prevScissor) gl.Enable(GL_SCISSOR_TEST);
+    if (prevBlend) gl.Enable(GL_BLEND);
+    gl.Viewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    gl.BindBuffer(GL_ARRAY_BUFFER, (GLuint)prevBuffer);
+    gl.UseProgram((GLuint)prevProgram);
+    SDL_GL_UnbindTexture(scene_);
+    gl.BindTexture(GL_TEXTURE_2D, (GLuint)prevTexture);
+    if (desktop && prevTexturing) gl.Enable(GL_TEXTURE_2D);
+    gl.ActiveTexture((GLenum)prevActive);
+}
+
+void CrtShader::release() {
+    renderTargetPool().release(scene_);
+    scene_ = nullptr;
+    w_ = h_ = 0;
+    if (program_ && gl_) gl_->DeleteProgram(program_);
+    program_ = 0;
+    active_ = false;
+}
+
+std::string CrtShader::statusLine() const {
+    if (failed_) return "FALLBACK (" + failure_ + ")";
+    if (program_) return "GLSL (" + driver_ + ")";
+    return "OFF";
+}
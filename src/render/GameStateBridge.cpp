@@ -1,12 +1,32 @@
 #include "render/GameStateBridge.hpp"
 #include "app/GameState.hpp"
+#include "app/GameSnapshot.hpp"
 #include "pieces/PieceManager.hpp"
+#include "pieces/Piece.hpp"
 #include "DebugLogger.hpp"
+#include <algorithm>
 #include <fstream>
 
 // External globals
 extern VisualEffectsView g_visualView;
 extern bool pm_loadPiecesFromStream(std::istream&);
+extern std::vector<Piece> PIECES;
+
+static_assert(GameSnapshot::MAX_NEXT <= NextView::MAX_NEXT, "NextView precisa caber a fila do snapshot");
+
+// Snapshot ligado pela thread de render (nullptr = ler o GameState vivo)
+namespace {
+const GameSnapshot* g_snapshot = nullptr;
+std::vector<int> g_snapshotStats;   // db_getPieceStats devolve vector*
+TimerSystem g_snapshotTimer;        // Réplica de exibição do timer
+
+// Snapshot guarda as linhas em ordem: rowSlot identidade
+struct IdentitySlots {
+    int v[GameSnapshot::MAX_ROWS];
+    IdentitySlots() { for (int i = 0; i < GameSnapshot::MAX_ROWS; ++i) v[i] = i; }
+};
+const IdentitySlots g_identitySlots;
+}
 
 // ============================================================================
 // GameState Bridge Functions
@@ -15,56 +35,204 @@ extern bool pm_loadPiecesFromStream(std::istream&);
 // and other modules without exposing the full GameState implementation.
 
 bool db_getBoardSize(const GameState& state, int& rows, int& cols) {
-    const auto& g = state.getBoard().getGrid();
-    rows = (int)g.size();
-    cols = rows ? (int)g[0].size() : 0;
+    if (g_snapshot) {
+        rows = g_snapshot->rows;
+        cols = g_snapshot->cols;
+        return rows > 0 && cols > 0;
+    }
+    rows = state.getBoard().height();
+    cols = state.getBoard().width();
     return rows > 0 && cols > 0;
 }
 
+bool db_getBoardView(const GameState& state, BoardView& out) {
+    if (g_snapshot) {
+        out.rows = g_snapshot->rows;
+        out.cols = g_snapshot->cols;
+        out.version = g_snapshot->boardVersion;
+        out.rowMasks = g_snapshot->rowMasks;
+        out.cells = g_snapshot->cells;
+        out.rowSlot = g_identitySlots.v;
+        out.stride = GameSnapshot::MAX_COLS;
+        return out.rows > 0 && out.cols > 0;
+    }
+    const GameBoard& board = state.getBoard();
+    out.rows = board.height();
+    out.cols = board.width();
+    out.version = board.getVersion();
+    out.rowMasks = board.rowMasks();
+    out.cells = board.cellData();
+    out.rowSlot = board.rowSlots();
+    out.stride = board.width();
+    return out.rows > 0 && out.cols > 0;
+}
+
+bool db_getActiveView(const GameState& state, ActiveView& out) {
+    out.count = 0;
+    if (!db_getActive(state, out.idx, out.rot, out.x, out.y)) return false;
+    if (out.idx < 0 || out.idx >= (int)PIECES.size()) return false;
+    const Piece& pc = PIECES[out.idx];
+    if (pc.rot.empty()) return false;
+    out.rot = ((out.rot % 4) + 4) % 4;  // Peças de fallback TÊM 4 rotações
+    out.r = pc.r; out.g = pc.g; out.b = pc.b;
+    auto push = [&](int gx, int gy) {
+        if (out.count < ActiveView::MAX_CELLS) out.cells[out.count++] = {gx, gy};
+    };
+    const RotationMask& m = pc.masks[out.rot];
+    if (m.valid) {
+        for (int i = 0; i < m.height(); i++)
+            for (uint32_t bits = m.rows[i]; bits; bits &= bits - 1) push(out.x + m.minX + __builtin_ctz(bits), out.y + m.minY + i);
+    } else {
+        for (auto pr : pc.rot[out.rot]) push(out.x + pr.first, out.y + pr.second);
+    }
+    return true;
+}
+
+bool db_getNextView(const GameState& state, NextView& out) {
+    if (g_snapshot) {
+        out.count = std::min(g_snapshot->nextCount, (int)NextView::MAX_NEXT);
+        std::copy(g_snapshot->nextQueue, g_snapshot->nextQueue + out.count, out.idx);
+        return out.count > 0;
+    }
+    out.count = state.getNextQueue(out.idx, GameSnapshot::MAX_NEXT);
+    return out.count > 0;
+}
+
 bool db_getBoardCell(const GameState& state, int x, int y, Uint8& r, Uint8& g, Uint8& b, bool& occ) {
-    const auto& gr = state.getBoard().getGrid();
-    if (y < 0 || y >= (int)gr.size() || x < 0 || x >= (int)gr[y].size()) return false;
-    const auto& c = gr[y][x];
-    r = c.r; g = c.g; b = c.b; occ = c.occ;
+    if (g_snapshot) {
+        if (y < 0 || y >= g_snapshot->rows || x < 0 || x >= g_snapshot->cols) return false;
+        const GameSnapshot::Cell& c = g_snapshot->cellAt(x, y);
+        r = c.r; g = c.g; b = c.b; occ = c.occ != 0;
+        return true;
+    }
+    const GameBoard& board = state.getBoard();
+    if (y < 0 || y >= board.height() || x < 0 || x >= board.width()) return false;
+    occ = board.isOccupied(x, y);
+    const Cell& c = board.cellAt(x, y);
+    r = c.r; g = c.g; b = c.b;
     return true;
 }
 
+Uint32 db_getBoardVersion(const GameState& state) {
+    if (g_snapshot) return g_snapshot->boardVersion;
+    return state.getBoard().getVersion();
+}
+
 bool db_getActive(const GameState& state, int& idx, int& rot, int& x, int& y) {
+    if (g_snapshot) {
+        idx = g_snapshot->activeIdx; rot = g_snapshot->activeRot; x = g_snapshot->activeX; y = g_snapshot->activeY;
+        return true;
+    }
     const Active& a = state.getActivePiece();
     idx = a.idx; rot = a.rot; x = a.x; y = a.y;
     return true;
 }
 
 bool db_getNextIdx(const GameState& state, int& nextIdx) {
+    if (g_snapshot) { nextIdx = g_snapshot->nextCount > 0 ? g_snapshot->nextQueue[0] : 0; return true; }
     nextIdx = state.getNextIdx();
     return true;
 }
 
+const LockEvent& db_getLockEvent(const GameState& state) {
+    if (g_snapshot) return g_snapshot->lockEvent;
+    return state.getLockEvent();
+}
+
 bool db_isPaused(const GameState& state) {
+    if (g_snapshot) return g_snapshot->paused;
     return state.isPaused();
 }
 
 bool db_isGameOver(const GameState& state) {
+    if (g_snapshot) return g_snapshot->gameOver;
     return state.isGameOver();
 }
 
 int db_getScore(const GameState& state) {
+    if (g_snapshot) return g_snapshot->score;
     return state.getScoreValue();
 }
 
 int db_getLines(const GameState& state) {
+    if (g_snapshot) return g_snapshot->lines;
     return state.getLinesValue();
 }
 
 int db_getLevel(const GameState& state) {
+    if (g_snapshot) return g_snapshot->level;
     return state.getLevelValue();
 }
 
 bool db_getPieceStats(const GameState& state, const std::vector<int>*& stats) {
+    if (g_snapshot) {
+        stats = &g_snapshotStats;
+        return true;
+    }
     stats = &state.getPieceStats();
     return true;
 }
 
+const TimerSystem& db_getTimer(const GameState& state) {
+    return g_snapshot ? g_snapshotTimer : state.getTimer();
+}
+
+void db_captureSnapshot(const GameState& state, GameSnapshot& out) {
+    const GameBoard& board = state.getBoard();
+    out.rows = std::min(board.height(), GameSnapshot::MAX_ROWS);
+    out.cols = std::min(board.width(), GameSnapshot::MAX_COLS);
+    out.boardVersion = board.getVersion();
+    const GameBoard::RowMask colMask = out.cols >= 32 ? ~0u : ((1u << out.cols) - 1u);
+    for (int y = 0; y < out.rows; ++y) {
+        GameBoard::RowMask bits = board.rowMask(y) & colMask;
+        out.rowMasks[y] = bits;
+        const Cell* src = board.cellData() + board.rowSlots()[y] * board.width();
+        Cell* dst = &out.cellAt(0, y);
+        for (int x = 0; x < out.cols; ++x) {
+            dst[x] = src[x];
+            dst[x].occ = (bits >> x) & 1u;
+        }
+    }
+
+    const Active& a = state.getActivePiece();
+    out.activeIdx = a.idx; out.activeRot = a.rot; out.activeX = a.x; out.activeY = a.y;
+    out.nextCount = state.getNextQueue(out.nextQueue, GameSnapshot::MAX_NEXT);
+
+    out.score = state.getScoreValue();
+    out.lines = state.getLinesValue();
+    out.level = state.getLevelValue();
+
+    const std::vector<int>& stats = state.getPieceStats();
+    out.pieceStatCount = std::min((int)stats.size(), GameSnapshot::MAX_PIECE_TYPES);
+    std::copy(stats.begin(), stats.begin() + out.pieceStatCount, out.pieceStats);
+
+    const TimerSystem& timer = state.getTimer();
+    out.timerEnabled = timer.isEnabled();
+    out.timerState = (int)timer.getState();
+    out.timerRemaining = timer.getRemainingSeconds();
+
+    out.running = state.isRunning();
+    out.paused = state.isPaused();
+    out.gameOver = state.isGameOver();
+    out.screenshotRequests = state.getScreenshotRequests();
+    out.inputVersion = state.getInputVersion();
+    out.inputStamp = state.getInputStamp();
+    out.lockEvent = state.getLockEvent();
+    state.saveResumeState(out);
+}
+
+void db_prepareSnapshotView(const GameState& state) {
+    g_snapshotTimer.setConfig(state.getTimer().getConfig());
+}
+
+void db_bindSnapshot(const GameSnapshot* snapshot) {
+    g_snapshot = snapshot;
+    if (!snapshot) return;
+    g_snapshotStats.assign(snapshot->pieceStats, snapshot->pieceStats + snapshot->pieceStatCount);
+    g_snapshotTimer.setDisplayState(snapshot->timerEnabled, (TimerSystem::State)snapshot->timerState,
+                                    snapshot->timerRemaining);
+}
+
 bool db_isRunning(const GameState& state) {
     return state.isRunning();
 }
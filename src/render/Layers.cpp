@@ -1,20 +1,28 @@
 #include "render/Layers.hpp"
 #include "render/RenderLayer.hpp"
+#include "render/RenderManager.hpp"
+#include "render/TimerRenderLayer.hpp"
+#include "render/ParticleLayer.hpp"
 #include "render/LayoutCache.hpp"
 #include "ThemeManager.hpp"
 #include "DebugLogger.hpp"
 #include "audio/AudioSystem.hpp"
 #include "pieces/Piece.hpp"
 #include "pieces/PieceManager.hpp"
+#include "pieces/PieceTable.hpp"
 #include "render/Primitives.hpp"
 #include "render/GameStateBridge.hpp"
+#include "render/TextureCache.hpp"
+#include "render/TextTextureCache.hpp"
+#include "render/CellSkin.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
+#include "app/GameSnapshot.hpp"
 
 #include <SDL2/SDL.h>
 #include <algorithm>
 #include <cmath>
 #include <string>
-#include <sstream>
-#include <iomanip>
 #include <ios>
 
 // Externals from main translation unit
@@ -25,9 +33,6 @@ extern PieceManager pieceManager;
 // Helpers declared in main TU
 void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int rad, Uint8 R, Uint8 G, Uint8 B, Uint8 A);
 void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int rad, int thickness, Uint8 R, Uint8 G, Uint8 B, Uint8 A);
-void drawPixelText(SDL_Renderer* r, int x, int y, const std::string& text, int scale, Uint8 R, Uint8 G, Uint8 B);
-void drawPixelTextOutlined(SDL_Renderer* r, int x, int y, const std::string& text, int scale, Uint8 R, Uint8 G, Uint8 B, Uint8 oR, Uint8 oG, Uint8 oB);
-int textWidthPx(const std::string& text, int scale);
 
 // Globals configured in config (temporary; will migrate via bridge)
 extern int ROUNDED_PANELS;
@@ -74,13 +79,261 @@ namespace {
     inline int scaleCellSpacing(int virtualSpacing, float scale) {
         return std::max(1, (int)(virtualSpacing * scale));
     }
+    
+    // Shared per-frame vertex batch for cells: each layer flushes once at its end
+    // (one SDL_RenderGeometry; textured from the CELL_SKIN atlas when a skin is on)
+    QuadBatch g_cellBatch;
+    
+    // block = piece cell (skinned); otherwise a flat cell (empty board, NEXT grid)
+    inline void addCell(const CellSkin* skin, const SDL_Rect& r, Uint8 R, Uint8 G, Uint8 B, bool block) {
+        if (skin) g_cellBatch.add(r, block ? skin->blockUV : skin->flatUV, R, G, B);
+        else g_cellBatch.add(r, R, G, B);
+    }
+    
+    inline void flushCells(SDL_Renderer* renderer, const CellSkin* skin) {
+        if (!g_cellBatch.flush(renderer, skin ? skin->texture : nullptr) && skin) disableCellSkin();
+    }
+    
+    // Blit a pre-rendered panel from the TextureCache; false = draw immediately
+    inline bool blitPanel(SDL_Renderer* renderer, const LayoutCache& layout,
+                          SDL_Texture* (TextureCache::*get)() const, int x, int y, int w, int h) {
+        if (!layout.panels) return false;
+        SDL_Texture* tex = (layout.panels->*get)();
+        if (!tex) return false;
+        SDL_Rect dst{x, y, w, h};
+        return DrawCalls::copy(renderer, tex, nullptr, &dst) == 0;
+    }
+    
+    // Text through the value-keyed texture cache when enabled
+    inline void drawCachedText(SDL_Renderer* renderer, const LayoutCache& layout, int x, int y, const std::string& s,
+                               float sx, float sy, Uint8 r, Uint8 g, Uint8 b) {
+        if (layout.texts) layout.texts->draw(renderer, x, y, s, sx, sy, r, g, b);
+        else drawPixelText(renderer, x, y, s, sx, sy, r, g, b);
+    }
+    inline void drawCachedTextOutlined(SDL_Renderer* renderer, const LayoutCache& layout, int x, int y, const std::string& s,
+                                       float sx, float sy, Uint8 r, Uint8 g, Uint8 b, Uint8 or_, Uint8 og, Uint8 ob) {
+        if (layout.texts) layout.texts->drawOutlined(renderer, x, y, s, sx, sy, r, g, b, or_, og, ob);
+        else drawPixelTextOutlined(renderer, x, y, s, sx, sy, r, g, b, or_, og, ob);
+    }
+    
+    // Re-format a readout only when its value changes
+    inline const std::string& formatCached(int value, int& lastValue, std::string& text) {
+        if (text.empty() || value != lastValue) { lastValue = value; text = std::to_string(value); }
+        return text;
+    }
+    
+    const std::string kScoreLabel = "SCORE";
+    const std::string kLinesLabel = "LINES";
+    const std::string kLevelLabel = "LEVEL";
+    const std::string kPauseText = "PAUSE";
+    const std::string kGameOverText = "GAME OVER";
+    const std::string kPressStartText = "PRESS START";
+    const std::string kNoText;
+    
+    // Banner/HUD rectangles: new layout system if configured, otherwise legacy
+    SDL_Rect bannerBox(const LayoutCache& layout) {
+        if (layout.bannerRect.w > 0) return layout.bannerRect;
+        return SDL_Rect{layout.BX, layout.BY, layout.BW, layout.BH};
+    }
+    SDL_Rect hudBox(const LayoutCache& layout) {
+        if (layout.hudRect.w > 0) return layout.hudRect;
+        return SDL_Rect{layout.panelX, layout.panelY, layout.panelW, layout.panelH};
+    }
+    
+    // contentVersion(): FNV-1a over the values a retained layer shows
+    inline std::uint64_t mixVersion(std::uint64_t h, std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) { h ^= (v >> (i * 8)) & 0xffu; h *= 1099511628211ull; }
+        return h;
+    }
+    constexpr std::uint64_t kVersionSeed = 1469598103934665603ull;
+    
+    // NEXT box geometry (shared by layoutBuildCellRects and NextLayer)
+    struct NextGeometry {
+        bool valid = false;
+        int boxX = 0, boxY = 0, boxW = 0, boxH = 0, pad = 0;
+        int gridCols = 0, gridRows = 0, cellW = 0, cellH = 0;
+        int gridX = 0, gridY = 0, gridW = 0, gridH = 0;
+        // Fila (NEXT_COUNT > 1): `queue` miniaturas numa linha no pé da caixa
+        int queue = 0, miniW = 0, miniH = 0, slotW = 0, slotH = 0;
+        int queueX = 0, queueY = 0, queueGap = 0;
+    };
+    NextGeometry nextGeometry(const LayoutCache& layout) {
+        NextGeometry g;
+        // Legacy layouts without a NEXT rectangle draw it inside the HUD
+        if (layout.nextRect.w <= 0 || layout.nextRect.x < 0) return g;
+        g.valid = true;
+        g.boxX = layout.nextRect.x; g.boxY = layout.nextRect.y;
+        g.boxW = layout.nextRect.w; g.boxH = layout.nextRect.h;
+        g.gridCols = std::max(4, std::min(10, pieceManager.getPreviewGrid()));
+        g.gridRows = g.gridCols;
+        // In STRETCH mode, cells distort like board cells; in AUTO/NATIVE they stay square
+        g.cellW = (int)(layout.cellBoardW * 0.6f);  // Smaller than board cells
+        g.cellH = (int)(layout.cellBoardH * 0.6f);
+        g.gridW = g.gridCols * g.cellW;
+        g.gridH = g.gridRows * g.cellH;
+        g.pad = scaleOffsetY(10, layout);
+        int labelH = (int)(10 * layout.scaleTextY);
+        int bottom = g.boxY + g.boxH - g.pad;
+        g.queue = std::max(0, std::min(layout.nextCount, (int)GameSnapshot::MAX_NEXT) - 1);
+        if (g.queue > 0) {
+            // Células com metade do tamanho da grade; a linha inteira encolhe por igual para caber na largura
+            g.queueGap = scaleOffsetX(6, layout);
+            g.miniW = std::max(2, g.cellW / 2);
+            g.miniH = std::max(2, g.cellH / 2);
+            const int avail = g.boxW - g.pad*2 - (g.queue - 1) * g.queueGap;
+            const int rowW = g.queue * (int)(g.miniW * 4.5f);
+            if (rowW > avail && avail > 0) {
+                const float k = (float)avail / rowW;
+                g.miniW = std::max(2, (int)(g.miniW * k));
+                g.miniH = std::max(2, (int)(g.miniH * k));
+            }
+            g.slotW = (int)(g.miniW * 4.5f);
+            g.slotH = (int)(g.miniH * 4.5f);
+            g.queueX = g.boxX + (g.boxW - g.queue * g.slotW - (g.queue - 1) * g.queueGap) / 2;
+            g.queueY = bottom - g.slotH;
+            bottom = g.queueY - g.pad;
+            // A grade principal cede a altura que faltar, mantendo a proporção das células
+            const int gridAvail = bottom - (g.boxY + labelH + g.pad*2);
+            if (g.gridH > gridAvail && gridAvail > 0) {
+                const float k = (float)gridAvail / g.gridH;
+                g.cellW = std::max(2, (int)(g.cellW * k));
+                g.cellH = std::max(2, (int)(g.cellH * k));
+                g.gridW = g.gridCols * g.cellW;
+                g.gridH = g.gridRows * g.cellH;
+            }
+        }
+        // Grid centered in the box, pulled up if the box is too small
+        g.gridX = g.boxX + (g.boxW - g.gridW) / 2;
+        g.gridY = g.boxY + labelH + g.pad*2;
+        if (g.gridY + g.gridH > bottom) g.gridY = bottom - g.gridH;
+        return g;
+    }
+    
+    // Piece stats panel geometry (thumbnail slot per piece, one row each)
+    struct StatsGeometry {
+        int boxX = 0, boxY = 0, boxW = 0, boxH = 0;
+        int miniW = 0, miniH = 0, slotW = 0, slotH = 0;
+        int rowHeight = 0, slotX = 0, firstY = 0;
+    };
+    StatsGeometry statsGeometry(const LayoutCache& layout) {
+        StatsGeometry g;
+        // Peças maiores (50% do tamanho do board, não 33%)
+        g.miniW = std::max(2, (int)(layout.cellBoardW / 2));
+        g.miniH = std::max(2, (int)(layout.cellBoardH / 2));
+        g.slotW = (int)(g.miniW * 4.5f);  // Espaço para 4 blocos + margem
+        g.slotH = (int)(g.miniH * 4.5f);
+        g.rowHeight = g.slotH + scaleOffsetY(4, layout);
+        // Use new layout system if configured, otherwise fall back to legacy
+        g.boxX = layout.statsRect.w > 0 ? layout.statsRect.x : (layout.BX + layout.BW + layout.statsMargin);
+        g.boxY = layout.statsRect.w > 0 ? layout.statsRect.y : layout.GY;
+        g.boxW = layout.statsRect.w > 0 ? layout.statsRect.w : layout.statsBoxW;
+        g.boxH = layout.statsRect.w > 0 ? layout.statsRect.h : layout.GH;
+        g.slotX = g.boxX + (g.boxW - g.slotW) / 2;  // Centralizar horizontalmente
+        g.firstY = g.boxY + scaleOffsetY(10, layout);
+        return g;
+    }
+    
+    // Rotation 0 of a piece, centered in a slot (cells and bounds from PIECE_TABLE)
+    PieceRectRange appendPieceCells(std::vector<SDL_Rect>& out, const PieceTable& t, int piece, int slotX, int slotY, int slotW, int slotH,
+                                    int cellW, int cellH, int gapW, int gapH) {
+        PieceRectRange range{(int)out.size(), 0};
+        const int s = PieceTable::slot(piece, 0);
+        if (t.cellCount(piece, 0) == 0) return range;
+        int startX = slotX + (slotW - t.width(piece, 0) * cellW) / 2 - t.minX[s] * cellW;
+        int startY = slotY + (slotH - t.height(piece, 0) * cellH) / 2 - t.minY[s] * cellH;
+        for (uint32_t c = t.rotBegin[s]; c < t.rotBegin[s + 1]; ++c)
+            out.push_back({startX + t.cellX[c] * cellW, startY + t.cellY[c] * cellH, cellW - gapW, cellH - gapH});
+        range.count = (int)out.size() - range.begin;
+        return range;
+    }
+    
+    // Miniatura relativa ao canto do slot; peças maiores que o slot encolhem por
+    // igual, assim a miniatura não invade a vizinha no atlas
+    PieceRectRange appendSlotThumb(std::vector<SDL_Rect>& out, int piece, int slotW, int slotH,
+                                   int miniW, int miniH, int gapW, int gapH) {
+        const int w = std::max(1, PIECE_TABLE.width(piece, 0)), h = std::max(1, PIECE_TABLE.height(piece, 0));
+        const float k = std::min({1.0f, (float)slotW / (w * miniW), (float)slotH / (h * miniH)});
+        const int cellW = std::max(1, (int)(miniW * k)), cellH = std::max(1, (int)(miniH * k));
+        return appendPieceCells(out, PIECE_TABLE, piece, 0, 0, slotW, slotH, cellW, cellH, gapW, gapH);
+    }
+    
+    // Linhas do painel de estatísticas que cabem na caixa (>= 1)
+    int statsVisibleRows(const StatsGeometry& g) {
+        if (g.rowHeight <= 0) return 1;
+        return std::max(1, (g.boxY + g.boxH - g.firstY) / g.rowHeight);
+    }
+    
+    void fillCellGrid(CellRectTable& t, int x0, int y0, int cols, int rows, int cellW, int cellH, int gapW, int gapH) {
+        t.cols = std::max(0, cols);
+        t.rows = std::max(0, rows);
+        t.rects.resize((size_t)t.cols * t.rows);
+        for (int y = 0; y < t.rows; ++y)
+            for (int x = 0; x < t.cols; ++x)
+                t.rects[y * t.cols + x] = {x0 + x * cellW, y0 + y * cellH, cellW - gapW, cellH - gapH};
+    }
+}
+
+void layoutBuildCellRects(LayoutCache& layout) {
+    static Uint32 builds = 0;
+    layout.cellRectsVersion = ++builds;
+    const int pieces = std::min((int)PIECES.size(), PIECE_TABLE.size());
+    const int gapW = scaleCellSpacing(1, layout.scaleX);
+    const int gapH = scaleCellSpacing(1, layout.scaleY);
+    
+    // Board: GW/GH are (int)(cell * COLS/ROWS), so the grid always covers the board
+    const int cellW = (int)layout.cellBoardW, cellH = (int)layout.cellBoardH;
+    if (cellW > 0 && cellH > 0) fillCellGrid(layout.boardCells, layout.GX, layout.GY, layout.GW / cellW, layout.GH / cellH, cellW, cellH, gapW, gapH);
+    else fillCellGrid(layout.boardCells, 0, 0, 0, 0, 0, 0, 0, 0);
+    
+    layout.nextPieceCells.clear(); layout.nextPieces.clear();
+    layout.nextQueueCells.clear(); layout.nextQueuePieces.clear();
+    NextGeometry ng = nextGeometry(layout);
+    if (ng.valid) {
+        fillCellGrid(layout.nextGrid, ng.gridX, ng.gridY, ng.gridCols, ng.gridRows, ng.cellW, ng.cellH, gapW, gapH);
+        for (int i = 0; i < pieces; ++i)
+            layout.nextPieces.push_back(appendPieceCells(layout.nextPieceCells, PIECE_TABLE, i, ng.gridX, ng.gridY, ng.gridW, ng.gridH,
+                                                         ng.cellW, ng.cellH, gapW, gapH));
+        if (ng.queue > 0) {
+            for (int i = 0; i < pieces; ++i)
+                layout.nextQueuePieces.push_back(appendSlotThumb(layout.nextQueueCells, i, ng.slotW, ng.slotH,
+                                                                 ng.miniW, ng.miniH, gapW, gapH));
+        }
+    } else {
+        fillCellGrid(layout.nextGrid, 0, 0, 0, 0, 0, 0, 0, 0);
+    }
+    
+    layout.statsPieceCells.clear(); layout.statsPieces.clear();
+    // Relativas ao slot: a linha de cada peça só se sabe no draw (top-N por contagem)
+    StatsGeometry sg = statsGeometry(layout);
+    layout.statsPieceCells.reserve(PIECE_TABLE.cellX.size() / 4 + 1);
+    for (int i = 0; i < pieces; ++i)
+        layout.statsPieces.push_back(appendSlotThumb(layout.statsPieceCells, i, sg.slotW, sg.slotH, sg.miniW, sg.miniH, gapW, gapH));
+}
+
+void addDefaultLayers(RenderManager& manager, AudioSystem* audio) {
+    manager.addLayer(std::make_unique<BackgroundLayer>());
+    manager.addLayer(std::make_unique<TimerRenderLayer>());  // Timer layer (early - before game elements)
+    manager.addLayer(std::make_unique<BannerLayer>());
+    manager.addLayer(std::make_unique<PieceStatsLayer>());
+    manager.addLayer(std::make_unique<BoardLayer>());
+    manager.addLayer(std::make_unique<ParticleLayer>());  // Linhas limpas e lock (PARTICLE_CAPACITY)
+    manager.addLayer(std::make_unique<HUDLayer>());
+    manager.addLayer(std::make_unique<NextLayer>());
+    manager.addLayer(std::make_unique<ScoreLayer>());
+    manager.addLayer(std::make_unique<OverlayLayer>());
+    manager.addLayer(std::make_unique<PostEffectsLayer>(audio));
 }
 
 // BackgroundLayer
 void BackgroundLayer::render(SDL_Renderer* renderer, const GameState&, const LayoutCache& layout) {
-    // Clear entire renderer with black first
+    // Clear entire renderer with black first (a split-screen region only clears its viewport)
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+    if (layout.region) {
+        SDL_Rect area{0, 0, layout.SWr, layout.SHr};
+        DrawCalls::fillRect(renderer, &area);
+    } else {
+        DrawCalls::clear(renderer);
+    }
     
     // Calculate virtual rendering area (centered on screen)
     int virtualAreaX = (int)((layout.SWr - layout.virtualWidth * layout.scaleX) / 2);
@@ -90,7 +343,7 @@ void BackgroundLayer::render(SDL_Renderer* renderer, const GameState&, const Lay
     
     SDL_Rect virtualArea = {virtualAreaX, virtualAreaY, virtualAreaW, virtualAreaH};
     SDL_SetRenderDrawColor(renderer, themeManager.getTheme().bg_r, themeManager.getTheme().bg_g, themeManager.getTheme().bg_b, 255);
-    SDL_RenderFillRect(renderer, &virtualArea);
+    DrawCalls::fillRect(renderer, &virtualArea);
     
     // Set clipping to virtual area - all subsequent layers will respect this
     SDL_RenderSetClipRect(renderer, &virtualArea);
@@ -102,11 +355,11 @@ std::string BackgroundLayer::getName() const { return "Background"; }
 void BannerLayer::render(SDL_Renderer* renderer, const GameState&, const LayoutCache& layout) {
     if (!layout.bannerConfig.enabled) return;
     
-    // Use new layout system if configured, otherwise fall back to legacy
-    int x = layout.bannerRect.w > 0 ? layout.bannerRect.x : layout.BX;
-    int y = layout.bannerRect.w > 0 ? layout.bannerRect.y : layout.BY;
-    int w = layout.bannerRect.w > 0 ? layout.bannerRect.w : layout.BW;
-    int h = layout.bannerRect.w > 0 ? layout.bannerRect.h : layout.BH;
+    const SDL_Rect box = bannerBox(layout);
+    int x = box.x, y = box.y, w = box.w, h = box.h;
+    
+    // Cached: background + title baked into one texture
+    if (blitPanel(renderer, layout, &TextureCache::getBannerTexture, x, y, w, h)) return;
     
     // Draw banner background (rounded with elliptical corners in STRETCH mode)
     // Uses ThemeManager for colors (proper separation of concerns)
@@ -119,6 +372,7 @@ void BannerLayer::render(SDL_Renderer* renderer, const GameState&, const LayoutC
     int bty = y + scaleOffsetY(10, layout);
     int cxText = x + (int)(w - 5 * layout.scaleTextX) / 2;
     
+    std::string glyph(1, ' ');  // Um string para o título inteiro, não um por letra
     for (size_t i = 0; i < TITLE_TEXT.size(); ++i) {
         char ch = TITLE_TEXT[i];
         if (ch == ' ') { bty += scaleTextSpacing(6, layout); continue; }
@@ -127,7 +381,8 @@ void BannerLayer::render(SDL_Renderer* renderer, const GameState&, const LayoutC
         if (!((ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '-' || ch == ':' || ch == '.')) {
             ch = ' ';
         }
-        drawPixelText(renderer, cxText, bty, std::string(1, ch), layout.scaleTextX, layout.scaleTextY,
+        glyph[0] = ch;
+        drawPixelText(renderer, cxText, bty, glyph, layout.scaleTextX, layout.scaleTextY,
                       themeManager.getTheme().banner_text_r,
                       themeManager.getTheme().banner_text_g,
                       themeManager.getTheme().banner_text_b);
@@ -136,59 +391,102 @@ void BannerLayer::render(SDL_Renderer* renderer, const GameState&, const LayoutC
 }
 int BannerLayer::getZOrder() const { return 1; }
 std::string BannerLayer::getName() const { return "Banner"; }
+bool BannerLayer::getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const {
+    if (!layout.bannerConfig.enabled) return false;
+    bounds = bannerBox(layout);
+    return bounds.w > 0 && bounds.h > 0;
+}
 
 // BoardLayer
+BoardLayer::~BoardLayer() {
+    renderTargetPool().release(stackTexture_);
+}
+
+void BoardLayer::drawStack(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout, int dx, int dy, bool flush) {
+    const auto& th = themeManager.getTheme();
+    const CellSkin* skin = acquireCellSkin(renderer);
+    const CellRectTable& grid = layout.boardCells;
+    g_cellBatch.reserve((size_t)grid.rows * grid.cols + 16);  // + peça ativa; no-op depois do primeiro frame
+    BoardView view;
+    if (!db_getBoardView(state, view)) view.rows = view.cols = 0;
+    const int rows = std::min(view.rows, grid.rows), cols = std::min(view.cols, grid.cols);
+    for (int y = 0; y < grid.rows; ++y) {
+        const Uint32 bits = y < rows ? view.rowMasks[y] : 0;
+        const Cell* row = y < rows ? view.row(y) : nullptr;
+        const SDL_Rect* rects = &grid.rects[y * grid.cols];
+        for (int x = 0; x < grid.cols; ++x) {
+            SDL_Rect r{rects[x].x + dx, rects[x].y + dy, rects[x].w, rects[x].h};
+            // Occupied cells replace the empty one in place (same rect), so no overdraw
+            if (x < cols && ((bits >> x) & 1u))
+                addCell(skin, r, row[x].r, row[x].g, row[x].b, true);
+            else
+                addCell(skin, r, th.board_empty_r, th.board_empty_g, th.board_empty_b, false);
+        }
+    }
+    if (flush) flushCells(renderer, skin);
+}
+
 void BoardLayer::render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) {
     // Use separate W/H for cells (STRETCH mode can have rectangular cells)
     int cellW = (int)layout.cellBoardW;
     int cellH = (int)layout.cellBoardH;
     int cellSpacingW = scaleCellSpacing(1, layout.scaleX);
     int cellSpacingH = scaleCellSpacing(1, layout.scaleY);
+    if (cellW <= 0 || cellH <= 0) return;
+    
+    const auto& th = themeManager.getTheme();
+    bool layoutChanged = layout.GW != cachedW_ || layout.GH != cachedH_ || cellW != cachedCellW_ || cellH != cachedCellH_ ||
+                         cellSpacingW != cachedGapW_ || cellSpacingH != cachedGapH_;
+    const CellSkin* skin = acquireCellSkin(renderer);
+    const Uint32 skinGeneration = skin ? skin->generation : 0;
+    bool themeChanged = th.board_empty_r != cachedEmptyR_ || th.board_empty_g != cachedEmptyG_ || th.board_empty_b != cachedEmptyB_ ||
+                        skinGeneration != cachedSkin_;
     
-    for (int y = 0; y < layout.GH / cellH; ++y) {
-        for (int x = 0; x < layout.GW / cellW; ++x) {
-            SDL_Rect r{layout.GX + x * cellW, layout.GY + y * cellH, cellW - cellSpacingW, cellH - cellSpacingH};
-            SDL_SetRenderDrawColor(renderer, themeManager.getTheme().board_empty_r, themeManager.getTheme().board_empty_g, themeManager.getTheme().board_empty_b, 255);
-            SDL_RenderFillRect(renderer, &r);
+    if (!textureFailed_ && layout.GW > 0 && layout.GH > 0 &&
+        (layoutChanged || !stackTexture_ || stackEpoch_ != renderTargetPool().targetsEpoch())) {
+        renderTargetPool().release(stackTexture_);
+        stackTexture_ = renderTargetPool().acquire(renderer, layout.GW, layout.GH, TextureUse::BOARD);
+        stackEpoch_ = renderTargetPool().targetsEpoch();
+        if (!stackTexture_) {
+            textureFailed_ = true;
+            DebugLogger::warning("BoardLayer: render target indisponivel, desenhando em modo imediato: " + std::string(SDL_GetError()));
         }
+        cachedVersion_ = 0;
     }
-    {
-        int rows=0, cols=0; if (db_getBoardSize(state, rows, cols)) {
-            for (int y = 0; y < rows; ++y) {
-                for (int x = 0; x < cols; ++x) {
-                    Uint8 r,g,b; bool occ; if (!db_getBoardCell(state, x, y, r, g, b, occ)) continue;
-                    if (occ) {
-                        SDL_Rect rr{layout.GX + x * cellW, layout.GY + y * cellH, cellW - cellSpacingW, cellH - cellSpacingH};
-                        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-                        SDL_RenderFillRect(renderer, &rr);
-                    }
-                }
-            }
+    
+    if (stackTexture_) {
+        Uint32 version = db_getBoardVersion(state);
+        if (version != cachedVersion_ || layoutChanged || themeChanged) {
+            SDL_Texture* prevTarget = SDL_GetRenderTarget(renderer);
+            SDL_SetRenderTarget(renderer, stackTexture_);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            DrawCalls::clear(renderer);
+            drawStack(renderer, state, layout, -layout.GX, -layout.GY, true);
+            SDL_SetRenderTarget(renderer, prevTarget);
+            cachedVersion_ = version;
         }
+        SDL_Rect dst{layout.GX, layout.GY, layout.GW, layout.GH};
+        DrawCalls::copy(renderer, stackTexture_, nullptr, &dst);
+    } else {
+        // Sem render target: stack e peça ativa saem no mesmo draw (ou no fallback em ordem de cor)
+        drawStack(renderer, state, layout, 0, 0, !QuadBatch::preservesOrder());
     }
-    if (PIECES.empty()) return;
-    {
-        int idx=0, rot=0, ax=0, ay=0; db_getActive(state, idx, rot, ax, ay);
-        if (idx < 0 || idx >= (int)PIECES.size()) return;
-        auto& pc = PIECES[idx];
-        if (pc.rot.empty()) return;
-        // Clamp rot because pieces from fallback MUST have 4 rotations
-        rot = ((rot % 4) + 4) % 4;
-        int rows=0, cols=0; db_getBoardSize(state, rows, cols);
-        int drawn = 0;
-        for (auto pr : pc.rot[rot]) {
-            int gx = ax + pr.first;
-            int gy = ay + pr.second;
-            if (gx < 0 || gx >= cols || gy < 0 || gy >= rows) continue;
-            SDL_Rect rr{layout.GX + gx * cellW,
-                        layout.GY + gy * cellH,
-                        cellW - cellSpacingW, cellH - cellSpacingH};
-            SDL_SetRenderDrawColor(renderer, pc.r, pc.g, pc.b, 255);
-            SDL_RenderFillRect(renderer, &rr);
-            ++drawn;
-        }
-        // Remove debug log for missing active piece
+    cachedW_ = layout.GW; cachedH_ = layout.GH; cachedCellW_ = cellW; cachedCellH_ = cellH;
+    cachedGapW_ = cellSpacingW; cachedGapH_ = cellSpacingH;
+    cachedEmptyR_ = th.board_empty_r; cachedEmptyG_ = th.board_empty_g; cachedEmptyB_ = th.board_empty_b;
+    cachedSkin_ = skinGeneration;
+    
+    ActiveView active;
+    if (!db_getActiveView(state, active)) return;
+    int rows=0, cols=0; db_getBoardSize(state, rows, cols);
+    rows = std::min(rows, layout.boardCells.rows);
+    cols = std::min(cols, layout.boardCells.cols);
+    for (int i = 0; i < active.count; ++i) {
+        const SDL_Point& p = active.cells[i];
+        if (p.x < 0 || p.x >= cols || p.y < 0 || p.y >= rows) continue;
+        addCell(skin, layout.boardCells.at(p.x, p.y), active.r, active.g, active.b, true);
     }
+    flushCells(renderer, skin);
 }
 
 std::string BoardLayer::getName() const { return "Board"; }
@@ -197,11 +495,10 @@ std::string BoardLayer::getName() const { return "Board"; }
 void HUDLayer::render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) {
     if (!layout.hudConfig.enabled) return;
     
-    // Use new layout system if configured, otherwise fall back to legacy
-    int x = layout.hudRect.w > 0 ? layout.hudRect.x : layout.panelX;
-    int y = layout.hudRect.w > 0 ? layout.hudRect.y : layout.panelY;
-    int w = layout.hudRect.w > 0 ? layout.hudRect.w : layout.panelW;
-    int h = layout.hudRect.w > 0 ? layout.hudRect.h : layout.panelH;
+    const SDL_Rect box = hudBox(layout);
+    int x = box.x, y = box.y, w = box.w, h = box.h;
+    
+    if (blitPanel(renderer, layout, &TextureCache::getHudPanelTexture, x, y, w, h)) return;
     
     // Painel principal do HUD (à direita) - elliptical corners in STRETCH mode
     drawRoundedFilled(renderer, x, y, w, h, layout.borderRadiusX, layout.borderRadiusY,
@@ -213,185 +510,243 @@ void NextLayer::render(SDL_Renderer* renderer, const GameState& state, const Lay
     if (!layout.nextConfig.enabled) return;
     
     // Get next piece index
-    int nextIdx = 0;
-    if (!db_getNextIdx(state, nextIdx)) return;
-    
-    // Use new layout system if configured, otherwise fall back to legacy (inside HUD)
-    int x = layout.nextRect.w > 0 ? layout.nextRect.x : -1;
-    int y = layout.nextRect.w > 0 ? layout.nextRect.y : -1;
-    int w = layout.nextRect.w > 0 ? layout.nextRect.w : -1;
-    int h = layout.nextRect.w > 0 ? layout.nextRect.h : -1;
+    NextView next;
+    if (!db_getNextView(state, next) || next.count == 0) return;
+    int nextIdx = next.idx[0];
     
     // Skip if not configured (will render in HUD as legacy)
-    if (x < 0 || w <= 0) return;
-    
-    // Calculate grid size
-    int gridCols = std::max(4, std::min(10, pieceManager.getPreviewGrid()));
-    int gridRows = gridCols;
-    // In STRETCH mode, cells distort like board cells; in AUTO/NATIVE they stay square
-    int cellMiniW = (int)(layout.cellBoardW * 0.6f);  // Smaller than board cells
-    int cellMiniH = (int)(layout.cellBoardH * 0.6f);
-    int gridW = gridCols * cellMiniW;
-    int gridH = gridRows * cellMiniH;
-    int pad = scaleOffsetY(10, layout);
-    int labelH = (int)(10 * layout.scaleTextY);
-    
-    // Use the configured rectangle
-    int boxX = x;
-    int boxY = y;
-    int boxW = w;
-    int boxH = h;
-    
-    // Draw background - elliptical corners in STRETCH mode
-    drawRoundedFilled(renderer, boxX, boxY, boxW, boxH, layout.borderRadiusX, layout.borderRadiusY,
-                      themeManager.getTheme().next_fill_r, themeManager.getTheme().next_fill_g, 
-                      themeManager.getTheme().next_fill_b, 255);
-    
-    // Draw "NEXT" label - text distorts in STRETCH mode
-    std::string nextText = "NEXT";
-    int nextW = textWidthPx(nextText, layout.scaleTextX);
-    int textX = boxX + (boxW - nextW) / 2;
-    int textY = boxY + pad*2;  // Aumentado de pad/2 para pad (mais para baixo)
-    drawPixelText(renderer, textX, textY, nextText, layout.scaleTextX, layout.scaleTextY,
-                 themeManager.getTheme().next_label_r,
-                 themeManager.getTheme().next_label_g,
-                 themeManager.getTheme().next_label_b);
-    
-    // Calculate grid position (centered in box)
-    int gridX = boxX + (boxW - gridW) / 2;
-    int gridY = boxY + labelH + pad*2;
-    
-    // Adjust grid to fit if box is too small
-    if (gridY + gridH > boxY + boxH - pad) {
-        gridY = boxY + boxH - gridH - pad;
-    }
-    
-    // Draw checkerboard grid (distorts in STRETCH mode)
-    for (int gy = 0; gy < gridRows; ++gy) {
-        for (int gx = 0; gx < gridCols; ++gx) {
-            // IMPORTANT: Cell spacing must be scaled too!
-                SDL_Rect q{gridX + gx * cellMiniW, gridY + gy * cellMiniH,
-                           cellMiniW - scaleCellSpacing(1, layout.scaleX), 
-                           cellMiniH - scaleCellSpacing(1, layout.scaleY)};
+    NextGeometry g = nextGeometry(layout);
+    if (!g.valid) return;
+    
+    // Background + "NEXT" label (cached texture when available)
+    if (!blitPanel(renderer, layout, &TextureCache::getNextBoxTexture, g.boxX, g.boxY, g.boxW, g.boxH)) {
+        // Draw background - elliptical corners in STRETCH mode
+        drawRoundedFilled(renderer, g.boxX, g.boxY, g.boxW, g.boxH, layout.borderRadiusX, layout.borderRadiusY,
+                          themeManager.getTheme().next_fill_r, themeManager.getTheme().next_fill_g, 
+                          themeManager.getTheme().next_fill_b, 255);
+        
+        // Draw "NEXT" label - text distorts in STRETCH mode
+        std::string nextText = "NEXT";
+        int nextW = textWidthPx(nextText, layout.scaleTextX);
+        int textX = g.boxX + (g.boxW - nextW) / 2;
+        int textY = g.boxY + g.pad*2;  // Aumentado de pad/2 para pad (mais para baixo)
+        drawPixelText(renderer, textX, textY, nextText, layout.scaleTextX, layout.scaleTextY,
+                     themeManager.getTheme().next_label_r,
+                     themeManager.getTheme().next_label_g,
+                     themeManager.getTheme().next_label_b);
+    }
+    
+    // Draw checkerboard grid (rects from layout.nextGrid, distorts in STRETCH mode)
+    const auto& th = themeManager.getTheme();
+    const CellSkin* skin = acquireCellSkin(renderer);
+    const CellRectTable& grid = layout.nextGrid;
+    for (int gy = 0; gy < grid.rows; ++gy) {
+        for (int gx = 0; gx < grid.cols; ++gx) {
+            const SDL_Rect& q = grid.at(gx, gy);
             bool isLight = ((gx + gy) & 1) != 0;
-            if (themeManager.getTheme().next_grid_use_rgb) {
-                if (isLight)
-                    SDL_SetRenderDrawColor(renderer, themeManager.getTheme().next_grid_light_r, 
-                                          themeManager.getTheme().next_grid_light_g, 
-                                          themeManager.getTheme().next_grid_light_b, 255);
-                else
-                    SDL_SetRenderDrawColor(renderer, themeManager.getTheme().next_grid_dark_r, 
-                                          themeManager.getTheme().next_grid_dark_g, 
-                                          themeManager.getTheme().next_grid_dark_b, 255);
+            if (th.next_grid_use_rgb) {
+                if (isLight) addCell(skin, q, th.next_grid_light_r, th.next_grid_light_g, th.next_grid_light_b, false);
+                else addCell(skin, q, th.next_grid_dark_r, th.next_grid_dark_g, th.next_grid_dark_b, false);
             } else {
-                Uint8 v = isLight ? themeManager.getTheme().next_grid_light : themeManager.getTheme().next_grid_dark;
-                SDL_SetRenderDrawColor(renderer, v, v, v, 255);
+                Uint8 v = isLight ? th.next_grid_light : th.next_grid_dark;
+                addCell(skin, q, v, v, v, false);
             }
-            SDL_RenderFillRect(renderer, &q);
         }
     }
+    // Piece cells overlap the checkerboard: one draw keeps them on top; the
+    // FillRects fallback groups by color, so it submits the grid first
+    if (!QuadBatch::preservesOrder()) flushCells(renderer, skin);
     
-    // Draw centered piece (distorts in STRETCH mode)
-    if (nextIdx >= 0 && nextIdx < (int)PIECES.size()) {
+    // Centered piece (precomputed per piece; colors can change at runtime)
+    if (nextIdx >= 0 && nextIdx < (int)PIECES.size() && nextIdx < (int)layout.nextPieces.size()) {
         const auto& pc = PIECES[nextIdx];
-        if (!pc.rot.empty() && !pc.rot[0].empty()) {
-            int minx = 999, maxx = -999, miny = 999, maxy = -999;
-            for (auto [px,py] : pc.rot[0]) {
-                if (px < minx) minx = px;
-                if (px > maxx) maxx = px;
-                if (py < miny) miny = py;
-                if (py > maxy) maxy = py;
-            }
-            int blocksW = (maxx - minx + 1);
-            int blocksH = (maxy - miny + 1);
-            int startX = gridX + (gridW - blocksW * cellMiniW) / 2 - minx * cellMiniW;
-            int startY = gridY + (gridH - blocksH * cellMiniH) / 2 - miny * cellMiniH;
-            for (auto [px,py] : pc.rot[0]) {
-            SDL_Rect rr{startX + px * cellMiniW, startY + py * cellMiniH,
-                           cellMiniW - scaleCellSpacing(1, layout.scaleX), 
-                           cellMiniH - scaleCellSpacing(1, layout.scaleY)};
-                SDL_SetRenderDrawColor(renderer, pc.r, pc.g, pc.b, 255);
-                SDL_RenderFillRect(renderer, &rr);
+        const PieceRectRange& range = layout.nextPieces[nextIdx];
+        for (int i = 0; i < range.count; ++i) addCell(skin, layout.nextPieceCells[range.begin + i], pc.r, pc.g, pc.b, true);
+    }
+    
+    // Resto da fila: fundo liso por slot no mesmo batch, miniaturas do atlas por cima
+    const int queued = std::min(g.queue, next.count - 1);
+    const Uint8 slotR = th.next_grid_use_rgb ? th.next_grid_dark_r : th.next_grid_dark;
+    const Uint8 slotG = th.next_grid_use_rgb ? th.next_grid_dark_g : th.next_grid_dark;
+    const Uint8 slotB = th.next_grid_use_rgb ? th.next_grid_dark_b : th.next_grid_dark;
+    for (int k = 0; k < queued; ++k)
+        addCell(skin, SDL_Rect{g.queueX + k * (g.slotW + g.queueGap), g.queueY, g.slotW, g.slotH}, slotR, slotG, slotB, false);
+    const bool atlas = queued > 0 &&
+        queueAtlas_.prepare(renderer, layout, layout.nextQueuePieces, layout.nextQueueCells, g.slotW, g.slotH, "NextLayer");
+    if (!atlas) {
+        if (queued > 0 && !QuadBatch::preservesOrder()) flushCells(renderer, skin);
+        for (int k = 0; k < queued; ++k) {
+            const int idx = next.idx[k + 1];
+            if (idx < 0 || idx >= (int)PIECES.size() || idx >= (int)layout.nextQueuePieces.size()) continue;
+            const auto& pc = PIECES[idx];
+            const PieceRectRange& range = layout.nextQueuePieces[idx];
+            const int dx = g.queueX + k * (g.slotW + g.queueGap);
+            for (int c = 0; c < range.count; ++c) {
+                SDL_Rect r = layout.nextQueueCells[range.begin + c];
+                r.x += dx; r.y += g.queueY;
+                addCell(skin, r, pc.r, pc.g, pc.b, true);
             }
         }
     }
+    flushCells(renderer, skin);
+    if (atlas) {
+        for (int k = 0; k < queued; ++k)
+            queueAtlas_.blit(renderer, next.idx[k + 1], SDL_Rect{g.queueX + k * (g.slotW + g.queueGap), g.queueY, g.slotW, g.slotH});
+    }
+}
+
+// PieceAtlas
+PieceAtlas::~PieceAtlas() {
+    renderTargetPool().release(texture_);
+}
+
+bool PieceAtlas::prepare(SDL_Renderer* renderer, const LayoutCache& layout, const std::vector<PieceRectRange>& pieces,
+                         const std::vector<SDL_Rect>& cells, int slotW, int slotH, const char* owner) {
+    const int count = std::min((int)pieces.size(), (int)PIECES.size());
+    if (failed_ || count == 0 || slotW <= 0 || slotH <= 0) return false;
+    
+    const CellSkin* skin = acquireCellSkin(renderer);
+    const Uint32 skinGeneration = skin ? skin->generation : 0;
+    std::uint64_t colors = mixVersion(kVersionSeed, (std::uint64_t)count);
+    for (int i = 0; i < count; ++i) colors = mixVersion(colors, ((std::uint64_t)PIECES[i].r << 16) | ((std::uint64_t)PIECES[i].g << 8) | PIECES[i].b);
+    const Uint32 epoch = renderTargetPool().targetsEpoch();
+    if (texture_ && layout_ == layout.cellRectsVersion && skin_ == skinGeneration && colors_ == colors &&
+        slotW == slotW_ && slotH == slotH_ && count == count_ && epoch_ == epoch) return true;
+    
+    if (!texture_ || slotW != slotW_ || slotH != slotH_ || count != count_ || epoch_ != epoch) {
+        renderTargetPool().release(texture_);
+        texture_ = nullptr;
+        SDL_RendererInfo info;
+        int maxW = 4096, maxH = 4096;
+        if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+            maxW = info.max_texture_width; maxH = info.max_texture_height;
+        }
+        cols_ = std::max(1, std::min(count, maxW / slotW));
+        const int rows = (count + cols_ - 1) / cols_;
+        if (cols_ * slotW <= maxW && rows * slotH <= maxH)
+            texture_ = renderTargetPool().acquire(renderer, cols_ * slotW, rows * slotH, TextureUse::THUMBS);
+        if (!texture_) {
+            failed_ = true;
+            count_ = 0;
+            DebugLogger::warning(std::string(owner) + ": atlas de miniaturas indisponivel, desenhando em modo imediato: " + std::string(SDL_GetError()));
+            return false;
+        }
+        slotW_ = slotW; slotH_ = slotH; count_ = count;
+        epoch_ = epoch;
+    }
+    
+    // Pode estar dentro da região retida do RenderManager: viewport e clip voltam como estavam
+    SDL_Texture* prevTarget = SDL_GetRenderTarget(renderer);
+    SDL_Rect viewport, clip;
+    SDL_RenderGetViewport(renderer, &viewport);
+    SDL_RenderGetClipRect(renderer, &clip);
+    const bool clipped = SDL_RenderIsClipEnabled(renderer) == SDL_TRUE;
+    SDL_SetRenderTarget(renderer, texture_);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    DrawCalls::clear(renderer);
+    for (int i = 0; i < count; ++i) {
+        const int dx = (i % cols_) * slotW, dy = (i / cols_) * slotH;
+        const auto& pc = PIECES[i];
+        const PieceRectRange& range = pieces[i];
+        for (int c = 0; c < range.count; ++c) {
+            SDL_Rect r = cells[range.begin + c];
+            r.x += dx; r.y += dy;
+            addCell(skin, r, pc.r, pc.g, pc.b, true);
+        }
+    }
+    flushCells(renderer, skin);
+    SDL_SetRenderTarget(renderer, prevTarget);
+    SDL_RenderSetViewport(renderer, &viewport);
+    SDL_RenderSetClipRect(renderer, clipped ? &clip : nullptr);
+    layout_ = layout.cellRectsVersion;
+    skin_ = skinGeneration;
+    colors_ = colors;
+    return true;
+}
+
+void PieceAtlas::blit(SDL_Renderer* renderer, int piece, const SDL_Rect& dst) const {
+    if (!texture_ || piece < 0 || piece >= count_) return;
+    SDL_Rect src{(piece % cols_) * slotW_, (piece / cols_) * slotH_, slotW_, slotH_};
+    DrawCalls::copy(renderer, texture_, &src, &dst);
 }
 
 // PieceStatsLayer
+
+void PieceStatsLayer::selectRows(const std::vector<int>& counts, int rows) {
+    const int n = std::min((int)PIECES.size(), PIECE_TABLE.size());
+    order_.resize(n);
+    for (int i = 0; i < n; ++i) order_[i] = i;
+    if (rows >= n) return;
+    // Mais peças que linhas: as mais sorteadas primeiro, empate pelo índice (ordem estável entre frames)
+    auto countOf = [&](int i) { return i < (int)counts.size() ? counts[i] : 0; };
+    std::partial_sort(order_.begin(), order_.begin() + rows, order_.end(), [&](int a, int b) {
+        const int ca = countOf(a), cb = countOf(b);
+        return ca != cb ? ca > cb : a < b;
+    });
+    order_.resize(rows);
+}
+
 void PieceStatsLayer::render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) {
     const std::vector<int>* pieceStats = nullptr;
     if (!db_getPieceStats(state, pieceStats) || pieceStats == nullptr || PIECES.empty()) return;
     
-    // Calcular tamanho da caixa de estatísticas (distorce em STRETCH mode)
-    // Peças maiores (50% do tamanho do board, não 33%)
-    int miniCellW = std::max(2, (int)(layout.cellBoardW / 2));
-    int miniCellH = std::max(2, (int)(layout.cellBoardH / 2));
-    int cellSizeW = (int)(miniCellW * 4.5f);  // Espaço para 4 blocos + margem
-    int cellSizeH = (int)(miniCellH * 4.5f);
-    int rowHeight = cellSizeH + scaleOffsetY(4, layout);
-    int numPieces = (int)PIECES.size();
-    int statsPad = scaleOffsetY(10, layout);
-    
     if (!layout.statsConfig.enabled) return;
-    
-    // Use new layout system if configured, otherwise fall back to legacy
-    int statsBoxX = layout.statsRect.w > 0 ? layout.statsRect.x : (layout.BX + layout.BW + layout.statsMargin);
-    int statsBoxY = layout.statsRect.w > 0 ? layout.statsRect.y : layout.GY;
-    int statsBoxW = layout.statsRect.w > 0 ? layout.statsRect.w : layout.statsBoxW;
-    int statsBoxH = layout.statsRect.w > 0 ? layout.statsRect.h : layout.GH;
+    const StatsGeometry g = statsGeometry(layout);
     
     // Desenhar caixa ao redor das estatísticas - elliptical corners in STRETCH mode
-    drawRoundedFilled(renderer, statsBoxX, statsBoxY, statsBoxW, statsBoxH, layout.borderRadiusX, layout.borderRadiusY,
-                      themeManager.getTheme().stats_fill_r, 
-                      themeManager.getTheme().stats_fill_g, 
-                      themeManager.getTheme().stats_fill_b, 255);
+    if (!blitPanel(renderer, layout, &TextureCache::getStatsBoxTexture, g.boxX, g.boxY, g.boxW, g.boxH)) {
+        drawRoundedFilled(renderer, g.boxX, g.boxY, g.boxW, g.boxH, layout.borderRadiusX, layout.borderRadiusY,
+                          themeManager.getTheme().stats_fill_r, 
+                          themeManager.getTheme().stats_fill_g, 
+                          themeManager.getTheme().stats_fill_b, 255);
+    }
     
-    // Renderizar estatísticas de cada peça (sem título, peças centralizadas)
-    int statY = statsBoxY + statsPad;
-    int statX = statsBoxX + (statsBoxW - cellSizeW) / 2;  // Centralizar horizontalmente
+    selectRows(*pieceStats, statsVisibleRows(g));
+    const int thumbs = (int)layout.statsPieces.size();
     
-    for (size_t i = 0; i < PIECES.size(); ++i) {
-        int count = 0;
-        if (i < pieceStats->size()) {
-            count = (*pieceStats)[i];
+    // Pass 1: thumbnails, one atlas tile per row (or every cell into the batch)
+    if (atlas_.prepare(renderer, layout, layout.statsPieces, layout.statsPieceCells, g.slotW, g.slotH, "PieceStatsLayer")) {
+        for (size_t row = 0; row < order_.size(); ++row) {
+            const int i = order_[row];
+            if (i >= thumbs) continue;
+            atlas_.blit(renderer, i, SDL_Rect{g.slotX, g.firstY + (int)row * g.rowHeight, g.slotW, g.slotH});
         }
-        
-        const auto& pc = PIECES[i];
-        
-        // Desenhar miniatura da peça CENTRALIZADA no bloco (distorce em STRETCH mode)
-        if (!pc.rot.empty() && !pc.rot[0].empty()) {
-            int minx = 999, maxx = -999, miny = 999, maxy = -999;
-            for (auto [px,py] : pc.rot[0]) {
-                if (px < minx) minx = px;
-                if (px > maxx) maxx = px;
-                if (py < miny) miny = py;
-                if (py > maxy) maxy = py;
-            }
-            int blocksW = (maxx - minx + 1);
-            int blocksH = (maxy - miny + 1);
-            
-            // Centralizar peça no bloco completo
-            int startX = statX + (cellSizeW - blocksW * miniCellW) / 2 - minx * miniCellW;
-            int startY = statY + (cellSizeH - blocksH * miniCellH) / 2 - miny * miniCellH;
-            
-            for (auto [px,py] : pc.rot[0]) {
-                SDL_Rect rr{startX + px * miniCellW, startY + py * miniCellH, 
-                           miniCellW - scaleCellSpacing(1, layout.scaleX), 
-                           miniCellH - scaleCellSpacing(1, layout.scaleY)};
-                SDL_SetRenderDrawColor(renderer, pc.r, pc.g, pc.b, 255);
-                SDL_RenderFillRect(renderer, &rr);
+    } else {
+        const CellSkin* skin = acquireCellSkin(renderer);
+        for (size_t row = 0; row < order_.size(); ++row) {
+            const int i = order_[row];
+            if (i >= thumbs) continue;
+            const auto& pc = PIECES[i];
+            const PieceRectRange& range = layout.statsPieces[i];
+            const int dy = g.firstY + (int)row * g.rowHeight;
+            for (int c = 0; c < range.count; ++c) {
+                SDL_Rect r = layout.statsPieceCells[range.begin + c];
+                r.x += g.slotX; r.y += dy;
+                addCell(skin, r, pc.r, pc.g, pc.b, true);
             }
         }
+        flushCells(renderer, skin);
+    }
+    
+    // Pass 2: counts
+    const int statX = g.slotX, cellSizeW = g.slotW, cellSizeH = g.slotH, rowHeight = g.rowHeight;
+    if (countStrs_.size() < PIECES.size()) { countStrs_.resize(PIECES.size()); lastCounts_.resize(PIECES.size(), 0); }
+    int statY = g.firstY;
+    for (int i : order_) {
+        int count = 0;
+        if (i < (int)pieceStats->size()) {
+            count = (*pieceStats)[i];
+        }
         
         // Contagem CENTRALIZADA SOBRE a peça com outline preto
-        std::string countStr = std::to_string(count);
+        const std::string& countStr = formatCached(count, lastCounts_[i], countStrs_[i]);
         float numberScaleX = layout.scaleTextX * 0.8f;  // Um pouco maior que antes
         float numberScaleY = layout.scaleTextY * 0.8f;
         int countW = textWidthPx(countStr, numberScaleX);
         int countX = statX + (cellSizeW - countW) / 2;  // Centralizar
         int countY = statY + (cellSizeH - (int)(7 * numberScaleY)) / 2;  // Centralizar verticalmente
         
-        drawPixelTextOutlined(renderer, countX, countY, countStr, numberScaleX, numberScaleY,
+        drawCachedTextOutlined(renderer, layout, countX, countY, countStr, numberScaleX, numberScaleY,
                              themeManager.getTheme().stats_count_r,
                              themeManager.getTheme().stats_count_g,
                              themeManager.getTheme().stats_count_b,
@@ -402,6 +757,23 @@ void PieceStatsLayer::render(SDL_Renderer* renderer, const GameState& state, con
 }
 int PieceStatsLayer::getZOrder() const { return 2; }
 std::string PieceStatsLayer::getName() const { return "PieceStats"; }
+bool PieceStatsLayer::getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const {
+    if (!layout.statsConfig.enabled || PIECES.empty()) return false;
+    // Só as linhas visíveis; a caixa mínima (uma linha) pode passar do fundo
+    const StatsGeometry g = statsGeometry(layout);
+    const SDL_Rect box{g.boxX, g.boxY, g.boxW, g.boxH};
+    const int rows = std::min((int)PIECES.size(), statsVisibleRows(g));
+    const SDL_Rect rowsRect{g.slotX, g.firstY, g.slotW, rows * g.rowHeight};
+    SDL_UnionRect(&box, &rowsRect, &bounds);
+    return bounds.w > 0 && bounds.h > 0;
+}
+std::uint64_t PieceStatsLayer::contentVersion(const GameState& state) const {
+    const std::vector<int>* pieceStats = nullptr;
+    if (!db_getPieceStats(state, pieceStats) || pieceStats == nullptr) return 0;
+    std::uint64_t h = mixVersion(kVersionSeed, pieceStats->size());
+    for (int count : *pieceStats) h = mixVersion(h, (std::uint64_t)(Uint32)count);
+    return h;
+}
 
 // BoardLayer
 int BoardLayer::getZOrder() const { return 3; } // Mudado de 2 para 3
@@ -409,17 +781,43 @@ int BoardLayer::getZOrder() const { return 3; } // Mudado de 2 para 3
 // HUDLayer
 int HUDLayer::getZOrder() const { return 4; } // Mudado de 3 para 4
 std::string HUDLayer::getName() const { return "HUD"; }
+bool HUDLayer::getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const {
+    if (!layout.hudConfig.enabled) return false;
+    bounds = hudBox(layout);
+    return bounds.w > 0 && bounds.h > 0;
+}
 
 // NextLayer
 int NextLayer::getZOrder() const { return 5; } // Independent NEXT preview
 std::string NextLayer::getName() const { return "Next"; }
+bool NextLayer::getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const {
+    if (!layout.nextConfig.enabled) return false;
+    const NextGeometry g = nextGeometry(layout);
+    if (!g.valid) return false;
+    const SDL_Rect box{g.boxX, g.boxY, g.boxW, g.boxH};
+    const SDL_Rect grid{g.gridX, g.gridY, g.gridW, g.gridH};
+    SDL_UnionRect(&box, &grid, &bounds);
+    if (g.queue > 0) {
+        const SDL_Rect row{g.queueX, g.queueY, g.queue * g.slotW + (g.queue - 1) * g.queueGap, g.slotH};
+        const SDL_Rect withGrid = bounds;
+        SDL_UnionRect(&withGrid, &row, &bounds);
+    }
+    return bounds.w > 0 && bounds.h > 0;
+}
+std::uint64_t NextLayer::contentVersion(const GameState& state) const {
+    NextView next;
+    if (!db_getNextView(state, next) || next.count == 0) return 0;
+    // A fila inteira: cada spawn já muda idx[0], então as entradas extras não custam redesenho a mais
+    std::uint64_t h = mixVersion(kVersionSeed, (std::uint64_t)next.count);
+    for (int k = 0; k < next.count; ++k) h = mixVersion(h, (std::uint64_t)(Uint32)next.idx[k] + 1);
+    return h;
+}
 
 // ScoreLayer (independent score/lines/level box)
 void ScoreLayer::render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) {
     if (!layout.scoreConfig.enabled) return;
     
     // Get score data
-    auto fmtScore = [](int s){ char b[32]; std::snprintf(b,sizeof(b), "%d", s); return std::string(b); };
     int score = db_getScore(state);
     int lines = db_getLines(state);
     int level = db_getLevel(state);
@@ -434,9 +832,11 @@ void ScoreLayer::render(SDL_Renderer* renderer, const GameState& state, const La
     if (boxX < 0 || boxW <= 0) return;
     
     // Draw box background
-    drawRoundedFilled(renderer, boxX, boxY, boxW, boxH, layout.borderRadiusX, layout.borderRadiusY,
-                      themeManager.getTheme().score_fill_r, themeManager.getTheme().score_fill_g, 
-                      themeManager.getTheme().score_fill_b, 255);
+    if (!blitPanel(renderer, layout, &TextureCache::getScoreBoxTexture, boxX, boxY, boxW, boxH)) {
+        drawRoundedFilled(renderer, boxX, boxY, boxW, boxH, layout.borderRadiusX, layout.borderRadiusY,
+                          themeManager.getTheme().score_fill_r, themeManager.getTheme().score_fill_g, 
+                          themeManager.getTheme().score_fill_b, 255);
+    }
     
     // Same top margin as NEXT (pad*2 for consistency)
     int pad = scaleOffsetY(10, layout);
@@ -444,59 +844,69 @@ void ScoreLayer::render(SDL_Renderer* renderer, const GameState& state, const La
     int ty = boxY + pad*2;  // Same top margin as NEXT
     
     // SCORE (centered label, right-aligned number)
-    std::string scoreLabel = "SCORE";
+    const std::string& scoreLabel = kScoreLabel;
     int scoreLabelW = textWidthPx(scoreLabel, layout.scaleTextX);
     int labelX = boxX + (boxW - scoreLabelW) / 2;  // Centered
-    drawPixelText(renderer, labelX, ty, scoreLabel, layout.scaleTextX, layout.scaleTextY, 
+    drawCachedText(renderer, layout, labelX, ty, scoreLabel, layout.scaleTextX, layout.scaleTextY, 
                   themeManager.getTheme().hud_label_r, themeManager.getTheme().hud_label_g, themeManager.getTheme().hud_label_b); 
     ty += scaleTextSpacing(10, layout);
     
-    std::string scoreStr = fmtScore(score);
+    const std::string& scoreStr = formatCached(score, lastScore_, scoreStr_);
     int scoreW = textWidthPx(scoreStr, layout.scaleTextX);
     int scoreX = boxX + boxW - scoreW - textPad;  // Right-aligned
-    drawPixelText(renderer, scoreX, ty, scoreStr, layout.scaleTextX, layout.scaleTextY,
+    drawCachedText(renderer, layout, scoreX, ty, scoreStr, layout.scaleTextX, layout.scaleTextY,
                   themeManager.getTheme().hud_score_r, themeManager.getTheme().hud_score_g, themeManager.getTheme().hud_score_b); 
     ty += scaleTextSpacing(14, layout);
     
     // LINES (centered label, right-aligned number)
-    std::string linesLabel = "LINES";
+    const std::string& linesLabel = kLinesLabel;
     int linesLabelW = textWidthPx(linesLabel, layout.scaleTextX);
     labelX = boxX + (boxW - linesLabelW) / 2;
-    drawPixelText(renderer, labelX, ty, linesLabel, layout.scaleTextX, layout.scaleTextY,
+    drawCachedText(renderer, layout, labelX, ty, linesLabel, layout.scaleTextX, layout.scaleTextY,
                   themeManager.getTheme().hud_label_r, themeManager.getTheme().hud_label_g, themeManager.getTheme().hud_label_b); 
     ty += scaleTextSpacing(10, layout);
     
-    std::string linesStr = std::to_string(lines);
+    const std::string& linesStr = formatCached(lines, lastLines_, linesStr_);
     int linesW = textWidthPx(linesStr, layout.scaleTextX);
     int linesX = boxX + boxW - linesW - textPad;
-    drawPixelText(renderer, linesX, ty, linesStr, layout.scaleTextX, layout.scaleTextY,
+    drawCachedText(renderer, layout, linesX, ty, linesStr, layout.scaleTextX, layout.scaleTextY,
                   themeManager.getTheme().hud_lines_r, themeManager.getTheme().hud_lines_g, themeManager.getTheme().hud_lines_b); 
     ty += scaleTextSpacing(14, layout);
     
     // LEVEL (centered label, right-aligned number)
-    std::string levelLabel = "LEVEL";
+    const std::string& levelLabel = kLevelLabel;
     int levelLabelW = textWidthPx(levelLabel, layout.scaleTextX);
     labelX = boxX + (boxW - levelLabelW) / 2;
-    drawPixelText(renderer, labelX, ty, levelLabel, layout.scaleTextX, layout.scaleTextY,
+    drawCachedText(renderer, layout, labelX, ty, levelLabel, layout.scaleTextX, layout.scaleTextY,
                   themeManager.getTheme().hud_label_r, themeManager.getTheme().hud_label_g, themeManager.getTheme().hud_label_b); 
     ty += scaleTextSpacing(10, layout);
     
-    std::string levelStr = std::to_string(level);
+    const std::string& levelStr = formatCached(level, lastLevel_, levelStr_);
     int levelW = textWidthPx(levelStr, layout.scaleTextX);
     int levelX = boxX + boxW - levelW - textPad;
-    drawPixelText(renderer, levelX, ty, levelStr, layout.scaleTextX, layout.scaleTextY,
+    drawCachedText(renderer, layout, levelX, ty, levelStr, layout.scaleTextX, layout.scaleTextY,
                   themeManager.getTheme().hud_level_r, themeManager.getTheme().hud_level_g, themeManager.getTheme().hud_level_b); 
 }
 int ScoreLayer::getZOrder() const { return 5; } // Same Z as Next
 std::string ScoreLayer::getName() const { return "Score"; }
+bool ScoreLayer::getCacheBounds(const LayoutCache& layout, SDL_Rect& bounds) const {
+    if (!layout.scoreConfig.enabled || layout.scoreRect.w <= 0 || layout.scoreRect.x < 0) return false;
+    bounds = layout.scoreRect;
+    return bounds.h > 0;
+}
+std::uint64_t ScoreLayer::contentVersion(const GameState& state) const {
+    std::uint64_t h = mixVersion(kVersionSeed, (std::uint64_t)(Uint32)db_getScore(state));
+    h = mixVersion(h, (std::uint64_t)(Uint32)db_getLines(state));
+    return mixVersion(h, (std::uint64_t)(Uint32)db_getLevel(state));
+}
 
 // OverlayLayer
 void OverlayLayer::render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) {
     const bool isPaused = db_isPaused(state);
     const bool isGameOver = db_isGameOver(state);
     if (isGameOver || isPaused) {
-        const std::string topText = isPaused ? "PAUSE" : "GAME OVER";
-        const std::string subText = isPaused ? "" : "PRESS START";
+        const std::string& topText = isPaused ? kPauseText : kGameOverText;
+        const std::string& subText = isPaused ? kNoText : kPressStartText;
         // Text distorts in STRETCH mode
         float topScaleX = layout.scaleTextX * (layout.scale + 2) / layout.scale;
         float topScaleY = layout.scaleTextY * (layout.scale + 2) / layout.scale;
@@ -512,13 +922,6 @@ void OverlayLayer::render(SDL_Renderer* renderer, const GameState& state, const
         int overlayRadX = scaleOffsetX(14, layout);
         int overlayRadY = scaleOffsetY(14, layout);
         
-        // DEBUG: Log colors being used for overlay rendering
-        std::stringstream debugOverlay;
-        debugOverlay << "OverlayLayer rendering - fill: #" 
-                     << std::hex << std::setfill('0') << std::setw(2) << (int)themeManager.getTheme().overlay_fill_r
-                     << std::setw(2) << (int)themeManager.getTheme().overlay_fill_g
-                     << std::setw(2) << (int)themeManager.getTheme().overlay_fill_b;
-        
         drawRoundedFilled(renderer, ox, oy, ow, oh, overlayRadX, overlayRadY, themeManager.getTheme().overlay_fill_r, themeManager.getTheme().overlay_fill_g, themeManager.getTheme().overlay_fill_b, themeManager.getTheme().overlay_fill_a);
         drawRoundedOutline(renderer, ox, oy, ow, oh, overlayRadX, overlayRadY, 2, themeManager.getTheme().overlay_outline_r, themeManager.getTheme().overlay_outline_g, themeManager.getTheme().overlay_outline_b, themeManager.getTheme().overlay_outline_a);
         int txc = ox + (ow - topW) / 2, tyc = oy + padY;
@@ -534,6 +937,96 @@ std::string OverlayLayer::getName() const { return "Overlay"; }
 
 // PostEffectsLayer
 PostEffectsLayer::PostEffectsLayer(AudioSystem* audio) : audio_(audio) {}
+
+PostEffectsLayer::~PostEffectsLayer() {
+    renderTargetPool().release(scanlineTex_);
+    renderTargetPool().release(sweepTex_);
+}
+
+namespace {
+    // Coluna RGBA de 1 px de largura com alpha por linha
+    SDL_Texture* createColumnTexture(SDL_Renderer* renderer, const std::vector<Uint32>& column, SDL_BlendMode blend) {
+        SDL_Texture* tex = renderTargetPool().create(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 1, (int)column.size(),
+                                                     TextureUse::EFFECTS);
+        if (!tex) return nullptr;
+        SDL_UpdateTexture(tex, nullptr, column.data(), (int)sizeof(Uint32));
+        SDL_SetTextureBlendMode(tex, blend);
+        return tex;
+    }
+}
+
+void PostEffectsLayer::dropLostTextures() {
+    if (texturesEpoch_ == renderTargetPool().deviceEpoch()) return;
+    texturesEpoch_ = renderTargetPool().deviceEpoch();
+    renderTargetPool().release(scanlineTex_);
+    renderTargetPool().release(sweepTex_);
+    scanlineTex_ = sweepTex_ = nullptr;
+}
+
+bool PostEffectsLayer::ensureScanlineTexture(SDL_Renderer* renderer, int areaH, int alpha) {
+    dropLostTextures();
+    if (scanlineTex_ && scanlineH_ == areaH && scanlineAlpha_ == alpha) return true;
+    if (scanlineTex_) { renderTargetPool().release(scanlineTex_); scanlineTex_ = nullptr; }
+    if (texturesFailed_ || areaH <= 0) return false;
+    
+    std::vector<Uint32> column((size_t)areaH, 0u);
+    for (int y = 0; y < areaH; y += 2) column[y] = (Uint32)(alpha & 0xFF);   // preto, alpha
+    scanlineTex_ = createColumnTexture(renderer, column, SDL_BLENDMODE_BLEND);
+    if (!scanlineTex_) {
+        texturesFailed_ = true;
+        DebugLogger::warning("PostEffectsLayer: texturas indisponiveis, efeitos por linhas: " + std::string(SDL_GetError()));
+        return false;
+    }
+    scanlineH_ = areaH;
+    scanlineAlpha_ = alpha;
+    return true;
+}
+
+bool PostEffectsLayer::ensureSweepTexture(SDL_Renderer* renderer, int bandH, int alphaMax, float softness) {
+    dropLostTextures();
+    if (sweepTex_ && sweepBandH_ == bandH && sweepAlphaMax_ == alphaMax && sweepSoftness_ == softness) return true;
+    if (sweepTex_) { renderTargetPool().release(sweepTex_); sweepTex_ = nullptr; }
+    if (texturesFailed_ || bandH <= 0) return false;
+    
+    std::vector<Uint32> column((size_t)bandH, 0u);
+    float sigma = 0.3f + (1.0f - softness) * 0.4f;
+    for (int i = 0; i < bandH; ++i) {
+        float distance = ((float)i / (float)bandH - 0.5f) * 2.0f;
+        float k = std::exp(-(distance * distance) / (2.0f * sigma * sigma));
+        Uint8 a = (Uint8)std::round(alphaMax * k);
+        column[i] = 0xFFFFFF00u | a;   // branco, alpha gaussiano
+    }
+    sweepTex_ = createColumnTexture(renderer, column, SDL_BLENDMODE_ADD);
+    if (!sweepTex_) {
+        texturesFailed_ = true;
+        DebugLogger::warning("PostEffectsLayer: texturas indisponiveis, efeitos por linhas: " + std::string(SDL_GetError()));
+        return false;
+    }
+    sweepBandH_ = bandH;
+    sweepAlphaMax_ = alphaMax;
+    sweepSoftness_ = softness;
+    return true;
+}
+
+bool PostEffectsLayer::isAnimated(const GameState&) const {
+    return db_getVisualEffects().globalSweep;  // Scanlines são estáticas
+}
+
+bool postEffectsSweepBand(const LayoutCache& layout, const VisualEffectsView& vis, int& sweepY, int& bandH) {
+    const int virtualAreaH = (int)(layout.virtualHeight * layout.scaleY);
+    float tsec = SDL_GetTicks() / 1000.0f;
+    bandH = (int)(vis.sweepGBandHPx * layout.scaleY); // Scale sweep band with virtual area
+    if (bandH < 1 || virtualAreaH < 1) return false;
+    if (bandH > virtualAreaH) bandH = virtualAreaH;
+    if (bandH > 1024) bandH = 1024; // safety cap to keep frame responsive
+    float speed = (float)vis.sweepGSpeedPxps * layout.scaleY; // Scale speed with virtual area
+    if (speed < 1.0f) speed = 1.0f;
+    if (speed > 4000.0f) speed = 4000.0f;
+    int total = virtualAreaH + bandH;
+    sweepY = (int)std::fmod(tsec * speed, (float)total) - bandH;
+    return true;
+}
+
 void PostEffectsLayer::render(SDL_Renderer* renderer, const GameState&, const LayoutCache& layout) {
     if (layout.SWr <= 0 || layout.SHr <= 0) { return; }
     
@@ -543,41 +1036,56 @@ void PostEffectsLayer::render(SDL_Renderer* renderer, const GameState&, const La
     int virtualAreaW = (int)(layout.virtualWidth * layout.scaleX);
     int virtualAreaH = (int)(layout.virtualHeight * layout.scaleY);
     
+    // CRT_SHADER: scanlines e sweep saem no shader do frame; os sons continuam aqui
+    const bool shader = layout.shaderEffects;
     const auto& vis = db_getVisualEffects();
     if (vis.scanlineAlpha > 0) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, (Uint8)vis.scanlineAlpha);
-        // Scanlines only in virtual area
-        for (int y = virtualAreaY; y < virtualAreaY + virtualAreaH; y += 2) {
-            SDL_Rect sl{virtualAreaX, y, virtualAreaW, 1};
-            SDL_RenderFillRect(renderer, &sl);
+        if (shader) {
+            // Desenhadas pelo CrtShader
+        } else if (ensureScanlineTexture(renderer, virtualAreaH, vis.scanlineAlpha)) {
+            SDL_Rect dst{virtualAreaX, virtualAreaY, virtualAreaW, virtualAreaH};
+            DrawCalls::copy(renderer, scanlineTex_, nullptr, &dst);
+        } else {
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, (Uint8)vis.scanlineAlpha);
+            // Scanlines only in virtual area
+            for (int y = virtualAreaY; y < virtualAreaY + virtualAreaH; y += 2) {
+                SDL_Rect sl{virtualAreaX, y, virtualAreaW, 1};
+                DrawCalls::fillRect(renderer, &sl);
+            }
         }
         if (audio_) audio_->playScanlineEffect();
     }
     if (vis.globalSweep) {
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
-        float tsec = SDL_GetTicks() / 1000.0f;
-        int bandH = (int)(vis.sweepGBandHPx * layout.scaleY); // Scale sweep band with virtual area
-        if (bandH < 1) { SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE); return; }
-        if (bandH > virtualAreaH) bandH = virtualAreaH;
-        if (bandH > 1024) bandH = 1024; // safety cap to keep frame responsive
-        float speed = (float)vis.sweepGSpeedPxps * layout.scaleY; // Scale speed with virtual area
-        if (speed < 1.0f) speed = 1.0f;
-        if (speed > 4000.0f) speed = 4000.0f;
-        int total = virtualAreaH + bandH;
-        int sweepY = (int)std::fmod(tsec * speed, (float)total) - bandH;
-        for (int i = 0; i < bandH; ++i) {
-            float normalizedPos = (float)i / (float)bandH;
-            float center = 0.5f;
-            float distance = (normalizedPos - center) * 2.0f;
-            float sigma = 0.3f + (1.0f - vis.sweepGSoftness) * 0.4f;
-            float softness = std::exp(-(distance * distance) / (2.0f * sigma * sigma));
-            Uint8 a = (Uint8)std::round(vis.sweepGAlphaMax * softness);
-            SDL_SetRenderDrawColor(renderer, 255, 255, 255, a);
-            int yy = virtualAreaY + sweepY + i;
-            if (yy >= virtualAreaY && yy < virtualAreaY + virtualAreaH) {
-                SDL_Rect line{virtualAreaX, yy, virtualAreaW, 1};
-                SDL_RenderFillRect(renderer, &line);
+        int sweepY = 0, bandH = 0;
+        if (!postEffectsSweepBand(layout, vis, sweepY, bandH)) { SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE); return; }
+        
+        if (shader) {
+            // Banda calculada de novo pelo CrtShader (mesmo relógio)
+        } else if (ensureSweepTexture(renderer, bandH, vis.sweepGAlphaMax, vis.sweepGSoftness)) {
+            // Only the rows of the band inside the virtual area
+            int first = std::max(0, -sweepY);
+            int last = std::min(bandH, virtualAreaH - sweepY);
+            if (last > first) {
+                SDL_Rect src{0, first, 1, last - first};
+                SDL_Rect dst{virtualAreaX, virtualAreaY + sweepY + first, virtualAreaW, last - first};
+                DrawCalls::copy(renderer, sweepTex_, &src, &dst);
+            }
+        } else {
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
+            for (int i = 0; i < bandH; ++i) {
+                float normalizedPos = (float)i / (float)bandH;
+                float center = 0.5f;
+                float distance = (normalizedPos - center) * 2.0f;
+                float sigma = 0.3f + (1.0f - vis.sweepGSoftness) * 0.4f;
+                float softness = std::exp(-(distance * distance) / (2.0f * sigma * sigma));
+                Uint8 a = (Uint8)std::round(vis.sweepGAlphaMax * softness);
+                SDL_SetRenderDrawColor(renderer, 255, 255, 255, a);
+                int yy = virtualAreaY + sweepY + i;
+                if (yy >= virtualAreaY && yy < virtualAreaY + virtualAreaH) {
+                    SDL_Rect line{virtualAreaX, yy, virtualAreaW, 1};
+                    DrawCalls::fillRect(renderer, &line);
+                }
             }
         }
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
@@ -5,8 +5,8 @@
 #include <SDL2/SDL.h>
 #include <algorithm>
 
-extern const int COLS;
-extern const int ROWS;
+extern int COLS;
+extern int ROWS;
 extern int BORDER;
 extern int HUD_FIXED_SCALE;
 extern LayoutConfig layoutConfig;
@@ -16,6 +16,10 @@ void db_layoutCalculate(LayoutCache& layout, SDL_Renderer* renderer) {
     // This is important when SDL_WINDOW_ALLOW_HIGHDPI is used
     int w, h;
     SDL_GetRendererOutputSize(renderer, &w, &h);
+    db_layoutCalculateSize(layout, w, h);
+}
+
+void db_layoutCalculateSize(LayoutCache& layout, int w, int h) {
     layout.SWr = w;
     layout.SHr = h;
     
@@ -46,6 +50,7 @@ void db_layoutCalculate(LayoutCache& layout, SDL_Renderer* renderer) {
     layout.hudConfig = layoutConfig.hud;
     layout.nextConfig = layoutConfig.next;
     layout.scoreConfig = layoutConfig.score;
+    layout.nextCount = layoutConfig.nextCount;
     
     // Copy global border settings
     layout.borderRadius = layoutConfig.borderRadius;
@@ -158,5 +163,7 @@ void db_layoutCalculate(LayoutCache& layout, SDL_Renderer* renderer) {
     layout.panelY = layout.hudRect.y;
     layout.panelW = layout.hudRect.w;
     layout.panelH = layout.hudRect.h;
+    
+    layoutBuildCellRects(layout);
 }
 
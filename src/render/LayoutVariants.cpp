@@ -0,0 +1,89 @@
+#include "render/LayoutVariants.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+#include <string>
+#include <utility>
+
+LayoutVariants::LayoutVariants() {
+    renderTargetPool().addEvictor(this);
+}
+
+LayoutVariants::~LayoutVariants() {
+    renderTargetPool().removeEvictor(this);
+    clear();
+}
+
+LayoutVariants::Entry* LayoutVariants::find(int w, int h, ScaleMode mode) {
+    for (Entry& e : entries_) {
+        if (e.used && e.w == w && e.h == h && e.mode == mode) return &e;
+    }
+    return nullptr;
+}
+
+bool LayoutVariants::swapTo(int w, int h, ScaleMode mode, LayoutCache& layout, TextureCache& panels) {
+    // Sai: o ativo vai para a própria chave, uma vaga ou a menos usada (que é descartada)
+    if (panels.isValid() && !panels.isRebaking() && layout.SWr > 0 && layout.SHr > 0) {
+        Entry* slot = find(layout.SWr, layout.SHr, layout.scaleMode);
+        if (!slot) {
+            for (Entry& e : entries_) {
+                if (!e.used) { slot = &e; break; }
+                if (!slot || e.stamp < slot->stamp) slot = &e;
+            }
+        }
+        std::swap(slot->layout, layout);
+        slot->panels.swap(panels);
+        slot->panels.retag(TextureUse::LAYOUTS);
+        slot->used = true;
+        slot->w = slot->layout.SWr;
+        slot->h = slot->layout.SHr;
+        slot->mode = slot->layout.scaleMode;
+        slot->stamp = ++clock_;
+        slot->frame = renderTargetPool().frame();
+    }
+    // O que sobrou no ativo (vazio ou a entrada descartada) volta ao pool antes do novo bake
+    panels.cleanup();
+
+    Entry* cached = find(w, h, mode);
+    if (!cached) {
+        ++misses_;
+        return false;
+    }
+    std::swap(cached->layout, layout);
+    cached->panels.swap(panels);
+    cached->panels.cleanup();
+    panels.retag(TextureUse::PANELS);
+    cached->used = false;
+    ++hits_;
+    DebugLogger::info("LayoutVariants: " + std::to_string(w) + "x" + std::to_string(h) + " reaproveitado");
+    return true;
+}
+
+void LayoutVariants::clear() {
+    for (Entry& e : entries_) {
+        e.panels.cleanup();
+        e.used = false;
+    }
+}
+
+Uint32 LayoutVariants::oldestTextureUse() const {
+    Uint32 oldest = UINT32_MAX;
+    for (const Entry& e : entries_) if (e.used) oldest = std::min(oldest, e.frame);
+    return oldest;
+}
+
+void LayoutVariants::evictOldestTexture() {
+    Entry* oldest = nullptr;
+    for (Entry& e : entries_) {
+        if (e.used && (!oldest || e.frame < oldest->frame)) oldest = &e;
+    }
+    if (!oldest) return;
+    DebugLogger::debug("LayoutVariants: " + std::to_string(oldest->w) + "x" + std::to_string(oldest->h) + " despejado");
+    oldest->panels.cleanup();
+    oldest->used = false;
+}
+
+int LayoutVariants::size() const {
+    int n = 0;
+    for (const Entry& e : entries_) n += e.used ? 1 : 0;
+    return n;
+}
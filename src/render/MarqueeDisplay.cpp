@@ -0,0 +1,269 @@
+#include "render/MarqueeDisplay.hpp"
+#include "render/GameStateBridge.hpp"
+#include "render/Primitives.hpp"
+#include "render/TexturePool.hpp"
+#include "pieces/Piece.hpp"
+#include "app/Metrics.hpp"
+#include "app/SessionLog.hpp"
+#include "ThemeManager.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <tuple>
+
+extern ThemeManager themeManager;
+extern std::vector<Piece> PIECES;
+
+namespace {
+inline Uint32 argb(Uint8 r, Uint8 g, Uint8 b) { return 0xFF000000u | ((Uint32)r << 16) | ((Uint32)g << 8) | b; }
+}
+
+bool MarqueeDisplay::Stamp::operator==(const Stamp& o) const {
+    return std::tie(board, active[0], active[1], active[2], active[3], next[0], next[1], next[2],
+                    score, lines, level, paused, over, theme, scores) ==
+           std::tie(o.board, o.active[0], o.active[1], o.active[2], o.active[3], o.next[0], o.next[1], o.next[2],
+                    o.score, o.lines, o.level, o.paused, o.over, o.theme, o.scores);
+}
+
+bool MarqueeDisplay::start(int display, int fps, int boardCols, int boardRows, SDL_Window* mainWindow) {
+    stop();
+    const int displays = SDL_GetNumVideoDisplays();
+    if (display < 0 || display >= displays) {
+        DebugLogger::warning("MARQUEE_DISPLAY " + std::to_string(display) + " inexistente (" +
+                             std::to_string(displays) + " tela(s)), marquee desligado");
+        return false;
+    }
+    SDL_Rect bounds;
+    if (SDL_GetDisplayBounds(display, &bounds) != 0) {
+        DebugLogger::warning("Marquee: SDL_GetDisplayBounds falhou: " + std::string(SDL_GetError()));
+        return false;
+    }
+    // Sem borda do tamanho da tela em vez de fullscreen: não minimiza quando o foco fica na principal
+    window_ = SDL_CreateWindow("DropBlocks Marquee", bounds.x, bounds.y, bounds.w, bounds.h,
+                               SDL_WINDOW_BORDERLESS | SDL_WINDOW_SKIP_TASKBAR);
+    if (!window_) {
+        DebugLogger::warning("Marquee: janela não criada: " + std::string(SDL_GetError()));
+        return false;
+    }
+    // Sem PRESENTVSYNC: o Present desta janela nunca espera o refresh da outra tela
+    renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer_) renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_SOFTWARE);
+    if (!renderer_) {
+        DebugLogger::warning("Marquee: renderer não criado: " + std::string(SDL_GetError()));
+        stop();
+        return false;
+    }
+    cols_ = std::max(1, boardCols);
+    rows_ = std::max(1, boardRows);
+    board_ = renderTargetPool().create(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, cols_, rows_, TextureUse::MARQUEE);
+    if (board_) SDL_SetTextureScaleMode(board_, SDL_ScaleModeNearest);
+    pixels_.assign((size_t)cols_ * rows_, 0u);
+
+    int w = bounds.w, h = bounds.h;
+    SDL_GetRendererOutputSize(renderer_, &w, &h);
+    computeLayout(w, h);
+    fps_ = std::max(1, fps);
+    intervalMs_ = (Uint32)(1000 / fps_);
+    nextFrame_ = 0;
+    hasDrawn_ = false;
+    if (mainWindow) SDL_RaiseWindow(mainWindow);  // Teclado segue na tela do jogo
+    DebugLogger::info("Marquee: tela " + std::to_string(display) + " " + std::to_string(w) + "x" + std::to_string(h) +
+                      " a " + std::to_string(fps_) + " fps");
+    return true;
+}
+
+void MarqueeDisplay::stop() {
+    if (board_) { renderTargetPool().release(board_); board_ = nullptr; }
+    if (renderer_) {
+        releaseGlyphAtlases(renderer_);
+        renderTargetPool().purge(renderer_);
+        SDL_DestroyRenderer(renderer_);
+        renderer_ = nullptr;
+    }
+    if (window_) { SDL_DestroyWindow(window_); window_ = nullptr; }
+}
+
+void MarqueeDisplay::computeLayout(int w, int h) {
+    // Topper deitado: tabuleiro à esquerda; em pé: em cima. O resto é placar/NEXT/TOP
+    const int m = std::max(4, std::min(w, h) / 20);
+    const bool landscape = w >= h;
+    const int areaW = landscape ? w / 3 : w - 2 * m;
+    const int areaH = landscape ? h - 2 * m : h * 3 / 5 - 2 * m;
+    const int cell = std::max(1, std::min(areaW / cols_, areaH / rows_));
+    boardRect_ = SDL_Rect{0, m, cell * cols_, cell * rows_};
+    boardRect_.x = landscape ? m : (w - boardRect_.w) / 2;
+    if (landscape) {
+        infoRect_ = SDL_Rect{boardRect_.x + boardRect_.w + 2 * m, m, 0, h - 2 * m};
+    } else {
+        infoRect_ = SDL_Rect{m, boardRect_.y + boardRect_.h + m, 0, 0};
+        infoRect_.h = h - infoRect_.y - m;
+    }
+    infoRect_.w = std::max(0, w - infoRect_.x - m);
+    // Duas colunas de ~12 caracteres e ~10 linhas de texto
+    const int byHeight = infoRect_.h / (10 * 9);
+    const int byWidth = infoRect_.w / (2 * 12 * 6);
+    textScale_ = std::max(1, std::min(byHeight, byWidth));
+}
+
+void MarqueeDisplay::trackScores(const GameState& state) {
+    const bool over = db_isGameOver(state);
+    const int score = over && !wasOver_ ? db_getScore(state) : 0;
+    if (score > 0) {
+        if (topCount_ < TOP_COUNT) {
+            top_[topCount_++] = score;
+        } else if (score > top_[TOP_COUNT - 1]) {
+            top_[TOP_COUNT - 1] = score;
+        }
+        std::sort(top_.begin(), top_.begin() + topCount_, std::greater<int>());
+    }
+    wasOver_ = over;
+}
+
+void MarqueeDisplay::update(const GameState& state, Uint32 now) {
+    if (!renderer_) return;
+    if (!scores_) trackScores(state);
+    if ((Sint32)(now - nextFrame_) < 0) return;
+    // Atrasado mais de um intervalo (idle, janela arrastada): recomeça daqui
+    nextFrame_ = (Sint32)(now - nextFrame_) > (Sint32)intervalMs_ ? now + intervalMs_ : nextFrame_ + intervalMs_;
+
+    Stamp stamp;
+    stamp.board = db_getBoardVersion(state);
+    db_getActive(state, stamp.active[0], stamp.active[1], stamp.active[2], stamp.active[3]);
+    NextView next;
+    if (db_getNextView(state, next)) {
+        for (int i = 0; i < NEXT_SHOWN && i < next.count; ++i) stamp.next[i] = next.idx[i];
+    }
+    stamp.score = db_getScore(state);
+    stamp.lines = db_getLines(state);
+    stamp.level = db_getLevel(state);
+    stamp.paused = db_isPaused(state);
+    stamp.over = db_isGameOver(state);
+    stamp.theme = &themeManager.getTheme();
+    stamp.scores = scores_ ? scores_->highScoreVersion() : (uint32_t)topCount_;
+    if (hasDrawn_ && stamp == drawn_) return;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    draw(state);
+    SDL_RenderPresent(renderer_);
+    lastMs_ = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    static const Metrics::Id mMarquee = Metrics::histogram("marquee_ms", {0.25, 0.5, 1, 2, 4, 8});
+    Metrics::observe(mMarquee, lastMs_);
+    drawn_ = stamp;
+    hasDrawn_ = true;
+    ++frames_;
+}
+
+void MarqueeDisplay::draw(const GameState& state) {
+    const Theme& th = themeManager.getTheme();
+    SDL_SetRenderDrawColor(renderer_, th.bg_r, th.bg_g, th.bg_b, 255);
+    SDL_RenderClear(renderer_);
+    drawBoard(state);
+    drawInfo(state);
+}
+
+void MarqueeDisplay::drawBoard(const GameState& state) {
+    const Theme& th = themeManager.getTheme();
+    BoardView view;
+    if (!board_ || !db_getBoardView(state, view)) return;
+    const int rows = std::min(rows_, view.rows), cols = std::min(cols_, view.cols);
+
+    // Um pixel por célula: o upload inteiro é COLS x ROWS x 4 bytes
+    const Uint32 empty = argb(th.board_empty_r, th.board_empty_g, th.board_empty_b);
+    std::fill(pixels_.begin(), pixels_.end(), empty);
+    for (int y = 0; y < rows; ++y) {
+        if (!view.rowMasks[y]) continue;
+        const Cell* row = view.row(y);
+        Uint32* out = &pixels_[(size_t)y * cols_];
+        for (int x = 0; x < cols; ++x) {
+            if (view.occupied(x, y)) out[x] = argb(row[x].r, row[x].g, row[x].b);
+        }
+    }
+    ActiveView active;
+    if (!db_isGameOver(state) && db_getActiveView(state, active)) {
+        const Uint32 color = argb(active.r, active.g, active.b);
+        for (int i = 0; i < active.count; ++i) {
+            const SDL_Point& p = active.cells[i];
+            if (p.x >= 0 && p.x < cols && p.y >= 0 && p.y < rows) pixels_[(size_t)p.y * cols_ + p.x] = color;
+        }
+    }
+    SDL_UpdateTexture(board_, nullptr, pixels_.data(), cols_ * (int)sizeof(Uint32));
+    SDL_RenderCopy(renderer_, board_, nullptr, &boardRect_);
+
+    SDL_SetRenderDrawColor(renderer_, th.panel_outline_r, th.panel_outline_g, th.panel_outline_b, 255);
+    SDL_Rect frame{boardRect_.x - 1, boardRect_.y - 1, boardRect_.w + 2, boardRect_.h + 2};
+    SDL_RenderDrawRect(renderer_, &frame);
+}
+
+void MarqueeDisplay::drawInfo(const GameState& state) {
+    const Theme& th = themeManager.getTheme();
+    const int s = textScale_;
+    const int line = 9 * s;
+    const int colB = infoRect_.x + infoRect_.w / 2;
+    char buf[32];
+
+    // Coluna A: placar e NEXT
+    int y = infoRect_.y;
+    drawPixelText(renderer_, infoRect_.x, y, "SCORE", s, th.hud_label_r, th.hud_label_g, th.hud_label_b);
+    y += line;
+    std::snprintf(buf, sizeof(buf), "%d", db_getScore(state));
+    drawPixelText(renderer_, infoRect_.x, y, buf, 2 * s, th.hud_score_r, th.hud_score_g, th.hud_score_b);
+    y += 2 * line;
+    std::snprintf(buf, sizeof(buf), "LINES %d", db_getLines(state));
+    drawPixelText(renderer_, infoRect_.x, y, buf, s, th.hud_lines_r, th.hud_lines_g, th.hud_lines_b);
+    y += line;
+    std::snprintf(buf, sizeof(buf), "LEVEL %d", db_getLevel(state));
+    drawPixelText(renderer_, infoRect_.x, y, buf, s, th.hud_level_r, th.hud_level_g, th.hud_level_b);
+    y += line + line / 2;
+    if (db_isGameOver(state) || db_isPaused(state)) {
+        drawPixelText(renderer_, infoRect_.x, y, db_isGameOver(state) ? "GAME OVER" : "PAUSED", s,
+                      th.overlay_top_r, th.overlay_top_g, th.overlay_top_b);
+        y += line + line / 2;
+    }
+
+    drawPixelText(renderer_, infoRect_.x, y, "NEXT", s, th.next_label_r, th.next_label_g, th.next_label_b);
+    y += line;
+    NextView next;
+    if (db_getNextView(state, next)) {
+        const int cell = 2 * s;
+        int x = infoRect_.x;
+        std::array<SDL_Rect, ActiveView::MAX_CELLS> rects;
+        for (int i = 0; i < NEXT_SHOWN && i < next.count; ++i) {
+            const int idx = next.idx[i];
+            if (idx < 0 || idx >= (int)PIECES.size()) continue;
+            const Piece& pc = PIECES[idx];
+            int minX = 0, minY = 0, maxX = 0;
+            bool first = true;
+            for (const auto& c : pc.rot[0]) {
+                if (first) { minX = maxX = c.first; minY = c.second; first = false; continue; }
+                minX = std::min(minX, c.first); maxX = std::max(maxX, c.first); minY = std::min(minY, c.second);
+            }
+            int n = 0;
+            for (const auto& c : pc.rot[0]) {
+                if (n == (int)rects.size()) break;
+                rects[n++] = SDL_Rect{x + (c.first - minX) * cell, y + (c.second - minY) * cell, cell - 1, cell - 1};
+            }
+            SDL_SetRenderDrawColor(renderer_, pc.r, pc.g, pc.b, 255);
+            SDL_RenderFillRects(renderer_, rects.data(), n);
+            x += (maxX - minX + 2) * cell;
+        }
+    }
+
+    // Coluna B: ranking
+    y = infoRect_.y;
+    drawPixelText(renderer_, colB, y, "TOP", s, th.stats_label_r, th.stats_label_g, th.stats_label_b);
+    y += line + line / 2;
+    HighScore ranked[TOP_COUNT];
+    const int count = scores_ ? scores_->highScores(ranked, TOP_COUNT) : topCount_;
+    for (int i = 0; i < count; ++i) {
+        std::snprintf(buf, sizeof(buf), "%d %d", i + 1, scores_ ? ranked[i].score : top_[i]);
+        drawPixelText(renderer_, colB, y, buf, s, th.stats_count_r, th.stats_count_g, th.stats_count_b);
+        y += line;
+    }
+}
+
+std::string MarqueeDisplay::statusLine() const {
+    char line[64];
+    std::snprintf(line, sizeof(line), "%d fps, %u frames, %.2f ms", fps_, frames_, lastMs_);
+    return line;
+}
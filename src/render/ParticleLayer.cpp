@@ -0,0 +1,197 @@
+#include "render/ParticleLayer.hpp"
+#include "render/GameStateBridge.hpp"
+#include "render/LayoutCache.hpp"
+#include "app/GameTypes.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__)
+#define DB_RESTRICT __restrict
+#define DB_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define DB_RESTRICT __restrict
+#define DB_NOINLINE __declspec(noinline)
+#else
+#define DB_RESTRICT
+#define DB_NOINLINE
+#endif
+
+// ParticlePool
+void ParticlePool::setCapacity(int capacity) {
+    capacity = std::max(0, capacity);
+    count_ = 0;
+    if (capacity == capacity_) return;
+    capacity_ = capacity;
+    // Arredondado para blocos inteiros: update() passa pelo último bloco todo
+    const int n = (capacity + BLOCK - 1) / BLOCK * BLOCK;
+    x_.reset(n ? new float[n]() : nullptr);
+    y_.reset(n ? new float[n]() : nullptr);
+    vx_.reset(n ? new float[n]() : nullptr);
+    vy_.reset(n ? new float[n]() : nullptr);
+    life_.reset(n ? new float[n]() : nullptr);
+    maxLife_.reset(n ? new float[n]() : nullptr);
+    r_.reset(n ? new Uint8[n]() : nullptr);
+    g_.reset(n ? new Uint8[n]() : nullptr);
+    b_.reset(n ? new Uint8[n]() : nullptr);
+}
+
+void ParticlePool::spawn(float x, float y, float vx, float vy, float lifeSec, Uint8 r, Uint8 g, Uint8 b) {
+    if (count_ >= capacity_) { dropped_++; return; }
+    const int i = count_++;
+    x_[i] = x; y_[i] = y; vx_[i] = vx; vy_[i] = vy;
+    life_[i] = maxLife_[i] = lifeSec;
+    r_[i] = r; g_[i] = g; b_[i] = b;
+}
+
+namespace {
+// Integração: só aritmética, em blocos de tamanho fixo, que o compilador
+// vetoriza já no -O2 (sem checagem de alias nem laço de resto). Nada de
+// comparação/select aqui: com -ftrapping-math (padrão) elas impedem a
+// vetorização. Quem sai de [0,w]x[0,h] perde a vida pela distância ao clamp
+// (min/max viram minps/maxps). Fora de linha: inlined no update() o GCC
+// perde o restrict dos parâmetros e volta ao laço escalar
+DB_NOINLINE void integrate(float* DB_RESTRICT x, float* DB_RESTRICT y, const float* DB_RESTRICT vx, float* DB_RESTRICT vy,
+               float* DB_RESTRICT life, int blocks, float dt, float dv, float w, float h) {
+    for (int bl = 0; bl < blocks; ++bl) {
+        const int o = bl * ParticlePool::BLOCK;
+        for (int k = 0; k < ParticlePool::BLOCK; ++k) {
+            const int i = o + k;
+            vy[i] += dv;
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+            const float outX = std::fabs(x[i] - std::min(std::max(x[i], 0.0f), w));
+            const float outY = std::fabs(y[i] - std::min(std::max(y[i], 0.0f), h));
+            life[i] -= dt + (outX + outY) * 1e6f;
+        }
+    }
+}
+} // namespace
+
+void ParticlePool::update(float dt, float gravity, float w, float h) {
+    const int n = count_;
+    // Os slots depois de count_ no último bloco são lixo inofensivo
+    integrate(x_.get(), y_.get(), vx_.get(), vy_.get(), life_.get(), (n + BLOCK - 1) / BLOCK, dt, gravity * dt, w, h);
+
+    float* x = x_.get();
+    float* y = y_.get();
+    float* vx = vx_.get();
+    float* vy = vy_.get();
+    float* life = life_.get();
+
+    // Compacta as vivas no começo, na mesma ordem (a sobreposição não pisca)
+    int out = 0;
+    for (int i = 0; i < n; ++i) {
+        if (life[i] <= 0.0f) continue;
+        if (out != i) {
+            x[out] = x[i]; y[out] = y[i]; vx[out] = vx[i]; vy[out] = vy[i];
+            life[out] = life[i]; maxLife_[out] = maxLife_[i];
+            r_[out] = r_[i]; g_[out] = g_[i]; b_[out] = b_[i];
+        }
+        out++;
+    }
+    count_ = out;
+}
+
+// ParticleLayer
+namespace {
+constexpr float GRAVITY = 20.0f;          // células/s²
+constexpr float MAX_STEP_SEC = 0.05f;     // Frame longo (arrasto da janela) não teleporta
+constexpr float CLEAR_PER_CELL = 3.0f;    // x PARTICLE_DENSITY
+constexpr float LOCK_PER_CELL = 1.0f;
+}
+
+float ParticleLayer::random01() {
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    return (float)(rng_ >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleLayer::spawnLock(const LockEvent& ev, int cols, int rows, float density) {
+    // Parte fracionária da densidade vira probabilidade: 0.5 = uma a cada duas células
+    auto emitCount = [&](float perCell) {
+        const float n = perCell * density;
+        const int k = (int)n;
+        return k + (random01() < n - (float)k ? 1 : 0);
+    };
+
+    // Linhas limpas: estouro claro ao longo da linha, para cima e para os lados
+    const Uint8 cr = (Uint8)((ev.r + 255) / 2), cg = (Uint8)((ev.g + 255) / 2), cb = (Uint8)((ev.b + 255) / 2);
+    for (Uint64 bits = ev.clearedRows; bits; bits &= bits - 1) {
+        const int y = __builtin_ctzll(bits);
+        if (y >= rows) break;
+        for (int x = 0; x < cols; ++x)
+            for (int k = emitCount(CLEAR_PER_CELL); k > 0; --k)
+                pool_.spawn((float)x + random01(), (float)y + random01(),
+                            (random01() - 0.5f) * 8.0f, -1.0f - random01() * 6.0f,
+                            0.45f + 0.45f * random01(), cr, cg, cb);
+    }
+
+    // Lock: faíscas curtas na borda de baixo de cada célula da peça
+    for (int i = 0; i < ev.cellCount; ++i) {
+        const int x = ev.cellX[i], y = ev.cellY[i];
+        if (x < 0 || x >= cols || y < 0 || y >= rows) continue;
+        for (int k = emitCount(LOCK_PER_CELL); k > 0; --k)
+            pool_.spawn((float)x + random01(), (float)y + 1.0f,
+                        (random01() - 0.5f) * 4.0f, -random01() * 3.0f,
+                        0.2f + 0.2f * random01(), ev.r, ev.g, ev.b);
+    }
+}
+
+void ParticleLayer::render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) {
+    const VisualEffectsView& vis = db_getVisualEffects();
+    if (vis.particleCapacity != pool_.capacity()) {
+        pool_.setCapacity(vis.particleCapacity);   // Hot reload/tema: o pool é refeito uma vez
+        batch_.reserve((size_t)pool_.capacity());
+    }
+
+    const Uint32 now = SDL_GetTicks();
+    float dt = seen_ ? (float)(now - lastMs_) / 1000.0f : 0.0f;
+    lastMs_ = now;
+    if (dt > MAX_STEP_SEC) dt = MAX_STEP_SEC;
+    if (db_isPaused(state)) dt = 0.0f;
+
+    const CellRectTable& grid = layout.boardCells;
+    int rows = 0, cols = 0;
+    db_getBoardSize(state, rows, cols);
+    rows = std::min(rows, grid.rows);
+    cols = std::min(cols, grid.cols);
+
+    const LockEvent& ev = db_getLockEvent(state);
+    if (!seen_) {
+        seen_ = true;   // O lock que já estava lá antes do primeiro frame não estoura
+    } else if (ev.seq != seenSeq_ && pool_.capacity() > 0 && rows > 0 && cols > 0) {
+        spawnLock(ev, cols, rows, vis.particleDensity);
+    }
+    seenSeq_ = ev.seq;
+
+    if (pool_.size() == 0 || rows <= 0 || cols <= 0) return;
+    pool_.update(dt, GRAVITY, (float)cols, (float)rows);
+    const int n = pool_.size();
+    if (n == 0) return;
+
+    // Células do layout -> pixels (o passo inclui o espaçamento da grade)
+    const SDL_Rect& c0 = grid.at(0, 0);
+    const float pitchX = cols > 1 ? (float)(grid.at(1, 0).x - c0.x) : (float)c0.w;
+    const float pitchY = rows > 1 ? (float)(grid.at(0, 1).y - c0.y) : (float)c0.h;
+    const float base = std::max(2.0f, std::min(pitchX, pitchY) * 0.25f);
+
+    const float* px = pool_.x();
+    const float* py = pool_.y();
+    const float* life = pool_.life();
+    const float* maxLife = pool_.maxLife();
+    for (int i = 0; i < n; ++i) {
+        const float t = life[i] / maxLife[i];
+        const int s = std::max(1, (int)(base * (0.35f + 0.65f * t)));
+        SDL_Rect rect{ c0.x + (int)(px[i] * pitchX) - s / 2, c0.y + (int)(py[i] * pitchY) - s / 2, s, s };
+        batch_.add(rect, pool_.r()[i], pool_.g()[i], pool_.b()[i], (Uint8)(255.0f * t));
+    }
+    batch_.flush(renderer);
+}
+
+bool ParticleLayer::isAnimated(const GameState& state) const {
+    return pool_.size() > 0 && !db_isPaused(state);
+}
+
+int ParticleLayer::getZOrder() const { return 4; }   // Acima do Board; mesmo Z do HUD (outro retângulo)
+std::string ParticleLayer::getName() const { return "Particles"; }
@@ -1,150 +1,449 @@
 // Implement full rendering primitives here (moved from dropblocks.cpp)
 #include "render/Primitives.hpp"
+#include "render/SoftRaster.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
+#include "DebugLogger.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cctype>
 
 extern int ROUNDED_PANELS; // global visual flag from config
+extern int TEXT_OUTLINES;  // QualityGovernor: 0 = só o preenchimento
 
-// 5x7 pixel font glyphs
-static bool glyph5x7(char c, int x, int y){
-    auto at=[&](const char* rows[7]){ return rows[y][x]=='#'; };
-    static const char* NUM[10][7] = {
-        {" ### ","#   #","#  ##","# # #","##  #","#   #"," ### "},
-        {"  #  "," ##  ","  #  ","  #  ","  #  ","  #  "," ### "},
-        {" ### ","#   #","    #","   # ","  #  "," #   ","#####"},
-        {" ### ","#   #","    #"," ### ","    #","#   #"," ### "},
-        {"   # ","  ## "," # # ","#  # ","#####","   # ","   # "},
-        {"#####","#    ","#    ","#### ","    #","#   #"," ### "},
-        {" ### ","#   #","#    ","#### ","#   #","#   #"," ### "},
-        {"#####","    #","   # ","  #  ","  #  ","  #  ","  #  "},
-        {" ### ","#   #","#   #"," ### ","#   #","#   #"," ### "},
-        {" ### ","#   #","#   #"," ####","    #","#   #"," ### "}
-    };
-    static const char* A_[7] = {
-        " ### ",
-        "#   #",
-        "#   #",
-        "#####",
-        "#   #",
-        "#   #",
-        "#   #"};
-    static const char* B_[7] = {
-        "#### ",
-        "#   #",
-        "#   #",
-        "#### ",
-        "#   #",
-        "#   #",
-        "#### "};
-    static const char* C_[7] = {" ### ","#   #","#    ","#    ","#    ","#   #"," ### "};
-    static const char* D_[7] = {"#### ","#   #","#   #","#   #","#   #","#   #","#### "};
-    static const char* E_[7] = {"#####","#    ","#    ","#### ","#    ","#    ","#####"};
-    static const char* F_[7] = {"#####","#    ","#    ","#### ","#    ","#    ","#    "};
-    static const char* G_[7] = {" ### ","#   #","#    ","# ###","#   #","#   #"," ### "};
-    static const char* H_[7] = {"#   #","#   #","#   #","#####","#   #","#   #","#   #"};
-    static const char* I_[7] = {"#####","  #  ","  #  ","  #  ","  #  ","  #  ","#####"};
-    static const char* J_[7] = {"  ###","   # ","   # ","   # ","#  # ","#  # "," ##  "};
-    static const char* K_[7] = {"#   #","#  # ","# #  ","##   ","# #  ","#  # ","#   #"};
-    static const char* L_[7] = {"#    ","#    ","#    ","#    ","#    ","#    ","#####"};
-    static const char* M_[7] = {"#   #","## ##","# # #","#   #","#   #","#   #","#   #"};
-    static const char* N_[7] = {"#   #","##  #","# # #","#  ##","#   #","#   #","#   #"};
-    static const char* O_[7] = {" ### ","#   #","#   #","#   #","#   #","#   #"," ### "};
-    static const char* P_[7] = {"#### ","#   #","#   #","#### ","#    ","#    ","#    "};
-    static const char* Q_[7] = {" ### ","#   #","#   #","#   #","# # #","#  # "," ## #"};
-    static const char* R_[7] = {"#### ","#   #","#   #","#### ","# #  ","#  # ","#   #"};
-    static const char* S_[7] = {" ####","#    ","#    "," ### ","    #","    #","#### "};
-    static const char* T_[7] = {"#####","  #  ","  #  ","  #  ","  #  ","  #  ","  #  "};
-    static const char* U_[7] = {"#   #","#   #","#   #","#   #","#   #","#   #"," ### "};
-    static const char* V_[7] = {"#   #","#   #","#   #","#   #","#   #"," # # ","  #  "};
-    static const char* W_[7] = {"#   #","#   #","#   #","# # #","# # #","## ##","#   #"};
-    static const char* X_[7] = {"#   #","#   #"," # # ","  #  "," # # ","#   #","#   #"};
-    static const char* Y_[7] = {"#   #","#   #"," # # ","  #  ","  #  ","  #  ","  #  "};
-    static const char* Z_[7] = {"#####","    #","   # ","  #  "," #   ","#    ","#####"};
-    static const char* dash[7] = {"     ","     ","     "," ### ","     ","     ","     "};
-    static const char* colon[7] = {"     ","  #  ","     ","     ","     ","  #  ","     "};
-    static const char* dot[7] = {"     ","     ","     ","     ","     "," ##  "," ##  "};
-    if(c>='0'&&c<='9') return NUM[c-'0'][y][x]=='#';
-    c=(char)std::toupper((unsigned char)c);
-#define GL(CH,ARR) if(c==CH) return at(ARR);
-    GL('A',A_) GL('B',B_) GL('C',C_) GL('D',D_) GL('E',E_) GL('F',F_) GL('G',G_)
-    GL('H',H_) GL('I',I_) GL('J',J_) GL('K',K_) GL('L',L_) GL('M',M_) GL('N',N_)
-    GL('O',O_) GL('P',P_) GL('Q',Q_) GL('R',R_) GL('S',S_) GL('T',T_) GL('U',U_)
-    GL('V',V_) GL('W',W_) GL('X',X_) GL('Y',Y_) GL('Z',Z_) GL('-',dash) GL(':',colon) GL('.',dot)
-#undef GL
-    return false;
+// 5x7 pixel font: one byte per row, bit 4 = leftmost column
+namespace {
+struct Glyph5x7 { char ch; Uint8 rows[7]; };
+
+constexpr Glyph5x7 FONT5x7[] = {
+    {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+    {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+    {'3', {0x0E, 0x11, 0x01, 0x0E, 0x01, 0x11, 0x0E}},
+    {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+    {'5', {0x1F, 0x10, 0x10, 0x1E, 0x01, 0x11, 0x0E}},
+    {'6', {0x0E, 0x11, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+    {'7', {0x1F, 0x01, 0x02, 0x04, 0x04, 0x04, 0x04}},
+    {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+    {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x11, 0x0E}},
+    {'A', {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},
+    {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+    {'D', {0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E}},
+    {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+    {'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},
+    {'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0E}},
+    {'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'I', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x1F}},
+    {'J', {0x07, 0x02, 0x02, 0x02, 0x12, 0x12, 0x0C}},
+    {'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},
+    {'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},
+    {'M', {0x11, 0x1B, 0x15, 0x11, 0x11, 0x11, 0x11}},
+    {'N', {0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x11}},
+    {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},
+    {'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},
+    {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+    {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+    {'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+    {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},
+    {'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x1B, 0x11}},
+    {'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},
+    {'Y', {0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04}},
+    {'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},
+    {'-', {0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00}},
+    {':', {0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00}},
+    {'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},
+};
+constexpr int GLYPH_COUNT = (int)(sizeof(FONT5x7) / sizeof(FONT5x7[0]));
+
+struct GlyphIndex {
+    signed char idx[128];
+    constexpr GlyphIndex() : idx() {
+        for (int i = 0; i < 128; i++) idx[i] = -1;
+        for (int g = 0; g < GLYPH_COUNT; g++) {
+            int c = (unsigned char)FONT5x7[g].ch;
+            idx[c] = (signed char)g;
+            if (c >= 'A' && c <= 'Z') idx[c - 'A' + 'a'] = (signed char)g;
+        }
+    }
+};
+constexpr GlyphIndex GLYPH_INDEX{};
+
+inline int glyphIndex(char c) {
+    unsigned char u = (unsigned char)c;
+    return u < 128 ? GLYPH_INDEX.idx[u] : -1;
 }
 
-void drawPixelText(SDL_Renderer* ren, int x, int y, const std::string& s, int scale, Uint8 r, Uint8 g, Uint8 b){
-    SDL_Rect px; SDL_SetRenderDrawColor(ren, r,g,b,255);
-    int cx=x;
-    for(char c : s){
-        if(c=='\n'){ y += (7*scale + scale*2); cx=x; continue; }
-        for(int yy=0; yy<7; ++yy) for(int xx=0; xx<5; ++xx)
-            if(glyph5x7(c,xx,yy)){ px = { cx + xx*scale, y + yy*scale, scale, scale }; SDL_RenderFillRect(ren, &px); }
-        cx += 6*scale;
+// Atlas branco (uma linha de glifos) rasterizado para um par de escalas;
+// a cor vem de SDL_SetTextureColorMod. O layout de pixels é o mesmo do
+// desenho por rects (offset (int)(xx*scale), tamanho (int)scale).
+struct GlyphAtlas {
+    SDL_Renderer* ren = nullptr;
+    float sx = 0.f, sy = 0.f;
+    SDL_Texture* tex = nullptr;
+    int cellW = 0, cellH = 0;
+    Uint32 lastUse = 0;
+    Uint32 frame = 0;    // TexturePool::frame() do último uso
+};
+
+constexpr size_t MAX_GLYPH_ATLASES = 8;
+std::vector<GlyphAtlas> g_atlases;
+Uint32 g_atlasClock = 0;
+Uint32 g_atlasEpoch = 0;   // TexturePool::deviceEpoch() dos atlas
+SDL_Renderer* g_atlasFailedFor = nullptr;
+
+// TEXTURE_BUDGET_MB: o atlas de uma escala que saiu de uso é refeito se ela voltar
+struct GlyphAtlasEvictor : TextureEvictor {
+    Uint32 oldestTextureUse() const override {
+        Uint32 oldest = UINT32_MAX;
+        for (const auto& a : g_atlases) oldest = std::min(oldest, a.frame);
+        return oldest;
+    }
+    void evictOldestTexture() override {
+        if (g_atlases.empty()) return;
+        auto oldest = std::min_element(g_atlases.begin(), g_atlases.end(),
+            [](const GlyphAtlas& l, const GlyphAtlas& r) { return l.frame < r.frame; });
+        renderTargetPool().release(oldest->tex);
+        *oldest = g_atlases.back();
+        g_atlases.pop_back();
     }
+};
+GlyphAtlasEvictor g_atlasEvictor;
+
+SDL_Texture* buildAtlasTexture(SDL_Renderer* ren, float sx, float sy, int cellW, int cellH) {
+    const int pw = (int)sx, ph = (int)sy;
+    const int texW = cellW * GLYPH_COUNT, texH = cellH;
+    SDL_Texture* tex = renderTargetPool().create(ren, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, texW, texH, TextureUse::GLYPHS);
+    if (!tex) return nullptr;
+    std::vector<Uint32> pixels((size_t)texW * texH, 0u);
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        for (int yy = 0; yy < 7; yy++) {
+            Uint8 bits = FONT5x7[g].rows[yy];
+            for (int xx = 0; xx < 5; xx++) {
+                if (!(bits & (0x10 >> xx))) continue;
+                int ox = g * cellW + (int)(xx * sx), oy = (int)(yy * sy);
+                for (int py = 0; py < ph; py++)
+                    std::fill_n(&pixels[(size_t)(oy + py) * texW + ox], pw, 0xFFFFFFFFu);
+            }
+        }
+    }
+    SDL_UpdateTexture(tex, nullptr, pixels.data(), texW * (int)sizeof(Uint32));
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
 }
 
-int textWidthPx(const std::string& s, int scale){
-    if(s.empty()) return 0; return (int)s.size() * 6 * scale - scale;
+const GlyphAtlas* getGlyphAtlas(SDL_Renderer* ren, float sx, float sy) {
+    TexturePool& pool = renderTargetPool();
+    // Device perdido: os atlas são refeitos conforme o texto volta a aparecer
+    if (g_atlasEpoch != pool.deviceEpoch()) {
+        releaseGlyphAtlases();
+        g_atlasEpoch = pool.deviceEpoch();
+    }
+    ++g_atlasClock;
+    for (auto& a : g_atlases) {
+        if (a.ren == ren && a.sx == sx && a.sy == sy) { a.lastUse = g_atlasClock; a.frame = pool.frame(); return &a; }
+    }
+    if (g_atlasFailedFor == ren) return nullptr;
+    
+    GlyphAtlas a;
+    a.ren = ren; a.sx = sx; a.sy = sy;
+    a.cellW = (int)(4 * sx) + (int)sx;
+    a.cellH = (int)(6 * sy) + (int)sy;
+    a.tex = buildAtlasTexture(ren, sx, sy, a.cellW, a.cellH);
+    if (!a.tex) {
+        // Sem textura (renderer limitado): fica no caminho por rects
+        g_atlasFailedFor = ren;
+        DebugLogger::warning("Glyph atlas indisponivel, texto por rects: " + std::string(SDL_GetError()));
+        return nullptr;
+    }
+    a.lastUse = g_atlasClock;
+    a.frame = pool.frame();
+    pool.addEvictor(&g_atlasEvictor);
+    if (g_atlases.size() >= MAX_GLYPH_ATLASES) {
+        auto oldest = std::min_element(g_atlases.begin(), g_atlases.end(),
+            [](const GlyphAtlas& l, const GlyphAtlas& r) { return l.lastUse < r.lastUse; });
+        pool.release(oldest->tex);
+        *oldest = a;
+        return &*oldest;
+    }
+    g_atlases.push_back(a);
+    return &g_atlases.back();
 }
 
-void drawPixelTextOutlined(SDL_Renderer* ren, int x, int y, const std::string& s, int scale,
-                           Uint8 fr, Uint8 fg, Uint8 fb, Uint8 or_, Uint8 og, Uint8 ob){
-    const int d = std::max(1, scale/2);
-    drawPixelText(ren, x-d, y,   s, scale, or_,og,ob);
-    drawPixelText(ren, x+d, y,   s, scale, or_,og,ob);
-    drawPixelText(ren, x,   y-d, s, scale, or_,og,ob);
-    drawPixelText(ren, x,   y+d, s, scale, or_,og,ob);
-    drawPixelText(ren, x-d, y-d, s, scale, or_,og,ob);
-    drawPixelText(ren, x+d, y-d, s, scale, or_,og,ob);
-    drawPixelText(ren, x-d, y+d, s, scale, or_,og,ob);
-    drawPixelText(ren, x+d, y+d, s, scale, or_,og,ob);
-    drawPixelText(ren, x,   y,   s, scale, fr,fg,fb);
+void drawTextRects(SDL_Renderer* ren, int x, int y, std::string_view s, float sx, float sy) {
+    SDL_Rect px;
+    int cx = x;
+    for (char c : s) {
+        if (c == '\n') { y += (int)(7*sy + sy*2); cx = x; continue; }
+        int g = glyphIndex(c);
+        if (g >= 0) {
+            for (int yy = 0; yy < 7; ++yy) {
+                Uint8 bits = FONT5x7[g].rows[yy];
+                for (int xx = 0; xx < 5; ++xx) {
+                    if (!(bits & (0x10 >> xx))) continue;
+                    px = { cx + (int)(xx*sx), y + (int)(yy*sy), (int)sx, (int)sy };
+                    DrawCalls::fillRect(ren, &px);
+                }
+            }
+        }
+        cx += (int)(6*sx);
+    }
 }
 
-// New versions with separate scaleX/scaleY (for STRETCH mode)
-void drawPixelText(SDL_Renderer* ren, int x, int y, const std::string& s, float scaleX, float scaleY, Uint8 r, Uint8 g, Uint8 b){
-    SDL_Rect px; SDL_SetRenderDrawColor(ren, r,g,b,255);
-    int cx=x;
-    for(char c : s){
-        if(c=='\n'){ y += (int)(7*scaleY + scaleY*2); cx=x; continue; }
-        for(int yy=0; yy<7; ++yy) {
-            for(int xx=0; xx<5; ++xx) {
-                if(glyph5x7(c,xx,yy)){
-                    px = { cx + (int)(xx*scaleX), y + (int)(yy*scaleY), (int)scaleX, (int)scaleY };
-                    SDL_RenderFillRect(ren, &px);
+void drawTextAtlas(SDL_Renderer* ren, const GlyphAtlas& a, int x, int y, std::string_view s) {
+    SDL_Rect src{0, 0, a.cellW, a.cellH};
+    SDL_Rect dst{0, 0, a.cellW, a.cellH};
+    int cx = x;
+    for (char c : s) {
+        if (c == '\n') { y += (int)(7*a.sy + a.sy*2); cx = x; continue; }
+        int g = glyphIndex(c);
+        if (g >= 0) {
+            src.x = g * a.cellW;
+            dst.x = cx; dst.y = y;
+            DrawCalls::copy(ren, a.tex, &src, &dst);
+        }
+        cx += (int)(6*a.sx);
+    }
+}
+
+// Frame de software: cada pixel do glifo vira um fillRect direto (mesmo layout do atlas)
+void drawTextDirect(const SoftRaster::Target& t, int x, int y, std::string_view s, float sx, float sy,
+                    Uint8 r, Uint8 g, Uint8 b) {
+    int cx = x;
+    for (char c : s) {
+        if (c == '\n') { y += (int)(7*sy + sy*2); cx = x; continue; }
+        int gi = glyphIndex(c);
+        if (gi >= 0) {
+            for (int yy = 0; yy < 7; ++yy) {
+                Uint8 bits = FONT5x7[gi].rows[yy];
+                for (int xx = 0; xx < 5; ++xx) {
+                    if (!(bits & (0x10 >> xx))) continue;
+                    SoftRaster::fillRect(t, cx + (int)(xx*sx), y + (int)(yy*sy), (int)sx, (int)sy, r, g, b, 255);
                 }
             }
         }
-        cx += (int)(6*scaleX);
+        cx += (int)(6*sx);
+    }
+}
+
+// Desenha o mesmo texto em vários offsets com uma cor (outline = 8 offsets + 1)
+void drawTextPasses(SDL_Renderer* ren, std::string_view s, float sx, float sy,
+                    const int (*offs)[2], int count, int x, int y, Uint8 r, Uint8 g, Uint8 b) {
+    if ((int)sx <= 0 || (int)sy <= 0 || s.empty()) return;
+    SoftRaster::Target direct;
+    if (SoftRaster::beginDirect(ren, direct)) {
+        for (int i = 0; i < count; i++) drawTextDirect(direct, x + offs[i][0], y + offs[i][1], s, sx, sy, r, g, b);
+        return;
+    }
+    if (const GlyphAtlas* a = getGlyphAtlas(ren, sx, sy)) {
+        SDL_SetTextureColorMod(a->tex, r, g, b);
+        for (int i = 0; i < count; i++) drawTextAtlas(ren, *a, x + offs[i][0], y + offs[i][1], s);
+        return;
+    }
+    SDL_SetRenderDrawColor(ren, r, g, b, 255);
+    for (int i = 0; i < count; i++) drawTextRects(ren, x + offs[i][0], y + offs[i][1], s, sx, sy);
+}
+
+void drawOutlined(SDL_Renderer* ren, int x, int y, std::string_view s, float sx, float sy, int dx, int dy,
+                  Uint8 fr, Uint8 fg, Uint8 fb, Uint8 or_, Uint8 og, Uint8 ob) {
+    const int ring[8][2] = { {-dx,0}, {dx,0}, {0,-dy}, {0,dy}, {-dx,-dy}, {dx,-dy}, {-dx,dy}, {dx,dy} };
+    const int center[1][2] = { {0,0} };
+    if (TEXT_OUTLINES) drawTextPasses(ren, s, sx, sy, ring, 8, x, y, or_, og, ob);
+    drawTextPasses(ren, s, sx, sy, center, 1, x, y, fr, fg, fb);
+}
+} // namespace
+
+void releaseGlyphAtlases(){
+    for (auto& a : g_atlases) renderTargetPool().release(a.tex);
+    g_atlases.clear();
+    g_atlasFailedFor = nullptr;
+}
+
+void releaseGlyphAtlases(SDL_Renderer* renderer){
+    size_t kept = 0;
+    for (auto& a : g_atlases) {
+        if (a.ren == renderer) renderTargetPool().release(a.tex);
+        else g_atlases[kept++] = a;
     }
+    g_atlases.resize(kept);
+    if (g_atlasFailedFor == renderer) g_atlasFailedFor = nullptr;
+}
+
+void drawPixelText(SDL_Renderer* ren, int x, int y, std::string_view s, int scale, Uint8 r, Uint8 g, Uint8 b){
+    const int origin[1][2] = { {0,0} };
+    drawTextPasses(ren, s, (float)scale, (float)scale, origin, 1, x, y, r, g, b);
+}
+
+int textWidthPx(std::string_view s, int scale){
+    if(s.empty()) return 0; return (int)s.size() * 6 * scale - scale;
+}
+
+void drawPixelTextOutlined(SDL_Renderer* ren, int x, int y, std::string_view s, int scale,
+                           Uint8 fr, Uint8 fg, Uint8 fb, Uint8 or_, Uint8 og, Uint8 ob){
+    const int d = std::max(1, scale/2);
+    drawOutlined(ren, x, y, s, (float)scale, (float)scale, d, d, fr, fg, fb, or_, og, ob);
+}
+
+// New versions with separate scaleX/scaleY (for STRETCH mode)
+void drawPixelText(SDL_Renderer* ren, int x, int y, std::string_view s, float scaleX, float scaleY, Uint8 r, Uint8 g, Uint8 b){
+    const int origin[1][2] = { {0,0} };
+    drawTextPasses(ren, s, scaleX, scaleY, origin, 1, x, y, r, g, b);
 }
 
-int textWidthPx(const std::string& s, float scaleX){
+int textWidthPx(std::string_view s, float scaleX){
     if(s.empty()) return 0; 
     return (int)(s.size() * 6 * scaleX - scaleX);
 }
 
-void drawPixelTextOutlined(SDL_Renderer* ren, int x, int y, const std::string& s, float scaleX, float scaleY,
+void drawPixelTextOutlined(SDL_Renderer* ren, int x, int y, std::string_view s, float scaleX, float scaleY,
                            Uint8 fr, Uint8 fg, Uint8 fb, Uint8 or_, Uint8 og, Uint8 ob){
     const int dx = std::max(1, (int)(scaleX/2));
     const int dy = std::max(1, (int)(scaleY/2));
-    drawPixelText(ren, x-dx, y,    s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x+dx, y,    s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x,    y-dy, s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x,    y+dy, s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x-dx, y-dy, s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x+dx, y-dy, s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x-dx, y+dy, s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x+dx, y+dy, s, scaleX, scaleY, or_,og,ob);
-    drawPixelText(ren, x,    y,    s, scaleX, scaleY, fr,fg,fb);
+    drawOutlined(ren, x, y, s, scaleX, scaleY, dx, dy, fr, fg, fb, or_, og, ob);
 }
 
+// Rounded panel meshes for SDL_RenderGeometry, cached by shape (w, h, radX, radY, thickness).
+// thickness 0 = filled (fan from the center); > 0 = ring between outer and inset contour.
+namespace {
+struct PanelMeshKey {
+    int w, h, radX, radY, thick;
+    bool operator==(const PanelMeshKey& o) const {
+        return w == o.w && h == o.h && radX == o.radX && radY == o.radY && thick == o.thick;
+    }
+};
+
+struct PanelMesh {
+    PanelMeshKey key;
+    std::vector<SDL_FPoint> points;   // local coords (panel origin at 0,0)
+    std::vector<int> indices;
+    Uint32 lastUse = 0;
+};
+
+constexpr size_t MAX_PANEL_MESHES = 32;
+std::vector<PanelMesh> g_panelMeshes;
+std::vector<SDL_Vertex> g_panelVerts;   // scratch, reused between calls
+Uint32 g_panelMeshClock = 0;
+bool g_geometryFailed = false;
+
+int cornerSegments(int radX, int radY) {
+    return std::max(1, std::min(24, std::max(radX, radY) / 2));
+}
+
+// Contour of a rounded rect, clockwise from the top-left corner; same point
+// count for any radii so outer/inner contours pair up index by index
+void appendContour(std::vector<SDL_FPoint>& out, float x0, float y0, float w, float h,
+                   float rx, float ry, int seg) {
+    const float cx[4] = { x0 + rx, x0 + w - rx, x0 + w - rx, x0 + rx };
+    const float cy[4] = { y0 + ry, y0 + ry, y0 + h - ry, y0 + h - ry };
+    const double kHalfPi = 1.57079632679489661923;
+    for (int c = 0; c < 4; c++) {
+        double a0 = kHalfPi * (c + 2);   // TL starts at 180 degrees
+        for (int k = 0; k <= seg; k++) {
+            double a = a0 + kHalfPi * k / seg;
+            out.push_back({ cx[c] + (float)(std::cos(a) * rx), cy[c] + (float)(std::sin(a) * ry) });
+        }
+    }
+}
+
+void buildPanelMesh(PanelMesh& m) {
+    const PanelMeshKey& k = m.key;
+    m.points.clear();
+    m.indices.clear();
+    const int seg = cornerSegments(k.radX, k.radY);
+    appendContour(m.points, 0.f, 0.f, (float)k.w, (float)k.h, (float)k.radX, (float)k.radY, seg);
+    const int n = (int)m.points.size();
+    
+    const int iw = k.w - 2 * k.thick, ih = k.h - 2 * k.thick;
+    if (k.thick <= 0 || iw <= 0 || ih <= 0) {
+        // Filled (or a border so thick it covers everything)
+        m.points.push_back({ k.w * 0.5f, k.h * 0.5f });
+        for (int i = 0; i < n; i++) {
+            m.indices.push_back(n);
+            m.indices.push_back(i);
+            m.indices.push_back((i + 1) % n);
+        }
+        return;
+    }
+    
+    const int irx = std::max(0, std::min(k.radX - k.thick, iw / 2));
+    const int iry = std::max(0, std::min(k.radY - k.thick, ih / 2));
+    appendContour(m.points, (float)k.thick, (float)k.thick, (float)iw, (float)ih, (float)irx, (float)iry, seg);
+    for (int i = 0; i < n; i++) {
+        int j = (i + 1) % n;
+        m.indices.push_back(i);     m.indices.push_back(j);     m.indices.push_back(n + i);
+        m.indices.push_back(n + i); m.indices.push_back(j);     m.indices.push_back(n + j);
+    }
+}
+
+const PanelMesh& getPanelMesh(const PanelMeshKey& key) {
+    ++g_panelMeshClock;
+    for (auto& m : g_panelMeshes) {
+        if (m.key == key) { m.lastUse = g_panelMeshClock; return m; }
+    }
+    PanelMesh* slot;
+    if (g_panelMeshes.size() < MAX_PANEL_MESHES) {
+        g_panelMeshes.emplace_back();
+        slot = &g_panelMeshes.back();
+    } else {
+        slot = &*std::min_element(g_panelMeshes.begin(), g_panelMeshes.end(),
+            [](const PanelMesh& a, const PanelMesh& b) { return a.lastUse < b.lastUse; });
+    }
+    slot->key = key;
+    slot->lastUse = g_panelMeshClock;
+    buildPanelMesh(*slot);
+    return *slot;
+}
+
+// One SDL_RenderGeometry call per panel; false = caller uses the scanline path
+bool drawPanelMesh(SDL_Renderer* r, int x, int y, int w, int h, int radX, int radY, int thick,
+                   Uint8 R, Uint8 G, Uint8 B, Uint8 A) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (g_geometryFailed) return false;
+    if (w <= 0 || h <= 0) return true;
+    if (!ROUNDED_PANELS) radX = radY = 0;
+    PanelMeshKey key{ w, h, std::max(0, std::min(radX, w/2)), std::max(0, std::min(radY, h/2)), std::max(0, thick) };
+    const PanelMesh& m = getPanelMesh(key);
+    
+    g_panelVerts.resize(m.points.size());
+    const SDL_Color col{ R, G, B, A };
+    for (size_t i = 0; i < m.points.size(); i++) {
+        g_panelVerts[i].position = { m.points[i].x + x, m.points[i].y + y };
+        g_panelVerts[i].color = col;
+        g_panelVerts[i].tex_coord = { 0.f, 0.f };
+    }
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    if (DrawCalls::geometry(r, nullptr, g_panelVerts.data(), (int)g_panelVerts.size(),
+                           m.indices.data(), (int)m.indices.size()) != 0) {
+        g_geometryFailed = true;
+        DebugLogger::warning("SDL_RenderGeometry indisponivel, paineis por scanlines: " + std::string(SDL_GetError()));
+        return false;
+    }
+    return true;
+#else
+    (void)r; (void)x; (void)y; (void)w; (void)h; (void)radX; (void)radY; (void)thick;
+    (void)R; (void)G; (void)B; (void)A;
+    return false;
+#endif
+}
+
+// Frame de software: o painel sai direto nos pixels; false = segue pelo SDL
+bool drawPanelDirect(SDL_Renderer* r, int x, int y, int w, int h, int radX, int radY, int thick,
+                     Uint8 R, Uint8 G, Uint8 B, Uint8 A) {
+    SoftRaster::Target t;
+    if (!SoftRaster::beginDirect(r, t)) return false;
+    if (!ROUNDED_PANELS) radX = radY = 0;
+    SoftRaster::fillRounded(t, x, y, w, h, radX, radY, thick, R, G, B, A);
+    return true;
+}
+} // namespace
+
 void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int rad, Uint8 R, Uint8 G, Uint8 B, Uint8 A){
-    if(!ROUNDED_PANELS){ SDL_SetRenderDrawColor(r, R,G,B,A); SDL_Rect rr{ x,y,w,h }; SDL_RenderFillRect(r,&rr); return; }
+    if (drawPanelDirect(r, x, y, w, h, rad, rad, 0, R, G, B, A)) return;
+    if(!ROUNDED_PANELS){ SDL_SetRenderDrawColor(r, R,G,B,A); SDL_Rect rr{ x,y,w,h }; DrawCalls::fillRect(r,&rr); return; }
     rad = std::max(0, std::min(rad, std::min(w,h)/2));
+    if (drawPanelMesh(r, x, y, w, h, rad, rad, 0, R, G, B, A)) return;
     SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(r, R,G,B,A);
     
@@ -153,7 +452,7 @@ void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int rad, Uin
     
     // 1. Draw the middle rectangle (full width, excluding corners)
     SDL_Rect middleRect = {x, y + rad, w, h - 2*rad};
-    SDL_RenderFillRect(r, &middleRect);
+    DrawCalls::fillRect(r, &middleRect);
     
     // 2. Draw top and bottom lines with rounded corners (line-by-line)
     int rad2 = rad * rad;
@@ -167,7 +466,7 @@ void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int rad, Uin
         
         if (line_width_top > 0) {
             SDL_Rect topLine = {left_x_top, y + yy, line_width_top, 1};
-            SDL_RenderFillRect(r, &topLine);
+            DrawCalls::fillRect(r, &topLine);
         }
         
         // BOTTOM: Mirror the calculation (yy=0 at bottom is widest, yy=rad-1 is narrowest)
@@ -178,7 +477,7 @@ void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int rad, Uin
         
         if (line_width_bottom > 0) {
             SDL_Rect bottomLine = {left_x_bottom, y + h - rad + yy, line_width_bottom, 1};
-            SDL_RenderFillRect(r, &bottomLine);
+            DrawCalls::fillRect(r, &bottomLine);
         }
     }
 }
@@ -186,6 +485,8 @@ void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int rad, Uin
 void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int rad, int thick, Uint8 R, Uint8 G, Uint8 B, Uint8 A){
     // Draw efficient outline by drawing outer filled rect minus inner filled rect
     if (thick <= 0) return;
+    if (drawPanelDirect(r, x, y, w, h, rad, rad, thick, R, G, B, A)) return;
+    if (drawPanelMesh(r, x, y, w, h, rad, rad, thick, R, G, B, A)) return;
     
     SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(r, R, G, B, A);
@@ -204,25 +505,25 @@ void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int rad, in
         // Top edge
         if (outer_h > 0) {
             SDL_Rect top = {outer_x + outer_rad, outer_y, outer_w - 2*outer_rad, 1};
-            if (top.w > 0) SDL_RenderFillRect(r, &top);
+            if (top.w > 0) DrawCalls::fillRect(r, &top);
         }
         
         // Bottom edge  
         if (outer_h > 1) {
             SDL_Rect bottom = {outer_x + outer_rad, outer_y + outer_h - 1, outer_w - 2*outer_rad, 1};
-            if (bottom.w > 0) SDL_RenderFillRect(r, &bottom);
+            if (bottom.w > 0) DrawCalls::fillRect(r, &bottom);
         }
         
         // Left edge
         if (outer_w > 0 && outer_h > 2) {
             SDL_Rect left = {outer_x, outer_y + outer_rad, 1, outer_h - 2*outer_rad};
-            if (left.h > 0) SDL_RenderFillRect(r, &left);
+            if (left.h > 0) DrawCalls::fillRect(r, &left);
         }
         
         // Right edge
         if (outer_w > 1 && outer_h > 2) {
             SDL_Rect right = {outer_x + outer_w - 1, outer_y + outer_rad, 1, outer_h - 2*outer_rad};
-            if (right.h > 0) SDL_RenderFillRect(r, &right);
+            if (right.h > 0) DrawCalls::fillRect(r, &right);
         }
         
         // Draw rounded corners (simplified - just corner pixels for now)
@@ -236,7 +537,7 @@ void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int rad, in
                 {outer_x + outer_w - outer_rad, outer_y + outer_h - outer_rad, outer_rad, outer_rad} // bottom-right
             };
             for (int c = 0; c < 4; c++) {
-                SDL_RenderFillRect(r, &corners[c]);
+                DrawCalls::fillRect(r, &corners[c]);
             }
         }
     }
@@ -244,9 +545,11 @@ void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int rad, in
 
 // New versions with elliptical corners (for STRETCH mode)
 void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int radX, int radY, Uint8 R, Uint8 G, Uint8 B, Uint8 A){
-    if(!ROUNDED_PANELS){ SDL_SetRenderDrawColor(r, R,G,B,A); SDL_Rect rr{ x,y,w,h }; SDL_RenderFillRect(r,&rr); return; }
+    if (drawPanelDirect(r, x, y, w, h, radX, radY, 0, R, G, B, A)) return;
+    if(!ROUNDED_PANELS){ SDL_SetRenderDrawColor(r, R,G,B,A); SDL_Rect rr{ x,y,w,h }; DrawCalls::fillRect(r,&rr); return; }
     radX = std::max(0, std::min(radX, w/2));
     radY = std::max(0, std::min(radY, h/2));
+    if (drawPanelMesh(r, x, y, w, h, radX, radY, 0, R, G, B, A)) return;
     SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(r, R,G,B,A);
     
@@ -255,7 +558,7 @@ void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int radX, in
     
     // 1. Draw the middle rectangle (full width, excluding corners)
     SDL_Rect middleRect = {x, y + radY, w, h - 2*radY};
-    SDL_RenderFillRect(r, &middleRect);
+    DrawCalls::fillRect(r, &middleRect);
     
     // 2. Draw top and bottom lines with elliptical corners (line-by-line)
     for (int yy = 0; yy < radY; ++yy){
@@ -269,7 +572,7 @@ void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int radX, in
         
         if (line_width_top > 0) {
             SDL_Rect topLine = {left_x_top, y + yy, line_width_top, 1};
-            SDL_RenderFillRect(r, &topLine);
+            DrawCalls::fillRect(r, &topLine);
         }
         
         // BOTTOM: Mirror the calculation
@@ -281,14 +584,129 @@ void drawRoundedFilled(SDL_Renderer* r, int x, int y, int w, int h, int radX, in
         
         if (line_width_bottom > 0) {
             SDL_Rect bottomLine = {left_x_bottom, y + h - radY + yy, line_width_bottom, 1};
-            SDL_RenderFillRect(r, &bottomLine);
+            DrawCalls::fillRect(r, &bottomLine);
         }
     }
 }
 
 void drawRoundedOutline(SDL_Renderer* r, int x, int y, int w, int h, int radX, int radY, int thick, Uint8 R, Uint8 G, Uint8 B, Uint8 A){
+    if (thick <= 0) return;
+    if (drawPanelDirect(r, x, y, w, h, radX, radY, thick, R, G, B, A)) return;
+    if (drawPanelMesh(r, x, y, w, h, radX, radY, thick, R, G, B, A)) return;
     for(int i=0;i<thick;i++){
         drawRoundedFilled(r, x+i, y+i, w-2*i, h-2*i, std::max(0,radX-i), std::max(0,radY-i), R,G,B,A);
     }
 }
 
+
+void RectBatch::add(const SDL_Rect& rect, Uint8 R, Uint8 G, Uint8 B, Uint8 A){
+    if (rect.w <= 0 || rect.h <= 0) return;
+    Uint32 key = ((Uint32)R << 24) | ((Uint32)G << 16) | ((Uint32)B << 8) | A;
+    // Poucas cores por layer: busca linear, começando pela última usada
+    for (size_t i = used_; i-- > 0; ) {
+        if (buckets_[i].rgba == key) { buckets_[i].rects.push_back(rect); return; }
+    }
+    if (used_ == buckets_.size()) buckets_.emplace_back();
+    Bucket& b = buckets_[used_++];
+    b.rgba = key;
+    b.rects.clear();
+    b.rects.push_back(rect);
+}
+
+void RectBatch::flush(SDL_Renderer* r){
+    SoftRaster::Target direct;
+    if (used_ > 0 && SoftRaster::beginDirect(r, direct)) {
+        for (size_t i = 0; i < used_; i++) {
+            const Bucket& b = buckets_[i];
+            for (const SDL_Rect& rr : b.rects)
+                SoftRaster::fillRect(direct, rr.x, rr.y, rr.w, rr.h, (Uint8)(b.rgba >> 24), (Uint8)(b.rgba >> 16), (Uint8)(b.rgba >> 8), (Uint8)b.rgba);
+        }
+        clear();
+        return;
+    }
+    for (size_t i = 0; i < used_; i++) {
+        const Bucket& b = buckets_[i];
+        if (b.rects.empty()) continue;
+        SDL_SetRenderDrawColor(r, (Uint8)(b.rgba >> 24), (Uint8)(b.rgba >> 16), (Uint8)(b.rgba >> 8), (Uint8)b.rgba);
+        DrawCalls::fillRects(r, b.rects.data(), (int)b.rects.size());
+    }
+    clear();
+}
+
+void RectBatch::clear(){
+    for (size_t i = 0; i < used_; i++) buckets_[i].rects.clear();
+    used_ = 0;
+}
+
+namespace {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+bool g_quadGeometryFailed = false;
+#else
+bool g_quadGeometryFailed = true;   // Sem SDL_RenderGeometry no SDL do build
+#endif
+} // namespace
+
+bool QuadBatch::preservesOrder(){ return !g_quadGeometryFailed; }
+
+void QuadBatch::reserve(size_t quads){
+    verts_.reserve(quads * 4);
+    indices_.reserve(quads * 6);
+}
+
+void QuadBatch::add(const SDL_Rect& rect, Uint8 R, Uint8 G, Uint8 B, Uint8 A){
+    add(rect, SDL_FRect{ 0.f, 0.f, 0.f, 0.f }, R, G, B, A);
+}
+
+void QuadBatch::add(const SDL_Rect& rect, const SDL_FRect& uv, Uint8 R, Uint8 G, Uint8 B, Uint8 A){
+    if (rect.w <= 0 || rect.h <= 0) return;
+    const float x0 = (float)rect.x, y0 = (float)rect.y, x1 = (float)(rect.x + rect.w), y1 = (float)(rect.y + rect.h);
+    const SDL_Color c{ R, G, B, A };
+    verts_.push_back({ { x0, y0 }, c, { uv.x, uv.y } });
+    verts_.push_back({ { x1, y0 }, c, { uv.x + uv.w, uv.y } });
+    verts_.push_back({ { x1, y1 }, c, { uv.x + uv.w, uv.y + uv.h } });
+    verts_.push_back({ { x0, y1 }, c, { uv.x, uv.y + uv.h } });
+}
+
+bool QuadBatch::flush(SDL_Renderer* r, SDL_Texture* texture){
+    if (verts_.empty()) return !g_quadGeometryFailed;
+    // Frame de software: quads lisos direto nos pixels, na ordem de submissão
+    SoftRaster::Target direct;
+    if (!texture && SoftRaster::beginDirect(r, direct)) {
+        for (size_t v = 0; v + 3 < verts_.size(); v += 4) {
+            const SDL_Vertex& a = verts_[v];
+            SoftRaster::fillRect(direct, (int)a.position.x, (int)a.position.y,
+                                 (int)(verts_[v + 2].position.x - a.position.x), (int)(verts_[v + 2].position.y - a.position.y),
+                                 a.color.r, a.color.g, a.color.b, a.color.a);
+        }
+        clear();
+        return true;
+    }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (!g_quadGeometryFailed) {
+        const int quads = (int)(verts_.size() / 4);
+        for (int q = (int)(indices_.size() / 6); q < quads; q++) {
+            const int v = q * 4;
+            const int idx[6] = { v, v + 1, v + 2, v + 2, v + 3, v };
+            indices_.insert(indices_.end(), idx, idx + 6);
+        }
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+        if (DrawCalls::geometry(r, texture, verts_.data(), (int)verts_.size(), indices_.data(), quads * 6) == 0) {
+            clear();
+            return true;
+        }
+        g_quadGeometryFailed = true;
+        DebugLogger::warning("SDL_RenderGeometry indisponivel, celulas por SDL_RenderFillRects: " + std::string(SDL_GetError()));
+    }
+#endif
+    // Os mesmos quads, lisos, uma chamada por cor
+    (void)texture;
+    for (size_t v = 0; v + 3 < verts_.size(); v += 4) {
+        const SDL_Vertex& a = verts_[v];
+        SDL_Rect rr{ (int)a.position.x, (int)a.position.y,
+                     (int)(verts_[v + 2].position.x - a.position.x), (int)(verts_[v + 2].position.y - a.position.y) };
+        fallback_.add(rr, a.color.r, a.color.g, a.color.b, a.color.a);
+    }
+    fallback_.flush(r);
+    clear();
+    return false;
+}
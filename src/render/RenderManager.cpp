@@ -1,8 +1,16 @@
 #include "../../include/render/RenderManager.hpp"
 #include "../../include/render/RenderLayer.hpp"
 #include "../../include/DebugLogger.hpp"
+#include "../../include/app/FrameProfiler.hpp"
+#include "../../include/app/Tracing.hpp"
+#include "../../include/render/LayoutCache.hpp"
+#include "../../include/render/TexturePool.hpp"
+#include "../../include/render/DrawCalls.hpp"
+
+#include <SDL2/SDL.h>
 
 #include <algorithm>
+#include <string>
 
 class GameState;
 class LayoutCache;
@@ -11,19 +19,152 @@ struct SDL_Renderer;
 
 RenderManager::RenderManager(SDL_Renderer* renderer) : renderer_(renderer) {}
 
+RenderManager::~RenderManager() {
+    releaseCache();
+}
+
 void RenderManager::addLayer(std::unique_ptr<RenderLayer> layer) {
     layers_.push_back(std::move(layer));
     std::sort(layers_.begin(), layers_.end(),
               [](const std::unique_ptr<RenderLayer>& a, const std::unique_ptr<RenderLayer>& b) {
                   return a->getZOrder() < b->getZOrder();
               });
+    rebuildProfileSlots();
+    cacheSlots_.assign(layers_.size(), CacheSlot{});
 }
 
 void RenderManager::render(const GameState& state, const LayoutCache& layout) {
-    for (auto& layer : layers_) {
-        if (layer->isEnabled()) {
-            layer->render(renderer_, state, layout);
+    DB_TRACE_ZONE("Render");
+    cacheRedraws_ = 0;
+    const bool retained = retained_ && prepareCache(layout);
+    
+    // Medido só o lado CPU (submissão); o custo da GPU aparece no Present
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        if (!layers_[i]->isEnabled()) continue;
+        Trace::Zone zone(traceNames_[i]);
+        Uint64 t0 = profiler_ ? SDL_GetPerformanceCounter() : 0;
+        if (retained && cacheSlots_[i].active) renderCached(i, state, layout);
+        else layers_[i]->render(renderer_, state, layout);
+        if (profiler_) profiler_->recordTicks(profileSlots_[i], SDL_GetPerformanceCounter() - t0);
+    }
+}
+
+bool RenderManager::prepareCache(const LayoutCache& layout) {
+    if (cacheFailed_ || !renderer_ || layout.SWr <= 0 || layout.SHr <= 0) return false;
+    if (!cacheTexture_ || cacheW_ != layout.SWr || cacheH_ != layout.SHr || cacheEpoch_ != renderTargetPool().targetsEpoch()) {
+        releaseCache();
+        if (SDL_RenderTargetSupported(renderer_)) {
+            cacheTexture_ = renderTargetPool().acquire(renderer_, layout.SWr, layout.SHr, TextureUse::RETAINED);
+        }
+        if (!cacheTexture_) {
+            cacheFailed_ = true;
+            DebugLogger::warning("RenderManager: render target indisponivel, layers em modo imediato: " + std::string(SDL_GetError()));
+            return false;
+        }
+        cacheW_ = layout.SWr;
+        cacheH_ = layout.SHr;
+        cacheEpoch_ = renderTargetPool().targetsEpoch();
+    }
+    
+    const SDL_Rect area{0, 0, cacheW_, cacheH_};
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        CacheSlot& slot = cacheSlots_[i];
+        SDL_Rect bounds{0, 0, 0, 0};
+        slot.active = layers_[i]->isEnabled() && layers_[i]->getCacheBounds(layout, bounds) &&
+                      SDL_IntersectRect(&bounds, &area, &bounds) == SDL_TRUE;
+        if (!slot.active) { slot.valid = false; continue; }
+        if (!SDL_RectEquals(&bounds, &slot.bounds)) slot.valid = false;
+        slot.bounds = bounds;
+    }
+    // As regiões dividem a mesma textura: layers cacheáveis que se sobrepõem ficam imediatas
+    for (size_t i = 0; i < cacheSlots_.size(); ++i) {
+        for (size_t j = i + 1; j < cacheSlots_.size(); ++j) {
+            CacheSlot& a = cacheSlots_[i];
+            CacheSlot& b = cacheSlots_[j];
+            if (a.active && b.active && SDL_HasIntersection(&a.bounds, &b.bounds)) {
+                a.active = b.active = false;
+                a.valid = b.valid = false;
+            }
+        }
+    }
+    return true;
+}
+
+void RenderManager::renderCached(size_t index, const GameState& state, const LayoutCache& layout) {
+    CacheSlot& slot = cacheSlots_[index];
+    RenderLayer& layer = *layers_[index];
+    const std::uint64_t version = layer.contentVersion(state);
+    
+    if (!slot.valid || version != slot.version) {
+        // Trocar de target zera viewport e clip: guarda os do alvo atual
+        // (janela ou a textura do CAPTURE_VIDEO) para voltar a eles
+        SDL_Texture* prevTarget = SDL_GetRenderTarget(renderer_);
+        SDL_Rect viewport, clip;
+        SDL_RenderGetViewport(renderer_, &viewport);
+        SDL_RenderGetClipRect(renderer_, &clip);
+        const bool clipped = SDL_RenderIsClipEnabled(renderer_) == SDL_TRUE;
+        
+        if (SDL_SetRenderTarget(renderer_, cacheTexture_) != 0) {
+            layer.render(renderer_, state, layout);
+            return;
         }
+        SDL_BlendMode blend = SDL_BLENDMODE_BLEND;
+        SDL_GetRenderDrawBlendMode(renderer_, &blend);
+        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+        DrawCalls::fillRect(renderer_, &slot.bounds);
+        SDL_SetRenderDrawBlendMode(renderer_, blend);
+        SDL_RenderSetClipRect(renderer_, &slot.bounds);
+        layer.render(renderer_, state, layout);
+        SDL_RenderSetClipRect(renderer_, nullptr);
+        
+        SDL_SetRenderTarget(renderer_, prevTarget);
+        SDL_RenderSetViewport(renderer_, &viewport);
+        SDL_RenderSetClipRect(renderer_, clipped ? &clip : nullptr);
+        slot.version = version;
+        slot.valid = true;
+        ++cacheRedraws_;
+    }
+    DrawCalls::copy(renderer_, cacheTexture_, &slot.bounds, &slot.bounds);
+}
+
+void RenderManager::setRetained(bool retained) {
+    if (retained == retained_) return;
+    retained_ = retained;
+    if (!retained_) releaseCache();
+    invalidateCache();
+}
+
+void RenderManager::invalidateCache() {
+    for (CacheSlot& slot : cacheSlots_) slot.valid = false;
+}
+
+void RenderManager::releaseCache() {
+    renderTargetPool().release(cacheTexture_);
+    cacheTexture_ = nullptr;
+    cacheW_ = cacheH_ = 0;
+    invalidateCache();
+}
+
+bool RenderManager::isAnimated(const GameState& state) const {
+    for (const auto& layer : layers_) {
+        if (layer->isEnabled() && layer->isAnimated(state)) return true;
+    }
+    return false;
+}
+
+void RenderManager::setProfiler(FrameProfiler* profiler) {
+    profiler_ = profiler;
+    rebuildProfileSlots();
+}
+
+void RenderManager::rebuildProfileSlots() {
+    profileSlots_.assign(layers_.size(), -1);
+    traceNames_.resize(layers_.size());
+    for (size_t i = 0; i < layers_.size(); ++i) traceNames_[i] = Trace::intern(layers_[i]->getName());
+    if (!profiler_) return;
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        profileSlots_[i] = profiler_->addSection(layers_[i]->getName());
     }
 }
 
@@ -37,7 +178,11 @@ void RenderManager::setLayerEnabled(const std::string& name, bool enabled) {
 }
 
 void RenderManager::cleanup() {
+    releaseCache();
     layers_.clear();
+    profileSlots_.clear();
+    traceNames_.clear();
+    cacheSlots_.clear();
 }
 
 RenderLayer* RenderManager::getLayer(const std::string& name) {
@@ -0,0 +1,132 @@
+#include "render/RendererProbe.hpp"
+#include "render/GameStateBridge.hpp"
+#include "render/Layers.hpp"
+#include "render/LayoutCache.hpp"
+#include "render/RenderManager.hpp"
+#include "render/TexturePool.hpp"
+#include "DebugLogger.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace RendererProbe {
+
+int driverIndex(const std::string& name) {
+    int n = SDL_GetNumRenderDrivers();
+    for (int i = 0; i < n; ++i) {
+        SDL_RendererInfo info;
+        if (SDL_GetRenderDriverInfo(i, &info) == 0 && info.name && SDL_strcasecmp(info.name, name.c_str()) == 0) return i;
+    }
+    return -1;
+}
+
+std::string driverName(SDL_Renderer* renderer) {
+    SDL_RendererInfo info;
+    if (!renderer || SDL_GetRendererInfo(renderer, &info) != 0 || !info.name) return "";
+    return info.name;
+}
+
+std::string machineKey(SDL_Window* window) {
+    const char* video = SDL_GetCurrentVideoDriver();
+    std::string key = std::string(SDL_GetPlatform()) + "|" + (video ? video : "?");
+    SDL_DisplayMode dm;
+    if (window && SDL_GetWindowDisplayMode(window, &dm) == 0) {
+        key += "|" + std::to_string(dm.w) + "x" + std::to_string(dm.h) + "@" + std::to_string(dm.refresh_rate);
+    }
+    key += "|";
+    int n = SDL_GetNumRenderDrivers();
+    for (int i = 0; i < n; ++i) {
+        SDL_RendererInfo info;
+        if (SDL_GetRenderDriverInfo(i, &info) != 0 || !info.name) continue;
+        if (key.back() != '|') key += ",";
+        key += info.name;
+    }
+    return key;
+}
+
+bool loadChoice(const std::string& path, const std::string& machine, std::string& driver) {
+    std::ifstream f(path.c_str());
+    if (!f.good()) return false;
+    std::string line, fileMachine, fileDriver;
+    while (std::getline(f, line)) {
+        if (line.compare(0, 8, "machine=") == 0) fileMachine = line.substr(8);
+        else if (line.compare(0, 7, "driver=") == 0) fileDriver = line.substr(7);
+    }
+    if (fileMachine != machine || fileDriver.empty()) return false;
+    driver = fileDriver;
+    return true;
+}
+
+bool saveChoice(const std::string& path, const std::string& machine, const std::string& driver,
+                const std::vector<Sample>& samples) {
+    std::ofstream f(path.c_str(), std::ios::trunc);
+    if (!f.good()) {
+        DebugLogger::warning("RendererProbe: cannot write " + path);
+        return false;
+    }
+    f << "# DropBlocks renderer probe (delete to measure again)\n";
+    f << "machine=" << machine << "\n";
+    f << "driver=" << driver << "\n";
+    for (const Sample& s : samples) {
+        char ms[32];
+        std::snprintf(ms, sizeof(ms), "%.3f", s.frameMs);
+        f << "# " << s.driver << " " << (s.ok ? std::string(ms) + " ms/frame" : std::string("failed")) << "\n";
+    }
+    return f.good();
+}
+
+std::vector<Sample> measure(SDL_Window* window, const GameState& state, int frames) {
+    const int WARMUP = 10;  // Shaders, texturas de cache e primeiro batch fora da média
+    if (frames < 1) frames = 1;
+    std::vector<Sample> samples;
+    int n = SDL_GetNumRenderDrivers();
+    for (int i = 0; i < n; ++i) {
+        SDL_RendererInfo info;
+        if (SDL_GetRenderDriverInfo(i, &info) != 0 || !info.name) continue;
+        Sample s;
+        s.driver = info.name;
+        SDL_Renderer* r = SDL_CreateRenderer(window, i, 0);  // Sem vsync: mede o custo, não o refresh
+        if (!r) {
+            DebugLogger::info("RendererProbe: " + s.driver + " unavailable: " + SDL_GetError());
+            samples.push_back(s);
+            continue;
+        }
+        {
+            RenderManager manager(r);
+            addDefaultLayers(manager, nullptr);
+            LayoutCache layout;
+            db_layoutCalculate(layout, r);
+            Uint64 start = 0;
+            for (int f = 0; f < WARMUP + frames; ++f) {
+                if (f == WARMUP) start = SDL_GetPerformanceCounter();
+                SDL_PumpEvents();
+                manager.render(state, layout);
+                SDL_RenderPresent(r);
+            }
+            // Ler um pixel espera a GPU terminar o que o Present só enfileirou
+            Uint32 pixel = 0;
+            SDL_Rect one{0, 0, 1, 1};
+            SDL_RenderReadPixels(r, &one, SDL_PIXELFORMAT_ARGB8888, &pixel, sizeof(pixel));
+            double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+            s.frameMs = ms / frames;
+            s.ok = true;
+        }  // Layers (e suas texturas) antes do renderer
+        renderTargetPool().purge(r);
+        SDL_DestroyRenderer(r);
+        char line[96];
+        std::snprintf(line, sizeof(line), "RendererProbe: %s %.3f ms/frame", s.driver.c_str(), s.frameMs);
+        DebugLogger::info(line);
+        samples.push_back(s);
+    }
+    return samples;
+}
+
+std::string fastest(const std::vector<Sample>& samples) {
+    const Sample* best = nullptr;
+    for (const Sample& s : samples) {
+        if (s.ok && (!best || s.frameMs < best->frameMs)) best = &s;
+    }
+    return best ? best->driver : std::string();
+}
+
+} // namespace RendererProbe
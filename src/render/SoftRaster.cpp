@@ -0,0 +1,258 @@
+#include "render/SoftRaster.hpp"
+#include "render/TexturePool.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#if DROPBLOCKS_SOFT_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define DB_SOFT_SSE2 1
+#elif DROPBLOCKS_SOFT_SIMD && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DB_SOFT_NEON 1
+#endif
+
+namespace {
+struct SoftFrame {
+    SDL_Window* window = nullptr;
+    SDL_Surface* surface = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    bool presentFailed = false;
+};
+SoftFrame g_frame;
+
+// round(x / 255) sem divisão, exato para x <= 255*255
+inline Uint32 div255(Uint32 x) { x += 128; return (x + (x >> 8)) >> 8; }
+
+inline Uint32 blendPixel(Uint32 d, Uint32 s, Uint32 a) {
+    const Uint32 inv = 255 - a;
+    Uint32 out = 0;
+    for (int sh = 0; sh < 32; sh += 8) {
+        out |= div255(((s >> sh) & 0xFF) * a + ((d >> sh) & 0xFF) * inv) << sh;
+    }
+    return out;
+}
+
+bool intersect(SDL_Rect& a, const SDL_Rect& b) {
+    const int x0 = std::max(a.x, b.x), y0 = std::max(a.y, b.y);
+    const int x1 = std::min(a.x + a.w, b.x + b.w), y1 = std::min(a.y + a.h, b.y + b.h);
+    a = SDL_Rect{x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0)};
+    return a.w > 0 && a.h > 0;
+}
+
+// Um trecho [x0, x1) da linha py, já em pixels do frame, recortado pelo clip
+inline void span(const SoftRaster::Target& t, int py, int x0, int x1, Uint32 color, Uint8 a) {
+    if (py < t.clip.y || py >= t.clip.y + t.clip.h) return;
+    x0 = std::max(x0, t.clip.x);
+    x1 = std::min(x1, t.clip.x + t.clip.w);
+    if (x1 <= x0) return;
+    Uint32* row = t.pixels + (size_t)py * t.stride + x0;
+    if (a == 255) SoftRaster::fillSpan(row, x1 - x0, color);
+    else SoftRaster::blendSpan(row, x1 - x0, color, a);
+}
+
+// Quanto a linha row (0..h-1) de um retângulo arredondado recua de cada lado
+inline int cornerInset(int row, int h, int radX, int radY) {
+    if (radX <= 0 || radY <= 0) return 0;
+    float dy;
+    if (row < radY) dy = radY - row - 0.5f;
+    else if (row >= h - radY) dy = row - (h - radY) + 0.5f;
+    else return 0;
+    const float k = dy / radY;
+    const float dx = radX * std::sqrt(std::max(0.f, 1.f - k * k));
+    return radX - (int)(dx + 0.5f);
+}
+} // namespace
+
+namespace SoftRaster {
+
+const char* kernelName() {
+#if defined(DB_SOFT_SSE2)
+    return "SSE2";
+#elif defined(DB_SOFT_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+void fillSpan(Uint32* dst, int n, Uint32 color) {
+    int i = 0;
+#if defined(DB_SOFT_SSE2)
+    const __m128i c = _mm_set1_epi32((int)color);
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), c);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), c);
+    }
+    for (; i + 4 <= n; i += 4) _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), c);
+#elif defined(DB_SOFT_NEON)
+    const uint32x4_t c = vdupq_n_u32(color);
+    for (; i + 4 <= n; i += 4) vst1q_u32(dst + i, c);
+#endif
+    for (; i < n; i++) dst[i] = color;
+}
+
+void blendSpan(Uint32* dst, int n, Uint32 color, Uint8 alpha) {
+    if (alpha == 0 || n <= 0) return;
+    if (alpha == 255) { fillSpan(dst, n, color); return; }
+    const Uint32 a = alpha, inv = 255 - alpha;
+    int i = 0;
+#if defined(DB_SOFT_SSE2)
+    // 4 pixels por volta em 16 bits: s*a + 128 fica pronto fora do laço
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+    const __m128i srcTerm = _mm_add_epi16(_mm_mullo_epi16(src, _mm_set1_epi16((short)a)), _mm_set1_epi16(128));
+    const __m128i invV = _mm_set1_epi16((short)inv);
+    for (; i + 4 <= n; i += 4) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invV), srcTerm);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invV), srcTerm);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(DB_SOFT_NEON)
+    const uint8x8_t src = vreinterpret_u8_u32(vdup_n_u32(color));
+    const uint16x8_t srcTerm = vaddq_u16(vmull_u8(src, vdup_n_u8((uint8_t)a)), vdupq_n_u16(128));
+    const uint8x8_t invV = vdup_n_u8((uint8_t)inv);
+    for (; i + 4 <= n; i += 4) {
+        uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        uint16x8_t lo = vmlal_u8(srcTerm, vget_low_u8(d), invV);
+        uint16x8_t hi = vmlal_u8(srcTerm, vget_high_u8(d), invV);
+        uint8x8_t rlo = vshrn_n_u16(vsraq_n_u16(lo, lo, 8), 8);
+        uint8x8_t rhi = vshrn_n_u16(vsraq_n_u16(hi, hi, 8), 8);
+        vst1q_u32(dst + i, vreinterpretq_u32_u8(vcombine_u8(rlo, rhi)));
+    }
+#endif
+    for (; i < n; i++) dst[i] = blendPixel(dst[i], color, a);
+}
+
+void fillRect(const Target& t, int x, int y, int w, int h, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    if (a == 0) return;
+    SDL_Rect rc{x + t.originX, y + t.originY, w, h};
+    if (!intersect(rc, t.clip)) return;
+    const Uint32 color = packColor(r, g, b);
+    Uint32* row = t.pixels + (size_t)rc.y * t.stride + rc.x;
+    for (int yy = 0; yy < rc.h; yy++, row += t.stride) {
+        if (a == 255) fillSpan(row, rc.w, color);
+        else blendSpan(row, rc.w, color, a);
+    }
+}
+
+void fillRounded(const Target& t, int x, int y, int w, int h, int radX, int radY, int thickness,
+                 Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    if (w <= 0 || h <= 0 || a == 0) return;
+    radX = std::max(0, std::min(radX, w / 2));
+    radY = std::max(0, std::min(radY, h / 2));
+    const Uint32 color = packColor(r, g, b);
+    const int px = x + t.originX, py = y + t.originY;
+
+    // Anel: por linha, o contorno externo menos o interno (sem sobrepor alpha)
+    const int iw = w - 2 * thickness, ih = h - 2 * thickness;
+    const bool ring = thickness > 0 && iw > 0 && ih > 0;
+    const int irx = ring ? std::max(0, std::min(radX - thickness, iw / 2)) : 0;
+    const int iry = ring ? std::max(0, std::min(radY - thickness, ih / 2)) : 0;
+
+    const int rowStart = std::max(0, t.clip.y - py), rowEnd = std::min(h, t.clip.y + t.clip.h - py);
+    for (int row = rowStart; row < rowEnd; row++) {
+        const int out = cornerInset(row, h, radX, radY);
+        const int x0 = px + out, x1 = px + w - out;
+        const int irow = row - thickness;
+        if (!ring || irow < 0 || irow >= ih) {
+            span(t, py + row, x0, x1, color, a);
+            continue;
+        }
+        const int in = cornerInset(irow, ih, irx, iry);
+        span(t, py + row, x0, px + thickness + in, color, a);
+        span(t, py + row, px + thickness + iw - in, x1, color, a);
+    }
+}
+
+bool beginDirect(SDL_Renderer* renderer, Target& out) {
+    if (!renderer || renderer != g_frame.renderer) return false;
+#if SDL_VERSION_ATLEAST(2, 0, 10)
+    if (SDL_GetRenderTarget(renderer)) return false;
+    float sx = 1.f, sy = 1.f;
+    SDL_RenderGetScale(renderer, &sx, &sy);
+    if (sx != 1.f || sy != 1.f) return false;
+    SDL_RenderFlush(renderer);  // O que as layers já mandaram ao SDL sai antes
+
+    SDL_Surface* s = g_frame.surface;
+    SDL_Rect vp;
+    SDL_RenderGetViewport(renderer, &vp);
+    out.pixels = static_cast<Uint32*>(s->pixels);
+    out.stride = s->pitch / 4;
+    out.originX = vp.x;
+    out.originY = vp.y;
+    out.clip = SDL_Rect{0, 0, s->w, s->h};
+    intersect(out.clip, vp);
+    if (SDL_RenderIsClipEnabled(renderer)) {
+        SDL_Rect c;
+        SDL_RenderGetClipRect(renderer, &c);
+        c.x += vp.x;
+        c.y += vp.y;
+        intersect(out.clip, c);
+    }
+    return true;
+#else
+    (void)out;
+    return false;  // Sem SDL_RenderFlush a ordem com a fila do SDL não fecha
+#endif
+}
+
+SDL_Renderer* createFrame(SDL_Window* window) {
+    destroyRenderer(g_frame.renderer);
+    int w = 0, h = 0;
+    SDL_GetWindowSize(window, &w, &h);
+    // RGB888: sem alpha, o blit para a janela é cópia (e os kernels escrevem 0xFF no byte livre)
+    SDL_Surface* surface = w > 0 && h > 0 ? SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGB888) : nullptr;
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer) {
+        DebugLogger::error(std::string("Software frame unavailable: ") + SDL_GetError());
+        if (surface) SDL_FreeSurface(surface);
+        return nullptr;
+    }
+    g_frame.window = window;
+    g_frame.surface = surface;
+    g_frame.renderer = renderer;
+    g_frame.presentFailed = false;
+    DebugLogger::info("Software frame " + std::to_string(w) + "x" + std::to_string(h) + ", " + kernelName() + " kernels");
+    return renderer;
+}
+
+bool isFrameRenderer(const SDL_Renderer* renderer) {
+    return renderer && renderer == g_frame.renderer;
+}
+
+void destroyRenderer(SDL_Renderer* renderer) {
+    if (!renderer) return;
+    renderTargetPool().purge(renderer);
+    SDL_DestroyRenderer(renderer);
+    if (renderer != g_frame.renderer) return;
+    SDL_FreeSurface(g_frame.surface);
+    g_frame = SoftFrame();
+}
+
+void present(SDL_Renderer* renderer) {
+    SDL_RenderPresent(renderer);
+    if (!isFrameRenderer(renderer) || g_frame.presentFailed) return;
+
+    // Uma cópia por frame; a janela redimensionada recebe o frame escalado
+    SDL_Surface* dst = SDL_GetWindowSurface(g_frame.window);
+    int rc = -1;
+    if (dst) {
+        if (dst->w == g_frame.surface->w && dst->h == g_frame.surface->h) {
+            rc = SDL_BlitSurface(g_frame.surface, nullptr, dst, nullptr);
+        } else {
+            SDL_Rect full{0, 0, dst->w, dst->h};
+            rc = SDL_BlitScaled(g_frame.surface, nullptr, dst, &full);
+        }
+    }
+    if (rc != 0 || SDL_UpdateWindowSurface(g_frame.window) != 0) {
+        g_frame.presentFailed = true;
+        DebugLogger::error(std::string("Software frame: window surface unavailable: ") + SDL_GetError());
+    }
+}
+
+} // namespace SoftRaster
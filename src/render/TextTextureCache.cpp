@@ -0,0 +1,127 @@
+#include "render/TextTextureCache.hpp"
+#include "render/Primitives.hpp"
+#include "render/DrawCalls.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+
+namespace {
+    inline Uint32 packRGB(Uint8 r, Uint8 g, Uint8 b) { return ((Uint32)r << 16) | ((Uint32)g << 8) | b; }
+}
+
+TextTextureCache::TextTextureCache() {
+    renderTargetPool().addEvictor(this);
+}
+
+TextTextureCache::~TextTextureCache() {
+    renderTargetPool().removeEvictor(this);
+    clear();
+}
+
+void TextTextureCache::clear() {
+    for (auto& e : entries_) renderTargetPool().release(e.tex);
+    entries_.clear();
+    failed_ = false;
+}
+
+Uint32 TextTextureCache::oldestTextureUse() const {
+    Uint32 oldest = UINT32_MAX;
+    for (const auto& e : entries_) oldest = std::min(oldest, e.frame);
+    return oldest;
+}
+
+void TextTextureCache::evictOldestTexture() {
+    if (entries_.empty()) return;
+    auto oldest = std::min_element(entries_.begin(), entries_.end(),
+        [](const Entry& a, const Entry& b) { return a.frame < b.frame; });
+    renderTargetPool().release(oldest->tex);
+    *oldest = std::move(entries_.back());
+    entries_.pop_back();
+}
+
+const TextTextureCache::Entry* TextTextureCache::find(SDL_Renderer* renderer, const std::string& text,
+                                                      float sx, float sy, Uint32 color, bool outlined, Uint32 outline) {
+    TexturePool& pool = renderTargetPool();
+    // Render targets perdidos: tudo é refeito conforme for desenhado
+    if (epoch_ != pool.targetsEpoch()) {
+        clear();
+        epoch_ = pool.targetsEpoch();
+    }
+    ++clock_;
+    for (auto& e : entries_) {
+        if (e.scaleX == sx && e.scaleY == sy && e.color == color && e.outlined == outlined &&
+            (!outlined || e.outline == outline) && e.text == text) {
+            e.lastUse = clock_;
+            e.frame = pool.frame();
+            return &e;
+        }
+    }
+    if (failed_ || !renderer) return nullptr;
+    // Só texto de uma linha com pixels visíveis
+    if (text.empty() || (int)sx <= 0 || (int)sy <= 0 || text.find('\n') != std::string::npos) return nullptr;
+    
+    Entry e;
+    e.text = text;
+    e.scaleX = sx; e.scaleY = sy;
+    e.color = color; e.outline = outline; e.outlined = outlined;
+    // Mesma extensão que drawPixelText(Outlined) gera
+    e.pad = outlined ? std::max(1, (int)(sx / 2)) : 0;
+    e.padY = outlined ? std::max(1, (int)(sy / 2)) : 0;
+    int n = (int)text.size();
+    e.w = (n - 1) * (int)(6 * sx) + (int)(4 * sx) + (int)sx + 2 * e.pad;
+    e.h = (int)(6 * sy) + (int)sy + 2 * e.padY;
+    
+    e.tex = pool.create(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, e.w, e.h, TextureUse::TEXT);
+    if (!e.tex) {
+        failed_ = true;
+        DebugLogger::warning("TextTextureCache: render target indisponivel, texto imediato: " + std::string(SDL_GetError()));
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(e.tex, SDL_BLENDMODE_BLEND);
+    
+    SDL_Texture* prev = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, e.tex);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    DrawCalls::clear(renderer);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    Uint8 r = (Uint8)(color >> 16), g = (Uint8)(color >> 8), b = (Uint8)color;
+    if (outlined) {
+        drawPixelTextOutlined(renderer, e.pad, e.padY, text, sx, sy, r, g, b,
+                              (Uint8)(outline >> 16), (Uint8)(outline >> 8), (Uint8)outline);
+    } else {
+        drawPixelText(renderer, 0, 0, text, sx, sy, r, g, b);
+    }
+    SDL_SetRenderTarget(renderer, prev);
+    
+    e.lastUse = clock_;
+    e.frame = pool.frame();
+    if (entries_.size() < capacity_) {
+        entries_.push_back(std::move(e));
+        return &entries_.back();
+    }
+    auto oldest = std::min_element(entries_.begin(), entries_.end(),
+        [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+    pool.release(oldest->tex);
+    *oldest = std::move(e);
+    return &*oldest;
+}
+
+void TextTextureCache::draw(SDL_Renderer* renderer, int x, int y, const std::string& text, float sx, float sy,
+                            Uint8 R, Uint8 G, Uint8 B) {
+    if (const Entry* e = find(renderer, text, sx, sy, packRGB(R, G, B), false, 0)) {
+        SDL_Rect dst{x, y, e->w, e->h};
+        DrawCalls::copy(renderer, e->tex, nullptr, &dst);
+        return;
+    }
+    drawPixelText(renderer, x, y, text, sx, sy, R, G, B);
+}
+
+void TextTextureCache::drawOutlined(SDL_Renderer* renderer, int x, int y, const std::string& text, float sx, float sy,
+                                    Uint8 R, Uint8 G, Uint8 B, Uint8 oR, Uint8 oG, Uint8 oB) {
+    if (const Entry* e = find(renderer, text, sx, sy, packRGB(R, G, B), true, packRGB(oR, oG, oB))) {
+        SDL_Rect dst{x - e->pad, y - e->padY, e->w, e->h};
+        DrawCalls::copy(renderer, e->tex, nullptr, &dst);
+        return;
+    }
+    drawPixelTextOutlined(renderer, x, y, text, sx, sy, R, G, B, oR, oG, oB);
+}
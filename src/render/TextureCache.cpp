@@ -1,10 +1,16 @@
 #include "render/TextureCache.hpp"
 #include "render/LayoutCache.hpp"
 #include "render/Primitives.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
 #include "ThemeManager.hpp"
 #include "DebugLogger.hpp"
+#include <cctype>
+#include <string>
+#include <utility>
 
 extern ThemeManager themeManager;
+extern std::string TITLE_TEXT;
 
 TextureCache::~TextureCache() {
     cleanup();
@@ -13,24 +19,36 @@ TextureCache::~TextureCache() {
 SDL_Texture* TextureCache::createTexture(SDL_Renderer* renderer, int w, int h) {
     if (!renderer || w <= 0 || h <= 0) return nullptr;
     
-    SDL_Texture* texture = SDL_CreateTexture(renderer, 
-                                            SDL_PIXELFORMAT_RGBA8888, 
-                                            SDL_TEXTUREACCESS_TARGET, 
-                                            w, h);
-    if (texture) {
-        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-    } else {
+    // Vem do pool (blend BLEND): voltar a um tamanho já visto não cria textura
+    SDL_Texture* texture = renderTargetPool().acquire(renderer, w, h, TextureUse::PANELS);
+    if (!texture) {
         DebugLogger::error("Failed to create texture: " + std::string(SDL_GetError()));
     }
     return texture;
 }
 
-void TextureCache::update(SDL_Renderer* renderer, const LayoutCache& layout, ThemeManager& theme) {
-    if (!renderer) return;
-    
-    // Clean up old textures
-    cleanup();
-    
+SDL_Texture* TextureCache::beginPanel(SDL_Renderer* renderer, int w, int h) {
+    SDL_Texture* texture = createTexture(renderer, w, h);
+    if (!texture) return nullptr;
+    SDL_SetRenderTarget(renderer, texture);
+    SDL_RenderSetClipRect(renderer, nullptr);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    DrawCalls::clear(renderer);
+    return texture;
+}
+
+SDL_Texture** TextureCache::slot(int panel) {
+    switch (panel) {
+        case BANNER: return &bannerTexture_;
+        case STATS: return &statsBoxTexture_;
+        case HUD: return &hudPanelTexture_;
+        case NEXT: return &nextBoxTexture_;
+        case SCORE: return &scoreBoxTexture_;
+        default: return nullptr;
+    }
+}
+
+SDL_Texture* TextureCache::bake(int panel, SDL_Renderer* renderer, const LayoutCache& layout, const Theme& th) {
     // Use new layout system if configured, otherwise fall back to legacy
     int bannerW = layout.bannerRect.w > 0 ? layout.bannerRect.w : layout.BW;
     int bannerH = layout.bannerRect.w > 0 ? layout.bannerRect.h : layout.BH;
@@ -39,84 +57,136 @@ void TextureCache::update(SDL_Renderer* renderer, const LayoutCache& layout, The
     int hudW = layout.hudRect.w > 0 ? layout.hudRect.w : layout.panelW;
     int hudH = layout.hudRect.w > 0 ? layout.hudRect.h : layout.panelH;
     
-    // 1. Create Banner Texture
-    if (layout.bannerConfig.enabled) {
-        bannerTexture_ = createTexture(renderer, bannerW, bannerH);
-        if (bannerTexture_) {
-            SDL_SetRenderTarget(renderer, bannerTexture_);
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-            SDL_RenderClear(renderer);
-            
-            // Draw banner background
-            drawRoundedFilled(renderer, 0, 0, bannerW, bannerH, layout.borderRadius,
-                             theme.getTheme().banner_bg_r, 
-                             theme.getTheme().banner_bg_g, 
-                             theme.getTheme().banner_bg_b, 255);
-            
-            SDL_SetRenderTarget(renderer, nullptr);
-        }
-    }
+    // Same corners as the layers (elliptical in STRETCH mode)
+    const int radX = layout.borderRadiusX, radY = layout.borderRadiusY;
+    SDL_Texture* texture = nullptr;
     
-    // 2. Create Stats Box Texture
-    if (layout.statsConfig.enabled) {
-        statsBoxTexture_ = createTexture(renderer, statsW, statsH);
-        if (statsBoxTexture_) {
-            SDL_SetRenderTarget(renderer, statsBoxTexture_);
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-            SDL_RenderClear(renderer);
+    switch (panel) {
+    case BANNER:
+        // 1. Banner: background + vertical title
+        if (layout.bannerConfig.enabled && (texture = beginPanel(renderer, bannerW, bannerH))) {
+            drawRoundedFilled(renderer, 0, 0, bannerW, bannerH, radX, radY,
+                              th.banner_bg_r, th.banner_bg_g, th.banner_bg_b, 255);
             
-            // DEBUG: Log stats texture colors
-            char statsDebug[256];
-            snprintf(statsDebug, sizeof(statsDebug), "TextureCache Stats - fill: #%02x%02x%02x, outline: #%02x%02x%02x", 
-                     theme.getTheme().stats_fill_r, theme.getTheme().stats_fill_g, theme.getTheme().stats_fill_b,
-                     theme.getTheme().stats_outline_r, theme.getTheme().stats_outline_g, theme.getTheme().stats_outline_b);
-
-            drawRoundedFilled(renderer, 0, 0, statsW, statsH, layout.borderRadius,
-                             theme.getTheme().stats_fill_r, 
-                             theme.getTheme().stats_fill_g, 
-                             theme.getTheme().stats_fill_b, 255);
-            
-            SDL_SetRenderTarget(renderer, nullptr);
+            // Mirrors BannerLayer's immediate path
+            int bty = (int)(10 * layout.scaleY);
+            int cxText = (int)(bannerW - 5 * layout.scaleTextX) / 2;
+            std::string glyph(1, ' ');
+            for (char ch : TITLE_TEXT) {
+                if (ch == ' ') { bty += (int)(6 * layout.scaleTextY); continue; }
+                ch = (char)std::toupper((unsigned char)ch);
+                if (!((ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '-' || ch == ':' || ch == '.')) {
+                    ch = ' ';
+                }
+                glyph[0] = ch;
+                drawPixelText(renderer, cxText, bty, glyph, layout.scaleTextX, layout.scaleTextY,
+                              th.banner_text_r, th.banner_text_g, th.banner_text_b);
+                bty += (int)(9 * layout.scaleTextY);
+            }
+        }
+        break;
+    case STATS:
+        // 2. Stats box
+        if (layout.statsConfig.enabled && (texture = beginPanel(renderer, statsW, statsH))) {
+            drawRoundedFilled(renderer, 0, 0, statsW, statsH, radX, radY,
+                              th.stats_fill_r, th.stats_fill_g, th.stats_fill_b, 255);
+        }
+        break;
+    case HUD:
+        // 3. HUD panel
+        if (layout.hudConfig.enabled && (texture = beginPanel(renderer, hudW, hudH))) {
+            drawRoundedFilled(renderer, 0, 0, hudW, hudH, radX, radY,
+                              th.panel_fill_r, th.panel_fill_g, th.panel_fill_b, 255);
+        }
+        break;
+    case NEXT:
+        // 4. NEXT box: background + "NEXT" label (only with the new layout system)
+        if (layout.nextConfig.enabled && layout.nextRect.w > 0 &&
+            (texture = beginPanel(renderer, layout.nextRect.w, layout.nextRect.h))) {
+            const int w = layout.nextRect.w, h = layout.nextRect.h;
+            drawRoundedFilled(renderer, 0, 0, w, h, radX, radY,
+                              th.next_fill_r, th.next_fill_g, th.next_fill_b, 255);
+            const std::string nextText = "NEXT";
+            int pad = (int)(10 * layout.scaleY);
+            int textX = (w - textWidthPx(nextText, layout.scaleTextX)) / 2;
+            drawPixelText(renderer, textX, pad*2, nextText, layout.scaleTextX, layout.scaleTextY,
+                          th.next_label_r, th.next_label_g, th.next_label_b);
+        }
+        break;
+    case SCORE:
+        // 5. Score box background
+        if (layout.scoreConfig.enabled && layout.scoreRect.w > 0 &&
+            (texture = beginPanel(renderer, layout.scoreRect.w, layout.scoreRect.h))) {
+            drawRoundedFilled(renderer, 0, 0, layout.scoreRect.w, layout.scoreRect.h, radX, radY,
+                              th.score_fill_r, th.score_fill_g, th.score_fill_b, 255);
         }
+        break;
+    default:
+        break;
     }
+    return texture;
+}
+
+void TextureCache::update(SDL_Renderer* renderer, const LayoutCache& layout, ThemeManager& theme) {
+    if (!renderer) return;
     
-    // 3. Create HUD Panel Texture
-    if (layout.hudConfig.enabled) {
-        hudPanelTexture_ = createTexture(renderer, hudW, hudH);
-        if (hudPanelTexture_) {
-            SDL_SetRenderTarget(renderer, hudPanelTexture_);
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-            SDL_RenderClear(renderer);
-            
-            drawRoundedFilled(renderer, 0, 0, hudW, hudH, layout.borderRadius,
-                             theme.getTheme().panel_fill_r, 
-                             theme.getTheme().panel_fill_g, 
-                             theme.getTheme().panel_fill_b, 255);
-            
-            SDL_SetRenderTarget(renderer, nullptr);
-        }
+    // Clean up old textures
+    cleanup();
+    
+    if (!SDL_RenderTargetSupported(renderer)) {
+        DebugLogger::warning("Render targets not supported; panels drawn immediately");
+        return;
     }
     
+    const auto& th = theme.getTheme();
+    for (int panel = 0; panel < PANEL_COUNT; ++panel) *slot(panel) = bake(panel, renderer, layout, th);
+    
+    SDL_SetRenderTarget(renderer, nullptr);
     valid_ = true;
 }
 
-void TextureCache::cleanup() {
-    if (bannerTexture_) {
-        SDL_DestroyTexture(bannerTexture_);
-        bannerTexture_ = nullptr;
-    }
-    if (statsBoxTexture_) {
-        SDL_DestroyTexture(statsBoxTexture_);
-        statsBoxTexture_ = nullptr;
+bool TextureCache::rebakeStep(SDL_Renderer* renderer, const LayoutCache& layout, ThemeManager& theme) {
+    if (!rebakePending_) return false;
+    if (!valid_ || !renderer) { rebakePending_ = 0; return false; }
+    int panel = 0;
+    while (!(rebakePending_ & (1u << panel))) ++panel;
+    rebakePending_ &= ~(1u << panel);
+    
+    // O painel antigo continua valendo até o novo ficar pronto
+    SDL_Texture* prev = SDL_GetRenderTarget(renderer);
+    SDL_Texture* fresh = bake(panel, renderer, layout, theme.getTheme());
+    SDL_SetRenderTarget(renderer, prev);
+    SDL_Texture** dst = slot(panel);
+    if (fresh || !*dst) {
+        renderTargetPool().release(*dst);
+        *dst = fresh;
     }
-    if (hudPanelTexture_) {
-        SDL_DestroyTexture(hudPanelTexture_);
-        hudPanelTexture_ = nullptr;
+    return rebakePending_ != 0;
+}
+
+void TextureCache::swap(TextureCache& other) noexcept {
+    std::swap(bannerTexture_, other.bannerTexture_);
+    std::swap(statsBoxTexture_, other.statsBoxTexture_);
+    std::swap(hudPanelTexture_, other.hudPanelTexture_);
+    std::swap(nextBoxTexture_, other.nextBoxTexture_);
+    std::swap(scoreBoxTexture_, other.scoreBoxTexture_);
+    std::swap(valid_, other.valid_);
+    std::swap(rebakePending_, other.rebakePending_);
+}
+
+void TextureCache::retag(TextureUse use) {
+    for (int panel = 0; panel < PANEL_COUNT; ++panel) {
+        if (SDL_Texture* texture = *slot(panel)) renderTargetPool().retag(texture, use);
     }
-    if (nextBoxTexture_) {
-        SDL_DestroyTexture(nextBoxTexture_);
-        nextBoxTexture_ = nullptr;
+}
+
+void TextureCache::cleanup() {
+    for (int panel = 0; panel < PANEL_COUNT; ++panel) {
+        SDL_Texture** texture = slot(panel);
+        renderTargetPool().release(*texture);
+        *texture = nullptr;
     }
     valid_ = false;
+    rebakePending_ = 0;
 }
 
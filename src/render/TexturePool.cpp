@@ -0,0 +1,241 @@
+#include "render/TexturePool.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace {
+// 180K / 2.4M
+std::string formatBytes(size_t bytes) {
+    char buf[32];
+    if (bytes >= (1u << 20)) std::snprintf(buf, sizeof(buf), "%.1fM", (double)bytes / (1u << 20));
+    else std::snprintf(buf, sizeof(buf), "%zuK", (bytes + 1023) >> 10);
+    return buf;
+}
+}
+
+const char* textureUseName(TextureUse use) {
+    switch (use) {
+        case TextureUse::PANELS:   return "panels";
+        case TextureUse::LAYOUTS:  return "layouts";
+        case TextureUse::RETAINED: return "retained";
+        case TextureUse::BOARD:    return "board";
+        case TextureUse::TIMER:    return "timer";
+        case TextureUse::THUMBS:   return "thumbs";
+        case TextureUse::TEXT:     return "text";
+        case TextureUse::GLYPHS:   return "glyphs";
+        case TextureUse::SKIN:     return "skin";
+        case TextureUse::EFFECTS:  return "fx";
+        case TextureUse::CRT:      return "crt";
+        case TextureUse::CAPTURE:  return "capture";
+        case TextureUse::MARQUEE:  return "marquee";
+        case TextureUse::COUNT:    break;
+    }
+    return "?";
+}
+
+void TexturePool::track(const Entry& entry) {
+    live_.push_back(entry);
+    liveBytes_ += bytesOf(entry);
+    useBytes_[(int)entry.use] += bytesOf(entry);
+}
+
+SDL_Texture* TexturePool::acquire(SDL_Renderer* renderer, int w, int h, TextureUse use) {
+    if (!renderer || w <= 0 || h <= 0) return nullptr;
+
+    // A mais recente do tamanho: é a que tem mais chance de ainda estar na VRAM
+    int best = -1;
+    for (size_t i = 0; i < free_.size(); ++i) {
+        const Entry& e = free_[i];
+        if (e.renderer == renderer && e.w == w && e.h == h && (best < 0 || e.stamp > free_[best].stamp)) best = (int)i;
+    }
+    Entry entry;
+    if (best >= 0) {
+        entry = free_[best];
+        free_[best] = free_.back();
+        free_.pop_back();
+        freeBytes_ -= bytesOf(entry);
+        ++hits_;
+    } else {
+        makeRoom((size_t)w * (size_t)h * 4);
+        SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!texture) return nullptr;
+        entry = Entry{renderer, texture, w, h, 0, use, true, false};
+        ++misses_;
+    }
+    // Estado do dono anterior não vaza para o novo
+    SDL_SetTextureBlendMode(entry.texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(entry.texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(entry.texture, 255);
+    entry.use = use;
+    track(entry);
+    return entry.texture;
+}
+
+SDL_Texture* TexturePool::create(SDL_Renderer* renderer, Uint32 format, int access, int w, int h, TextureUse use) {
+    if (!renderer || w <= 0 || h <= 0) return nullptr;
+    makeRoom((size_t)w * (size_t)h * 4);
+    SDL_Texture* texture = SDL_CreateTexture(renderer, format, access, w, h);
+    if (texture) track(Entry{renderer, texture, w, h, 0, use, false, false});
+    return texture;
+}
+
+void TexturePool::release(SDL_Texture* texture) {
+    if (!texture) return;
+    for (size_t i = 0; i < live_.size(); ++i) {
+        if (live_[i].texture != texture) continue;
+        Entry entry = live_[i];
+        live_[i] = live_.back();
+        live_.pop_back();
+        liveBytes_ -= bytesOf(entry);
+        useBytes_[(int)entry.use] -= bytesOf(entry);
+        if (!entry.pooled || entry.lost) break;
+        entry.stamp = ++clock_;
+        free_.push_back(entry);
+        freeBytes_ += bytesOf(entry);
+        trim();
+        return;
+    }
+    SDL_DestroyTexture(texture);
+}
+
+void TexturePool::retag(SDL_Texture* texture, TextureUse use) {
+    for (Entry& e : live_) {
+        if (e.texture != texture) continue;
+        useBytes_[(int)e.use] -= bytesOf(e);
+        e.use = use;
+        useBytes_[(int)e.use] += bytesOf(e);
+        return;
+    }
+}
+
+void TexturePool::purge(SDL_Renderer* renderer) {
+    size_t kept = 0;
+    for (const Entry& e : free_) {
+        if (e.renderer == renderer) {
+            freeBytes_ -= bytesOf(e);
+            SDL_DestroyTexture(e.texture);
+        } else {
+            free_[kept++] = e;
+        }
+    }
+    free_.resize(kept);
+    // As em uso somem junto com o renderer; release() depois disso só destroi
+    kept = 0;
+    for (const Entry& e : live_) {
+        if (e.renderer != renderer) {
+            live_[kept++] = e;
+        } else {
+            liveBytes_ -= bytesOf(e);
+            useBytes_[(int)e.use] -= bytesOf(e);
+        }
+    }
+    live_.resize(kept);
+}
+
+void TexturePool::setBudget(size_t bytes) {
+    budget_ = bytes;
+    trim();
+}
+
+void TexturePool::setVramBudget(size_t bytes) {
+    vramBudget_ = bytes;
+    if (bytes) DebugLogger::info("TexturePool: teto de " + formatBytes(bytes) + " (em uso " + formatBytes(totalBytes()) + ")");
+    makeRoom(0);
+}
+
+void TexturePool::addEvictor(TextureEvictor* evictor) {
+    if (evictor && std::find(evictors_.begin(), evictors_.end(), evictor) == evictors_.end()) evictors_.push_back(evictor);
+}
+
+void TexturePool::removeEvictor(TextureEvictor* evictor) {
+    evictors_.erase(std::remove(evictors_.begin(), evictors_.end(), evictor), evictors_.end());
+}
+
+void TexturePool::markTargetsLost() {
+    ++targetsEpoch_;
+    DebugLogger::info("TexturePool: render targets perdidos, refazendo no proximo uso");
+}
+
+void TexturePool::markDeviceLost() {
+    ++deviceEpoch_;
+    ++targetsEpoch_;
+    for (const Entry& e : free_) SDL_DestroyTexture(e.texture);
+    free_.clear();
+    freeBytes_ = 0;
+    for (Entry& e : live_) e.lost = true;
+    DebugLogger::warning("TexturePool: device perdido, " + std::to_string(live_.size()) + " textura(s) refeitas no proximo uso");
+}
+
+void TexturePool::dropOldestFree() {
+    size_t oldest = 0;
+    for (size_t i = 1; i < free_.size(); ++i) {
+        if (free_[i].stamp < free_[oldest].stamp) oldest = i;
+    }
+    const Entry e = free_[oldest];
+    free_[oldest] = free_.back();
+    free_.pop_back();
+    freeBytes_ -= bytesOf(e);
+    DebugLogger::debug("TexturePool: descartando " + std::to_string(e.w) + "x" + std::to_string(e.h));
+    SDL_DestroyTexture(e.texture);
+}
+
+void TexturePool::trim() {
+    while ((freeBytes_ > budget_ || (vramBudget_ && totalBytes() > vramBudget_)) && !free_.empty()) dropOldestFree();
+}
+
+void TexturePool::makeRoom(size_t bytes) {
+    if (!vramBudget_) return;
+    const size_t target = bytes < vramBudget_ ? vramBudget_ - bytes : 0;
+    while (totalBytes() > target) {
+        if (!free_.empty()) {
+            dropOldestFree();
+            continue;
+        }
+        // LRU entre os caches: a textura parada há mais tempo, nunca uma do frame corrente
+        TextureEvictor* victim = nullptr;
+        Uint32 oldest = frame_;
+        for (TextureEvictor* e : evictors_) {
+            const Uint32 use = e->oldestTextureUse();
+            if (use < oldest) { oldest = use; victim = e; }
+        }
+        if (!victim) break;
+        const size_t before = liveBytes_;
+        victim->evictOldestTexture();
+        if (liveBytes_ >= before) break;   // Não soltou nada: não insiste
+        ++evictions_;
+        DebugLogger::debug("TexturePool: despejada textura parada desde o frame " + std::to_string(oldest));
+    }
+    // Um aviso por estouro, não um por textura criada enquanto ele dura
+    const bool over = totalBytes() > target;
+    if (over && !overBudget_) {
+        DebugLogger::warning("TexturePool: " + formatBytes(totalBytes() + bytes) + " em uso, acima de TEXTURE_BUDGET_MB (" +
+                             formatBytes(vramBudget_) + ")");
+    }
+    overBudget_ = over;
+}
+
+std::string TexturePool::usageLine() const {
+    std::string out = formatBytes(totalBytes());
+    if (vramBudget_) out += "/" + formatBytes(vramBudget_);
+    if (evictions_) out += ", " + std::to_string(evictions_) + " evicted";
+    // Os maiores primeiro
+    int order[(int)TextureUse::COUNT];
+    for (int i = 0; i < (int)TextureUse::COUNT; ++i) order[i] = i;
+    std::sort(order, order + (int)TextureUse::COUNT, [this](int a, int b) { return useBytes_[a] > useBytes_[b]; });
+    const char* sep = ": ";
+    for (int i : order) {
+        if (!useBytes_[i]) break;
+        out += sep;
+        out += textureUseName((TextureUse)i);
+        out += " " + formatBytes(useBytes_[i]);
+        sep = ", ";
+    }
+    if (freeBytes_) out += std::string(sep) + "free " + formatBytes(freeBytes_);
+    return out;
+}
+
+TexturePool& renderTargetPool() {
+    static TexturePool pool;
+    return pool;
+}
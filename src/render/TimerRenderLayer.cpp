@@ -1,6 +1,9 @@
 #include "render/TimerRenderLayer.hpp"
+#include "render/GameStateBridge.hpp"
 #include "render/Primitives.hpp"
 #include "render/LayoutCache.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
 #include "timer/TimerSystem.hpp"
 #include "app/GameState.hpp"
 #include "DebugLogger.hpp"
@@ -20,7 +23,10 @@ void TimerRenderLayer::cleanup() {
         SDL_DestroyTexture(textTexture_);
         textTexture_ = nullptr;
     }
+    renderTargetPool().release(boxTexture_);
+    boxTexture_ = nullptr;
     textureNeedsUpdate_ = true;
+    cachedTimer_ = nullptr;
 }
 
 SDL_Rect TimerRenderLayer::getPhysicalRect(const TimerSystem& timer, const LayoutCache& layout) const {
@@ -60,10 +66,9 @@ SDL_Color TimerRenderLayer::getBlinkColor(const TimerSystem& timer) const {
     return {color.r, color.g, color.b, 255};
 }
 
-void TimerRenderLayer::renderBackground(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout) const {
+void TimerRenderLayer::renderBackground(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout, const SDL_Rect& rect) const {
     if (!timer.isEnabled() || !timer.getLayout().enabled) return;
     
-    SDL_Rect rect = getPhysicalRect(timer, layout);
     const auto& timerLayout = timer.getLayout();
     
     // Renderizar fundo
@@ -93,11 +98,11 @@ void TimerRenderLayer::renderProgressBar(SDL_Renderer* renderer, const TimerSyst
     const auto& timerConfig = timer.getConfig();
     SDL_SetRenderDrawColor(renderer, timerConfig.progressBarBg.r, timerConfig.progressBarBg.g, timerConfig.progressBarBg.b, 180);
     SDL_Rect backgroundRect = { barX, barY, barMaxWidth, barHeight };
-    SDL_RenderFillRect(renderer, &backgroundRect);
+    DrawCalls::fillRect(renderer, &backgroundRect);
     
     // Renderizar borda da barra de progresso (usando cor configurável)
     SDL_SetRenderDrawColor(renderer, timerConfig.progressBarBorder.r, timerConfig.progressBarBorder.g, timerConfig.progressBarBorder.b, 255);
-    SDL_RenderDrawRect(renderer, &backgroundRect);
+    DrawCalls::drawRect(renderer, &backgroundRect);
     
     // Renderizar progresso restante
     int barWidth = static_cast<int>(barMaxWidth * (1.0f - progress));
@@ -107,21 +112,20 @@ void TimerRenderLayer::renderProgressBar(SDL_Renderer* renderer, const TimerSyst
         // Barra mais opaca e colorida
         SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 220);
         SDL_Rect progressRect = { barX + 1, barY + 1, barWidth - 2, barHeight - 2 };
-        SDL_RenderFillRect(renderer, &progressRect);
+        DrawCalls::fillRect(renderer, &progressRect);
         
         // Adicionar brilho na barra quando critical
         if (timer.isCritical()) {
             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
             SDL_Rect glowRect = { barX + 1, barY + 1, barWidth - 2, 2 };
-            SDL_RenderFillRect(renderer, &glowRect);
+            DrawCalls::fillRect(renderer, &glowRect);
         }
     }
 }
 
-void TimerRenderLayer::renderText(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout) const {
+void TimerRenderLayer::renderText(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout, const SDL_Rect& rect) const {
     if (!timer.isEnabled()) return;
     
-    SDL_Rect rect = getPhysicalRect(timer, layout);
     std::string timeText = timer.getFormattedTime();
     
     // Calcular escala baseada no tamanho do container
@@ -145,13 +149,69 @@ void TimerRenderLayer::renderText(SDL_Renderer* renderer, const TimerSystem& tim
                          0, 0, 0); // Contorno preto
 }
 
+bool TimerRenderLayer::prepareBox(SDL_Renderer* renderer, const TimerSystem& timer, const LayoutCache& layout, const SDL_Rect& rect) {
+    if (textureFailed_ || rect.w <= 0 || rect.h <= 0) return false;
+    
+    if (!boxTexture_ || rect.w != cachedW_ || rect.h != cachedH_ || boxEpoch_ != renderTargetPool().targetsEpoch()) {
+        renderTargetPool().release(boxTexture_);
+        boxTexture_ = renderTargetPool().acquire(renderer, rect.w, rect.h, TextureUse::TIMER);
+        boxEpoch_ = renderTargetPool().targetsEpoch();
+        // O fundo translúcido fica pré-multiplicado na textura: compor com ONE, 1-srcA
+        SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        if (!boxTexture_ || SDL_SetTextureBlendMode(boxTexture_, premultiplied) != 0) {
+            renderTargetPool().release(boxTexture_);
+            boxTexture_ = nullptr;
+            textureFailed_ = true;
+            DebugLogger::warning("TimerRenderLayer: render target indisponivel, desenhando em modo imediato: " + std::string(SDL_GetError()));
+            return false;
+        }
+        cachedTimer_ = nullptr;
+    }
+    
+    const bool blink = timer.isCritical() && blinkState_;
+    if (cachedTimer_ != &timer || timer.getVersion() != cachedVersion_ || blink != cachedBlink_ ||
+        layout.scaleX != cachedScaleX_ || layout.scaleY != cachedScaleY_ ||
+        layout.borderRadiusX != cachedRadiusX_ || layout.borderRadiusY != cachedRadiusY_) {
+        SDL_Texture* prevTarget = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, boxTexture_);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        DrawCalls::clear(renderer);
+        SDL_Rect local{0, 0, rect.w, rect.h};
+        renderBackground(renderer, timer, layout, local);
+        renderText(renderer, timer, layout, local);
+        SDL_SetRenderTarget(renderer, prevTarget);
+        cachedTimer_ = &timer;
+        cachedVersion_ = timer.getVersion();
+        cachedBlink_ = blink;
+    }
+    cachedW_ = rect.w; cachedH_ = rect.h;
+    cachedScaleX_ = layout.scaleX; cachedScaleY_ = layout.scaleY;
+    cachedRadiusX_ = layout.borderRadiusX; cachedRadiusY_ = layout.borderRadiusY;
+    return true;
+}
+
+bool TimerRenderLayer::isAnimated(const GameState& state) const {
+    const TimerSystem& timer = db_getTimer(state);
+    return timer.isEnabled() && timer.isCritical() && !timer.isExpired();
+}
+
 void TimerRenderLayer::render(SDL_Renderer* renderer, const GameState& state, const LayoutCache& layout) {
-    const TimerSystem& timer = state.getTimer();
+    const TimerSystem& timer = db_getTimer(state);
     
     if (!timer.isEnabled()) return;
     
-    // Renderizar componentes do timer
-    renderBackground(renderer, timer, layout);
-    renderText(renderer, timer, layout);
+    // Avança o piscar uma vez por frame: caixa e barra usam o mesmo estado
+    getBlinkColor(timer);
+    
+    // Caixa e dígitos só mudam na virada de segundo; a barra sai todo frame
+    SDL_Rect rect = getPhysicalRect(timer, layout);
+    if (prepareBox(renderer, timer, layout, rect)) {
+        DrawCalls::copy(renderer, boxTexture_, nullptr, &rect);
+    } else {
+        renderBackground(renderer, timer, layout, rect);
+        renderText(renderer, timer, layout, rect);
+    }
     renderProgressBar(renderer, timer, layout);
 }
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "render/VideoCapture.hpp"
+#include "render/TexturePool.hpp"
+#include "render/DrawCalls.hpp"
+#include "DebugLogger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#  define popen _popen
+#  define pclose _pclose
+#  define PIPE_MODE "wb"
+#else
+#  include <csignal>
+#  define PIPE_MODE "w"
+#endif
+
+namespace {
+
+bool endsWith(const std::string& s, const char* suffix) {
+    const size_t n = std::strlen(suffix);
+    if (s.size() < n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (std::tolower((unsigned char)s[s.size() - n + i]) != suffix[i]) return false;
+    }
+    return true;
+}
+
+bool ffmpegAvailable() {
+#ifdef _WIN32
+    return std::system("ffmpeg -version > NUL 2>&1") == 0;
+#else
+    return std::system("ffmpeg -version > /dev/null 2>&1") == 0;
+#endif
+}
+
+} // namespace
+
+bool VideoCapture::start(const std::string& path, int fps, int delayFrames, size_t budgetBytes) {
+    if (thread_) return true;
+    path_ = path;
+    fps_ = std::max(1, fps);
+    delay_ = std::max(1, std::min(MAX_DELAY, delayFrames));
+    budget_ = budgetBytes;
+    failed_.store(false, std::memory_order_relaxed);
+    if (!wake_) wake_ = SDL_CreateSemaphore(0);
+    if (!wake_) { DebugLogger::error(std::string("SDL_CreateSemaphore failed: ") + SDL_GetError()); return false; }
+    quit_.store(false, std::memory_order_relaxed);
+    thread_ = SDL_CreateThread(&VideoCapture::threadMain, "dropblocks-video", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("Video capture: SDL_CreateThread failed: ") + SDL_GetError());
+        return false;
+    }
+    DebugLogger::info("Video capture: recording to " + path_ + " (" + std::to_string(fps_) + " fps, readback " +
+                      std::to_string(delay_) + " frame(s) behind)");
+    return true;
+}
+
+void VideoCapture::stop(SDL_Renderer* renderer) {
+    if (!thread_) return;
+    // Os DELAY frames que ainda estão só nas texturas
+    if (renderer && !targets_.empty()) {
+        for (uint64_t f = frame_ > (uint64_t)delay_ ? frame_ - (uint64_t)delay_ : 0; f < frame_; ++f) {
+            readBack(renderer, (int)(f % targets_.size()));
+        }
+    }
+    quit_.store(true, std::memory_order_release);
+    SDL_SemPost(wake_);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+    SDL_DestroySemaphore(wake_);
+    wake_ = nullptr;
+    destroyTargets();
+    DebugLogger::info("Video capture: " + statusLine());
+}
+
+std::string VideoCapture::statusLine() const {
+    return std::to_string(framesWritten()) + " frames, " + std::to_string(dropped_) + " dropped, " +
+           std::to_string(bytesInFlight() >> 20) + "/" + std::to_string(budget_ >> 20) + " MB";
+}
+
+// ---------------------------------------------------------------------------
+// Thread do render
+// ---------------------------------------------------------------------------
+
+bool VideoCapture::ensureTargets(SDL_Renderer* renderer) {
+    int w = 0, h = 0;
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    if (w <= 0 || h <= 0) return false;
+    if (!targets_.empty() && w == w_ && h == h_ && epoch_ == renderTargetPool().deviceEpoch()) return true;
+
+    // Resize: o que estava no anel se perde (o vídeo segue no tamanho do começo)
+    destroyTargets();
+    for (int i = 0; i <= delay_; ++i) {
+        SDL_Texture* t = renderTargetPool().create(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h, TextureUse::CAPTURE);
+        if (!t) {
+            DebugLogger::warning(std::string("Video capture: cannot create render target: ") + SDL_GetError());
+            destroyTargets();
+            return false;
+        }
+        targets_.push_back(t);
+    }
+    w_ = w;
+    h_ = h;
+    epoch_ = renderTargetPool().deviceEpoch();
+    frame_ = 0;
+
+    if (buffers_.empty()) {
+        // Pool fixo a partir do primeiro tamanho; pixels alocados no primeiro uso
+        frameBytes_ = (size_t)w * h * 4;
+        const size_t count = std::max<size_t>(2, std::min<size_t>(MAX_BUFFERS, budget_ / frameBytes_));
+        buffers_.resize(count);
+        for (int i = (int)count - 1; i >= 0; --i) free_.push_back(i);
+        DebugLogger::info("Video capture: " + std::to_string(count) + " frame buffers of " +
+                          std::to_string(frameBytes_ >> 10) + " KB");
+    }
+    return true;
+}
+
+void VideoCapture::destroyTargets() {
+    for (SDL_Texture* t : targets_) renderTargetPool().release(t);
+    targets_.clear();
+    slot_ = -1;
+}
+
+void VideoCapture::readBack(SDL_Renderer* renderer, int slot) {
+    while (const int* b = returned_.front()) {
+        free_.push_back(*b);
+        returned_.pop();
+    }
+    if (free_.empty()) {
+        // Encoder atrasado e orçamento no fim: perde este, o próximo cobre o buraco
+        dropped_++;
+        pendingRepeat_++;
+        return;
+    }
+    const int index = free_.back();
+    Buffer& buffer = buffers_[index];
+    buffer.pixels.resize((size_t)w_ * h_ * 4);
+    SDL_Texture* prev = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, targets_[slot]);
+    const int rc = SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, buffer.pixels.data(), w_ * 4);
+    SDL_SetRenderTarget(renderer, prev);
+    if (rc != 0) {
+        dropped_++;
+        pendingRepeat_++;
+        return;
+    }
+    free_.pop_back();
+    buffer.w = w_;
+    buffer.h = h_;
+    buffer.repeatBefore = pendingRepeat_;
+    pendingRepeat_ = 0;
+    inFlight_.fetch_add(1, std::memory_order_relaxed);
+    queue_.push(index);  // Cabe: no máximo MAX_BUFFERS em uso
+    SDL_SemPost(wake_);
+}
+
+void VideoCapture::beginFrame(SDL_Renderer* renderer) {
+    slot_ = -1;
+    if (!thread_ || failed_.load(std::memory_order_relaxed) || !ensureTargets(renderer)) return;
+    const int ring = (int)targets_.size();
+    slot_ = (int)(frame_ % (uint64_t)ring);
+    // A textura da vez guarda o frame de DELAY atrás: lê antes de desenhar por cima
+    if (frame_ >= (uint64_t)delay_) readBack(renderer, (int)((frame_ - (uint64_t)delay_) % (uint64_t)ring));
+    prevTarget_ = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, targets_[slot_]);
+}
+
+void VideoCapture::endFrame(SDL_Renderer* renderer) {
+    if (slot_ < 0) return;
+    SDL_SetRenderTarget(renderer, prevTarget_);
+    DrawCalls::copy(renderer, targets_[slot_], nullptr, nullptr);
+    frame_++;
+    slot_ = -1;
+}
+
+// ---------------------------------------------------------------------------
+// Encoder
+// ---------------------------------------------------------------------------
+
+int SDLCALL VideoCapture::threadMain(void* self) {
+    static_cast<VideoCapture*>(self)->loop();
+    return 0;
+}
+
+void VideoCapture::loop() {
+    for (;;) {
+        SDL_SemWait(wake_);
+        while (const int* index = queue_.front()) {
+            const int b = *index;
+            queue_.pop();
+            if (!failed_.load(std::memory_order_relaxed)) writeFrame(buffers_[b]);
+            inFlight_.fetch_sub(1, std::memory_order_relaxed);
+            returned_.push(b);
+        }
+        if (quit_.load(std::memory_order_acquire)) break;
+    }
+    if (out_) {
+        if (pipe_) pclose(out_);
+        else std::fclose(out_);
+        out_ = nullptr;
+    }
+}
+
+bool VideoCapture::openOutput() {
+    std::string path = path_;
+    pipe_ = false;
+    if (!endsWith(path, ".y4m")) {
+        if (ffmpegAvailable()) {
+            // ffmpeg escolhe o codec pela extensão; stderr só com erros
+            const std::string cmd = "ffmpeg -y -loglevel error -f yuv4mpegpipe -i - \"" + path + "\"";
+#ifndef _WIN32
+            std::signal(SIGPIPE, SIG_IGN);  // ffmpeg saiu com erro: fwrite falha em vez de matar o jogo
+#endif
+            out_ = popen(cmd.c_str(), PIPE_MODE);
+            pipe_ = out_ != nullptr;
+        }
+        if (!out_) {
+            path += ".y4m";
+            DebugLogger::warning("Video capture: ffmpeg not available, writing raw " + path);
+        }
+    }
+    if (!out_) out_ = std::fopen(path.c_str(), "wb");
+    if (!out_) {
+        DebugLogger::error("Video capture: cannot open " + path);
+        return false;
+    }
+    char header[96];
+    std::snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", outW_, outH_, fps_);
+    std::fputs(header, out_);
+    return true;
+}
+
+void VideoCapture::writeFrame(const Buffer& buffer) {
+    if (!out_) {
+        // Tamanho do vídeo = primeiro frame, arredondado para par (4:2:0)
+        outW_ = buffer.w & ~1;
+        outH_ = buffer.h & ~1;
+        if (outW_ <= 0 || outH_ <= 0 || !openOutput()) { failed_.store(true, std::memory_order_relaxed); return; }
+        yuv_.assign((size_t)outW_ * outH_ * 3 / 2, 0);
+    }
+    bool ok = true;
+    // Frames perdidos: repete o último já convertido
+    for (uint32_t r = 0; r < buffer.repeatBefore && written_.load(std::memory_order_relaxed) > 0; ++r) {
+        ok = ok && std::fputs("FRAME\n", out_) >= 0 && std::fwrite(yuv_.data(), 1, yuv_.size(), out_) == yuv_.size();
+    }
+
+    // BT.601 full range (C420jpeg); resize no meio: recorta ou completa com preto
+    uint8_t* Y = yuv_.data();
+    uint8_t* U = Y + (size_t)outW_ * outH_;
+    uint8_t* V = U + (size_t)(outW_ / 2) * (outH_ / 2);
+    const int w = std::min(outW_, buffer.w & ~1);
+    const int h = std::min(outH_, buffer.h & ~1);
+    if (w < outW_ || h < outH_) {
+        std::memset(Y, 0, (size_t)outW_ * outH_);
+        std::memset(U, 128, (size_t)(outW_ / 2) * (outH_ / 2) * 2);
+    }
+    const size_t pitch = (size_t)buffer.w * 4;
+    for (int y = 0; y < h; y += 2) {
+        const uint8_t* r0 = buffer.pixels.data() + (size_t)y * pitch;
+        const uint8_t* r1 = r0 + pitch;
+        uint8_t* y0 = Y + (size_t)y * outW_;
+        uint8_t* y1 = y0 + outW_;
+        uint8_t* u = U + (size_t)(y / 2) * (outW_ / 2);
+        uint8_t* v = V + (size_t)(y / 2) * (outW_ / 2);
+        for (int x = 0; x < w; x += 2) {
+            int sr = 0, sg = 0, sb = 0;
+            const uint8_t* px[4] = {r0 + x * 4, r0 + x * 4 + 4, r1 + x * 4, r1 + x * 4 + 4};
+            uint8_t* dy[4] = {y0 + x, y0 + x + 1, y1 + x, y1 + x + 1};
+            for (int k = 0; k < 4; ++k) {
+                // ARGB8888 na memória (little endian): B, G, R, A
+                const int b = px[k][0], g = px[k][1], r = px[k][2];
+                *dy[k] = (uint8_t)((77 * r + 150 * g + 29 * b + 128) >> 8);
+                sr += r; sg += g; sb += b;
+            }
+            sr >>= 2; sg >>= 2; sb >>= 2;
+            u[x / 2] = (uint8_t)std::max(0, std::min(255, ((-43 * sr - 85 * sg + 128 * sb + 128) >> 8) + 128));
+            v[x / 2] = (uint8_t)std::max(0, std::min(255, ((128 * sr - 107 * sg - 21 * sb + 128) >> 8) + 128));
+        }
+    }
+    ok = ok && std::fputs("FRAME\n", out_) >= 0 && std::fwrite(yuv_.data(), 1, yuv_.size(), out_) == yuv_.size();
+    if (!ok) {
+        DebugLogger::error("Video capture: write failed, recording stopped");
+        failed_.store(true, std::memory_order_relaxed);
+        return;
+    }
+    written_.fetch_add(1 + (written_.load(std::memory_order_relaxed) > 0 ? buffer.repeatBefore : 0),
+                       std::memory_order_relaxed);
+}
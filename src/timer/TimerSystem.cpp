@@ -1,10 +1,10 @@
 #include "timer/TimerSystem.hpp"
 #include "DebugLogger.hpp"
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cstdio>
 
 TimerSystem::TimerSystem() : state_(State::STOPPED), startTime_(0), pausedTime_(0), 
-                            pauseStartTime_(0), lastUpdateTime_(0), gamePauseStartTime_(0), gameWasPaused_(false),
+                            pauseStartTime_(0), nextChangeMs_(0), gamePauseStartTime_(0), gameWasPaused_(false),
                             remainingSeconds_(0), wasWarning_(false), 
                             wasCritical_(false) {
     // Configuração padrão (usa valores default de ConfigTypes.hpp)
@@ -22,15 +22,16 @@ void TimerSystem::start() {
     
     if (state_ == State::STOPPED || state_ == State::EXPIRED) {
         // Novo início
-        startTime_ = SDL_GetTicks();
+        startTime_ = now();
         pausedTime_ = 0;
         pauseStartTime_ = 0;
         state_ = State::RUNNING;
         remainingSeconds_ = config_.durationSeconds;
         wasWarning_ = false;
         wasCritical_ = false;
-        lastUpdateTime_ = startTime_;
-        DebugLogger::info("Timer started: " + std::to_string(config_.durationSeconds) + " seconds");
+        nextChangeMs_ = startTime_ + 1000;
+        ++version_;
+        DB_LOG_INFO("Timer started: " + std::to_string(config_.durationSeconds) + " seconds");
     } else if (state_ == State::PAUSED) {
         // Resume do pause
         resume();
@@ -42,21 +43,23 @@ void TimerSystem::pause() {
         // Atualizar tempo antes de pausar
         updateRemainingTime();
         state_ = State::PAUSED;
-        Uint32 currentTime = SDL_GetTicks();
+        ++version_;
+        Uint32 currentTime = now();
         // Marcar momento do pause (não acumular ainda)
         pauseStartTime_ = currentTime;
-        DebugLogger::info("Timer paused at " + std::to_string(remainingSeconds_) + " seconds remaining");
+        DB_LOG_INFO("Timer paused at " + std::to_string(remainingSeconds_) + " seconds remaining");
     }
 }
 
 void TimerSystem::resume() {
     if (state_ == State::PAUSED) {
         state_ = State::RUNNING;
-        Uint32 currentTime = SDL_GetTicks();
-        // Acumular tempo pausado
+        Uint32 currentTime = now();
+        // Acumular tempo pausado; a virada de segundo anda junto
         pausedTime_ += (currentTime - pauseStartTime_);
-        lastUpdateTime_ = currentTime;
-        DebugLogger::info("Timer resumed with " + std::to_string(remainingSeconds_) + " seconds remaining");
+        nextChangeMs_ += (currentTime - pauseStartTime_);
+        ++version_;
+        DB_LOG_INFO("Timer resumed with " + std::to_string(remainingSeconds_) + " seconds remaining");
     }
 }
 
@@ -65,18 +68,20 @@ void TimerSystem::reset() {
     startTime_ = 0;
     pausedTime_ = 0;
     pauseStartTime_ = 0;
-    lastUpdateTime_ = 0;
+    nextChangeMs_ = 0;
     gamePauseStartTime_ = 0;
     gameWasPaused_ = false;
     remainingSeconds_ = config_.durationSeconds;
     wasWarning_ = false;
     wasCritical_ = false;
-    DebugLogger::info("Timer reset to " + std::to_string(config_.durationSeconds) + " seconds");
+    ++version_;
+    DB_LOG_INFO("Timer reset to " + std::to_string(config_.durationSeconds) + " seconds");
 }
 
 void TimerSystem::stop() {
     if (state_ != State::STOPPED) {
         state_ = State::STOPPED;
+        ++version_;
         DebugLogger::info("Timer stopped");
     }
 }
@@ -85,11 +90,13 @@ void TimerSystem::toggle() {
     if (!config_.enabled) {
         // Se desabilitado, habilita e inicia
         config_.enabled = true;
+        ++version_;
         start();
         DebugLogger::info("Timer enabled and started");
     } else {
         // Se habilitado, desabilita completamente
         config_.enabled = false;
+        ++version_;
         stop();
         DebugLogger::info("Timer disabled");
     }
@@ -107,22 +114,59 @@ void TimerSystem::notifyGamePaused(bool isPaused) {
     }
 }
 
+Uint32 TimerSystem::getElapsedMs() const {
+    switch (state_) {
+        case State::RUNNING: return (now() - startTime_) - pausedTime_;
+        case State::PAUSED: return (pauseStartTime_ - startTime_) - pausedTime_;
+        case State::EXPIRED: return (Uint32)config_.durationSeconds * 1000;
+        default: return 0;
+    }
+}
+
+void TimerSystem::restoreElapsed(bool enabled, State state, Uint32 elapsedMs) {
+    const Uint32 t = now();
+    config_.enabled = enabled;
+    state_ = state;
+    startTime_ = t - elapsedMs;
+    pausedTime_ = 0;
+    pauseStartTime_ = t;
+    gamePauseStartTime_ = 0;
+    gameWasPaused_ = false;
+    nextChangeMs_ = startTime_ + (elapsedMs / 1000 + 1) * 1000;
+    remainingSeconds_ = state == State::STOPPED ? config_.durationSeconds
+                      : std::max(0, config_.durationSeconds - (int)(elapsedMs / 1000));
+    wasWarning_ = isWarning();
+    wasCritical_ = isCritical();
+    ++version_;
+}
+
 void TimerSystem::updateRemainingTime() {
     if (state_ != State::RUNNING) return;
     
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = now();
     Uint32 elapsedTime = (currentTime - startTime_) - pausedTime_;
     int elapsedSeconds = elapsedTime / 1000;
+    // Os limiares de warning/critical são em segundos: a virada seguinte cobre as trocas de cor
+    nextChangeMs_ = startTime_ + pausedTime_ + (Uint32)(elapsedSeconds + 1) * 1000;
     
-    remainingSeconds_ = config_.durationSeconds - elapsedSeconds;
+    const int remaining = std::max(0, config_.durationSeconds - elapsedSeconds);
+    if (remaining != remainingSeconds_) {
+        remainingSeconds_ = remaining;
+        ++version_;
+    }
     
     if (remainingSeconds_ <= 0) {
-        remainingSeconds_ = 0;
         state_ = State::EXPIRED;
+        ++version_;
         DebugLogger::info("Timer expired!");
     }
 }
 
+int TimerSystem::msUntilChange() const {
+    if (!config_.enabled || state_ != State::RUNNING) return -1;
+    return std::max(0, (int)(Sint32)(nextChangeMs_ - now()));
+}
+
 float TimerSystem::getProgress() const {
     if (config_.durationSeconds <= 0) return 1.0f;
     
@@ -134,11 +178,10 @@ std::string TimerSystem::getFormattedTime() const {
     int minutes = remainingSeconds_ / 60;
     int seconds = remainingSeconds_ % 60;
     
-    std::stringstream ss;
-    ss << std::setfill('0') << std::setw(2) << minutes << ":"
-       << std::setfill('0') << std::setw(2) << seconds;
-    
-    return ss.str();
+    // snprintf num buffer local: "MM:SS" cabe no SSO, sem heap no caminho do frame
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%02d:%02d", minutes, seconds);
+    return std::string(buf);
 }
 
 bool TimerSystem::isWarning() const {
@@ -163,6 +206,7 @@ void TimerSystem::setConfig(const TimerConfig& config) {
     bool wasEnabled = config_.enabled;
     config_ = config;
     remainingSeconds_ = config_.durationSeconds;
+    ++version_;
     
     // Se estava desabilitado e agora está habilitado, não inicia automaticamente
     // Se estava habilitado e agora está desabilitado, para o timer
@@ -174,6 +218,7 @@ void TimerSystem::setConfig(const TimerConfig& config) {
 void TimerSystem::setEnabled(bool enabled) {
     bool wasEnabled = config_.enabled;
     config_.enabled = enabled;
+    ++version_;
     
     if (wasEnabled && !enabled) {
         stop();
@@ -191,28 +236,26 @@ void TimerSystem::setDuration(int seconds) {
         if (state_ == State::STOPPED) {
             remainingSeconds_ = seconds;
         }
+        ++version_;
     }
 }
 
 void TimerSystem::update() {
     if (!config_.enabled || state_ != State::RUNNING) return;
     
-    Uint32 currentTime = SDL_GetTicks();
-    
-    // Atualiza a cada segundo ou se for a primeira atualização
-    if (lastUpdateTime_ == 0 || (currentTime - lastUpdateTime_) >= 1000) {
+    // Nada visível muda antes da próxima virada de segundo da contagem
+    if ((Sint32)(now() - nextChangeMs_) >= 0) {
         updateRemainingTime();
-        lastUpdateTime_ = currentTime;
         
         // Log de transições de estado
         bool isWarn = isWarning();
         bool isCrit = isCritical();
         
         if (isCrit && !wasCritical_) {
-            DebugLogger::info("Timer entering critical state: " + std::to_string(remainingSeconds_) + "s remaining");
+            DB_LOG_INFO("Timer entering critical state: " + std::to_string(remainingSeconds_) + "s remaining");
             wasCritical_ = true;
         } else if (isWarn && !wasWarning_ && !isCrit) {
-            DebugLogger::info("Timer entering warning state: " + std::to_string(remainingSeconds_) + "s remaining");
+            DB_LOG_INFO("Timer entering warning state: " + std::to_string(remainingSeconds_) + "s remaining");
             wasWarning_ = true;
         }
     }
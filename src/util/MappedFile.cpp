@@ -0,0 +1,36 @@
+#include "util/MappedFile.hpp"
+#include <sys/stat.h>
+#include <fstream>
+#include <iterator>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) { map_ = p; data_ = static_cast<const char*>(p); size_ = (size_t)st.st_size; }
+    }
+    ::close(fd);
+    if (map_) return;
+#endif
+    std::ifstream in(path, std::ios::binary);
+    if (!in.good()) return;
+    copy_.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (copy_.empty()) return;
+    data_ = copy_.data();
+    size_ = copy_.size();
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+    if (map_) munmap(map_, size_);
+#endif
+}
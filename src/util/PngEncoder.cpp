@@ -0,0 +1,209 @@
+#include "util/PngEncoder.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+uint32_t crcTable[256];
+bool crcReady = false;
+
+uint32_t crc32(const uint8_t* data, size_t n, uint32_t crc = 0) {
+    if (!crcReady) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            crcTable[i] = c;
+        }
+        crcReady = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)(v >> 24));
+    out.push_back((uint8_t)(v >> 16));
+    out.push_back((uint8_t)(v >> 8));
+    out.push_back((uint8_t)v);
+}
+
+void chunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t n) {
+    put32(out, (uint32_t)n);
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (n) out.insert(out.end(), data, data + n);
+    put32(out, crc32(out.data() + start, n + 4));
+}
+
+// Bits LSB primeiro, como o deflate quer
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+    void bits(uint32_t value, int count) {
+        acc_ |= value << fill_;
+        fill_ += count;
+        while (fill_ >= 8) {
+            out_.push_back((uint8_t)acc_);
+            acc_ >>= 8;
+            fill_ -= 8;
+        }
+    }
+    /// Códigos de Huffman vão do bit mais significativo
+    void code(uint32_t code, int length) {
+        uint32_t r = 0;
+        for (int i = 0; i < length; ++i) r |= ((code >> i) & 1u) << (length - 1 - i);
+        bits(r, length);
+    }
+    void flush() { if (fill_) bits(0, 8 - fill_); }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint32_t acc_ = 0;
+    int fill_ = 0;
+};
+
+const uint16_t LEN_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                               35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LEN_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+                                513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+void literal(BitWriter& bw, int v) {
+    if (v < 144) bw.code(0x30 + v, 8);
+    else if (v < 256) bw.code(0x190 + (v - 144), 9);
+    else if (v < 280) bw.code(v - 256, 7);
+    else bw.code(0xC0 + (v - 280), 8);
+}
+
+void match(BitWriter& bw, int length, int distance) {
+    int l = 28;
+    while (LEN_BASE[l] > length) --l;
+    literal(bw, 257 + l);
+    bw.bits((uint32_t)(length - LEN_BASE[l]), LEN_EXTRA[l]);
+    int d = 29;
+    while (DIST_BASE[d] > distance) --d;
+    bw.code((uint32_t)d, 5);
+    bw.bits((uint32_t)(distance - DIST_BASE[d]), DIST_EXTRA[d]);
+}
+
+// zlib: um bloco só, Huffman fixo
+void deflate(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    constexpr int WINDOW = 32768, HASH_BITS = 15, MAX_CHAIN = 24, MAX_MATCH = 258;
+    out.push_back(0x78);
+    out.push_back(0x01);
+    BitWriter bw(out);
+    bw.bits(1, 1);   // BFINAL
+    bw.bits(1, 2);   // BTYPE = fixo
+
+    std::vector<int32_t> head((size_t)1 << HASH_BITS, -1), prev(WINDOW, -1);
+    const size_t n = in.size();
+    auto hashAt = [&](size_t i) {
+        return ((uint32_t)in[i] << 10 ^ (uint32_t)in[i + 1] << 5 ^ in[i + 2]) & ((1u << HASH_BITS) - 1);
+    };
+    auto insert = [&](size_t i) {
+        if (i + 2 >= n) return;
+        const uint32_t h = hashAt(i);
+        prev[i & (WINDOW - 1)] = head[h];
+        head[h] = (int32_t)i;
+    };
+    size_t i = 0;
+    while (i < n) {
+        int bestLen = 0, bestDist = 0;
+        if (i + 2 < n) {
+            int32_t cand = head[hashAt(i)];
+            const int limit = (int)std::min<size_t>(MAX_MATCH, n - i);
+            for (int chain = 0; cand >= 0 && (int)(i - cand) <= WINDOW - 1 && chain < MAX_CHAIN; ++chain) {
+                const uint8_t* a = &in[i];
+                const uint8_t* b = &in[(size_t)cand];
+                if (b[bestLen] == a[bestLen]) {
+                    int len = 0;
+                    while (len < limit && a[len] == b[len]) ++len;
+                    if (len > bestLen) {
+                        bestLen = len;
+                        bestDist = (int)(i - cand);
+                        if (len == limit) break;
+                    }
+                }
+                const int32_t next = prev[(size_t)cand & (WINDOW - 1)];
+                if (next >= cand) break;  // Entrada reciclada da janela
+                cand = next;
+            }
+        }
+        if (bestLen >= 3) {
+            match(bw, bestLen, bestDist);
+            for (int k = 0; k < bestLen; ++k) insert(i + k);
+            i += (size_t)bestLen;
+        } else {
+            literal(bw, in[i]);
+            insert(i);
+            ++i;
+        }
+    }
+    literal(bw, 256);
+    bw.flush();
+
+    uint32_t a = 1, b = 0;
+    for (size_t k = 0; k < n; ++k) {
+        a = (a + in[k]) % 65521;
+        b = (b + a) % 65521;
+    }
+    put32(out, (b << 16) | a);
+}
+
+} // namespace
+
+namespace PngEncoder {
+
+bool encodeRgb(const uint8_t* rgb, int w, int h, int pitch, std::vector<uint8_t>& out) {
+    if (!rgb || w <= 0 || h <= 0 || pitch < w * 3) return false;
+    const size_t row = (size_t)w * 3;
+
+    // Linhas filtradas: byte do filtro + dados
+    std::vector<uint8_t> raw((row + 1) * (size_t)h);
+    std::vector<uint8_t> cand[3];
+    for (auto& c : cand) c.resize(row);
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* cur = rgb + (size_t)y * pitch;
+        const uint8_t* up = y > 0 ? rgb + (size_t)(y - 1) * pitch : nullptr;
+        long best = -1;
+        int bestFilter = 0;
+        for (int f = 0; f < 3; ++f) {
+            if (f == 2 && !up) break;
+            long sum = 0;
+            for (size_t x = 0; x < row; ++x) {
+                uint8_t v = cur[x];
+                if (f == 1) v = (uint8_t)(v - (x >= 3 ? cur[x - 3] : 0));
+                else if (f == 2) v = (uint8_t)(v - up[x]);
+                cand[f][x] = v;
+                sum += std::abs((int)(int8_t)v);
+            }
+            if (best < 0 || sum < best) { best = sum; bestFilter = f; }
+        }
+        uint8_t* dst = &raw[(row + 1) * (size_t)y];
+        dst[0] = (uint8_t)bestFilter;
+        std::memcpy(dst + 1, cand[bestFilter].data(), row);
+    }
+
+    out.clear();
+    static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.insert(out.end(), SIGNATURE, SIGNATURE + 8);
+    uint8_t ihdr[13] = {0};
+    for (int k = 0; k < 4; ++k) {
+        ihdr[k] = (uint8_t)((uint32_t)w >> (24 - 8 * k));
+        ihdr[4 + k] = (uint8_t)((uint32_t)h >> (24 - 8 * k));
+    }
+    ihdr[8] = 8;   // bits por canal
+    ihdr[9] = 2;   // RGB
+    chunk(out, "IHDR", ihdr, sizeof(ihdr));
+    std::vector<uint8_t> z;
+    z.reserve(raw.size() / 4);
+    deflate(raw, z);
+    chunk(out, "IDAT", z.data(), z.size());
+    chunk(out, "IEND", nullptr, 0);
+    return true;
+}
+
+} // namespace PngEncoder
@@ -0,0 +1,38 @@
+#include "util/RotatingFile.hpp"
+
+bool RotatingFile::open(const std::string& path, size_t maxBytes, int keepFiles) {
+    close();
+    path_ = path;
+    maxBytes_ = maxBytes;
+    keep_ = keepFiles < 0 ? 0 : keepFiles;
+    file_ = std::fopen(path.c_str(), "a");
+    if (!file_) return false;
+    std::fseek(file_, 0, SEEK_END);
+    long size = std::ftell(file_);
+    bytes_ = size > 0 ? (size_t)size : 0;
+    return true;
+}
+
+void RotatingFile::close() {
+    if (file_) std::fclose(file_);
+    file_ = nullptr;
+}
+
+void RotatingFile::write(const char* data, size_t length) {
+    if (!file_) return;
+    bytes_ += std::fwrite(data, 1, length, file_);
+    if (maxBytes_ > 0 && bytes_ >= maxBytes_) rotate();
+}
+
+void RotatingFile::rotate() {
+    std::fclose(file_);
+    if (keep_ > 0) {
+        std::remove((path_ + "." + std::to_string(keep_)).c_str());
+        for (int i = keep_ - 1; i >= 1; --i) {
+            std::rename((path_ + "." + std::to_string(i)).c_str(), (path_ + "." + std::to_string(i + 1)).c_str());
+        }
+        std::rename(path_.c_str(), (path_ + ".1").c_str());
+    }
+    file_ = std::fopen(path_.c_str(), "w");
+    bytes_ = 0;
+}
@@ -0,0 +1,91 @@
+#include "util/ScreenshotWriter.hpp"
+#include "util/PngEncoder.hpp"
+#include "util/UiUtil.hpp"
+#include "DebugLogger.hpp"
+#include <cstdio>
+
+bool ScreenshotWriter::start() {
+    if (thread_) return true;
+    if (!wake_) wake_ = SDL_CreateSemaphore(0);
+    if (!wake_) { DebugLogger::error(std::string("SDL_CreateSemaphore failed: ") + SDL_GetError()); return false; }
+    quit_.store(false, std::memory_order_relaxed);
+    thread_ = SDL_CreateThread(&ScreenshotWriter::threadMain, "dropblocks-shot", this);
+    if (!thread_) {
+        DebugLogger::error(std::string("Screenshot: SDL_CreateThread failed: ") + SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void ScreenshotWriter::stop() {
+    if (thread_) {
+        // O worker termina o que já está na fila antes de sair
+        quit_.store(true, std::memory_order_release);
+        SDL_SemPost(wake_);
+        SDL_WaitThread(thread_, nullptr);
+        thread_ = nullptr;
+    }
+    if (wake_) { SDL_DestroySemaphore(wake_); wake_ = nullptr; }
+}
+
+bool ScreenshotWriter::capture(SDL_Renderer* renderer) {
+    if (!thread_ || !renderer) return false;
+    int slot = -1;
+    for (int i = 0; i < POOL_FRAMES && slot < 0; ++i) {
+        if (!frames_[i].busy.load(std::memory_order_acquire)) slot = i;
+    }
+    if (slot < 0) {
+        DebugLogger::warning("Screenshot: still writing the previous ones, request dropped");
+        return false;
+    }
+    Frame& f = frames_[slot];
+    int w = 0, h = 0;
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    if (w <= 0 || h <= 0) return false;
+    f.pixels.resize((size_t)w * h * 3);  // Mesmo tamanho da última vez: nenhuma alocação
+    if (SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGB24, f.pixels.data(), w * 3) != 0) {
+        DebugLogger::warning(std::string("Screenshot: SDL_RenderReadPixels failed: ") + SDL_GetError());
+        return false;
+    }
+    f.w = w;
+    f.h = h;
+    f.path = timestampedScreenshotName("png");
+    f.busy.store(true, std::memory_order_release);
+    queue_.push(slot);  // Cabe sempre: no máximo POOL_FRAMES na fila
+    SDL_SemPost(wake_);
+    return true;
+}
+
+int SDLCALL ScreenshotWriter::threadMain(void* self) {
+    static_cast<ScreenshotWriter*>(self)->loop();
+    return 0;
+}
+
+void ScreenshotWriter::loop() {
+    for (;;) {
+        SDL_SemWait(wake_);
+        while (const int* slot = queue_.front()) {
+            Frame& f = frames_[*slot];
+            queue_.pop();
+            write(f);
+            f.busy.store(false, std::memory_order_release);
+        }
+        if (quit_.load(std::memory_order_acquire)) break;
+    }
+}
+
+void ScreenshotWriter::write(Frame& f) {
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    if (!PngEncoder::encodeRgb(f.pixels.data(), f.w, f.h, f.w * 3, png_)) return;
+    FILE* out = std::fopen(f.path.c_str(), "wb");
+    bool ok = out && std::fwrite(png_.data(), 1, png_.size(), out) == png_.size();
+    if (out) ok = std::fclose(out) == 0 && ok;
+    if (!ok) {
+        DebugLogger::warning("Screenshot: cannot write " + f.path);
+        return;
+    }
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    DebugLogger::info("Screenshot saved: " + f.path + " (" + std::to_string(png_.size() / 1024) + " KB, " +
+                      std::to_string((int)ms) + "ms)");
+    completed_.fetch_add(1, std::memory_order_acq_rel);
+}
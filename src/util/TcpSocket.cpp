@@ -0,0 +1,193 @@
+#include "util/TcpSocket.hpp"
+#include "DebugLogger.hpp"
+
+#ifdef _WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <netdb.h>
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  include <sys/select.h>
+#  include <sys/socket.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+const NativeSocket BAD_SOCKET = INVALID_SOCKET;
+bool ensureWinsock() {
+    static bool ok = [] { WSADATA data; return WSAStartup(MAKEWORD(2, 2), &data) == 0; }();
+    return ok;
+}
+void closeNative(NativeSocket s) { closesocket(s); }
+bool setNonBlocking(NativeSocket s) { u_long on = 1; return ioctlsocket(s, FIONBIO, &on) == 0; }
+bool wouldBlock() { int e = WSAGetLastError(); return e == WSAEWOULDBLOCK || e == WSAEINPROGRESS; }
+#else
+using NativeSocket = int;
+const NativeSocket BAD_SOCKET = -1;
+void closeNative(NativeSocket s) { ::close(s); }
+bool setNonBlocking(NativeSocket s) { return fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK) == 0; }
+bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == EINPROGRESS; }
+#endif
+
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL;   // Par fechado vira -1, não SIGPIPE
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+// Eventos pequenos: sem Nagle, cada frame sai na hora
+void setNoDelay(NativeSocket s) {
+    int on = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&on, sizeof(on));
+}
+
+bool waitFor(intptr_t fd, bool write, int timeoutMs) {
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET((NativeSocket)fd, &set);
+    timeval tv;
+    tv.tv_sec = timeoutMs / 1000;
+    tv.tv_usec = (timeoutMs % 1000) * 1000;
+    return select((int)fd + 1, write ? nullptr : &set, write ? &set : nullptr, nullptr, &tv) > 0;
+}
+
+} // namespace
+
+bool TcpSocket::connect(const std::string& host, int port, int timeoutMs) {
+    close();
+#ifdef _WIN32
+    if (!ensureWinsock()) { DebugLogger::warning("TCP: WSAStartup failed"); return false; }
+#endif
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &res) != 0 || !res) {
+        DebugLogger::warning("TCP: cannot resolve " + host + ":" + service);
+        return false;
+    }
+    for (addrinfo* ai = res; ai && fd_ < 0; ai = ai->ai_next) {
+        NativeSocket s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s == BAD_SOCKET) continue;
+        // Não bloqueante já no connect: o timeout fica com o select
+        if (!setNonBlocking(s)) { closeNative(s); continue; }
+        bool ok = ::connect(s, ai->ai_addr, (int)ai->ai_addrlen) == 0;
+        if (!ok && wouldBlock() && waitFor((intptr_t)s, true, timeoutMs)) {
+            int err = 0;
+            socklen_t len = sizeof(err);
+            ok = getsockopt(s, SOL_SOCKET, SO_ERROR, (char*)&err, &len) == 0 && err == 0;
+        }
+        if (ok) {
+            setNoDelay(s);
+            fd_ = (intptr_t)s;
+        } else {
+            closeNative(s);
+        }
+    }
+    freeaddrinfo(res);
+    return fd_ >= 0;
+}
+
+void TcpSocket::adopt(intptr_t fd) {
+    close();
+    fd_ = fd;
+}
+
+void TcpSocket::close() {
+    if (fd_ < 0) return;
+    closeNative((NativeSocket)fd_);
+    fd_ = -1;
+}
+
+int TcpSocket::send(const void* data, size_t length) {
+    if (fd_ < 0) return -1;
+#ifdef _WIN32
+    int n = ::send((NativeSocket)fd_, (const char*)data, (int)length, SEND_FLAGS);
+#else
+    ssize_t n = ::send((NativeSocket)fd_, data, length, SEND_FLAGS);
+#endif
+    if (n < 0) return wouldBlock() ? 0 : -1;
+    return (int)n;
+}
+
+int TcpSocket::receive(void* buffer, size_t capacity) {
+    if (fd_ < 0) return -1;
+#ifdef _WIN32
+    int n = ::recv((NativeSocket)fd_, (char*)buffer, (int)capacity, 0);
+#else
+    ssize_t n = ::recv((NativeSocket)fd_, buffer, capacity, 0);
+#endif
+    if (n == 0) return -1;  // Fim do stream
+    if (n < 0) return wouldBlock() ? 0 : -1;
+    return (int)n;
+}
+
+bool TcpSocket::waitReadable(int timeoutMs) {
+    return fd_ >= 0 && waitFor(fd_, false, timeoutMs);
+}
+
+bool TcpListener::listen(int port) {
+    close();
+#ifdef _WIN32
+    if (!ensureWinsock()) { DebugLogger::warning("TCP: WSAStartup failed"); return false; }
+#endif
+    // IPv6 com v4 mapeado quando der; senão IPv4
+    NativeSocket s = socket(AF_INET6, SOCK_STREAM, 0);
+    bool bound = false;
+    int on = 1;
+    if (s != BAD_SOCKET) {
+        int off = 0;
+        setsockopt(s, IPPROTO_IPV6, IPV6_V6ONLY, (const char*)&off, sizeof(off));
+        setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
+        sockaddr_in6 a{};
+        a.sin6_family = AF_INET6;
+        a.sin6_addr = in6addr_any;
+        a.sin6_port = htons((uint16_t)port);
+        bound = bind(s, (const sockaddr*)&a, sizeof(a)) == 0;
+        if (!bound) closeNative(s);
+    }
+    if (!bound) {
+        s = socket(AF_INET, SOCK_STREAM, 0);
+        if (s == BAD_SOCKET) return false;
+        setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
+        sockaddr_in a{};
+        a.sin_family = AF_INET;
+        a.sin_addr.s_addr = htonl(INADDR_ANY);
+        a.sin_port = htons((uint16_t)port);
+        bound = bind(s, (const sockaddr*)&a, sizeof(a)) == 0;
+    }
+    if (!bound || ::listen(s, 8) != 0 || !setNonBlocking(s)) {
+        closeNative(s);
+        DebugLogger::warning("TCP: cannot listen on port " + std::to_string(port));
+        return false;
+    }
+    fd_ = (intptr_t)s;
+    return true;
+}
+
+void TcpListener::close() {
+    if (fd_ < 0) return;
+    closeNative((NativeSocket)fd_);
+    fd_ = -1;
+}
+
+intptr_t TcpListener::accept() {
+    if (fd_ < 0) return -1;
+    NativeSocket c = ::accept((NativeSocket)fd_, nullptr, nullptr);
+    if (c == BAD_SOCKET) return -1;
+    if (!setNonBlocking(c)) { closeNative(c); return -1; }
+    setNoDelay(c);
+    return (intptr_t)c;
+}
+
+bool TcpListener::waitPending(int timeoutMs) {
+    return fd_ >= 0 && waitFor(fd_, false, timeoutMs);
+}
@@ -0,0 +1,122 @@
+#include "util/UdpSocket.hpp"
+#include "DebugLogger.hpp"
+
+#ifdef _WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+#else
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <netdb.h>
+#  include <netinet/in.h>
+#  include <sys/select.h>
+#  include <sys/socket.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+const NativeSocket BAD_SOCKET = INVALID_SOCKET;
+bool ensureWinsock() {
+    static bool ok = [] { WSADATA data; return WSAStartup(MAKEWORD(2, 2), &data) == 0; }();
+    return ok;
+}
+void closeNative(NativeSocket s) { closesocket(s); }
+bool setNonBlocking(NativeSocket s) { u_long on = 1; return ioctlsocket(s, FIONBIO, &on) == 0; }
+#else
+using NativeSocket = int;
+const NativeSocket BAD_SOCKET = -1;
+void closeNative(NativeSocket s) { ::close(s); }
+bool setNonBlocking(NativeSocket s) { return fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK) == 0; }
+#endif
+
+// Porta local em todas as interfaces, na família do destino
+bool bindLocal(NativeSocket s, int family, int port) {
+    if (family == AF_INET6) {
+        sockaddr_in6 a{};
+        a.sin6_family = AF_INET6;
+        a.sin6_addr = in6addr_any;
+        a.sin6_port = htons((uint16_t)port);
+        return bind(s, (const sockaddr*)&a, sizeof(a)) == 0;
+    }
+    sockaddr_in a{};
+    a.sin_family = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_ANY);
+    a.sin_port = htons((uint16_t)port);
+    return bind(s, (const sockaddr*)&a, sizeof(a)) == 0;
+}
+
+} // namespace
+
+bool UdpSocket::open(const std::string& host, int port, int localPort) {
+    close();
+#ifdef _WIN32
+    if (!ensureWinsock()) { DebugLogger::warning("UDP: WSAStartup failed"); return false; }
+#endif
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* res = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &res) != 0 || !res) {
+        DebugLogger::warning("UDP: cannot resolve " + host + ":" + service);
+        return false;
+    }
+    for (addrinfo* ai = res; ai; ai = ai->ai_next) {
+        NativeSocket s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s == BAD_SOCKET) continue;
+        if (localPort > 0 && !bindLocal(s, ai->ai_family, localPort)) {
+            closeNative(s);
+            continue;
+        }
+        if (connect(s, ai->ai_addr, (int)ai->ai_addrlen) == 0 && setNonBlocking(s)) {
+            fd_ = (intptr_t)s;
+            break;
+        }
+        closeNative(s);
+    }
+    freeaddrinfo(res);
+    if (fd_ < 0) DebugLogger::warning("UDP: cannot open a socket to " + host + ":" + service);
+    return fd_ >= 0;
+}
+
+void UdpSocket::close() {
+    if (fd_ < 0) return;
+    closeNative((NativeSocket)fd_);
+    fd_ = -1;
+}
+
+bool UdpSocket::send(const void* data, size_t length) {
+    if (fd_ < 0) return false;
+#ifdef _WIN32
+    return ::send((NativeSocket)fd_, (const char*)data, (int)length, 0) == (int)length;
+#else
+    return ::send((NativeSocket)fd_, data, length, 0) == (ssize_t)length;
+#endif
+}
+
+int UdpSocket::receive(void* buffer, size_t capacity) {
+    if (fd_ < 0) return -1;
+#ifdef _WIN32
+    int n = ::recv((NativeSocket)fd_, (char*)buffer, (int)capacity, 0);
+    if (n < 0) return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+#else
+    ssize_t n = ::recv((NativeSocket)fd_, buffer, capacity, 0);
+    if (n < 0) return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+#endif
+    return (int)n;
+}
+
+bool UdpSocket::waitReadable(int timeoutMs) {
+    if (fd_ < 0) return false;
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET((NativeSocket)fd_, &set);
+    timeval tv;
+    tv.tv_sec = timeoutMs / 1000;
+    tv.tv_usec = (timeoutMs % 1000) * 1000;
+    return select((int)fd_ + 1, &set, nullptr, nullptr, &tv) > 0;
+}
@@ -1,5 +1,7 @@
 #include "util/UiUtil.hpp"
 #include <algorithm>
+#include <cstdio>
+#include <ctime>
 #include <SDL2/SDL.h>
 
 std::string fmtScore(int value){
@@ -20,4 +22,15 @@ bool saveScreenshot(SDL_Renderer* renderer, const char* path) {
     return (rc == 0);
 }
 
+std::string timestampedScreenshotName(const char* ext) {
+    time_t now = time(0);
+    struct tm* timeinfo = localtime(&now);
+    char filename[64];
+    size_t n = strftime(filename, sizeof(filename), "dropblocks-screenshot_%Y-%m-%d_%H-%M-%S", timeinfo);
+    snprintf(filename + n, sizeof(filename) - n, ".%s", ext);
+    return filename;
+}
 
+bool saveTimestampedScreenshot(SDL_Renderer* renderer) {
+    return saveScreenshot(renderer, timestampedScreenshotName("bmp").c_str());
+}